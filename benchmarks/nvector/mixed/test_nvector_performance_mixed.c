@@ -0,0 +1,415 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to evaluate the performance of the
+ * mixed-precision NVECTOR module implementation. With timing
+ * enabled, the run ends with a comparison of the throughput and
+ * accuracy of the mixed-precision vector to those of the serial
+ * vector storing the data in full precision.
+ * -----------------------------------------------------------------*/
+
+#include <nvector/nvector_mixed.h>
+#include <nvector/nvector_serial.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS)
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "test_nvector_performance.h"
+
+/* private functions */
+static int InitializeClearCache(int cachesize);
+static int FinalizeClearCache();
+static void PrintMixedComparison(N_Vector X, int nvecs, int ntests);
+
+/* private data for clearing cache */
+static sunindextype N;    /* data length */
+static sunrealtype* data; /* host data   */
+
+/* ----------------------------------------------------------------------
+ * Main NVector Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  SUNContext ctx = NULL; /* SUNDIALS context */
+  N_Vector X     = NULL; /* test vector      */
+  sunindextype veclen;   /* vector length    */
+
+  int print_timing; /* output timings     */
+  int ntests;       /* number of tests    */
+  int nvecs;        /* number of tests    */
+  int nsums;        /* number of sums     */
+  int cachesize;    /* size of cache (MB) */
+  int nthreads;     /* number of threads  */
+  int flag;         /* return flag        */
+
+  printf("\nStart Tests\n");
+  printf("Vector Name: Mixed\n");
+
+  /* check input and set vector length */
+  if (argc < 7)
+  {
+    printf("ERROR: SIX (6) arguments required: ");
+    printf("<vector length> <number of vectors> <number of sums> <number of "
+           "tests> ");
+    printf("<cache size (MB)> <print timing> [<number of threads>]\n");
+    return (-1);
+  }
+
+  veclen = (sunindextype)atol(argv[1]);
+  if (veclen <= 0)
+  {
+    printf("ERROR: length of vector must be a positive integer \n");
+    return (-1);
+  }
+
+  nvecs = (int)atol(argv[2]);
+  if (nvecs < 1) { printf("WARNING: Fused operation test disabled\n"); }
+
+  nsums = (int)atol(argv[3]);
+  if (nsums < 1) { printf("WARNING: Some fused operation tests disabled\n"); }
+
+  ntests = (int)atol(argv[4]);
+  if (ntests <= 0)
+  {
+    printf("ERROR: number of tests must be a positive integer \n");
+    return (-1);
+  }
+
+  cachesize = (int)atol(argv[5]);
+  if (cachesize < 0)
+  {
+    printf("ERROR: cache size (MB) must be a non-negative integer \n");
+    return (-1);
+  }
+  InitializeClearCache(cachesize);
+
+  print_timing = atoi(argv[6]);
+  SetTiming(print_timing, 0);
+
+  nthreads = (argc > 7) ? atoi(argv[7]) : 1;
+  if (nthreads < 1)
+  {
+    printf("ERROR: number of threads must be a positive integer \n");
+    return (-1);
+  }
+
+  printf("\nRunning with: \n");
+  printf("  vector length         %ld \n", (long int)veclen);
+  printf("  max number of vectors %d  \n", nvecs);
+  printf("  max number of sums    %d  \n", nsums);
+  printf("  number of tests       %d  \n", ntests);
+  printf("  timing on/off         %d  \n", print_timing);
+  printf("  number of threads     %d  \n", nthreads);
+
+  flag = SUNContext_Create(SUN_COMM_NULL, &ctx);
+  if (flag) { return flag; }
+
+  /* Create vectors */
+  X    = N_VNew_Mixed(veclen, ctx);
+  flag = N_VSetNumThreads_Mixed(X, nthreads);
+  if (flag) { return flag; }
+
+  /* run tests */
+  if (print_timing) { printf("\n\n standard operations:\n"); }
+  if (print_timing) { PrintTableHeader(1); }
+  flag = Test_N_VLinearSum(X, veclen, ntests);
+  flag = Test_N_VConst(X, veclen, ntests);
+  flag = Test_N_VProd(X, veclen, ntests);
+  flag = Test_N_VDiv(X, veclen, ntests);
+  flag = Test_N_VScale(X, veclen, ntests);
+  flag = Test_N_VAbs(X, veclen, ntests);
+  flag = Test_N_VInv(X, veclen, ntests);
+  flag = Test_N_VAddConst(X, veclen, ntests);
+  flag = Test_N_VDotProd(X, veclen, ntests);
+  flag = Test_N_VMaxNorm(X, veclen, ntests);
+  flag = Test_N_VWrmsNorm(X, veclen, ntests);
+  flag = Test_N_VWrmsNormMask(X, veclen, ntests);
+  flag = Test_N_VMin(X, veclen, ntests);
+  flag = Test_N_VWL2Norm(X, veclen, ntests);
+  flag = Test_N_VL1Norm(X, veclen, ntests);
+  flag = Test_N_VCompare(X, veclen, ntests);
+  flag = Test_N_VInvTest(X, veclen, ntests);
+  flag = Test_N_VConstrMask(X, veclen, ntests);
+  flag = Test_N_VMinQuotient(X, veclen, ntests);
+
+  if (nvecs > 0)
+  {
+    if (print_timing) { printf("\n\n fused operations 1: nvecs= %d\n", nvecs); }
+    if (print_timing) { PrintTableHeader(2); }
+    flag = Test_N_VLinearCombination(X, veclen, nvecs, ntests);
+    flag = Test_N_VScaleAddMulti(X, veclen, nvecs, ntests);
+    flag = Test_N_VDotProdMulti(X, veclen, nvecs, ntests);
+    flag = Test_N_VLinearSumVectorArray(X, veclen, nvecs, ntests);
+    flag = Test_N_VScaleVectorArray(X, veclen, nvecs, ntests);
+    flag = Test_N_VConstVectorArray(X, veclen, nvecs, ntests);
+    flag = Test_N_VWrmsNormVectorArray(X, veclen, nvecs, ntests);
+    flag = Test_N_VWrmsNormMaskVectorArray(X, veclen, nvecs, ntests);
+
+    if (nsums > 0)
+    {
+      if (print_timing)
+      {
+        printf("\n\n fused operations 2: nvecs= %d nsums= %d\n", nvecs, nsums);
+      }
+      if (print_timing) { PrintTableHeader(2); }
+      flag = Test_N_VScaleAddMultiVectorArray(X, veclen, nvecs, nsums, ntests);
+      flag = Test_N_VLinearCombinationVectorArray(X, veclen, nvecs, nsums,
+                                                  ntests);
+    }
+  }
+
+  /* compare to the full precision serial vector */
+  if (print_timing) { PrintMixedComparison(X, nvecs, ntests); }
+
+  /* Free vectors */
+  N_VDestroy(X);
+
+  FinalizeClearCache();
+
+  flag = SUNContext_Free(&ctx);
+  if (flag) { return flag; }
+
+  printf("\nFinished Tests\n");
+
+  return (flag);
+}
+
+/* ----------------------------------------------------------------------
+ * Functions required by testing routines to fill vector data
+ * --------------------------------------------------------------------*/
+
+/* The data is generated in full precision and rounded into the vector */
+
+/* random data between lower and upper */
+void N_VRand(N_Vector Xvec, sunindextype Xlen, sunrealtype lower,
+             sunrealtype upper)
+{
+  sunrealtype* Xdata;
+
+  Xdata = (sunrealtype*)malloc(Xlen * sizeof(sunrealtype));
+  rand_realtype(Xdata, Xlen, lower, upper);
+  N_VCopyFromArray_Mixed(Xdata, Xvec);
+  free(Xdata);
+}
+
+/* series of 0 and 1 */
+void N_VRandZeroOne(N_Vector Xvec, sunindextype Xlen)
+{
+  sunrealtype* Xdata;
+
+  Xdata = (sunrealtype*)malloc(Xlen * sizeof(sunrealtype));
+  rand_realtype_zero_one(Xdata, Xlen);
+  N_VCopyFromArray_Mixed(Xdata, Xvec);
+  free(Xdata);
+}
+
+/* random values for constraint array */
+void N_VRandConstraints(N_Vector Xvec, sunindextype Xlen)
+{
+  sunrealtype* Xdata;
+
+  Xdata = (sunrealtype*)malloc(Xlen * sizeof(sunrealtype));
+  rand_realtype_constraints(Xdata, Xlen);
+  N_VCopyFromArray_Mixed(Xdata, Xvec);
+  free(Xdata);
+}
+
+/* ----------------------------------------------------------------------
+ * Functions required for MPI or GPU testing
+ * --------------------------------------------------------------------*/
+
+void collect_times(N_Vector X, double* times, int ntimes)
+{
+  /* not running with MPI, just return */
+  return;
+}
+
+void sync_device(N_Vector x)
+{
+  /* not running on GPU, just return */
+  return;
+}
+
+/* ----------------------------------------------------------------------
+ * Comparison to the full precision serial vector
+ * --------------------------------------------------------------------*/
+
+static double mixed_time(void)
+{
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS) && defined(_POSIX_TIMERS)
+  struct timespec spec;
+  clock_gettime(CLOCK_MONOTONIC, &spec);
+  return (double)spec.tv_sec + ((double)spec.tv_nsec) / 1E9;
+#else
+  return 0.0;
+#endif
+}
+
+/* average time of ntests calls of operation op, the result of the last call
+   (a reduction or the L1 norm of the output vector) is returned in res */
+static double mixed_time_op(int op, N_Vector* V, int nvecs, sunrealtype* c,
+                            int ntests, sunrealtype* res)
+{
+  double start, stop;
+  sunrealtype r = ZERO;
+  int i;
+
+  start = mixed_time();
+  for (i = 0; i < ntests; i++)
+  {
+    switch (op)
+    {
+    case 0: N_VLinearSum(TWO, V[0], NEG_ONE, V[1], V[2]); break;
+    case 1: N_VProd(V[0], V[1], V[2]); break;
+    case 2: r = N_VDotProd(V[0], V[1]); break;
+    case 3: r = N_VMaxNorm(V[0]); break;
+    case 4: r = N_VWrmsNorm(V[0], V[1]); break;
+    case 5: r = N_VWrmsNormMask(V[0], V[1], V[2]); break;
+    case 6: r = N_VL1Norm(V[0]); break;
+    case 7: r = N_VMinQuotient(V[0], V[1]); break;
+    case 8: N_VLinearCombination(nvecs, c, V + 1, V[0]); break;
+    case 9: N_VScaleAddMulti(nvecs, c, V[0], V + 1, V + 1); break;
+    case 10: N_VDotProdMulti(nvecs, V[0], V + 1, c); break;
+    }
+  }
+  stop = mixed_time();
+
+  /* streaming operations are compared by the L1 norm of their output */
+  switch (op)
+  {
+  case 0:
+  case 1: r = N_VL1Norm(V[2]); break;
+  case 8: r = N_VL1Norm(V[0]); break;
+  case 9: r = N_VL1Norm(V[1]); break;
+  case 10: r = c[0]; break;
+  }
+  *res = r;
+
+  return (stop - start) / ntests;
+}
+
+static void PrintMixedComparison(N_Vector X, int nvecs, int ntests)
+{
+  static const char* names[] = {"N_VLinearSum",
+                                "N_VProd",
+                                "N_VDotProd",
+                                "N_VMaxNorm",
+                                "N_VWrmsNorm",
+                                "N_VWrmsNormMask",
+                                "N_VL1Norm",
+                                "N_VMinQuotient",
+                                "N_VLinearCombination",
+                                "N_VScaleAddMulti",
+                                "N_VDotProdMulti"};
+  sunindextype len = N_VGetLength(X);
+  int nv           = SUNMAX(nvecs, 3);
+  int i, op, nops;
+  double tserial, tmixed, reldiff;
+  sunrealtype rserial, rmixed;
+  N_Vector *S, *V;
+  sunrealtype *c, *vals;
+
+  S    = (N_Vector*)malloc((nv + 1) * sizeof(N_Vector));
+  V    = N_VCloneVectorArray(nv + 1, X);
+  c    = (sunrealtype*)malloc(nv * sizeof(sunrealtype));
+  vals = (sunrealtype*)malloc(len * sizeof(sunrealtype));
+
+  /* both vectors start from the same values, rounded to float, and the third
+     vector is a mask for the masked norm */
+  for (i = 0; i <= nv; i++)
+  {
+    if (i == 2) { rand_realtype_zero_one(vals, len); }
+    else { rand_realtype(vals, len, NEG_ONE, ONE); }
+    N_VCopyFromArray_Mixed(vals, V[i]);
+    S[i] = N_VNew_Serial(len, X->sunctx);
+    N_VCopyToArray_Mixed(V[i], N_VGetArrayPointer(S[i]));
+    N_VEnableFusedOps_Serial(S[i], SUNTRUE);
+    N_VEnableFusedOps_Mixed(V[i], SUNTRUE);
+  }
+
+  /* fused operations are only compared when nvecs > 0 */
+  nops = (nvecs > 0) ? 11 : 8;
+
+  printf("\n\n comparison to the full precision serial vector:\n");
+  printf("\n%33s %22s %22s %12s %12s\n", "Operation", "Avg Serial",
+         "Avg Mixed", "Speedup", "Rel. Diff");
+  for (op = 0; op < nops; op++)
+  {
+    for (i = 0; i < nv; i++) { c[i] = ONE / (i + 1); }
+    tserial = mixed_time_op(op, S, nvecs, c, ntests, &rserial);
+    for (i = 0; i < nv; i++) { c[i] = ONE / (i + 1); }
+    tmixed  = mixed_time_op(op, V, nvecs, c, ntests, &rmixed);
+    reldiff = (double)SUNRabs(rmixed - rserial);
+    if (rserial != ZERO) { reldiff /= (double)SUNRabs(rserial); }
+    printf("%33s %22.15e %22.15e %12.3f %12.3e\n", names[op], tserial, tmixed,
+           (tmixed > 0.0) ? tserial / tmixed : 0.0, reldiff);
+  }
+
+  for (i = 0; i <= nv; i++) { N_VDestroy(S[i]); }
+  N_VDestroyVectorArray(V, nv + 1);
+  free(S);
+  free(c);
+  free(vals);
+}
+
+/* ----------------------------------------------------------------------
+ * Functions required for clearing cache
+ * --------------------------------------------------------------------*/
+
+static int InitializeClearCache(int cachesize)
+{
+  size_t nbytes; /* cache size in bytes */
+
+  if (!cachesize)
+  {
+    N    = 0;
+    data = NULL;
+    return 0;
+  }
+
+  /* determine size of vector to clear cache, N = ceil(2 * nbytes/sunrealtype) */
+  nbytes = (size_t)(2 * cachesize * 1024 * 1024);
+  N = (sunindextype)((nbytes + sizeof(sunrealtype) - 1) / sizeof(sunrealtype));
+
+  /* allocate data and fill random values */
+  data = (sunrealtype*)malloc(N * sizeof(sunrealtype));
+  rand_realtype(data, N, SUN_RCONST(-1.0), SUN_RCONST(1.0));
+
+  return (0);
+}
+
+static int FinalizeClearCache()
+{
+  if (data) { free(data); }
+  return (0);
+}
+
+void ClearCache()
+{
+  if (data)
+  {
+    sunrealtype sum;
+    sunindextype i;
+
+    sum = SUN_RCONST(0.0);
+    for (i = 0; i < N; i++) { sum += data[i]; }
+    (void)sum;
+  }
+
+  return;
+}
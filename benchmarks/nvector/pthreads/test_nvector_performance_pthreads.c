@@ -46,6 +46,8 @@ int main(int argc, char* argv[])
   int nsums;        /* number of sums     */
   int cachesize;    /* size of cache (MB) */
   int nthreads;     /* number of threads  */
+  long int nserial; /* serial length      */
+  int nspin;        /* spin count         */
   int flag;         /* return flag        */
 
   printf("\nStart Tests\n");
@@ -57,7 +59,8 @@ int main(int argc, char* argv[])
     printf("ERROR: SEVEN (7) arguments required: ");
     printf("<vector length> <number of vectors> <number of sums> <number of "
            "tests> ");
-    printf("<cache size (MB)> <print timing> <number of threads>\n");
+    printf("<cache size (MB)> <print timing> <number of threads> ");
+    printf("[serial length] [spin count]\n");
     return (-1);
   }
 
@@ -99,6 +102,23 @@ int main(int argc, char* argv[])
     return (-1);
   }
 
+  /* optional worker pool settings, vectors shorter than the serial length are
+     computed by the calling thread only and idle threads poll spin count
+     times for work before sleeping */
+  nserial = (argc > 8) ? atol(argv[8]) : 0;
+  if (nserial < 0)
+  {
+    printf("ERROR: serial length must be a non-negative integer \n");
+    return (-1);
+  }
+
+  nspin = (argc > 9) ? atoi(argv[9]) : 0;
+  if (nspin < 0)
+  {
+    printf("ERROR: spin count must be a non-negative integer \n");
+    return (-1);
+  }
+
   printf("\nRunning with: \n");
   printf("  vector length         %ld \n", (long int)veclen);
   printf("  max number of vectors %d  \n", nvecs);
@@ -106,12 +126,16 @@ int main(int argc, char* argv[])
   printf("  number of tests       %d  \n", ntests);
   printf("  timing on/off         %d  \n", print_timing);
   printf("  number of threads     %d  \n", nthreads);
+  printf("  serial length         %ld \n", nserial);
+  printf("  spin count            %d  \n", nspin);
 
   flag = SUNContext_Create(SUN_COMM_NULL, &ctx);
   if (flag) { return flag; }
 
   /* Create vectors */
   X = N_VNew_Pthreads(veclen, nthreads, ctx);
+  N_VSetSerialLength_Pthreads(X, (sunindextype)nserial);
+  N_VSetSpinCount_Pthreads(X, nspin);
 
   /* run tests */
   if (print_timing) { printf("\n\n standard operations:\n"); }
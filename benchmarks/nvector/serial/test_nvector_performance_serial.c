@@ -22,11 +22,17 @@
 #include <sundials/sundials_math.h>
 #include <sundials/sundials_types.h>
 
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS)
+#include <time.h>
+#include <unistd.h>
+#endif
+
 #include "test_nvector_performance.h"
 
 /* private functions */
 static int InitializeClearCache(int cachesize);
 static int FinalizeClearCache();
+static void PrintSIMDSpeedup(N_Vector X, int nvecs, int ntests);
 
 /* private data for clearing cache */
 static sunindextype N;    /* data length */
@@ -154,6 +160,9 @@ int main(int argc, char* argv[])
     }
   }
 
+  /* compare the SIMD kernels to the scalar loops */
+  if (print_timing) { PrintSIMDSpeedup(X, nvecs, ntests); }
+
   /* Free vectors */
   N_VDestroy(X);
 
@@ -215,6 +224,111 @@ void sync_device(N_Vector x)
   return;
 }
 
+/* ----------------------------------------------------------------------
+ * SIMD speedup
+ * --------------------------------------------------------------------*/
+
+static double simd_time(void)
+{
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS) && defined(_POSIX_TIMERS)
+  struct timespec spec;
+  clock_gettime(CLOCK_MONOTONIC, &spec);
+  return (double)spec.tv_sec + ((double)spec.tv_nsec) / 1E9;
+#else
+  return 0.0;
+#endif
+}
+
+/* average time of ntests calls of operation op */
+static double simd_time_op(int op, N_Vector* V, int nvecs, sunrealtype* c,
+                           int ntests)
+{
+  double start;
+  int i;
+
+  /* warmup */
+  N_VLinearSum(TWO, V[0], TEN, V[1], V[2]);
+
+  start = simd_time();
+  for (i = 0; i < ntests; i++)
+  {
+    switch (op)
+    {
+    case 0: N_VLinearSum(TWO, V[0], TEN, V[1], V[2]); break;
+    case 1: (void)N_VDotProd(V[0], V[1]); break;
+    case 2: (void)N_VMaxNorm(V[0]); break;
+    case 3: (void)N_VWrmsNorm(V[0], V[1]); break;
+    case 4: (void)N_VWrmsNormMask(V[0], V[1], V[2]); break;
+    case 5: (void)N_VMin(V[0]); break;
+    case 6: (void)N_VL1Norm(V[0]); break;
+    case 7: (void)N_VMinQuotient(V[0], V[1]); break;
+    case 8: N_VLinearCombination(nvecs, c, V + 1, V[0]); break;
+    case 9: N_VScaleAddMulti(nvecs, c, V[0], V + 1, V + 1); break;
+    case 10: N_VDotProdMulti(nvecs, V[0], V + 1, c); break;
+    }
+  }
+  return (simd_time() - start) / ntests;
+}
+
+static void PrintSIMDSpeedup(N_Vector X, int nvecs, int ntests)
+{
+  static const char* names[] = {"N_VLinearSum",
+                                "N_VDotProd",
+                                "N_VMaxNorm",
+                                "N_VWrmsNorm",
+                                "N_VWrmsNormMask",
+                                "N_VMin",
+                                "N_VL1Norm",
+                                "N_VMinQuotient",
+                                "N_VLinearCombination",
+                                "N_VScaleAddMulti",
+                                "N_VDotProdMulti"};
+  N_VSIMDLevel level = N_VSIMD_AVX512;
+  sunindextype len   = N_VGetLength(X);
+  int nv             = SUNMAX(nvecs, 3);
+  int i, op, nops;
+  double tscalar, tsimd;
+  N_Vector* V;
+  sunrealtype* c;
+
+  /* the scalar loops are the default, compare with the widest kernels */
+  while (level > N_VSIMD_NONE && N_VSetSIMDLevel_Serial(level))
+  {
+    level = (N_VSIMDLevel)(level - 1);
+  }
+  if (level == N_VSIMD_NONE)
+  {
+    printf("\n\n SIMD kernels are not available\n");
+    return;
+  }
+
+  V = N_VCloneVectorArray(nv + 1, X);
+  c = (sunrealtype*)malloc(nv * sizeof(sunrealtype));
+  for (i = 0; i <= nv; i++) { N_VRand(V[i], len, NEG_ONE, ONE); }
+  for (i = 0; i < nv; i++) { c[i] = ONE / (i + 1); }
+  for (i = 0; i <= nv; i++) { N_VEnableFusedOps_Serial(V[i], SUNTRUE); }
+
+  /* fused operations are only compared when nvecs > 0 */
+  nops = (nvecs > 0) ? 11 : 8;
+
+  printf("\n\n SIMD speedup: level %d\n", (int)level);
+  printf("\n%33s %22s %22s %22s\n", "Operation", "Avg Scalar", "Avg SIMD",
+         "Speedup");
+  for (op = 0; op < nops; op++)
+  {
+    N_VSetSIMDLevel_Serial(N_VSIMD_NONE);
+    tscalar = simd_time_op(op, V, nvecs, c, ntests);
+    N_VSetSIMDLevel_Serial(level);
+    tsimd = simd_time_op(op, V, nvecs, c, ntests);
+    printf("%33s %22.15e %22.15e %22.3f\n", names[op], tscalar, tsimd,
+           (tsimd > 0.0) ? tscalar / tsimd : 0.0);
+  }
+  N_VSetSIMDLevel_Serial(N_VSIMD_NONE);
+
+  N_VDestroyVectorArray(V, nv + 1);
+  free(c);
+}
+
 /* ----------------------------------------------------------------------
  * Functions required for clearing cache
  * --------------------------------------------------------------------*/
@@ -20,14 +20,8 @@
 # Currently only available in CVODE.
 # ---------------------------------------------------------------
 
-if(ENABLE_CUDA OR ENABLE_HIP)
-  set(CUDA_OR_HIP TRUE)
-else()
-  set(CUDA_OR_HIP FALSE)
-endif()
-
-sundials_option(SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS BOOL "Build specialized fused GPU kernels" OFF
-                DEPENDS_ON BUILD_CVODE CUDA_OR_HIP
+sundials_option(SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS BOOL "Build specialized fused CPU and GPU kernels" OFF
+                DEPENDS_ON BUILD_CVODE
                 DEPENDS_ON_THROW_ERROR)
 
 # ---------------------------------------------------------------
@@ -112,6 +106,14 @@ sundials_option(BUILD_NVECTOR_KOKKOS BOOL "Build the NVECTOR_KOKKOS module (requ
                 ADVANCED)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_NVECTOR_KOKKOS")
 
+sundials_option(BUILD_NVECTOR_LAZY BOOL "Build the NVECTOR_LAZY module" ON
+                ADVANCED)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_NVECTOR_LAZY")
+
+sundials_option(BUILD_NVECTOR_MIXED BOOL "Build the NVECTOR_MIXED module" ON
+                ADVANCED)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_NVECTOR_MIXED")
+
 
 # ---------------------------------------------------------------
 # Options to enable/disable build for SUNMATRIX modules.
@@ -125,6 +127,10 @@ list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_DENSE")
 set(BUILD_SUNMATRIX_SPARSE TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_SPARSE")
 
+sundials_option(BUILD_SUNMATRIX_BLOCKSPARSE BOOL "Build the SUNMATRIX_BLOCKSPARSE module" ON
+                ADVANCED)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNMATRIX_BLOCKSPARSE")
+
 set(_COMPATIBLE_INDEX_SIZE FALSE)
 if(SUNDIALS_INDEX_SIZE MATCHES "32")
   set(_COMPATIBLE_INDEX_SIZE TRUE)
@@ -168,6 +174,8 @@ set(BUILD_SUNLINSOL_BAND TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_BAND")
 set(BUILD_SUNLINSOL_DENSE TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_DENSE")
+set(BUILD_SUNLINSOL_GCRODR TRUE)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_GCRODR")
 set(BUILD_SUNLINSOL_PCG TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_PCG")
 set(BUILD_SUNLINSOL_SPBCGS TRUE)
@@ -179,6 +187,19 @@ list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_SPGMR")
 set(BUILD_SUNLINSOL_SPTFQMR TRUE)
 list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_SPTFQMR")
 
+sundials_option(BUILD_SUNLINSOL_BATCHEDDENSE BOOL "Build the SUNLINSOL_BATCHEDDENSE module" ON
+                DEPENDS_ON BUILD_SUNMATRIX_BLOCKSPARSE
+                ADVANCED)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_BATCHEDDENSE")
+
+sundials_option(BUILD_SUNLINSOL_ILU BOOL "Build the SUNLINSOL_ILU module" ON
+                ADVANCED)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_ILU")
+
+sundials_option(BUILD_SUNLINSOL_CHEBYSHEV BOOL "Build the SUNLINSOL_CHEBYSHEV module" ON
+                ADVANCED)
+list(APPEND SUNDIALS_BUILD_LIST "BUILD_SUNLINSOL_CHEBYSHEV")
+
 sundials_option(BUILD_SUNLINSOL_CUSOLVERSP BOOL "Build the SUNLINSOL_CUSOLVERSP module (requires CUDA and 32-bit indexing)" ON
                 DEPENDS_ON ENABLE_CUDA CMAKE_CUDA_COMPILER BUILD_NVECTOR_CUDA BUILD_SUNMATRIX_CUSPARSE
                 ADVANCED)
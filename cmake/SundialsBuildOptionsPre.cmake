@@ -68,6 +68,13 @@ if(SUNDIALS_BUILD_WITH_PROFILING)
   message(WARNING "SUNDIALS built with profiling turned on, performance may be affected.")
 endif()
 
+# ---------------------------------------------------------------
+# Option to enable/disable the x86 SIMD kernels
+# ---------------------------------------------------------------
+
+set(DOCSTR "Build the x86 SIMD kernels of the serial vector and dense LU factorization when the compiler supports them")
+sundials_option(SUNDIALS_ENABLE_SIMD_KERNELS BOOL "${DOCSTR}" ON ADVANCED)
+
 # ---------------------------------------------------------------
 # Option to enable/disable error checking
 # ---------------------------------------------------------------
@@ -229,6 +229,63 @@ check_c_source_compiles("
   }
 " SUNDIALS_C_COMPILER_HAS_ATTRIBUTE_UNUSED)
 
+# ---------------------------------------------------------------
+# Check for thread local storage
+# ---------------------------------------------------------------
+
+# Prefer the GNU extension since _Thread_local is only valid in C11 and gives
+# pedantic warnings with the C99 standard
+check_c_source_compiles("
+  static __thread int x = 0;
+  int main(void) { x++; return x - 1; }
+" SUNDIALS_C_COMPILER_HAS_GNU_THREAD_LOCAL)
+if(SUNDIALS_C_COMPILER_HAS_GNU_THREAD_LOCAL)
+  set(SUNDIALS_THREAD_LOCAL "__thread")
+else()
+  check_c_source_compiles("
+    #if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L
+    #error _Thread_local requires C11
+    #endif
+    static _Thread_local int x = 0;
+    int main(void) { x++; return x - 1; }
+  " SUNDIALS_C_COMPILER_HAS_C11_THREAD_LOCAL)
+  if(SUNDIALS_C_COMPILER_HAS_C11_THREAD_LOCAL)
+    set(SUNDIALS_THREAD_LOCAL "_Thread_local")
+  else()
+    check_c_source_compiles("
+      static __declspec(thread) int x = 0;
+      int main(void) { x++; return x - 1; }
+    " SUNDIALS_C_COMPILER_HAS_DECLSPEC_THREAD_LOCAL)
+    if(SUNDIALS_C_COMPILER_HAS_DECLSPEC_THREAD_LOCAL)
+      set(SUNDIALS_THREAD_LOCAL "__declspec(thread)")
+    endif()
+  endif()
+endif()
+
+# ---------------------------------------------------------------
+# Check for x86 function target attributes
+# ---------------------------------------------------------------
+
+# The SIMD kernels are compiled with function target attributes and selected
+# at run time, so the libraries do not need to be built for a particular CPU
+set(SUNDIALS_X86_SIMD_KERNELS FALSE)
+if(SUNDIALS_ENABLE_SIMD_KERNELS)
+  check_c_source_compiles("
+    #include <immintrin.h>
+    __attribute__((target(\"avx512f\"))) static double f(const double* x)
+    { return _mm512_reduce_add_pd(_mm512_abs_pd(_mm512_loadu_pd(x))); }
+    int main(void)
+    {
+      double x[8] = {0};
+      __builtin_cpu_init();
+      return __builtin_cpu_supports(\"avx512f\") ? (int)f(x) : 0;
+    }
+  " SUNDIALS_C_COMPILER_HAS_X86_TARGET_ATTRIBUTES)
+  if(SUNDIALS_C_COMPILER_HAS_X86_TARGET_ATTRIBUTES)
+    set(SUNDIALS_X86_SIMD_KERNELS TRUE)
+  endif()
+endif()
+
 # ---------------------------------------------------------------
 # Check for POSIX timers
 # ---------------------------------------------------------------
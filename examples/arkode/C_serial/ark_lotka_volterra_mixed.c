@@ -0,0 +1,331 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Example problem:
+ *
+ * This example integrates an ensemble of M independent
+ * Lotka-Volterra predator-prey systems,
+ *    u_j' =  a*u_j - b*u_j*v_j
+ *    v_j' = -c*v_j + d*u_j*v_j
+ * for t in [0, 10] with a = 1.5, b = 1, c = 3, d = 1 and the
+ * initial conditions u_j(0) = 1 + j/M, v_j(0) = 1. Each system
+ * conserves the quantity
+ *    H_j = d*u_j - c*log(u_j) + b*v_j - a*log(v_j),
+ * whose drift measures the accuracy of the solution.
+ *
+ * The problem is non-stiff and is solved with the default ERK
+ * method of ERKStep, first with an NVECTOR_SERIAL vector and
+ * then with an NVECTOR_MIXED vector that stores the solution
+ * and the stage vectors in single precision. The right-hand
+ * side function works on the float data of the mixed vector
+ * directly. The run statistics, the largest drift of H_j, and
+ * the difference between the two solutions are printed. With
+ * the optional second argument set to 1 the run times are also
+ * printed, which shows the throughput gained by the smaller
+ * memory traffic of the mixed vector for large ensembles.
+ *
+ * Usage: ark_lotka_volterra_mixed [M] [print timing]
+ *---------------------------------------------------------------*/
+
+/* Header files */
+#include <arkode/arkode_erkstep.h> /* prototypes for ERKStep fcts., consts */
+#include <math.h>
+#include <nvector/nvector_mixed.h>  /* mixed-precision N_Vector             */
+#include <nvector/nvector_serial.h> /* serial N_Vector types, fcts., macros */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_types.h> /* def. of type 'sunrealtype' */
+#include <time.h>
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* problem parameters */
+#define A SUN_RCONST(1.5)
+#define B SUN_RCONST(1.0)
+#define C SUN_RCONST(3.0)
+#define D SUN_RCONST(1.0)
+
+/* user data structure */
+typedef struct
+{
+  sunindextype M;       /* number of systems            */
+  sunbooleantype mixed; /* SUNTRUE for the mixed vector */
+}* UserData;
+
+/* statistics of a run */
+typedef struct
+{
+  long int nst, nfe;     /* number of steps and RHS evals  */
+  sunrealtype max_drift; /* largest drift of the invariant */
+  double time;           /* run time (s)                   */
+} RunStats;
+
+/* User-supplied Functions Called by the Solver */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data);
+
+/* Private functions */
+static int Solve(N_Vector y, UserData udata, sunrealtype* ysol,
+                 RunStats* stats);
+static sunrealtype Invariant(sunrealtype u, sunrealtype v);
+static int check_flag(void* flagvalue, const char* funcname, int opt);
+
+/* Main Program */
+int main(int argc, char* argv[])
+{
+  /* general problem variables */
+  int flag;                /* reusable error-checking flag    */
+  int print_timing = 0;    /* print run times                 */
+  N_Vector y       = NULL; /* solution vector                 */
+  sunrealtype *ys, *ym;    /* final solutions of the two runs */
+  sunrealtype diff, nrm;   /* difference between the two runs */
+  RunStats serial, mixed;  /* statistics of the two runs      */
+  UserData udata = NULL;
+  sunindextype i;
+
+  /* Create the SUNDIALS context object for this simulation */
+  SUNContext ctx;
+  flag = SUNContext_Create(SUN_COMM_NULL, &ctx);
+  if (check_flag(&flag, "SUNContext_Create", 1)) { return 1; }
+
+  /* allocate and fill udata structure */
+  udata    = (UserData)malloc(sizeof(*udata));
+  udata->M = 1000;
+  if (argc > 1) { udata->M = (sunindextype)atol(argv[1]); }
+  if (argc > 2) { print_timing = atoi(argv[2]); }
+  if (udata->M < 1)
+  {
+    printf("ERROR: the number of systems must be a positive integer\n");
+    return 1;
+  }
+
+  /* Initial problem output */
+  printf("\nLotka-Volterra ensemble with mixed-precision vectors:\n");
+  printf("  number of systems: M = %li\n", (long int)udata->M);
+
+  ys = (sunrealtype*)malloc(2 * udata->M * sizeof(sunrealtype));
+  ym = (sunrealtype*)malloc(2 * udata->M * sizeof(sunrealtype));
+
+  /* Solve with the full precision serial vector */
+  y = N_VNew_Serial(2 * udata->M, ctx);
+  if (check_flag((void*)y, "N_VNew_Serial", 0)) { return 1; }
+  udata->mixed = SUNFALSE;
+  if (Solve(y, udata, ys, &serial)) { return 1; }
+  N_VDestroy(y);
+
+  /* Solve with the mixed-precision vector */
+  y = N_VNew_Mixed(2 * udata->M, ctx);
+  if (check_flag((void*)y, "N_VNew_Mixed", 0)) { return 1; }
+  udata->mixed = SUNTRUE;
+  if (Solve(y, udata, ym, &mixed)) { return 1; }
+  N_VDestroy(y);
+
+  /* relative difference between the two solutions */
+  diff = SUN_RCONST(0.0);
+  nrm  = SUN_RCONST(0.0);
+  for (i = 0; i < 2 * udata->M; i++)
+  {
+    diff = SUNMAX(diff, SUNRabs(ym[i] - ys[i]));
+    nrm  = SUNMAX(nrm, SUNRabs(ys[i]));
+  }
+
+  /* Print some final statistics */
+  printf("\n%22s %14s %14s\n", "", "serial", "mixed");
+  printf("%22s %14ld %14ld\n", "steps", serial.nst, mixed.nst);
+  printf("%22s %14ld %14ld\n", "RHS evals", serial.nfe, mixed.nfe);
+  printf("%22s %14.2" ESYM " %14.2" ESYM "\n", "max invariant drift",
+         serial.max_drift, mixed.max_drift);
+  if (print_timing)
+  {
+    printf("%22s %14.4e %14.4e\n", "run time (s)", serial.time, mixed.time);
+  }
+  printf("\n  max relative difference of the solutions = %.2" ESYM "\n",
+         diff / nrm);
+
+  /* Clean up and return */
+  free(ys);
+  free(ym);
+  free(udata);
+  SUNContext_Free(&ctx);
+
+  return 0;
+}
+
+/*-------------------------------
+ * Functions called by the solver
+ *-------------------------------*/
+
+/* f routine to compute the ODE RHS function f(t,y). */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  UserData udata = (UserData)user_data;
+  sunindextype j;
+  sunrealtype u, v;
+
+  if (udata->mixed)
+  {
+    /* the data is read and written as float, the arithmetic is done in
+       sunrealtype */
+    float* Y  = N_VGetFloatArrayPointer_Mixed(y);
+    float* dY = N_VGetFloatArrayPointer_Mixed(ydot);
+    for (j = 0; j < udata->M; j++)
+    {
+      u             = (sunrealtype)Y[2 * j];
+      v             = (sunrealtype)Y[2 * j + 1];
+      dY[2 * j]     = (float)(A * u - B * u * v);
+      dY[2 * j + 1] = (float)(-C * v + D * u * v);
+    }
+  }
+  else
+  {
+    sunrealtype* Y  = N_VGetArrayPointer(y);
+    sunrealtype* dY = N_VGetArrayPointer(ydot);
+    for (j = 0; j < udata->M; j++)
+    {
+      u             = Y[2 * j];
+      v             = Y[2 * j + 1];
+      dY[2 * j]     = A * u - B * u * v;
+      dY[2 * j + 1] = -C * v + D * u * v;
+    }
+  }
+
+  return 0;
+}
+
+/*-------------------------------
+ * Private helper functions
+ *-------------------------------*/
+
+/* integrates the ensemble with the vector y and returns the final solution
+   in ysol and the run statistics in stats */
+static int Solve(N_Vector y, UserData udata, sunrealtype* ysol,
+                 RunStats* stats)
+{
+  sunrealtype T0   = SUN_RCONST(0.0);    /* initial time       */
+  sunrealtype Tf   = SUN_RCONST(10.0);   /* final time         */
+  sunrealtype rtol = SUN_RCONST(1.0e-5); /* relative tolerance */
+  sunrealtype atol = SUN_RCONST(1.0e-8); /* absolute tolerance */
+  void* arkode_mem = NULL;
+  sunrealtype t, H0;
+  sunindextype j;
+  clock_t start;
+  int flag;
+
+  /* Set the initial conditions in full precision */
+  for (j = 0; j < udata->M; j++)
+  {
+    ysol[2 * j]     = SUN_RCONST(1.0) + (sunrealtype)j / (sunrealtype)udata->M;
+    ysol[2 * j + 1] = SUN_RCONST(1.0);
+  }
+  if (udata->mixed) { N_VCopyFromArray_Mixed(ysol, y); }
+  else
+  {
+    for (j = 0; j < 2 * udata->M; j++) { NV_Ith_S(y, j) = ysol[j]; }
+  }
+
+  /* Call ERKStepCreate to initialize the ERK timestepper module */
+  arkode_mem = ERKStepCreate(f, T0, y, y->sunctx);
+  if (check_flag((void*)arkode_mem, "ERKStepCreate", 0)) { return 1; }
+
+  flag = ARKodeSetUserData(arkode_mem, (void*)udata);
+  if (check_flag(&flag, "ARKodeSetUserData", 1)) { return 1; }
+  flag = ARKodeSStolerances(arkode_mem, rtol, atol);
+  if (check_flag(&flag, "ARKodeSStolerances", 1)) { return 1; }
+  flag = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (check_flag(&flag, "ARKodeSetMaxNumSteps", 1)) { return 1; }
+
+  /* Integrate to the final time */
+  start = clock();
+  flag  = ARKodeEvolve(arkode_mem, Tf, y, &t, ARK_NORMAL);
+  if (check_flag(&flag, "ARKodeEvolve", 1)) { return 1; }
+  stats->time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  flag = ARKodeGetNumSteps(arkode_mem, &stats->nst);
+  check_flag(&flag, "ARKodeGetNumSteps", 1);
+  flag = ERKStepGetNumRhsEvals(arkode_mem, &stats->nfe);
+  check_flag(&flag, "ERKStepGetNumRhsEvals", 1);
+
+  /* Compute the largest drift of the invariant */
+  if (udata->mixed) { N_VCopyToArray_Mixed(y, ysol); }
+  else
+  {
+    for (j = 0; j < 2 * udata->M; j++) { ysol[j] = NV_Ith_S(y, j); }
+  }
+  stats->max_drift = SUN_RCONST(0.0);
+  for (j = 0; j < udata->M; j++)
+  {
+    H0 = Invariant(SUN_RCONST(1.0) + (sunrealtype)j / (sunrealtype)udata->M,
+                   SUN_RCONST(1.0));
+    stats->max_drift =
+      SUNMAX(stats->max_drift,
+             SUNRabs(Invariant(ysol[2 * j], ysol[2 * j + 1]) - H0) / H0);
+  }
+
+  ARKodeFree(&arkode_mem);
+
+  return 0;
+}
+
+/* conserved quantity of a Lotka-Volterra system */
+static sunrealtype Invariant(sunrealtype u, sunrealtype v)
+{
+  return (D * u - C * log(u) + B * v - A * log(v));
+}
+
+/* Check function return value...
+    opt == 0 means SUNDIALS function allocates memory so check if
+             returned NULL pointer
+    opt == 1 means SUNDIALS function returns a flag so check if
+             flag >= 0
+    opt == 2 means function allocates memory so check if returned
+             NULL pointer
+*/
+static int check_flag(void* flagvalue, const char* funcname, int opt)
+{
+  int* errflag;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && flagvalue == NULL)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1;
+  }
+
+  /* Check if flag < 0 */
+  else if (opt == 1)
+  {
+    errflag = (int*)flagvalue;
+    if (*errflag < 0)
+    {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with flag = %d\n\n",
+              funcname, *errflag);
+      return 1;
+    }
+  }
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && flagvalue == NULL)
+  {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return 1;
+  }
+
+  return 0;
+}
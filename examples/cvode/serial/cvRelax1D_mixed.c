@@ -0,0 +1,437 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The following stiff system models a chain of N cells that
+ * exchange heat with their neighbors and relax toward a common
+ * oscillating temperature,
+ *   u_i' = k*(u_{i-1} - 2*u_i + u_{i+1}) - lambda_i*(u_i - cos(t))
+ *          - sin(t),
+ *   lambda_i = 10^(4*x_i),  x_i = i/(N-1),
+ * for i = 0, ..., N-1 and t in [0, 20], with k = 1, reflecting
+ * ends (u_{-1} = u_1, u_N = u_{N-2}), and the initial condition
+ *   u_i(0) = 1 + 0.5*cos(pi*x_i).
+ * The perturbation of the initial condition decays at least like
+ * exp(-t), so the solution at the final time is u_i = cos(20) up
+ * to about 1e-9. The relaxation rates span four orders of
+ * magnitude and do not depend on N.
+ *
+ * The problem is solved with the BDF method of CVODE, the
+ * SUNLinSol_SPGMR linear solver, and a left Jacobi
+ * preconditioner, first with an NVECTOR_SERIAL vector and then
+ * with an NVECTOR_MIXED vector that stores the solution, the
+ * history array, and the Krylov basis in single precision. The
+ * preconditioner is built from vector operations only, while the
+ * right-hand side function converts the mixed vector data with
+ * N_VCopyToArray_Mixed and N_VCopyFromArray_Mixed. The run
+ * statistics, the error of each solution, and the difference
+ * between the two solutions are printed. With the optional
+ * second argument set to 1 the run times are also printed.
+ *
+ * Usage: cvRelax1D_mixed [N] [print timing]
+ * -----------------------------------------------------------------*/
+
+#include <cvode/cvode.h> /* prototypes for CVODE fcts., consts.  */
+#include <math.h>
+#include <nvector/nvector_mixed.h>  /* access to mixed-precision N_Vector */
+#include <nvector/nvector_serial.h> /* access to serial N_Vector          */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_types.h> /* defs. of sunrealtype, sunindextype */
+#include <sunlinsol/sunlinsol_spgmr.h> /* access to SPGMR SUNLinearSolver */
+#include <time.h>
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* Problem Constants */
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define PI    SUN_RCONST(3.141592653589793238462643383279502884197169)
+#define KDIFF SUN_RCONST(1.0)    /* exchange rate         */
+#define T0    ZERO               /* initial time          */
+#define TF    SUN_RCONST(20.0)   /* final time            */
+#define RTOL  SUN_RCONST(1.0e-5) /* relative tolerance    */
+#define ATOL  SUN_RCONST(1.0e-8) /* absolute tolerance    */
+
+/* Type : UserData contains the problem data and the preconditioner */
+
+typedef struct
+{
+  sunindextype N;       /* number of cells                          */
+  sunrealtype dx;       /* cell spacing                             */
+  sunrealtype* lam;     /* relaxation rates                         */
+  sunbooleantype mixed; /* SUNTRUE for the mixed vector             */
+  sunrealtype *Y, *F;   /* sunrealtype copies of mixed vector data  */
+  N_Vector lambda;      /* relaxation rates for the preconditioner  */
+  N_Vector pinv;        /* inverse of the preconditioner diagonal   */
+}* UserData;
+
+/* Type : RunStats contains the statistics of a run */
+
+typedef struct
+{
+  long int nst, nfe, nni, nli, npe; /* integrator and solver counters */
+  sunrealtype err;                  /* max error at the final time    */
+  double time;                      /* run time (s)                   */
+} RunStats;
+
+/* Private Helper Functions */
+
+static int Solve(N_Vector u, UserData data, sunrealtype* usol,
+                 RunStats* stats);
+static int check_retval(void* returnvalue, const char* funcname, int opt);
+
+/* Functions Called by the Solver */
+
+static int f(sunrealtype t, N_Vector u, N_Vector udot, void* user_data);
+
+static int Precond(sunrealtype tn, N_Vector u, N_Vector fu, sunbooleantype jok,
+                   sunbooleantype* jcurPtr, sunrealtype gamma, void* user_data);
+
+static int PSolve(sunrealtype tn, N_Vector u, N_Vector fu, N_Vector r,
+                  N_Vector z, sunrealtype gamma, sunrealtype delta, int lr,
+                  void* user_data);
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx;
+  N_Vector u;
+  UserData data;
+  RunStats serial, mixed;
+  sunrealtype *us, *um, diff;
+  sunindextype i;
+  int retval, print_timing;
+
+  u            = NULL;
+  data         = NULL;
+  print_timing = 0;
+
+  /* Create the SUNDIALS context */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (check_retval(&retval, "SUNContext_Create", 1)) { return (1); }
+
+  /* Allocate and set the problem data */
+  data    = (UserData)malloc(sizeof *data);
+  data->N = 1000;
+  if (argc > 1) { data->N = (sunindextype)atol(argv[1]); }
+  if (argc > 2) { print_timing = atoi(argv[2]); }
+  if (data->N < 2)
+  {
+    printf("ERROR: the number of cells must be at least 2\n");
+    return (1);
+  }
+  data->dx  = ONE / (data->N - 1);
+  data->lam = (sunrealtype*)malloc(data->N * sizeof(sunrealtype));
+  data->Y   = (sunrealtype*)malloc(data->N * sizeof(sunrealtype));
+  data->F   = (sunrealtype*)malloc(data->N * sizeof(sunrealtype));
+  for (i = 0; i < data->N; i++)
+  {
+    data->lam[i] = pow(SUN_RCONST(10.0), SUN_RCONST(4.0) * i * data->dx);
+  }
+
+  printf("\nChain of relaxing cells with mixed-precision vectors:\n");
+  printf("  number of cells: N = %li\n", (long int)data->N);
+  printf("  exchange rate:   k = %" GSYM "\n", KDIFF);
+
+  us = (sunrealtype*)malloc(data->N * sizeof(sunrealtype));
+  um = (sunrealtype*)malloc(data->N * sizeof(sunrealtype));
+
+  /* Solve with the full precision serial vector */
+  u = N_VNew_Serial(data->N, sunctx);
+  if (check_retval((void*)u, "N_VNew_Serial", 0)) { return (1); }
+  data->mixed = SUNFALSE;
+  if (Solve(u, data, us, &serial)) { return (1); }
+  N_VDestroy(u);
+
+  /* Solve with the mixed-precision vector */
+  u = N_VNew_Mixed(data->N, sunctx);
+  if (check_retval((void*)u, "N_VNew_Mixed", 0)) { return (1); }
+  data->mixed = SUNTRUE;
+  if (Solve(u, data, um, &mixed)) { return (1); }
+  N_VDestroy(u);
+
+  /* max difference between the two solutions */
+  diff = ZERO;
+  for (i = 0; i < data->N; i++)
+  {
+    diff = SUNMAX(diff, SUNRabs(um[i] - us[i]));
+  }
+
+  /* Print the final statistics */
+  printf("\n%22s %14s %14s\n", "", "serial", "mixed");
+  printf("%22s %14ld %14ld\n", "steps", serial.nst, mixed.nst);
+  printf("%22s %14ld %14ld\n", "RHS evals", serial.nfe, mixed.nfe);
+  printf("%22s %14ld %14ld\n", "nonlinear iters", serial.nni, mixed.nni);
+  printf("%22s %14ld %14ld\n", "linear iters", serial.nli, mixed.nli);
+  printf("%22s %14ld %14ld\n", "prec evals", serial.npe, mixed.npe);
+  printf("%22s %14.2" ESYM " %14.2" ESYM "\n", "max error", serial.err,
+         mixed.err);
+  if (print_timing)
+  {
+    printf("%22s %14.4e %14.4e\n", "run time (s)", serial.time, mixed.time);
+  }
+  printf("\n  max difference of the solutions = %.2" ESYM "\n", diff);
+
+  /* Free memory */
+  free(us);
+  free(um);
+  free(data->lam);
+  free(data->Y);
+  free(data->F);
+  free(data);
+  SUNContext_Free(&sunctx);
+
+  return (0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/* Integrates the problem with the vector u, returns the final solution in
+   usol and the run statistics in stats */
+
+static int Solve(N_Vector u, UserData data, sunrealtype* usol, RunStats* stats)
+{
+  SUNLinearSolver LS;
+  void* cvode_mem;
+  sunrealtype t;
+  sunindextype i;
+  clock_t start;
+  int retval;
+
+  /* Set the initial condition and the relaxation rates */
+  data->lambda = N_VClone(u);
+  data->pinv   = N_VClone(u);
+  if (check_retval((void*)data->pinv, "N_VClone", 0)) { return (1); }
+
+  for (i = 0; i < data->N; i++)
+  {
+    usol[i] = ONE + HALF * cos(PI * i * data->dx);
+  }
+  if (data->mixed)
+  {
+    N_VCopyFromArray_Mixed(usol, u);
+    N_VCopyFromArray_Mixed(data->lam, data->lambda);
+  }
+  else
+  {
+    for (i = 0; i < data->N; i++)
+    {
+      NV_Ith_S(u, i)            = usol[i];
+      NV_Ith_S(data->lambda, i) = data->lam[i];
+    }
+  }
+
+  /* Create and initialize the BDF integrator */
+  cvode_mem = CVodeCreate(CV_BDF, u->sunctx);
+  if (check_retval((void*)cvode_mem, "CVodeCreate", 0)) { return (1); }
+
+  retval = CVodeInit(cvode_mem, f, T0, u);
+  if (check_retval(&retval, "CVodeInit", 1)) { return (1); }
+
+  retval = CVodeSStolerances(cvode_mem, RTOL, ATOL);
+  if (check_retval(&retval, "CVodeSStolerances", 1)) { return (1); }
+
+  retval = CVodeSetUserData(cvode_mem, data);
+  if (check_retval(&retval, "CVodeSetUserData", 1)) { return (1); }
+
+  retval = CVodeSetMaxNumSteps(cvode_mem, 10000);
+  if (check_retval(&retval, "CVodeSetMaxNumSteps", 1)) { return (1); }
+
+  /* Attach SPGMR with left preconditioning */
+  LS = SUNLinSol_SPGMR(u, SUN_PREC_LEFT, 0, u->sunctx);
+  if (check_retval((void*)LS, "SUNLinSol_SPGMR", 0)) { return (1); }
+
+  retval = CVodeSetLinearSolver(cvode_mem, LS, NULL);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) { return (1); }
+
+  retval = CVodeSetPreconditioner(cvode_mem, Precond, PSolve);
+  if (check_retval(&retval, "CVodeSetPreconditioner", 1)) { return (1); }
+
+  /* Integrate to the final time */
+  start  = clock();
+  retval = CVode(cvode_mem, TF, u, &t, CV_NORMAL);
+  if (check_retval(&retval, "CVode", 1)) { return (1); }
+  stats->time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  retval = CVodeGetNumSteps(cvode_mem, &stats->nst);
+  check_retval(&retval, "CVodeGetNumSteps", 1);
+  retval = CVodeGetNumRhsEvals(cvode_mem, &stats->nfe);
+  check_retval(&retval, "CVodeGetNumRhsEvals", 1);
+  retval = CVodeGetNumNonlinSolvIters(cvode_mem, &stats->nni);
+  check_retval(&retval, "CVodeGetNumNonlinSolvIters", 1);
+  retval = CVodeGetNumLinIters(cvode_mem, &stats->nli);
+  check_retval(&retval, "CVodeGetNumLinIters", 1);
+  retval = CVodeGetNumPrecEvals(cvode_mem, &stats->npe);
+  check_retval(&retval, "CVodeGetNumPrecEvals", 1);
+
+  /* Compute the error of the final solution */
+  if (data->mixed) { N_VCopyToArray_Mixed(u, usol); }
+  else
+  {
+    for (i = 0; i < data->N; i++) { usol[i] = NV_Ith_S(u, i); }
+  }
+  stats->err = ZERO;
+  for (i = 0; i < data->N; i++)
+  {
+    stats->err = SUNMAX(stats->err, SUNRabs(usol[i] - cos(TF)));
+  }
+
+  /* Free memory */
+  N_VDestroy(data->lambda);
+  N_VDestroy(data->pinv);
+  SUNLinSolFree(LS);
+  CVodeFree(&cvode_mem);
+
+  return (0);
+}
+
+/* Check function return value...
+     opt == 0 means SUNDIALS function allocates memory so check if
+              returned NULL pointer
+     opt == 1 means SUNDIALS function returns an integer value so check if
+              retval < 0
+     opt == 2 means function allocates memory so check if returned
+              NULL pointer */
+
+static int check_retval(void* returnvalue, const char* funcname, int opt)
+{
+  int* retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  /* Check if retval < 0 */
+  else if (opt == 1)
+  {
+    retval = (int*)returnvalue;
+    if (*retval < 0)
+    {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return (1);
+    }
+  }
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  return (0);
+}
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/* f routine. Compute RHS function f(t,u). */
+
+static int f(sunrealtype t, N_Vector u, N_Vector udot, void* user_data)
+{
+  UserData data = (UserData)user_data;
+  sunindextype i, N;
+  sunrealtype *Y, *F, *lam, c, s;
+
+  N   = data->N;
+  lam = data->lam;
+  c   = cos(t);
+  s   = sin(t);
+
+  /* The mixed vector data is converted to and from sunrealtype arrays */
+  if (data->mixed)
+  {
+    Y = data->Y;
+    F = data->F;
+    N_VCopyToArray_Mixed(u, Y);
+  }
+  else
+  {
+    Y = N_VGetArrayPointer(u);
+    F = N_VGetArrayPointer(udot);
+  }
+
+  /* the boundary values use the mirrored neighbors */
+  F[0] = KDIFF * TWO * (Y[1] - Y[0]) - lam[0] * (Y[0] - c) - s;
+  for (i = 1; i < N - 1; i++)
+  {
+    F[i] = KDIFF * (Y[i - 1] - TWO * Y[i] + Y[i + 1]) - lam[i] * (Y[i] - c) - s;
+  }
+  F[N - 1] = KDIFF * TWO * (Y[N - 2] - Y[N - 1]) - lam[N - 1] * (Y[N - 1] - c) -
+             s;
+
+  if (data->mixed) { N_VCopyFromArray_Mixed(F, udot); }
+
+  return (0);
+}
+
+/* Preconditioner setup routine. The Jacobi preconditioner
+   P = diag(I - gamma*J) does not depend on u and is computed with vector
+   operations. */
+
+static int Precond(sunrealtype tn, N_Vector u, N_Vector fu, sunbooleantype jok,
+                   sunbooleantype* jcurPtr, sunrealtype gamma, void* user_data)
+{
+  UserData data = (UserData)user_data;
+
+  N_VScale(gamma, data->lambda, data->pinv);
+  N_VAddConst(data->pinv, ONE + TWO * gamma * KDIFF, data->pinv);
+  N_VInv(data->pinv, data->pinv);
+
+  *jcurPtr = SUNTRUE;
+
+  return (0);
+}
+
+/* Preconditioner solve routine */
+
+static int PSolve(sunrealtype tn, N_Vector u, N_Vector fu, N_Vector r,
+                  N_Vector z, sunrealtype gamma, sunrealtype delta, int lr,
+                  void* user_data)
+{
+  UserData data = (UserData)user_data;
+
+  N_VProd(data->pinv, r, z);
+
+  return (0);
+}
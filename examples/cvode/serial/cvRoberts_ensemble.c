@@ -0,0 +1,485 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * This example integrates an ensemble of NSYS copies of the
+ * chemical kinetics problem of cvRoberts_dns,
+ *    dy1/dt = -k1*y1 + k2*y2*y3
+ *    dy2/dt = k1*y1 - k2*y2*y3 - k3*(y2)^2
+ *    dy3/dt = k3*(y2)^2
+ * with y1 = 1.0, y2 = y3 = 0 at t = 0, where the rate constant k1
+ * differs between the systems. The ensemble is solved with the
+ * batched ensemble mode of CVODE (CVodeEnsemble): each system
+ * takes its own steps with the BDF method, Newton iteration, and a
+ * dense linear solver, while the right-hand side and Jacobian of
+ * all systems are evaluated together by one call to the
+ * user-supplied routines.
+ *
+ * The state of the ensemble is stored in one serial N_Vector with
+ * the systems innermost, so that the loops in f and Jac run over
+ * the systems. The solution of system 0 is printed in decades from
+ * t = .4 to t = 4.e10. At the end every system is also solved on
+ * its own with CVODE and the two solutions and step counts are
+ * compared.
+ * -----------------------------------------------------------------*/
+
+#include <cvode/cvode.h>          /* prototypes for CVODE fcts., consts.  */
+#include <cvode/cvode_ensemble.h> /* prototypes for CVodeEnsemble fcts.   */
+#include <nvector/nvector_serial.h> /* access to serial N_Vector            */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>    /* definition of SUNRabs, SUNMAX     */
+#include <sunlinsol/sunlinsol_dense.h> /* access to dense SUNLinearSolver   */
+#include <sunmatrix/sunmatrix_dense.h> /* access to dense SUNMatrix         */
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* Accessor macros for the ensemble data: component i (1..NEQ) of
+   system s and Jacobian entry (i,j) (1..NEQ) of system s */
+
+#define Ith(v, i, s)     v[((i) - 1) * NSYS + (s)]
+#define IJth(J, i, j, s) J[(((j) - 1) * NEQ + ((i) - 1)) * NSYS + (s)]
+
+/* Problem Constants */
+
+#define NEQ   3               /* number of equations per system */
+#define NSYS  8               /* number of systems              */
+#define Y1    SUN_RCONST(1.0) /* initial y components           */
+#define Y2    SUN_RCONST(0.0)
+#define Y3    SUN_RCONST(0.0)
+#define RTOL  SUN_RCONST(1.0e-4) /* scalar relative tolerance            */
+#define ATOL1 SUN_RCONST(1.0e-8) /* vector absolute tolerance components */
+#define ATOL2 SUN_RCONST(1.0e-14)
+#define ATOL3 SUN_RCONST(1.0e-6)
+#define T0    SUN_RCONST(0.0)  /* initial time           */
+#define T1    SUN_RCONST(0.4)  /* first output time      */
+#define TMULT SUN_RCONST(10.0) /* output time factor     */
+#define NOUT  12               /* number of output times */
+
+#define ZERO SUN_RCONST(0.0)
+
+/* Type : UserData (rate constants of each system) */
+
+typedef struct
+{
+  sunrealtype k1[NSYS], k2, k3;
+} * UserData;
+
+/* Functions Called by the Solvers */
+
+static int fens(const sunrealtype* t, N_Vector y, N_Vector ydot,
+                const sunbooleantype* active, void* user_data);
+
+static int Jens(const sunrealtype* t, N_Vector y, N_Vector fy, sunrealtype* J,
+                const sunbooleantype* active, void* user_data);
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data);
+
+static int Jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+
+/* Private function to solve one system with CVODE */
+
+static int SolveSystem(int s, UserData data, SUNContext sunctx,
+                       sunrealtype* yfinal, long int* nst);
+
+/* Private function to check function return values */
+
+static int check_retval(void* returnvalue, const char* funcname, int opt);
+
+/* Data of the system solved by f */
+
+static int fsys = 0;
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main(void)
+{
+  SUNContext sunctx;
+  sunrealtype t, tout, *yd, *ad;
+  sunrealtype ycv[NEQ], err, maxerr;
+  N_Vector y;
+  N_Vector abstol;
+  UserData data;
+  void* cvens_mem;
+  long int nst[NSYS], nstcv, nfe;
+  int retval, iout, s, i, passfail;
+
+  y         = NULL;
+  abstol    = NULL;
+  data      = NULL;
+  cvens_mem = NULL;
+  passfail  = 0;
+
+  /* Create the SUNDIALS context */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (check_retval(&retval, "SUNContext_Create", 1)) { return (1); }
+
+  /* Set the rate constants: k1 spans a factor of 2 over the ensemble */
+  data = (UserData)malloc(sizeof *data);
+  if (check_retval((void*)data, "malloc", 2)) { return (1); }
+  for (s = 0; s < NSYS; s++)
+  {
+    data->k1[s] = SUN_RCONST(0.04) * (SUN_RCONST(1.0) + s / (sunrealtype)NSYS);
+  }
+  data->k2 = SUN_RCONST(1.0e4);
+  data->k3 = SUN_RCONST(3.0e7);
+
+  /* Initial conditions and absolute tolerances of all systems */
+  y = N_VNew_Serial(NEQ * NSYS, sunctx);
+  if (check_retval((void*)y, "N_VNew_Serial", 0)) { return (1); }
+  abstol = N_VNew_Serial(NEQ * NSYS, sunctx);
+  if (check_retval((void*)abstol, "N_VNew_Serial", 0)) { return (1); }
+
+  yd = N_VGetArrayPointer(y);
+  ad = N_VGetArrayPointer(abstol);
+  for (s = 0; s < NSYS; s++)
+  {
+    Ith(yd, 1, s) = Y1;
+    Ith(yd, 2, s) = Y2;
+    Ith(yd, 3, s) = Y3;
+    Ith(ad, 1, s) = ATOL1;
+    Ith(ad, 2, s) = ATOL2;
+    Ith(ad, 3, s) = ATOL3;
+  }
+
+  /* Create and initialize the ensemble integrator */
+  cvens_mem = CVodeEnsembleCreate(NEQ, NSYS, sunctx);
+  if (check_retval((void*)cvens_mem, "CVodeEnsembleCreate", 0)) { return (1); }
+
+  retval = CVodeEnsembleInit(cvens_mem, fens, T0, y);
+  if (check_retval(&retval, "CVodeEnsembleInit", 1)) { return (1); }
+
+  retval = CVodeEnsembleSVtolerances(cvens_mem, RTOL, abstol);
+  if (check_retval(&retval, "CVodeEnsembleSVtolerances", 1)) { return (1); }
+
+  retval = CVodeEnsembleSetUserData(cvens_mem, data);
+  if (check_retval(&retval, "CVodeEnsembleSetUserData", 1)) { return (1); }
+
+  retval = CVodeEnsembleSetJacFn(cvens_mem, Jens);
+  if (check_retval(&retval, "CVodeEnsembleSetJacFn", 1)) { return (1); }
+
+  /* In loop, call CVodeEnsemble and print the results of system 0 */
+  printf(" \n3-species kinetics problem, ensemble of %d systems\n\n", NSYS);
+
+  tout = T1;
+  for (iout = 0; iout < NOUT; iout++, tout *= TMULT)
+  {
+    retval = CVodeEnsemble(cvens_mem, tout, y, &t);
+    if (check_retval(&retval, "CVodeEnsemble", 1)) { break; }
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+    printf("At t = %0.4Le      y =%14.6Le  %14.6Le  %14.6Le\n", t,
+           Ith(yd, 1, 0), Ith(yd, 2, 0), Ith(yd, 3, 0));
+#else
+    printf("At t = %0.4e      y =%14.6e  %14.6e  %14.6e\n", t, Ith(yd, 1, 0),
+           Ith(yd, 2, 0), Ith(yd, 3, 0));
+#endif
+  }
+
+  /* Compare every system with a CVODE solution of the same system */
+  retval = CVodeEnsembleGetNumSteps(cvens_mem, nst);
+  check_retval(&retval, "CVodeEnsembleGetNumSteps", 1);
+  retval = CVodeEnsembleGetNumRhsEvals(cvens_mem, &nfe);
+  check_retval(&retval, "CVodeEnsembleGetNumRhsEvals", 1);
+
+  printf("\n  sys      k1       y3(tf)      steps  CVODE steps\n");
+
+  maxerr = ZERO;
+  for (s = 0; s < NSYS; s++)
+  {
+    retval = SolveSystem(s, data, sunctx, ycv, &nstcv);
+    if (check_retval(&retval, "SolveSystem", 1)) { return (1); }
+
+    err = ZERO;
+    for (i = 1; i <= NEQ; i++)
+    {
+      err = SUNMAX(err, SUNRabs(Ith(yd, i, s) - ycv[i - 1]) /
+                          (RTOL * SUNRabs(ycv[i - 1]) + ATOL1));
+    }
+    maxerr = SUNMAX(maxerr, err);
+
+    printf("  %3d  %8.4" FSYM "  %12.6" ESYM "  %6ld  %11ld\n", s, data->k1[s],
+           Ith(yd, 3, s), nst[s], nstcv);
+  }
+
+  printf("\nEnsemble right-hand side calls = %ld\n", nfe);
+
+  /* The ensemble and CVODE solutions should agree to the tolerances */
+  if (maxerr > SUN_RCONST(1.0))
+  {
+    fprintf(stdout, "\nSUNDIALS_WARNING: ensemble error=%" GSYM "\n\n", maxerr);
+    passfail = 1;
+  }
+  else { printf("Ensemble and CVODE solutions agree\n"); }
+
+  /* Free memory */
+  N_VDestroy(y);
+  N_VDestroy(abstol);
+  CVodeEnsembleFree(&cvens_mem);
+  free(data);
+  SUNContext_Free(&sunctx);
+
+  return (passfail);
+}
+
+/*
+ *-------------------------------
+ * Functions called by the solvers
+ *-------------------------------
+ */
+
+/*
+ * fens routine. Compute f(t,y) for the active systems.
+ */
+
+static int fens(const sunrealtype* t, N_Vector y, N_Vector ydot,
+                const sunbooleantype* active, void* user_data)
+{
+  UserData data = (UserData)user_data;
+  sunrealtype *yd, *dd, yd1, yd3;
+  int s;
+
+  yd = N_VGetArrayPointer(y);
+  dd = N_VGetArrayPointer(ydot);
+
+  for (s = 0; s < NSYS; s++)
+  {
+    if (!active[s]) { continue; }
+
+    yd1 = -data->k1[s] * Ith(yd, 1, s) +
+          data->k2 * Ith(yd, 2, s) * Ith(yd, 3, s);
+    yd3 = data->k3 * Ith(yd, 2, s) * Ith(yd, 2, s);
+
+    Ith(dd, 1, s) = yd1;
+    Ith(dd, 2, s) = -yd1 - yd3;
+    Ith(dd, 3, s) = yd3;
+  }
+
+  return (0);
+}
+
+/*
+ * Jens routine. Compute J(t,y) = df/dy for the active systems.
+ */
+
+static int Jens(const sunrealtype* t, N_Vector y, N_Vector fy, sunrealtype* J,
+                const sunbooleantype* active, void* user_data)
+{
+  UserData data = (UserData)user_data;
+  sunrealtype *yd, y2, y3;
+  int s;
+
+  yd = N_VGetArrayPointer(y);
+
+  /* The saved Jacobians of the inactive systems must not be changed */
+  for (s = 0; s < NSYS; s++)
+  {
+    if (!active[s]) { continue; }
+
+    y2 = Ith(yd, 2, s);
+    y3 = Ith(yd, 3, s);
+
+    IJth(J, 1, 1, s) = -data->k1[s];
+    IJth(J, 1, 2, s) = data->k2 * y3;
+    IJth(J, 1, 3, s) = data->k2 * y2;
+
+    IJth(J, 2, 1, s) = data->k1[s];
+    IJth(J, 2, 2, s) = -data->k2 * y3 - 2 * data->k3 * y2;
+    IJth(J, 2, 3, s) = -data->k2 * y2;
+
+    IJth(J, 3, 1, s) = ZERO;
+    IJth(J, 3, 2, s) = 2 * data->k3 * y2;
+    IJth(J, 3, 3, s) = ZERO;
+  }
+
+  return (0);
+}
+
+/*
+ * f routine. Compute f(t,y) for the single system fsys.
+ */
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  UserData data = (UserData)user_data;
+  sunrealtype y1, y2, y3, yd1, yd3;
+
+  y1 = NV_Ith_S(y, 0);
+  y2 = NV_Ith_S(y, 1);
+  y3 = NV_Ith_S(y, 2);
+
+  yd1 = NV_Ith_S(ydot, 0) = -data->k1[fsys] * y1 + data->k2 * y2 * y3;
+  yd3 = NV_Ith_S(ydot, 2) = data->k3 * y2 * y2;
+  NV_Ith_S(ydot, 1)       = -yd1 - yd3;
+
+  return (0);
+}
+
+/*
+ * Jacobian routine. Compute J(t,y) = df/dy for the single system fsys.
+ */
+
+static int Jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  UserData data = (UserData)user_data;
+  sunrealtype y2, y3;
+
+  y2 = NV_Ith_S(y, 1);
+  y3 = NV_Ith_S(y, 2);
+
+  SM_ELEMENT_D(J, 0, 0) = -data->k1[fsys];
+  SM_ELEMENT_D(J, 0, 1) = data->k2 * y3;
+  SM_ELEMENT_D(J, 0, 2) = data->k2 * y2;
+
+  SM_ELEMENT_D(J, 1, 0) = data->k1[fsys];
+  SM_ELEMENT_D(J, 1, 1) = -data->k2 * y3 - 2 * data->k3 * y2;
+  SM_ELEMENT_D(J, 1, 2) = -data->k2 * y2;
+
+  SM_ELEMENT_D(J, 2, 0) = ZERO;
+  SM_ELEMENT_D(J, 2, 1) = 2 * data->k3 * y2;
+  SM_ELEMENT_D(J, 2, 2) = ZERO;
+
+  return (0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/*
+ * Solve system s with CVODE (dense linear solver, user-supplied
+ * Jacobian) to the final output time.
+ */
+
+static int SolveSystem(int s, UserData data, SUNContext sunctx,
+                       sunrealtype* yfinal, long int* nst)
+{
+  N_Vector y, abstol;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  void* cvode_mem;
+  sunrealtype t, tout;
+  int retval, iout;
+
+  fsys = s;
+
+  y      = N_VNew_Serial(NEQ, sunctx);
+  abstol = N_VNew_Serial(NEQ, sunctx);
+  if (y == NULL || abstol == NULL) { return (-1); }
+
+  NV_Ith_S(y, 0)      = Y1;
+  NV_Ith_S(y, 1)      = Y2;
+  NV_Ith_S(y, 2)      = Y3;
+  NV_Ith_S(abstol, 0) = ATOL1;
+  NV_Ith_S(abstol, 1) = ATOL2;
+  NV_Ith_S(abstol, 2) = ATOL3;
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (cvode_mem == NULL) { return (-1); }
+
+  retval = CVodeInit(cvode_mem, f, T0, y);
+  if (retval == CV_SUCCESS)
+  {
+    retval = CVodeSVtolerances(cvode_mem, RTOL, abstol);
+  }
+  if (retval == CV_SUCCESS) { retval = CVodeSetUserData(cvode_mem, data); }
+
+  A  = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (retval == CV_SUCCESS)
+  {
+    retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  }
+  if (retval == CV_SUCCESS) { retval = CVodeSetJacFn(cvode_mem, Jac); }
+
+  /* Use the same output times as the ensemble */
+  tout = T1;
+  for (iout = 0; (iout < NOUT) && (retval == CV_SUCCESS); iout++, tout *= TMULT)
+  {
+    retval = CVode(cvode_mem, tout, y, &t, CV_NORMAL);
+  }
+
+  if (retval == CV_SUCCESS) { retval = CVodeGetNumSteps(cvode_mem, nst); }
+
+  yfinal[0] = NV_Ith_S(y, 0);
+  yfinal[1] = NV_Ith_S(y, 1);
+  yfinal[2] = NV_Ith_S(y, 2);
+
+  N_VDestroy(y);
+  N_VDestroy(abstol);
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  return (retval);
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void* returnvalue, const char* funcname, int opt)
+{
+  int* retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  /* Check if retval < 0 */
+  else if (opt == 1)
+  {
+    retval = (int*)returnvalue;
+    if (*retval < 0)
+    {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return (1);
+    }
+  }
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  return (0);
+}
@@ -0,0 +1,476 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The following is a simple example problem with a sparse Jacobian,
+ * with the program for its solution by CVODES.
+ * The problem is the semi-discrete form of the advection-diffusion
+ * equation in 2-D:
+ *   du/dt = d^2 u / dx^2 + .5 du/dx + d^2 u / dy^2
+ * on the rectangle 0 <= x <= 2, 0 <= y <= 1, and the time
+ * interval 0 <= t <= 1. Homogeneous Dirichlet boundary conditions
+ * are posed, and the initial condition is
+ *   u(x,y,t=0) = x(2-x)y(1-y)exp(5xy).
+ * The PDE is discretized on a uniform MX+2 by MY+2 grid with
+ * central differencing, and with boundary values eliminated,
+ * leaving an ODE system of size NEQ = MX*MY.
+ * This program solves the problem with the BDF method and Newton
+ * iteration, with the Jacobian approximated by the internal
+ * difference quotient routine of CVODES. The command line argument
+ * selects the linear system:
+ *   0 -- a dense matrix and the SUNDENSE linear solver (default),
+ *   1 -- a sparse matrix with the 5-point stencil pattern supplied
+ *        through CVodeSetJacSparsityPattern, so the Jacobian is
+ *        computed with colored difference quotients, and the
+ *        SUNLinSol_ILU solver with enough fill for an exact LU.
+ * Both runs produce the same output. The number of right-hand side
+ * evaluations for the difference quotients, the only statistic that
+ * differs, is not printed.
+ * It uses scalar relative and absolute tolerances.
+ * Output is printed at t = .1, .2, ..., 1.
+ * Run statistics (optional outputs) are printed at the end.
+ * -----------------------------------------------------------------*/
+
+#include <cvodes/cvodes.h> /* prototypes for CVODES fcts., consts. */
+#include <math.h>
+#include <nvector/nvector_serial.h> /* access to serial N_Vector            */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sunlinsol/sunlinsol_dense.h>  /* access to dense SUNLinearSolver  */
+#include <sunlinsol/sunlinsol_ilu.h>    /* access to ILU SUNLinearSolver    */
+#include <sunmatrix/sunmatrix_dense.h>  /* access to dense SUNMatrix        */
+#include <sunmatrix/sunmatrix_sparse.h> /* access to sparse SUNMatrix       */
+
+/* Problem Constants */
+
+#define XMAX  SUN_RCONST(2.0) /* domain boundaries         */
+#define YMAX  SUN_RCONST(1.0)
+#define MX    10 /* mesh dimensions           */
+#define MY    5
+#define NEQ   MX* MY             /* number of equations       */
+#define ATOL  SUN_RCONST(1.0e-5) /* scalar absolute tolerance */
+#define T0    SUN_RCONST(0.0)    /* initial time              */
+#define T1    SUN_RCONST(0.1)    /* first output time         */
+#define DTOUT SUN_RCONST(0.1)    /* output time increment     */
+#define NOUT  10                 /* number of output times    */
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+#define FIVE SUN_RCONST(5.0)
+
+/* User-defined vector access macro IJth */
+
+/* IJth is defined in order to isolate the translation from the
+   mathematical 2-dimensional structure of the dependent variable vector
+   to the underlying 1-dimensional storage.
+   IJth(vdata,i,j) references the element in the vdata array for
+   u at mesh point (i,j), where 1 <= i <= MX, 1 <= j <= MY.
+   The vdata array is obtained via the call vdata = N_VGetArrayPointer(v),
+   where v is an N_Vector.
+   The variables are ordered by the y index j, then by the x index i. */
+
+#define IJth(vdata, i, j) (vdata[(j - 1) + (i - 1) * MY])
+
+/* Type : UserData (contains grid constants) */
+
+typedef struct
+{
+  sunrealtype dx, dy, hdcoef, hacoef, vdcoef;
+}* UserData;
+
+/* Private Helper Functions */
+
+static void SetIC(N_Vector u, UserData data);
+static SUNMatrix JacPattern(SUNContext sunctx);
+static void PrintHeader(sunrealtype reltol, sunrealtype abstol, sunrealtype umax);
+static void PrintOutput(sunrealtype t, sunrealtype umax, long int nst);
+static void PrintFinalStats(void* cvode_mem);
+
+/* Private function to check function return values */
+
+static int check_retval(int retval, const char* funcname);
+
+/* Functions Called by the Solver */
+
+static int f(sunrealtype t, N_Vector u, N_Vector udot, void* user_data);
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  sunrealtype dx, dy, reltol, abstol, t, tout, umax;
+  N_Vector u;
+  UserData data;
+  SUNMatrix A, P;
+  SUNLinearSolver LS;
+  void* cvode_mem;
+  int iout, retval, sparse;
+  long int nst;
+  SUNContext sunctx;
+
+  /* Initialize variables */
+  u         = NULL;
+  data      = NULL;
+  A         = NULL;
+  P         = NULL;
+  LS        = NULL;
+  cvode_mem = NULL;
+  sunctx    = NULL;
+
+  /* Select the linear system */
+  sparse = (argc > 1) ? atoi(argv[1]) : 0;
+
+  /* Create the SUNDIALS context */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (check_retval(retval, "SUNContext_Create")) { return (1); }
+
+  /* Create a serial vector */
+
+  u = N_VNew_Serial(NEQ, sunctx); /* Allocate u vector */
+  if (check_retval(SUNContext_GetLastError(sunctx), "N_VNew_Serial"))
+  {
+    return (1);
+  }
+
+  reltol = ZERO; /* Set the tolerances */
+  abstol = ATOL;
+
+  data = (UserData)malloc(sizeof *data); /* Allocate data memory */
+  if (!data)
+  {
+    fprintf(stderr, "MEMORY_ERROR: malloc failed - returned NULL pointer\n");
+    return 1;
+  }
+
+  dx = data->dx = XMAX / (MX + 1); /* Set grid coefficients in data */
+  dy = data->dy = YMAX / (MY + 1);
+  data->hdcoef  = ONE / (dx * dx);
+  data->hacoef  = HALF / (TWO * dx);
+  data->vdcoef  = ONE / (dy * dy);
+
+  SetIC(u, data); /* Initialize u vector */
+
+  /* Call CVodeCreate to create the solver memory and specify the
+   * Backward Differentiation Formula */
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (check_retval(SUNContext_GetLastError(sunctx), "CVodeCreate"))
+  {
+    return (1);
+  }
+
+  /* Call CVodeInit to initialize the integrator memory and specify the
+   * user's right hand side function in u'=f(t,u), the inital time T0, and
+   * the initial dependent variable vector u. */
+  retval = CVodeInit(cvode_mem, f, T0, u);
+  if (check_retval(retval, "CVodeInit")) { return (1); }
+
+  /* Call CVodeSStolerances to specify the scalar relative tolerance
+   * and scalar absolute tolerance */
+  retval = CVodeSStolerances(cvode_mem, reltol, abstol);
+  if (check_retval(retval, "CVodeSStolerances")) { return (1); }
+
+  /* Set the pointer to user-defined data */
+  retval = CVodeSetUserData(cvode_mem, data);
+  if (check_retval(retval, "CVodeSetUserData")) { return (1); }
+
+  if (sparse)
+  {
+    /* Create sparse SUNMatrix and an ILU SUNLinearSolver with enough fill
+       for an exact factorization */
+    A = SUNSparseMatrix(NEQ, NEQ, 5 * NEQ, CSC_MAT, sunctx);
+    if (check_retval(SUNContext_GetLastError(sunctx), "SUNSparseMatrix"))
+    {
+      return (1);
+    }
+
+    LS = SUNLinSol_ILU(u, A, SUN_ILU_ILUK, sunctx);
+    if (check_retval(SUNContext_GetLastError(sunctx), "SUNLinSol_ILU"))
+    {
+      return (1);
+    }
+
+    retval = SUNLinSol_ILUSetFillLevel(LS, NEQ);
+    if (check_retval(retval, "SUNLinSol_ILUSetFillLevel")) { return (1); }
+  }
+  else
+  {
+    /* Create dense SUNMatrix and dense SUNLinearSolver */
+    A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+    if (check_retval(SUNContext_GetLastError(sunctx), "SUNDenseMatrix"))
+    {
+      return (1);
+    }
+
+    LS = SUNLinSol_Dense(u, A, sunctx);
+    if (check_retval(SUNContext_GetLastError(sunctx), "SUNLinSol_Dense"))
+    {
+      return (1);
+    }
+  }
+
+  /* Call CVodeSetLinearSolver to attach the matrix and linear solver to CVode */
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (check_retval(retval, "CVodeSetLinearSolver")) { return (1); }
+
+  /* Supply the Jacobian sparsity pattern for the colored difference
+     quotients */
+  if (sparse)
+  {
+    P = JacPattern(sunctx);
+    if (P == NULL) { return (1); }
+
+    retval = CVodeSetJacSparsityPattern(cvode_mem, P);
+    if (check_retval(retval, "CVodeSetJacSparsityPattern")) { return (1); }
+  }
+
+  /* In loop over output points: call CVode, print results, test for errors */
+
+  umax = N_VMaxNorm(u);
+  PrintHeader(reltol, abstol, umax);
+  for (iout = 1, tout = T1; iout <= NOUT; iout++, tout += DTOUT)
+  {
+    retval = CVode(cvode_mem, tout, u, &t, CV_NORMAL);
+    if (check_retval(retval, "CVode")) { break; }
+    umax   = N_VMaxNorm(u);
+    retval = CVodeGetNumSteps(cvode_mem, &nst);
+    check_retval(retval, "CVodeGetNumSteps");
+    PrintOutput(t, umax, nst);
+  }
+
+  PrintFinalStats(cvode_mem); /* Print some final statistics   */
+
+  N_VDestroy(u);         /* Free the u vector          */
+  CVodeFree(&cvode_mem); /* Free the integrator memory */
+  SUNLinSolFree(LS);     /* Free linear solver memory  */
+  SUNMatDestroy(A);      /* Free the matrix memory     */
+  SUNMatDestroy(P);      /* Free the pattern memory    */
+  free(data);            /* Free the user data         */
+
+  SUNContext_Free(&sunctx);
+  return (0);
+}
+
+/*
+ *-------------------------------
+ * Functions called by the solver
+ *-------------------------------
+ */
+
+/* f routine. Compute f(t,u). */
+
+static int f(sunrealtype t, N_Vector u, N_Vector udot, void* user_data)
+{
+  sunrealtype uij, udn, uup, ult, urt, hordc, horac, verdc, hdiff, hadv, vdiff;
+  sunrealtype *udata, *dudata;
+  int i, j;
+  UserData data;
+
+  udata  = N_VGetArrayPointer(u);
+  dudata = N_VGetArrayPointer(udot);
+
+  /* Extract needed constants from data */
+
+  data  = (UserData)user_data;
+  hordc = data->hdcoef;
+  horac = data->hacoef;
+  verdc = data->vdcoef;
+
+  /* Loop over all grid points. */
+
+  for (j = 1; j <= MY; j++)
+  {
+    for (i = 1; i <= MX; i++)
+    {
+      /* Extract u at x_i, y_j and four neighboring points */
+
+      uij = IJth(udata, i, j);
+      udn = (j == 1) ? ZERO : IJth(udata, i, j - 1);
+      uup = (j == MY) ? ZERO : IJth(udata, i, j + 1);
+      ult = (i == 1) ? ZERO : IJth(udata, i - 1, j);
+      urt = (i == MX) ? ZERO : IJth(udata, i + 1, j);
+
+      /* Set diffusion and advection terms and load into udot */
+
+      hdiff              = hordc * (ult - TWO * uij + urt);
+      hadv               = horac * (urt - ult);
+      vdiff              = verdc * (uup - TWO * uij + udn);
+      IJth(dudata, i, j) = hdiff + hadv + vdiff;
+    }
+  }
+
+  return (0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/* Set initial conditions in u vector */
+
+static void SetIC(N_Vector u, UserData data)
+{
+  int i, j;
+  sunrealtype x, y, dx, dy;
+  sunrealtype* udata;
+
+  /* Extract needed constants from data */
+
+  dx = data->dx;
+  dy = data->dy;
+
+  /* Set pointer to data array in vector u. */
+
+  udata = N_VGetArrayPointer(u);
+
+  /* Load initial profile into u vector */
+
+  for (j = 1; j <= MY; j++)
+  {
+    y = j * dy;
+    for (i = 1; i <= MX; i++)
+    {
+      x = i * dx;
+      IJth(udata, i, j) = x * (XMAX - x) * y * (YMAX - y) * SUNRexp(FIVE * x * y);
+    }
+  }
+}
+
+/* Create the CSC nonzero pattern of the Jacobian. The components of f that
+   depend on u(i,j) are f(i,j) and the f at the four neighboring points. */
+
+static SUNMatrix JacPattern(SUNContext sunctx)
+{
+  SUNMatrix P;
+  sunindextype *colptrs, *rowvals;
+  sunrealtype* data;
+  sunindextype i, j, k, nz;
+
+  P = SUNSparseMatrix(NEQ, NEQ, 5 * NEQ, CSC_MAT, sunctx);
+  if (check_retval(SUNContext_GetLastError(sunctx), "SUNSparseMatrix"))
+  {
+    return (NULL);
+  }
+
+  colptrs = SUNSparseMatrix_IndexPointers(P);
+  rowvals = SUNSparseMatrix_IndexValues(P);
+  data    = SUNSparseMatrix_Data(P);
+
+  /* the rows of each column are stored in increasing order */
+  nz = 0;
+  for (i = 1; i <= MX; i++)
+  {
+    for (j = 1; j <= MY; j++)
+    {
+      k          = (j - 1) + (i - 1) * MY;
+      colptrs[k] = nz;
+      if (i != 1) { rowvals[nz++] = k - MY; }
+      if (j != 1) { rowvals[nz++] = k - 1; }
+      rowvals[nz++] = k;
+      if (j != MY) { rowvals[nz++] = k + 1; }
+      if (i != MX) { rowvals[nz++] = k + MY; }
+    }
+  }
+  colptrs[NEQ] = nz;
+
+  for (k = 0; k < nz; k++) { data[k] = ONE; }
+
+  return (P);
+}
+
+/* Print first lines of output (problem description) */
+
+static void PrintHeader(sunrealtype reltol, sunrealtype abstol, sunrealtype umax)
+{
+  printf("\n2-D Advection-Diffusion Equation\n");
+  printf("Mesh dimensions = %d X %d\n", MX, MY);
+  printf("Total system size = %d\n", NEQ);
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("Tolerance parameters: reltol = %Lg   abstol = %Lg\n\n", reltol, abstol);
+  printf("At t = %Lg      max.norm(u) =%14.6Le \n", T0, umax);
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+  printf("Tolerance parameters: reltol = %g   abstol = %g\n\n", reltol, abstol);
+  printf("At t = %g      max.norm(u) =%14.6e \n", T0, umax);
+#else
+  printf("Tolerance parameters: reltol = %g   abstol = %g\n\n", reltol, abstol);
+  printf("At t = %g      max.norm(u) =%14.6e \n", T0, umax);
+#endif
+
+  return;
+}
+
+/* Print current value */
+
+static void PrintOutput(sunrealtype t, sunrealtype umax, long int nst)
+{
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("At t = %4.2Lf   max.norm(u) =%14.6Le   nst = %4ld\n", t, umax, nst);
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+  printf("At t = %4.2f   max.norm(u) =%14.6e   nst = %4ld\n", t, umax, nst);
+#else
+  printf("At t = %4.2f   max.norm(u) =%14.6e   nst = %4ld\n", t, umax, nst);
+#endif
+
+  return;
+}
+
+/* Get and print some final statistics */
+
+static void PrintFinalStats(void* cvode_mem)
+{
+  int retval;
+  long int nst, nfe, nsetups, netf, nni, ncfn, nje;
+
+  retval = CVodeGetNumSteps(cvode_mem, &nst);
+  check_retval(retval, "CVodeGetNumSteps");
+  retval = CVodeGetNumRhsEvals(cvode_mem, &nfe);
+  check_retval(retval, "CVodeGetNumRhsEvals");
+  retval = CVodeGetNumLinSolvSetups(cvode_mem, &nsetups);
+  check_retval(retval, "CVodeGetNumLinSolvSetups");
+  retval = CVodeGetNumErrTestFails(cvode_mem, &netf);
+  check_retval(retval, "CVodeGetNumErrTestFails");
+  retval = CVodeGetNumNonlinSolvIters(cvode_mem, &nni);
+  check_retval(retval, "CVodeGetNumNonlinSolvIters");
+  retval = CVodeGetNumNonlinSolvConvFails(cvode_mem, &ncfn);
+  check_retval(retval, "CVodeGetNumNonlinSolvConvFails");
+
+  retval = CVodeGetNumJacEvals(cvode_mem, &nje);
+  check_retval(retval, "CVodeGetNumJacEvals");
+
+  printf("\nFinal Statistics:\n");
+  printf("nst = %-6ld nfe  = %-6ld nsetups = %-6ld nje = %ld\n", nst, nfe,
+         nsetups, nje);
+  printf("nni = %-6ld ncfn = %-6ld netf = %ld\n", nni, ncfn, netf);
+
+  return;
+}
+
+/* Check function return value */
+static int check_retval(int retval, const char* funcname)
+{
+  /* Check if retval < 0 */
+  if (retval < 0)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+            funcname, retval);
+    return (1);
+  }
+  else { return (0); }
+}
@@ -0,0 +1,660 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Adjoint sensitivity example problem with a limited number of
+ * check points.
+ * The problem is the chemical kinetics problem of
+ * cvsRoberts_ASAi_dns:
+ *    dy1/dt = -p1*y1 + p2*y2*y3
+ *    dy2/dt =  p1*y1 - p2*y2*y3 - p3*(y2)^2
+ *    dy3/dt =  p3*(y2)^2
+ * on the interval from t = 0.0 to t = 4.e7, with initial
+ * conditions: y1 = 1.0, y2 = y3 = 0 and the reaction rates
+ * p1=0.04, p2=1e4, and p3=3e7. The gradient dG/dp of
+ *   G = int_t0^tB0 y3 dt
+ * is computed with the adjoint method for two final times tB0.
+ *
+ * The adjoint problem is solved twice: first keeping all check
+ * points of the forward integration, and then with at most
+ * MAXCKPNTS check points set with CVodeSetAdjMaxCheckPoints. In
+ * the second case CVODES removes check points during the forward
+ * integration and integrates the forward problem again during the
+ * backward integration to place them (using a binomial schedule).
+ * The number of check points and of recomputed steps is printed
+ * and the gradients of both runs are compared.
+ * -----------------------------------------------------------------*/
+
+#include <cvodes/cvodes.h>          /* prototypes for CVODE fcts., consts.  */
+#include <nvector/nvector_serial.h> /* access to serial N_Vector            */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h> /* defs. of SUNRabs, SUNRexp, etc.      */
+#include <sundials/sundials_types.h> /* defs. of sunrealtype, sunindextype      */
+#include <sunlinsol/sunlinsol_dense.h> /* access to dense SUNLinearSolver      */
+#include <sunmatrix/sunmatrix_dense.h> /* access to dense SUNMatrix            */
+
+/* Accessor macros */
+
+#define Ith(v, i) NV_Ith_S(v, i - 1) /* i-th vector component, i=1..NEQ */
+#define IJth(A, i, j) \
+  SM_ELEMENT_D(A, i - 1, j - 1) /* (i,j)-th matrix el., i,j=1..NEQ */
+
+/* Problem Constants */
+
+#define NEQ 3 /* number of equations                  */
+
+#define RTOL SUN_RCONST(1e-6) /* scalar relative tolerance            */
+
+#define ATOL1 SUN_RCONST(1e-8) /* vector absolute tolerance components */
+#define ATOL2 SUN_RCONST(1e-14)
+#define ATOL3 SUN_RCONST(1e-6)
+
+#define ATOLl SUN_RCONST(1e-8) /* absolute tolerance for adjoint vars. */
+#define ATOLq SUN_RCONST(1e-6) /* absolute tolerance for quadratures   */
+
+#define T0   SUN_RCONST(0.0) /* initial time                         */
+#define TOUT SUN_RCONST(4e7) /* final time                           */
+
+#define TB1 SUN_RCONST(4e7)  /* starting point for adjoint problem   */
+#define TB2 SUN_RCONST(50.0) /* starting point for adjoint problem   */
+
+#define STEPS     25 /* number of steps between check points */
+#define MAXCKPNTS 5  /* maximum number of check points       */
+
+#define NP 3 /* number of problem parameters         */
+
+#define ZERO SUN_RCONST(0.0)
+
+/* Type : UserData */
+
+typedef struct
+{
+  sunrealtype p[3];
+}* UserData;
+
+/* Prototypes of user-supplied functions */
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data);
+static int Jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+static int fQ(sunrealtype t, N_Vector y, N_Vector qdot, void* user_data);
+static int ewt(N_Vector y, N_Vector w, void* user_data);
+
+static int fB(sunrealtype t, N_Vector y, N_Vector yB, N_Vector yBdot,
+              void* user_dataB);
+static int JacB(sunrealtype t, N_Vector y, N_Vector yB, N_Vector fyB,
+                SUNMatrix JB, void* user_dataB, N_Vector tmp1B, N_Vector tmp2B,
+                N_Vector tmp3B);
+static int fQB(sunrealtype t, N_Vector y, N_Vector yB, N_Vector qBdot,
+               void* user_dataB);
+
+/* Prototypes of private functions */
+
+static int SolveAdjoint(int maxckpnts, UserData data, N_Vector qB1,
+                        N_Vector qB2, SUNContext sunctx);
+static void PrintCheckPoints(void* cvode_mem);
+static void PrintGradient(sunrealtype tB0, N_Vector qB);
+static int check_retval(void* returnvalue, const char* funcname, int opt);
+
+/*
+ *--------------------------------------------------------------------
+ * MAIN PROGRAM
+ *--------------------------------------------------------------------
+ */
+
+int main(void)
+{
+  SUNContext sunctx;
+  UserData data;
+  N_Vector qB1, qB2, qB1lim, qB2lim;
+  sunrealtype diff;
+  int retval, i;
+
+  data = NULL;
+  qB1 = qB2 = qB1lim = qB2lim = NULL;
+
+  /* Print problem description */
+  printf("\nAdjoint Sensitivity Example with Limited Check Points\n");
+  printf("-----------------------------------------------------\n\n");
+  printf("ODE: dy1/dt = -p1*y1 + p2*y2*y3\n");
+  printf("     dy2/dt =  p1*y1 - p2*y2*y3 - p3*(y2)^2\n");
+  printf("     dy3/dt =  p3*(y2)^2\n\n");
+  printf("Find dG/dp for\n");
+  printf("     G = int_t0^tB0 g(t,p,y) dt\n");
+  printf("     g(t,p,y) = y3\n\n");
+
+  /* User data structure */
+  data = (UserData)malloc(sizeof *data);
+  if (check_retval((void*)data, "malloc", 2)) { return (1); }
+  data->p[0] = SUN_RCONST(0.04);
+  data->p[1] = SUN_RCONST(1.0e4);
+  data->p[2] = SUN_RCONST(3.0e7);
+
+  /* Create the SUNDIALS simulation context that all SUNDIALS objects require */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (check_retval(&retval, "SUNContext_Create", 1)) { return (1); }
+
+  qB1    = N_VNew_Serial(NP, sunctx);
+  qB2    = N_VNew_Serial(NP, sunctx);
+  qB1lim = N_VNew_Serial(NP, sunctx);
+  qB2lim = N_VNew_Serial(NP, sunctx);
+  if (check_retval((void*)qB2lim, "N_VNew_Serial", 0)) { return (1); }
+
+  /* Keep all check points */
+  printf("\nAll check points kept\n");
+  printf("=====================\n");
+  if (SolveAdjoint(0, data, qB1, qB2, sunctx)) { return (1); }
+
+  /* Limit the number of check points */
+  printf("\nAt most %d check points\n", MAXCKPNTS);
+  printf("=======================\n");
+  if (SolveAdjoint(MAXCKPNTS, data, qB1lim, qB2lim, sunctx)) { return (1); }
+
+  /* Compare the gradients */
+  diff = ZERO;
+  for (i = 1; i <= NP; i++)
+  {
+    diff = SUNMAX(diff, SUNRabs(Ith(qB1, i) - Ith(qB1lim, i)) /
+                          SUNRabs(Ith(qB1, i)));
+    diff = SUNMAX(diff, SUNRabs(Ith(qB2, i) - Ith(qB2lim, i)) /
+                          SUNRabs(Ith(qB2, i)));
+  }
+
+  if (diff < SUN_RCONST(1.0e-4))
+  {
+    printf("\nThe gradients agree with and without a check point limit\n\n");
+  }
+  else
+  {
+    printf("\nThe gradients differ (maximum relative difference %g)\n\n",
+           (double)diff);
+  }
+
+  /* Free memory */
+  N_VDestroy(qB1);
+  N_VDestroy(qB2);
+  N_VDestroy(qB1lim);
+  N_VDestroy(qB2lim);
+  free(data);
+  SUNContext_Free(&sunctx);
+
+  return (diff < SUN_RCONST(1.0e-4)) ? 0 : 1;
+}
+
+/*
+ *--------------------------------------------------------------------
+ * FUNCTIONS CALLED BY CVODES
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * f routine. Compute function f(t,y).
+ */
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype y1, y2, y3, yd1, yd3;
+  UserData data;
+  sunrealtype p1, p2, p3;
+
+  y1   = Ith(y, 1);
+  y2   = Ith(y, 2);
+  y3   = Ith(y, 3);
+  data = (UserData)user_data;
+  p1   = data->p[0];
+  p2   = data->p[1];
+  p3   = data->p[2];
+
+  yd1 = Ith(ydot, 1) = -p1 * y1 + p2 * y2 * y3;
+  yd3 = Ith(ydot, 3) = p3 * y2 * y2;
+  Ith(ydot, 2)       = -yd1 - yd3;
+
+  return (0);
+}
+
+/*
+ * Jacobian routine. Compute J(t,y).
+ */
+
+static int Jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  sunrealtype y2, y3;
+  UserData data;
+  sunrealtype p1, p2, p3;
+
+  y2   = Ith(y, 2);
+  y3   = Ith(y, 3);
+  data = (UserData)user_data;
+  p1   = data->p[0];
+  p2   = data->p[1];
+  p3   = data->p[2];
+
+  IJth(J, 1, 1) = -p1;
+  IJth(J, 1, 2) = p2 * y3;
+  IJth(J, 1, 3) = p2 * y2;
+  IJth(J, 2, 1) = p1;
+  IJth(J, 2, 2) = -p2 * y3 - 2 * p3 * y2;
+  IJth(J, 2, 3) = -p2 * y2;
+  IJth(J, 3, 1) = ZERO;
+  IJth(J, 3, 2) = 2 * p3 * y2;
+  IJth(J, 3, 3) = ZERO;
+
+  return (0);
+}
+
+/*
+ * fQ routine. Compute fQ(t,y).
+ */
+
+static int fQ(sunrealtype t, N_Vector y, N_Vector qdot, void* user_data)
+{
+  Ith(qdot, 1) = Ith(y, 3);
+
+  return (0);
+}
+
+/*
+ * EwtSet function. Computes the error weights at the current solution.
+ */
+
+static int ewt(N_Vector y, N_Vector w, void* user_data)
+{
+  int i;
+  sunrealtype yy, ww, rtol, atol[3];
+
+  rtol    = RTOL;
+  atol[0] = ATOL1;
+  atol[1] = ATOL2;
+  atol[2] = ATOL3;
+
+  for (i = 1; i <= 3; i++)
+  {
+    yy = Ith(y, i);
+    ww = rtol * SUNRabs(yy) + atol[i - 1];
+    if (ww <= 0.0) { return (-1); }
+    Ith(w, i) = 1.0 / ww;
+  }
+
+  return (0);
+}
+
+/*
+ * fB routine. Compute fB(t,y,yB).
+ */
+
+static int fB(sunrealtype t, N_Vector y, N_Vector yB, N_Vector yBdot,
+              void* user_dataB)
+{
+  UserData data;
+  sunrealtype y2, y3;
+  sunrealtype p1, p2, p3;
+  sunrealtype l1, l2, l3;
+  sunrealtype l21, l32;
+
+  data = (UserData)user_dataB;
+
+  /* The p vector */
+  p1 = data->p[0];
+  p2 = data->p[1];
+  p3 = data->p[2];
+
+  /* The y vector */
+  y2 = Ith(y, 2);
+  y3 = Ith(y, 3);
+
+  /* The lambda vector */
+  l1 = Ith(yB, 1);
+  l2 = Ith(yB, 2);
+  l3 = Ith(yB, 3);
+
+  /* Temporary variables */
+  l21 = l2 - l1;
+  l32 = l3 - l2;
+
+  /* Load yBdot */
+  Ith(yBdot, 1) = -p1 * l21;
+  Ith(yBdot, 2) = p2 * y3 * l21 - SUN_RCONST(2.0) * p3 * y2 * l32;
+  Ith(yBdot, 3) = p2 * y2 * l21 - SUN_RCONST(1.0);
+
+  return (0);
+}
+
+/*
+ * JacB routine. Compute JB(t,y,yB).
+ */
+
+static int JacB(sunrealtype t, N_Vector y, N_Vector yB, N_Vector fyB,
+                SUNMatrix JB, void* user_dataB, N_Vector tmp1B, N_Vector tmp2B,
+                N_Vector tmp3B)
+{
+  UserData data;
+  sunrealtype y2, y3;
+  sunrealtype p1, p2, p3;
+
+  data = (UserData)user_dataB;
+
+  /* The p vector */
+  p1 = data->p[0];
+  p2 = data->p[1];
+  p3 = data->p[2];
+
+  /* The y vector */
+  y2 = Ith(y, 2);
+  y3 = Ith(y, 3);
+
+  /* Load JB */
+  IJth(JB, 1, 1) = p1;
+  IJth(JB, 1, 2) = -p1;
+  IJth(JB, 1, 3) = ZERO;
+  IJth(JB, 2, 1) = -p2 * y3;
+  IJth(JB, 2, 2) = p2 * y3 + 2.0 * p3 * y2;
+  IJth(JB, 2, 3) = SUN_RCONST(-2.0) * p3 * y2;
+  IJth(JB, 3, 1) = -p2 * y2;
+  IJth(JB, 3, 2) = p2 * y2;
+  IJth(JB, 3, 3) = ZERO;
+
+  return (0);
+}
+
+/*
+ * fQB routine. Compute integrand for quadratures
+ */
+
+static int fQB(sunrealtype t, N_Vector y, N_Vector yB, N_Vector qBdot,
+               void* user_dataB)
+{
+  sunrealtype y1, y2, y3;
+  sunrealtype l1, l2, l3;
+  sunrealtype l21, l32, y23;
+
+  /* The y vector */
+  y1 = Ith(y, 1);
+  y2 = Ith(y, 2);
+  y3 = Ith(y, 3);
+
+  /* The lambda vector */
+  l1 = Ith(yB, 1);
+  l2 = Ith(yB, 2);
+  l3 = Ith(yB, 3);
+
+  /* Temporary variables */
+  l21 = l2 - l1;
+  l32 = l3 - l2;
+  y23 = y2 * y3;
+
+  Ith(qBdot, 1) = y1 * l21;
+  Ith(qBdot, 2) = -y23 * l21;
+  Ith(qBdot, 3) = y2 * y2 * l32;
+
+  return (0);
+}
+
+/*
+ *--------------------------------------------------------------------
+ * PRIVATE FUNCTIONS
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * Solve the forward problem and the adjoint problem for tB0 = TB1
+ * and tB0 = TB2, keeping at most maxckpnts check points (no limit
+ * if maxckpnts = 0). The quadratures at t0 are returned in qB1 and
+ * qB2.
+ */
+
+static int SolveAdjoint(int maxckpnts, UserData data, N_Vector qB1,
+                        N_Vector qB2, SUNContext sunctx)
+{
+  SUNMatrix A, AB;
+  SUNLinearSolver LS, LSB;
+  void* cvode_mem;
+  N_Vector y, q, yB;
+  sunrealtype time;
+  long int nrecomp;
+  int retval, ncheck, indexB;
+
+  /* Initialize y and q */
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (check_retval((void*)y, "N_VNew_Serial", 0)) { return (1); }
+  Ith(y, 1) = SUN_RCONST(1.0);
+  Ith(y, 2) = ZERO;
+  Ith(y, 3) = ZERO;
+
+  q = N_VNew_Serial(1, sunctx);
+  if (check_retval((void*)q, "N_VNew_Serial", 0)) { return (1); }
+  Ith(q, 1) = ZERO;
+
+  /* Create and allocate CVODES memory for the forward run */
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (check_retval((void*)cvode_mem, "CVodeCreate", 0)) { return (1); }
+
+  retval = CVodeInit(cvode_mem, f, T0, y);
+  if (check_retval(&retval, "CVodeInit", 1)) { return (1); }
+
+  retval = CVodeWFtolerances(cvode_mem, ewt);
+  if (check_retval(&retval, "CVodeWFtolerances", 1)) { return (1); }
+
+  retval = CVodeSetUserData(cvode_mem, data);
+  if (check_retval(&retval, "CVodeSetUserData", 1)) { return (1); }
+
+  A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (check_retval((void*)A, "SUNDenseMatrix", 0)) { return (1); }
+
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (check_retval((void*)LS, "SUNLinSol_Dense", 0)) { return (1); }
+
+  retval = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) { return (1); }
+
+  retval = CVodeSetJacFn(cvode_mem, Jac);
+  if (check_retval(&retval, "CVodeSetJacFn", 1)) { return (1); }
+
+  retval = CVodeQuadInit(cvode_mem, fQ, q);
+  if (check_retval(&retval, "CVodeQuadInit", 1)) { return (1); }
+
+  retval = CVodeSetQuadErrCon(cvode_mem, SUNTRUE);
+  if (check_retval(&retval, "CVodeSetQuadErrCon", 1)) { return (1); }
+
+  retval = CVodeQuadSStolerances(cvode_mem, RTOL, ATOLq);
+  if (check_retval(&retval, "CVodeQuadSStolerances", 1)) { return (1); }
+
+  retval = CVodeSetMaxNumSteps(cvode_mem, 2500);
+  if (check_retval(&retval, "CVodeSetMaxNumSteps", 1)) { return (1); }
+
+  /* Allocate memory for the adjoint integration and set the limit on
+     the number of check points */
+  retval = CVodeAdjInit(cvode_mem, STEPS, CV_HERMITE);
+  if (check_retval(&retval, "CVodeAdjInit", 1)) { return (1); }
+
+  retval = CVodeSetAdjMaxCheckPoints(cvode_mem, maxckpnts);
+  if (check_retval(&retval, "CVodeSetAdjMaxCheckPoints", 1)) { return (1); }
+
+  /* Perform the forward run */
+  retval = CVodeF(cvode_mem, TOUT, y, &time, CV_NORMAL, &ncheck);
+  if (check_retval(&retval, "CVodeF", 1)) { return (1); }
+
+  printf("\nForward integration done (ncheck = %d)\n", ncheck);
+  PrintCheckPoints(cvode_mem);
+
+  /* Create and allocate CVODES memory for the backward run */
+  yB = N_VNew_Serial(NEQ, sunctx);
+  if (check_retval((void*)yB, "N_VNew_Serial", 0)) { return (1); }
+  N_VConst(ZERO, yB);
+  N_VConst(ZERO, qB1);
+
+  retval = CVodeCreateB(cvode_mem, CV_BDF, &indexB);
+  if (check_retval(&retval, "CVodeCreateB", 1)) { return (1); }
+
+  retval = CVodeInitB(cvode_mem, indexB, fB, TB1, yB);
+  if (check_retval(&retval, "CVodeInitB", 1)) { return (1); }
+
+  retval = CVodeSStolerancesB(cvode_mem, indexB, RTOL, ATOLl);
+  if (check_retval(&retval, "CVodeSStolerancesB", 1)) { return (1); }
+
+  retval = CVodeSetUserDataB(cvode_mem, indexB, data);
+  if (check_retval(&retval, "CVodeSetUserDataB", 1)) { return (1); }
+
+  AB = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (check_retval((void*)AB, "SUNDenseMatrix", 0)) { return (1); }
+
+  LSB = SUNLinSol_Dense(yB, AB, sunctx);
+  if (check_retval((void*)LSB, "SUNLinSol_Dense", 0)) { return (1); }
+
+  retval = CVodeSetLinearSolverB(cvode_mem, indexB, LSB, AB);
+  if (check_retval(&retval, "CVodeSetLinearSolverB", 1)) { return (1); }
+
+  retval = CVodeSetJacFnB(cvode_mem, indexB, JacB);
+  if (check_retval(&retval, "CVodeSetJacFnB", 1)) { return (1); }
+
+  retval = CVodeQuadInitB(cvode_mem, indexB, fQB, qB1);
+  if (check_retval(&retval, "CVodeQuadInitB", 1)) { return (1); }
+
+  retval = CVodeSetQuadErrConB(cvode_mem, indexB, SUNTRUE);
+  if (check_retval(&retval, "CVodeSetQuadErrConB", 1)) { return (1); }
+
+  retval = CVodeQuadSStolerancesB(cvode_mem, indexB, RTOL, ATOLq);
+  if (check_retval(&retval, "CVodeQuadSStolerancesB", 1)) { return (1); }
+
+  /* Backward integration from TB1 */
+  retval = CVodeB(cvode_mem, T0, CV_NORMAL);
+  if (check_retval(&retval, "CVodeB", 1)) { return (1); }
+
+  retval = CVodeGetQuadB(cvode_mem, indexB, &time, qB1);
+  if (check_retval(&retval, "CVodeGetQuadB", 1)) { return (1); }
+
+  PrintGradient(TB1, qB1);
+
+  /* Backward integration from TB2 */
+  N_VConst(ZERO, yB);
+  N_VConst(ZERO, qB2);
+
+  retval = CVodeReInitB(cvode_mem, indexB, TB2, yB);
+  if (check_retval(&retval, "CVodeReInitB", 1)) { return (1); }
+
+  retval = CVodeQuadReInitB(cvode_mem, indexB, qB2);
+  if (check_retval(&retval, "CVodeQuadReInitB", 1)) { return (1); }
+
+  retval = CVodeB(cvode_mem, T0, CV_NORMAL);
+  if (check_retval(&retval, "CVodeB", 1)) { return (1); }
+
+  retval = CVodeGetQuadB(cvode_mem, indexB, &time, qB2);
+  if (check_retval(&retval, "CVodeGetQuadB", 1)) { return (1); }
+
+  PrintGradient(TB2, qB2);
+
+  /* Print the check point statistics after the backward runs */
+  retval = CVodeGetAdjNumCheckPoints(cvode_mem, &ncheck);
+  if (check_retval(&retval, "CVodeGetAdjNumCheckPoints", 1)) { return (1); }
+
+  retval = CVodeGetAdjNumRecompSteps(cvode_mem, &nrecomp);
+  if (check_retval(&retval, "CVodeGetAdjNumRecompSteps", 1)) { return (1); }
+
+  printf("\nBackward integration done (ncheck = %d, recomputed steps = %ld)\n",
+         ncheck, nrecomp);
+
+  /* Free memory */
+  CVodeFree(&cvode_mem);
+  N_VDestroy(y);
+  N_VDestroy(q);
+  N_VDestroy(yB);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNLinSolFree(LSB);
+  SUNMatDestroy(AB);
+
+  return (0);
+}
+
+/*
+ * Print the step numbers at the check points
+ */
+
+static void PrintCheckPoints(void* cvode_mem)
+{
+  CVadjCheckPointRec* ckpnt;
+  int i, ncheck;
+
+  CVodeGetAdjNumCheckPoints(cvode_mem, &ncheck);
+
+  ckpnt = (CVadjCheckPointRec*)malloc((ncheck + 1) * sizeof(CVadjCheckPointRec));
+  CVodeGetAdjCheckPointsInfo(cvode_mem, ckpnt);
+
+  printf("Check points at steps:");
+  for (i = ncheck; i >= 0; i--) { printf(" %ld", ckpnt[i].nstep); }
+  printf("\n");
+
+  free(ckpnt);
+}
+
+/*
+ * Print the gradient dG/dp
+ */
+
+static void PrintGradient(sunrealtype tB0, N_Vector qB)
+{
+  printf("--------------------------------------------------------\n");
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("tB0:        %12.4Le\n", tB0);
+  printf("dG/dp:      %12.4Le %12.4Le %12.4Le\n", -Ith(qB, 1), -Ith(qB, 2),
+         -Ith(qB, 3));
+#else
+  printf("tB0:        %12.4e\n", tB0);
+  printf("dG/dp:      %12.4e %12.4e %12.4e\n", -Ith(qB, 1), -Ith(qB, 2),
+         -Ith(qB, 3));
+#endif
+  printf("--------------------------------------------------------\n");
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void* returnvalue, const char* funcname, int opt)
+{
+  int* retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  /* Check if retval < 0 */
+  else if (opt == 1)
+  {
+    retval = (int*)returnvalue;
+    if (*retval < 0)
+    {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return (1);
+    }
+  }
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  return (0);
+}
@@ -0,0 +1,521 @@
+/* -----------------------------------------------------------------
+ * Programmer(s): Allan Taylor, Alan Hindmarsh and
+ *                Radu Serban @ LLNL
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem for IDA: 2D heat equation, serial, sparse
+ * difference quotient Jacobian.
+ *
+ * This example solves a discretized 2D heat equation problem.
+ * This version uses the internal difference quotient Jacobian
+ * with a dense or a sparse matrix, and IDACalcIC.
+ *
+ * The DAE system solved is a spatial discretization of the PDE
+ *          du/dt = d^2u/dx^2 + d^2u/dy^2
+ * on the unit square. The boundary condition is u = 0 on all edges.
+ * Initial conditions are given by u = 16 x (1 - x) y (1 - y).
+ * The PDE is treated with central differences on a uniform M x M
+ * grid. The values of u at the interior points satisfy ODEs, and
+ * equations u = 0 at the boundaries are appended, to form a DAE
+ * system of size N = M^2. Here M = 10.
+ *
+ * The system is solved with IDA using the default
+ * difference-quotient Jacobian. The command line argument selects
+ * the linear system:
+ *   0 -- a dense matrix and the SUNDENSE linear solver (default),
+ *   1 -- a sparse matrix with the Jacobian pattern supplied through
+ *        IDASetJacSparsityPattern, so the Jacobian is computed with
+ *        colored difference quotients, and the SUNLinSol_ILU solver
+ *        with enough fill for an exact LU.
+ * Both runs produce the same output. The number of residual
+ * evaluations for the difference quotients, the only statistic
+ * that differs, is not printed. For purposes of illustration,
+ * IDACalcIC is called to compute correct values at the boundary,
+ * given incorrect values as input initial guesses. Output is taken at
+ * t = 0, .01, .02, .04, ..., 10.24. (Output at t = 0 is for
+ * IDACalcIC cost statistics only.)
+ * -----------------------------------------------------------------*/
+
+#include <ida/ida.h> /* prototypes for IDA fcts., consts.    */
+#include <math.h>
+#include <nvector/nvector_serial.h> /* access to serial N_Vector            */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_types.h> /* definition of type sunrealtype          */
+#include <sunlinsol/sunlinsol_dense.h>  /* access to dense SUNLinearSolver  */
+#include <sunlinsol/sunlinsol_ilu.h>    /* access to ILU SUNLinearSolver    */
+#include <sunmatrix/sunmatrix_dense.h>  /* access to dense SUNMatrix        */
+#include <sunmatrix/sunmatrix_sparse.h> /* access to sparse SUNMatrix       */
+
+/* Problem Constants */
+
+#define NOUT  11
+#define MGRID 10
+#define NEQ   MGRID* MGRID
+#define ZERO  SUN_RCONST(0.0)
+#define ONE   SUN_RCONST(1.0)
+#define TWO   SUN_RCONST(2.0)
+#define BVAL  SUN_RCONST(0.1)
+
+/* Type: UserData */
+
+typedef struct
+{
+  sunindextype mm;
+  sunrealtype dx;
+  sunrealtype coeff;
+}* UserData;
+
+/* Prototypes of functions called by IDA */
+
+int heatres(sunrealtype tres, N_Vector uu, N_Vector up, N_Vector resval,
+            void* user_data);
+
+/* Prototypes of private functions */
+
+static SUNMatrix JacPattern(UserData data, SUNContext ctx);
+static void PrintHeader(sunrealtype rtol, sunrealtype atol);
+static void PrintOutput(void* mem, sunrealtype t, N_Vector u);
+static int SetInitialProfile(UserData data, N_Vector uu, N_Vector up,
+                             N_Vector id, N_Vector res);
+
+static int check_retval(void* returnvalue, const char* funcname, int opt);
+
+/*
+ *--------------------------------------------------------------------
+ * MAIN PROGRAM
+ *--------------------------------------------------------------------
+ */
+
+int main(int argc, char* argv[])
+{
+  void* mem;
+  UserData data;
+  N_Vector uu, up, id, res;
+  int retval, iout, sparse;
+  long int netf, ncfn;
+  sunrealtype rtol, atol, t0, t1, tout, tret;
+  SUNMatrix A, P;
+  SUNLinearSolver LS;
+  SUNContext ctx;
+
+  mem  = NULL;
+  data = NULL;
+  uu = up = id = res = NULL;
+  A                  = NULL;
+  P                  = NULL;
+  LS                 = NULL;
+
+  /* Select the linear system */
+  sparse = (argc > 1) ? atoi(argv[1]) : 0;
+
+  /* Create the SUNDIALS context object for this simulation */
+  retval = SUNContext_Create(SUN_COMM_NULL, &ctx);
+  if (check_retval(&retval, "SUNContext_Create", 1)) { return 1; }
+
+  /* Create vectors uu, up, res, id. */
+  uu = N_VNew_Serial(NEQ, ctx);
+  if (check_retval((void*)uu, "N_VNew_Serial", 0)) { return (1); }
+  up = N_VClone(uu);
+  if (check_retval((void*)up, "N_VNew_Serial", 0)) { return (1); }
+  res = N_VClone(uu);
+  if (check_retval((void*)res, "N_VNew_Serial", 0)) { return (1); }
+  id = N_VClone(uu);
+  if (check_retval((void*)id, "N_VNew_Serial", 0)) { return (1); }
+
+  /* Create and load problem data block. */
+  data = (UserData)malloc(sizeof *data);
+  if (check_retval((void*)data, "malloc", 2)) { return (1); }
+  data->mm    = MGRID;
+  data->dx    = ONE / (MGRID - ONE);
+  data->coeff = ONE / ((data->dx) * (data->dx));
+
+  /* Initialize uu, up, id. */
+  SetInitialProfile(data, uu, up, id, res);
+
+  /* Set remaining input parameters. */
+  t0   = ZERO;
+  t1   = SUN_RCONST(0.01);
+  rtol = ZERO;
+  atol = SUN_RCONST(1.0e-3);
+
+  /* Call IDACreate and IDAMalloc to initialize solution */
+  mem = IDACreate(ctx);
+  if (check_retval((void*)mem, "IDACreate", 0)) { return (1); }
+
+  retval = IDASetUserData(mem, data);
+  if (check_retval(&retval, "IDASetUserData", 1)) { return (1); }
+
+  /* Set which components are algebraic or differential */
+  retval = IDASetId(mem, id);
+  if (check_retval(&retval, "IDASetId", 1)) { return (1); }
+
+  retval = IDAInit(mem, heatres, t0, uu, up);
+  if (check_retval(&retval, "IDAInit", 1)) { return (1); }
+
+  retval = IDASStolerances(mem, rtol, atol);
+  if (check_retval(&retval, "IDASStolerances", 1)) { return (1); }
+
+  if (sparse)
+  {
+    /* Create sparse SUNMatrix and an ILU SUNLinearSolver with enough fill
+       for an exact factorization */
+    A = SUNSparseMatrix(NEQ, NEQ, 5 * NEQ, CSC_MAT, ctx);
+    if (check_retval((void*)A, "SUNSparseMatrix", 0)) { return (1); }
+
+    LS = SUNLinSol_ILU(uu, A, SUN_ILU_ILUK, ctx);
+    if (check_retval((void*)LS, "SUNLinSol_ILU", 0)) { return (1); }
+
+    retval = SUNLinSol_ILUSetFillLevel(LS, NEQ);
+    if (check_retval(&retval, "SUNLinSol_ILUSetFillLevel", 1)) { return (1); }
+  }
+  else
+  {
+    /* Create dense SUNMatrix and dense SUNLinearSolver */
+    A = SUNDenseMatrix(NEQ, NEQ, ctx);
+    if (check_retval((void*)A, "SUNDenseMatrix", 0)) { return (1); }
+
+    LS = SUNLinSol_Dense(uu, A, ctx);
+    if (check_retval((void*)LS, "SUNLinSol_Dense", 0)) { return (1); }
+  }
+
+  /* Attach the matrix and linear solver */
+  retval = IDASetLinearSolver(mem, LS, A);
+  if (check_retval(&retval, "IDASetLinearSolver", 1)) { return (1); }
+
+  /* Supply the Jacobian sparsity pattern for the colored difference
+     quotients */
+  if (sparse)
+  {
+    P = JacPattern(data, ctx);
+    if (check_retval((void*)P, "JacPattern", 0)) { return (1); }
+
+    retval = IDASetJacSparsityPattern(mem, P);
+    if (check_retval(&retval, "IDASetJacSparsityPattern", 1)) { return (1); }
+  }
+
+  /* Call IDACalcIC to correct the initial values. */
+
+  retval = IDACalcIC(mem, IDA_YA_YDP_INIT, t1);
+  if (check_retval(&retval, "IDACalcIC", 1)) { return (1); }
+
+  /* Print output heading. */
+  PrintHeader(rtol, atol);
+
+  PrintOutput(mem, t0, uu);
+
+  /* Loop over output times, call IDASolve, and print results. */
+
+  for (tout = t1, iout = 1; iout <= NOUT; iout++, tout *= TWO)
+  {
+    retval = IDASolve(mem, tout, &tret, uu, up, IDA_NORMAL);
+    if (check_retval(&retval, "IDASolve", 1)) { return (1); }
+
+    PrintOutput(mem, tret, uu);
+  }
+
+  /* Print remaining counters and free memory. */
+  retval = IDAGetNumErrTestFails(mem, &netf);
+  check_retval(&retval, "IDAGetNumErrTestFails", 1);
+  retval = IDAGetNumNonlinSolvConvFails(mem, &ncfn);
+  check_retval(&retval, "IDAGetNumNonlinSolvConvFails", 1);
+  printf("\n netf = %ld,   ncfn = %ld \n", netf, ncfn);
+
+  IDAFree(&mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(P);
+  N_VDestroy(uu);
+  N_VDestroy(up);
+  N_VDestroy(id);
+  N_VDestroy(res);
+  free(data);
+  SUNContext_Free(&ctx);
+
+  return (0);
+}
+
+/*
+ *--------------------------------------------------------------------
+ * FUNCTIONS CALLED BY IDA
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * heatres: heat equation system residual function
+ * This uses 5-point central differencing on the interior points, and
+ * includes algebraic equations for the boundary values.
+ * So for each interior point, the residual component has the form
+ *    res_i = u'_i - (central difference)_i
+ * while for each boundary point, it is res_i = u_i.
+ */
+
+int heatres(sunrealtype tres, N_Vector uu, N_Vector up, N_Vector resval,
+            void* user_data)
+{
+  sunindextype mm, i, j, offset, loc;
+  sunrealtype *uv, *upv, *resv, coeff;
+  UserData data;
+
+  uv   = N_VGetArrayPointer(uu);
+  upv  = N_VGetArrayPointer(up);
+  resv = N_VGetArrayPointer(resval);
+
+  data  = (UserData)user_data;
+  mm    = data->mm;
+  coeff = data->coeff;
+
+  /* Initialize resval to uu, to take care of boundary equations. */
+  N_VScale(ONE, uu, resval);
+
+  /* Loop over interior points; set res = up - (central difference). */
+  for (j = 1; j < mm - 1; j++)
+  {
+    offset = mm * j;
+    for (i = 1; i < mm - 1; i++)
+    {
+      loc       = offset + i;
+      resv[loc] = upv[loc] - coeff * (uv[loc - 1] + uv[loc + 1] + uv[loc - mm] +
+                                      uv[loc + mm] - SUN_RCONST(4.0) * uv[loc]);
+    }
+  }
+
+  return (0);
+}
+
+/*
+ *--------------------------------------------------------------------
+ * PRIVATE FUNCTIONS
+ *--------------------------------------------------------------------
+ */
+
+/*
+ * SetInitialProfile: routine to initialize u, up, and id vectors.
+ */
+
+static int SetInitialProfile(UserData data, N_Vector uu, N_Vector up,
+                             N_Vector id, N_Vector res)
+{
+  sunrealtype xfact, yfact, *udata, *updata, *iddata;
+  sunindextype mm, mm1, i, j, offset, loc;
+
+  mm  = data->mm;
+  mm1 = mm - 1;
+
+  udata  = N_VGetArrayPointer(uu);
+  updata = N_VGetArrayPointer(up);
+  iddata = N_VGetArrayPointer(id);
+
+  /* Initialize id to 1's. */
+  N_VConst(ONE, id);
+
+  /* Initialize uu on all grid points. */
+  for (j = 0; j < mm; j++)
+  {
+    yfact  = data->dx * j;
+    offset = mm * j;
+    for (i = 0; i < mm; i++)
+    {
+      xfact      = data->dx * i;
+      loc        = offset + i;
+      udata[loc] = SUN_RCONST(16.0) * xfact * (ONE - xfact) * yfact *
+                   (ONE - yfact);
+    }
+  }
+
+  /* Initialize up vector to 0. */
+  N_VConst(ZERO, up);
+
+  /* heatres sets res to negative of ODE RHS values at interior points. */
+  heatres(ZERO, uu, up, res, data);
+
+  /* Copy -res into up to get correct interior initial up values. */
+  N_VScale(-ONE, res, up);
+
+  /* Finally, set values of u, up, and id at boundary points. */
+  for (j = 0; j < mm; j++)
+  {
+    offset = mm * j;
+    for (i = 0; i < mm; i++)
+    {
+      loc = offset + i;
+      if (j == 0 || j == mm1 || i == 0 || i == mm1)
+      {
+        udata[loc]  = BVAL;
+        updata[loc] = ZERO;
+        iddata[loc] = ZERO;
+      }
+    }
+  }
+
+  return (0);
+}
+
+/*
+ * JacPattern: routine to create the CSC nonzero pattern of the Jacobian.
+ * Column loc holds the boundary or interior equation at loc itself and the
+ * equations at the neighboring interior points.
+ */
+
+static SUNMatrix JacPattern(UserData data, SUNContext ctx)
+{
+  SUNMatrix P;
+  sunindextype *colptrs, *rowvals;
+  sunrealtype* pdata;
+  sunindextype mm, mm1, i, j, loc, nz;
+
+  mm  = data->mm;
+  mm1 = mm - 1;
+
+  P = SUNSparseMatrix(NEQ, NEQ, 5 * NEQ, CSC_MAT, ctx);
+  if (P == NULL) { return (NULL); }
+
+  colptrs = SUNSparseMatrix_IndexPointers(P);
+  rowvals = SUNSparseMatrix_IndexValues(P);
+  pdata   = SUNSparseMatrix_Data(P);
+
+  /* the rows of each column are stored in increasing order */
+  nz = 0;
+  for (j = 0; j < mm; j++)
+  {
+    for (i = 0; i < mm; i++)
+    {
+      loc          = mm * j + i;
+      colptrs[loc] = nz;
+      if (j > 1 && i > 0 && i < mm1) { rowvals[nz++] = loc - mm; }
+      if (i > 1 && j > 0 && j < mm1) { rowvals[nz++] = loc - 1; }
+      rowvals[nz++] = loc;
+      if (i < mm - 2 && j > 0 && j < mm1) { rowvals[nz++] = loc + 1; }
+      if (j < mm - 2 && i > 0 && i < mm1) { rowvals[nz++] = loc + mm; }
+    }
+  }
+  colptrs[NEQ] = nz;
+
+  for (loc = 0; loc < nz; loc++) { pdata[loc] = ONE; }
+
+  return (P);
+}
+
+/*
+ * Print first lines of output (problem description)
+ */
+
+static void PrintHeader(sunrealtype rtol, sunrealtype atol)
+{
+  printf("\nidaHeat2D_sparse_dq: Heat equation, serial example problem for "
+         "IDA\n");
+  printf("          Discretized heat equation on 2D unit square.\n");
+  printf("          Zero boundary conditions,");
+  printf(" polynomial initial conditions.\n");
+  printf("          Mesh dimensions: %d x %d", MGRID, MGRID);
+  printf("        Total system size: %d\n\n", NEQ);
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("Tolerance parameters:  rtol = %Lg   atol = %Lg\n", rtol, atol);
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+  printf("Tolerance parameters:  rtol = %g   atol = %g\n", rtol, atol);
+#else
+  printf("Tolerance parameters:  rtol = %g   atol = %g\n", rtol, atol);
+#endif
+  printf("Linear solver: direct solver, difference quotient Jacobian \n");
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("IDACalcIC called with input boundary values = %Lg \n", BVAL);
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+  printf("IDACalcIC called with input boundary values = %g \n", BVAL);
+#else
+  printf("IDACalcIC called with input boundary values = %g \n", BVAL);
+#endif
+  /* Print output table heading and initial line of table. */
+  printf("\n   Output Summary (umax = max-norm of solution) \n\n");
+  printf("  time       umax     k  nst  nni  nje   nre     h      \n");
+  printf(" .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  . \n");
+}
+
+/*
+ * Print Output
+ */
+
+static void PrintOutput(void* mem, sunrealtype t, N_Vector uu)
+{
+  int retval;
+  sunrealtype umax, hused;
+  long int nst, nni, nje, nre;
+  int kused;
+
+  umax = N_VMaxNorm(uu);
+
+  retval = IDAGetLastOrder(mem, &kused);
+  check_retval(&retval, "IDAGetLastOrder", 1);
+  retval = IDAGetNumSteps(mem, &nst);
+  check_retval(&retval, "IDAGetNumSteps", 1);
+  retval = IDAGetNumNonlinSolvIters(mem, &nni);
+  check_retval(&retval, "IDAGetNumNonlinSolvIters", 1);
+  retval = IDAGetNumResEvals(mem, &nre);
+  check_retval(&retval, "IDAGetNumResEvals", 1);
+  retval = IDAGetLastStep(mem, &hused);
+  check_retval(&retval, "IDAGetLastStep", 1);
+  retval = IDAGetNumJacEvals(mem, &nje);
+  check_retval(&retval, "IDAGetNumJacEvals", 1);
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  printf(" %5.2Lf %13.5Le  %d  %3ld  %3ld  %3ld  %4ld  %9.2Le \n", t, umax,
+         kused, nst, nni, nje, nre, hused);
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+  printf(" %5.2f %13.5e  %d  %3ld  %3ld  %3ld  %4ld  %9.2e \n", t, umax,
+         kused, nst, nni, nje, nre, hused);
+#else
+  printf(" %5.2f %13.5e  %d  %3ld  %3ld  %3ld  %4ld  %9.2e \n", t, umax,
+         kused, nst, nni, nje, nre, hused);
+#endif
+}
+
+/*
+ * Check function return value...
+ *   opt == 0 means SUNDIALS function allocates memory so check if
+ *            returned NULL pointer
+ *   opt == 1 means SUNDIALS function returns an integer value so check if
+ *            retval < 0
+ *   opt == 2 means function allocates memory so check if returned
+ *            NULL pointer
+ */
+
+static int check_retval(void* returnvalue, const char* funcname, int opt)
+{
+  int* retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+  else if (opt == 1)
+  {
+    /* Check if retval < 0 */
+    retval = (int*)returnvalue;
+    if (*retval < 0)
+    {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return (1);
+    }
+  }
+  else if (opt == 2 && returnvalue == NULL)
+  {
+    /* Check if function returned NULL pointer - no memory allocated */
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  return (0);
+}
@@ -23,6 +23,11 @@
 
 #include "test_nvector.h"
 
+/* OpenMP vector specific tests */
+static int Test_FirstTouch(N_Vector X, sunindextype local_length, int nthreads);
+static int Test_Reproducible(N_Vector X, N_Vector Y, N_Vector Z,
+                             sunindextype local_length, int nthreads);
+
 /* ----------------------------------------------------------------------
  * Main NVector Testing Routine
  * --------------------------------------------------------------------*/
@@ -229,6 +234,31 @@ int main(int argc, char* argv[])
   fails += Test_N_VBufPack(X, length, 0);
   fails += Test_N_VBufUnpack(X, length, 0);
 
+  /* OpenMP vector specific tests */
+  printf("\nTesting data placement options:\n\n");
+
+  fails += Test_FirstTouch(X, length, nthreads);
+
+#if !defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("\nTesting reproducible reductions:\n\n");
+
+  N_VSetReproducibleReductions_OpenMP(X, SUNTRUE);
+  N_VSetReproducibleReductions_OpenMP(V, SUNTRUE);
+  fails += Test_N_VDotProd(X, Y, length, 0);
+  fails += Test_N_VWrmsNorm(X, Y, length, 0);
+  fails += Test_N_VWrmsNormMask(X, Y, Z, length, 0);
+  fails += Test_N_VWL2Norm(X, Y, length, 0);
+  fails += Test_N_VL1Norm(X, length, 0);
+  fails += Test_N_VWSqrSumLocal(X, Y, length, 0);
+  fails += Test_N_VWSqrSumMaskLocal(X, Y, Z, length, 0);
+  fails += Test_N_VDotProdMulti(V, length, 0);
+  fails += Test_N_VWrmsNormVectorArray(V, length, 0);
+  fails += Test_N_VWrmsNormMaskVectorArray(V, length, 0);
+  N_VSetReproducibleReductions_OpenMP(X, SUNFALSE);
+
+  fails += Test_Reproducible(X, Y, Z, length, nthreads);
+#endif
+
   /* Free vectors */
   N_VDestroy(W);
   N_VDestroy(X);
@@ -245,6 +275,170 @@ int main(int argc, char* argv[])
   return (fails);
 }
 
+/* ----------------------------------------------------------------------
+ * Test the parallel first touch and the thread partition
+ * --------------------------------------------------------------------*/
+static int Test_FirstTouch(N_Vector X, sunindextype local_length, int nthreads)
+{
+  int fails = 0, t;
+  sunindextype* offsets;
+  sunbooleantype bound;
+  N_Vector Y;
+
+  /* enabling the first touch keeps the data of X */
+  N_VConst(TWO, X);
+  if (N_VSetFirstTouch_OpenMP(X, SUNTRUE) || check_ans(TWO, X, local_length))
+  {
+    printf(">>> FAILED test -- N_VSetFirstTouch_OpenMP \n");
+    fails++;
+  }
+
+  /* clones inherit the setting */
+  Y = N_VClone(X);
+  N_VScale(HALF, X, Y);
+  if (!NV_FIRST_TOUCH_OMP(Y) || check_ans(ONE, Y, local_length))
+  {
+    printf(">>> FAILED test -- N_VClone with first touch \n");
+    fails++;
+  }
+  N_VDestroy(Y);
+  N_VSetFirstTouch_OpenMP(X, SUNFALSE);
+
+  /* the partition covers the vector with ordered contiguous ranges */
+  offsets = (sunindextype*)malloc((nthreads + 1) * sizeof(sunindextype));
+  if (N_VGetThreadPartition_OpenMP(X, offsets) || offsets[0] != 0 ||
+      offsets[nthreads] != local_length)
+  {
+    printf(">>> FAILED test -- N_VGetThreadPartition_OpenMP \n");
+    fails++;
+  }
+  for (t = 0; t < nthreads; t++)
+  {
+    if (offsets[t] > offsets[t + 1])
+    {
+      printf(">>> FAILED test -- N_VGetThreadPartition_OpenMP \n");
+      fails++;
+      break;
+    }
+  }
+  free(offsets);
+
+  if (N_VGetThreadsBound_OpenMP(X, &bound))
+  {
+    printf(">>> FAILED test -- N_VGetThreadsBound_OpenMP \n");
+    fails++;
+  }
+
+  if (fails == 0)
+  {
+    printf("PASSED test -- first touch and thread partition (threads %s)\n",
+           bound ? "bound" : "not bound");
+  }
+
+  return (fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Test that the reproducible reductions do not depend on the number of
+ * threads or on the order of the elements
+ * --------------------------------------------------------------------*/
+static int Test_Reproducible(N_Vector X, N_Vector Y, N_Vector Z,
+                             sunindextype local_length, int nthreads)
+{
+  int fails = 0, t, k;
+  sunindextype i;
+  sunrealtype *xd, *yd, *zd, *rd[3];
+  sunrealtype ref[5] = {ZERO, ZERO, ZERO, ZERO, ZERO}, val[5];
+  N_Vector R[3];
+
+  /* terms of widely varying magnitude and sign with heavy cancellation */
+  xd = N_VGetArrayPointer(X);
+  yd = N_VGetArrayPointer(Y);
+  zd = N_VGetArrayPointer(Z);
+  for (i = 0; i < local_length; i++)
+  {
+    xd[i] = SUNRpowerI(SUN_RCONST(10.0), (int)(i % 13) - 6) *
+            (sunrealtype)((i * 7919) % 1001 - 500) / SUN_RCONST(500.0);
+    yd[i] = ONE + SUN_RCONST(1.0e-3) * (sunrealtype)(i % 7);
+    zd[i] = (i % 3) ? ONE : ZERO;
+  }
+
+  /* the same values in reverse order */
+  for (k = 0; k < 3; k++)
+  {
+    R[k]  = N_VClone(X);
+    rd[k] = N_VGetArrayPointer(R[k]);
+  }
+  for (i = 0; i < local_length; i++)
+  {
+    rd[0][i] = xd[local_length - 1 - i];
+    rd[1][i] = yd[local_length - 1 - i];
+    rd[2][i] = zd[local_length - 1 - i];
+  }
+
+  N_VSetReproducibleReductions_OpenMP(X, SUNTRUE);
+  N_VSetReproducibleReductions_OpenMP(R[0], SUNTRUE);
+
+  for (t = 1; t <= nthreads + 2; t++)
+  {
+    NV_NUM_THREADS_OMP(X)    = t;
+    NV_NUM_THREADS_OMP(R[0]) = nthreads + 3 - t;
+
+    val[0] = N_VDotProd(X, Y);
+    val[1] = N_VWrmsNorm(X, Y);
+    val[2] = N_VWrmsNormMask(X, Y, Z);
+    val[3] = N_VL1Norm(X);
+    val[4] = N_VWL2Norm(X, Y);
+    if (t == 1)
+    {
+      for (k = 0; k < 5; k++) { ref[k] = val[k]; }
+    }
+    for (k = 0; k < 5; k++)
+    {
+      if (val[k] != ref[k])
+      {
+        printf(">>> FAILED test -- reproducible reduction %d with %d threads\n",
+               k, t);
+        fails++;
+      }
+    }
+
+    val[0] = N_VDotProd(R[0], R[1]);
+    val[1] = N_VWrmsNorm(R[0], R[1]);
+    val[2] = N_VWrmsNormMask(R[0], R[1], R[2]);
+    val[3] = N_VL1Norm(R[0]);
+    val[4] = N_VWL2Norm(R[0], R[1]);
+    for (k = 0; k < 5; k++)
+    {
+      if (val[k] != ref[k])
+      {
+        printf(">>> FAILED test -- reproducible reduction %d reversed\n", k);
+        fails++;
+      }
+    }
+  }
+
+  /* the result agrees with the standard reduction */
+  NV_NUM_THREADS_OMP(X) = nthreads;
+  N_VSetReproducibleReductions_OpenMP(X, SUNFALSE);
+  if (SUNRCompareTol(ref[0], N_VDotProd(X, Y), 1000 * SUN_UNIT_ROUNDOFF) ||
+      SUNRCompareTol(ref[3], N_VL1Norm(X), 1000 * SUN_UNIT_ROUNDOFF))
+  {
+    printf(">>> FAILED test -- reproducible reductions accuracy\n");
+    fails++;
+  }
+
+  for (k = 0; k < 3; k++) { N_VDestroy(R[k]); }
+
+  if (fails == 0)
+  {
+    printf("PASSED test -- reproducible reductions with 1 to %d threads\n",
+           nthreads + 2);
+  }
+
+  return (fails);
+}
+
 /* ----------------------------------------------------------------------
  * Implementation specific utility functions for vector tests
  * --------------------------------------------------------------------*/
@@ -0,0 +1,363 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the NVECTOR Lazy module
+ * implementation wrapping a serial vector.
+ * -----------------------------------------------------------------*/
+
+#include <nvector/nvector_lazy.h>
+#include <nvector/nvector_serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#include "test_nvector.h"
+
+/* lazy vector specific tests */
+static int Test_Fusion(N_Vector X, sunindextype local_length);
+static int Test_Dependencies(N_Vector X, sunindextype local_length);
+
+/* ----------------------------------------------------------------------
+ * Main NVector Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  int fails = 0;             /* counter for test failures */
+  sunindextype length;       /* vector length             */
+  N_Vector Xbase;            /* wrapped serial vector     */
+  N_Vector U, W, X, Y, Z;    /* test vectors              */
+  int print_timing;          /* turn timing on/off        */
+
+  Test_Init(SUN_COMM_NULL);
+
+  /* check input and set vector length */
+  if (argc < 3)
+  {
+    printf("ERROR: TWO (2) Inputs required: vector length, print timing \n");
+    Test_Finalize();
+    return (-1);
+  }
+
+  length = (sunindextype)atol(argv[1]);
+  if (length <= 0)
+  {
+    printf("ERROR: length of vector must be a positive integer \n");
+    Test_Finalize();
+    return (-1);
+  }
+
+  print_timing = atoi(argv[2]);
+  SetTiming(print_timing, 0);
+
+  printf("Testing lazy N_Vector \n");
+  printf("Vector length %ld \n", (long int)length);
+
+  /* Create new vectors */
+  Xbase = N_VNew_Serial(length, sunctx);
+  if (Xbase == NULL)
+  {
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  X = N_VMake_Lazy(Xbase, sunctx);
+  if (X == NULL)
+  {
+    N_VDestroy(Xbase);
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  W = N_VCloneEmpty(X);
+  if (W == NULL)
+  {
+    N_VDestroy(X);
+    N_VDestroy(Xbase);
+    printf("FAIL: Unable to create a new empty vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  /* Check vector ID */
+  fails += Test_N_VGetVectorID(X, SUNDIALS_NVEC_LAZY, 0);
+
+  /* Check vector length */
+  fails += Test_N_VGetLength(X, 0);
+
+  /* Check vector communicator */
+  fails += Test_N_VGetCommunicator(X, SUN_COMM_NULL, 0);
+
+  /* Test clone functions */
+  fails += Test_N_VCloneEmpty(X, 0);
+  fails += Test_N_VClone(X, length, 0);
+  fails += Test_N_VCloneEmptyVectorArray(5, X, 0);
+  fails += Test_N_VCloneVectorArray(5, X, length, 0);
+
+  /* Test setting/getting array data */
+  fails += Test_N_VSetArrayPointer(W, length, 0);
+  fails += Test_N_VGetArrayPointer(X, length, 0);
+
+  /* Clone additional vectors for testing */
+  Y = N_VClone(X);
+  Z = N_VClone(X);
+  U = N_VClone(X);
+  if (Y == NULL || Z == NULL || U == NULL)
+  {
+    N_VDestroy(W);
+    N_VDestroy(X);
+    N_VDestroy(Xbase);
+    if (Y) { N_VDestroy(Y); }
+    if (Z) { N_VDestroy(Z); }
+    if (U) { N_VDestroy(U); }
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  /* Standard vector operation tests */
+  printf("\nTesting standard vector operations:\n\n");
+
+  fails += Test_N_VConst(X, length, 0);
+  fails += Test_N_VLinearSum(X, Y, Z, length, 0);
+  fails += Test_N_VProd(X, Y, Z, length, 0);
+  fails += Test_N_VDiv(X, Y, Z, length, 0);
+  fails += Test_N_VScale(X, Z, length, 0);
+  fails += Test_N_VAbs(X, Z, length, 0);
+  fails += Test_N_VInv(X, Z, length, 0);
+  fails += Test_N_VAddConst(X, Z, length, 0);
+  fails += Test_N_VDotProd(X, Y, length, 0);
+  fails += Test_N_VMaxNorm(X, length, 0);
+  fails += Test_N_VWrmsNorm(X, Y, length, 0);
+  fails += Test_N_VWrmsNormMask(X, Y, Z, length, 0);
+  fails += Test_N_VMin(X, length, 0);
+  fails += Test_N_VWL2Norm(X, Y, length, 0);
+  fails += Test_N_VL1Norm(X, length, 0);
+  fails += Test_N_VCompare(X, Z, length, 0);
+  fails += Test_N_VInvTest(X, Z, length, 0);
+  fails += Test_N_VConstrMask(X, Y, Z, length, 0);
+  fails += Test_N_VMinQuotient(X, Y, length, 0);
+
+  /* Fused and vector array operations tests (default implementations) */
+  printf("\nTesting fused and vector array operations (recorded):\n\n");
+
+  /* fused operations */
+  fails += Test_N_VLinearCombination(U, length, 0);
+  fails += Test_N_VScaleAddMulti(U, length, 0);
+  fails += Test_N_VDotProdMulti(U, length, 0);
+
+  /* vector array operations */
+  fails += Test_N_VLinearSumVectorArray(U, length, 0);
+  fails += Test_N_VScaleVectorArray(U, length, 0);
+  fails += Test_N_VConstVectorArray(U, length, 0);
+  fails += Test_N_VWrmsNormVectorArray(U, length, 0);
+  fails += Test_N_VWrmsNormMaskVectorArray(U, length, 0);
+  fails += Test_N_VScaleAddMultiVectorArray(U, length, 0);
+  fails += Test_N_VLinearCombinationVectorArray(U, length, 0);
+
+  /* local reduction operations */
+  printf("\nTesting local reduction operations:\n\n");
+
+  fails += Test_N_VDotProdLocal(X, Y, length, 0);
+  fails += Test_N_VMaxNormLocal(X, length, 0);
+  fails += Test_N_VMinLocal(X, length, 0);
+  fails += Test_N_VL1NormLocal(X, length, 0);
+  fails += Test_N_VWSqrSumLocal(X, Y, length, 0);
+  fails += Test_N_VWSqrSumMaskLocal(X, Y, Z, length, 0);
+  fails += Test_N_VInvTestLocal(X, Z, length, 0);
+  fails += Test_N_VConstrMaskLocal(X, Y, Z, length, 0);
+  fails += Test_N_VMinQuotientLocal(X, Y, length, 0);
+
+  /* XBraid interface operations */
+  printf("\nTesting XBraid interface operations:\n\n");
+
+  fails += Test_N_VBufSize(X, length, 0);
+  fails += Test_N_VBufPack(X, length, 0);
+  fails += Test_N_VBufUnpack(X, length, 0);
+
+  /* deferred evaluation */
+  printf("\nTesting deferred evaluation:\n\n");
+
+  fails += Test_Fusion(X, length);
+  fails += Test_Dependencies(X, length);
+
+  /* Free vectors */
+  N_VDestroy(W);
+  N_VDestroy(X);
+  N_VDestroy(Xbase);
+  N_VDestroy(Y);
+  N_VDestroy(Z);
+  N_VDestroy(U);
+
+  /* Print result */
+  if (fails) { printf("FAIL: NVector module failed %i tests \n\n", fails); }
+  else { printf("SUCCESS: NVector module passed all tests \n\n"); }
+
+  Test_Finalize();
+  return (fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Check that a chain of streaming operations followed by a norm is
+ * evaluated in one loop
+ * --------------------------------------------------------------------*/
+static int Test_Fusion(N_Vector X, sunindextype local_length)
+{
+  int failure = 0;
+  long int nops, nloops;
+  sunrealtype nrm;
+  N_Vector Y, Z, W;
+
+  Y = N_VClone(X);
+  Z = N_VClone(X);
+  W = N_VClone(X);
+
+  N_VConst(SUN_RCONST(1.0), X);
+  N_VConst(SUN_RCONST(2.0), Y);
+  N_VConst(SUN_RCONST(0.5), W);
+  N_VFlush_Lazy(X);
+  N_VFlush_Lazy(Y);
+  N_VFlush_Lazy(W);
+
+  /* Z = 4*(2*(3*X - Y) + 1) is pending until the norm is computed */
+  N_VConst(SUN_RCONST(1.0), Z);
+  N_VLinearSum(SUN_RCONST(3.0), X, -SUN_RCONST(1.0), Y, Y);
+  N_VLinearSum(SUN_RCONST(2.0), Y, SUN_RCONST(1.0), Z, Z);
+  N_VScale(SUN_RCONST(4.0), Z, Z);
+  nrm = N_VWrmsNorm(Z, W);
+
+  N_VGetNumOps_Lazy(Z, &nops, &nloops);
+
+  /* Z = 4*(2*(3 - 2) + 1) = 12, ||Z|| = 6 */
+  failure += SUNRCompare(nrm, SUN_RCONST(6.0));
+  failure += check_ans(SUN_RCONST(12.0), Z, local_length);
+  failure += (nops != 3 || nloops != 1);
+
+  /* Y is still pending and is materialized on access */
+  failure += check_ans(SUN_RCONST(1.0), Y, local_length);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- deferred evaluation fusion (ops %ld, loops "
+           "%ld)\n",
+           nops, nloops);
+  }
+  else { printf("PASSED test -- deferred evaluation fusion \n"); }
+
+  N_VDestroy(Y);
+  N_VDestroy(Z);
+  N_VDestroy(W);
+
+  return (failure ? 1 : 0);
+}
+
+/* ----------------------------------------------------------------------
+ * Check that pending operations read the values of their inputs at the
+ * time they were recorded
+ * --------------------------------------------------------------------*/
+static int Test_Dependencies(N_Vector X, sunindextype local_length)
+{
+  int failure = 0;
+  N_Vector Y, Z, T;
+
+  Y = N_VClone(X);
+  Z = N_VClone(X);
+  T = N_VClone(X);
+
+  N_VConst(SUN_RCONST(1.0), X);
+  N_VConst(SUN_RCONST(2.0), Y);
+  N_VFlush_Lazy(X);
+  N_VFlush_Lazy(Y);
+
+  /* Z = X + Y reads the data of X, which is then overwritten */
+  N_VLinearSum(SUN_RCONST(1.0), X, SUN_RCONST(1.0), Y, Z);
+  N_VScale(SUN_RCONST(5.0), X, X);
+  N_VFlush_Lazy(X);
+  failure += check_ans(SUN_RCONST(3.0), Z, local_length);
+  failure += check_ans(SUN_RCONST(5.0), X, local_length);
+
+  /* T = 2*Y reads the data of Y, which is then accessed for writing */
+  N_VScale(SUN_RCONST(2.0), Y, T);
+  set_element_range(Y, 0, local_length - 1, SUN_RCONST(-1.0));
+  failure += check_ans(SUN_RCONST(4.0), T, local_length);
+
+  /* T = 3*Z reads the data of Z, which is then destroyed */
+  N_VScale(SUN_RCONST(3.0), Z, T);
+  N_VDestroy(Z);
+  failure += check_ans(SUN_RCONST(9.0), T, local_length);
+
+  if (failure) { printf(">>> FAILED test -- deferred evaluation order\n"); }
+  else { printf("PASSED test -- deferred evaluation order \n"); }
+
+  N_VDestroy(Y);
+  N_VDestroy(T);
+
+  return (failure ? 1 : 0);
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation specific utility functions for vector tests
+ * --------------------------------------------------------------------*/
+int check_ans(sunrealtype ans, N_Vector X, sunindextype local_length)
+{
+  int failure = 0;
+  sunindextype i;
+  sunrealtype* Xdata;
+
+  Xdata = N_VGetArrayPointer(X);
+
+  /* check vector data */
+  for (i = 0; i < local_length; i++) { failure += SUNRCompare(Xdata[i], ans); }
+
+  return (failure > ZERO) ? (1) : (0);
+}
+
+sunbooleantype has_data(N_Vector X)
+{
+  /* check if data array is non-null */
+  return (N_VGetArrayPointer(X) == NULL) ? SUNFALSE : SUNTRUE;
+}
+
+void set_element(N_Vector X, sunindextype i, sunrealtype val)
+{
+  /* set i-th element of data array */
+  set_element_range(X, i, i, val);
+}
+
+void set_element_range(N_Vector X, sunindextype is, sunindextype ie,
+                       sunrealtype val)
+{
+  sunindextype i;
+
+  /* set elements [is,ie] of the data array */
+  sunrealtype* xd = N_VGetArrayPointer(X);
+  for (i = is; i <= ie; i++) { xd[i] = val; }
+}
+
+sunrealtype get_element(N_Vector X, sunindextype i)
+{
+  /* get i-th element of data array */
+  return N_VGetArrayPointer(X)[i];
+}
+
+double max_time(N_Vector X, double time)
+{
+  /* not running in parallel, just return input time */
+  return (time);
+}
+
+void sync_device(N_Vector x)
+{
+  /* not running on GPU, just return */
+  return;
+}
@@ -36,6 +36,7 @@ int main(int argc, char* argv[])
   N_Vector Xsub[2];          /* subvector pointer array   */
   N_Vector U, V, W, X, Y, Z; /* test vectors              */
   int print_timing;          /* turn timing on/off        */
+  int nthreads;              /* number of threads         */
 
   Test_Init(SUN_COMM_NULL);
 
@@ -64,11 +65,21 @@ int main(int argc, char* argv[])
   print_timing = atoi(argv[3]);
   SetTiming(print_timing, 0);
 
+  /* optional number of threads operating on the subvectors */
+  nthreads = 1;
+  if (argc > 4) { nthreads = atoi(argv[4]); }
+  if (nthreads <= 0)
+  {
+    printf("ERROR: number of threads must be a positive integer \n");
+    Test_Abort(1);
+  }
+
   /* overall length */
   length = len1 + len2;
 
   printf("Testing ManyVector (serial) N_Vector \n");
   printf("Vector lengths: %ld %ld \n", (long int)len1, (long int)len2);
+  printf("Number of threads: %d \n", nthreads);
 
   /* Create subvectors */
   Xsub[0] = N_VNew_Serial(len1, sunctx);
@@ -88,6 +99,22 @@ int main(int argc, char* argv[])
   /* Create a new ManyVector */
   X = N_VNew_ManyVector(2, Xsub, sunctx);
 
+  /* Operate on the subvectors with nthreads threads (inherited by clones) */
+  retval = N_VSetNumThreads_ManyVector(X, nthreads);
+  if (retval != 0)
+  {
+    printf(">>> FAILED test -- N_VSetNumThreads_ManyVector\n");
+    fails += 1;
+  }
+  else if (nthreads > 1 &&
+           (((N_VectorContent_ManyVector)X->content)->num_threads != 2 ||
+            ((N_VectorContent_ManyVector)X->content)->thread_offsets[1] != 1))
+  {
+    /* two subvectors are split into one group per thread */
+    printf(">>> FAILED test -- N_VSetNumThreads_ManyVector partition\n");
+    fails += 1;
+  }
+
   /* Check vector ID */
   fails += Test_N_VGetVectorID(X, SUNDIALS_NVEC_MANYVECTOR, 0);
 
@@ -0,0 +1,364 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the NVECTOR Mixed module
+ * implementation.
+ * -----------------------------------------------------------------*/
+
+#include <float.h>
+#include <nvector/nvector_mixed.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#include "test_nvector.h"
+
+/* private test of the conversion functions and the reduction precision */
+static int Test_Mixed_Precision(N_Vector X, sunindextype length);
+
+/* ----------------------------------------------------------------------
+ * Main NVector Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  int fails = 0;          /* counter for test failures */
+  int retval;             /* function return value     */
+  sunindextype length;    /* vector length             */
+  N_Vector U, V, X, Y, Z; /* test vectors              */
+  int print_timing;       /* turn timing on/off        */
+  int nthreads;           /* number of threads         */
+
+  Test_Init(SUN_COMM_NULL);
+
+  /* check input and set vector length */
+  if (argc < 3)
+  {
+    printf("ERROR: TWO (2) Inputs required: vector length, print timing \n");
+    Test_Finalize();
+    return (-1);
+  }
+
+  length = (sunindextype)atol(argv[1]);
+  if (length <= 0)
+  {
+    printf("ERROR: length of vector must be a positive integer \n");
+    Test_Finalize();
+    return (-1);
+  }
+
+  print_timing = atoi(argv[2]);
+  SetTiming(print_timing, 0);
+
+  /* optionally set the number of threads */
+  nthreads = (argc > 3) ? atoi(argv[3]) : 1;
+  if (nthreads < 1)
+  {
+    printf("ERROR: number of threads must be a positive integer \n");
+    Test_Finalize();
+    return (-1);
+  }
+
+  printf("Testing mixed-precision N_Vector \n");
+  printf("Vector length %ld \n", (long int)length);
+  printf("Number of threads %d \n", nthreads);
+
+  /* Create new vectors */
+  X = N_VNew_Mixed(length, sunctx);
+  if (X == NULL || N_VSetNumThreads_Mixed(X, nthreads))
+  {
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  /* Check vector ID */
+  fails += Test_N_VGetVectorID(X, SUNDIALS_NVEC_MIXED, 0);
+
+  /* Check vector length */
+  fails += Test_N_VGetLength(X, 0);
+
+  /* Check vector communicator */
+  fails += Test_N_VGetCommunicator(X, SUN_COMM_NULL, 0);
+
+  /* Test clone functions */
+  fails += Test_N_VCloneEmpty(X, 0);
+  fails += Test_N_VClone(X, length, 0);
+  fails += Test_N_VCloneEmptyVectorArray(5, X, 0);
+  fails += Test_N_VCloneVectorArray(5, X, length, 0);
+
+  /* Clone additional vectors for testing */
+  Y = N_VClone(X);
+  if (Y == NULL)
+  {
+    N_VDestroy(X);
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  Z = N_VClone(X);
+  if (Z == NULL)
+  {
+    N_VDestroy(X);
+    N_VDestroy(Y);
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  /* Standard vector operation tests */
+  printf("\nTesting standard vector operations:\n\n");
+
+  fails += Test_N_VConst(X, length, 0);
+  fails += Test_N_VLinearSum(X, Y, Z, length, 0);
+  fails += Test_N_VProd(X, Y, Z, length, 0);
+  fails += Test_N_VDiv(X, Y, Z, length, 0);
+  fails += Test_N_VScale(X, Z, length, 0);
+  fails += Test_N_VAbs(X, Z, length, 0);
+  fails += Test_N_VInv(X, Z, length, 0);
+  fails += Test_N_VAddConst(X, Z, length, 0);
+  fails += Test_N_VDotProd(X, Y, length, 0);
+  fails += Test_N_VMaxNorm(X, length, 0);
+  fails += Test_N_VWrmsNorm(X, Y, length, 0);
+  fails += Test_N_VWrmsNormMask(X, Y, Z, length, 0);
+  fails += Test_N_VMin(X, length, 0);
+  fails += Test_N_VWL2Norm(X, Y, length, 0);
+  fails += Test_N_VL1Norm(X, length, 0);
+  fails += Test_N_VCompare(X, Z, length, 0);
+  fails += Test_N_VInvTest(X, Z, length, 0);
+  fails += Test_N_VConstrMask(X, Y, Z, length, 0);
+  fails += Test_N_VMinQuotient(X, Y, length, 0);
+
+  /* Fused and vector array operations tests (disabled) */
+  printf("\nTesting fused and vector array operations (disabled):\n\n");
+
+  /* create vector and disable all fused operations */
+  U      = N_VClone(X);
+  retval = (U == NULL) ? -1 : N_VEnableFusedOps_Mixed(U, SUNFALSE);
+  if (U == NULL || retval != 0)
+  {
+    N_VDestroy(X);
+    N_VDestroy(Y);
+    N_VDestroy(Z);
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  /* fused operations */
+  fails += Test_N_VLinearCombination(U, length, 0);
+  fails += Test_N_VScaleAddMulti(U, length, 0);
+  fails += Test_N_VDotProdMulti(U, length, 0);
+
+  /* vector array operations */
+  fails += Test_N_VLinearSumVectorArray(U, length, 0);
+  fails += Test_N_VScaleVectorArray(U, length, 0);
+  fails += Test_N_VConstVectorArray(U, length, 0);
+  fails += Test_N_VWrmsNormVectorArray(U, length, 0);
+  fails += Test_N_VWrmsNormMaskVectorArray(U, length, 0);
+  fails += Test_N_VScaleAddMultiVectorArray(U, length, 0);
+  fails += Test_N_VLinearCombinationVectorArray(U, length, 0);
+
+  /* Fused and vector array operations tests (enabled) */
+  printf("\nTesting fused and vector array operations (enabled):\n\n");
+
+  /* create vector and enable all fused operations */
+  V      = N_VClone(X);
+  retval = (V == NULL) ? -1 : N_VEnableFusedOps_Mixed(V, SUNTRUE);
+  if (V == NULL || retval != 0)
+  {
+    N_VDestroy(X);
+    N_VDestroy(Y);
+    N_VDestroy(Z);
+    N_VDestroy(U);
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Finalize();
+    return (1);
+  }
+
+  /* fused operations */
+  fails += Test_N_VLinearCombination(V, length, 0);
+  fails += Test_N_VScaleAddMulti(V, length, 0);
+  fails += Test_N_VDotProdMulti(V, length, 0);
+
+  /* vector array operations */
+  fails += Test_N_VLinearSumVectorArray(V, length, 0);
+  fails += Test_N_VScaleVectorArray(V, length, 0);
+  fails += Test_N_VConstVectorArray(V, length, 0);
+  fails += Test_N_VWrmsNormVectorArray(V, length, 0);
+  fails += Test_N_VWrmsNormMaskVectorArray(V, length, 0);
+  fails += Test_N_VScaleAddMultiVectorArray(V, length, 0);
+  fails += Test_N_VLinearCombinationVectorArray(V, length, 0);
+
+  /* local reduction operations */
+  printf("\nTesting local reduction operations:\n\n");
+
+  fails += Test_N_VDotProdLocal(X, Y, length, 0);
+  fails += Test_N_VMaxNormLocal(X, length, 0);
+  fails += Test_N_VMinLocal(X, length, 0);
+  fails += Test_N_VL1NormLocal(X, length, 0);
+  fails += Test_N_VWSqrSumLocal(X, Y, length, 0);
+  fails += Test_N_VWSqrSumMaskLocal(X, Y, Z, length, 0);
+  fails += Test_N_VInvTestLocal(X, Z, length, 0);
+  fails += Test_N_VConstrMaskLocal(X, Y, Z, length, 0);
+  fails += Test_N_VMinQuotientLocal(X, Y, length, 0);
+
+  /* local fused reduction operations */
+  printf("\nTesting local fused reduction operations:\n\n");
+  fails += Test_N_VDotProdMultiLocal(V, length, 0);
+
+  /* XBraid interface operations */
+  printf("\nTesting XBraid interface operations:\n\n");
+
+  fails += Test_N_VBufSize(X, length, 0);
+  fails += Test_N_VBufPack(X, length, 0);
+  fails += Test_N_VBufUnpack(X, length, 0);
+
+  /* mixed precision storage */
+  printf("\nTesting mixed precision storage:\n\n");
+
+  fails += Test_Mixed_Precision(X, length);
+
+  /* Free vectors */
+  N_VDestroy(X);
+  N_VDestroy(Y);
+  N_VDestroy(Z);
+  N_VDestroy(U);
+  N_VDestroy(V);
+
+  /* Print result */
+  if (fails) { printf("FAIL: NVector module failed %i tests \n\n", fails); }
+  else { printf("SUCCESS: NVector module passed all tests \n\n"); }
+
+  Test_Finalize();
+  return (fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Check that the conversion functions round the values to float and that
+ * the reductions accumulate the float values in double precision
+ * --------------------------------------------------------------------*/
+static int Test_Mixed_Precision(N_Vector X, sunindextype length)
+{
+  int failure = 0;
+  sunindextype i;
+  sunrealtype *in, *out;
+  sunrealtype third, ans;
+
+  in  = (sunrealtype*)malloc(length * sizeof(sunrealtype));
+  out = (sunrealtype*)malloc(length * sizeof(sunrealtype));
+  if (in == NULL || out == NULL)
+  {
+    free(in);
+    free(out);
+    printf(">>> FAILED test -- malloc failed \n");
+    return (1);
+  }
+
+  third = ONE / SUN_RCONST(3.0);
+  for (i = 0; i < length; i++) { in[i] = third; }
+
+  /* a round trip rounds the values to float */
+  if (N_VCopyFromArray_Mixed(in, X) || N_VCopyToArray_Mixed(X, out))
+  {
+    failure = 1;
+  }
+  for (i = 0; i < length && !failure; i++)
+  {
+    if (out[i] != (sunrealtype)((float)third)) { failure = 1; }
+  }
+
+  if (failure) { printf(">>> FAILED test -- N_VCopyFromArray_Mixed \n"); }
+  else { printf("PASSED test -- N_VCopyFromArray_Mixed \n"); }
+
+  /* the sum of the squares of the float values is accumulated in double
+     precision, a float accumulation is off by many float roundoffs */
+  if (!failure)
+  {
+    ans = N_VDotProd(X, X);
+    if (SUNRCompareTol(ans,
+                       (sunrealtype)length * (sunrealtype)((float)third) *
+                         (sunrealtype)((float)third),
+                       SUN_RCONST(1.0e6) * SUN_UNIT_ROUNDOFF))
+    {
+      printf(">>> FAILED test -- N_VDotProd_Mixed accumulation \n");
+      failure = 1;
+    }
+    else { printf("PASSED test -- N_VDotProd_Mixed accumulation \n"); }
+  }
+
+  free(in);
+  free(out);
+
+  return failure;
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation specific utility functions for vector tests
+ * --------------------------------------------------------------------*/
+int check_ans(sunrealtype ans, N_Vector X, sunindextype local_length)
+{
+  int failure = 0;
+  sunindextype i;
+  float* Xdata;
+
+  Xdata = N_VGetFloatArrayPointer_Mixed(X);
+
+  /* check vector data, the expected value is rounded to float */
+  for (i = 0; i < local_length; i++)
+  {
+    failure += SUNRCompareTol((sunrealtype)Xdata[i], ans,
+                              SUN_RCONST(10.0) * FLT_EPSILON);
+  }
+
+  return (failure > ZERO) ? (1) : (0);
+}
+
+sunbooleantype has_data(N_Vector X)
+{
+  /* check if data array is non-null */
+  return (N_VGetFloatArrayPointer_Mixed(X) == NULL) ? SUNFALSE : SUNTRUE;
+}
+
+void set_element(N_Vector X, sunindextype i, sunrealtype val)
+{
+  /* set i-th element of data array */
+  set_element_range(X, i, i, val);
+}
+
+void set_element_range(N_Vector X, sunindextype is, sunindextype ie,
+                       sunrealtype val)
+{
+  sunindextype i;
+
+  /* set elements [is,ie] of the data array */
+  float* xd = N_VGetFloatArrayPointer_Mixed(X);
+  for (i = is; i <= ie; i++) { xd[i] = (float)val; }
+}
+
+sunrealtype get_element(N_Vector X, sunindextype i)
+{
+  /* get i-th element of data array */
+  return (sunrealtype)NV_Ith_MX(X, i);
+}
+
+double max_time(N_Vector X, double time)
+{
+  /* not running in parallel, just return input time */
+  return (time);
+}
+
+void sync_device(N_Vector x)
+{
+  /* not running on GPU, just return */
+  return;
+}
@@ -24,6 +24,10 @@
 
 #include "test_nvector.h"
 
+/* Parallel vector specific tests */
+static int Test_Reproducible(N_Vector X, N_Vector Y, N_Vector Z,
+                             sunindextype local_length, int myid, int nprocs);
+
 /* ----------------------------------------------------------------------
  * Main NVector Testing Routine
  * --------------------------------------------------------------------*/
@@ -251,6 +255,30 @@ int main(int argc, char* argv[])
   fails += Test_N_VBufPack(X, local_length, myid);
   fails += Test_N_VBufUnpack(X, local_length, myid);
 
+#if !defined(SUNDIALS_EXTENDED_PRECISION)
+  /* reproducible reductions */
+  if (myid == 0) { printf("\nTesting reproducible reductions:\n\n"); }
+
+  N_VSetReproducibleReductions_Parallel(X, SUNTRUE);
+  N_VSetReproducibleReductions_Parallel(V, SUNTRUE);
+  fails += Test_N_VDotProd(X, Y, local_length, myid);
+  fails += Test_N_VWrmsNorm(X, Y, local_length, myid);
+  fails += Test_N_VWrmsNormMask(X, Y, Z, local_length, myid);
+  fails += Test_N_VWL2Norm(X, Y, local_length, myid);
+  fails += Test_N_VL1Norm(X, local_length, myid);
+  fails += Test_N_VDotProdLocal(X, Y, local_length, myid);
+  fails += Test_N_VL1NormLocal(X, local_length, myid);
+  fails += Test_N_VWSqrSumLocal(X, Y, local_length, myid);
+  fails += Test_N_VWSqrSumMaskLocal(X, Y, Z, local_length, myid);
+  fails += Test_N_VDotProdMulti(V, local_length, myid);
+  fails += Test_N_VWrmsNormVectorArray(V, local_length, myid);
+  fails += Test_N_VWrmsNormMaskVectorArray(V, local_length, myid);
+  fails += Test_N_VDotProdMultiLocal(V, local_length, myid);
+  N_VSetReproducibleReductions_Parallel(X, SUNFALSE);
+
+  fails += Test_Reproducible(X, Y, Z, local_length, myid, nprocs);
+#endif
+
   /* Free vectors */
   N_VDestroy(W);
   N_VDestroy(X);
@@ -277,6 +305,96 @@ int main(int argc, char* argv[])
   return (globfails);
 }
 
+/* ----------------------------------------------------------------------
+ * Test that the reproducible reductions do not depend on the number of
+ * MPI processes by comparing them with a vector holding all of the
+ * global data on a single process
+ * --------------------------------------------------------------------*/
+static int Test_Reproducible(N_Vector X, N_Vector Y, N_Vector Z,
+                             sunindextype local_length, int myid, int nprocs)
+{
+  int fails = 0, k;
+  sunindextype i, ig, global_length;
+  sunrealtype *xd, *yd, *zd, *sd[3];
+  sunrealtype val[5], ref[5];
+  N_Vector S[3];
+
+  global_length = nprocs * local_length;
+
+  /* the full data on every process */
+  for (k = 0; k < 3; k++)
+  {
+    S[k]  = N_VNew_Parallel(MPI_COMM_SELF, global_length, global_length,
+                            X->sunctx);
+    sd[k] = N_VGetArrayPointer(S[k]);
+  }
+  for (ig = 0; ig < global_length; ig++)
+  {
+    sd[0][ig] = SUNRpowerI(SUN_RCONST(10.0), (int)(ig % 13) - 6) *
+                (sunrealtype)((ig * 7919) % 1001 - 500) / SUN_RCONST(500.0);
+    sd[1][ig] = ONE + SUN_RCONST(1.0e-3) * (sunrealtype)(ig % 7);
+    sd[2][ig] = (ig % 3) ? ONE : ZERO;
+  }
+
+  /* this process's part of the data */
+  xd = N_VGetArrayPointer(X);
+  yd = N_VGetArrayPointer(Y);
+  zd = N_VGetArrayPointer(Z);
+  for (i = 0; i < local_length; i++)
+  {
+    ig    = myid * local_length + i;
+    xd[i] = sd[0][ig];
+    yd[i] = sd[1][ig];
+    zd[i] = sd[2][ig];
+  }
+
+  N_VSetReproducibleReductions_Parallel(X, SUNTRUE);
+  N_VSetReproducibleReductions_Parallel(S[0], SUNTRUE);
+
+  val[0] = N_VDotProd(X, Y);
+  val[1] = N_VWrmsNorm(X, Y);
+  val[2] = N_VWrmsNormMask(X, Y, Z);
+  val[3] = N_VL1Norm(X);
+  val[4] = N_VWL2Norm(X, Y);
+
+  ref[0] = N_VDotProd(S[0], S[1]);
+  ref[1] = N_VWrmsNorm(S[0], S[1]);
+  ref[2] = N_VWrmsNormMask(S[0], S[1], S[2]);
+  ref[3] = N_VL1Norm(S[0]);
+  ref[4] = N_VWL2Norm(S[0], S[1]);
+
+  for (k = 0; k < 5; k++)
+  {
+    if (val[k] != ref[k])
+    {
+      printf(">>> FAILED test -- reproducible reduction %d with %d processes, "
+             "Proc %d\n",
+             k, nprocs, myid);
+      fails++;
+    }
+  }
+
+  /* the result agrees with the standard reduction */
+  N_VSetReproducibleReductions_Parallel(X, SUNFALSE);
+  if (SUNRCompareTol(val[0], N_VDotProd(X, Y), 1000 * SUN_UNIT_ROUNDOFF) ||
+      SUNRCompareTol(val[3], N_VL1Norm(X), 1000 * SUN_UNIT_ROUNDOFF))
+  {
+    printf(">>> FAILED test -- reproducible reductions accuracy, Proc %d\n",
+           myid);
+    fails++;
+  }
+
+  for (k = 0; k < 3; k++) { N_VDestroy(S[k]); }
+
+  if (fails == 0 && myid == 0)
+  {
+    printf("PASSED test -- reproducible reductions with %d processes\n",
+           nprocs);
+  }
+
+  return (fails);
+}
+
 /* ----------------------------------------------------------------------
  * Implementation specific utility functions for vector tests
  * --------------------------------------------------------------------*/
@@ -23,6 +23,10 @@
 
 #include "test_nvector.h"
 
+/* Pthreads vector specific tests */
+static int Test_Reproducible(N_Vector X, N_Vector Y, N_Vector Z,
+                             sunindextype local_length, int nthreads);
+
 /* ----------------------------------------------------------------------
  * Main NVector Testing Routine
  * --------------------------------------------------------------------*/
@@ -32,6 +36,7 @@ int main(int argc, char* argv[])
   int retval;                /* function return value     */
   sunindextype length;       /* vector length             */
   N_Vector U, V, W, X, Y, Z; /* test vectors              */
+  N_Vector S, T;             /* worker pool test vectors  */
   int print_timing;          /* turn timing on/off        */
   int nthreads;              /* number of POSIX threads   */
 
@@ -205,6 +210,54 @@ int main(int argc, char* argv[])
   fails += Test_N_VScaleAddMultiVectorArray(V, length, 0);
   fails += Test_N_VLinearCombinationVectorArray(V, length, 0);
 
+  /* Worker pool option tests */
+  printf("\nTesting worker pool options:\n\n");
+
+  /* create vector that spins before sleeping and computes serially, clones
+     share the pool and inherit the serial length */
+  S = N_VNew_Pthreads(length, nthreads, sunctx);
+  if (S == NULL)
+  {
+    N_VDestroy(W);
+    N_VDestroy(X);
+    N_VDestroy(Y);
+    N_VDestroy(Z);
+    N_VDestroy(U);
+    N_VDestroy(V);
+    printf("FAIL: Unable to create a new vector \n\n");
+    Test_Abort(1);
+  }
+
+  retval = N_VSetSpinCount_Pthreads(S, 1000);
+  retval += N_VSetSerialLength_Pthreads(S, length + 1);
+  T = N_VClone(S);
+  if (T == NULL || retval != 0)
+  {
+    N_VDestroy(W);
+    N_VDestroy(X);
+    N_VDestroy(Y);
+    N_VDestroy(Z);
+    N_VDestroy(U);
+    N_VDestroy(V);
+    N_VDestroy(S);
+    printf("FAIL: Unable to set worker pool options \n\n");
+    Test_Abort(1);
+  }
+
+  fails += Test_N_VLinearSum(S, T, Z, length, 0);
+  fails += Test_N_VDotProd(S, T, length, 0);
+
+  /* run in parallel with the spinning pool */
+  retval = N_VSetSerialLength_Pthreads(T, 0);
+  if (retval != 0)
+  {
+    printf("FAIL: Unable to set worker pool options \n\n");
+    fails++;
+  }
+
+  fails += Test_N_VWrmsNorm(T, S, length, 0);
+  fails += Test_N_VMinQuotient(T, S, length, 0);
+
   /* local reduction operations */
   printf("\nTesting local reduction operations:\n\n");
 
@@ -229,6 +282,26 @@ int main(int argc, char* argv[])
   fails += Test_N_VBufPack(X, length, 0);
   fails += Test_N_VBufUnpack(X, length, 0);
 
+#if !defined(SUNDIALS_EXTENDED_PRECISION)
+  printf("\nTesting reproducible reductions:\n\n");
+
+  N_VSetReproducibleReductions_Pthreads(X, SUNTRUE);
+  N_VSetReproducibleReductions_Pthreads(V, SUNTRUE);
+  fails += Test_N_VDotProd(X, Y, length, 0);
+  fails += Test_N_VWrmsNorm(X, Y, length, 0);
+  fails += Test_N_VWrmsNormMask(X, Y, Z, length, 0);
+  fails += Test_N_VWL2Norm(X, Y, length, 0);
+  fails += Test_N_VL1Norm(X, length, 0);
+  fails += Test_N_VWSqrSumLocal(X, Y, length, 0);
+  fails += Test_N_VWSqrSumMaskLocal(X, Y, Z, length, 0);
+  fails += Test_N_VDotProdMulti(V, length, 0);
+  fails += Test_N_VWrmsNormVectorArray(V, length, 0);
+  fails += Test_N_VWrmsNormMaskVectorArray(V, length, 0);
+  N_VSetReproducibleReductions_Pthreads(X, SUNFALSE);
+
+  fails += Test_Reproducible(X, Y, Z, length, nthreads);
+#endif
+
   /* Free vectors */
   N_VDestroy(W);
   N_VDestroy(X);
@@ -236,6 +309,8 @@ int main(int argc, char* argv[])
   N_VDestroy(Z);
   N_VDestroy(U);
   N_VDestroy(V);
+  N_VDestroy(S);
+  N_VDestroy(T);
 
   /* Print result */
   if (fails) { printf("FAIL: NVector module failed %i tests \n\n", fails); }
@@ -245,6 +320,110 @@ int main(int argc, char* argv[])
   return (fails);
 }
 
+/* ----------------------------------------------------------------------
+ * Test that the reproducible reductions do not depend on the number of
+ * threads or on the order of the elements
+ * --------------------------------------------------------------------*/
+static int Test_Reproducible(N_Vector X, N_Vector Y, N_Vector Z,
+                             sunindextype local_length, int nthreads)
+{
+  int fails = 0, t, k;
+  sunindextype i;
+  sunrealtype *xd, *yd, *zd, *rd[3];
+  sunrealtype ref[5] = {ZERO, ZERO, ZERO, ZERO, ZERO}, val[5];
+  N_Vector R[3], A, B, C;
+
+  /* terms of widely varying magnitude and sign with heavy cancellation */
+  xd = N_VGetArrayPointer(X);
+  yd = N_VGetArrayPointer(Y);
+  zd = N_VGetArrayPointer(Z);
+  for (i = 0; i < local_length; i++)
+  {
+    xd[i] = SUNRpowerI(SUN_RCONST(10.0), (int)(i % 13) - 6) *
+            (sunrealtype)((i * 7919) % 1001 - 500) / SUN_RCONST(500.0);
+    yd[i] = ONE + SUN_RCONST(1.0e-3) * (sunrealtype)(i % 7);
+    zd[i] = (i % 3) ? ONE : ZERO;
+  }
+
+  /* the same values in reverse order */
+  for (k = 0; k < 3; k++)
+  {
+    R[k]  = N_VClone(X);
+    rd[k] = N_VGetArrayPointer(R[k]);
+  }
+  for (i = 0; i < local_length; i++)
+  {
+    rd[0][i] = xd[local_length - 1 - i];
+    rd[1][i] = yd[local_length - 1 - i];
+    rd[2][i] = zd[local_length - 1 - i];
+  }
+  N_VSetReproducibleReductions_Pthreads(R[0], SUNTRUE);
+
+  for (t = 1; t <= nthreads + 2; t++)
+  {
+    /* vectors sharing the data of X, Y, and Z using t threads */
+    A = N_VMake_Pthreads(local_length, t, xd, sunctx);
+    B = N_VMake_Pthreads(local_length, t, yd, sunctx);
+    C = N_VMake_Pthreads(local_length, t, zd, sunctx);
+    N_VSetReproducibleReductions_Pthreads(A, SUNTRUE);
+
+    val[0] = N_VDotProd(A, B);
+    val[1] = N_VWrmsNorm(A, B);
+    val[2] = N_VWrmsNormMask(A, B, C);
+    val[3] = N_VL1Norm(A);
+    val[4] = N_VWL2Norm(A, B);
+    if (t == 1)
+    {
+      for (k = 0; k < 5; k++) { ref[k] = val[k]; }
+    }
+    for (k = 0; k < 5; k++)
+    {
+      if (val[k] != ref[k])
+      {
+        printf(">>> FAILED test -- reproducible reduction %d with %d threads\n",
+               k, t);
+        fails++;
+      }
+    }
+
+    N_VDestroy(A);
+    N_VDestroy(B);
+    N_VDestroy(C);
+  }
+
+  val[0] = N_VDotProd(R[0], R[1]);
+  val[1] = N_VWrmsNorm(R[0], R[1]);
+  val[2] = N_VWrmsNormMask(R[0], R[1], R[2]);
+  val[3] = N_VL1Norm(R[0]);
+  val[4] = N_VWL2Norm(R[0], R[1]);
+  for (k = 0; k < 5; k++)
+  {
+    if (val[k] != ref[k])
+    {
+      printf(">>> FAILED test -- reproducible reduction %d reversed\n", k);
+      fails++;
+    }
+  }
+
+  /* the result agrees with the standard reduction */
+  if (SUNRCompareTol(ref[0], N_VDotProd(X, Y), 1000 * SUN_UNIT_ROUNDOFF) ||
+      SUNRCompareTol(ref[3], N_VL1Norm(X), 1000 * SUN_UNIT_ROUNDOFF))
+  {
+    printf(">>> FAILED test -- reproducible reductions accuracy\n");
+    fails++;
+  }
+
+  for (k = 0; k < 3; k++) { N_VDestroy(R[k]); }
+
+  if (fails == 0)
+  {
+    printf("PASSED test -- reproducible reductions with 1 to %d threads\n",
+           nthreads + 2);
+  }
+
+  return (fails);
+}
+
 /* ----------------------------------------------------------------------
  * Implementation specific utility functions for vector tests
  * --------------------------------------------------------------------*/
@@ -55,8 +55,17 @@ int main(int argc, char* argv[])
   print_timing = atoi(argv[2]);
   SetTiming(print_timing, 0);
 
+  /* optionally select the SIMD instruction set */
+  if (argc > 3 && N_VSetSIMDLevel_Serial((N_VSIMDLevel)atoi(argv[3])))
+  {
+    printf("SIMD level %s not supported, skipping test \n", argv[3]);
+    Test_Finalize();
+    return (0);
+  }
+
   printf("Testing serial N_Vector \n");
   printf("Vector length %ld \n", (long int)length);
+  printf("SIMD level %d \n", (int)N_VGetSIMDLevel_Serial());
 
   /* Create new vectors */
   W = N_VNewEmpty_Serial(length, sunctx);
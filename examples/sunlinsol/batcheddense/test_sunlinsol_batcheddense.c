@@ -0,0 +1,418 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNLinSol BatchedDense
+ * module implementation.
+ * -----------------------------------------------------------------*/
+
+#include <nvector/nvector_serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_dense.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+#include <sunlinsol/sunlinsol_batcheddense.h>
+#include <sunmatrix/sunmatrix_blocksparse.h>
+
+#include "test_sunlinsol.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* private functions */
+static SUNMatrix BlockDiagonalMatrix(sunindextype nblocks, sunindextype bs,
+                                     SUNContext sunctx);
+static int Test_DenseBlocks(SUNMatrix A, N_Vector x, N_Vector b);
+static int Test_Threads(SUNLinearSolver LS, SUNMatrix A, N_Vector x,
+                        N_Vector b);
+static int Test_Singular(SUNLinearSolver LS, SUNMatrix A);
+static int Test_Pattern(sunindextype nblocks, sunindextype bs, N_Vector y,
+                        SUNContext sunctx);
+
+/* ----------------------------------------------------------------------
+ * SUNLinSol_BatchedDense Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  int fails = 0;               /* counter for test failures */
+  sunindextype nblocks, bs, j; /* number and size of blocks */
+  SUNLinearSolver LS;          /* solver object             */
+  SUNMatrix A, B;              /* test matrices             */
+  N_Vector x, y, b;            /* test vectors              */
+  int print_timing;
+  sunrealtype* xdata;
+  SUNContext sunctx;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx))
+  {
+    printf("ERROR: SUNContext_Create failed\n");
+    return (-1);
+  }
+
+  /* check input and set matrix dimensions */
+  if (argc < 4)
+  {
+    printf("ERROR: THREE (3) Inputs required: number of blocks, block size, "
+           "print timing \n");
+    return (-1);
+  }
+
+  nblocks = (sunindextype)atol(argv[1]);
+  if (nblocks <= 0)
+  {
+    printf("ERROR: number of blocks must be a positive integer \n");
+    return (-1);
+  }
+
+  bs = (sunindextype)atol(argv[2]);
+  if (bs <= 0)
+  {
+    printf("ERROR: block size must be a positive integer \n");
+    return (-1);
+  }
+
+  print_timing = atoi(argv[3]);
+  SetTiming(print_timing);
+
+  printf("\nBatched dense linear solver test: %ld blocks of size %ld\n\n",
+         (long int)nblocks, (long int)bs);
+
+  /* Create matrices and vectors */
+  A = BlockDiagonalMatrix(nblocks, bs, sunctx);
+  B = SUNMatClone(A);
+  x = N_VNew_Serial(nblocks * bs, sunctx);
+  y = N_VNew_Serial(nblocks * bs, sunctx);
+  b = N_VNew_Serial(nblocks * bs, sunctx);
+
+  /* Fill x vector with uniform random data in [0,1] */
+  xdata = N_VGetArrayPointer(x);
+  for (j = 0; j < nblocks * bs; j++)
+  {
+    xdata[j] = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+  }
+
+  /* copy A and x into B and y */
+  SUNMatCopy(A, B);
+  N_VScale(ONE, x, y);
+
+  /* create right-hand side vector for linear solve */
+  fails = SUNMatMatvec(A, x, b);
+  if (fails)
+  {
+    printf("FAIL: SUNLinSol SUNMatMatvec failure\n");
+
+    /* Free matrices and vectors */
+    SUNMatDestroy(A);
+    SUNMatDestroy(B);
+    N_VDestroy(x);
+    N_VDestroy(y);
+    N_VDestroy(b);
+
+    return (1);
+  }
+
+  /* Create batched dense linear solver */
+  LS = SUNLinSol_BatchedDense(x, A, sunctx);
+
+  /* Run Tests */
+  fails += Test_SUNLinSolInitialize(LS, 0);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 100 * SUN_UNIT_ROUNDOFF, SUNTRUE, 0);
+
+  fails += Test_SUNLinSolGetType(LS, SUNLINEARSOLVER_DIRECT, 0);
+  fails += Test_SUNLinSolGetID(LS, SUNLINEARSOLVER_BATCHEDDENSE, 0);
+  fails += Test_SUNLinSolLastFlag(LS, 0);
+  fails += Test_SUNLinSolSpace(LS, 0);
+
+  /* Compare with the dense factorization of each block */
+  fails += Test_DenseBlocks(B, y, b);
+
+  /* Repeat the solve with several threads */
+  fails += Test_Threads(LS, B, y, b);
+
+  /* A zero column in a block is reported with its row */
+  fails += Test_Singular(LS, B);
+
+  /* A matrix with off-diagonal blocks is rejected */
+  if (nblocks > 1) { fails += Test_Pattern(nblocks, bs, y, sunctx); }
+
+  /* Print result */
+  if (fails) { printf("FAIL: SUNLinSol module failed %i tests \n \n", fails); }
+  else { printf("SUCCESS: SUNLinSol module passed all tests \n \n"); }
+
+  /* Free solver, matrix and vectors */
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(B);
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(b);
+  SUNContext_Free(&sunctx);
+
+  return (fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Block diagonal matrix whose blocks are random, in [0,1/bs], plus an
+ * anti-identity to ensure the solver needs to swap rows
+ * --------------------------------------------------------------------*/
+static SUNMatrix BlockDiagonalMatrix(sunindextype nblocks, sunindextype bs,
+                                     SUNContext sunctx)
+{
+  sunindextype i, j, k;
+  sunindextype *rowptrs, *colind;
+  SUNMatrix A;
+
+  A       = SUNBlockSparseMatrix(nblocks, nblocks, bs, nblocks, sunctx);
+  rowptrs = SUNBlockSparseMatrix_RowPointers(A);
+  colind  = SUNBlockSparseMatrix_ColumnIndices(A);
+
+  for (k = 0; k < nblocks; k++)
+  {
+    rowptrs[k] = k;
+    colind[k]  = k;
+    for (j = 0; j < bs; j++)
+    {
+      for (i = 0; i < bs; i++)
+      {
+        SM_BLOCK_ELEMENT_BS(A, k, i, j) = (sunrealtype)rand() /
+                                          (sunrealtype)RAND_MAX / bs;
+      }
+      SM_BLOCK_ELEMENT_BS(A, k, bs - 1 - j, j) += ONE;
+    }
+  }
+  rowptrs[nblocks] = nblocks;
+
+  return (A);
+}
+
+/* ----------------------------------------------------------------------
+ * Solve each block with SUNDlsMat_denseGETRF and SUNDlsMat_denseGETRS
+ * and compare with the batched solution
+ * --------------------------------------------------------------------*/
+static int Test_DenseBlocks(SUNMatrix A, N_Vector x, N_Vector b)
+{
+  int failure = 0;
+  sunindextype i, j, k, bs, nblocks;
+  sunindextype* p;
+  sunrealtype **a, *xdata, *bdata;
+  N_Vector xb;
+  SUNLinearSolver LS;
+  SUNMatrix C;
+
+  bs      = SUNBlockSparseMatrix_BlockSize(A);
+  nblocks = SUNBlockSparseMatrix_BlockRows(A);
+
+  /* batched solution */
+  C  = SUNMatClone(A);
+  xb = N_VClone(x);
+  SUNMatCopy(A, C);
+  LS = SUNLinSol_BatchedDense(x, C, A->sunctx);
+  failure += SUNLinSolSetup(LS, C);
+  failure += SUNLinSolSolve(LS, C, xb, b, ZERO);
+
+  /* dense solutions, block by block */
+  p     = (sunindextype*)malloc(bs * sizeof(sunindextype));
+  a     = SUNDlsMat_newDenseMat(bs, bs);
+  xdata = N_VGetArrayPointer(xb);
+  bdata = (sunrealtype*)malloc(bs * sizeof(sunrealtype));
+
+  for (k = 0; k < nblocks && !failure; k++)
+  {
+    for (j = 0; j < bs; j++)
+    {
+      for (i = 0; i < bs; i++) { a[j][i] = SM_BLOCK_ELEMENT_BS(A, k, i, j); }
+    }
+    for (i = 0; i < bs; i++) { bdata[i] = N_VGetArrayPointer(b)[k * bs + i]; }
+
+    if (SUNDlsMat_denseGETRF(a, bs, bs, p)) { failure = 1; }
+    SUNDlsMat_denseGETRS(a, bs, p, bdata);
+
+    for (i = 0; i < bs; i++)
+    {
+      if (SUNRCompareTol(xdata[k * bs + i], bdata[i], 10 * SUN_UNIT_ROUNDOFF))
+      {
+        failure = 1;
+      }
+    }
+  }
+
+  if (failure) { printf(">>> FAILED test -- batched vs dense blocks\n"); }
+  else { printf("    PASSED test -- batched vs dense blocks\n"); }
+
+  SUNDlsMat_destroyMat(a);
+  free(p);
+  free(bdata);
+  N_VDestroy(xb);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(C);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Setup and solve with three threads give the same solution as with one
+ * --------------------------------------------------------------------*/
+static int Test_Threads(SUNLinearSolver LS, SUNMatrix A, N_Vector x, N_Vector b)
+{
+  int failure = 0;
+  sunindextype i, n;
+  sunrealtype *x1, *x3;
+  N_Vector y1, y3;
+  SUNMatrix C;
+
+  C  = SUNMatClone(A);
+  y1 = N_VClone(x);
+  y3 = N_VClone(x);
+  n  = N_VGetLength(x);
+
+  failure += SUNLinSol_BatchedDense_SetNumThreads(LS, 1);
+  SUNMatCopy(A, C);
+  failure += SUNLinSolSetup(LS, C);
+  failure += SUNLinSolSolve(LS, C, y1, b, ZERO);
+
+  failure += SUNLinSol_BatchedDense_SetNumThreads(LS, 3);
+  SUNMatCopy(A, C);
+  failure += SUNLinSolSetup(LS, C);
+  failure += SUNLinSolSolve(LS, C, y3, b, ZERO);
+
+  x1 = N_VGetArrayPointer(y1);
+  x3 = N_VGetArrayPointer(y3);
+  for (i = 0; i < n; i++)
+  {
+    if (x1[i] != x3[i]) { failure = 1; }
+  }
+  failure += check_vector(x, y3, 100 * SUN_UNIT_ROUNDOFF);
+
+  if (failure) { printf(">>> FAILED test -- threaded setup and solve\n"); }
+  else { printf("    PASSED test -- threaded setup and solve\n"); }
+
+  N_VDestroy(y1);
+  N_VDestroy(y3);
+  SUNMatDestroy(C);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Zero the first column of the middle block: setup fails and the last
+ * flag is the (one-based) row of the zero pivot
+ * --------------------------------------------------------------------*/
+static int Test_Singular(SUNLinearSolver LS, SUNMatrix A)
+{
+  int failure = 0;
+  sunindextype i, k, bs, flag;
+  SUNMatrix C;
+
+  bs = SUNBlockSparseMatrix_BlockSize(A);
+  k  = SUNBlockSparseMatrix_BlockRows(A) / 2;
+
+  C = SUNMatClone(A);
+  SUNMatCopy(A, C);
+  for (i = 0; i < bs; i++) { SM_BLOCK_ELEMENT_BS(C, k, i, 0) = ZERO; }
+
+  if (SUNLinSolSetup(LS, C) != SUNLS_LUFACT_FAIL) { failure = 1; }
+  flag = SUNLinSolLastFlag(LS);
+  if (flag != k * bs + 1) { failure = 1; }
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- singular block, last flag %ld (expected %ld)\n",
+           (long int)flag, (long int)(k * bs + 1));
+  }
+  else { printf("    PASSED test -- singular block\n"); }
+
+  SUNMatDestroy(C);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * A block above the diagonal makes setup fail
+ * --------------------------------------------------------------------*/
+static int Test_Pattern(sunindextype nblocks, sunindextype bs, N_Vector y,
+                        SUNContext sunctx)
+{
+  int failure = 0;
+  sunindextype k;
+  sunindextype *rowptrs, *colind;
+  SUNMatrix C;
+  SUNLinearSolver LS;
+
+  C       = SUNBlockSparseMatrix(nblocks, nblocks, bs, nblocks + 1, sunctx);
+  rowptrs = SUNBlockSparseMatrix_RowPointers(C);
+  colind  = SUNBlockSparseMatrix_ColumnIndices(C);
+  SUNMatZero(C);
+
+  /* block row 0 holds blocks (0,0) and (0,1) */
+  rowptrs[0] = 0;
+  colind[0]  = 0;
+  colind[1]  = 1;
+  for (k = 1; k < nblocks; k++)
+  {
+    rowptrs[k]    = k + 1;
+    colind[k + 1] = k;
+  }
+  rowptrs[nblocks] = nblocks + 1;
+
+  LS = SUNLinSol_BatchedDense(y, C, sunctx);
+  if (SUNLinSolSetup(LS, C) != SUN_ERR_ARG_INCOMPATIBLE) { failure = 1; }
+
+  if (failure) { printf(">>> FAILED test -- off-diagonal block\n"); }
+  else { printf("    PASSED test -- off-diagonal block\n"); }
+
+  SUNLinSolFree(LS);
+  SUNMatDestroy(C);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation-specific 'check' routines
+ * --------------------------------------------------------------------*/
+int check_vector(N_Vector X, N_Vector Y, sunrealtype tol)
+{
+  int failure = 0;
+  sunindextype i, local_length;
+  sunrealtype *Xdata, *Ydata, maxerr;
+
+  Xdata        = N_VGetArrayPointer(X);
+  Ydata        = N_VGetArrayPointer(Y);
+  local_length = N_VGetLength_Serial(X);
+
+  /* check vector data */
+  for (i = 0; i < local_length; i++)
+  {
+    failure += SUNRCompareTol(Xdata[i], Ydata[i], tol);
+  }
+
+  if (failure > ZERO)
+  {
+    maxerr = ZERO;
+    for (i = 0; i < local_length; i++)
+    {
+      maxerr = SUNMAX(SUNRabs(Xdata[i] - Ydata[i]), maxerr);
+    }
+    printf("check err failure: maxerr = %" GSYM " (tol = %" GSYM ")\n", maxerr,
+           tol);
+    return (1);
+  }
+  else { return (0); }
+}
+
+void sync_device(void) {}
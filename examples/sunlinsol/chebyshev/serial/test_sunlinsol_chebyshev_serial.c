@@ -0,0 +1,475 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNLinSol Chebyshev
+ * module implementation.
+ * -----------------------------------------------------------------
+ */
+
+#include <nvector/nvector_serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_iterative.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+#include <sunlinsol/sunlinsol_chebyshev.h>
+#include <sunlinsol/sunlinsol_pcg.h>
+#include <sunlinsol/sunlinsol_spgmr.h>
+
+#include "test_sunlinsol.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* constants */
+#define TWO   SUN_RCONST(2.0)
+#define FIVE  SUN_RCONST(5.0)
+#define SEVEN SUN_RCONST(7.0)
+
+/* degree of the polynomial when the module is used as a solver */
+#define SOLVE_DEGREE 200
+
+/* user data structure */
+typedef struct
+{
+  sunindextype N; /* problem size */
+  N_Vector d;     /* matrix diagonal */
+} UserData;
+
+/* private functions */
+/*    matrix-vector product  */
+int ATimes(void* ProbData, N_Vector v, N_Vector z);
+/*    preconditioner setup */
+int PSetup(void* ProbData);
+/*    preconditioner solve */
+int PSolve(void* ProbData, N_Vector r, N_Vector z, sunrealtype tol, int lr);
+/*    checks function return values  */
+static int check_flag(void* flagvalue, const char* funcname, int opt);
+/*    uniform random number generator in [0,1] */
+static sunrealtype urand(void);
+
+/* global copy of the problem size (for check_vector routine) */
+sunindextype problem_size;
+
+/* ----------------------------------------------------------------------
+ * SUNLinSol_Chebyshev Linear Solver Testing Routine
+ *
+ * We run multiple tests to exercise this solver:
+ * 1. Chebyshev iteration as a solver for a tridiagonal system, with
+ *    bounds of the spectrum estimated by Arnoldi iterations (without
+ *    or with Jacobi preconditioning)
+ * 2. Chebyshev polynomial as the preconditioner of PCG
+ * 3. Chebyshev polynomial as the right preconditioner of SPGMR
+ *
+ * Note: We construct the SPD tridiagonal matrix A = tridiag(-1,5,-1),
+ *       whose eigenvalues lie in (3,7), a random solution xhat, and the
+ *       corresponding rhs vector b = A*xhat. The preconditioned Krylov
+ *       solves must take fewer iterations than the unpreconditioned ones.
+ * --------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  int fails    = 0;    /* counter for test failures */
+  int passfail = 0;    /* overall pass/fail flag    */
+  SUNLinearSolver LS;  /* linear solver object      */
+  SUNLinearSolver KLS; /* Krylov solver object      */
+  N_Vector xhat, x, b; /* test vectors              */
+  UserData ProbData;   /* problem data structure    */
+  int degree, pretype, print_timing, nli_none, nli_cheb;
+  sunindextype i;
+  sunrealtype* vecdata;
+  sunrealtype lmin, lmax, emax, gmrestol;
+  double tol;
+  SUNContext sunctx;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx))
+  {
+    printf("ERROR: SUNContext_Create failed\n");
+    return (-1);
+  }
+
+  /* check inputs: local problem size, degree, pretype, tol, timing flag */
+  if (argc < 6)
+  {
+    printf("ERROR: FIVE (5) Inputs required:\n");
+    printf("  Problem size should be >1\n");
+    printf("  Polynomial degree should be >0\n");
+    printf("  Preconditioning type should be 0 or 1\n");
+    printf("  Solver tolerance should be >0\n");
+    printf("  timing output flag should be 0 or 1 \n");
+    return 1;
+  }
+  ProbData.N   = (sunindextype)atol(argv[1]);
+  problem_size = ProbData.N;
+  if (ProbData.N <= 1)
+  {
+    printf("ERROR: Problem size must be an integer greater than 1\n");
+    return 1;
+  }
+  degree = atoi(argv[2]);
+  if (degree <= 0)
+  {
+    printf("ERROR: Polynomial degree must be a positive integer\n");
+    return 1;
+  }
+  pretype = atoi(argv[3]);
+  if ((pretype < 0) || (pretype > 1))
+  {
+    printf("ERROR: Preconditioning type must be either 0 or 1\n");
+    return 1;
+  }
+  tol = atof(argv[4]);
+  if (tol <= ZERO)
+  {
+    printf("ERROR: Solver tolerance must be a positive real number\n");
+    return 1;
+  }
+  print_timing = atoi(argv[5]);
+  SetTiming(print_timing);
+
+  printf("\nChebyshev linear solver test:\n");
+  printf("  Problem size = %ld\n", (long int)ProbData.N);
+  printf("  Polynomial degree = %i\n", degree);
+  printf("  Preconditioning type = %i\n", pretype);
+  printf("  Solver Tolerance = %g\n", tol);
+  printf("  timing output flag = %i\n\n", print_timing);
+
+  /* Create vectors */
+  x = N_VNew_Serial(ProbData.N, sunctx);
+  if (check_flag(x, "N_VNew_Serial", 0)) { return 1; }
+  xhat = N_VNew_Serial(ProbData.N, sunctx);
+  if (check_flag(xhat, "N_VNew_Serial", 0)) { return 1; }
+  b = N_VNew_Serial(ProbData.N, sunctx);
+  if (check_flag(b, "N_VNew_Serial", 0)) { return 1; }
+  ProbData.d = N_VNew_Serial(ProbData.N, sunctx);
+  if (check_flag(ProbData.d, "N_VNew_Serial", 0)) { return 1; }
+
+  /* Fill xhat vector with uniform random data in [1,2] */
+  vecdata = N_VGetArrayPointer(xhat);
+  for (i = 0; i < ProbData.N; i++) { vecdata[i] = ONE + urand(); }
+
+  /* Fill Jacobi vector with matrix diagonal */
+  N_VConst(FIVE, ProbData.d);
+
+  /* Fill x vector with the solution and b with the matrix-vector product */
+  N_VScale(ONE, xhat, x);
+  fails = ATimes(&ProbData, x, b);
+  if (check_flag(&fails, "ATimes", 1)) { return 1; }
+
+  /* lower bound on the largest eigenvalue of the (Jacobi preconditioned)
+     matrix from the Rayleigh quotient of the vector (1,-1,1,...) */
+  emax = SEVEN - TWO / (sunrealtype)ProbData.N;
+  if (pretype) { emax /= FIVE; }
+
+  /* Create Chebyshev linear solver */
+  LS = SUNLinSol_Chebyshev(x, pretype ? SUN_PREC_LEFT : SUN_PREC_NONE, degree,
+                           sunctx);
+  fails += Test_SUNLinSolGetType(LS, SUNLINEARSOLVER_ITERATIVE, 0);
+  fails += Test_SUNLinSolGetID(LS, SUNLINEARSOLVER_CHEBYSHEV, 0);
+  fails += Test_SUNLinSolSetATimes(LS, &ProbData, ATimes, 0);
+  fails += Test_SUNLinSolSetPreconditioner(LS, &ProbData, PSetup, PSolve, 0);
+  fails += Test_SUNLinSolSetZeroGuess(LS, 0);
+  fails += Test_SUNLinSolInitialize(LS, 0);
+  fails += Test_SUNLinSolSpace(LS, 0);
+  if (fails)
+  {
+    printf(
+      "FAIL: SUNLinSol_Chebyshev module failed %i initialization tests\n\n",
+      fails);
+    return 1;
+  }
+  else
+  {
+    printf(
+           "SUCCESS: SUNLinSol_Chebyshev module passed all initialization tests\n\n");
+  }
+
+  /*** Test 1: Chebyshev iteration as a solver ***/
+
+  /* Run tests with this setup */
+  fails += SUNLinSol_ChebyshevSetDegree(LS, SOLVE_DEGREE);
+  fails += Test_SUNLinSolSetup(LS, NULL, 0);
+  fails += Test_SUNLinSolSolve(LS, NULL, x, b, tol, SUNTRUE, 0);
+  fails += Test_SUNLinSolSolve(LS, NULL, x, b, tol, SUNFALSE, 0);
+  fails += Test_SUNLinSolLastFlag(LS, 0);
+  fails += Test_SUNLinSolNumIters(LS, 0);
+  fails += Test_SUNLinSolSpace(LS, 0);
+
+  /* The estimated interval must reach the largest eigenvalue */
+  fails += SUNLinSol_ChebyshevGetEigBounds(LS, &lmin, &lmax);
+  if ((lmin <= ZERO) || (lmin >= lmax) || (lmax < emax))
+  {
+    printf(">>> FAILED test -- SUNLinSol_ChebyshevGetEigBounds returned [%" GSYM
+           ", %" GSYM "] (largest eigenvalue >= %" GSYM ")\n",
+           lmin, lmax, emax);
+    fails++;
+  }
+  else { printf("    PASSED test -- SUNLinSol_ChebyshevGetEigBounds\n"); }
+
+  /* Print result */
+  if (fails)
+  {
+    printf("FAIL: SUNLinSol_Chebyshev module, problem 1, failed %i tests\n\n",
+           fails);
+    passfail += 1;
+  }
+  else
+  {
+    printf(
+           "SUCCESS: SUNLinSol_Chebyshev module, problem 1, passed all tests\n\n");
+  }
+
+  /*** Test 2: Chebyshev preconditioned PCG ***/
+
+  fails += SUNLinSol_ChebyshevSetDegree(LS, degree);
+
+  /* unpreconditioned solve for reference */
+  KLS = SUNLinSol_PCG(x, SUN_PREC_NONE, (int)ProbData.N, sunctx);
+  fails += Test_SUNLinSolSetATimes(KLS, &ProbData, ATimes, 0);
+  fails += Test_SUNLinSolSetPreconditioner(KLS, LS,
+                                           SUNLinSol_ChebyshevPrecSetup,
+                                           SUNLinSol_ChebyshevPrecSolve, 0);
+  fails += Test_SUNLinSolInitialize(KLS, 0);
+  fails += Test_SUNLinSolSetup(KLS, NULL, 0);
+  fails += Test_SUNLinSolSolve(KLS, NULL, x, b, tol, SUNTRUE, 0);
+  nli_none = SUNLinSolNumIters(KLS);
+
+  /* Chebyshev preconditioned solve */
+  fails += SUNLinSol_PCGSetPrecType(KLS, SUN_PREC_LEFT);
+  fails += Test_SUNLinSolSetup(KLS, NULL, 0);
+  fails += Test_SUNLinSolSolve(KLS, NULL, x, b, tol, SUNTRUE, 0);
+  fails += Test_SUNLinSolSolve(KLS, NULL, x, b, tol, SUNFALSE, 0);
+  nli_cheb = SUNLinSolNumIters(KLS);
+  if (nli_cheb >= nli_none)
+  {
+    printf(">>> FAILED test -- PCG iterations with Chebyshev preconditioner "
+           "%i, without %i\n",
+           nli_cheb, nli_none);
+    fails++;
+  }
+  else
+  {
+    printf("    PASSED test -- PCG iterations with Chebyshev preconditioner "
+           "%i, without %i\n",
+           nli_cheb, nli_none);
+  }
+  SUNLinSolFree(KLS);
+
+  /* Print result */
+  if (fails)
+  {
+    printf("FAIL: SUNLinSol_Chebyshev module, problem 2, failed %i tests\n\n",
+           fails);
+    passfail += 1;
+  }
+  else
+  {
+    printf(
+           "SUCCESS: SUNLinSol_Chebyshev module, problem 2, passed all tests\n\n");
+  }
+
+  /*** Test 3: Chebyshev right preconditioned SPGMR ***/
+
+  /* SPGMR tests the unscaled residual norm, so the tolerance is made relative
+     to ||b|| to stay above roundoff */
+  gmrestol = tol * SUNRsqrt(N_VDotProd(b, b));
+
+  /* unpreconditioned solve for reference */
+  KLS = SUNLinSol_SPGMR(x, SUN_PREC_NONE, (int)ProbData.N, sunctx);
+  fails += Test_SUNLinSolSetATimes(KLS, &ProbData, ATimes, 0);
+  fails += Test_SUNLinSolSetPreconditioner(KLS, LS,
+                                           SUNLinSol_ChebyshevPrecSetup,
+                                           SUNLinSol_ChebyshevPrecSolve, 0);
+  fails += Test_SUNLinSolInitialize(KLS, 0);
+  fails += Test_SUNLinSolSetup(KLS, NULL, 0);
+  fails += Test_SUNLinSolSolve(KLS, NULL, x, b, gmrestol, SUNTRUE, 0);
+  nli_none = SUNLinSolNumIters(KLS);
+
+  /* Chebyshev preconditioned solve */
+  fails += SUNLinSol_SPGMRSetPrecType(KLS, SUN_PREC_RIGHT);
+  fails += Test_SUNLinSolSetup(KLS, NULL, 0);
+  fails += Test_SUNLinSolSolve(KLS, NULL, x, b, gmrestol, SUNTRUE, 0);
+  fails += Test_SUNLinSolSolve(KLS, NULL, x, b, gmrestol, SUNFALSE, 0);
+  nli_cheb = SUNLinSolNumIters(KLS);
+  if (nli_cheb >= nli_none)
+  {
+    printf(">>> FAILED test -- SPGMR iterations with Chebyshev preconditioner "
+           "%i, without %i\n",
+           nli_cheb, nli_none);
+    fails++;
+  }
+  else
+  {
+    printf("    PASSED test -- SPGMR iterations with Chebyshev preconditioner "
+           "%i, without %i\n",
+           nli_cheb, nli_none);
+  }
+  SUNLinSolFree(KLS);
+
+  /* Print result */
+  if (fails)
+  {
+    printf("FAIL: SUNLinSol_Chebyshev module, problem 3, failed %i tests\n\n",
+           fails);
+    passfail += 1;
+  }
+  else
+  {
+    printf(
+           "SUCCESS: SUNLinSol_Chebyshev module, problem 3, passed all tests\n\n");
+  }
+
+  /* Free solver and vectors */
+  SUNLinSolFree(LS);
+  N_VDestroy(x);
+  N_VDestroy(xhat);
+  N_VDestroy(b);
+  N_VDestroy(ProbData.d);
+  SUNContext_Free(&sunctx);
+
+  return (passfail);
+}
+
+/* ----------------------------------------------------------------------
+ * Private helper functions
+ * --------------------------------------------------------------------*/
+
+/* matrix-vector product  */
+int ATimes(void* Data, N_Vector v_vec, N_Vector z_vec)
+{
+  /* local variables */
+  sunrealtype *v, *z;
+  sunindextype i, N;
+  UserData* ProbData;
+
+  /* access user data structure and vector data */
+  ProbData = (UserData*)Data;
+  v        = N_VGetArrayPointer(v_vec);
+  if (check_flag(v, "N_VGetArrayPointer", 0)) { return 1; }
+  z = N_VGetArrayPointer(z_vec);
+  if (check_flag(z, "N_VGetArrayPointer", 0)) { return 1; }
+  N = ProbData->N;
+
+  /* perform product at the left domain boundary (note: v is zero at the boundary)*/
+  z[0] = FIVE * v[0] - v[1];
+
+  /* iterate through interior of local domain, performing product */
+  for (i = 1; i < N - 1; i++) { z[i] = -v[i - 1] + FIVE * v[i] - v[i + 1]; }
+
+  /* perform product at the right domain boundary (note: v is zero at the boundary)*/
+  z[N - 1] = -v[N - 2] + FIVE * v[N - 1];
+
+  /* return with success */
+  return 0;
+}
+
+/* preconditioner setup -- nothing to do here since everything is already stored */
+int PSetup(void* Data) { return 0; }
+
+/* preconditioner solve */
+int PSolve(void* Data, N_Vector r_vec, N_Vector z_vec, sunrealtype tol, int lr)
+{
+  /* local variables */
+  sunrealtype *r, *z, *d;
+  sunindextype i;
+  UserData* ProbData;
+
+  /* access user data structure and vector data */
+  ProbData = (UserData*)Data;
+  r        = N_VGetArrayPointer(r_vec);
+  if (check_flag(r, "N_VGetArrayPointer", 0)) { return 1; }
+  z = N_VGetArrayPointer(z_vec);
+  if (check_flag(z, "N_VGetArrayPointer", 0)) { return 1; }
+  d = N_VGetArrayPointer(ProbData->d);
+  if (check_flag(d, "N_VGetArrayPointer", 0)) { return 1; }
+
+  /* iterate through domain, performing Jacobi solve */
+  for (i = 0; i < ProbData->N; i++) { z[i] = r[i] / d[i]; }
+
+  /* return with success */
+  return 0;
+}
+
+/* uniform random number generator */
+static sunrealtype urand(void)
+{
+  return ((sunrealtype)rand() / (sunrealtype)RAND_MAX);
+}
+
+/* Check function return value based on "opt" input:
+     0:  function allocates memory so check for NULL pointer
+     1:  function returns a flag so check for flag != 0 */
+static int check_flag(void* flagvalue, const char* funcname, int opt)
+{
+  int* errflag;
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  if (opt == 0 && flagvalue == NULL)
+  {
+    fprintf(stderr, "\nERROR: %s() failed - returned NULL pointer\n\n", funcname);
+    return 1;
+  }
+
+  /* Check if flag != 0 */
+  if (opt == 1)
+  {
+    errflag = (int*)flagvalue;
+    if (*errflag != 0)
+    {
+      fprintf(stderr, "\nERROR: %s() failed with flag = %d\n\n", funcname,
+              *errflag);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation-specific 'check' routines
+ * --------------------------------------------------------------------*/
+int check_vector(N_Vector X, N_Vector Y, sunrealtype tol)
+{
+  int failure = 0;
+  sunindextype i;
+  sunrealtype *Xdata, *Ydata, maxerr;
+
+  Xdata = N_VGetArrayPointer(X);
+  Ydata = N_VGetArrayPointer(Y);
+
+  /* check vector data */
+  for (i = 0; i < problem_size; i++)
+  {
+    failure += SUNRCompareTol(Xdata[i], Ydata[i], tol);
+  }
+
+  if (failure > ZERO)
+  {
+    maxerr = ZERO;
+    for (i = 0; i < problem_size; i++)
+    {
+      maxerr = SUNMAX(SUNRabs(Xdata[i] - Ydata[i]) / SUNRabs(Xdata[i]), maxerr);
+    }
+    printf("check err failure: maxerr = %" GSYM " (tol = %" GSYM ")\n", maxerr,
+           tol);
+    return (1);
+  }
+  else { return (0); }
+}
+
+void sync_device(void) {}
@@ -37,6 +37,13 @@
 #define FSYM "f"
 #endif
 
+/* private functions */
+static int Test_DenseGETRF(sunindextype rows, sunindextype cols,
+                           sunbooleantype singular, SUNContext sunctx);
+static sunindextype ReferenceGETRF(sunrealtype** a, sunindextype m,
+                                   sunindextype n, sunindextype* p);
+static int Test_DenseMixed(sunindextype n, int test, SUNContext sunctx);
+
 /* ----------------------------------------------------------------------
  * SUNLinSol_Dense Testing Routine
  * --------------------------------------------------------------------*/
@@ -162,6 +169,28 @@ int main(int argc, char* argv[])
   fails += Test_SUNLinSolLastFlag(LS, 0);
   fails += Test_SUNLinSolSpace(LS, 0);
 
+  /* Repeat the setup and solve with threaded trailing updates */
+  SUNMatCopy(B, A);
+  N_VScale(ONE, y, x);
+  fails += SUNLinSol_Dense_SetNumThreads(LS, 3);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 100 * SUN_UNIT_ROUNDOFF, SUNTRUE, 0);
+
+  /* Compare the blocked factorization with the unblocked algorithm */
+  fails += Test_DenseGETRF(rows, cols, SUNFALSE, sunctx);
+  fails += Test_DenseGETRF(rows + 7, cols, SUNFALSE, sunctx);
+  fails += Test_DenseGETRF(rows, cols, SUNTRUE, sunctx);
+
+  /* Solve in mixed precision */
+  fails += Test_DenseMixed(cols, 0, sunctx);
+#if !defined(SUNDIALS_SINGLE_PRECISION)
+  if (cols > 1)
+  {
+    fails += Test_DenseMixed(cols, 1, sunctx);
+    fails += Test_DenseMixed(cols, 2, sunctx);
+  }
+#endif
+
   /* Print result */
   if (fails)
   {
@@ -227,3 +256,271 @@ int check_vector(N_Vector X, N_Vector Y, sunrealtype tol)
 }
 
 void sync_device(void) {}
+
+/* ----------------------------------------------------------------------
+ * Unblocked LU factorization with partial pivoting, as computed by
+ * SUNDlsMat_denseGETRF before the factorization was blocked
+ * --------------------------------------------------------------------*/
+static sunindextype ReferenceGETRF(sunrealtype** a, sunindextype m,
+                                   sunindextype n, sunindextype* p)
+{
+  sunindextype i, j, k, l;
+  sunrealtype temp, mult;
+
+  for (k = 0; k < n; k++)
+  {
+    l = k;
+    for (i = k + 1; i < m; i++)
+    {
+      if (SUNRabs(a[k][i]) > SUNRabs(a[k][l])) { l = i; }
+    }
+    p[k] = l;
+
+    if (a[k][l] == ZERO) { return (k + 1); }
+
+    if (l != k)
+    {
+      for (i = 0; i < n; i++)
+      {
+        temp    = a[i][l];
+        a[i][l] = a[i][k];
+        a[i][k] = temp;
+      }
+    }
+
+    mult = ONE / a[k][k];
+    for (i = k + 1; i < m; i++) { a[k][i] *= mult; }
+
+    for (j = k + 1; j < n; j++)
+    {
+      for (i = k + 1; i < m; i++) { a[j][i] -= a[j][k] * a[k][i]; }
+    }
+  }
+
+  return (0);
+}
+
+/* ----------------------------------------------------------------------
+ * Factor a random rows x cols matrix with SUNDlsMat_denseGETRF, with
+ * SUNDlsMat_denseGETRFThreads, and with the unblocked algorithm. The
+ * pivots and return values must agree, the factors must agree to
+ * rounding (the SIMD kernels may use fused multiply-adds), and the
+ * threaded factors must equal the serial ones. A singular matrix has
+ * its last column set to zero.
+ * --------------------------------------------------------------------*/
+static int Test_DenseGETRF(sunindextype rows, sunindextype cols,
+                           sunbooleantype singular, SUNContext sunctx)
+{
+  int failure = 0;
+  sunindextype i, j, flag, rflag, tflag;
+  sunindextype *p, *rp, *tp;
+  sunrealtype **a, **r, **t, tol;
+  SUNMatrix A, R, T;
+
+  A  = SUNDenseMatrix(rows, cols, sunctx);
+  R  = SUNDenseMatrix(rows, cols, sunctx);
+  T  = SUNDenseMatrix(rows, cols, sunctx);
+  p  = (sunindextype*)malloc(cols * sizeof(sunindextype));
+  rp = (sunindextype*)malloc(cols * sizeof(sunindextype));
+  tp = (sunindextype*)malloc(cols * sizeof(sunindextype));
+  a  = SUNDenseMatrix_Cols(A);
+  r  = SUNDenseMatrix_Cols(R);
+  t  = SUNDenseMatrix_Cols(T);
+
+  /* random entries plus an anti-identity, as in the solver test */
+  for (j = 0; j < cols; j++)
+  {
+    for (i = 0; i < rows; i++)
+    {
+      a[j][i] = (sunrealtype)rand() / (sunrealtype)RAND_MAX / cols;
+    }
+    a[j][cols - 1 - j] += ONE;
+  }
+  if (singular)
+  {
+    for (i = 0; i < rows; i++) { a[cols - 1][i] = ZERO; }
+  }
+  SUNMatCopy(A, R);
+  SUNMatCopy(A, T);
+
+  flag  = SUNDlsMat_denseGETRF(a, rows, cols, p);
+  rflag = ReferenceGETRF(r, rows, cols, rp);
+  tflag = SUNDlsMat_denseGETRFThreads(t, rows, cols, tp, 3);
+
+  if (flag != rflag || tflag != rflag)
+  {
+    printf(">>> FAILED test -- denseGETRF (%ld x %ld), return values %ld, %ld "
+           "(threads), and %ld (unblocked)\n",
+           (long int)rows, (long int)cols, (long int)flag, (long int)tflag,
+           (long int)rflag);
+    failure = 1;
+  }
+  else if (flag == 0)
+  {
+    tol = SUNRsqrt(SUN_UNIT_ROUNDOFF);
+    for (j = 0; j < cols; j++)
+    {
+      if (p[j] != rp[j] || tp[j] != rp[j]) { failure = 1; }
+      for (i = 0; i < rows; i++)
+      {
+        if (SUNRabs(a[j][i] - r[j][i]) > tol * (ONE + SUNRabs(r[j][i])))
+        {
+          failure = 1;
+        }
+        if (t[j][i] != a[j][i]) { failure = 1; }
+      }
+    }
+    if (failure)
+    {
+      printf(">>> FAILED test -- denseGETRF (%ld x %ld), factors differ\n",
+             (long int)rows, (long int)cols);
+    }
+  }
+
+  if (!failure)
+  {
+    printf("    PASSED test -- denseGETRF (%ld x %ld%s)\n", (long int)rows,
+           (long int)cols, singular ? ", singular" : "");
+  }
+
+  SUNMatDestroy(A);
+  SUNMatDestroy(R);
+  SUNMatDestroy(T);
+  free(p);
+  free(rp);
+  free(tp);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Test_DenseMixed: solves A x = b with the factors of A in single
+ * precision, where A is
+ *
+ *   test 0: random entries plus an anti-identity, solved by refinement,
+ *   test 1: the identity with a leading block [1 1; 1 1+1e-10], which is
+ *           singular in single precision so the setup falls back to
+ *           sunrealtype,
+ *   test 2: the identity with a leading block [1 1; 1 1+1.8e-7], for
+ *           which one refinement iteration is not enough so the solve
+ *           falls back to sunrealtype,
+ *
+ * and checks the residual and the numbers of refinements and fallbacks.
+ * --------------------------------------------------------------------*/
+static int Test_DenseMixed(sunindextype n, int test, SUNContext sunctx)
+{
+  int failure = 0, max_refine, retval;
+  sunindextype i, j;
+  long int num_refine, num_fallback;
+  sunrealtype **a, *bdata, rnorm, xnorm, anorm;
+  SUNMatrix A, A0;
+  N_Vector x, b, r;
+  SUNLinearSolver LS;
+
+  A  = SUNDenseMatrix(n, n, sunctx);
+  A0 = SUNDenseMatrix(n, n, sunctx);
+  x  = N_VNew_Serial(n, sunctx);
+  b  = N_VNew_Serial(n, sunctx);
+  r  = N_VNew_Serial(n, sunctx);
+  a  = SUNDenseMatrix_Cols(A);
+
+  if (test == 0)
+  {
+    for (j = 0; j < n; j++)
+    {
+      for (i = 0; i < n; i++)
+      {
+        a[j][i] = (sunrealtype)rand() / (sunrealtype)RAND_MAX / n;
+      }
+      a[j][n - 1 - j] += ONE;
+    }
+  }
+  else
+  {
+    SUNMatZero(A);
+    for (j = 0; j < n; j++) { a[j][j] = ONE; }
+    a[0][1] = ONE;
+    a[1][0] = ONE;
+    a[1][1] += (test == 1) ? SUN_RCONST(1.0e-10) : SUN_RCONST(1.8e-7);
+  }
+  SUNMatCopy(A, A0);
+
+  /* b = A0 * ones */
+  N_VConst(ONE, x);
+  SUNMatMatvec(A0, x, b);
+  N_VConst(ZERO, x);
+
+  max_refine = (test == 2) ? 1 : 10;
+
+  LS     = SUNLinSol_Dense(x, A, sunctx);
+  retval = SUNLinSol_Dense_SetMixedPrecision(LS, SUNTRUE, max_refine);
+  if (retval == 0) { retval = SUNLinSolSetup(LS, A); }
+  if (retval == 0) { retval = SUNLinSolSolve(LS, A, x, b, ZERO); }
+  SUNLinSol_Dense_GetNumRefinements(LS, &num_refine);
+  SUNLinSol_Dense_GetNumFallbacks(LS, &num_fallback);
+
+  if (retval)
+  {
+    printf(">>> FAILED test -- mixed precision solve %d, return value %d\n",
+           test, retval);
+    failure = 1;
+  }
+  else
+  {
+    /* r = b - A0 x */
+    SUNMatMatvec(A0, x, r);
+    N_VLinearSum(ONE, b, -ONE, r, r);
+    rnorm = N_VMaxNorm(r);
+    xnorm = N_VMaxNorm(x);
+
+    /* the entries of A0 are nonnegative, so its infinity norm is max(b) */
+    bdata = N_VGetArrayPointer(b);
+    anorm = ZERO;
+    for (i = 0; i < n; i++) { anorm = SUNMAX(anorm, bdata[i]); }
+
+    if (rnorm > SUN_RCONST(100.0) * n * SUN_UNIT_ROUNDOFF * anorm * xnorm)
+    {
+      printf(">>> FAILED test -- mixed precision solve %d, residual %" GSYM
+             "\n",
+             test, rnorm);
+      failure = 1;
+    }
+    if (num_fallback != ((test == 0) ? 0 : 1))
+    {
+      printf(">>> FAILED test -- mixed precision solve %d, %ld fallbacks\n",
+             test, num_fallback);
+      failure = 1;
+    }
+    if (num_refine != SUNLinSolNumIters(LS) || num_refine > max_refine ||
+        (test == 2 && num_refine != 1))
+    {
+      printf(">>> FAILED test -- mixed precision solve %d, %ld refinements\n",
+             test, num_refine);
+      failure = 1;
+    }
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+    if (test == 0 && num_refine == 0)
+    {
+      printf(">>> FAILED test -- mixed precision solve %d, no refinement\n",
+             test);
+      failure = 1;
+    }
+#endif
+  }
+
+  if (!failure)
+  {
+    printf("    PASSED test -- mixed precision solve %d, %ld refinements, %ld "
+           "fallbacks\n",
+           test, num_refine, num_fallback);
+  }
+
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(A0);
+  N_VDestroy(x);
+  N_VDestroy(b);
+  N_VDestroy(r);
+
+  return (failure);
+}
@@ -0,0 +1,499 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNLinSol ILU module
+ * implementation.
+ * -----------------------------------------------------------------*/
+
+#include <nvector/nvector_serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+#include <sunlinsol/sunlinsol_ilu.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#include "test_sunlinsol.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* private functions */
+static SUNMatrix TestMatrix(sunindextype N, sunindextype bs, sunindextype m,
+                            SUNContext sunctx);
+static int Test_ILU0Property(sunindextype N, SUNContext sunctx);
+static int Test_Threads(SUNLinearSolver LS, SUNMatrix A, N_Vector x,
+                        N_Vector b);
+static int Test_CSC(SUNLinearSolver LS, SUNMatrix A, N_Vector x, N_Vector b);
+static int Test_Singular(SUNLinearSolver LS, SUNMatrix A);
+
+/* ----------------------------------------------------------------------
+ * SUNLinSol_ILU Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  int fails = 0;        /* counter for test failures */
+  sunindextype N, j;    /* matrix dimension          */
+  int ilutype, param;   /* factorization type        */
+  SUNLinearSolver LS;   /* solver object             */
+  SUNMatrix A, B;       /* test matrices             */
+  N_Vector x, y, b;     /* test vectors              */
+  int print_timing;
+  sunrealtype* xdata;
+  SUNContext sunctx;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx))
+  {
+    printf("ERROR: SUNContext_Create failed\n");
+    return (-1);
+  }
+
+  /* check input and set matrix dimensions */
+  if (argc < 5)
+  {
+    printf("ERROR: FOUR (4) Inputs required: matrix size, factorization type "
+           "(0 Jacobi, 1 block Jacobi, 2 ILU(k)), block size or fill level, "
+           "print timing \n");
+    return (-1);
+  }
+
+  N = (sunindextype)atol(argv[1]);
+  if (N <= 0)
+  {
+    printf("ERROR: matrix size must be a positive integer \n");
+    return (-1);
+  }
+
+  ilutype = atoi(argv[2]);
+  if (ilutype != SUN_ILU_JACOBI && ilutype != SUN_ILU_BLOCK_JACOBI &&
+      ilutype != SUN_ILU_ILUK)
+  {
+    printf("ERROR: factorization type must be 0, 1, or 2 \n");
+    return (-1);
+  }
+
+  param = atoi(argv[3]);
+  if (param < 0)
+  {
+    printf("ERROR: block size or fill level must be a nonnegative integer \n");
+    return (-1);
+  }
+
+  print_timing = atoi(argv[4]);
+  SetTiming(print_timing);
+
+  printf("\nILU linear solver test: size %ld, type %i, parameter %i\n\n",
+         (long int)N, ilutype, param);
+
+  /* Create a matrix that the factorization solves exactly: diagonal for
+     Jacobi, block diagonal for block Jacobi, tridiagonal for ILU(0), and
+     with entries N^(1/2) off the diagonal for complete ILU(k) */
+  if (ilutype == SUN_ILU_JACOBI) { A = TestMatrix(N, 1, 0, sunctx); }
+  else if (ilutype == SUN_ILU_BLOCK_JACOBI)
+  {
+    A = TestMatrix(N, SUNMAX(param, 1), 0, sunctx);
+  }
+  else if (param == 0) { A = TestMatrix(N, 1, 1, sunctx); }
+  else
+  {
+    A = TestMatrix(N, 1, SUNMAX((sunindextype)SUNRsqrt((sunrealtype)N), 1),
+                   sunctx);
+  }
+  B = SUNMatClone(A);
+  x = N_VNew_Serial(N, sunctx);
+  y = N_VNew_Serial(N, sunctx);
+  b = N_VNew_Serial(N, sunctx);
+
+  /* Fill x vector with uniform random data in [0,1] */
+  xdata = N_VGetArrayPointer(x);
+  for (j = 0; j < N; j++)
+  {
+    xdata[j] = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+  }
+
+  /* copy A and x into B and y */
+  SUNMatCopy(A, B);
+  N_VScale(ONE, x, y);
+
+  /* create right-hand side vector for linear solve */
+  fails = SUNMatMatvec(A, x, b);
+  if (fails)
+  {
+    printf("FAIL: SUNLinSol SUNMatMatvec failure\n");
+
+    /* Free matrices and vectors */
+    SUNMatDestroy(A);
+    SUNMatDestroy(B);
+    N_VDestroy(x);
+    N_VDestroy(y);
+    N_VDestroy(b);
+
+    return (1);
+  }
+
+  /* Create ILU linear solver */
+  LS = SUNLinSol_ILU(x, A, ilutype, sunctx);
+  if (ilutype == SUN_ILU_BLOCK_JACOBI)
+  {
+    fails += SUNLinSol_ILUSetBlockSize(LS, param);
+  }
+  else if (ilutype == SUN_ILU_ILUK)
+  {
+    fails += SUNLinSol_ILUSetFillLevel(LS, param);
+  }
+
+  /* Run Tests */
+  fails += Test_SUNLinSolInitialize(LS, 0);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 1000 * SUN_UNIT_ROUNDOFF, SUNTRUE,
+                               0);
+
+  fails += Test_SUNLinSolGetType(LS, SUNLINEARSOLVER_DIRECT, 0);
+  fails += Test_SUNLinSolGetID(LS, SUNLINEARSOLVER_ILU, 0);
+  fails += Test_SUNLinSolLastFlag(LS, 0);
+  fails += Test_SUNLinSolSpace(LS, 0);
+
+  /* Repeat the solve with several threads */
+  fails += Test_Threads(LS, B, y, b);
+
+  /* The same matrix in CSC format gives the same solution */
+  fails += Test_CSC(LS, B, y, b);
+
+  /* A zero row is reported with its index */
+  fails += Test_Singular(LS, B);
+
+  /* The ILU(0) factors reproduce A on its pattern */
+  fails += Test_ILU0Property(SUNMIN(N, 200), sunctx);
+
+  /* Print result */
+  if (fails) { printf("FAIL: SUNLinSol module failed %i tests \n \n", fails); }
+  else { printf("SUCCESS: SUNLinSol module passed all tests \n \n"); }
+
+  /* Free solver, matrix and vectors */
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  SUNMatDestroy(B);
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(b);
+  SUNContext_Free(&sunctx);
+
+  return (fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Diagonally dominant CSR matrix with random entries in [0,1] in the
+ * dense diagonal blocks of size bs and, when m > 0, at the positions
+ * i +/- 1 and i +/- m (a five-point stencil on a grid with m columns)
+ * --------------------------------------------------------------------*/
+static SUNMatrix TestMatrix(sunindextype N, sunindextype bs, sunindextype m,
+                            SUNContext sunctx)
+{
+  sunindextype i, j, s, e, nnz, dpos;
+  sunindextype *rowptrs, *colind;
+  sunrealtype *data, rowsum;
+  sunindextype offsets[4];
+  SUNMatrix A;
+
+  A       = SUNSparseMatrix(N, N, N * (bs + 4), CSR_MAT, sunctx);
+  rowptrs = SUNSparseMatrix_IndexPointers(A);
+  colind  = SUNSparseMatrix_IndexValues(A);
+  data    = SUNSparseMatrix_Data(A);
+
+  offsets[0] = -m;
+  offsets[1] = -1;
+  offsets[2] = 1;
+  offsets[3] = m;
+
+  nnz = 0;
+  for (i = 0; i < N; i++)
+  {
+    rowptrs[i] = nnz;
+    rowsum     = ZERO;
+    dpos       = -1;
+    s          = (i / bs) * bs;
+    e          = SUNMIN(s + bs, N);
+
+    /* entries left of the block */
+    for (j = 0; m > 0 && j < 2; j++)
+    {
+      if (i + offsets[j] >= 0 && i + offsets[j] < s &&
+          (j == 0 || offsets[j] != offsets[0]))
+      {
+        colind[nnz] = i + offsets[j];
+        data[nnz]   = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+        rowsum += data[nnz];
+        nnz++;
+      }
+    }
+
+    /* the block */
+    for (j = s; j < e; j++)
+    {
+      colind[nnz] = j;
+      data[nnz]   = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+      if (j == i) { dpos = nnz; }
+      else { rowsum += data[nnz]; }
+      nnz++;
+    }
+
+    /* entries right of the block */
+    for (j = 2; m > 0 && j < 4; j++)
+    {
+      if (i + offsets[j] >= e && i + offsets[j] < N &&
+          (j == 2 || offsets[j] != offsets[2]))
+      {
+        colind[nnz] = i + offsets[j];
+        data[nnz]   = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+        rowsum += data[nnz];
+        nnz++;
+      }
+    }
+
+    data[dpos] += ONE + rowsum;
+  }
+  rowptrs[N] = nnz;
+
+  return (A);
+}
+
+/* ----------------------------------------------------------------------
+ * The product of the ILU(0) factors of a five-point matrix equals the
+ * matrix at every position of its pattern
+ * --------------------------------------------------------------------*/
+static int Test_ILU0Property(sunindextype N, SUNContext sunctx)
+{
+  int failure = 0;
+  sunindextype i, j, k, p, m;
+  sunindextype *rowptrs, *colind, *diag, *aptrs, *acols;
+  sunrealtype *L, *U, *lu, *adata, lij, maxerr;
+  SUNLinearSolverContent_ILU content;
+  SUNLinearSolver LS;
+  SUNMatrix A;
+  N_Vector z;
+
+  m  = SUNMAX((sunindextype)SUNRsqrt((sunrealtype)N), 2);
+  A  = TestMatrix(N, 1, m, sunctx);
+  z  = N_VNew_Serial(N, sunctx);
+  LS = SUNLinSol_ILU(z, A, SUN_ILU_ILUK, sunctx);
+  failure += SUNLinSolSetup(LS, A);
+
+  /* dense copies of the unit lower and upper factors */
+  content = (SUNLinearSolverContent_ILU)LS->content;
+  rowptrs = content->rowptrs;
+  colind  = content->colind;
+  diag    = content->diag;
+  lu      = content->lu;
+  L       = (sunrealtype*)calloc(N * N, sizeof(sunrealtype));
+  U       = (sunrealtype*)calloc(N * N, sizeof(sunrealtype));
+  for (i = 0; i < N && !failure; i++)
+  {
+    L[i * N + i] = ONE;
+    for (p = rowptrs[i]; p < rowptrs[i + 1]; p++)
+    {
+      if (p < diag[i]) { L[i * N + colind[p]] = lu[p]; }
+      else { U[i * N + colind[p]] = lu[p]; }
+    }
+  }
+
+  /* compare (LU)_ij with A_ij on the pattern of A */
+  aptrs  = SUNSparseMatrix_IndexPointers(A);
+  acols  = SUNSparseMatrix_IndexValues(A);
+  adata  = SUNSparseMatrix_Data(A);
+  maxerr = ZERO;
+  for (i = 0; i < N && !failure; i++)
+  {
+    for (p = aptrs[i]; p < aptrs[i + 1]; p++)
+    {
+      j   = acols[p];
+      lij = ZERO;
+      for (k = 0; k <= SUNMIN(i, j); k++) { lij += L[i * N + k] * U[k * N + j]; }
+      maxerr = SUNMAX(maxerr, SUNRabs(lij - adata[p]));
+    }
+  }
+  if (maxerr > 100 * SUN_UNIT_ROUNDOFF * (m + 4)) { failure = 1; }
+
+  /* the pattern of the ILU(0) factors is the pattern of A */
+  if (content->nnz != aptrs[N]) { failure = 1; }
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- ILU(0) factors, max error %" GSYM "\n", maxerr);
+  }
+  else { printf("    PASSED test -- ILU(0) factors\n"); }
+
+  free(L);
+  free(U);
+  N_VDestroy(z);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Setup and solve with three threads give the same solution as with one
+ * --------------------------------------------------------------------*/
+static int Test_Threads(SUNLinearSolver LS, SUNMatrix A, N_Vector x, N_Vector b)
+{
+  int failure = 0;
+  sunindextype i, n;
+  sunrealtype *x1, *x3;
+  N_Vector y1, y3;
+
+  y1 = N_VClone(x);
+  y3 = N_VClone(x);
+  n  = N_VGetLength(x);
+
+  failure += SUNLinSol_ILUSetNumThreads(LS, 1);
+  failure += SUNLinSolSetup(LS, A);
+  failure += SUNLinSolSolve(LS, A, y1, b, ZERO);
+
+  failure += SUNLinSol_ILUSetNumThreads(LS, 3);
+  failure += SUNLinSolSetup(LS, A);
+  failure += SUNLinSolSolve(LS, A, y3, b, ZERO);
+
+  x1 = N_VGetArrayPointer(y1);
+  x3 = N_VGetArrayPointer(y3);
+  for (i = 0; i < n; i++)
+  {
+    if (x1[i] != x3[i]) { failure = 1; }
+  }
+  failure += check_vector(x, y3, 1000 * SUN_UNIT_ROUNDOFF);
+
+  if (failure) { printf(">>> FAILED test -- threaded setup and solve\n"); }
+  else { printf("    PASSED test -- threaded setup and solve\n"); }
+
+  N_VDestroy(y1);
+  N_VDestroy(y3);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * The matrix converted to CSC gives the same solution, and switching
+ * back to CSR redoes the analysis
+ * --------------------------------------------------------------------*/
+static int Test_CSC(SUNLinearSolver LS, SUNMatrix A, N_Vector x, N_Vector b)
+{
+  int failure = 0;
+  sunindextype i, n;
+  sunrealtype *x1, *x2;
+  N_Vector y1, y2;
+  SUNMatrix C;
+
+  y1 = N_VClone(x);
+  y2 = N_VClone(x);
+  n  = N_VGetLength(x);
+
+  C = NULL;
+  failure += SUNSparseMatrix_ToCSC(A, &C);
+
+  failure += SUNLinSolSetup(LS, C);
+  failure += SUNLinSolSolve(LS, C, y2, b, ZERO);
+  failure += SUNLinSolSetup(LS, A);
+  failure += SUNLinSolSolve(LS, A, y1, b, ZERO);
+
+  x1 = N_VGetArrayPointer(y1);
+  x2 = N_VGetArrayPointer(y2);
+  for (i = 0; i < n; i++)
+  {
+    if (x1[i] != x2[i]) { failure = 1; }
+  }
+  failure += check_vector(x, y2, 1000 * SUN_UNIT_ROUNDOFF);
+
+  if (failure) { printf(">>> FAILED test -- CSC matrix\n"); }
+  else { printf("    PASSED test -- CSC matrix\n"); }
+
+  N_VDestroy(y1);
+  N_VDestroy(y2);
+  SUNMatDestroy(C);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Zero the middle row: setup fails and the last flag is the (one-based)
+ * index of the row
+ * --------------------------------------------------------------------*/
+static int Test_Singular(SUNLinearSolver LS, SUNMatrix A)
+{
+  int failure = 0;
+  sunindextype k, p, flag;
+  sunindextype* rowptrs;
+  sunrealtype* data;
+  SUNMatrix C;
+
+  k = SUNSparseMatrix_Rows(A) / 2;
+
+  C = SUNMatClone(A);
+  SUNMatCopy(A, C);
+  rowptrs = SUNSparseMatrix_IndexPointers(C);
+  data    = SUNSparseMatrix_Data(C);
+  for (p = rowptrs[k]; p < rowptrs[k + 1]; p++) { data[p] = ZERO; }
+
+  if (SUNLinSolSetup(LS, C) != SUNLS_LUFACT_FAIL) { failure = 1; }
+  flag = SUNLinSolLastFlag(LS);
+  if (flag != k + 1) { failure = 1; }
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- zero row, last flag %ld (expected %ld)\n",
+           (long int)flag, (long int)(k + 1));
+  }
+  else { printf("    PASSED test -- zero row\n"); }
+
+  SUNMatDestroy(C);
+
+  return (failure);
+}
+
+/* ----------------------------------------------------------------------
+ * Implementation-specific 'check' routines
+ * --------------------------------------------------------------------*/
+int check_vector(N_Vector X, N_Vector Y, sunrealtype tol)
+{
+  int failure = 0;
+  sunindextype i, local_length;
+  sunrealtype *Xdata, *Ydata, maxerr;
+
+  Xdata        = N_VGetArrayPointer(X);
+  Ydata        = N_VGetArrayPointer(Y);
+  local_length = N_VGetLength_Serial(X);
+
+  /* check vector data */
+  for (i = 0; i < local_length; i++)
+  {
+    failure += SUNRCompareTol(Xdata[i], Ydata[i], tol);
+  }
+
+  if (failure > ZERO)
+  {
+    maxerr = ZERO;
+    for (i = 0; i < local_length; i++)
+    {
+      maxerr = SUNMAX(SUNRabs(Xdata[i] - Ydata[i]), maxerr);
+    }
+    printf("check err failure: maxerr = %" GSYM " (tol = %" GSYM ")\n", maxerr,
+           tol);
+    return (1);
+  }
+  else { return (0); }
+}
+
+void sync_device(void) {}
@@ -27,6 +27,9 @@
 
 #include "test_sunlinsol.h"
 
+/* private functions */
+static int Test_LapackBandMixed(SUNLinearSolver LS);
+
 /* ----------------------------------------------------------------------
  * SUNLinSol_LapackBand Testing Routine
  * --------------------------------------------------------------------*/
@@ -144,6 +147,14 @@ int main(int argc, char* argv[])
   fails += Test_SUNLinSolLastFlag(LS, 0);
   fails += Test_SUNLinSolSpace(LS, 0);
 
+  /* Repeat the setup and solve with the factors in single precision */
+  SUNMatCopy(B, A);
+  N_VScale(ONE, y, x);
+  fails += SUNLinSol_LapackBand_SetMixedPrecision(LS, SUNTRUE, 10);
+  fails += Test_SUNLinSolSetup(LS, A, 0);
+  fails += Test_SUNLinSolSolve(LS, A, x, b, 100 * SUN_UNIT_ROUNDOFF, SUNTRUE, 0);
+  fails += Test_LapackBandMixed(LS);
+
   /* Print result */
   if (fails)
   {
@@ -211,3 +222,35 @@ int check_vector(N_Vector X, N_Vector Y, sunrealtype tol)
 }
 
 void sync_device(void) {}
+
+/* ----------------------------------------------------------------------
+ * Test_LapackBandMixed: checks the refinement counters after a solve with
+ * the factors in single precision of a well conditioned matrix, which
+ * needs refinement in double precision and no fallback.
+ * --------------------------------------------------------------------*/
+static int Test_LapackBandMixed(SUNLinearSolver LS)
+{
+  int failure = 0;
+  long int num_refine, num_fallback;
+
+  SUNLinSol_LapackBand_GetNumRefinements(LS, &num_refine);
+  SUNLinSol_LapackBand_GetNumFallbacks(LS, &num_fallback);
+
+  if (num_fallback != 0 || num_refine != SUNLinSolNumIters(LS)) { failure = 1; }
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+  if (num_refine == 0) { failure = 1; }
+#endif
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- mixed precision, %ld refinements, %ld "
+           "fallbacks\n",
+           num_refine, num_fallback);
+  }
+  else
+  {
+    printf("    PASSED test -- mixed precision, %ld refinements\n", num_refine);
+  }
+
+  return (failure);
+}
@@ -103,7 +103,7 @@ int main(int argc, char* argv[])
   SUNLinearSolver LS;  /* linear solver object      */
   N_Vector xhat, x, b; /* test vectors              */
   UserData ProbData;   /* problem data structure    */
-  int gstype, pretype, maxl, print_timing;
+  int gstype, pretype, maxl, print_timing, sstep;
   sunindextype i;
   sunrealtype* vecdata;
   double tol;
@@ -134,6 +134,7 @@ int main(int argc, char* argv[])
     printf("  Maximum Krylov subspace dimension should be >0\n");
     printf("  Solver tolerance should be >0\n");
     printf("  timing output flag should be 0 or 1 \n");
+    printf("  optional s-step block size should be >0\n");
     return 1;
   }
   ProbData.Nloc      = (sunindextype)atol(argv[1]);
@@ -172,6 +173,13 @@ int main(int argc, char* argv[])
   print_timing = atoi(argv[6]);
   SetTiming(print_timing);
 
+  sstep = (argc > 7) ? atoi(argv[7]) : 1;
+  if (sstep <= 0)
+  {
+    printf("ERROR: s-step block size must be a positive integer\n");
+    return 1;
+  }
+
   if (ProbData.myid == 0)
   {
     printf("\nSPGMR linear solver test:\n");
@@ -182,7 +190,8 @@ int main(int argc, char* argv[])
     printf("  Preconditioning type = %i\n", pretype);
     printf("  Maximum Krylov subspace dimension = %i\n", maxl);
     printf("  Solver Tolerance = %g\n", tol);
-    printf("  timing output flag = %i\n\n", print_timing);
+    printf("  timing output flag = %i\n", print_timing);
+    printf("  s-step block size = %i\n\n", sstep);
   }
 
   /* Create vectors */
@@ -222,6 +231,7 @@ int main(int argc, char* argv[])
   fails += Test_SUNLinSolSetScalingVectors(LS, ProbData.s1, ProbData.s2,
                                            ProbData.myid);
   fails += Test_SUNLinSolSetZeroGuess(LS, ProbData.myid);
+  fails += SUNLinSol_SPGMRSetSStep(LS, sstep);
   fails += Test_SUNLinSolInitialize(LS, ProbData.myid);
   fails += Test_SUNLinSolSpace(LS, ProbData.myid);
   fails += SUNLinSol_SPGMRSetGSType(LS, gstype);
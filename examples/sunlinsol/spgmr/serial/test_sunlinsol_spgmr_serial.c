@@ -99,7 +99,7 @@ int main(int argc, char* argv[])
   SUNLinearSolver LS;  /* linear solver object      */
   N_Vector xhat, x, b; /* test vectors              */
   UserData ProbData;   /* problem data structure    */
-  int gstype, pretype, maxl, print_timing;
+  int gstype, pretype, maxl, print_timing, sstep;
   sunindextype i;
   sunrealtype* vecdata;
   double tol;
@@ -121,6 +121,7 @@ int main(int argc, char* argv[])
     printf("  Maximum Krylov subspace dimension should be >0\n");
     printf("  Solver tolerance should be >0\n");
     printf("  timing output flag should be 0 or 1 \n");
+    printf("  optional s-step block size should be >0\n");
     return 1;
   }
   ProbData.N   = (sunindextype)atol(argv[1]);
@@ -159,13 +160,21 @@ int main(int argc, char* argv[])
   print_timing = atoi(argv[6]);
   SetTiming(print_timing);
 
+  sstep = (argc > 7) ? atoi(argv[7]) : 1;
+  if (sstep <= 0)
+  {
+    printf("ERROR: s-step block size must be a positive integer\n");
+    return 1;
+  }
+
   printf("\nSPGMR linear solver test:\n");
   printf("  Problem size = %ld\n", (long int)ProbData.N);
   printf("  Gram-Schmidt orthogonalization type = %i\n", gstype);
   printf("  Preconditioning type = %i\n", pretype);
   printf("  Maximum Krylov subspace dimension = %i\n", maxl);
   printf("  Solver Tolerance = %g\n", tol);
-  printf("  timing output flag = %i\n\n", print_timing);
+  printf("  timing output flag = %i\n", print_timing);
+  printf("  s-step block size = %i\n\n", sstep);
 
   /* Create vectors */
   x = N_VNew_Serial(ProbData.N, sunctx);
@@ -196,6 +205,7 @@ int main(int argc, char* argv[])
   fails += Test_SUNLinSolSetPreconditioner(LS, &ProbData, PSetup, PSolve, 0);
   fails += Test_SUNLinSolSetScalingVectors(LS, ProbData.s1, ProbData.s2, 0);
   fails += Test_SUNLinSolSetZeroGuess(LS, 0);
+  fails += SUNLinSol_SPGMRSetSStep(LS, sstep);
   fails += Test_SUNLinSolInitialize(LS, 0);
   fails += Test_SUNLinSolSpace(LS, 0);
   fails += SUNLinSol_SPGMRSetGSType(LS, gstype);
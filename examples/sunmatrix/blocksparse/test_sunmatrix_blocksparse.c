@@ -0,0 +1,730 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the testing routine to check the SUNMatrix BlockSparse
+ * module implementation.
+ * -----------------------------------------------------------------
+ */
+
+#include <nvector/nvector_serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+#include <sunmatrix/sunmatrix_blocksparse.h>
+#include <sunmatrix/sunmatrix_dense.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#include "test_sunmatrix.h"
+
+/* prototypes for custom tests */
+int Test_SUNBlockSparseMatrixFromDense(SUNContext sunctx);
+int Test_SUNMatScaleAdd2(SUNMatrix A, SUNMatrix B, N_Vector x, N_Vector y,
+                         N_Vector z);
+int Test_SUNBlockSparseMatrixToSparse(SUNMatrix A, N_Vector x, N_Vector y,
+                                      int sparsetype);
+int Test_SUNBlockSparseMatrixColorBlockColumns(SUNMatrix A);
+int Test_SUNBlockSparseMatrixDQJacobian(SUNMatrix A, N_Vector x, N_Vector y);
+int Test_SUNBlockSparseMatrixBlockJacobi(SUNMatrix A, N_Vector x);
+
+/* ----------------------------------------------------------------------
+ * Main SUNMatrix Testing Routine
+ * --------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  int fails = 0;                     /* counter for test failures */
+  sunindextype blockrows, blockcols; /* matrix dims in blocks     */
+  sunindextype bs;                   /* block size                */
+  N_Vector x, y, z;                  /* test vectors              */
+  sunrealtype* vecdata;              /* pointers to vector data   */
+  SUNMatrix A, B, C, D, I;           /* test matrices             */
+  sunrealtype* matdata;              /* pointer to matrix data    */
+  sunindextype i, j, k, r, c;
+  int print_timing, square;
+  SUNContext sunctx;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx))
+  {
+    printf("ERROR: SUNContext_Create failed\n");
+    return (-1);
+  }
+
+  /* check input and set matrix dimensions */
+  if (argc < 5)
+  {
+    printf("ERROR: FOUR (4) Input required: matrix block rows, matrix block "
+           "cols, block size, print timing \n");
+    return (-1);
+  }
+
+  blockrows = (sunindextype)atol(argv[1]);
+  if (blockrows < 1)
+  {
+    printf("ERROR: number of block rows must be a positive integer\n");
+    return (-1);
+  }
+
+  blockcols = (sunindextype)atol(argv[2]);
+  if (blockcols < 1)
+  {
+    printf("ERROR: number of block cols must be a positive integer\n");
+    return (-1);
+  }
+
+  bs = (sunindextype)atol(argv[3]);
+  if (bs < 1)
+  {
+    printf("ERROR: block size must be a positive integer\n");
+    return (-1);
+  }
+
+  print_timing = atoi(argv[4]);
+  SetTiming(print_timing);
+
+  square = (blockrows == blockcols) ? 1 : 0;
+  printf("\nBlock sparse matrix test: size %ld by %ld blocks, block size %ld\n\n",
+         (long int)blockrows, (long int)blockcols, (long int)bs);
+
+  /* Initialize vectors and matrices to NULL */
+  x = NULL;
+  y = NULL;
+  z = NULL;
+  A = NULL;
+  B = NULL;
+  C = NULL;
+  D = NULL;
+  I = NULL;
+
+  /* check creating a block sparse matrix from a dense matrix */
+  fails += Test_SUNBlockSparseMatrixFromDense(sunctx);
+  if (fails)
+  {
+    printf("FAIL: SUNMatrix BlockSparseFromDense conversion failed\n");
+    return (1);
+  }
+
+  /* Create/fill I matrix */
+  I = NULL;
+  if (square)
+  {
+    I = SUNBlockSparseMatrix(blockrows, blockcols, bs, blockrows, sunctx);
+    for (i = 0; i < blockrows; i++)
+    {
+      SUNBlockSparseMatrix_ColumnIndices(I)[i] = i;
+      SUNBlockSparseMatrix_RowPointers(I)[i]   = i;
+      for (r = 0; r < bs; r++) { SM_BLOCK_ELEMENT_BS(I, i, r, r) = ONE; }
+    }
+    SUNBlockSparseMatrix_RowPointers(I)[blockrows] = blockrows;
+  }
+
+  /* Create/fill random dense matrices with a random block pattern, create
+     block sparse from them */
+  C = SUNDenseMatrix(blockrows * bs, blockcols * bs, sunctx);
+  D = SUNDenseMatrix(blockrows * bs, blockcols * bs, sunctx);
+  for (k = 0; k < 3 * blockrows; k++)
+  {
+    i = rand() % blockrows;
+    j = rand() % blockcols;
+    for (c = 0; c < bs; c++)
+    {
+      matdata = SUNDenseMatrix_Column(D, j * bs + c);
+      for (r = 0; r < bs; r++)
+      {
+        matdata[i * bs + r] = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+      }
+    }
+  }
+  for (k = 0; k < blockrows; k++)
+  {
+    i = rand() % blockrows;
+    j = rand() % blockcols;
+    for (c = 0; c < bs; c++)
+    {
+      matdata = SUNDenseMatrix_Column(C, j * bs + c);
+      for (r = 0; r < bs; r++)
+      {
+        matdata[i * bs + r] = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+      }
+    }
+  }
+  A = SUNBlockSparseFromDenseMatrix(C, bs, ZERO);
+  B = SUNBlockSparseFromDenseMatrix(D, bs, ZERO);
+
+  /* Create vectors and fill */
+  x       = N_VNew_Serial(blockcols * bs, sunctx);
+  y       = N_VNew_Serial(blockrows * bs, sunctx);
+  z       = N_VNew_Serial(blockrows * bs, sunctx);
+  vecdata = N_VGetArrayPointer(x);
+  for (i = 0; i < blockcols * bs; i++)
+  {
+    vecdata[i] = (sunrealtype)rand() / (sunrealtype)RAND_MAX;
+  }
+  if (SUNMatMatvec(C, x, y) != 0)
+  {
+    printf("FAIL: SUNMatrix module Dense matvec failure \n \n");
+    SUNMatDestroy(A);
+    SUNMatDestroy(B);
+    SUNMatDestroy(C);
+    SUNMatDestroy(D);
+    N_VDestroy(x);
+    N_VDestroy(y);
+    N_VDestroy(z);
+    if (square) { SUNMatDestroy(I); }
+    return (1);
+  }
+  if (SUNMatMatvec(D, x, z) != 0)
+  {
+    printf("FAIL: SUNMatrix module Dense matvec failure \n \n");
+    SUNMatDestroy(A);
+    SUNMatDestroy(B);
+    SUNMatDestroy(C);
+    SUNMatDestroy(D);
+    N_VDestroy(x);
+    N_VDestroy(y);
+    N_VDestroy(z);
+    if (square) { SUNMatDestroy(I); }
+    return (1);
+  }
+
+  /* SUNMatrix Tests */
+  fails += Test_SUNMatGetID(A, SUNMATRIX_BLOCKSPARSE, 0);
+  fails += Test_SUNMatClone(A, 0);
+  fails += Test_SUNMatCopy(A, 0);
+  fails += Test_SUNMatZero(A, 0);
+  fails += Test_SUNMatScaleAdd(A, I, 0);
+  fails += Test_SUNMatScaleAdd2(A, B, x, y, z);
+  if (square) { fails += Test_SUNMatScaleAddI(A, I, 0); }
+  fails += Test_SUNMatMatvec(A, x, y, 0);
+  fails += Test_SUNMatSpace(A, 0);
+  fails += Test_SUNBlockSparseMatrixToSparse(A, x, y, CSR_MAT);
+  fails += Test_SUNBlockSparseMatrixToSparse(A, x, y, CSC_MAT);
+  fails += Test_SUNBlockSparseMatrixColorBlockColumns(A);
+  fails += Test_SUNBlockSparseMatrixDQJacobian(A, x, y);
+  if (square) { fails += Test_SUNBlockSparseMatrixBlockJacobi(A, x); }
+
+  /* Print result */
+  if (fails)
+  {
+    printf("FAIL: SUNMatrix module failed %i tests \n \n", fails);
+    printf("\nA =\n");
+    SUNBlockSparseMatrix_Print(A, stdout);
+    printf("\nB =\n");
+    SUNBlockSparseMatrix_Print(B, stdout);
+    if (square)
+    {
+      printf("\nI =\n");
+      SUNBlockSparseMatrix_Print(I, stdout);
+    }
+    printf("\nx =\n");
+    N_VPrint_Serial(x);
+    printf("\ny =\n");
+    N_VPrint_Serial(y);
+    printf("\nz =\n");
+    N_VPrint_Serial(z);
+  }
+  else { printf("SUCCESS: SUNMatrix module passed all tests \n \n"); }
+
+  /* Free vectors and matrices */
+  N_VDestroy(x);
+  N_VDestroy(y);
+  N_VDestroy(z);
+  SUNMatDestroy(A);
+  SUNMatDestroy(B);
+  SUNMatDestroy(C);
+  SUNMatDestroy(D);
+  if (square) { SUNMatDestroy(I); }
+
+  SUNContext_Free(&sunctx);
+
+  return (fails);
+}
+
+/* ----------------------------------------------------------------------
+ * Check the conversion of a small dense matrix with 2x2 blocks:
+ *
+ *    [ 1 2 | 0 0 | 0 0 ]
+ *    [ 0 3 | 0 0 | 0 0 ]
+ *    [ ----+-----+---- ]
+ *    [ 0 0 | 0 0 | 0 4 ]
+ *    [ 5 0 | 0 0 | 0 0 ]
+ * --------------------------------------------------------------------*/
+int Test_SUNBlockSparseMatrixFromDense(SUNContext sunctx)
+{
+  int failure;
+  SUNMatrix Ad, A, B;
+  sunrealtype* data;
+  sunrealtype tol = 10 * SUN_UNIT_ROUNDOFF;
+
+  Ad                     = SUNDenseMatrix(4, 6, sunctx);
+  SM_ELEMENT_D(Ad, 0, 0) = SUN_RCONST(1.0);
+  SM_ELEMENT_D(Ad, 0, 1) = SUN_RCONST(2.0);
+  SM_ELEMENT_D(Ad, 1, 1) = SUN_RCONST(3.0);
+  SM_ELEMENT_D(Ad, 2, 5) = SUN_RCONST(4.0);
+  SM_ELEMENT_D(Ad, 3, 0) = SUN_RCONST(5.0);
+
+  B = SUNBlockSparseMatrix(2, 3, 2, 3, sunctx);
+  SUNBlockSparseMatrix_RowPointers(B)[0]   = 0;
+  SUNBlockSparseMatrix_ColumnIndices(B)[0] = 0;
+  SUNBlockSparseMatrix_RowPointers(B)[1]   = 1;
+  SUNBlockSparseMatrix_ColumnIndices(B)[1] = 0;
+  SUNBlockSparseMatrix_ColumnIndices(B)[2] = 2;
+  SUNBlockSparseMatrix_RowPointers(B)[2]   = 3;
+
+  data     = SUNBlockSparseMatrix_Data(B); /* column-major blocks */
+  data[0]  = SUN_RCONST(1.0);
+  data[2]  = SUN_RCONST(2.0);
+  data[3]  = SUN_RCONST(3.0);
+  data[5]  = SUN_RCONST(5.0);
+  data[10] = SUN_RCONST(4.0);
+
+  A       = SUNBlockSparseFromDenseMatrix(Ad, 2, ZERO);
+  failure = check_matrix(A, B, tol);
+
+  SUNMatDestroy(Ad);
+  SUNMatDestroy(A);
+  SUNMatDestroy(B);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNBlockSparseFromDenseMatrix check \n");
+    return (1);
+  }
+
+  printf("    PASSED test -- SUNBlockSparseFromDenseMatrix \n");
+  return (0);
+}
+
+/* ----------------------------------------------------------------------
+ * Extra ScaleAdd test for block sparse matrices:
+ *    A and B should have different block patterns
+ *    y should already equal A*x
+ *    z should already equal B*x
+ * --------------------------------------------------------------------*/
+int Test_SUNMatScaleAdd2(SUNMatrix A, SUNMatrix B, N_Vector x, N_Vector y,
+                         N_Vector z)
+{
+  int failure;
+  SUNMatrix C;
+  N_Vector u, v;
+  sunrealtype tol = 100 * SUN_UNIT_ROUNDOFF;
+
+  /* C = 2A + B, the union of the patterns */
+  C       = SUNMatClone(A);
+  failure = SUNMatCopy(A, C);
+  if (!failure) { failure = SUNMatScaleAdd(TWO, C, B); }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNMatScaleAdd2 returned %d \n", failure);
+    SUNMatDestroy(C);
+    return (1);
+  }
+
+  /* u = C x should equal v = 2y + z */
+  u = N_VClone(y);
+  v = N_VClone(y);
+  failure = SUNMatMatvec(C, x, u);
+  N_VLinearSum(TWO, y, ONE, z, v);
+  if (!failure) { failure = check_vector(u, v, tol); }
+
+  SUNMatDestroy(C);
+  N_VDestroy(u);
+  N_VDestroy(v);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNMatScaleAdd2 check \n");
+    return (1);
+  }
+
+  printf("    PASSED test -- SUNMatScaleAdd2 \n");
+  return (0);
+}
+
+/* ----------------------------------------------------------------------
+ * Check the conversion to a sparse matrix: y should already equal A*x
+ * --------------------------------------------------------------------*/
+int Test_SUNBlockSparseMatrixToSparse(SUNMatrix A, N_Vector x, N_Vector y,
+                                      int sparsetype)
+{
+  int failure;
+  SUNMatrix S, T;
+  N_Vector u;
+  sunrealtype tol = 100 * SUN_UNIT_ROUNDOFF;
+
+  S       = NULL;
+  u       = N_VClone(y);
+  failure = SUNBlockSparseMatrix_ToSparse(A, sparsetype, &S);
+  if (!failure) { failure = SUNMatMatvec(S, x, u); }
+  if (!failure) { failure = check_vector(u, y, tol); }
+
+  /* copy into a sparse matrix that is too small */
+  T = SUNSparseMatrix(SUNBlockSparseMatrix_Rows(A),
+                      SUNBlockSparseMatrix_Columns(A), 1, sparsetype, A->sunctx);
+  if (!failure) { failure = SUNBlockSparseMatrix_CopyToSparse(A, T); }
+  if (!failure) { failure = SUNMatMatvec(T, x, u); }
+  if (!failure) { failure = check_vector(u, y, tol); }
+
+  if (S) { SUNMatDestroy(S); }
+  SUNMatDestroy(T);
+  N_VDestroy(u);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNBlockSparseMatrix_ToSparse (%s) check \n",
+           (sparsetype == CSR_MAT) ? "CSR" : "CSC");
+    return (1);
+  }
+
+  printf("    PASSED test -- SUNBlockSparseMatrix_ToSparse (%s) \n",
+         (sparsetype == CSR_MAT) ? "CSR" : "CSC");
+  return (0);
+}
+
+int Test_SUNBlockSparseMatrixColorBlockColumns(SUNMatrix A)
+{
+  int failure = 0;
+  sunindextype i, k, N, M, ncolors;
+  sunindextype *colors, *last, *rowptrs, *colind;
+
+  M = SUNBlockSparseMatrix_BlockRows(A);
+  N = SUNBlockSparseMatrix_BlockColumns(A);
+
+  colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+  last   = (sunindextype*)malloc(N * sizeof(sunindextype));
+
+  if (SUNBlockSparseMatrix_ColorBlockColumns(A, colors, &ncolors))
+  {
+    printf(">>> FAILED test -- SUNBlockSparseMatrix_ColorBlockColumns returned "
+           "nonzero\n");
+    free(colors);
+    free(last);
+    return (1);
+  }
+
+  /* every block column must have a valid color and no two block columns with
+     the same color may have a block in the same block row */
+  for (k = 0; k < N; k++)
+  {
+    if (colors[k] < 0 || colors[k] >= ncolors) { failure = 1; }
+    last[k] = -1;
+  }
+
+  rowptrs = SUNBlockSparseMatrix_RowPointers(A);
+  colind  = SUNBlockSparseMatrix_ColumnIndices(A);
+  for (i = 0; i < M && !failure; i++)
+  {
+    for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+    {
+      if (last[colors[colind[k]]] == i) { failure = 1; }
+      last[colors[colind[k]]] = i;
+    }
+  }
+
+  free(colors);
+  free(last);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNBlockSparseMatrix_ColorBlockColumns check "
+           "failed\n");
+    return (1);
+  }
+
+  printf("    PASSED test -- SUNBlockSparseMatrix_ColorBlockColumns (%ld "
+         "colors)\n",
+         (long int)ncolors);
+
+  return (0);
+}
+
+/* f(y) = A y, the Jacobian is A */
+static int linear_fn(N_Vector y, N_Vector fy, void* user_data)
+{
+  return SUNMatMatvec((SUNMatrix)user_data, y, fy);
+}
+
+/* ----------------------------------------------------------------------
+ * Check the difference quotient Jacobian of a linear function:
+ *    x is the point, y should already equal A*x
+ * --------------------------------------------------------------------*/
+int Test_SUNBlockSparseMatrixDQJacobian(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int failure;
+  SUNMatrix J;
+  N_Vector tmp1, tmp2;
+  sunindextype i, n;
+  sunrealtype *Adata, *Jdata;
+  sunrealtype tol = SUNRpowerR(SUN_UNIT_ROUNDOFF, SUN_RCONST(1.0) / THREE);
+
+  /* J gets the pattern of A with zero values */
+  J       = SUNMatClone(A);
+  tmp1    = N_VClone(x);
+  tmp2    = N_VClone(y);
+  failure = SUNMatCopy(A, J);
+  if (!failure) { failure = SUNMatZero(J); }
+  if (!failure)
+  {
+    failure = SUNBlockSparseMatrix_DQJacobian(J, linear_fn, A, x, y, NULL,
+                                              tmp1, tmp2);
+  }
+
+  /* compare the entries, the error of the difference quotient of a linear
+     function is O(uround / increment) */
+  Adata = SUNBlockSparseMatrix_Data(A);
+  Jdata = SUNBlockSparseMatrix_Data(J);
+  n = SUNBlockSparseMatrix_RowPointers(A)[SUNBlockSparseMatrix_BlockRows(A)] *
+      SUNBlockSparseMatrix_BlockSize(A) * SUNBlockSparseMatrix_BlockSize(A);
+  for (i = 0; i < n && !failure; i++)
+  {
+    failure = (SUNRabs(Adata[i] - Jdata[i]) > tol);
+  }
+
+  SUNMatDestroy(J);
+  N_VDestroy(tmp1);
+  N_VDestroy(tmp2);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNBlockSparseMatrix_DQJacobian check \n");
+    return (1);
+  }
+
+  printf("    PASSED test -- SUNBlockSparseMatrix_DQJacobian \n");
+  return (0);
+}
+
+/* ----------------------------------------------------------------------
+ * Check the block-Jacobi solve with B = A/10 + I: the product of the block
+ * diagonal part of B and the solution z of D z = x should equal x
+ * --------------------------------------------------------------------*/
+int Test_SUNBlockSparseMatrixBlockJacobi(SUNMatrix A, N_Vector x)
+{
+  int failure;
+  SUNMatrix B, D;
+  N_Vector u, z;
+  sunindextype i, k, l, M, bs;
+  sunindextype *rowptrs, *colind;
+  sunrealtype tol = 1000 * SUN_UNIT_ROUNDOFF;
+
+  M  = SUNBlockSparseMatrix_BlockRows(A);
+  bs = SUNBlockSparseMatrix_BlockSize(A);
+
+  B       = SUNMatClone(A);
+  failure = SUNMatCopy(A, B);
+  if (!failure) { failure = SUNMatScaleAddI(SUN_RCONST(0.1), B); }
+  if (!failure) { failure = SUNBlockSparseMatrix_FactorBlockDiagonal(B); }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNBlockSparseMatrix_FactorBlockDiagonal "
+           "returned %d \n",
+           failure);
+    SUNMatDestroy(B);
+    return (1);
+  }
+
+  /* D holds the diagonal blocks of B */
+  rowptrs = SUNBlockSparseMatrix_RowPointers(B);
+  colind  = SUNBlockSparseMatrix_ColumnIndices(B);
+  D       = SUNBlockSparseMatrix(M, M, bs, M, A->sunctx);
+  for (i = 0; i < M; i++)
+  {
+    SUNBlockSparseMatrix_ColumnIndices(D)[i] = i;
+    SUNBlockSparseMatrix_RowPointers(D)[i]   = i;
+    for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+    {
+      if (colind[k] != i) { continue; }
+      for (l = 0; l < bs * bs; l++)
+      {
+        SM_BLOCK_BS(D, i)[l] = SM_BLOCK_BS(B, k)[l];
+      }
+    }
+  }
+  SUNBlockSparseMatrix_RowPointers(D)[M] = M;
+
+  u = N_VClone(x);
+  z = N_VClone(x);
+
+  /* out of place solve */
+  failure = SUNBlockSparseMatrix_SolveBlockDiagonal(B, z, x);
+  if (!failure) { failure = SUNMatMatvec(D, z, u); }
+  if (!failure) { failure = check_vector(u, x, tol); }
+
+  /* in place solve */
+  if (!failure)
+  {
+    N_VScale(ONE, x, z);
+    failure = SUNBlockSparseMatrix_SolveBlockDiagonal(B, z, z);
+  }
+  if (!failure) { failure = SUNMatMatvec(D, z, u); }
+  if (!failure) { failure = check_vector(u, x, tol); }
+
+  SUNMatDestroy(B);
+  SUNMatDestroy(D);
+  N_VDestroy(u);
+  N_VDestroy(z);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNBlockSparseMatrix_SolveBlockDiagonal check "
+           "\n");
+    return (1);
+  }
+
+  printf("    PASSED test -- SUNBlockSparseMatrix block-Jacobi \n");
+  return (0);
+}
+
+/* ----------------------------------------------------------------------
+ * Check matrix
+ * --------------------------------------------------------------------*/
+int check_matrix(SUNMatrix A, SUNMatrix B, sunrealtype tol)
+{
+  int failure = 0;
+  sunrealtype *Adata, *Bdata;
+  sunindextype *Arowptrs, *Browptrs;
+  sunindextype *Acolind, *Bcolind;
+  sunindextype i, M, bs, Annzb, Bnnzb;
+
+  /* matrices must have same type, shape, block size, and number of blocks */
+  if (SUNMatGetID(A) != SUNMatGetID(B))
+  {
+    printf(">>> ERROR: check_matrix: Different storage types (%d vs %d)\n",
+           SUNMatGetID(A), SUNMatGetID(B));
+    return (1);
+  }
+  if (SUNBlockSparseMatrix_BlockRows(A) != SUNBlockSparseMatrix_BlockRows(B) ||
+      SUNBlockSparseMatrix_BlockColumns(A) !=
+        SUNBlockSparseMatrix_BlockColumns(B) ||
+      SUNBlockSparseMatrix_BlockSize(A) != SUNBlockSparseMatrix_BlockSize(B))
+  {
+    printf(">>> ERROR: check_matrix: Different block dimensions\n");
+    return (1);
+  }
+
+  M        = SUNBlockSparseMatrix_BlockRows(A);
+  bs       = SUNBlockSparseMatrix_BlockSize(A);
+  Adata    = SUNBlockSparseMatrix_Data(A);
+  Arowptrs = SUNBlockSparseMatrix_RowPointers(A);
+  Acolind  = SUNBlockSparseMatrix_ColumnIndices(A);
+  Annzb    = Arowptrs[M];
+  Bdata    = SUNBlockSparseMatrix_Data(B);
+  Browptrs = SUNBlockSparseMatrix_RowPointers(B);
+  Bcolind  = SUNBlockSparseMatrix_ColumnIndices(B);
+  Bnnzb    = Browptrs[M];
+
+  if (Annzb != Bnnzb)
+  {
+    printf(">>> ERROR: check_matrix: Different numbers of blocks (%ld vs "
+           "%ld)\n",
+           (long int)Annzb, (long int)Bnnzb);
+    return (1);
+  }
+
+  /* compare block patterns */
+  for (i = 0; i < M; i++) { failure += (Arowptrs[i] != Browptrs[i]); }
+  if (failure > ZERO)
+  {
+    printf(">>> ERROR: check_matrix: Different rowptrs \n");
+    return (1);
+  }
+  for (i = 0; i < Annzb; i++) { failure += (Acolind[i] != Bcolind[i]); }
+  if (failure > ZERO)
+  {
+    printf(">>> ERROR: check_matrix: Different colind \n");
+    return (1);
+  }
+
+  /* compare matrix values */
+  for (i = 0; i < Annzb * bs * bs; i++)
+  {
+    failure += SUNRCompareTol(Adata[i], Bdata[i], tol);
+  }
+  if (failure > ZERO)
+  {
+    printf(">>> ERROR: check_matrix: Different entries \n");
+    return (1);
+  }
+
+  return (0);
+}
+
+int check_matrix_entry(SUNMatrix A, sunrealtype val, sunrealtype tol)
+{
+  int failure = 0;
+  sunrealtype* Adata;
+  sunindextype i, n, bs;
+
+  /* get data pointer */
+  Adata = SUNBlockSparseMatrix_Data(A);
+
+  /* compare data */
+  bs = SUNBlockSparseMatrix_BlockSize(A);
+  n = SUNBlockSparseMatrix_RowPointers(A)[SUNBlockSparseMatrix_BlockRows(A)] *
+      bs * bs;
+  for (i = 0; i < n; i++) { failure += SUNRCompareTol(Adata[i], val, tol); }
+
+  if (failure > ZERO) { return (1); }
+  else { return (0); }
+}
+
+int check_vector(N_Vector x, N_Vector y, sunrealtype tol)
+{
+  int failure = 0;
+  sunrealtype *xdata, *ydata;
+  sunindextype xldata, yldata;
+  sunindextype i;
+
+  /* get vector data */
+  xdata = N_VGetArrayPointer(x);
+  ydata = N_VGetArrayPointer(y);
+
+  /* check data lengths */
+  xldata = N_VGetLength_Serial(x);
+  yldata = N_VGetLength_Serial(y);
+
+  if (xldata != yldata)
+  {
+    printf(">>> ERROR: check_vector: Different data array lengths \n");
+    return (1);
+  }
+
+  /* check vector data */
+  for (i = 0; i < xldata; i++)
+  {
+    failure += SUNRCompareTol(xdata[i], ydata[i], tol);
+  }
+
+  if (failure > ZERO) { return (1); }
+  else { return (0); }
+}
+
+sunbooleantype has_data(SUNMatrix A)
+{
+  sunrealtype* Adata = SUNBlockSparseMatrix_Data(A);
+  if (Adata == NULL) { return SUNFALSE; }
+  else { return SUNTRUE; }
+}
+
+sunbooleantype is_square(SUNMatrix A)
+{
+  if (SUNBlockSparseMatrix_Rows(A) == SUNBlockSparseMatrix_Columns(A))
+  {
+    return SUNTRUE;
+  }
+  else { return SUNFALSE; }
+}
+
+void sync_device(SUNMatrix A)
+{
+  /* not running on GPU, just return */
+  return;
+}
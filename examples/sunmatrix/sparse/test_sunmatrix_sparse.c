@@ -32,8 +32,11 @@
 int Test_SUNMatScaleAdd2(SUNMatrix A, SUNMatrix B, N_Vector x, N_Vector y,
                          N_Vector z);
 int Test_SUNMatScaleAddI2(SUNMatrix A, N_Vector x, N_Vector y);
+int Test_SUNSparseMatrixInsertDiagonal(SUNMatrix A, N_Vector x, N_Vector y);
+int Test_SUNSparseMatrixSetNumThreads(SUNMatrix A, N_Vector x, N_Vector y);
 int Test_SUNSparseMatrixToCSC(SUNMatrix A);
 int Test_SUNSparseMatrixToCSR(SUNMatrix A);
+int Test_SUNSparseMatrixColorColumns(SUNMatrix A);
 
 /* ----------------------------------------------------------------------
  * Main SUNMatrix Testing Routine
@@ -455,11 +458,14 @@ int main(int argc, char* argv[])
   {
     fails += Test_SUNMatScaleAddI(A, I, 0);
     fails += Test_SUNMatScaleAddI2(A, x, y);
+    fails += Test_SUNSparseMatrixInsertDiagonal(A, x, y);
   }
   fails += Test_SUNMatMatvec(A, x, y, 0);
+  fails += Test_SUNSparseMatrixSetNumThreads(A, x, y);
   fails += Test_SUNMatSpace(A, 0);
   if (mattype == CSR_MAT) { fails += Test_SUNSparseMatrixToCSC(A); }
   else { fails += Test_SUNSparseMatrixToCSR(A); }
+  fails += Test_SUNSparseMatrixColorColumns(A);
 
   /* Print result */
   if (fails)
@@ -894,6 +900,187 @@ int Test_SUNMatScaleAddI2(SUNMatrix A, N_Vector x, N_Vector y)
   return (0);
 }
 
+int Test_SUNSparseMatrixInsertDiagonal(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int failure = 0;
+  SUNMatrix B, C;
+  N_Vector w, z;
+  sunindextype j, k, N, *Bp, *Bi;
+  sunrealtype *Bx, *Cx;
+  sunrealtype tol = 200 * SUN_UNIT_ROUNDOFF;
+
+  N = SUNSparseMatrix_NP(A);
+  B = SUNMatClone(A);
+  C = SUNMatClone(A);
+  z = N_VClone(x);
+  w = N_VClone(x);
+
+  /* test 1: the pattern contains the diagonal and the values are unchanged */
+  failure = SUNMatCopy(A, B);
+  if (!failure) { failure = SUNSparseMatrix_InsertDiagonal(B); }
+  if (!failure) { failure = SUNMatMatvec(B, x, z); }
+  if (!failure) { failure = check_vector(z, y, tol); }
+  Bp = SUNSparseMatrix_IndexPointers(B);
+  Bi = SUNSparseMatrix_IndexValues(B);
+  for (j = 0; j < N && !failure; j++)
+  {
+    failure = 1;
+    for (k = Bp[j]; k < Bp[j + 1]; k++)
+    {
+      if (Bi[k] == j) { failure = 0; }
+    }
+  }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_InsertDiagonal check 1 \n");
+    SUNMatDestroy(B);
+    SUNMatDestroy(C);
+    N_VDestroy(z);
+    N_VDestroy(w);
+    return (1);
+  }
+  else
+  {
+    printf("    PASSED test -- SUNSparseMatrix_InsertDiagonal check 1 \n");
+  }
+
+  /* test 2: ScaleAddI and ScaleAdd with the same pattern update the values
+     in place */
+  Bx      = SUNSparseMatrix_Data(B);
+  failure = SUNMatScaleAddI(NEG_ONE, B); /* B = I-A */
+  if (!failure) { failure = SUNMatCopy(B, C); }
+  Cx = SUNSparseMatrix_Data(C);
+  if (!failure) { failure = SUNMatScaleAdd(ONE, C, B); } /* C = 2(I-A) */
+  if (!failure) { failure = SUNMatMatvec(C, x, z); }
+  N_VLinearSum(TWO, x, -TWO, y, w);
+  if (!failure) { failure = check_vector(z, w, tol); }
+  if (!failure)
+  {
+    failure = (SUNSparseMatrix_Data(B) != Bx || SUNSparseMatrix_Data(C) != Cx);
+  }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_InsertDiagonal check 2 \n");
+    SUNMatDestroy(B);
+    SUNMatDestroy(C);
+    N_VDestroy(z);
+    N_VDestroy(w);
+    return (1);
+  }
+  else
+  {
+    printf("    PASSED test -- SUNSparseMatrix_InsertDiagonal check 2 \n");
+  }
+
+  /* test 3: refilling the pattern without the diagonal reuses the storage */
+  failure = SUNMatCopy(A, B);
+  Bx      = SUNSparseMatrix_Data(B);
+  if (!failure) { failure = SUNMatScaleAddI(NEG_ONE, B); } /* B = I-A */
+  if (!failure) { failure = SUNMatMatvec(B, x, z); }
+  N_VLinearSum(ONE, x, NEG_ONE, y, w);
+  if (!failure) { failure = check_vector(z, w, tol); }
+  if (!failure) { failure = (SUNSparseMatrix_Data(B) != Bx); }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_InsertDiagonal check 3 \n");
+    SUNMatDestroy(B);
+    SUNMatDestroy(C);
+    N_VDestroy(z);
+    N_VDestroy(w);
+    return (1);
+  }
+  else
+  {
+    printf("    PASSED test -- SUNSparseMatrix_InsertDiagonal check 3 \n");
+  }
+
+  SUNMatDestroy(B);
+  SUNMatDestroy(C);
+  N_VDestroy(z);
+  N_VDestroy(w);
+  return (0);
+}
+
+int Test_SUNSparseMatrixSetNumThreads(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int failure = 0;
+  SUNMatrix B;
+  N_Vector w, z;
+  sunindextype i, M;
+  sunrealtype *wd, *zd;
+  sunrealtype tol = 200 * SUN_UNIT_ROUNDOFF;
+
+  M  = SUNSparseMatrix_Rows(A);
+  B  = SUNMatClone(A);
+  z  = N_VClone(y);
+  w  = N_VClone(y);
+  wd = N_VGetArrayPointer(w);
+  zd = N_VGetArrayPointer(z);
+
+  /* test 1: the threaded product is identical to the serial product */
+  failure = SUNMatCopy(A, B);
+  if (!failure) { failure = SUNSparseMatrix_SetNumThreads(B, 3); }
+  if (!failure) { failure = SUNMatMatvec(A, x, w); }
+  if (!failure) { failure = SUNMatMatvec(B, x, z); }
+  for (i = 0; i < M && !failure; i++) { failure = (zd[i] != wd[i]); }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_SetNumThreads check 1 \n");
+    SUNMatDestroy(B);
+    N_VDestroy(z);
+    N_VDestroy(w);
+    return (1);
+  }
+  else
+  {
+    printf("    PASSED test -- SUNSparseMatrix_SetNumThreads check 1 \n");
+  }
+
+  /* test 2: the product uses the current values */
+  failure = SUNMatScaleAdd(TWO, B, A); /* B = 3A */
+  if (!failure) { failure = SUNMatMatvec(B, x, z); }
+  N_VScale(SUN_RCONST(3.0), w, w);
+  if (!failure) { failure = check_vector(z, w, tol); }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_SetNumThreads check 2 \n");
+    SUNMatDestroy(B);
+    N_VDestroy(z);
+    N_VDestroy(w);
+    return (1);
+  }
+  else
+  {
+    printf("    PASSED test -- SUNSparseMatrix_SetNumThreads check 2 \n");
+  }
+
+  /* test 3: the product uses the current pattern */
+  failure = SUNMatZero(B);
+  if (!failure) { failure = SUNMatMatvec(B, x, z); }
+  for (i = 0; i < M && !failure; i++) { failure = (zd[i] != ZERO); }
+  if (!failure) { failure = SUNMatCopy(A, B); }
+  if (!failure) { failure = SUNMatMatvec(A, x, w); }
+  if (!failure) { failure = SUNMatMatvec(B, x, z); }
+  for (i = 0; i < M && !failure; i++) { failure = (zd[i] != wd[i]); }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_SetNumThreads check 3 \n");
+    SUNMatDestroy(B);
+    N_VDestroy(z);
+    N_VDestroy(w);
+    return (1);
+  }
+  else
+  {
+    printf("    PASSED test -- SUNSparseMatrix_SetNumThreads check 3 \n");
+  }
+
+  SUNMatDestroy(B);
+  N_VDestroy(z);
+  N_VDestroy(w);
+  return (0);
+}
+
 int Test_SUNSparseMatrixToCSR(SUNMatrix A)
 {
   int failure;
@@ -974,6 +1161,71 @@ int Test_SUNSparseMatrixToCSC(SUNMatrix A)
   return (0);
 }
 
+int Test_SUNSparseMatrixColorColumns(SUNMatrix A)
+{
+  int failure = 0;
+  SUNMatrix csr;
+  sunindextype i, k, N, M, ncolors;
+  sunindextype *colors, *last, *rowptrs, *colvals;
+
+  M = SUNSparseMatrix_Rows(A);
+  N = SUNSparseMatrix_Columns(A);
+
+  colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+  last   = (sunindextype*)malloc(N * sizeof(sunindextype));
+
+  if (SUNSparseMatrix_ColorColumns(A, colors, &ncolors))
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_ColorColumns returned nonzero\n");
+    free(colors);
+    free(last);
+    return (1);
+  }
+
+  if (SUNSparseMatrix_SparseType(A) == CSR_MAT) { csr = A; }
+  else if (SUNSparseMatrix_ToCSR(A, &csr))
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_ToCSR returned nonzero\n");
+    free(colors);
+    free(last);
+    return (1);
+  }
+
+  /* every column must have a valid color and no two columns with the same
+     color may have an entry in the same row */
+  for (k = 0; k < N; k++)
+  {
+    if (colors[k] < 0 || colors[k] >= ncolors) { failure = 1; }
+    last[k] = -1;
+  }
+
+  rowptrs = SUNSparseMatrix_IndexPointers(csr);
+  colvals = SUNSparseMatrix_IndexValues(csr);
+  for (i = 0; i < M && !failure; i++)
+  {
+    for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+    {
+      if (last[colors[colvals[k]]] == i) { failure = 1; }
+      last[colors[colvals[k]]] = i;
+    }
+  }
+
+  if (csr != A) { SUNMatDestroy(csr); }
+  free(colors);
+  free(last);
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNSparseMatrix_ColorColumns check failed\n");
+    return (1);
+  }
+
+  printf("    PASSED test -- SUNSparseMatrix_ColorColumns (%ld colors)\n",
+         (long int)ncolors);
+
+  return (0);
+}
+
 /* ----------------------------------------------------------------------
  * Check matrix
  * --------------------------------------------------------------------*/
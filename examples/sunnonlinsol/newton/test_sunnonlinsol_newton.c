@@ -11,7 +11,9 @@
  * SPDX-License-Identifier: BSD-3-Clause
  * SUNDIALS Copyright End
  * -----------------------------------------------------------------------------
- * This is the testing routine to check the SUNNonlinearSolver Newton module
+ * This is the testing routine to check the SUNNonlinearSolver Newton module.
+ * The system is solved twice, the second time with the Eisenstat-Walker
+ * forcing term enabled.
  * ---------------------------------------------------------------------------*/
 
 #include <stdio.h>
@@ -74,6 +76,9 @@ typedef struct IntegratorMemRec
   N_Vector x;
   SUNMatrix A;
   SUNLinearSolver LS;
+  SUNNonlinearSolver NLS;
+  int neta;
+  sunrealtype eta[MAXIT];
 }* IntegratorMem;
 
 /* Linear solver setup interface function */
@@ -94,6 +99,10 @@ int main(int argc, char* argv[])
   IntegratorMem Imem;     /* proxy for integrator memory */
   SUNNonlinearSolver NLS; /* nonlinear solver object     */
   long int niters;        /* number of nonlinear iters   */
+  sunrealtype eta;        /* forcing term                */
+  sunrealtype eta_init;   /* initial forcing term        */
+  int i, k;               /* loop counters               */
+  int fails  = 0;         /* number of failed checks     */
   int retval = 0;         /* return value                */
   SUNContext sunctx;
 
@@ -150,6 +159,8 @@ int main(int argc, char* argv[])
   /* create nonlinear solver */
   NLS = SUNNonlinSol_Newton(Imem->y0, sunctx);
   if (check_retval((void*)NLS, "SUNNonlinSol_Newton", 0)) { return (1); }
+  Imem->NLS  = NLS;
+  Imem->neta = 0;
 
   /* set the nonlinear residual function */
   retval = SUNNonlinSolSetSysFn(NLS, Res);
@@ -195,6 +206,80 @@ int main(int argc, char* argv[])
 
   printf("Number of nonlinear iterations: %ld\n", niters);
 
+  /* without the forcing term the linear solves are exact */
+  for (i = 0; i < Imem->neta; i++)
+  {
+    if (Imem->eta[i] != ZERO)
+    {
+      printf("FAIL: nonzero forcing term %" GSYM " in iteration %d\n",
+             Imem->eta[i], i);
+      fails++;
+    }
+  }
+
+  /* enable the Eisenstat-Walker forcing term and solve again */
+  retval = SUNNonlinSolSetForcingTerm_Newton(NLS, SUNTRUE);
+  if (check_retval(&retval, "SUNNonlinSolSetForcingTerm_Newton", 1))
+  {
+    return (1);
+  }
+
+  /* by default the first iteration keeps the client's tolerance, then test a
+     positive initial forcing term */
+  for (k = 0; k < 2; k++)
+  {
+    eta_init = (k == 0) ? ZERO : HALF;
+
+    retval = SUNNonlinSolSetForcingParams_Newton(NLS, eta_init, ZERO, ZERO);
+    if (check_retval(&retval, "SUNNonlinSolSetForcingParams_Newton", 1))
+    {
+      return (1);
+    }
+
+    N_VConst(ZERO, Imem->ycor);
+    Imem->neta = 0;
+
+    retval = SUNNonlinSolSolve(NLS, Imem->y0, Imem->ycor, Imem->w, TOL,
+                               SUNTRUE, Imem);
+    if (check_retval(&retval, "SUNNonlinSolSolve", 1)) { return (1); }
+
+    N_VLinearSum(ONE, Imem->y0, ONE, Imem->ycor, Imem->ycur);
+
+    printf("Solution Error with forcing term (eta_init = %" GSYM "):\n",
+           eta_init);
+    printf("e1 = %" GSYM "\n", NV_Ith_S(Imem->ycur, 0) - Y1);
+    printf("e2 = %" GSYM "\n", NV_Ith_S(Imem->ycur, 1) - Y2);
+    printf("e3 = %" GSYM "\n", NV_Ith_S(Imem->ycur, 2) - Y3);
+
+    /* the first iteration uses the initial forcing term, later iterations
+       stay within the safeguards */
+    printf("Forcing terms:");
+    for (i = 0; i < Imem->neta; i++) { printf(" %" GSYM, Imem->eta[i]); }
+    printf("\n");
+
+    if (Imem->neta < 1 || Imem->eta[0] != eta_init)
+    {
+      printf("FAIL: incorrect initial forcing term\n");
+      fails++;
+    }
+    for (i = 1; i < Imem->neta; i++)
+    {
+      if (Imem->eta[i] < SUNNEWTON_ETA_MIN || Imem->eta[i] > SUNNEWTON_ETA_MAX)
+      {
+        printf("FAIL: forcing term %" GSYM " out of range in iteration %d\n",
+               Imem->eta[i], i);
+        fails++;
+      }
+    }
+  }
+
+  /* the forcing term only applies within a solve */
+  if (SUNNonlinSolGetForcingTerm(NLS, &eta) || eta != ZERO)
+  {
+    printf("FAIL: nonzero forcing term after the solve\n");
+    fails++;
+  }
+
   /* Free vector, matrix, linear solver, and nonlinear solver */
   N_VDestroy(Imem->y0);
   N_VDestroy(Imem->ycur);
@@ -207,6 +292,8 @@ int main(int argc, char* argv[])
   free(Imem);
   SUNContext_Free(&sunctx);
 
+  if (fails) { retval = 1; }
+
   /* Print result */
   if (retval) { printf("FAIL\n"); }
   else { printf("SUCCESS\n"); }
@@ -253,6 +340,11 @@ int LSolve(N_Vector b, void* mem)
   }
   Imem = (IntegratorMem)mem;
 
+  /* record the forcing term for this linear solve */
+  retval = SUNNonlinSolGetForcingTerm(Imem->NLS, &(Imem->eta[Imem->neta]));
+  if (retval != 0) { return (retval); }
+  if (Imem->neta < MAXIT - 1) { Imem->neta++; }
+
   retval = SUNLinSolSolve(Imem->LS, Imem->A, Imem->x, b, ZERO);
   N_VScale(ONE, Imem->x, b);
 
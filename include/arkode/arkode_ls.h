@@ -122,6 +122,8 @@ SUNDIALS_EXPORT int ARKodeSetMassTimes(void* arkode_mem,
                                        ARKLsMassTimesVecFn mtimes,
                                        void* mtimes_data);
 SUNDIALS_EXPORT int ARKodeSetLinSysFn(void* arkode_mem, ARKLsLinSysFn linsys);
+SUNDIALS_EXPORT int ARKodeSetJacSparsityPattern(void* arkode_mem,
+                                                SUNMatrix Jpattern);
 
 #ifdef __cplusplus
 }
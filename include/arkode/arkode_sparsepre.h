@@ -0,0 +1,49 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ARKSPARSEPRE module, which provides
+ * a preconditioner P = I - gamma*J built from a sparse Jacobian J
+ * (user-supplied or colored difference quotient) and applied with a
+ * matrix-based SUNLinearSolver, e.g., SUNLinSol_ILU.
+ * -----------------------------------------------------------------*/
+
+#ifndef _ARKSPARSEPRE_H
+#define _ARKSPARSEPRE_H
+
+#include <arkode/arkode_ls.h>
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* SparsePrec inititialization function */
+
+SUNDIALS_EXPORT int ARKSparsePrecInit(void* arkode_mem, SUNMatrix Jpattern,
+                                      SUNLinearSolver LS, ARKLsJacFn jac);
+
+/* Optional output functions */
+
+SUNDIALS_EXPORT int ARKSparsePrecGetWorkSpace(void* arkode_mem,
+                                              long int* lenrwSP,
+                                              long int* leniwSP);
+SUNDIALS_EXPORT int ARKSparsePrecGetNumRhsEvals(void* arkode_mem,
+                                                long int* nfevalsSP);
+SUNDIALS_EXPORT int ARKSparsePrecGetNumJacEvals(void* arkode_mem,
+                                                long int* njevalsSP);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,123 @@
+/* ---------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * ---------------------------------------------------------------------
+ * This is the header file for the batched ensemble mode of CVODE,
+ * CVODE_ENSEMBLE. It integrates many independent ODE systems of the
+ * same size with the BDF method, keeping a separate step size, order,
+ * and error test for each system while evaluating the right-hand side
+ * of the whole ensemble with one call.
+ *
+ * The states of the ensemble are packed into a single N_Vector in
+ * structure-of-arrays order: component i of system s is stored at
+ * index i * nsystems + s.
+ * ---------------------------------------------------------------------*/
+
+#ifndef _CVODE_ENSEMBLE_H
+#define _CVODE_ENSEMBLE_H
+
+#include <cvode/cvode.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------------------------------------------------
+ * Type : CVEnsRhsFn
+ * -----------------------------------------------------------------
+ * The right-hand side of the ensemble. On entry t[s] is the time of
+ * system s and active[s] is SUNFALSE if the values of system s in
+ * ydot are not needed. The function returns 0 if successful, a
+ * positive value on a recoverable failure, and a negative value on
+ * an unrecoverable failure.
+ * ----------------------------------------------------------------- */
+
+typedef int (*CVEnsRhsFn)(const sunrealtype* t, N_Vector y, N_Vector ydot,
+                          const sunbooleantype* active, void* user_data);
+
+/* -----------------------------------------------------------------
+ * Type : CVEnsJacFn
+ * -----------------------------------------------------------------
+ * The Jacobians of the active systems. Entry (i,j) of the Jacobian
+ * of system s, df_i/dy_j, is stored at J[(j * nstates + i) *
+ * nsystems + s]. fy holds f(t, y) on entry. J also holds the saved
+ * Jacobians of the other systems, so the entries of systems with
+ * active[s] = SUNFALSE must not be changed.
+ * ----------------------------------------------------------------- */
+
+typedef int (*CVEnsJacFn)(const sunrealtype* t, N_Vector y, N_Vector fy,
+                          sunrealtype* J, const sunbooleantype* active,
+                          void* user_data);
+
+/* Creation and initialization functions */
+
+SUNDIALS_EXPORT void* CVodeEnsembleCreate(sunindextype nstates,
+                                          sunindextype nsystems,
+                                          SUNContext sunctx);
+SUNDIALS_EXPORT int CVodeEnsembleInit(void* cvens_mem, CVEnsRhsFn f,
+                                      sunrealtype t0, N_Vector y0);
+SUNDIALS_EXPORT int CVodeEnsembleReInit(void* cvens_mem, sunrealtype t0,
+                                        N_Vector y0);
+SUNDIALS_EXPORT int CVodeEnsembleSStolerances(void* cvens_mem,
+                                              sunrealtype reltol,
+                                              sunrealtype abstol);
+SUNDIALS_EXPORT int CVodeEnsembleSVtolerances(void* cvens_mem,
+                                              sunrealtype reltol,
+                                              N_Vector abstol);
+
+/* Optional input functions */
+
+SUNDIALS_EXPORT int CVodeEnsembleSetUserData(void* cvens_mem, void* user_data);
+SUNDIALS_EXPORT int CVodeEnsembleSetJacFn(void* cvens_mem, CVEnsJacFn jac);
+SUNDIALS_EXPORT int CVodeEnsembleSetMaxOrd(void* cvens_mem, int maxord);
+SUNDIALS_EXPORT int CVodeEnsembleSetMaxNumSteps(void* cvens_mem,
+                                                long int mxsteps);
+SUNDIALS_EXPORT int CVodeEnsembleSetInitStep(void* cvens_mem, sunrealtype hin);
+
+/* Integrate the ensemble to tout */
+
+SUNDIALS_EXPORT int CVodeEnsemble(void* cvens_mem, sunrealtype tout,
+                                  N_Vector yout, sunrealtype* tret);
+
+/* Optional output functions (arrays of length nsystems unless noted) */
+
+SUNDIALS_EXPORT int CVodeEnsembleGetReturnFlags(void* cvens_mem, int* flags);
+SUNDIALS_EXPORT int CVodeEnsembleGetCurrentTime(void* cvens_mem,
+                                                sunrealtype* tcur);
+SUNDIALS_EXPORT int CVodeEnsembleGetCurrentStep(void* cvens_mem,
+                                                sunrealtype* hcur);
+SUNDIALS_EXPORT int CVodeEnsembleGetLastOrder(void* cvens_mem, int* qlast);
+SUNDIALS_EXPORT int CVodeEnsembleGetNumSteps(void* cvens_mem, long int* nsteps);
+SUNDIALS_EXPORT int CVodeEnsembleGetNumErrTestFails(void* cvens_mem,
+                                                    long int* netfails);
+SUNDIALS_EXPORT int CVodeEnsembleGetNumNonlinSolvIters(void* cvens_mem,
+                                                       long int* nniters);
+SUNDIALS_EXPORT int CVodeEnsembleGetNumNonlinSolvConvFails(void* cvens_mem,
+                                                           long int* nncfails);
+SUNDIALS_EXPORT int CVodeEnsembleGetNumJacEvals(void* cvens_mem,
+                                                long int* njevals);
+SUNDIALS_EXPORT int CVodeEnsembleGetNumLinSolvSetups(void* cvens_mem,
+                                                     long int* nlinsetups);
+
+/* Number of calls to the ensemble right-hand side (a single value) */
+
+SUNDIALS_EXPORT int CVodeEnsembleGetNumRhsEvals(void* cvens_mem,
+                                                long int* nfevals);
+
+/* Free function */
+
+SUNDIALS_EXPORT void CVodeEnsembleFree(void** cvens_mem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -96,6 +96,8 @@ SUNDIALS_EXPORT int CVodeSetPreconditioner(void* cvode_mem, CVLsPrecSetupFn pset
 SUNDIALS_EXPORT int CVodeSetJacTimes(void* cvode_mem, CVLsJacTimesSetupFn jtsetup,
                                      CVLsJacTimesVecFn jtimes);
 SUNDIALS_EXPORT int CVodeSetLinSysFn(void* cvode_mem, CVLsLinSysFn linsys);
+SUNDIALS_EXPORT int CVodeSetJacSparsityPattern(void* cvode_mem,
+                                               SUNMatrix Jpattern);
 
 /*-----------------------------------------------------------------
   Optional outputs from the CVLS linear solver interface
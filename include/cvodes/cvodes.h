@@ -529,6 +529,11 @@ SUNDIALS_EXPORT int CVodeB(void* cvode_mem, sunrealtype tBout, int itaskB);
 /* Optional Input Functions For Adjoint Problems */
 
 SUNDIALS_EXPORT int CVodeSetAdjNoSensi(void* cvode_mem);
+SUNDIALS_EXPORT int CVodeSetAdjMaxCheckPoints(void* cvode_mem, int maxckpnts);
+SUNDIALS_EXPORT int CVodeSetAdjCheckPointMemory(void* cvode_mem,
+                                                size_t ckpntmem);
+SUNDIALS_EXPORT int CVodeSetAdjCheckPointStore(void* cvode_mem,
+                                               SUNCheckpointStore store);
 
 SUNDIALS_EXPORT int CVodeSetUserDataB(void* cvode_mem, int which,
                                       void* user_dataB);
@@ -577,6 +582,9 @@ typedef struct
 
 SUNDIALS_EXPORT int CVodeGetAdjCheckPointsInfo(void* cvode_mem,
                                                CVadjCheckPointRec* ckpnt);
+SUNDIALS_EXPORT int CVodeGetAdjNumCheckPoints(void* cvode_mem, int* nckpnts);
+SUNDIALS_EXPORT int CVodeGetAdjNumRecompSteps(void* cvode_mem,
+                                              long int* nrecomp);
 
 /* CVLS interface function that depends on CVRhsFn */
 SUNDIALS_EXPORT int CVodeSetJacTimesRhsFnB(void* cvode_mem, int which,
@@ -0,0 +1,49 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the IDASPARSEPRE module, which
+ * provides a preconditioner P = dF/dy + c_j*dF/dy' built from a
+ * sparse Jacobian (user-supplied or colored difference quotient)
+ * and applied with a matrix-based SUNLinearSolver, e.g.,
+ * SUNLinSol_ILU.
+ * -----------------------------------------------------------------*/
+
+#ifndef _IDASPARSEPRE_H
+#define _IDASPARSEPRE_H
+
+#include <ida/ida_ls.h>
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* SparsePrec inititialization function */
+
+SUNDIALS_EXPORT int IDASparsePrecInit(void* ida_mem, SUNMatrix Jpattern,
+                                      SUNLinearSolver LS, IDALsJacFn jac);
+
+/* Optional output functions */
+
+SUNDIALS_EXPORT int IDASparsePrecGetWorkSpace(void* ida_mem, long int* lenrwSP,
+                                              long int* leniwSP);
+SUNDIALS_EXPORT int IDASparsePrecGetNumResEvals(void* ida_mem,
+                                                long int* nrevalsSP);
+SUNDIALS_EXPORT int IDASparsePrecGetNumJacEvals(void* ida_mem,
+                                                long int* njevalsSP);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
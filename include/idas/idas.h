@@ -512,6 +512,8 @@ SUNDIALS_EXPORT int IDASolveB(void* ida_mem, sunrealtype tBout, int itaskB);
 /* Optional Input Functions For Adjoint Problems */
 
 SUNDIALS_EXPORT int IDAAdjSetNoSensi(void* ida_mem);
+SUNDIALS_EXPORT int IDAAdjSetCheckPointStore(void* ida_mem,
+                                             SUNCheckpointStore store);
 
 SUNDIALS_EXPORT int IDASetUserDataB(void* ida_mem, int which, void* user_dataB);
 SUNDIALS_EXPORT int IDASetMaxOrdB(void* ida_mem, int which, int maxordB);
@@ -97,6 +97,7 @@ SUNDIALS_EXPORT int IDASetLSNormFactor(void* ida_mem, sunrealtype nrmfac);
 SUNDIALS_EXPORT int IDASetLinearSolutionScaling(void* ida_mem,
                                                 sunbooleantype onoff);
 SUNDIALS_EXPORT int IDASetIncrementFactor(void* ida_mem, sunrealtype dqincfac);
+SUNDIALS_EXPORT int IDASetJacSparsityPattern(void* ida_mem, SUNMatrix Jpattern);
 
 /*-----------------------------------------------------------------
   Optional outputs from the IDALS linear solver interface
@@ -0,0 +1,196 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the main header file for the "Lazy" implementation of the
+ * NVECTOR module. A lazy vector wraps a serial or OpenMP vector and
+ * defers the elementwise operations applied to it. The deferred
+ * operations are recorded into an expression and evaluated in one
+ * fused loop when a reduction, an access to the data array, or an
+ * explicit flush requires the values.
+ *
+ * Notes:
+ *
+ *   - The definition of the generic N_Vector structure can be found
+ *     in the header file sundials_nvector.h.
+ *
+ *   - The wrapped vector must not be accessed directly while it is
+ *     attached to a lazy vector. Use N_VGetBaseVector_Lazy to obtain
+ *     it with all pending operations applied.
+ *
+ *   - A pointer returned by N_VGetArrayPointer is only valid until
+ *     the next operation that writes the vector. Operations writing
+ *     a vector whose data was attached with N_VSetArrayPointer are
+ *     evaluated immediately.
+ *
+ *   - N_Vector arguments to arithmetic vector operations need not
+ *     be distinct. For example, the following call:
+ *
+ *       N_VLinearSum_Lazy(a,x,b,y,y);
+ *
+ *     (which stores the result of the operation a*x+b*y in y)
+ *     is legal.
+ * -----------------------------------------------------------------*/
+
+#ifndef _NVECTOR_LAZY_H
+#define _NVECTOR_LAZY_H
+
+#include <stdio.h>
+#include <sundials/sundials_core.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------------------------------------------------
+   Lazy implementation of N_Vector
+   ----------------------------------------------------------------- */
+
+struct _N_VLazyExpr;
+
+struct _N_VectorContent_Lazy
+{
+  N_Vector base;             /* wrapped vector holding the data      */
+  sunbooleantype own_base;   /* flag indicating ownership of base    */
+  struct _N_VLazyExpr* expr; /* pending operations and dependencies  */
+};
+
+typedef struct _N_VectorContent_Lazy* N_VectorContent_Lazy;
+
+/* -----------------------------------------------------------------
+   functions exported by Lazy
+   ----------------------------------------------------------------- */
+
+SUNDIALS_EXPORT
+N_Vector N_VMake_Lazy(N_Vector base, SUNContext sunctx);
+
+SUNDIALS_EXPORT
+N_Vector N_VGetBaseVector_Lazy(N_Vector v);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VFlush_Lazy(N_Vector v);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VGetNumOps_Lazy(N_Vector v, long int* nops, long int* nloops);
+
+SUNDIALS_EXPORT
+N_Vector_ID N_VGetVectorID_Lazy(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VPrint_Lazy(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VPrintFile_Lazy(N_Vector v, FILE* outfile);
+
+SUNDIALS_EXPORT
+N_Vector N_VCloneEmpty_Lazy(N_Vector w);
+
+SUNDIALS_EXPORT
+N_Vector N_VClone_Lazy(N_Vector w);
+
+SUNDIALS_EXPORT
+void N_VDestroy_Lazy(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VSpace_Lazy(N_Vector v, sunindextype* lrw, sunindextype* liw);
+
+SUNDIALS_EXPORT
+sunrealtype* N_VGetArrayPointer_Lazy(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VSetArrayPointer_Lazy(sunrealtype* v_data, N_Vector v);
+
+SUNDIALS_EXPORT
+sunindextype N_VGetLength_Lazy(N_Vector v);
+
+/* standard vector operations */
+
+SUNDIALS_EXPORT
+void N_VLinearSum_Lazy(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
+                       N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VConst_Lazy(sunrealtype c, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VProd_Lazy(N_Vector x, N_Vector y, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VDiv_Lazy(N_Vector x, N_Vector y, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VScale_Lazy(sunrealtype c, N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VAbs_Lazy(N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VInv_Lazy(N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VAddConst_Lazy(N_Vector x, sunrealtype b, N_Vector z);
+
+SUNDIALS_EXPORT
+sunrealtype N_VDotProd_Lazy(N_Vector x, N_Vector y);
+
+SUNDIALS_EXPORT
+sunrealtype N_VMaxNorm_Lazy(N_Vector x);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWrmsNorm_Lazy(N_Vector x, N_Vector w);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWrmsNormMask_Lazy(N_Vector x, N_Vector w, N_Vector id);
+
+SUNDIALS_EXPORT
+sunrealtype N_VMin_Lazy(N_Vector x);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWL2Norm_Lazy(N_Vector x, N_Vector w);
+
+SUNDIALS_EXPORT
+sunrealtype N_VL1Norm_Lazy(N_Vector x);
+
+SUNDIALS_EXPORT
+void N_VCompare_Lazy(sunrealtype c, N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+sunbooleantype N_VInvTest_Lazy(N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+sunbooleantype N_VConstrMask_Lazy(N_Vector c, N_Vector x, N_Vector m);
+
+SUNDIALS_EXPORT
+sunrealtype N_VMinQuotient_Lazy(N_Vector num, N_Vector denom);
+
+/* OPTIONAL local reduction kernels (no parallel communication) */
+
+SUNDIALS_EXPORT
+sunrealtype N_VWSqrSumLocal_Lazy(N_Vector x, N_Vector w);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWSqrSumMaskLocal_Lazy(N_Vector x, N_Vector w, N_Vector id);
+
+/* OPTIONAL XBraid interface operations */
+
+SUNDIALS_EXPORT
+SUNErrCode N_VBufSize_Lazy(N_Vector x, sunindextype* size);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VBufPack_Lazy(N_Vector x, void* buf);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VBufUnpack_Lazy(N_Vector x, void* buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
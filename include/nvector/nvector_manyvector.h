@@ -50,10 +50,13 @@ extern "C" {
 
 struct _N_VectorContent_ManyVector
 {
-  sunindextype num_subvectors; /* number of vectors attached       */
-  sunindextype global_length;  /* overall global manyvector length */
-  N_Vector* subvec_array;      /* pointer to N_Vector array        */
-  sunbooleantype own_data;     /* flag indicating data ownership   */
+  sunindextype num_subvectors;      /* number of vectors attached           */
+  sunindextype global_length;       /* overall global manyvector length     */
+  N_Vector* subvec_array;           /* pointer to N_Vector array            */
+  sunbooleantype own_data;          /* flag indicating data ownership       */
+  int num_threads;                  /* number of threads (subvector groups) */
+  sunindextype* thread_offsets;     /* first subvector of each group        */
+  sunbooleantype thread_reductions; /* flag for threaded reductions         */
 };
 
 typedef struct _N_VectorContent_ManyVector* N_VectorContent_ManyVector;
@@ -80,6 +83,9 @@ SUNErrCode N_VSetSubvectorArrayPointer_ManyVector(sunrealtype* v_data, N_Vector
 SUNDIALS_EXPORT
 sunindextype N_VGetNumSubvectors_ManyVector(N_Vector v);
 
+SUNDIALS_EXPORT
+SUNErrCode N_VSetNumThreads_ManyVector(N_Vector v, int num_threads);
+
 /* standard vector operations */
 
 SUNDIALS_EXPORT
@@ -0,0 +1,246 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the mixed-precision implementation
+ * of the NVECTOR module. A mixed-precision vector stores its data
+ * in single precision (float) to halve the memory traffic of the
+ * vector operations, while the operations compute in sunrealtype
+ * and the reductions accumulate in sunrealtype (or double when
+ * sunrealtype is single precision).
+ *
+ * Notes:
+ *
+ *   - The definition of the generic N_Vector structure can be found
+ *     in the header file sundials_nvector.h.
+ *
+ *   - The data array holds float values, so N_VGetArrayPointer
+ *     returns NULL for this vector. Use N_VGetFloatArrayPointer_Mixed
+ *     to access the data directly, or N_VCopyToArray_Mixed and
+ *     N_VCopyFromArray_Mixed to convert it from and to a sunrealtype
+ *     array, e.g., in the right-hand side function.
+ *
+ *   - N_Vector arguments to arithmetic vector operations need not
+ *     be distinct. For example, the following call:
+ *
+ *       N_VLinearSum_Mixed(a,x,b,y,y);
+ *
+ *     (which stores the result of the operation a*x+b*y in y)
+ *     is legal.
+ * -----------------------------------------------------------------*/
+
+#ifndef _NVECTOR_MIXED_H
+#define _NVECTOR_MIXED_H
+
+#include <stdio.h>
+#include <sundials/sundials_core.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------------------------------------------------
+   Mixed-precision implementation of N_Vector
+   ----------------------------------------------------------------- */
+
+struct _N_VectorContent_Mixed
+{
+  sunindextype length;     /* vector length                 */
+  sunbooleantype own_data; /* data ownership flag           */
+  float* data;             /* single precision data array   */
+  int num_threads;         /* number of OpenMP threads      */
+};
+
+typedef struct _N_VectorContent_Mixed* N_VectorContent_Mixed;
+
+/* -----------------------------------------------------------------
+   Macros NV_CONTENT_MX, NV_DATA_MX, NV_OWN_DATA_MX,
+          NV_LENGTH_MX, NV_NUM_THREADS_MX, and NV_Ith_MX
+   ----------------------------------------------------------------- */
+
+#define NV_CONTENT_MX(v) ((N_VectorContent_Mixed)(v->content))
+
+#define NV_LENGTH_MX(v) (NV_CONTENT_MX(v)->length)
+
+#define NV_OWN_DATA_MX(v) (NV_CONTENT_MX(v)->own_data)
+
+#define NV_DATA_MX(v) (NV_CONTENT_MX(v)->data)
+
+#define NV_NUM_THREADS_MX(v) (NV_CONTENT_MX(v)->num_threads)
+
+#define NV_Ith_MX(v, i) (NV_DATA_MX(v)[i])
+
+/* -----------------------------------------------------------------
+   Functions exported by nvector_mixed
+   ----------------------------------------------------------------- */
+
+SUNDIALS_EXPORT
+N_Vector N_VNewEmpty_Mixed(sunindextype vec_length, SUNContext sunctx);
+
+SUNDIALS_EXPORT
+N_Vector N_VNew_Mixed(sunindextype vec_length, SUNContext sunctx);
+
+SUNDIALS_EXPORT
+N_Vector N_VMake_Mixed(sunindextype vec_length, float* v_data,
+                       SUNContext sunctx);
+
+SUNDIALS_EXPORT
+sunindextype N_VGetLength_Mixed(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VPrint_Mixed(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VPrintFile_Mixed(N_Vector v, FILE* outfile);
+
+SUNDIALS_EXPORT
+N_Vector_ID N_VGetVectorID_Mixed(N_Vector v);
+
+SUNDIALS_EXPORT
+N_Vector N_VCloneEmpty_Mixed(N_Vector w);
+
+SUNDIALS_EXPORT
+N_Vector N_VClone_Mixed(N_Vector w);
+
+SUNDIALS_EXPORT
+void N_VDestroy_Mixed(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VSpace_Mixed(N_Vector v, sunindextype* lrw, sunindextype* liw);
+
+SUNDIALS_EXPORT
+float* N_VGetFloatArrayPointer_Mixed(N_Vector v);
+
+SUNDIALS_EXPORT
+void N_VSetFloatArrayPointer_Mixed(float* v_data, N_Vector v);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VCopyToArray_Mixed(N_Vector v, sunrealtype* v_data);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VCopyFromArray_Mixed(const sunrealtype* v_data, N_Vector v);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VSetNumThreads_Mixed(N_Vector v, int num_threads);
+
+/* standard vector operations */
+
+SUNDIALS_EXPORT
+void N_VLinearSum_Mixed(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
+                        N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VConst_Mixed(sunrealtype c, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VProd_Mixed(N_Vector x, N_Vector y, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VDiv_Mixed(N_Vector x, N_Vector y, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VScale_Mixed(sunrealtype c, N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VAbs_Mixed(N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VInv_Mixed(N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+void N_VAddConst_Mixed(N_Vector x, sunrealtype b, N_Vector z);
+
+SUNDIALS_EXPORT
+sunrealtype N_VDotProd_Mixed(N_Vector x, N_Vector y);
+
+SUNDIALS_EXPORT
+sunrealtype N_VMaxNorm_Mixed(N_Vector x);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWrmsNorm_Mixed(N_Vector x, N_Vector w);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWrmsNormMask_Mixed(N_Vector x, N_Vector w, N_Vector id);
+
+SUNDIALS_EXPORT
+sunrealtype N_VMin_Mixed(N_Vector x);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWL2Norm_Mixed(N_Vector x, N_Vector w);
+
+SUNDIALS_EXPORT
+sunrealtype N_VL1Norm_Mixed(N_Vector x);
+
+SUNDIALS_EXPORT
+void N_VCompare_Mixed(sunrealtype c, N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+sunbooleantype N_VInvTest_Mixed(N_Vector x, N_Vector z);
+
+SUNDIALS_EXPORT
+sunbooleantype N_VConstrMask_Mixed(N_Vector c, N_Vector x, N_Vector m);
+
+SUNDIALS_EXPORT
+sunrealtype N_VMinQuotient_Mixed(N_Vector num, N_Vector denom);
+
+/* fused vector operations */
+
+SUNDIALS_EXPORT
+SUNErrCode N_VLinearCombination_Mixed(int nvec, sunrealtype* c, N_Vector* V,
+                                      N_Vector z);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VScaleAddMulti_Mixed(int nvec, sunrealtype* a, N_Vector x,
+                                  N_Vector* Y, N_Vector* Z);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VDotProdMulti_Mixed(int nvec, N_Vector x, N_Vector* Y,
+                                 sunrealtype* dotprods);
+
+/* OPTIONAL local reduction kernels (no parallel communication) */
+
+SUNDIALS_EXPORT
+sunrealtype N_VWSqrSumLocal_Mixed(N_Vector x, N_Vector w);
+
+SUNDIALS_EXPORT
+sunrealtype N_VWSqrSumMaskLocal_Mixed(N_Vector x, N_Vector w, N_Vector id);
+
+/* OPTIONAL XBraid interface operations */
+
+SUNDIALS_EXPORT
+SUNErrCode N_VBufSize_Mixed(N_Vector x, sunindextype* size);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VBufPack_Mixed(N_Vector x, void* buf);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VBufUnpack_Mixed(N_Vector x, void* buf);
+
+/* -----------------------------------------------------------------
+   Enable / disable fused vector operations
+   ----------------------------------------------------------------- */
+
+SUNDIALS_EXPORT
+SUNErrCode N_VEnableFusedOps_Mixed(N_Vector v, sunbooleantype tf);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VEnableLinearCombination_Mixed(N_Vector v, sunbooleantype tf);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VEnableScaleAddMulti_Mixed(N_Vector v, sunbooleantype tf);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VEnableDotProdMulti_Mixed(N_Vector v, sunbooleantype tf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
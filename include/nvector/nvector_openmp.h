@@ -57,10 +57,12 @@ extern "C" {
 
 struct _N_VectorContent_OpenMP
 {
-  sunindextype length;     /* vector length            */
-  sunbooleantype own_data; /* data ownership flag      */
-  sunrealtype* data;       /* data array               */
-  int num_threads;         /* number of OpenMP threads */
+  sunindextype length;         /* vector length                */
+  sunbooleantype own_data;     /* data ownership flag          */
+  sunrealtype* data;           /* data array                   */
+  int num_threads;             /* number of OpenMP threads     */
+  sunbooleantype first_touch;  /* parallel first touch flag    */
+  sunbooleantype reproducible; /* reproducible reductions flag */
 };
 
 typedef struct _N_VectorContent_OpenMP* N_VectorContent_OpenMP;
@@ -80,6 +82,10 @@ typedef struct _N_VectorContent_OpenMP* N_VectorContent_OpenMP;
 
 #define NV_OWN_DATA_OMP(v) (NV_CONTENT_OMP(v)->own_data)
 
+#define NV_FIRST_TOUCH_OMP(v) (NV_CONTENT_OMP(v)->first_touch)
+
+#define NV_REPRODUCIBLE_OMP(v) (NV_CONTENT_OMP(v)->reproducible)
+
 #define NV_DATA_OMP(v) (NV_CONTENT_OMP(v)->data)
 
 #define NV_Ith_OMP(v, i) (NV_DATA_OMP(v)[i])
@@ -132,6 +138,21 @@ sunrealtype* N_VGetArrayPointer_OpenMP(N_Vector v);
 SUNDIALS_EXPORT
 void N_VSetArrayPointer_OpenMP(sunrealtype* v_data, N_Vector v);
 
+/* data placement options */
+SUNDIALS_EXPORT
+SUNErrCode N_VSetFirstTouch_OpenMP(N_Vector v, sunbooleantype first_touch);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VGetThreadPartition_OpenMP(N_Vector v, sunindextype* offsets);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VGetThreadsBound_OpenMP(N_Vector v, sunbooleantype* bound);
+
+/* reduction options */
+SUNDIALS_EXPORT
+SUNErrCode N_VSetReproducibleReductions_OpenMP(N_Vector v,
+                                               sunbooleantype reproducible);
+
 /* standard vector operations */
 SUNDIALS_EXPORT
 void N_VLinearSum_OpenMP(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
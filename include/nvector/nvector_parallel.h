@@ -56,11 +56,12 @@ extern "C" {
 
 struct _N_VectorContent_Parallel
 {
-  sunindextype local_length;  /* local vector length         */
-  sunindextype global_length; /* global vector length        */
-  sunbooleantype own_data;    /* ownership of data           */
-  sunrealtype* data;          /* local data array            */
-  MPI_Comm comm;              /* pointer to MPI communicator */
+  sunindextype local_length;   /* local vector length          */
+  sunindextype global_length;  /* global vector length         */
+  sunbooleantype own_data;     /* ownership of data            */
+  sunrealtype* data;           /* local data array             */
+  MPI_Comm comm;               /* pointer to MPI communicator  */
+  sunbooleantype reproducible; /* reproducible reductions flag */
 };
 
 typedef struct _N_VectorContent_Parallel* N_VectorContent_Parallel;
@@ -84,6 +85,8 @@ typedef struct _N_VectorContent_Parallel* N_VectorContent_Parallel;
 
 #define NV_COMM_P(v) (NV_CONTENT_P(v)->comm)
 
+#define NV_REPRODUCIBLE_P(v) (NV_CONTENT_P(v)->reproducible)
+
 #define NV_Ith_P(v, i) (NV_DATA_P(v)[i])
 
 /*
@@ -138,6 +141,11 @@ sunrealtype* N_VGetArrayPointer_Parallel(N_Vector v);
 SUNDIALS_EXPORT
 void N_VSetArrayPointer_Parallel(sunrealtype* v_data, N_Vector v);
 
+/* reduction options */
+SUNDIALS_EXPORT
+SUNErrCode N_VSetReproducibleReductions_Parallel(N_Vector v,
+                                                 sunbooleantype reproducible);
+
 SUNDIALS_EXPORT
 MPI_Comm N_VGetCommunicator_Parallel(N_Vector v);
 
@@ -57,12 +57,21 @@ extern "C" {
  * -----------------------------------------------------------------
  */
 
+/* Persistent pool of worker threads shared by a vector and its clones. The
+   pool is created with the vector and destroyed with the last vector that
+   references it. Its definition is private to the implementation. */
+
+typedef struct _N_VectorPool_Pthreads* N_VectorPool_Pthreads;
+
 struct _N_VectorContent_Pthreads
 {
-  sunindextype length;     /* vector length           */
-  sunbooleantype own_data; /* data ownership flag     */
-  sunrealtype* data;       /* data array              */
-  int num_threads;         /* number of POSIX threads */
+  sunindextype length;        /* vector length                  */
+  sunbooleantype own_data;    /* data ownership flag            */
+  sunrealtype* data;          /* data array                     */
+  int num_threads;            /* number of POSIX threads        */
+  sunindextype serial_length;  /* run serially below this length */
+  N_VectorPool_Pthreads pool;  /* persistent worker thread pool  */
+  sunbooleantype reproducible; /* reproducible reductions flag   */
 };
 
 typedef struct _N_VectorContent_Pthreads* N_VectorContent_Pthreads;
@@ -97,6 +106,9 @@ struct _Pthreads_Data
 
   N_Vector** ZZ1; /* array of vector arrays in fused op */
   N_Vector** ZZ2; /* array of vector arrays in fused op */
+
+  int term;         /* term in a reproducible reduction */
+  void* global_sum; /* shared binned sum in the reduction */
 };
 
 typedef struct _Pthreads_Data Pthreads_Data;
@@ -120,6 +132,12 @@ typedef struct _Pthreads_Data Pthreads_Data;
 
 #define NV_Ith_PT(v, i) (NV_DATA_PT(v)[i])
 
+#define NV_SERIAL_LENGTH_PT(v) (NV_CONTENT_PT(v)->serial_length)
+
+#define NV_POOL_PT(v) (NV_CONTENT_PT(v)->pool)
+
+#define NV_REPRODUCIBLE_PT(v) (NV_CONTENT_PT(v)->reproducible)
+
 /*
  * -----------------------------------------------------------------
  * Functions exported by nvector_Pthreads
@@ -168,6 +186,17 @@ sunrealtype* N_VGetArrayPointer_Pthreads(N_Vector v);
 SUNDIALS_EXPORT
 void N_VSetArrayPointer_Pthreads(sunrealtype* v_data, N_Vector v);
 
+/* worker pool options */
+SUNDIALS_EXPORT
+SUNErrCode N_VSetSerialLength_Pthreads(N_Vector v, sunindextype serial_length);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VSetSpinCount_Pthreads(N_Vector v, int spin_count);
+
+SUNDIALS_EXPORT
+SUNErrCode N_VSetReproducibleReductions_Pthreads(N_Vector v,
+                                                 sunbooleantype reproducible);
+
 /* standard vector operations */
 SUNDIALS_EXPORT
 void N_VLinearSum_Pthreads(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
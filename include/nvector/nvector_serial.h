@@ -240,6 +240,28 @@ SUNErrCode N_VBufPack_Serial(N_Vector x, void* buf);
 SUNDIALS_EXPORT
 SUNErrCode N_VBufUnpack_Serial(N_Vector x, void* buf);
 
+/*
+ * -----------------------------------------------------------------
+ * SIMD instruction sets used by the vector kernels. The scalar
+ * loops (N_VSIMD_NONE) are used by default; the level is global and
+ * should be set before vectors are used by several threads.
+ * -----------------------------------------------------------------
+ */
+
+typedef enum
+{
+  N_VSIMD_NONE,
+  N_VSIMD_SSE2,
+  N_VSIMD_AVX2,
+  N_VSIMD_AVX512
+} N_VSIMDLevel;
+
+SUNDIALS_EXPORT
+SUNErrCode N_VSetSIMDLevel_Serial(N_VSIMDLevel level);
+
+SUNDIALS_EXPORT
+N_VSIMDLevel N_VGetSIMDLevel_Serial(void);
+
 /*
  * -----------------------------------------------------------------
  * Enable / disable fused vector operations
@@ -0,0 +1,58 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the SUNCheckpointStore_MMap module,
+ * a check point store that keeps its records in a memory mapped
+ * file. Pages are written back and read in by the operating system,
+ * so only the records in use need to be resident.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNCHECKPOINTSTORE_MMAP_H
+#define _SUNCHECKPOINTSTORE_MMAP_H
+
+#include <sundials/sundials_checkpointstore.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* ------------------
+ * Exported Functions
+ * ------------------ */
+
+/* Creates a store backed by the file 'filename'. The file is created (or
+   truncated) and is removed when the store is destroyed. */
+SUNDIALS_EXPORT
+SUNCheckpointStore SUNCheckpointStore_MMap(const char* filename,
+                                           SUNContext sunctx);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Write_MMap(SUNCheckpointStore S, long int key,
+                                         const void* buf, size_t nbytes);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Read_MMap(SUNCheckpointStore S, long int key,
+                                        void* buf, size_t nbytes);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Remove_MMap(SUNCheckpointStore S, long int key);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Prefetch_MMap(SUNCheckpointStore S, long int key);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Destroy_MMap(SUNCheckpointStore S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SUNCHECKPOINTSTORE_MMAP_H */
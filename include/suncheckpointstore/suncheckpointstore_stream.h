@@ -0,0 +1,66 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the SUNCheckpointStore_Stream
+ * module, a check point store that streams its records to a file.
+ * A background thread writes records behind the caller and reads
+ * the record named by SUNCheckpointStore_Prefetch ahead of it.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNCHECKPOINTSTORE_STREAM_H
+#define _SUNCHECKPOINTSTORE_STREAM_H
+
+#include <sundials/sundials_checkpointstore.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* ------------------
+ * Exported Functions
+ * ------------------ */
+
+/* Creates a store backed by the file 'filename'. The file is created (or
+   truncated) and is removed when the store is destroyed. */
+SUNDIALS_EXPORT
+SUNCheckpointStore SUNCheckpointStore_Stream(const char* filename,
+                                             SUNContext sunctx);
+
+/* Sets the number of bytes of records that may wait to be written before
+   SUNCheckpointStore_Write blocks (default 16 MiB). One record is always
+   accepted. */
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_SetBufferSize_Stream(SUNCheckpointStore S,
+                                                   size_t nbytes);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Write_Stream(SUNCheckpointStore S, long int key,
+                                           const void* buf, size_t nbytes);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Read_Stream(SUNCheckpointStore S, long int key,
+                                          void* buf, size_t nbytes);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Remove_Stream(SUNCheckpointStore S, long int key);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Prefetch_Stream(SUNCheckpointStore S,
+                                              long int key);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Destroy_Stream(SUNCheckpointStore S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SUNCHECKPOINTSTORE_STREAM_H */
@@ -109,6 +109,27 @@ SUNDIALS_EXPORT
 void SUNDlsMat_bandGBTRS(sunrealtype** a, sunindextype n, sunindextype smu,
                          sunindextype ml, sunindextype* p, sunrealtype* b);
 
+/*
+ * -----------------------------------------------------------------
+ * Functions: SUNDlsMat_bandSGBTRF and SUNDlsMat_bandSGBTRS
+ * -----------------------------------------------------------------
+ * SUNDlsMat_bandSGBTRF and SUNDlsMat_bandSGBTRS are the same as
+ * SUNDlsMat_bandGBTRF and SUNDlsMat_bandGBTRS for a band matrix
+ * stored in single precision, e.g. to compute approximate factors
+ * that are refined with residuals computed in sunrealtype. The
+ * right-hand side of SUNDlsMat_bandSGBTRS is in sunrealtype.
+ * -----------------------------------------------------------------
+ */
+
+SUNDIALS_EXPORT
+sunindextype SUNDlsMat_bandSGBTRF(float** a, sunindextype n, sunindextype mu,
+                                  sunindextype ml, sunindextype smu,
+                                  sunindextype* p);
+
+SUNDIALS_EXPORT
+void SUNDlsMat_bandSGBTRS(float** a, sunindextype n, sunindextype smu,
+                          sunindextype ml, sunindextype* p, sunrealtype* b);
+
 /*
  * -----------------------------------------------------------------
  * Function: SUNDlsMat_BandCopy
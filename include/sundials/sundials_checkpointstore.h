@@ -0,0 +1,114 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SUNDIALS check point store class. These objects hold the check
+ * point data of adjoint sensitivity analysis outside of the
+ * solver's resident N_Vectors, e.g., in a file. A record is an
+ * opaque buffer of bytes identified by an integer key; the solvers
+ * fill the buffers with N_VBufPack and read them back with
+ * N_VBufUnpack.
+ * ----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_CHECKPOINTSTORE_H
+#define _SUNDIALS_CHECKPOINTSTORE_H
+
+#include <stdlib.h>
+#include <sundials/sundials_context.h>
+
+#include "sundials/sundials_types.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------------------------------------------------
+ * Generic definition of SUNCheckpointStore
+ * ----------------------------------------------------------------- */
+
+/* Forward reference for pointer to SUNCheckpointStore_Ops object */
+typedef _SUNDIALS_STRUCT_ _generic_SUNCheckpointStore_Ops* SUNCheckpointStore_Ops;
+
+/* Forward reference for pointer to SUNCheckpointStore object */
+typedef _SUNDIALS_STRUCT_ _generic_SUNCheckpointStore* SUNCheckpointStore;
+
+/* Structure containing function pointers to store operations  */
+struct _generic_SUNCheckpointStore_Ops
+{
+  /* REQUIRED of all store implementations. */
+  SUNErrCode (*write)(SUNCheckpointStore S, long int key, const void* buf,
+                      size_t nbytes);
+  SUNErrCode (*read)(SUNCheckpointStore S, long int key, void* buf,
+                     size_t nbytes);
+  SUNErrCode (*remove)(SUNCheckpointStore S, long int key);
+
+  /* OPTIONAL for all SUNCheckpointStore implementations. */
+  SUNErrCode (*prefetch)(SUNCheckpointStore S, long int key);
+  SUNErrCode (*destroy)(SUNCheckpointStore S);
+};
+
+/* A SUNCheckpointStore is a structure with an implementation-dependent
+   'content' field, and a pointer to a structure of
+   operations corresponding to that implementation. */
+struct _generic_SUNCheckpointStore
+{
+  void* content;
+  SUNCheckpointStore_Ops ops;
+  SUNContext sunctx;
+};
+
+/* -----------------------------------------------------------------
+ * Functions exported by SUNCheckpointStore module
+ * ----------------------------------------------------------------- */
+
+/* Function to create an empty SUNCheckpointStore data structure. */
+SUNDIALS_EXPORT
+SUNCheckpointStore SUNCheckpointStore_NewEmpty(SUNContext sunctx);
+
+/* Function to free a generic SUNCheckpointStore (assumes content is already
+   empty) */
+SUNDIALS_EXPORT
+void SUNCheckpointStore_DestroyEmpty(SUNCheckpointStore S);
+
+/* Function to deallocate a SUNCheckpointStore object and the records it
+   holds. */
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Destroy(SUNCheckpointStore S);
+
+/* Function to save the nbytes bytes of buf as the record 'key', replacing
+   any record with the same key. The store may finish the write after the
+   function returns, but buf may be reused immediately. */
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Write(SUNCheckpointStore S, long int key,
+                                    const void* buf, size_t nbytes);
+
+/* Function to copy the first nbytes bytes of the record 'key' into buf.
+   Returns SUN_ERR_ARG_OUTOFRANGE if there is no such record or if it is
+   shorter than nbytes. */
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Read(SUNCheckpointStore S, long int key,
+                                   void* buf, size_t nbytes);
+
+/* Function to delete the record 'key'. Removing a key that is not in the
+   store is not an error. */
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Remove(SUNCheckpointStore S, long int key);
+
+/* Function to notify the store that the record 'key' will be read next, so
+   that it can start loading it. This is only a hint and does nothing if
+   the store does not provide it. */
+SUNDIALS_EXPORT
+SUNErrCode SUNCheckpointStore_Prefetch(SUNCheckpointStore S, long int key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SUNDIALS_CHECKPOINTSTORE_H */
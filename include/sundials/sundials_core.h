@@ -16,6 +16,7 @@
 #define _SUNDIALS_CORE_H
 
 #include <sundials/sundials_adaptcontroller.h>
+#include <sundials/sundials_checkpointstore.h>
 #include <sundials/sundials_config.h>
 #include <sundials/sundials_context.h>
 #include <sundials/sundials_errors.h>
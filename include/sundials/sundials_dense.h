@@ -66,6 +66,17 @@ extern "C" {
  * SUNDlsMat_DenseGETRF and SUNDlsMat_DenseGETRS are simply wrappers around
  * SUNDlsMat_denseGETRF and SUNDlsMat_denseGETRS, respectively, which perform all the
  * work by directly accessing the data in the SUNDlsMat A (i.e. in A->cols).
+ *
+ * SUNDlsMat_denseGETRF factors the columns in panels and updates the trailing
+ * columns one panel at a time. SUNDlsMat_denseGETRFThreads computes the same
+ * factorization, dividing the trailing updates among num_threads OpenMP
+ * threads when SUNDIALS is built with OpenMP. The pivots and factors do not
+ * depend on the number of threads.
+ *
+ * SUNDlsMat_denseSGETRF and SUNDlsMat_denseSGETRS are the same routines for a
+ * matrix stored in single precision, e.g. to compute approximate factors that
+ * are refined with residuals computed in sunrealtype. The right-hand side of
+ * SUNDlsMat_denseSGETRS is in sunrealtype.
  * ----------------------------------------------------------------------------
  */
 
@@ -79,10 +90,23 @@ SUNDIALS_EXPORT
 sunindextype SUNDlsMat_denseGETRF(sunrealtype** a, sunindextype m,
                                   sunindextype n, sunindextype* p);
 
+SUNDIALS_EXPORT
+sunindextype SUNDlsMat_denseGETRFThreads(sunrealtype** a, sunindextype m,
+                                         sunindextype n, sunindextype* p,
+                                         int num_threads);
+
 SUNDIALS_EXPORT
 void SUNDlsMat_denseGETRS(sunrealtype** a, sunindextype n, sunindextype* p,
                           sunrealtype* b);
 
+SUNDIALS_EXPORT
+sunindextype SUNDlsMat_denseSGETRF(float** a, sunindextype m, sunindextype n,
+                                   sunindextype* p, int num_threads);
+
+SUNDIALS_EXPORT
+void SUNDlsMat_denseSGETRS(float** a, sunindextype n, sunindextype* p,
+                           sunrealtype* b);
+
 /*
  * ----------------------------------------------------------------------------
  * Functions : SUNDlsMat_DensePOTRF and SUNDlsMat_DensePOTRS
@@ -96,6 +96,10 @@ typedef enum
   SUNLINEARSOLVER_ONEMKLDENSE,
   SUNLINEARSOLVER_GINKGO,
   SUNLINEARSOLVER_KOKKOSDENSE,
+  SUNLINEARSOLVER_BATCHEDDENSE,
+  SUNLINEARSOLVER_GCRODR,
+  SUNLINEARSOLVER_ILU,
+  SUNLINEARSOLVER_CHEBYSHEV,
   SUNLINEARSOLVER_CUSTOM
 } SUNLinearSolver_ID;
 
@@ -68,6 +68,7 @@ typedef enum
   SUNMATRIX_CUSPARSE,
   SUNMATRIX_GINKGO,
   SUNMATRIX_KOKKOSDENSE,
+  SUNMATRIX_BLOCKSPARSE,
   SUNMATRIX_CUSTOM
 } SUNMatrix_ID;
 
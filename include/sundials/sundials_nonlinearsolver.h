@@ -113,6 +113,7 @@ struct _generic_SUNNonlinearSolver_Ops
   SUNErrCode (*getnumiters)(SUNNonlinearSolver, long int*);
   SUNErrCode (*getcuriter)(SUNNonlinearSolver, int*);
   SUNErrCode (*getnumconvfails)(SUNNonlinearSolver, long int*);
+  SUNErrCode (*getforcingterm)(SUNNonlinearSolver, sunrealtype*);
 };
 
 /* A nonlinear solver is a structure with an implementation-dependent 'content'
@@ -184,6 +185,9 @@ SUNDIALS_EXPORT
 SUNErrCode SUNNonlinSolGetNumConvFails(SUNNonlinearSolver NLS,
                                        long int* nconvfails);
 
+SUNDIALS_EXPORT
+SUNErrCode SUNNonlinSolGetForcingTerm(SUNNonlinearSolver NLS, sunrealtype* eta);
+
 /* -----------------------------------------------------------------------------
  * SUNNonlinearSolver return values
  * ---------------------------------------------------------------------------*/
@@ -78,6 +78,8 @@ typedef enum
   SUNDIALS_NVEC_MANYVECTOR,
   SUNDIALS_NVEC_MPIMANYVECTOR,
   SUNDIALS_NVEC_MPIPLUSX,
+  SUNDIALS_NVEC_LAZY,
+  SUNDIALS_NVEC_MIXED,
   SUNDIALS_NVEC_CUSTOM
 } N_Vector_ID;
 
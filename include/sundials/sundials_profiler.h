@@ -38,6 +38,18 @@ SUNErrCode SUNProfiler_Begin(SUNProfiler p, const char* name);
 SUNDIALS_EXPORT
 SUNErrCode SUNProfiler_End(SUNProfiler p, const char* name);
 
+/* Timer handles are shared by all profilers. Registering the same name
+   again returns the same handle. */
+SUNDIALS_EXPORT
+SUNErrCode SUNProfiler_RegisterTimer(SUNProfiler p, const char* name,
+                                     int* timer);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNProfiler_BeginTimer(SUNProfiler p, int timer);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNProfiler_EndTimer(SUNProfiler p, int timer);
+
 SUNDIALS_EXPORT
 SUNErrCode SUNProfiler_GetTimerResolution(SUNProfiler p, double* resolution);
 
@@ -66,11 +78,37 @@ SUNErrCode SUNProfiler_Reset(SUNProfiler p);
 
 #elif defined(SUNDIALS_BUILD_WITH_PROFILING)
 
+#if defined(__cplusplus)
+#define SUNDIALS_PROFILER_THREAD_LOCAL thread_local
+#elif defined(SUNDIALS_THREAD_LOCAL)
+#define SUNDIALS_PROFILER_THREAD_LOCAL SUNDIALS_THREAD_LOCAL
+#endif
+
+#if defined(SUNDIALS_PROFILER_THREAD_LOCAL)
+
+/* The function timer is registered on the first call on each thread and its
+   handle is kept in a thread local static shared with
+   SUNDIALS_MARK_FUNCTION_END. */
+#define SUNDIALS_MARK_FUNCTION_BEGIN(profobj)                               \
+  static SUNDIALS_PROFILER_THREAD_LOCAL int sunprof_function_timer_ = -1;   \
+  if (sunprof_function_timer_ < 0)                                          \
+  {                                                                         \
+    SUNProfiler_RegisterTimer(profobj, __func__, &sunprof_function_timer_); \
+  }                                                                         \
+  SUNProfiler_BeginTimer(profobj, sunprof_function_timer_)
+
+#define SUNDIALS_MARK_FUNCTION_END(profobj) \
+  SUNProfiler_EndTimer(profobj, sunprof_function_timer_)
+
+#else
+
 #define SUNDIALS_MARK_FUNCTION_BEGIN(profobj) \
   SUNProfiler_Begin(profobj, __func__)
 
 #define SUNDIALS_MARK_FUNCTION_END(profobj) SUNProfiler_End(profobj, __func__)
 
+#endif
+
 #define SUNDIALS_WRAP_STATEMENT(profobj, name, stmt) \
   SUNProfiler_Begin(profobj, (name));                \
   stmt;                                              \
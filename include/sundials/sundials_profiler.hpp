@@ -22,8 +22,10 @@
 #if defined(SUNDIALS_BUILD_WITH_PROFILING) && defined(SUNDIALS_CALIPER_ENABLED)
 #define SUNDIALS_CXX_MARK_FUNCTION(projobj) CALI_CXX_MARK_FUNCTION
 #elif defined(SUNDIALS_BUILD_WITH_PROFILING)
-#define SUNDIALS_CXX_MARK_FUNCTION(profobj) \
-  sundials::ProfilerMarkScope ProfilerMarkScope__(profobj, __func__)
+#define SUNDIALS_CXX_MARK_FUNCTION(profobj)                          \
+  static int ProfilerMarkScopeTimer__ = -1;                          \
+  sundials::ProfilerMarkScope ProfilerMarkScope__(profobj, __func__, \
+                                                  ProfilerMarkScopeTimer__)
 #else
 #define SUNDIALS_CXX_MARK_FUNCTION(profobj)
 #endif
@@ -38,14 +40,26 @@ public:
   {
     prof_ = prof;
     name_ = name;
-    SUNProfiler_Begin(prof_, name_);
+    SUNProfiler_RegisterTimer(prof_, name_, &timer_);
+    SUNProfiler_BeginTimer(prof_, timer_);
   }
 
-  ~ProfilerMarkScope() { SUNProfiler_End(prof_, name_); }
+  /* Registers the timer on first use and keeps the handle in timer */
+  ProfilerMarkScope(SUNProfiler prof, const char* name, int& timer)
+  {
+    prof_ = prof;
+    name_ = name;
+    if (timer < 0) { SUNProfiler_RegisterTimer(prof_, name_, &timer); }
+    timer_ = timer;
+    SUNProfiler_BeginTimer(prof_, timer_);
+  }
+
+  ~ProfilerMarkScope() { SUNProfiler_EndTimer(prof_, timer_); }
 
 private:
   SUNProfiler prof_;
   const char* name_;
+  int timer_ = -1;
 };
 } // namespace sundials
 
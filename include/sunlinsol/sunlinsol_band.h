@@ -43,6 +43,17 @@ struct _SUNLinearSolverContent_Band
   sunindextype N;
   sunindextype* pivots;
   sunindextype last_flag;
+  sunbooleantype mixed;
+  int max_refine;
+  sunbooleantype dfactored;
+  sunindextype sldim;
+  float* sdata;
+  float** scols;
+  sunrealtype* res;
+  sunrealtype rtol;
+  int last_refine;
+  long int num_refine;
+  long int num_fallback;
 };
 
 typedef struct _SUNLinearSolverContent_Band* SUNLinearSolverContent_Band;
@@ -54,6 +65,19 @@ typedef struct _SUNLinearSolverContent_Band* SUNLinearSolverContent_Band;
 SUNDIALS_EXPORT
 SUNLinearSolver SUNLinSol_Band(N_Vector y, SUNMatrix A, SUNContext sunctx);
 
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_Band_SetMixedPrecision(SUNLinearSolver S,
+                                            sunbooleantype onoff,
+                                            int max_refine);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_Band_GetNumRefinements(SUNLinearSolver S,
+                                            long int* num_refine);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_Band_GetNumFallbacks(SUNLinearSolver S,
+                                          long int* num_fallback);
+
 SUNDIALS_EXPORT
 SUNLinearSolver_Type SUNLinSolGetType_Band(SUNLinearSolver S);
 
@@ -70,6 +94,9 @@ SUNDIALS_EXPORT
 int SUNLinSolSolve_Band(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
                         sunrealtype tol);
 
+SUNDIALS_EXPORT
+int SUNLinSolNumIters_Band(SUNLinearSolver S);
+
 SUNDIALS_EXPORT
 sunindextype SUNLinSolLastFlag_Band(SUNLinearSolver S);
 
@@ -0,0 +1,104 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the batched dense implementation of
+ * the SUNLINSOL module, SUNLINSOL_BATCHEDDENSE. It solves systems
+ * with a block diagonal SUNMATRIX_BLOCKSPARSE matrix by factoring
+ * the diagonal blocks, SUNLINSOL_BATCHEDDENSE_LANES blocks at a
+ * time, in an interleaved layout.
+ *
+ * Notes:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_BATCHEDDENSE_H
+#define _SUNLINSOL_BATCHEDDENSE_H
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+#include <sunmatrix/sunmatrix_blocksparse.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* number of blocks factored together, one per SIMD lane, so that an entry
+   of all the blocks of a batch fills 64 bytes in single or double precision */
+#if defined(SUNDIALS_SINGLE_PRECISION)
+#define SUNLINSOL_BATCHEDDENSE_LANES 16
+#else
+#define SUNLINSOL_BATCHEDDENSE_LANES 8
+#endif
+
+/* ----------------------------------------------------
+ * Batched Dense Implementation of SUNLinearSolver
+ * ---------------------------------------------------- */
+
+struct _SUNLinearSolverContent_BatchedDense
+{
+  sunindextype nblocks;   /* number of diagonal blocks                */
+  sunindextype bs;        /* block size                               */
+  sunindextype nbatches;  /* number of groups of LANES blocks         */
+  sunrealtype* lu;        /* interleaved LU factors of the blocks     */
+  sunrealtype* work;      /* interleaved right-hand sides             */
+  sunindextype* pivots;   /* interleaved pivots of the factorizations */
+  sunindextype last_flag; /* last error return flag                   */
+  int num_threads;        /* number of OpenMP threads                 */
+};
+
+typedef struct _SUNLinearSolverContent_BatchedDense* SUNLinearSolverContent_BatchedDense;
+
+/* ----------------------------------------------
+ * Exported Functions for SUNLINSOL_BATCHEDDENSE
+ * ---------------------------------------------- */
+
+SUNDIALS_EXPORT
+SUNLinearSolver SUNLinSol_BatchedDense(N_Vector y, SUNMatrix A,
+                                       SUNContext sunctx);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_BatchedDense_SetNumThreads(SUNLinearSolver S,
+                                                int num_threads);
+
+SUNDIALS_EXPORT
+SUNLinearSolver_Type SUNLinSolGetType_BatchedDense(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNLinearSolver_ID SUNLinSolGetID_BatchedDense(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolInitialize_BatchedDense(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+int SUNLinSolSetup_BatchedDense(SUNLinearSolver S, SUNMatrix A);
+
+SUNDIALS_EXPORT
+int SUNLinSolSolve_BatchedDense(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                                N_Vector b, sunrealtype tol);
+
+SUNDIALS_EXPORT
+sunindextype SUNLinSolLastFlag_BatchedDense(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolSpace_BatchedDense(SUNLinearSolver S, long int* lenrwLS,
+                                       long int* leniwLS);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolFree_BatchedDense(SUNLinearSolver S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
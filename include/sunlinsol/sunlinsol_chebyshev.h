@@ -0,0 +1,155 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the Chebyshev polynomial
+ * implementation of the SUNLINSOL module, SUNLINSOL_CHEBYSHEV. It
+ * applies a fixed degree Chebyshev polynomial in the (optionally
+ * preconditioned) operator using only ATimes products and vector
+ * linear combinations, i.e., without global reductions. Bounds on
+ * the spectrum are estimated with a few Arnoldi iterations after
+ * each setup. The module is intended for use as a preconditioner.
+ *
+ * Notes:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_CHEBYSHEV_H
+#define _SUNLINSOL_CHEBYSHEV_H
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Default Chebyshev solver parameters */
+#define SUNCHEBYSHEV_DEGREE_DEFAULT  5
+#define SUNCHEBYSHEV_MAXEIG_DEFAULT  10
+#define SUNCHEBYSHEV_EIG_SAFETY      SUN_RCONST(1.1)
+#define SUNCHEBYSHEV_EIG_RATIO_FLOOR SUN_RCONST(0.01)
+
+/* ---------------------------------------------
+ * Chebyshev Implementation of SUNLinearSolver
+ * --------------------------------------------- */
+
+struct _SUNLinearSolverContent_Chebyshev
+{
+  int degree;                /* number of Chebyshev iterations per solve  */
+  int maxeig;                /* number of Arnoldi iterations for bounds   */
+  int pretype;               /* type of preconditioning                   */
+  sunbooleantype zeroguess;  /* the initial guess is zero                 */
+  sunbooleantype user_eigs;  /* the bounds were supplied by the user      */
+  sunbooleantype eig_needed; /* the bounds must be estimated before use   */
+  sunrealtype lmin;          /* lower bound of the spectrum               */
+  sunrealtype lmax;          /* upper bound of the spectrum               */
+  int numiters;
+  int last_flag;
+
+  SUNATimesFn ATimes;
+  void* ATData;
+  SUNPSetupFn Psetup;
+  SUNPSolveFn Psolve;
+  void* PData;
+
+  N_Vector r;        /* residual                                      */
+  N_Vector d;        /* update direction                              */
+  N_Vector w;        /* ATimes and Psolve output                      */
+  N_Vector* V;       /* Arnoldi basis, allocated at first estimate    */
+  sunrealtype** H;   /* Arnoldi Hessenberg matrix                     */
+  sunrealtype* Hsym; /* symmetric part of the Hessenberg matrix       */
+};
+
+typedef struct _SUNLinearSolverContent_Chebyshev* SUNLinearSolverContent_Chebyshev;
+
+/* -------------------------------------------
+ * Exported Functions for SUNLINSOL_CHEBYSHEV
+ * ------------------------------------------- */
+
+SUNDIALS_EXPORT
+SUNLinearSolver SUNLinSol_Chebyshev(N_Vector y, int pretype, int degree,
+                                    SUNContext sunctx);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ChebyshevSetPrecType(SUNLinearSolver S, int pretype);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ChebyshevSetDegree(SUNLinearSolver S, int degree);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ChebyshevSetMaxEigIters(SUNLinearSolver S, int maxeig);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ChebyshevSetEigBounds(SUNLinearSolver S, sunrealtype lmin,
+                                           sunrealtype lmax);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ChebyshevGetEigBounds(SUNLinearSolver S,
+                                           sunrealtype* lmin,
+                                           sunrealtype* lmax);
+
+SUNDIALS_EXPORT
+int SUNLinSol_ChebyshevPrecSetup(void* P_data);
+
+SUNDIALS_EXPORT
+int SUNLinSol_ChebyshevPrecSolve(void* P_data, N_Vector r, N_Vector z,
+                                 sunrealtype tol, int lr);
+
+SUNDIALS_EXPORT
+SUNLinearSolver_Type SUNLinSolGetType_Chebyshev(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNLinearSolver_ID SUNLinSolGetID_Chebyshev(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolInitialize_Chebyshev(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolSetATimes_Chebyshev(SUNLinearSolver S, void* A_data,
+                                        SUNATimesFn ATimes);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolSetPreconditioner_Chebyshev(SUNLinearSolver S,
+                                                void* P_data, SUNPSetupFn Pset,
+                                                SUNPSolveFn Psol);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolSetZeroGuess_Chebyshev(SUNLinearSolver S,
+                                           sunbooleantype onoff);
+
+SUNDIALS_EXPORT
+int SUNLinSolSetup_Chebyshev(SUNLinearSolver S, SUNMatrix nul);
+
+SUNDIALS_EXPORT
+int SUNLinSolSolve_Chebyshev(SUNLinearSolver S, SUNMatrix nul, N_Vector x,
+                             N_Vector b, sunrealtype tol);
+
+SUNDIALS_EXPORT
+int SUNLinSolNumIters_Chebyshev(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+sunindextype SUNLinSolLastFlag_Chebyshev(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolSpace_Chebyshev(SUNLinearSolver S, long int* lenrwLS,
+                                    long int* leniwLS);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolFree_Chebyshev(SUNLinearSolver S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -48,6 +48,17 @@ struct _SUNLinearSolverContent_Dense
   sunindextype N;
   sunindextype* pivots;
   sunindextype last_flag;
+  int num_threads;
+  sunbooleantype mixed;
+  int max_refine;
+  sunbooleantype dfactored;
+  float* sdata;
+  float** scols;
+  sunrealtype* res;
+  sunrealtype rtol;
+  int last_refine;
+  long int num_refine;
+  long int num_fallback;
 };
 
 typedef struct _SUNLinearSolverContent_Dense* SUNLinearSolverContent_Dense;
@@ -59,6 +70,22 @@ typedef struct _SUNLinearSolverContent_Dense* SUNLinearSolverContent_Dense;
 SUNDIALS_EXPORT
 SUNLinearSolver SUNLinSol_Dense(N_Vector y, SUNMatrix A, SUNContext sunctx);
 
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_Dense_SetNumThreads(SUNLinearSolver S, int num_threads);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_Dense_SetMixedPrecision(SUNLinearSolver S,
+                                             sunbooleantype onoff,
+                                             int max_refine);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_Dense_GetNumRefinements(SUNLinearSolver S,
+                                             long int* num_refine);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_Dense_GetNumFallbacks(SUNLinearSolver S,
+                                           long int* num_fallback);
+
 SUNDIALS_EXPORT
 SUNLinearSolver_Type SUNLinSolGetType_Dense(SUNLinearSolver S);
 
@@ -75,6 +102,9 @@ SUNDIALS_EXPORT
 int SUNLinSolSolve_Dense(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
                          sunrealtype tol);
 
+SUNDIALS_EXPORT
+int SUNLinSolNumIters_Dense(SUNLinearSolver S);
+
 SUNDIALS_EXPORT
 sunindextype SUNLinSolLastFlag_Dense(SUNLinearSolver S);
 
@@ -0,0 +1,145 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the GCRO-DR implementation of the
+ * SUNLINSOL module, SUNLINSOL_GCRODR. The GCRO-DR method is a
+ * restarted GMRES method that keeps a subspace of approximate
+ * eigenvectors from one cycle, and from one solve, to the next
+ * and solves each system in the orthogonal complement of its
+ * image. The GCRO-DR algorithm is from
+ *
+ *   M. L. Parks, E. de Sturler, G. Mackey, D. D. Johnson and
+ *   S. Maiti, Recycling Krylov Subspaces for Sequences of Linear
+ *   Systems, SIAM J. Sci. Comput., 28(5):1651-1674, 2006.
+ *
+ * Notes:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ *   - The definition of the type 'sunrealtype' can be found in the
+ *     header file sundials_types.h, and it may be changed (at the
+ *     configuration stage) according to the user's needs.
+ *     The sundials_types.h file also contains the definition
+ *     for the type 'sunbooleantype'.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_GCRODR_H
+#define _SUNLINSOL_GCRODR_H
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Default GCRO-DR solver parameters */
+#define SUNGCRODR_MAXL_DEFAULT   10
+#define SUNGCRODR_KDIM_DEFAULT   4
+#define SUNGCRODR_MAXRS_DEFAULT  0
+#define SUNGCRODR_GSTYPE_DEFAULT SUN_MODIFIED_GS
+
+/* -----------------------------------------
+ * GCRO-DR Implementation of SUNLinearSolver
+ * ----------------------------------------- */
+
+struct _SUNLinearSolverContent_GCRODR
+{
+  int maxl;
+  int kdim;
+  int pretype;
+  int gstype;
+  sunbooleantype zeroguess;
+  int max_restarts;
+  int numiters;
+  sunrealtype resnorm;
+  int last_flag;
+
+  SUNATimesFn ATimes;
+  void* ATData;
+  SUNPSetupFn Psetup;
+  SUNPSolveFn Psolve;
+  void* PData;
+
+  N_Vector s1;
+  N_Vector s2;
+  N_Vector* V;
+  N_Vector* U;
+  N_Vector* Utmp;
+  N_Vector* Ctmp;
+  int nrecycled;
+  sunrealtype* dvals;
+  sunrealtype** Hes;
+  sunrealtype* Gcopy;
+  sunrealtype* givens;
+  N_Vector xcor;
+  sunrealtype* yg;
+  N_Vector vtemp;
+
+  sunrealtype* cv;
+  N_Vector* Xv;
+
+  sunrealtype* work;
+  sunrealtype** Eig;
+  sunindextype* pivots;
+};
+
+typedef struct _SUNLinearSolverContent_GCRODR* SUNLinearSolverContent_GCRODR;
+
+/* ----------------------------------------
+ * Exported Functions for SUNLINSOL_GCRODR
+ * ---------------------------------------- */
+
+SUNDIALS_EXPORT SUNLinearSolver SUNLinSol_GCRODR(N_Vector y, int pretype,
+                                                 int maxl, int kdim,
+                                                 SUNContext sunctx);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_GCRODRSetPrecType(SUNLinearSolver S,
+                                                       int pretype);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_GCRODRSetGSType(SUNLinearSolver S,
+                                                     int gstype);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_GCRODRSetMaxRestarts(SUNLinearSolver S,
+                                                          int maxrs);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_GCRODRGetNumRecycled(SUNLinearSolver S,
+                                                          int* nrecycled);
+SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_GCRODR(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_GCRODR(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNErrCode SUNLinSolInitialize_GCRODR(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNErrCode SUNLinSolSetATimes_GCRODR(SUNLinearSolver S,
+                                                     void* A_data,
+                                                     SUNATimesFn ATimes);
+SUNDIALS_EXPORT SUNErrCode SUNLinSolSetPreconditioner_GCRODR(SUNLinearSolver S,
+                                                             void* P_data,
+                                                             SUNPSetupFn Pset,
+                                                             SUNPSolveFn Psol);
+SUNDIALS_EXPORT SUNErrCode SUNLinSolSetScalingVectors_GCRODR(SUNLinearSolver S,
+                                                             N_Vector s1,
+                                                             N_Vector s2);
+SUNDIALS_EXPORT SUNErrCode SUNLinSolSetZeroGuess_GCRODR(SUNLinearSolver S,
+                                                        sunbooleantype onff);
+SUNDIALS_EXPORT int SUNLinSolSetup_GCRODR(SUNLinearSolver S, SUNMatrix A);
+SUNDIALS_EXPORT int SUNLinSolSolve_GCRODR(SUNLinearSolver S, SUNMatrix A,
+                                          N_Vector x, N_Vector b,
+                                          sunrealtype tol);
+SUNDIALS_EXPORT int SUNLinSolNumIters_GCRODR(SUNLinearSolver S);
+SUNDIALS_EXPORT sunrealtype SUNLinSolResNorm_GCRODR(SUNLinearSolver S);
+SUNDIALS_EXPORT N_Vector SUNLinSolResid_GCRODR(SUNLinearSolver S);
+SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_GCRODR(SUNLinearSolver S);
+SUNDIALS_EXPORT SUNErrCode SUNLinSolSpace_GCRODR(SUNLinearSolver S,
+                                                 long int* lenrwLS,
+                                                 long int* leniwLS);
+SUNDIALS_EXPORT SUNErrCode SUNLinSolFree_GCRODR(SUNLinearSolver S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,144 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the incomplete factorization
+ * implementation of the SUNLINSOL module, SUNLINSOL_ILU. It
+ * computes an ILU(k), point Jacobi, or block Jacobi factorization
+ * of a square SUNMATRIX_SPARSE matrix and applies it with level
+ * scheduled triangular solves. The solves are approximate, and the
+ * module is intended for use as a preconditioner.
+ *
+ * Notes:
+ *   - The definition of the generic SUNLinearSolver structure can
+ *     be found in the header file sundials_linearsolver.h.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNLINSOL_ILU_H
+#define _SUNLINSOL_ILU_H
+
+#include <sundials/sundials_linearsolver.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* types of incomplete factorization */
+#define SUN_ILU_JACOBI       0 /* inverse of the diagonal              */
+#define SUN_ILU_BLOCK_JACOBI 1 /* LU of the diagonal blocks            */
+#define SUN_ILU_ILUK         2 /* ILU with fill up to a level k        */
+
+/* Default ILU solver parameters */
+#define SUNILU_FILL_DEFAULT      0
+#define SUNILU_BLOCKSIZE_DEFAULT 1
+
+/* ----------------------------------------------------
+ * ILU Implementation of SUNLinearSolver
+ * ---------------------------------------------------- */
+
+struct _SUNLinearSolverContent_ILU
+{
+  int ilutype;            /* type of factorization                     */
+  int fill;               /* level of fill of ILU(k)                   */
+  sunindextype bs;        /* block size of block Jacobi                */
+  int num_threads;        /* number of OpenMP threads                  */
+  sunindextype N;         /* matrix dimension                          */
+  sunbooleantype current; /* the analysis matches the pattern of A     */
+
+  /* copy of the pattern of A used in the analysis */
+  int a_type;
+  sunindextype a_nnz;
+  sunindextype* a_ptrs;
+  sunindextype* a_vals;
+  sunindextype* amap; /* position of each entry of A in lu, or -1 */
+
+  /* factors in CSR format, unit lower L and upper U in one array */
+  sunindextype nnz;
+  sunindextype* rowptrs;
+  sunindextype* colind;
+  sunindextype* diag; /* position of the diagonal in each row */
+  sunrealtype* lu;
+
+  /* level schedules of the rows for the L and U solves */
+  sunindextype nlevL;
+  sunindextype* levptrL;
+  sunindextype* levrowsL;
+  sunindextype nlevU;
+  sunindextype* levptrU;
+  sunindextype* levrowsU;
+
+  sunindextype* iwork;    /* per thread row scatter arrays             */
+  sunindextype last_flag; /* last error return flag                    */
+};
+
+typedef struct _SUNLinearSolverContent_ILU* SUNLinearSolverContent_ILU;
+
+/* ---------------------------------------
+ * Exported Functions for SUNLINSOL_ILU
+ * --------------------------------------- */
+
+SUNDIALS_EXPORT
+SUNLinearSolver SUNLinSol_ILU(N_Vector y, SUNMatrix A, int ilutype,
+                              SUNContext sunctx);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ILUSetType(SUNLinearSolver S, int ilutype);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ILUSetFillLevel(SUNLinearSolver S, int fill);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ILUSetBlockSize(SUNLinearSolver S, sunindextype bs);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ILUSetNumThreads(SUNLinearSolver S, int num_threads);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ILUGetNumNonzeros(SUNLinearSolver S, sunindextype* nnz);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSol_ILUGetNumLevels(SUNLinearSolver S, sunindextype* nlevL,
+                                     sunindextype* nlevU);
+
+SUNDIALS_EXPORT
+SUNLinearSolver_Type SUNLinSolGetType_ILU(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNLinearSolver_ID SUNLinSolGetID_ILU(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolInitialize_ILU(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+int SUNLinSolSetup_ILU(SUNLinearSolver S, SUNMatrix A);
+
+SUNDIALS_EXPORT
+int SUNLinSolSolve_ILU(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
+                       sunrealtype tol);
+
+SUNDIALS_EXPORT
+sunindextype SUNLinSolLastFlag_ILU(SUNLinearSolver S);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolSpace_ILU(SUNLinearSolver S, long int* lenrwLS,
+                              long int* leniwLS);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNLinSolFree_ILU(SUNLinearSolver S);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
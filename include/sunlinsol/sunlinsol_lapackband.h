@@ -42,6 +42,17 @@ struct _SUNLinearSolverContent_LapackBand
   sunindextype N;
   sunindextype* pivots;
   sunindextype last_flag;
+  sunbooleantype mixed;
+  int max_refine;
+  sunbooleantype dfactored;
+  float* sdata;
+  float* swork;
+  sunindextype sldim;
+  sunrealtype* res;
+  sunrealtype rtol;
+  int last_refine;
+  long int num_refine;
+  long int num_fallback;
 };
 
 typedef struct _SUNLinearSolverContent_LapackBand* SUNLinearSolverContent_LapackBand;
@@ -52,6 +63,12 @@ typedef struct _SUNLinearSolverContent_LapackBand* SUNLinearSolverContent_Lapack
 
 SUNDIALS_EXPORT SUNLinearSolver SUNLinSol_LapackBand(N_Vector y, SUNMatrix A,
                                                      SUNContext sunctx);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_LapackBand_SetMixedPrecision(
+  SUNLinearSolver S, sunbooleantype onoff, int max_refine);
+SUNDIALS_EXPORT SUNErrCode
+SUNLinSol_LapackBand_GetNumRefinements(SUNLinearSolver S, long int* num_refine);
+SUNDIALS_EXPORT SUNErrCode
+SUNLinSol_LapackBand_GetNumFallbacks(SUNLinearSolver S, long int* num_fallback);
 SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_LapackBand(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_LapackBand(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNErrCode SUNLinSolInitialize_LapackBand(SUNLinearSolver S);
@@ -59,6 +76,7 @@ SUNDIALS_EXPORT int SUNLinSolSetup_LapackBand(SUNLinearSolver S, SUNMatrix A);
 SUNDIALS_EXPORT int SUNLinSolSolve_LapackBand(SUNLinearSolver S, SUNMatrix A,
                                               N_Vector x, N_Vector b,
                                               sunrealtype tol);
+SUNDIALS_EXPORT int SUNLinSolNumIters_LapackBand(SUNLinearSolver S);
 SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_LapackBand(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNErrCode SUNLinSolSpace_LapackBand(SUNLinearSolver S,
                                                      long int* lenrwLS,
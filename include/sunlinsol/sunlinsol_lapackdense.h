@@ -42,6 +42,16 @@ struct _SUNLinearSolverContent_LapackDense
   sunindextype N;
   sunindextype* pivots;
   sunindextype last_flag;
+  sunbooleantype mixed;
+  int max_refine;
+  sunbooleantype dfactored;
+  float* sdata;
+  float* swork;
+  sunrealtype* res;
+  sunrealtype rtol;
+  int last_refine;
+  long int num_refine;
+  long int num_fallback;
 };
 
 typedef struct _SUNLinearSolverContent_LapackDense* SUNLinearSolverContent_LapackDense;
@@ -52,6 +62,12 @@ typedef struct _SUNLinearSolverContent_LapackDense* SUNLinearSolverContent_Lapac
 
 SUNDIALS_EXPORT SUNLinearSolver SUNLinSol_LapackDense(N_Vector y, SUNMatrix A,
                                                       SUNContext sunctx);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_LapackDense_SetMixedPrecision(
+  SUNLinearSolver S, sunbooleantype onoff, int max_refine);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_LapackDense_GetNumRefinements(
+  SUNLinearSolver S, long int* num_refine);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_LapackDense_GetNumFallbacks(
+  SUNLinearSolver S, long int* num_fallback);
 SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_LapackDense(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_LapackDense(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNErrCode SUNLinSolInitialize_LapackDense(SUNLinearSolver S);
@@ -59,6 +75,7 @@ SUNDIALS_EXPORT int SUNLinSolSetup_LapackDense(SUNLinearSolver S, SUNMatrix A);
 SUNDIALS_EXPORT int SUNLinSolSolve_LapackDense(SUNLinearSolver S, SUNMatrix A,
                                                N_Vector x, N_Vector b,
                                                sunrealtype tol);
+SUNDIALS_EXPORT int SUNLinSolNumIters_LapackDense(SUNLinearSolver S);
 SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_LapackDense(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNErrCode SUNLinSolSpace_LapackDense(SUNLinearSolver S,
                                                       long int* lenrwLS,
@@ -41,6 +41,7 @@ extern "C" {
 #define SUNSPGMR_MAXL_DEFAULT   5
 #define SUNSPGMR_MAXRS_DEFAULT  0
 #define SUNSPGMR_GSTYPE_DEFAULT SUN_MODIFIED_GS
+#define SUNSPGMR_SSTEP_DEFAULT  1
 
 /* ----------------------------------------
  * SPGMR Implementation of SUNLinearSolver
@@ -74,6 +75,12 @@ struct _SUNLinearSolverContent_SPGMR
 
   sunrealtype* cv;
   N_Vector* Xv;
+
+  int sstep;
+  sunbooleantype newshifts;
+  sunrealtype* shifts;
+  sunrealtype* Hcopy;
+  sunrealtype* swork;
 };
 
 typedef struct _SUNLinearSolverContent_SPGMR* SUNLinearSolverContent_SPGMR;
@@ -90,6 +97,8 @@ SUNDIALS_EXPORT SUNErrCode SUNLinSol_SPGMRSetGSType(SUNLinearSolver S,
                                                     int gstype);
 SUNDIALS_EXPORT SUNErrCode SUNLinSol_SPGMRSetMaxRestarts(SUNLinearSolver S,
                                                          int maxrs);
+SUNDIALS_EXPORT SUNErrCode SUNLinSol_SPGMRSetSStep(SUNLinearSolver S,
+                                                   int sstep);
 SUNDIALS_EXPORT SUNLinearSolver_Type SUNLinSolGetType_SPGMR(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNLinearSolver_ID SUNLinSolGetID_SPGMR(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNErrCode SUNLinSolInitialize_SPGMR(SUNLinearSolver S);
@@ -0,0 +1,195 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the block sparse implementation of
+ * the SUNMATRIX module, SUNMATRIX_BLOCKSPARSE.
+ *
+ * Notes:
+ *   - The matrix is made of dense bs by bs blocks on a sparse
+ *     pattern of M block rows and N block columns, stored in
+ *     block compressed-sparse-row (BSR) format. Each block is
+ *     stored in column-major order.
+ *   - The definition of the generic SUNMatrix structure can be found
+ *     in the header file sundials_matrix.h.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _SUNMATRIX_BLOCKSPARSE_H
+#define _SUNMATRIX_BLOCKSPARSE_H
+
+#include <stdio.h>
+#include <sundials/sundials_matrix.h>
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* ------------------------------------------------------
+ * Block Sparse Implementation of SUNMATRIX_BLOCKSPARSE
+ * ------------------------------------------------------ */
+
+struct _SUNMatrixContent_BlockSparse
+{
+  sunindextype M;        /* number of block rows                  */
+  sunindextype N;        /* number of block columns               */
+  sunindextype bs;       /* block size                            */
+  sunindextype NNZB;     /* number of blocks allocated            */
+  sunrealtype* data;     /* blocks, each bs*bs in column-major    */
+  sunindextype* colind;  /* block column of each block            */
+  sunindextype* rowptrs; /* first block of each block row         */
+  /* cached positions of the diagonal blocks */
+  sunindextype* diag;
+  /* block-Jacobi preconditioner */
+  sunrealtype* bdiag;    /* LU factors of the diagonal blocks     */
+  sunrealtype** bcols;   /* columns of the factors                */
+  sunindextype* bpivots; /* pivots of the factors                 */
+};
+
+typedef struct _SUNMatrixContent_BlockSparse* SUNMatrixContent_BlockSparse;
+
+/* --------------------------------------------
+ * Macros for access to SUNMATRIX_BLOCKSPARSE
+ * -------------------------------------------- */
+
+#define SM_CONTENT_BS(A) ((SUNMatrixContent_BlockSparse)(A->content))
+
+#define SM_BLOCKROWS_BS(A) (SM_CONTENT_BS(A)->M)
+
+#define SM_BLOCKCOLS_BS(A) (SM_CONTENT_BS(A)->N)
+
+#define SM_BLOCKSIZE_BS(A) (SM_CONTENT_BS(A)->bs)
+
+#define SM_NNZB_BS(A) (SM_CONTENT_BS(A)->NNZB)
+
+#define SM_DATA_BS(A) (SM_CONTENT_BS(A)->data)
+
+#define SM_COLIND_BS(A) (SM_CONTENT_BS(A)->colind)
+
+#define SM_ROWPTRS_BS(A) (SM_CONTENT_BS(A)->rowptrs)
+
+#define SM_BLOCK_BS(A, k) \
+  (SM_DATA_BS(A) + (k) * SM_BLOCKSIZE_BS(A) * SM_BLOCKSIZE_BS(A))
+
+#define SM_BLOCK_ELEMENT_BS(A, k, i, j) \
+  (SM_BLOCK_BS(A, k)[(j) * SM_BLOCKSIZE_BS(A) + (i)])
+
+/* -------------------------------------------------------------
+ * Function type for the block difference quotient Jacobian,
+ * fy = f(y)
+ * ------------------------------------------------------------- */
+
+typedef int (*SUNBlockSparseFn)(N_Vector y, N_Vector fy, void* user_data);
+
+/* ---------------------------------------------
+ * Exported Functions for SUNMATRIX_BLOCKSPARSE
+ * --------------------------------------------- */
+
+SUNDIALS_EXPORT
+SUNMatrix SUNBlockSparseMatrix(sunindextype M, sunindextype N,
+                               sunindextype bs, sunindextype NNZB,
+                               SUNContext sunctx);
+
+SUNDIALS_EXPORT
+SUNMatrix SUNBlockSparseFromDenseMatrix(SUNMatrix A, sunindextype bs,
+                                        sunrealtype droptol);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNBlockSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZB);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNBlockSparseMatrix_ToSparse(SUNMatrix A, int sparsetype,
+                                         SUNMatrix* Bout);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNBlockSparseMatrix_CopyToSparse(SUNMatrix A, SUNMatrix B);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNBlockSparseMatrix_ColorBlockColumns(SUNMatrix A,
+                                                  sunindextype* colors,
+                                                  sunindextype* ncolors);
+
+SUNDIALS_EXPORT
+int SUNBlockSparseMatrix_DQJacobian(SUNMatrix J, SUNBlockSparseFn f,
+                                    void* user_data, N_Vector y, N_Vector fy,
+                                    N_Vector w, N_Vector tmp1, N_Vector tmp2);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNBlockSparseMatrix_FactorBlockDiagonal(SUNMatrix A);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNBlockSparseMatrix_SolveBlockDiagonal(SUNMatrix A, N_Vector x,
+                                                   N_Vector b);
+
+SUNDIALS_EXPORT
+void SUNBlockSparseMatrix_Print(SUNMatrix A, FILE* outfile);
+
+SUNDIALS_EXPORT
+sunindextype SUNBlockSparseMatrix_Rows(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunindextype SUNBlockSparseMatrix_Columns(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunindextype SUNBlockSparseMatrix_BlockRows(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunindextype SUNBlockSparseMatrix_BlockColumns(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunindextype SUNBlockSparseMatrix_BlockSize(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunindextype SUNBlockSparseMatrix_NNZB(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunrealtype* SUNBlockSparseMatrix_Data(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunindextype* SUNBlockSparseMatrix_ColumnIndices(SUNMatrix A);
+
+SUNDIALS_EXPORT
+sunindextype* SUNBlockSparseMatrix_RowPointers(SUNMatrix A);
+
+SUNDIALS_EXPORT
+SUNMatrix_ID SUNMatGetID_BlockSparse(SUNMatrix A);
+
+SUNDIALS_EXPORT
+SUNMatrix SUNMatClone_BlockSparse(SUNMatrix A);
+
+SUNDIALS_EXPORT
+void SUNMatDestroy_BlockSparse(SUNMatrix A);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMatZero_BlockSparse(SUNMatrix A);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMatCopy_BlockSparse(SUNMatrix A, SUNMatrix B);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMatScaleAdd_BlockSparse(sunrealtype c, SUNMatrix A, SUNMatrix B);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMatScaleAddI_BlockSparse(sunrealtype c, SUNMatrix A);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMatMatvec_BlockSparse(SUNMatrix A, N_Vector x, N_Vector y);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMatSpace_BlockSparse(SUNMatrix A, long int* lenrw,
+                                   long int* leniw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -70,6 +70,15 @@ struct _SUNMatrixContent_Sparse
   /* CSR indices */
   sunindextype** colvals;
   sunindextype** rowptrs;
+  /* cached positions of the diagonal entries */
+  sunindextype* diag;
+  /* threaded matrix-vector product */
+  int num_threads;         /* number of OpenMP threads              */
+  sunindextype* csrptrs;   /* CSR view of a CSC matrix: row ptrs,   */
+  sunindextype* csrvals;   /* column indices, and the positions of  */
+  sunindextype* csrperm;   /* the entries in data                   */
+  sunindextype* rowpart;   /* first row of each thread              */
+  sunbooleantype csrvalid; /* CSR view and row partition are valid  */
 };
 
 typedef struct _SUNMatrixContent_Sparse* SUNMatrixContent_Sparse;
@@ -124,6 +133,16 @@ SUNErrCode SUNSparseMatrix_Realloc(SUNMatrix A);
 SUNDIALS_EXPORT
 SUNErrCode SUNSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZ);
 
+SUNDIALS_EXPORT
+SUNErrCode SUNSparseMatrix_InsertDiagonal(SUNMatrix A);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNSparseMatrix_SetNumThreads(SUNMatrix A, int num_threads);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNSparseMatrix_ColorColumns(SUNMatrix A, sunindextype* colors,
+                                        sunindextype* ncolors);
+
 SUNDIALS_EXPORT
 void SUNSparseMatrix_Print(SUNMatrix A, FILE* outfile);
 
@@ -0,0 +1,91 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SUNDIALS pooling memory helper header file. Host memory is
+ * recycled through size class free lists, other memory types are
+ * passed to an optional upstream helper.
+ * ----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_POOLMEMORY_H
+#define _SUNDIALS_POOLMEMORY_H
+
+#include <sundials/sundials_memory.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Default alignment of the host allocations in bytes */
+#define SUNMEMORY_POOL_DEFAULT_ALIGNMENT 64
+
+/* Implementation specific functions */
+
+SUNDIALS_EXPORT
+SUNMemoryHelper SUNMemoryHelper_Pool(SUNMemoryHelper upstream,
+                                     SUNContext sunctx);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_SetAlignment_Pool(SUNMemoryHelper helper,
+                                             size_t alignment);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_SetMaxCachedBytes_Pool(SUNMemoryHelper helper,
+                                                  size_t max_cached);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_Release_Pool(SUNMemoryHelper helper);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_GetPoolStats_Pool(SUNMemoryHelper helper,
+                                             unsigned long* num_hits,
+                                             unsigned long* num_misses,
+                                             size_t* bytes_cached);
+
+/* SUNMemoryHelper functions */
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_Alloc_Pool(SUNMemoryHelper helper, SUNMemory* memptr,
+                                      size_t mem_size, SUNMemoryType mem_type,
+                                      void* queue);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_Dealloc_Pool(SUNMemoryHelper helper, SUNMemory mem,
+                                        void* queue);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_Copy_Pool(SUNMemoryHelper helper, SUNMemory dst,
+                                     SUNMemory src, size_t memory_size,
+                                     void* queue);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_CopyAsync_Pool(SUNMemoryHelper helper, SUNMemory dst,
+                                          SUNMemory src, size_t memory_size,
+                                          void* queue);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_GetAllocStats_Pool(SUNMemoryHelper helper,
+                                              SUNMemoryType mem_type,
+                                              unsigned long* num_allocations,
+                                              unsigned long* num_deallocations,
+                                              size_t* bytes_allocated,
+                                              size_t* bytes_high_watermark);
+
+SUNDIALS_EXPORT
+SUNMemoryHelper SUNMemoryHelper_Clone_Pool(SUNMemoryHelper helper);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNMemoryHelper_Destroy_Pool(SUNMemoryHelper helper);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
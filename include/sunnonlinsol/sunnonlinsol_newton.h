@@ -30,6 +30,12 @@
 extern "C" {
 #endif
 
+/* Default Eisenstat-Walker forcing term parameters */
+#define SUNNEWTON_ETA_MIN   SUN_RCONST(1.0e-4)
+#define SUNNEWTON_ETA_MAX   SUN_RCONST(0.9)
+#define SUNNEWTON_ETA_GAMMA SUN_RCONST(0.9)
+#define SUNNEWTON_ETA_ALPHA SUN_RCONST(2.0)
+
 /* -----------------------------------------------------------------------------
  * I. Content structure
  * ---------------------------------------------------------------------------*/
@@ -51,6 +57,14 @@ struct _SUNNonlinearSolverContent_Newton
   long int nconvfails; /* total number of convergence failures across all solves
                         */
   void* ctest_data; /* data to pass to convergence test function              */
+
+  /* inexact Newton forcing term variables */
+  sunbooleantype forcing; /* compute the Eisenstat-Walker forcing term      */
+  sunrealtype eta;        /* forcing term for the current iteration         */
+  sunrealtype eta_init;   /* forcing term for the first iteration           */
+  sunrealtype eta_gamma;  /* forcing term scaling factor                    */
+  sunrealtype eta_alpha;  /* forcing term power                             */
+  sunrealtype fnorm;      /* WRMS norm of the previous nonlinear residual   */
 };
 
 typedef struct _SUNNonlinearSolverContent_Newton* SUNNonlinearSolverContent_Newton;
@@ -103,6 +117,16 @@ SUNErrCode SUNNonlinSolSetConvTestFn_Newton(SUNNonlinearSolver NLS,
 SUNDIALS_EXPORT
 SUNErrCode SUNNonlinSolSetMaxIters_Newton(SUNNonlinearSolver NLS, int maxiters);
 
+SUNDIALS_EXPORT
+SUNErrCode SUNNonlinSolSetForcingTerm_Newton(SUNNonlinearSolver NLS,
+                                             sunbooleantype onoff);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNNonlinSolSetForcingParams_Newton(SUNNonlinearSolver NLS,
+                                               sunrealtype eta_init,
+                                               sunrealtype gamma,
+                                               sunrealtype alpha);
+
 /* get functions */
 SUNDIALS_EXPORT
 SUNErrCode SUNNonlinSolGetNumIters_Newton(SUNNonlinearSolver NLS,
@@ -115,6 +139,10 @@ SUNDIALS_EXPORT
 SUNErrCode SUNNonlinSolGetNumConvFails_Newton(SUNNonlinearSolver NLS,
                                               long int* nconvfails);
 
+SUNDIALS_EXPORT
+SUNErrCode SUNNonlinSolGetForcingTerm_Newton(SUNNonlinearSolver NLS,
+                                             sunrealtype* eta);
+
 SUNDIALS_EXPORT
 SUNErrCode SUNNonlinSolGetSysFn_Newton(SUNNonlinearSolver NLS,
                                        SUNNonlinSolSysFn* SysFn);
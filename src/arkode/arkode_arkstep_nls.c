@@ -507,6 +507,7 @@ int arkStep_NlsLSolve(N_Vector b, void* arkode_mem)
   ARKodeMem ark_mem;
   ARKodeARKStepMem step_mem;
   int retval, nonlin_iter;
+  sunrealtype eta;
 
   /* access ARKodeMem and ARKodeARKStepMem structures */
   retval = arkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem, &step_mem);
@@ -516,10 +517,15 @@ int arkStep_NlsLSolve(N_Vector b, void* arkode_mem)
   retval = SUNNonlinSolGetCurIter(step_mem->NLS, &nonlin_iter);
   if (retval != SUN_SUCCESS) { return (ARK_NLS_OP_ERR); }
 
+  /* retrieve the forcing term for the linear solve from module, the
+     tolerance is not relaxed if it is unavailable */
+  retval = SUNNonlinSolGetForcingTerm(step_mem->NLS, &eta);
+  if (retval != SUN_SUCCESS) { eta = ZERO; }
+
   /* call linear solver interface, and handle return value */
   retval = step_mem->lsolve(ark_mem, b, ark_mem->tcur, ark_mem->ycur,
                             step_mem->Fi[step_mem->istage], step_mem->eRNrm,
-                            nonlin_iter);
+                            eta, nonlin_iter);
 
   if (retval < 0) { return (ARK_LSOLVE_FAIL); }
   if (retval > 0) { return (CONV_FAIL); }
@@ -195,7 +195,8 @@ typedef int (*ARKLinsolSetupFn)(ARKodeMem ark_mem, int convfail,
                                 N_Vector vtemp2, N_Vector vtemp3);
 typedef int (*ARKLinsolSolveFn)(ARKodeMem ark_mem, N_Vector b, sunrealtype tcur,
                                 N_Vector ycur, N_Vector fcur,
-                                sunrealtype client_tol, int mnewt);
+                                sunrealtype client_tol, sunrealtype client_eta,
+                                int mnewt);
 typedef int (*ARKLinsolFreeFn)(ARKodeMem ark_mem);
 
 /* mass matrix solver interface functions */
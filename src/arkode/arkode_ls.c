@@ -1054,6 +1054,97 @@ int ARKodeSetLinSysFn(void* arkode_mem, ARKLsLinSysFn linsys)
   return (ARKLS_SUCCESS);
 }
 
+/* ARKodeSetJacSparsityPattern specifies the nonzero pattern used by the
+   internal sparse difference quotient Jacobian. A NULL pattern clears any
+   stored pattern so that it is probed on the next Jacobian evaluation. */
+int ARKodeSetJacSparsityPattern(void* arkode_mem, SUNMatrix Jpattern)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  SUNMatrix Jpat;
+  int retval;
+
+  /* Return immediately if arkode_mem is NULL */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Guard against use for time steppers that do not need an algebraic solver */
+  if (!ark_mem->step_supports_implicit)
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, "time-stepping module does not require an algebraic solver");
+    return (ARK_STEPPER_UNSUPPORTED);
+  }
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(ark_mem, __func__, &arkls_mem);
+  if (retval != ARKLS_SUCCESS) { return (retval); }
+
+  /* a pattern can only be used with a sparse linear system matrix */
+  if ((arkls_mem->A == NULL) || (SUNMatGetID(arkls_mem->A) != SUNMATRIX_SPARSE))
+  {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "A sparsity pattern requires a sparse SUNMatrix");
+    return (ARKLS_ILL_INPUT);
+  }
+
+  /* copy the pattern in the storage format of A */
+  Jpat = NULL;
+  if (Jpattern != NULL)
+  {
+    if ((SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+        (SUNSparseMatrix_Rows(Jpattern) !=
+         SUNSparseMatrix_Rows(arkls_mem->A)) ||
+        (SUNSparseMatrix_Columns(Jpattern) !=
+         SUNSparseMatrix_Columns(arkls_mem->A)))
+    {
+      arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "The sparsity pattern is incompatible with the SUNMatrix");
+      return (ARKLS_ILL_INPUT);
+    }
+
+    if (SUNSparseMatrix_SparseType(Jpattern) ==
+        SUNSparseMatrix_SparseType(arkls_mem->A))
+    {
+      Jpat = SUNMatClone(Jpattern);
+      if (Jpat != NULL && SUNMatCopy(Jpattern, Jpat))
+      {
+        SUNMatDestroy(Jpat);
+        Jpat = NULL;
+      }
+    }
+    else if (SUNSparseMatrix_SparseType(arkls_mem->A) == CSC_MAT)
+    {
+      if (SUNSparseMatrix_ToCSC(Jpattern, &Jpat)) { Jpat = NULL; }
+    }
+    else if (SUNSparseMatrix_ToCSR(Jpattern, &Jpat)) { Jpat = NULL; }
+
+    if (Jpat == NULL)
+    {
+      arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (ARKLS_MEM_FAIL);
+    }
+  }
+
+  /* replace the stored pattern and invalidate the column coloring */
+  if (arkls_mem->Jpat) { SUNMatDestroy(arkls_mem->Jpat); }
+  arkls_mem->Jpat = Jpat;
+  if (arkls_mem->colors)
+  {
+    free(arkls_mem->colors);
+    arkls_mem->colors = NULL;
+  }
+  arkls_mem->ncolors = 0;
+
+  return (ARKLS_SUCCESS);
+}
+
 int ARKodeGetJac(void* arkode_mem, SUNMatrix* J)
 {
   ARKodeMem ark_mem;
@@ -2542,13 +2633,12 @@ int arkLsMPSolve(void* arkode_mem, N_Vector r, N_Vector z, sunrealtype tol, int
 /*---------------------------------------------------------------
   arkLsDQJac:
 
-  This routine is a wrapper for the Dense and Band
+  This routine is a wrapper for the Dense, Band and Sparse
   implementations of the difference quotient Jacobian
   approximation routines.
   ---------------------------------------------------------------*/
 int arkLsDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
-               void* arkode_mem, N_Vector tmp1, N_Vector tmp2,
-               SUNDIALS_MAYBE_UNUSED N_Vector tmp3)
+               void* arkode_mem, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
 {
   ARKodeMem ark_mem;
   ARKLsMem arkls_mem;
@@ -2599,6 +2689,11 @@ int arkLsDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   {
     retval = arkLsBandDQJac(t, y, fy, Jac, ark_mem, arkls_mem, fi, tmp1, tmp2);
   }
+  else if (SUNMatGetID(Jac) == SUNMATRIX_SPARSE)
+  {
+    retval = arkLsSparseDQJac(t, y, fy, Jac, ark_mem, arkls_mem, fi, tmp1, tmp2,
+                              tmp3);
+  }
   else
   {
     arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
@@ -2813,6 +2908,335 @@ int arkLsBandDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   return (retval);
 }
 
+/*---------------------------------------------------------------
+  arkLsSparseDQJac:
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of fi(t,y) with the column grouping of Curtis,
+  Powell and Reid. Columns that do not share a nonzero row are
+  given the same color by SUNSparseMatrix_ColorColumns and are
+  perturbed together, so each fi evaluation fills every column of
+  one color. The nonzero pattern is either supplied through
+  ARKodeSetJacSparsityPattern or probed on the first call (see
+  arkLsSparseDQPattern), and the coloring is computed once and
+  reused until the pattern changes. The difference quotients are
+  formed by arkLsColoredDQJac.
+  ---------------------------------------------------------------*/
+int arkLsSparseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                     ARKodeMem ark_mem, ARKLsMem arkls_mem, ARKRhsFn fi,
+                     N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  sunindextype N;
+  int retval = 0;
+
+  /* access matrix dimension */
+  N = SUNSparseMatrix_Columns(Jac);
+
+  /* Probe the nonzero pattern if one was not supplied */
+  if (arkls_mem->Jpat == NULL)
+  {
+    retval = arkLsSparseDQPattern(t, y, fy, Jac, ark_mem, arkls_mem, fi, tmp1,
+                                  tmp2);
+    if (retval != 0) { return (retval); }
+  }
+
+  /* Color the columns of the pattern */
+  if (arkls_mem->colors == NULL)
+  {
+    arkls_mem->colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+    if (arkls_mem->colors == NULL)
+    {
+      arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (ARKLS_MEM_FAIL);
+    }
+    if (SUNSparseMatrix_ColorColumns(arkls_mem->Jpat, arkls_mem->colors,
+                                     &arkls_mem->ncolors))
+    {
+      free(arkls_mem->colors);
+      arkls_mem->colors = NULL;
+      arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_SUNMAT_FAILED);
+      return (ARKLS_SUNMAT_FAIL);
+    }
+  }
+
+  /* Load the pattern into Jac, every stored entry is overwritten */
+  if (SUNMatCopy(arkls_mem->Jpat, Jac))
+  {
+    arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_SUNMAT_FAILED);
+    return (ARKLS_SUNMAT_FAIL);
+  }
+
+  return (arkLsColoredDQJac(t, y, fy, Jac, arkls_mem->colors,
+                            arkls_mem->ncolors, ark_mem, fi, tmp1, tmp2, tmp3,
+                            &arkls_mem->nfeDQ));
+}
+
+/*---------------------------------------------------------------
+  arkLsColoredDQJac:
+
+  This routine overwrites the entries of the sparse matrix Jac,
+  which holds the Jacobian pattern, with difference quotients of
+  fi(t,y). The columns given the same color are perturbed together
+  and the fi evaluations are counted in nfe. It is shared by
+  arkLsSparseDQJac and the sparse preconditioner
+  (arkode_sparsepre.c). The work vectors hold the perturbed fi
+  (ftemp), the perturbed y (ytemp), and the column increments
+  (incs).
+  ---------------------------------------------------------------*/
+int arkLsColoredDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                      const sunindextype* colors, sunindextype ncolors,
+                      ARKodeMem ark_mem, ARKRhsFn fi, N_Vector ftemp,
+                      N_Vector ytemp, N_Vector incs, long int* nfe)
+{
+  sunrealtype fnorm, minInc, inc, srur, conj;
+  sunrealtype *ewt_data, *fy_data, *ftemp_data, *y_data, *ytemp_data;
+  sunrealtype *inc_data, *cns_data, *J_data;
+  sunindextype *J_ptrs, *J_vals;
+  sunindextype c, i, j, k, N;
+  int retval = 0;
+
+  N      = SUNSparseMatrix_Columns(Jac);
+  J_data = SUNSparseMatrix_Data(Jac);
+  J_ptrs = SUNSparseMatrix_IndexPointers(Jac);
+  J_vals = SUNSparseMatrix_IndexValues(Jac);
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp, increments */
+  ewt_data   = N_VGetArrayPointer(ark_mem->ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  inc_data   = N_VGetArrayPointer(incs);
+  cns_data = (ark_mem->constraintsSet) ? N_VGetArrayPointer(ark_mem->constraints)
+                                       : NULL;
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur   = SUNRsqrt(ark_mem->uround);
+  fnorm  = N_VWrmsNorm(fy, ark_mem->rwt);
+  minInc = (fnorm != ZERO)
+             ? (MIN_INC_MULT * SUNRabs(ark_mem->h) * ark_mem->uround * N * fnorm)
+             : ONE;
+
+  /* Compute the increment for each column */
+  for (j = 0; j < N; j++)
+  {
+    inc = SUNMAX(srur * SUNRabs(y_data[j]), minInc / ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (ark_mem->constraintsSet)
+    {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)
+      {
+        if ((y_data[j] + inc) * conj < ZERO) { inc = -inc; }
+      }
+      else if (SUNRabs(conj) == TWO)
+      {
+        if ((y_data[j] + inc) * conj <= ZERO) { inc = -inc; }
+      }
+    }
+
+    inc_data[j] = inc;
+  }
+
+  /* Loop over column colors. */
+  for (c = 0; c < ncolors; c++)
+  {
+    /* Increment all y_j with color c */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] == c) { ytemp_data[j] += inc_data[j]; }
+    }
+
+    /* Evaluate fi with incremented y */
+    retval = fi(t, ytemp, ftemp, ark_mem->user_data);
+    (*nfe)++;
+    if (retval != 0) { break; }
+
+    /* Restore ytemp, then form and load difference quotients */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] == c) { ytemp_data[j] = y_data[j]; }
+    }
+
+    if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT)
+    {
+      for (j = 0; j < N; j++)
+      {
+        if (colors[j] != c) { continue; }
+        for (k = J_ptrs[j]; k < J_ptrs[j + 1]; k++)
+        {
+          i         = J_vals[k];
+          J_data[k] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+        }
+      }
+    }
+    else
+    {
+      for (i = 0; i < N; i++)
+      {
+        for (k = J_ptrs[i]; k < J_ptrs[i + 1]; k++)
+        {
+          j = J_vals[k];
+          if (colors[j] == c)
+          {
+            J_data[k] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+          }
+        }
+      }
+    }
+  }
+
+  return (retval);
+}
+
+/*---------------------------------------------------------------
+  arkLsSparseDQPattern:
+
+  This routine determines the nonzero pattern of the Jacobian of
+  fi(t,y) when none was supplied, by perturbing one column at a
+  time and recording the rows of fi that change (N evaluations
+  of fi, counted in nfeDQ). The diagonal is always included. Entries
+  that happen to vanish at the probed state are missed, so the
+  pattern should be supplied with ARKodeSetJacSparsityPattern when
+  this is a concern. The pattern is stored in the format of Jac.
+  ---------------------------------------------------------------*/
+int arkLsSparseDQPattern(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                         ARKodeMem ark_mem, ARKLsMem arkls_mem, ARKRhsFn fi,
+                         N_Vector tmp1, N_Vector tmp2)
+{
+  N_Vector ftemp, ytemp;
+  SUNMatrix Jcsc, Jcsr;
+  sunrealtype fnorm, minInc, inc, srur, conj;
+  sunrealtype *ewt_data, *fy_data, *ftemp_data, *y_data, *ytemp_data;
+  sunrealtype *cns_data, *P_data;
+  sunindextype *colptrs, *rowvals;
+  sunindextype i, j, N, nnz, nz;
+  int retval = 0;
+
+  /* access matrix dimension and create the pattern in CSC format */
+  N    = SUNSparseMatrix_Columns(Jac);
+  nnz  = SUNMAX(SUNSparseMatrix_NNZ(Jac), N);
+  Jcsc = SUNSparseMatrix(N, N, nnz, CSC_MAT, ark_mem->sunctx);
+  if (Jcsc == NULL)
+  {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_MEM_FAIL);
+    return (ARKLS_MEM_FAIL);
+  }
+  colptrs = SUNSparseMatrix_IndexPointers(Jcsc);
+  rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+  P_data  = SUNSparseMatrix_Data(Jcsc);
+
+  /* Rename work vectors for use as temporary values of y and f */
+  ftemp = tmp1;
+  ytemp = tmp2;
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp */
+  ewt_data   = N_VGetArrayPointer(ark_mem->ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  cns_data = (ark_mem->constraintsSet) ? N_VGetArrayPointer(ark_mem->constraints)
+                                       : NULL;
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur   = SUNRsqrt(ark_mem->uround);
+  fnorm  = N_VWrmsNorm(fy, ark_mem->rwt);
+  minInc = (fnorm != ZERO)
+             ? (MIN_INC_MULT * SUNRabs(ark_mem->h) * ark_mem->uround * N * fnorm)
+             : ONE;
+
+  nz = 0;
+  for (j = 0; j < N; j++)
+  {
+    inc = SUNMAX(srur * SUNRabs(y_data[j]), minInc / ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (ark_mem->constraintsSet)
+    {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)
+      {
+        if ((y_data[j] + inc) * conj < ZERO) { inc = -inc; }
+      }
+      else if (SUNRabs(conj) == TWO)
+      {
+        if ((y_data[j] + inc) * conj <= ZERO) { inc = -inc; }
+      }
+    }
+
+    /* Evaluate fi with incremented y_j */
+    ytemp_data[j] += inc;
+    retval = fi(t, ytemp, ftemp, ark_mem->user_data);
+    arkls_mem->nfeDQ++;
+    if (retval != 0) { break; }
+    ytemp_data[j] = y_data[j];
+
+    /* Record the rows of fi that depend on y_j */
+    colptrs[j] = nz;
+    for (i = 0; i < N; i++)
+    {
+      if ((i != j) && (ftemp_data[i] == fy_data[i])) { continue; }
+      if (nz == nnz)
+      {
+        nnz *= 2;
+        if (SUNSparseMatrix_Reallocate(Jcsc, nnz))
+        {
+          retval = ARKLS_MEM_FAIL;
+          break;
+        }
+        rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+        P_data  = SUNSparseMatrix_Data(Jcsc);
+      }
+      rowvals[nz] = i;
+      P_data[nz]  = ONE;
+      nz++;
+    }
+    if (retval != 0) { break; }
+  }
+  colptrs[N] = nz;
+
+  if (retval == ARKLS_MEM_FAIL)
+  {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_MEM_FAIL);
+  }
+  if (retval != 0)
+  {
+    SUNMatDestroy(Jcsc);
+    return (retval);
+  }
+
+  /* Store the pattern in the format of Jac */
+  if (SUNSparseMatrix_SparseType(Jac) == CSR_MAT)
+  {
+    Jcsr   = NULL;
+    retval = SUNSparseMatrix_ToCSR(Jcsc, &Jcsr);
+    SUNMatDestroy(Jcsc);
+    if (retval != 0 || Jcsr == NULL)
+    {
+      arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (ARKLS_MEM_FAIL);
+    }
+    arkls_mem->Jpat = Jcsr;
+  }
+  else { arkls_mem->Jpat = Jcsc; }
+
+  return (0);
+}
+
 /*---------------------------------------------------------------
   arkLsDQJtimes:
 
@@ -2995,13 +3419,14 @@ int arkLsInitialize(ARKodeMem ark_mem)
       /* Check if an internal or user-supplied Jacobian function is used */
       if (arkls_mem->jacDQ)
       {
-        /* Internal difference quotient Jacobian. Check that A is dense or band,
-           otherwise return an error */
+        /* Internal difference quotient Jacobian. Check that A is dense, band
+           or sparse, otherwise return an error */
         retval = 0;
         if (arkls_mem->A->ops->getid)
         {
           if ((SUNMatGetID(arkls_mem->A) == SUNMATRIX_DENSE) ||
-              (SUNMatGetID(arkls_mem->A) == SUNMATRIX_BAND))
+              (SUNMatGetID(arkls_mem->A) == SUNMATRIX_BAND) ||
+              (SUNMatGetID(arkls_mem->A) == SUNMATRIX_SPARSE))
           {
             arkls_mem->jac    = arkLsDQJac;
             arkls_mem->J_data = ark_mem;
@@ -3286,9 +3711,13 @@ int arkLsSetup(ARKodeMem ark_mem, int convfail, sunrealtype tpred,
 
   When using a non-NULL SUNMatrix, this will additionally scale
   the solution appropriately when gamrat != 1.
+
+  When the nonlinear solver supplies a positive forcing term eta,
+  the tolerance eplifac*eRNrm is relaxed to eta*||b||, but never
+  beyond the nonlinear solver tolerance eRNrm itself.
   ---------------------------------------------------------------*/
 int arkLsSolve(ARKodeMem ark_mem, N_Vector b, sunrealtype tnow, N_Vector ynow,
-               N_Vector fnow, sunrealtype eRNrm, int mnewt)
+               N_Vector fnow, sunrealtype eRNrm, sunrealtype eta, int mnewt)
 {
   sunrealtype bnorm, resnorm;
   ARKLsMem arkls_mem;
@@ -3320,6 +3749,9 @@ int arkLsSolve(ARKodeMem ark_mem, N_Vector b, sunrealtype tnow, N_Vector ynow,
       arkls_mem->last_flag = ARKLS_SUCCESS;
       return (arkls_mem->last_flag);
     }
+    /* Relax the tolerance to the nonlinear solver forcing term, if any,
+       limited by the nonlinear solver tolerance */
+    deltar = SUNMAX(deltar, SUNMIN(eta * bnorm, eRNrm));
     /* Adjust tolerance for 2-norm */
     delta = deltar * arkls_mem->nrmfac;
   }
@@ -3512,6 +3944,18 @@ int arkLsFree(ARKodeMem ark_mem)
     arkls_mem->savedJ = NULL;
   }
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (arkls_mem->Jpat)
+  {
+    SUNMatDestroy(arkls_mem->Jpat);
+    arkls_mem->Jpat = NULL;
+  }
+  if (arkls_mem->colors)
+  {
+    free(arkls_mem->colors);
+    arkls_mem->colors = NULL;
+  }
+
   /* Nullify other N_Vector pointers */
   arkls_mem->ycur = NULL;
   arkls_mem->fcur = NULL;
@@ -72,6 +72,11 @@ typedef struct ARKLsMemRec
   N_Vector ycur;      /* ptr to current y vector in ARKLs solve        */
   N_Vector fcur;      /* ptr to current fcur = fI(tcur, ycur)          */
 
+  /* Sparse difference quotient Jacobian data */
+  SUNMatrix Jpat;       /* nonzero pattern of J (user-supplied or probed) */
+  sunindextype* colors; /* column colors of Jpat                          */
+  sunindextype ncolors; /* number of column colors                        */
+
   /* Statistics and associated parameters */
   long int msbj;     /* max num steps between jac/pset calls         */
   sunrealtype tcur;  /* 'time' for current ARKLs solve               */
@@ -216,6 +221,16 @@ int arkLsDenseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
 int arkLsBandDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
                    ARKodeMem ark_mem, ARKLsMem arkls_mem, ARKRhsFn fi,
                    N_Vector tmp1, N_Vector tmp2);
+int arkLsSparseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                     ARKodeMem ark_mem, ARKLsMem arkls_mem, ARKRhsFn fi,
+                     N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+int arkLsColoredDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                      const sunindextype* colors, sunindextype ncolors,
+                      ARKodeMem ark_mem, ARKRhsFn fi, N_Vector ftemp,
+                      N_Vector ytemp, N_Vector incs, long int* nfe);
+int arkLsSparseDQPattern(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                         ARKodeMem ark_mem, ARKLsMem arkls_mem, ARKRhsFn fi,
+                         N_Vector tmp1, N_Vector tmp2);
 
 /* Generic linit/lsetup/lsolve/lfree interface routines for ARKODE to call */
 int arkLsInitialize(ARKodeMem ark_mem);
@@ -223,7 +238,7 @@ int arkLsSetup(ARKodeMem ark_mem, int convfail, sunrealtype tpred,
                N_Vector ypred, N_Vector fpred, sunbooleantype* jcurPtr,
                N_Vector vtemp1, N_Vector vtemp2, N_Vector vtemp3);
 int arkLsSolve(ARKodeMem ark_mem, N_Vector b, sunrealtype tcur, N_Vector ycur,
-               N_Vector fcur, sunrealtype eRnrm, int mnewt);
+               N_Vector fcur, sunrealtype eRnrm, sunrealtype eta, int mnewt);
 int arkLsFree(ARKodeMem ark_mem);
 
 /* Generic minit/msetup/mmult/msolve/mfree routines for ARKODE to call */
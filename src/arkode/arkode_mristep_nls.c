@@ -411,6 +411,7 @@ int mriStep_NlsLSolve(N_Vector b, void* arkode_mem)
   ARKodeMem ark_mem;
   ARKodeMRIStepMem step_mem;
   int retval, nonlin_iter;
+  sunrealtype eta;
 
   /* access ARKodeMem and ARKodeMRIStepMem structures */
   retval = mriStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem, &step_mem);
@@ -420,10 +421,15 @@ int mriStep_NlsLSolve(N_Vector b, void* arkode_mem)
   retval = SUNNonlinSolGetCurIter(step_mem->NLS, &nonlin_iter);
   if (retval != SUN_SUCCESS) { return (ARK_NLS_OP_ERR); }
 
+  /* retrieve the forcing term for the linear solve from module, the
+     tolerance is not relaxed if it is unavailable */
+  retval = SUNNonlinSolGetForcingTerm(step_mem->NLS, &eta);
+  if (retval != SUN_SUCCESS) { eta = ZERO; }
+
   /* call linear solver interface, and handle return value */
   retval = step_mem->lsolve(ark_mem, b, ark_mem->tcur, ark_mem->ycur,
                             step_mem->Fsi[step_mem->stage_map[step_mem->istage]],
-                            step_mem->eRNrm, nonlin_iter);
+                            step_mem->eRNrm, eta, nonlin_iter);
 
   if (retval < 0) { return (ARK_LSOLVE_FAIL); }
   if (retval > 0) { return (CONV_FAIL); }
@@ -0,0 +1,427 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the sparse Jacobian-based
+ * preconditioner and solver routines for use with the ARKLS linear
+ * solver interface. The preconditioner matrix P = I - gamma*J is
+ * factored and applied by a user-supplied matrix-based linear
+ * solver, typically an incomplete factorization (SUNLinSol_ILU).
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+
+#include "arkode_impl.h"
+#include "arkode_ls_impl.h"
+#include "arkode_sparsepre_impl.h"
+
+#define ZERO SUN_RCONST(0.0)
+
+/* Prototypes of ARKSparsePrecSetup and ARKSparsePrecSolve */
+static int ARKSparsePrecSetup(sunrealtype t, N_Vector y, N_Vector fy,
+                              sunbooleantype jok, sunbooleantype* jcurPtr,
+                              sunrealtype gamma, void* sp_data);
+static int ARKSparsePrecSolve(sunrealtype t, N_Vector y, N_Vector fy,
+                              N_Vector r, N_Vector z, sunrealtype gamma,
+                              sunrealtype delta, int lr, void* sp_data);
+
+/* Prototype for ARKSparsePrecFree */
+static int ARKSparsePrecFree(ARKodeMem ark_mem);
+static void ARKSparsePrecFreeData(ARKSparsePrecData pdata);
+
+/*-----------------------------------------------------------------
+  Initialization, Free, and Get Functions
+  NOTE: The difference quotient Jacobian assumes a serial/OpenMP/
+        Pthreads implementation of the NVECTOR package. Therefore,
+        when jac is NULL, ARKSparsePrecInit will first test for a
+        compatible N_Vector internal representation by checking
+        that the function N_VGetArrayPointer exists.
+  -----------------------------------------------------------------*/
+int ARKSparsePrecInit(void* arkode_mem, SUNMatrix Jpattern, SUNLinearSolver LS,
+                      ARKLsJacFn jac)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  ARKSparsePrecData pdata;
+  sunindextype N;
+  int flag;
+
+  /* access ARKodeMem and ARKLsMem structures */
+  flag = arkLs_AccessARKODELMem(arkode_mem, __func__, &ark_mem, &arkls_mem);
+  if (flag != ARK_SUCCESS) { return (flag); }
+
+  /* Test the Jacobian pattern and the preconditioner linear solver */
+  N = N_VGetLength(ark_mem->tempv1);
+  if ((Jpattern == NULL) || (SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+      (SUNSparseMatrix_Rows(Jpattern) != N) ||
+      (SUNSparseMatrix_Columns(Jpattern) != N))
+  {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGSP_BAD_PATTERN);
+    return (ARKLS_ILL_INPUT);
+  }
+  if (LS == NULL)
+  {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGSP_LS_NULL);
+    return (ARKLS_ILL_INPUT);
+  }
+
+  /* Test compatibility of NVECTOR package with the DQ Jacobian */
+  if ((jac == NULL) && (ark_mem->tempv1->ops->nvgetarraypointer == NULL))
+  {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGSP_BAD_NVECTOR);
+    return (ARKLS_ILL_INPUT);
+  }
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (ARKSparsePrecData)calloc(1, sizeof *pdata);
+  if (pdata == NULL)
+  {
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_MEM_FAIL);
+    return (ARKLS_MEM_FAIL);
+  }
+
+  /* Load pointers into pdata block */
+  pdata->arkode_mem = arkode_mem;
+  pdata->LS        = LS;
+  pdata->jac       = jac;
+  pdata->nfeSP     = 0;
+  pdata->njeSP     = 0;
+
+  /* Allocate a copy of the pattern and the saved J and P matrices */
+  pdata->Jpat   = SUNMatClone(Jpattern);
+  pdata->savedJ = SUNMatClone(Jpattern);
+  pdata->savedP = SUNMatClone(Jpattern);
+  pdata->tmp1   = N_VClone(ark_mem->tempv1);
+  pdata->tmp2   = N_VClone(ark_mem->tempv1);
+  pdata->tmp3   = N_VClone(ark_mem->tempv1);
+  if ((pdata->Jpat == NULL) || (pdata->savedJ == NULL) ||
+      (pdata->savedP == NULL) || (pdata->tmp1 == NULL) ||
+      (pdata->tmp2 == NULL) || (pdata->tmp3 == NULL))
+  {
+    ARKSparsePrecFreeData(pdata);
+    arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_MEM_FAIL);
+    return (ARKLS_MEM_FAIL);
+  }
+  if (SUNMatCopy(Jpattern, pdata->Jpat))
+  {
+    ARKSparsePrecFreeData(pdata);
+    arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_SUNMAT_FAIL);
+    return (ARKLS_SUNMAT_FAIL);
+  }
+
+  /* Color the columns of the pattern for the DQ Jacobian */
+  if (jac == NULL)
+  {
+    pdata->colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+    if (pdata->colors == NULL)
+    {
+      ARKSparsePrecFreeData(pdata);
+      arkProcessError(ark_mem, ARKLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSGSP_MEM_FAIL);
+      return (ARKLS_MEM_FAIL);
+    }
+    if (SUNSparseMatrix_ColorColumns(pdata->Jpat, pdata->colors,
+                                     &pdata->ncolors))
+    {
+      ARKSparsePrecFreeData(pdata);
+      arkProcessError(ark_mem, ARKLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                      MSGSP_SUNMAT_FAIL);
+      return (ARKLS_SUNMAT_FAIL);
+    }
+  }
+
+  /* initialize the preconditioner linear solver object */
+  flag = SUNLinSolInitialize(pdata->LS);
+  if (flag != SUN_SUCCESS)
+  {
+    ARKSparsePrecFreeData(pdata);
+    arkProcessError(ark_mem, ARKLS_SUNLS_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_SUNLS_FAIL);
+    return (ARKLS_SUNLS_FAIL);
+  }
+
+  /* make sure P_data is free from any previous allocations */
+  if (arkls_mem->pfree) { arkls_mem->pfree(ark_mem); }
+
+  /* Point to the new P_data field in the LS memory */
+  arkls_mem->P_data = pdata;
+
+  /* Attach the pfree function */
+  arkls_mem->pfree = ARKSparsePrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = ARKodeSetPreconditioner(arkode_mem, ARKSparsePrecSetup,
+                                 ARKSparsePrecSolve);
+  return (flag);
+}
+
+/* Access the preconditioner data attached to arkode_mem */
+static int arkSparsePrecAccess(void* arkode_mem, const char* fname,
+                               ARKodeMem* ark_mem, ARKSparsePrecData* pdata)
+{
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKLsMem structures */
+  retval = arkLs_AccessARKODELMem(arkode_mem, fname, ark_mem, &arkls_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if ((arkls_mem->P_data == NULL) || (arkls_mem->pfree != ARKSparsePrecFree))
+  {
+    arkProcessError(*ark_mem, ARKLS_PMEM_NULL, __LINE__, fname, __FILE__,
+                    MSGSP_PMEM_NULL);
+    return (ARKLS_PMEM_NULL);
+  }
+  *pdata = (ARKSparsePrecData)arkls_mem->P_data;
+
+  return (ARKLS_SUCCESS);
+}
+
+int ARKSparsePrecGetWorkSpace(void* arkode_mem, long int* lenrwSP,
+                              long int* leniwSP)
+{
+  ARKodeMem ark_mem;
+  ARKSparsePrecData pdata;
+  sunindextype lrw1, liw1;
+  long int lrw, liw;
+  int flag;
+
+  flag = arkSparsePrecAccess(arkode_mem, __func__, &ark_mem, &pdata);
+  if (flag != ARKLS_SUCCESS) { return (flag); }
+
+  /* sum space requirements for all objects owned by pdata, the
+     preconditioner linear solver is owned by the user */
+  *leniwSP = 4;
+  *lenrwSP = 0;
+  if (pdata->colors) { *leniwSP += N_VGetLength(ark_mem->tempv1); }
+  if (ark_mem->tempv1->ops->nvspace)
+  {
+    N_VSpace(ark_mem->tempv1, &lrw1, &liw1);
+    *leniwSP += 3 * liw1;
+    *lenrwSP += 3 * lrw1;
+  }
+  if (pdata->Jpat->ops->space)
+  {
+    flag = SUNMatSpace(pdata->Jpat, &lrw, &liw);
+    if (flag != 0) { return (-1); }
+    *leniwSP += 3 * liw;
+    *lenrwSP += 3 * lrw;
+  }
+
+  return (ARKLS_SUCCESS);
+}
+
+int ARKSparsePrecGetNumRhsEvals(void* arkode_mem, long int* nfevalsSP)
+{
+  ARKodeMem ark_mem;
+  ARKSparsePrecData pdata;
+  int flag;
+
+  flag = arkSparsePrecAccess(arkode_mem, __func__, &ark_mem, &pdata);
+  if (flag != ARKLS_SUCCESS) { return (flag); }
+
+  *nfevalsSP = pdata->nfeSP;
+
+  return (ARKLS_SUCCESS);
+}
+
+int ARKSparsePrecGetNumJacEvals(void* arkode_mem, long int* njevalsSP)
+{
+  ARKodeMem ark_mem;
+  ARKSparsePrecData pdata;
+  int flag;
+
+  flag = arkSparsePrecAccess(arkode_mem, __func__, &ark_mem, &pdata);
+  if (flag != ARKLS_SUCCESS) { return (flag); }
+
+  *njevalsSP = pdata->njeSP;
+
+  return (ARKLS_SUCCESS);
+}
+
+/*-----------------------------------------------------------------
+  ARKSparsePrecSetup
+  -----------------------------------------------------------------
+  Together ARKSparsePrecSetup and ARKSparsePrecSolve use a sparse
+  Jacobian to create a preconditioner. ARKSparsePrecSetup computes
+  a new J with the user's Jacobian function or a colored difference
+  quotient when jok == SUNFALSE, then forms P = I - gamma*J and
+  calls the setup of the preconditioner linear solver (e.g., the
+  incomplete factorization of P).
+
+  The value to be returned by the ARKSparsePrecSetup function is
+    0  if successful,
+    1  if a recoverable failure occurred, or
+   -1  if an unrecoverable failure occurred.
+  -----------------------------------------------------------------*/
+static int ARKSparsePrecSetup(sunrealtype t, N_Vector y, N_Vector fy,
+                              sunbooleantype jok, sunbooleantype* jcurPtr,
+                              sunrealtype gamma, void* sp_data)
+{
+  ARKSparsePrecData pdata;
+  ARKodeMem ark_mem;
+  ARKRhsFn fi;
+  int retval;
+
+  pdata   = (ARKSparsePrecData)sp_data;
+  ark_mem = (ARKodeMem)pdata->arkode_mem;
+
+  if (jok)
+  {
+    /* If jok = SUNTRUE, use saved copy of J. */
+    *jcurPtr = SUNFALSE;
+  }
+  else
+  {
+    /* If jok = SUNFALSE, compute a new J. */
+    *jcurPtr = SUNTRUE;
+    pdata->njeSP++;
+
+    if (pdata->jac)
+    {
+      retval = SUNMatZero(pdata->savedJ);
+      if (retval)
+      {
+        arkProcessError(ark_mem, -1, __LINE__, __func__, __FILE__,
+                        MSGSP_SUNMAT_FAIL);
+        return (-1);
+      }
+
+      retval = pdata->jac(t, y, fy, pdata->savedJ, ark_mem->user_data,
+                          pdata->tmp1, pdata->tmp2, pdata->tmp3);
+      if (retval < 0)
+      {
+        arkProcessError(ark_mem, -1, __LINE__, __func__, __FILE__,
+                        MSGSP_JACFUNC_FAILED);
+        return (-1);
+      }
+      if (retval > 0) { return (1); }
+    }
+    else
+    {
+      /* Access implicit RHS function */
+      fi = ark_mem->step_getimplicitrhs((void*)ark_mem);
+      if (fi == NULL)
+      {
+        arkProcessError(ark_mem, -1, __LINE__, __func__, __FILE__,
+                        MSGSP_RHSFUNC_FAILED);
+        return (-1);
+      }
+
+      /* Load the pattern into savedJ, then form the colored DQ Jacobian */
+      if (SUNMatCopy(pdata->Jpat, pdata->savedJ))
+      {
+        arkProcessError(ark_mem, -1, __LINE__, __func__, __FILE__,
+                        MSGSP_SUNMAT_FAIL);
+        return (-1);
+      }
+      retval = arkLsColoredDQJac(t, y, fy, pdata->savedJ, pdata->colors,
+                                 pdata->ncolors, ark_mem, fi, pdata->tmp1,
+                                 pdata->tmp2, pdata->tmp3, &pdata->nfeSP);
+      if (retval < 0)
+      {
+        arkProcessError(ark_mem, -1, __LINE__, __func__, __FILE__,
+                        MSGSP_RHSFUNC_FAILED);
+        return (-1);
+      }
+      if (retval > 0) { return (1); }
+    }
+  }
+
+  /* Copy J and scale and add identity to get savedP = I - gamma*J. */
+  retval = SUNMatCopy(pdata->savedJ, pdata->savedP);
+  if (retval == SUN_SUCCESS)
+  {
+    retval = SUNMatScaleAddI(-gamma, pdata->savedP);
+  }
+  if (retval)
+  {
+    arkProcessError(ark_mem, -1, __LINE__, __func__, __FILE__,
+                    MSGSP_SUNMAT_FAIL);
+    return (-1);
+  }
+
+  /* Factor P and return the (recoverable) error flag */
+  retval = SUNLinSolSetup(pdata->LS, pdata->savedP);
+  if (retval < 0)
+  {
+    arkProcessError(ark_mem, -1, __LINE__, __func__, __FILE__,
+                    MSGSP_SUNLS_FAIL);
+    return (-1);
+  }
+  return (retval);
+}
+
+/*-----------------------------------------------------------------
+  ARKSparsePrecSolve
+  -----------------------------------------------------------------
+  ARKSparsePrecSolve solves a linear system P z = r with the
+  preconditioner linear solver, where P is the matrix computed by
+  ARKSparsePrecSetup. For an incomplete factorization the solve is
+  approximate, which is all that is required of a preconditioner.
+  -----------------------------------------------------------------*/
+static int ARKSparsePrecSolve(SUNDIALS_MAYBE_UNUSED sunrealtype t,
+                              SUNDIALS_MAYBE_UNUSED N_Vector y,
+                              SUNDIALS_MAYBE_UNUSED N_Vector fy, N_Vector r,
+                              N_Vector z,
+                              SUNDIALS_MAYBE_UNUSED sunrealtype gamma,
+                              SUNDIALS_MAYBE_UNUSED sunrealtype delta,
+                              SUNDIALS_MAYBE_UNUSED int lr, void* sp_data)
+{
+  ARKSparsePrecData pdata;
+  int retval;
+
+  pdata = (ARKSparsePrecData)sp_data;
+
+  retval = SUNLinSolSolve(pdata->LS, pdata->savedP, z, r, ZERO);
+  return (retval);
+}
+
+static int ARKSparsePrecFree(ARKodeMem ark_mem)
+{
+  ARKLsMem arkls_mem;
+  void* ark_step_lmem;
+
+  /* Return immediately if ARKodeMem or ARKLsMem are NULL */
+  if (ark_mem == NULL) { return (0); }
+  ark_step_lmem = ark_mem->step_getlinmem((void*)ark_mem);
+  if (ark_step_lmem == NULL) { return (0); }
+  arkls_mem = (ARKLsMem)ark_step_lmem;
+
+  if (arkls_mem->P_data == NULL) { return (0); }
+  ARKSparsePrecFreeData((ARKSparsePrecData)arkls_mem->P_data);
+  arkls_mem->P_data = NULL;
+
+  return (0);
+}
+
+/* Free the objects owned by pdata, the linear solver belongs to the user */
+static void ARKSparsePrecFreeData(ARKSparsePrecData pdata)
+{
+  if (pdata->Jpat) { SUNMatDestroy(pdata->Jpat); }
+  if (pdata->savedJ) { SUNMatDestroy(pdata->savedJ); }
+  if (pdata->savedP) { SUNMatDestroy(pdata->savedP); }
+  if (pdata->tmp1) { N_VDestroy(pdata->tmp1); }
+  if (pdata->tmp2) { N_VDestroy(pdata->tmp2); }
+  if (pdata->tmp3) { N_VDestroy(pdata->tmp3); }
+  free(pdata->colors);
+  free(pdata);
+}
@@ -164,7 +164,9 @@ static void cvAdamsFinish(CVodeMem cv_mem, sunrealtype m[], sunrealtype M[],
                           sunrealtype hsum);
 static sunrealtype cvAltSum(int iend, sunrealtype a[], int k);
 static void cvSetBDF(CVodeMem cv_mem);
-static void cvSetTqBDF(CVodeMem cv_mem, sunrealtype hsum, sunrealtype alpha0,
+static void cvSetTqBDF(int q, int qwait, sunrealtype h, const sunrealtype* tau,
+                       sunrealtype nlscoef, const sunrealtype* l,
+                       sunrealtype* tq, sunrealtype hsum, sunrealtype alpha0,
                        sunrealtype alpha0_hat, sunrealtype xi_inv,
                        sunrealtype xistar_inv);
 
@@ -2566,30 +2568,10 @@ static void cvAdjustBDF(CVodeMem cv_mem, int deltaq)
 
 static void cvIncreaseBDF(CVodeMem cv_mem)
 {
-  sunrealtype alpha0, alpha1, prod, xi, xiold, hsum, A1;
-  int i, j;
+  sunrealtype A1;
 
-  for (i = 0; i <= cv_mem->cv_qmax; i++) { cv_mem->cv_l[i] = ZERO; }
-  cv_mem->cv_l[2] = alpha1 = prod = xiold = ONE;
-  alpha0                                  = -ONE;
-  hsum                                    = cv_mem->cv_hscale;
-  if (cv_mem->cv_q > 1)
-  {
-    for (j = 1; j < cv_mem->cv_q; j++)
-    {
-      hsum += cv_mem->cv_tau[j + 1];
-      xi = hsum / cv_mem->cv_hscale;
-      prod *= xi;
-      alpha0 -= ONE / (j + 1);
-      alpha1 += ONE / xi;
-      for (i = j + 2; i >= 2; i--)
-      {
-        cv_mem->cv_l[i] = cv_mem->cv_l[i] * xiold + cv_mem->cv_l[i - 1];
-      }
-      xiold = xi;
-    }
-  }
-  A1 = (-alpha0 - alpha1) / prod;
+  A1 = cvIncreaseBDFCoefs(cv_mem->cv_q, cv_mem->cv_qmax, cv_mem->cv_hscale,
+                          cv_mem->cv_tau, cv_mem->cv_l);
   N_VScale(A1, cv_mem->cv_zn[cv_mem->cv_indx_acor], cv_mem->cv_zn[cv_mem->cv_L]);
 
   /* for (j=2; j <= cv_mem->cv_q; j++) */
@@ -2601,6 +2583,42 @@ static void cvIncreaseBDF(CVodeMem cv_mem)
   }
 }
 
+/*
+ * cvIncreaseBDFCoefs
+ *
+ * This routine computes the coefficients used by cvIncreaseBDF: on
+ * return l[2], ..., l[q] hold the multiples of the new column zn[q+1]
+ * added to zn[2], ..., zn[q], and the return value is the multiple
+ * of the saved correction that gives zn[q+1]. It is shared with the
+ * ensemble mode (cvode_ensemble.c).
+ */
+
+sunrealtype cvIncreaseBDFCoefs(int q, int qmax, sunrealtype hscale,
+                               const sunrealtype* tau, sunrealtype* l)
+{
+  sunrealtype alpha0, alpha1, prod, xi, xiold, hsum;
+  int i, j;
+
+  for (i = 0; i <= qmax; i++) { l[i] = ZERO; }
+  l[2] = alpha1 = prod = xiold = ONE;
+  alpha0                       = -ONE;
+  hsum                         = hscale;
+  if (q > 1)
+  {
+    for (j = 1; j < q; j++)
+    {
+      hsum += tau[j + 1];
+      xi = hsum / hscale;
+      prod *= xi;
+      alpha0 -= ONE / (j + 1);
+      alpha1 += ONE / xi;
+      for (i = j + 2; i >= 2; i--) { l[i] = l[i] * xiold + l[i - 1]; }
+      xiold = xi;
+    }
+  }
+  return ((-alpha0 - alpha1) / prod);
+}
+
 /*
  * cvDecreaseBDF
  *
@@ -2613,21 +2631,10 @@ static void cvIncreaseBDF(CVodeMem cv_mem)
 
 static void cvDecreaseBDF(CVodeMem cv_mem)
 {
-  sunrealtype hsum, xi;
-  int i, j;
+  int j;
 
-  for (i = 0; i <= cv_mem->cv_qmax; i++) { cv_mem->cv_l[i] = ZERO; }
-  cv_mem->cv_l[2] = ONE;
-  hsum            = ZERO;
-  for (j = 1; j <= cv_mem->cv_q - 2; j++)
-  {
-    hsum += cv_mem->cv_tau[j];
-    xi = hsum / cv_mem->cv_hscale;
-    for (i = j + 2; i >= 2; i--)
-    {
-      cv_mem->cv_l[i] = cv_mem->cv_l[i] * xi + cv_mem->cv_l[i - 1];
-    }
-  }
+  cvDecreaseBDFCoefs(cv_mem->cv_q, cv_mem->cv_qmax, cv_mem->cv_hscale,
+                     cv_mem->cv_tau, cv_mem->cv_l);
 
   for (j = 2; j < cv_mem->cv_q; j++)
   {
@@ -2642,6 +2649,31 @@ static void cvDecreaseBDF(CVodeMem cv_mem)
   }
 }
 
+/*
+ * cvDecreaseBDFCoefs
+ *
+ * This routine computes the coefficients used by cvDecreaseBDF: on
+ * return zn[j] is to be adjusted by -l[j] * zn[q], j = 2, ..., q-1.
+ * It is shared with the ensemble mode (cvode_ensemble.c).
+ */
+
+void cvDecreaseBDFCoefs(int q, int qmax, sunrealtype hscale,
+                        const sunrealtype* tau, sunrealtype* l)
+{
+  sunrealtype hsum, xi;
+  int i, j;
+
+  for (i = 0; i <= qmax; i++) { l[i] = ZERO; }
+  l[2] = ONE;
+  hsum = ZERO;
+  for (j = 1; j <= q - 2; j++)
+  {
+    hsum += tau[j];
+    xi = hsum / hscale;
+    for (i = j + 2; i >= 2; i--) { l[i] = l[i] * xi + l[i - 1]; }
+  }
+}
+
 /*
  * cvRescale
  *
@@ -2693,12 +2725,21 @@ static void cvPredict(CVodeMem cv_mem)
     }
   }
 
-  for (k = 1; k <= cv_mem->cv_q; k++)
+#ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
+  if (cv_mem->cv_usefused)
   {
-    for (j = cv_mem->cv_q; j >= k; j--)
+    cvPredict_fused(cv_mem->cv_q, cv_mem->cv_zn);
+  }
+  else
+#endif
+  {
+    for (k = 1; k <= cv_mem->cv_q; k++)
     {
-      N_VLinearSum(ONE, cv_mem->cv_zn[j - 1], ONE, cv_mem->cv_zn[j],
-                   cv_mem->cv_zn[j - 1]);
+      for (j = cv_mem->cv_q; j >= k; j--)
+      {
+        N_VLinearSum(ONE, cv_mem->cv_zn[j - 1], ONE, cv_mem->cv_zn[j],
+                     cv_mem->cv_zn[j - 1]);
+      }
     }
   }
 
@@ -2899,56 +2940,67 @@ static sunrealtype cvAltSum(int iend, sunrealtype a[], int k)
  */
 
 static void cvSetBDF(CVodeMem cv_mem)
+{
+  cvBDFCoefs(cv_mem->cv_q, cv_mem->cv_qwait, cv_mem->cv_h, cv_mem->cv_tau,
+             cv_mem->cv_nlscoef, cv_mem->cv_l, cv_mem->cv_tq,
+             cv_mem->proj_enabled ? cv_mem->proj_p : NULL);
+}
+
+/*
+ * cvBDFCoefs
+ *
+ * This routine computes the BDF coefficients l and the test
+ * quantities tq of cvSetBDF from the order q, qwait, the step size h,
+ * the step history tau, and the nonlinear convergence coefficient.
+ * If p is not NULL, the projection coefficients are returned in p.
+ * It is shared with the ensemble mode (cvode_ensemble.c).
+ */
+
+void cvBDFCoefs(int q, int qwait, sunrealtype h, const sunrealtype* tau,
+                sunrealtype nlscoef, sunrealtype* l, sunrealtype* tq,
+                sunrealtype* p)
 {
   sunrealtype alpha0, alpha0_hat, xi_inv, xistar_inv, hsum;
   int i, j;
 
-  cv_mem->cv_l[0] = cv_mem->cv_l[1] = xi_inv = xistar_inv = ONE;
-  for (i = 2; i <= cv_mem->cv_q; i++) { cv_mem->cv_l[i] = ZERO; }
+  l[0] = l[1] = xi_inv = xistar_inv = ONE;
+  for (i = 2; i <= q; i++) { l[i] = ZERO; }
   alpha0 = alpha0_hat = -ONE;
-  hsum                = cv_mem->cv_h;
+  hsum                = h;
 
-  if (cv_mem->proj_enabled)
+  if (p != NULL)
   {
-    for (i = 0; i <= cv_mem->cv_q; i++) { cv_mem->proj_p[i] = cv_mem->cv_l[i]; }
+    for (i = 0; i <= q; i++) { p[i] = l[i]; }
   }
 
-  if (cv_mem->cv_q > 1)
+  if (q > 1)
   {
-    for (j = 2; j < cv_mem->cv_q; j++)
+    for (j = 2; j < q; j++)
     {
-      hsum += cv_mem->cv_tau[j - 1];
-      xi_inv = cv_mem->cv_h / hsum;
+      hsum += tau[j - 1];
+      xi_inv = h / hsum;
       alpha0 -= ONE / j;
-      for (i = j; i >= 1; i--)
-      {
-        cv_mem->cv_l[i] += cv_mem->cv_l[i - 1] * xi_inv;
-      }
+      for (i = j; i >= 1; i--) { l[i] += l[i - 1] * xi_inv; }
       /* The l[i] are coefficients of product(1 to j) (1 + x/xi_i) */
     }
 
     /* j = q */
-    alpha0 -= ONE / cv_mem->cv_q;
-    xistar_inv = -cv_mem->cv_l[1] - alpha0;
-    hsum += cv_mem->cv_tau[cv_mem->cv_q - 1];
-    xi_inv     = cv_mem->cv_h / hsum;
-    alpha0_hat = -cv_mem->cv_l[1] - xi_inv;
+    alpha0 -= ONE / q;
+    xistar_inv = -l[1] - alpha0;
+    hsum += tau[q - 1];
+    xi_inv     = h / hsum;
+    alpha0_hat = -l[1] - xi_inv;
 
-    if (cv_mem->proj_enabled)
+    if (p != NULL)
     {
-      for (i = cv_mem->cv_q; i >= 1; i--)
-      {
-        cv_mem->proj_p[i] = cv_mem->cv_l[i] + cv_mem->proj_p[i - 1] * xi_inv;
-      }
+      for (i = q; i >= 1; i--) { p[i] = l[i] + p[i - 1] * xi_inv; }
     }
 
-    for (i = cv_mem->cv_q; i >= 1; i--)
-    {
-      cv_mem->cv_l[i] += cv_mem->cv_l[i - 1] * xistar_inv;
-    }
+    for (i = q; i >= 1; i--) { l[i] += l[i - 1] * xistar_inv; }
   }
 
-  cvSetTqBDF(cv_mem, hsum, alpha0, alpha0_hat, xi_inv, xistar_inv);
+  cvSetTqBDF(q, qwait, h, tau, nlscoef, l, tq, hsum, alpha0, alpha0_hat,
+             xi_inv, xistar_inv);
 }
 
 /*
@@ -2958,37 +3010,38 @@ static void cvSetBDF(CVodeMem cv_mem)
  * lmm == CV_BDF.
  */
 
-static void cvSetTqBDF(CVodeMem cv_mem, sunrealtype hsum, sunrealtype alpha0,
+static void cvSetTqBDF(int q, int qwait, sunrealtype h, const sunrealtype* tau,
+                       sunrealtype nlscoef, const sunrealtype* l,
+                       sunrealtype* tq, sunrealtype hsum, sunrealtype alpha0,
                        sunrealtype alpha0_hat, sunrealtype xi_inv,
                        sunrealtype xistar_inv)
 {
   sunrealtype A1, A2, A3, A4, A5, A6;
   sunrealtype C, Cpinv, Cppinv;
 
-  A1               = ONE - alpha0_hat + alpha0;
-  A2               = ONE + cv_mem->cv_q * A1;
-  cv_mem->cv_tq[2] = SUNRabs(A1 / (alpha0 * A2));
-  cv_mem->cv_tq[5] =
-    SUNRabs(A2 * xistar_inv / (cv_mem->cv_l[cv_mem->cv_q] * xi_inv));
-  if (cv_mem->cv_qwait == 1)
+  A1    = ONE - alpha0_hat + alpha0;
+  A2    = ONE + q * A1;
+  tq[2] = SUNRabs(A1 / (alpha0 * A2));
+  tq[5] = SUNRabs(A2 * xistar_inv / (l[q] * xi_inv));
+  if (qwait == 1)
   {
-    if (cv_mem->cv_q > 1)
+    if (q > 1)
     {
-      C                = xistar_inv / cv_mem->cv_l[cv_mem->cv_q];
-      A3               = alpha0 + ONE / cv_mem->cv_q;
-      A4               = alpha0_hat + xi_inv;
-      Cpinv            = (ONE - A4 + A3) / A3;
-      cv_mem->cv_tq[1] = SUNRabs(C * Cpinv);
+      C     = xistar_inv / l[q];
+      A3    = alpha0 + ONE / q;
+      A4    = alpha0_hat + xi_inv;
+      Cpinv = (ONE - A4 + A3) / A3;
+      tq[1] = SUNRabs(C * Cpinv);
     }
-    else { cv_mem->cv_tq[1] = ONE; }
-    hsum += cv_mem->cv_tau[cv_mem->cv_q];
-    xi_inv           = cv_mem->cv_h / hsum;
-    A5               = alpha0 - (ONE / (cv_mem->cv_q + 1));
-    A6               = alpha0_hat - xi_inv;
-    Cppinv           = (ONE - A6 + A5) / A2;
-    cv_mem->cv_tq[3] = SUNRabs(Cppinv / (xi_inv * (cv_mem->cv_q + 2) * A5));
-  }
-  cv_mem->cv_tq[4] = cv_mem->cv_nlscoef / cv_mem->cv_tq[2];
+    else { tq[1] = ONE; }
+    hsum += tau[q];
+    xi_inv = h / hsum;
+    A5     = alpha0 - (ONE / (q + 1));
+    A6     = alpha0_hat - xi_inv;
+    Cppinv = (ONE - A6 + A5) / A2;
+    tq[3]  = SUNRabs(Cppinv / (xi_inv * (q + 2) * A5));
+  }
+  tq[4] = nlscoef / tq[2];
 }
 
 /*
@@ -3015,14 +3068,9 @@ static int cvNls(CVodeMem cv_mem, int nflag)
   /* set flag convfail (input to lsetup for its evaluation decision) */
   if (cv_mem->cv_lsetup)
   {
-    cv_mem->convfail = ((nflag == FIRST_CALL) || (nflag == PREV_ERR_FAIL))
-                         ? CV_NO_FAILURES
-                         : CV_FAIL_OTHER;
-
-    callSetup = (nflag == PREV_CONV_FAIL) || (nflag == PREV_ERR_FAIL) ||
-                (cv_mem->cv_nst == 0) ||
-                (cv_mem->cv_nst >= cv_mem->cv_nstlp + cv_mem->cv_msbp) ||
-                (SUNRabs(cv_mem->cv_gamrat - ONE) > cv_mem->cv_dgmax_lsetup);
+    callSetup = cvNlsCallSetup(nflag, cv_mem->cv_nst, cv_mem->cv_nstlp,
+                               cv_mem->cv_msbp, cv_mem->cv_gamrat,
+                               cv_mem->cv_dgmax_lsetup, &(cv_mem->convfail));
   }
   else
   {
@@ -3057,13 +3105,26 @@ static int cvNls(CVodeMem cv_mem, int nflag)
 
   /* solve successful */
 
-  /* update the state based on the final correction from the nonlinear solver */
-  N_VLinearSum(ONE, cv_mem->cv_zn[0], ONE, cv_mem->cv_acor, cv_mem->cv_y);
-
-  /* compute acnrm if is was not already done by the nonlinear solver */
-  if (!cv_mem->cv_acnrmcur)
+#ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
+  if (cv_mem->cv_usefused)
   {
-    cv_mem->cv_acnrm = N_VWrmsNorm(cv_mem->cv_acor, cv_mem->cv_ewt);
+    /* update the state and compute acnrm (if it was not already done by the
+       nonlinear solver) in a single pass */
+    cvUpdateY_fused(!cv_mem->cv_acnrmcur, cv_mem->cv_zn[0], cv_mem->cv_acor,
+                    cv_mem->cv_ewt, cv_mem->cv_y, &(cv_mem->cv_acnrm));
+  }
+  else
+#endif
+  {
+    /* update the state based on the final correction from the nonlinear
+       solver */
+    N_VLinearSum(ONE, cv_mem->cv_zn[0], ONE, cv_mem->cv_acor, cv_mem->cv_y);
+
+    /* compute acnrm if is was not already done by the nonlinear solver */
+    if (!cv_mem->cv_acnrmcur)
+    {
+      cv_mem->cv_acnrm = N_VWrmsNorm(cv_mem->cv_acor, cv_mem->cv_ewt);
+    }
   }
 
   /* update Jacobian status */
@@ -3075,6 +3136,28 @@ static int cvNls(CVodeMem cv_mem, int nflag)
   return (flag);
 }
 
+/*
+ * cvNlsCallSetup
+ *
+ * This routine decides whether the nonlinear solver should call the
+ * linear solver setup routine at the start of a step attempt, given
+ * the outcome nflag of the previous attempt, and sets convfail (the
+ * input to lsetup for its Jacobian evaluation decision). It is shared
+ * with the ensemble mode (cvode_ensemble.c).
+ */
+
+sunbooleantype cvNlsCallSetup(int nflag, long int nst, long int nstlp,
+                              long int msbp, sunrealtype gamrat,
+                              sunrealtype dgmax_lsetup, int* convfail)
+{
+  *convfail = ((nflag == FIRST_CALL) || (nflag == PREV_ERR_FAIL))
+                ? CV_NO_FAILURES
+                : CV_FAIL_OTHER;
+
+  return ((nflag == PREV_CONV_FAIL) || (nflag == PREV_ERR_FAIL) || (nst == 0) ||
+          (nst >= nstlp + msbp) || (SUNRabs(gamrat - ONE) > dgmax_lsetup));
+}
+
 /*
  * cvCheckConstraints
  *
@@ -3321,14 +3404,10 @@ static int cvDoErrorTest(CVodeMem cv_mem, int* nflagPtr, sunrealtype saved_t,
   /* Set h ratio eta from dsm, rescale, and return for retry of step */
   if (*nefPtr <= MXNEF1)
   {
-    cv_mem->cv_eta = ONE / (SUNRpowerR(BIAS2 * dsm, ONE / cv_mem->cv_L) + ADDON);
-    cv_mem->cv_eta =
-      SUNMAX(cv_mem->cv_eta_min_ef,
-             SUNMAX(cv_mem->cv_eta, cv_mem->cv_hmin / SUNRabs(cv_mem->cv_h)));
-    if (*nefPtr >= cv_mem->cv_small_nef)
-    {
-      cv_mem->cv_eta = SUNMIN(cv_mem->cv_eta, cv_mem->cv_eta_max_ef);
-    }
+    cv_mem->cv_eta = cvErrFailEta(dsm, cv_mem->cv_L, *nefPtr,
+                                  cv_mem->cv_small_nef, cv_mem->cv_eta_min_ef,
+                                  cv_mem->cv_eta_max_ef,
+                                  cv_mem->cv_hmin / SUNRabs(cv_mem->cv_h));
 
     cvRescale(cv_mem);
 
@@ -3383,6 +3462,29 @@ static int cvDoErrorTest(CVodeMem cv_mem, int* nflagPtr, sunrealtype saved_t,
   return (TRY_AGAIN);
 }
 
+/*
+ * cvErrFailEta
+ *
+ * This routine returns the step size ratio eta for the retry of a
+ * step after nef <= MXNEF1 error test failures with the local error
+ * norm dsm, limited below by eta_min_ef and hmin_ratio = hmin/|h| and,
+ * after small_nef failures, above by eta_max_ef. It is shared with
+ * the ensemble mode (cvode_ensemble.c).
+ */
+
+sunrealtype cvErrFailEta(sunrealtype dsm, int L, int nef, int small_nef,
+                         sunrealtype eta_min_ef, sunrealtype eta_max_ef,
+                         sunrealtype hmin_ratio)
+{
+  sunrealtype eta;
+
+  eta = cvEtaFromNorm(BIAS2, dsm, L);
+  eta = SUNMAX(eta_min_ef, SUNMAX(eta, hmin_ratio));
+  if (nef >= small_nef) { eta = SUNMIN(eta, eta_max_ef); }
+
+  return (eta);
+}
+
 /*
  * -----------------------------------------------------------------
  * Functions called after a successful step
@@ -3478,7 +3580,7 @@ static void cvPrepareNextStep(CVodeMem cv_mem, sunrealtype dsm)
   else
   {
     /* etaq is the ratio of new to old h at the current order */
-    cv_mem->cv_etaq = ONE / (SUNRpowerR(BIAS2 * dsm, ONE / cv_mem->cv_L) + ADDON);
+    cv_mem->cv_etaq = cvEtaFromNorm(BIAS2, dsm, cv_mem->cv_L);
 
     /* If no order change, adjust eta and acor in cvSetEta and return */
     if (cv_mem->cv_qwait != 0)
@@ -3518,33 +3620,48 @@ static void cvPrepareNextStep(CVodeMem cv_mem, sunrealtype dsm)
 
 static void cvSetEta(CVodeMem cv_mem)
 {
-  if ((cv_mem->cv_eta > cv_mem->cv_eta_min_fx) &&
-      (cv_mem->cv_eta < cv_mem->cv_eta_max_fx))
+  cv_mem->cv_eta = cvLimitEta(cv_mem->cv_eta, cv_mem->cv_h, cv_mem->cv_etamax,
+                              cv_mem->cv_eta_min_fx, cv_mem->cv_eta_max_fx,
+                              cv_mem->cv_eta_min, cv_mem->cv_hmin,
+                              cv_mem->cv_hmax_inv);
+
+  /* Set hprime (eta = 1 retains the step size and order) */
+  cv_mem->cv_hprime = cv_mem->cv_h * cv_mem->cv_eta;
+  if (cv_mem->cv_qprime < cv_mem->cv_q) { cv_mem->cv_nscon = 0; }
+}
+
+/*
+ * cvLimitEta
+ *
+ * This routine returns the step size ratio eta after applying the
+ * heuristic limits: eta is set to one if it is within the fixed step
+ * bounds (eta_min_fx, eta_max_fx), an increase is limited by etamax
+ * and hmax, and a reduction is limited by eta_min and hmin. It is
+ * shared with the ensemble mode (cvode_ensemble.c).
+ */
+
+sunrealtype cvLimitEta(sunrealtype eta, sunrealtype h, sunrealtype etamax,
+                       sunrealtype eta_min_fx, sunrealtype eta_max_fx,
+                       sunrealtype eta_min, sunrealtype hmin,
+                       sunrealtype hmax_inv)
+{
+  /* Eta is within the fixed step bounds, retain step size */
+  if ((eta > eta_min_fx) && (eta < eta_max_fx)) { return (ONE); }
+
+  if (eta >= eta_max_fx)
   {
-    /* Eta is within the fixed step bounds, retain step size */
-    cv_mem->cv_eta    = ONE;
-    cv_mem->cv_hprime = cv_mem->cv_h;
+    /* Increase the step size, limit eta by etamax and hmax */
+    eta = SUNMIN(eta, etamax);
+    eta /= SUNMAX(ONE, SUNRabs(h) * hmax_inv * eta);
   }
   else
   {
-    if (cv_mem->cv_eta >= cv_mem->cv_eta_max_fx)
-    {
-      /* Increase the step size, limit eta by etamax and hmax */
-      cv_mem->cv_eta = SUNMIN(cv_mem->cv_eta, cv_mem->cv_etamax);
-      cv_mem->cv_eta /= SUNMAX(ONE, SUNRabs(cv_mem->cv_h) *
-                                      cv_mem->cv_hmax_inv * cv_mem->cv_eta);
-    }
-    else
-    {
-      /* Reduce the step size, limit eta by etamin and hmin */
-      cv_mem->cv_eta = SUNMAX(cv_mem->cv_eta, cv_mem->cv_eta_min);
-      cv_mem->cv_eta = SUNMAX(cv_mem->cv_eta,
-                              cv_mem->cv_hmin / SUNRabs(cv_mem->cv_h));
-    }
-    /* Set hprime */
-    cv_mem->cv_hprime = cv_mem->cv_h * cv_mem->cv_eta;
-    if (cv_mem->cv_qprime < cv_mem->cv_q) { cv_mem->cv_nscon = 0; }
+    /* Reduce the step size, limit eta by etamin and hmin */
+    eta = SUNMAX(eta, eta_min);
+    eta = SUNMAX(eta, hmin / SUNRabs(h));
   }
+
+  return (eta);
 }
 
 /*
@@ -3563,8 +3680,7 @@ static sunrealtype cvComputeEtaqm1(CVodeMem cv_mem)
   {
     ddn = N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q], cv_mem->cv_ewt) *
           cv_mem->cv_tq[1];
-    cv_mem->cv_etaqm1 = ONE /
-                        (SUNRpowerR(BIAS1 * ddn, ONE / cv_mem->cv_q) + ADDON);
+    cv_mem->cv_etaqm1 = cvEtaFromNorm(BIAS1, ddn, cv_mem->cv_q);
   }
   return (cv_mem->cv_etaqm1);
 }
@@ -3589,12 +3705,25 @@ static sunrealtype cvComputeEtaqp1(CVodeMem cv_mem)
     N_VLinearSum(-cquot, cv_mem->cv_zn[cv_mem->cv_qmax], ONE, cv_mem->cv_acor,
                  cv_mem->cv_tempv);
     dup = N_VWrmsNorm(cv_mem->cv_tempv, cv_mem->cv_ewt) * cv_mem->cv_tq[3];
-    cv_mem->cv_etaqp1 =
-      ONE / (SUNRpowerR(BIAS3 * dup, ONE / (cv_mem->cv_L + 1)) + ADDON);
+    cv_mem->cv_etaqp1 = cvEtaFromNorm(BIAS3, dup, cv_mem->cv_L + 1);
   }
   return (cv_mem->cv_etaqp1);
 }
 
+/*
+ * cvEtaFromNorm
+ *
+ * This routine returns the step size ratio 1/((bias*dnrm)^(1/k) + ADDON)
+ * for a method whose local error norm dnrm scales as h^k. It is used
+ * for etaq, etaqm1, and etaqp1 and is shared with the ensemble mode
+ * (cvode_ensemble.c).
+ */
+
+sunrealtype cvEtaFromNorm(sunrealtype bias, sunrealtype dnrm, int k)
+{
+  return (ONE / (SUNRpowerR(bias * dnrm, ONE / k) + ADDON));
+}
+
 /*
  * cvChooseEta
  * Given etaqm1, etaq, etaqp1 (the values of eta for qprime =
@@ -3608,46 +3737,66 @@ static sunrealtype cvComputeEtaqp1(CVodeMem cv_mem)
  */
 
 static void cvChooseEta(CVodeMem cv_mem)
+{
+  int deltaq;
+
+  deltaq = cvChooseOrder(cv_mem->cv_etaqm1, cv_mem->cv_etaq, cv_mem->cv_etaqp1,
+                         cv_mem->cv_eta_min_fx, cv_mem->cv_eta_max_fx,
+                         &(cv_mem->cv_eta));
+
+  cv_mem->cv_qprime = cv_mem->cv_q + deltaq;
+
+  if ((deltaq == 1) && (cv_mem->cv_lmm == CV_BDF))
+  {
+    /*
+     * Store Delta_n in zn[qmax] to be used in order increase
+     *
+     * This happens at the last step of order q before an increase
+     * to order q+1, so it represents Delta_n in the ELTE at q+1
+     */
+
+    N_VScale(ONE, cv_mem->cv_acor, cv_mem->cv_zn[cv_mem->cv_qmax]);
+  }
+}
+
+/*
+ * cvChooseOrder
+ *
+ * This routine implements the selection of cvChooseEta: it sets *eta
+ * to the largest of etaqm1, etaq, and etaqp1 (or to one if that value
+ * is within the fixed step bounds) and returns the corresponding
+ * order change -1, 0, or +1. It is shared with the ensemble mode
+ * (cvode_ensemble.c).
+ */
+
+int cvChooseOrder(sunrealtype etaqm1, sunrealtype etaq, sunrealtype etaqp1,
+                  sunrealtype eta_min_fx, sunrealtype eta_max_fx,
+                  sunrealtype* eta)
 {
   sunrealtype etam;
 
-  etam = SUNMAX(cv_mem->cv_etaqm1, SUNMAX(cv_mem->cv_etaq, cv_mem->cv_etaqp1));
+  etam = SUNMAX(etaqm1, SUNMAX(etaq, etaqp1));
 
-  if ((etam > cv_mem->cv_eta_min_fx) && (etam < cv_mem->cv_eta_max_fx))
+  if ((etam > eta_min_fx) && (etam < eta_max_fx))
   {
-    cv_mem->cv_eta    = ONE;
-    cv_mem->cv_qprime = cv_mem->cv_q;
+    *eta = ONE;
+    return (0);
   }
-  else
+
+  if (etam == etaq)
   {
-    if (etam == cv_mem->cv_etaq)
-    {
-      cv_mem->cv_eta    = cv_mem->cv_etaq;
-      cv_mem->cv_qprime = cv_mem->cv_q;
-    }
-    else if (etam == cv_mem->cv_etaqm1)
-    {
-      cv_mem->cv_eta    = cv_mem->cv_etaqm1;
-      cv_mem->cv_qprime = cv_mem->cv_q - 1;
-    }
-    else
-    {
-      cv_mem->cv_eta    = cv_mem->cv_etaqp1;
-      cv_mem->cv_qprime = cv_mem->cv_q + 1;
+    *eta = etaq;
+    return (0);
+  }
 
-      if (cv_mem->cv_lmm == CV_BDF)
-      {
-        /*
-         * Store Delta_n in zn[qmax] to be used in order increase
-         *
-         * This happens at the last step of order q before an increase
-         * to order q+1, so it represents Delta_n in the ELTE at q+1
-         */
-
-        N_VScale(ONE, cv_mem->cv_acor, cv_mem->cv_zn[cv_mem->cv_qmax]);
-      }
-    }
+  if (etam == etaqm1)
+  {
+    *eta = etaqm1;
+    return (-1);
   }
+
+  *eta = etaqp1;
+  return (1);
 }
 
 /*
@@ -0,0 +1,2848 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the batched ensemble mode of
+ * CVODE, CVODE_ENSEMBLE.
+ *
+ * Each system of the ensemble is integrated with the BDF method
+ * using the step size and order selection of cvStep (cvode.c), the
+ * Newton iteration of SUNNonlinSol_Newton with the convergence test
+ * of cvode_nls.c, and the dense direct linear solver path of
+ * cvode_ls.c. The BDF coefficients, the step size and order choices,
+ * the linear solver setup decision, and the Newton convergence test
+ * are computed by the step control kernels that cvStep itself uses
+ * (see cvode_impl.h), so only the batched vector and matrix
+ * operations are specific to this file.
+ *
+ * The systems advance in lockstep rounds: in each round every
+ * system still integrating towards tout performs one Newton
+ * iteration, so that a single call to the user's right-hand side
+ * (and Jacobian) function serves all of them. Systems that do not
+ * take part in an evaluation are masked out.
+ *
+ * The vector kernels of the Newton iteration (residual, batched LU
+ * factorization and solve, norms) loop over the systems innermost
+ * on the structure-of-arrays data. The remaining step control
+ * operations act on one system at a time.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sundials/sundials_math.h>
+
+#include "cvode_ensemble_impl.h"
+#include "cvode_ls_impl.h"
+
+/*
+ * -----------------------------------------------------------------
+ * Private constants
+ * -----------------------------------------------------------------
+ */
+
+#define ZERO   SUN_RCONST(0.0)
+#define POINT2 SUN_RCONST(0.2)
+#define HALF   SUN_RCONST(0.5)
+#define ONE    SUN_RCONST(1.0)
+#define TWO    SUN_RCONST(2.0)
+
+/* Tolerance types (see cvode.c) */
+#define CV_NN 0
+#define CV_SS 1
+#define CV_SV 2
+
+/* Initial step size selection (see cvHin in cvode.c) */
+#define FUZZ_FACTOR SUN_RCONST(100.0)
+#define HLB_FACTOR  SUN_RCONST(100.0)
+#define HUB_FACTOR  SUN_RCONST(0.1)
+#define H_BIAS      HALF
+#define MAX_ITERS   4
+
+/* Newton iteration (see cvode.c and cvode_nls.c) */
+#define CORTES     SUN_RCONST(0.1)
+#define NLS_MAXCOR 3
+
+/* Difference quotient Jacobian (see cvode_ls.c) */
+#define MIN_INC_MULT SUN_RCONST(1000.0)
+
+/* Position of a system in the step loop of CVodeEnsemble */
+#define CVENS_NEW_STEP 0 /* about to start a new step             */
+#define CVENS_PREDICT  1 /* about to (re)attempt the current step */
+#define CVENS_NEWTON   2 /* in the Newton iteration               */
+#define CVENS_RESTART  3 /* needs f to reload zn[1] at order 1    */
+#define CVENS_DONE     4 /* reached tout or failed                */
+
+/* Index of component i of system s in the ensemble vectors */
+#define IDX(i, s) ((i) * M + (s))
+
+/* Index of entry (i,j) of the matrix of system s */
+#define MIDX(i, j, s) (((j) * N + (i)) * M + (s))
+
+/*
+ * -----------------------------------------------------------------
+ * Private functions
+ * -----------------------------------------------------------------
+ */
+
+static sunbooleantype cvEnsCheckNvector(CVodeEnsembleMem ens_mem, N_Vector v);
+static sunbooleantype cvEnsAllocVectors(CVodeEnsembleMem ens_mem,
+                                        N_Vector tmpl);
+static void cvEnsFreeVectors(CVodeEnsembleMem ens_mem);
+static void cvEnsReset(CVodeEnsembleMem ens_mem, sunrealtype t0, N_Vector y0);
+
+static sunindextype cvEnsSetActive(CVodeEnsembleMem ens_mem, int phase);
+static void cvEnsFail(CVodeEnsembleMem ens_mem, sunindextype s, int flag);
+static void cvEnsEwtSet(CVodeEnsembleMem ens_mem);
+static void cvEnsWrmsNorms(CVodeEnsembleMem ens_mem, N_Vector x);
+static sunrealtype cvEnsWrmsNorm(CVodeEnsembleMem ens_mem, sunindextype s,
+                                 N_Vector x);
+
+static int cvEnsInitialStep(CVodeEnsembleMem ens_mem, sunrealtype tout);
+static int cvEnsHin(CVodeEnsembleMem ens_mem, sunrealtype tout);
+
+static void cvEnsBeginSteps(CVodeEnsembleMem ens_mem, sunrealtype tout);
+static void cvEnsAdjustOrder(CVodeEnsembleMem ens_mem, sunindextype s,
+                             int deltaq);
+static void cvEnsIncreaseBDF(CVodeEnsembleMem ens_mem, sunindextype s);
+static void cvEnsDecreaseBDF(CVodeEnsembleMem ens_mem, sunindextype s);
+static void cvEnsRescale(CVodeEnsembleMem ens_mem, sunindextype s);
+static void cvEnsRestore(CVodeEnsembleMem ens_mem, sunindextype s);
+static void cvEnsPredict(CVodeEnsembleMem ens_mem);
+static void cvEnsSet(CVodeEnsembleMem ens_mem, sunindextype s);
+
+static int cvEnsNlsIteration(CVodeEnsembleMem ens_mem);
+static void cvEnsLinSetup(CVodeEnsembleMem ens_mem);
+static int cvEnsDenseDQJac(CVodeEnsembleMem ens_mem);
+static void cvEnsDenseGETRF(CVodeEnsembleMem ens_mem);
+static void cvEnsDenseGETRS(CVodeEnsembleMem ens_mem, N_Vector b);
+static void cvEnsNlsFail(CVodeEnsembleMem ens_mem, sunindextype s, int nflag);
+static void cvEnsHandleNFlag(CVodeEnsembleMem ens_mem, sunindextype s,
+                             int nflag);
+
+static void cvEnsDoErrorTest(CVodeEnsembleMem ens_mem, sunindextype s);
+static int cvEnsRestartOrder1(CVodeEnsembleMem ens_mem);
+static void cvEnsCompleteStep(CVodeEnsembleMem ens_mem, sunindextype s);
+static void cvEnsPrepareNextStep(CVodeEnsembleMem ens_mem, sunindextype s,
+                                 sunrealtype dsm);
+static void cvEnsSetEta(CVodeEnsembleMem ens_mem, sunindextype s);
+static sunrealtype cvEnsComputeEtaqm1(CVodeEnsembleMem ens_mem,
+                                      sunindextype s);
+static sunrealtype cvEnsComputeEtaqp1(CVodeEnsembleMem ens_mem,
+                                      sunindextype s);
+static void cvEnsChooseEta(CVodeEnsembleMem ens_mem, sunindextype s);
+
+static void cvEnsProcessError(CVodeEnsembleMem ens_mem, int error_code,
+                              int line, const char* func, const char* file,
+                              const char* msgfmt, ...);
+
+/*
+ * =================================================================
+ * Exported functions -- creation, initialization, and options
+ * =================================================================
+ */
+
+/*
+ * CVodeEnsembleCreate
+ *
+ * CVodeEnsembleCreate allocates the ensemble memory and the
+ * per-system data for nsystems systems of nstates states each.
+ * If an error occurs, an error message is issued and NULL is
+ * returned.
+ */
+
+void* CVodeEnsembleCreate(sunindextype nstates, sunindextype nsystems,
+                          SUNContext sunctx)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype N, M;
+
+  if (sunctx == NULL)
+  {
+    cvEnsProcessError(NULL, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  if ((nstates <= 0) || (nsystems <= 0))
+  {
+    cvEnsProcessError(NULL, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGENS_BAD_SIZES);
+    return (NULL);
+  }
+
+  ens_mem = (CVodeEnsembleMem)malloc(sizeof(struct CVodeEnsembleMemRec));
+  if (ens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSGCV_CVMEM_FAIL);
+    return (NULL);
+  }
+
+  /* Zero out ens_mem */
+  memset(ens_mem, 0, sizeof(struct CVodeEnsembleMemRec));
+
+  N = nstates;
+  M = nsystems;
+
+  ens_mem->sunctx   = sunctx;
+  ens_mem->uround   = SUN_UNIT_ROUNDOFF;
+  ens_mem->nstates  = N;
+  ens_mem->nsystems = M;
+
+  /* Set default values for the optional inputs */
+  ens_mem->itol   = CV_NN;
+  ens_mem->qmax   = BDF_Q_MAX;
+  ens_mem->mxstep = MXSTEP_DEFAULT;
+  ens_mem->hin    = ZERO;
+
+  /* Allocate the per-system data and the batched matrices */
+  ens_mem->sys    = (CVEnsSys)calloc(M, sizeof(CVEnsSysRec));
+  ens_mem->t      = (sunrealtype*)malloc(M * sizeof(sunrealtype));
+  ens_mem->active = (sunbooleantype*)malloc(M * sizeof(sunbooleantype));
+  ens_mem->ctmp1  = (sunrealtype*)malloc(M * sizeof(sunrealtype));
+  ens_mem->ctmp2  = (sunrealtype*)malloc(M * sizeof(sunrealtype));
+  ens_mem->nrm    = (sunrealtype*)malloc(M * sizeof(sunrealtype));
+  ens_mem->iwork  = (int*)malloc(M * sizeof(int));
+  ens_mem->J      = (sunrealtype*)malloc(N * N * M * sizeof(sunrealtype));
+  ens_mem->A      = (sunrealtype*)malloc(N * N * M * sizeof(sunrealtype));
+  ens_mem->piv    = (sunindextype*)malloc(N * M * sizeof(sunindextype));
+
+  if ((ens_mem->sys == NULL) || (ens_mem->t == NULL) ||
+      (ens_mem->active == NULL) || (ens_mem->ctmp1 == NULL) ||
+      (ens_mem->ctmp2 == NULL) || (ens_mem->nrm == NULL) ||
+      (ens_mem->iwork == NULL) || (ens_mem->J == NULL) ||
+      (ens_mem->A == NULL) || (ens_mem->piv == NULL))
+  {
+    cvEnsProcessError(NULL, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSGCV_CVMEM_FAIL);
+    CVodeEnsembleFree((void**)&ens_mem);
+    return (NULL);
+  }
+
+  return ((void*)ens_mem);
+}
+
+/*
+ * CVodeEnsembleInit
+ *
+ * CVodeEnsembleInit allocates the ensemble vectors, cloned from y0,
+ * and initializes every system at (t0, y0). The vector y0 must
+ * provide N_VGetArrayPointer and have length nstates * nsystems.
+ */
+
+int CVodeEnsembleInit(void* cvens_mem, CVEnsRhsFn f, sunrealtype t0,
+                      N_Vector y0)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  if (y0 == NULL)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_NULL_Y0);
+    return (CV_ILL_INPUT);
+  }
+
+  if (f == NULL)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_NULL_F);
+    return (CV_ILL_INPUT);
+  }
+
+  if (!cvEnsCheckNvector(ens_mem, y0))
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGENS_BAD_NVECTOR);
+    return (CV_ILL_INPUT);
+  }
+
+  /* Free the vectors of a previous initialization */
+  if (ens_mem->MallocDone) { cvEnsFreeVectors(ens_mem); }
+  ens_mem->MallocDone = SUNFALSE;
+
+  if (!cvEnsAllocVectors(ens_mem, y0))
+  {
+    cvEnsProcessError(ens_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSGCV_MEM_FAIL);
+    return (CV_MEM_FAIL);
+  }
+
+  ens_mem->f = f;
+
+  cvEnsReset(ens_mem, t0, y0);
+
+  ens_mem->MallocDone = SUNTRUE;
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVodeEnsembleReInit
+ *
+ * CVodeEnsembleReInit restarts every system of the ensemble at
+ * (t0, y0), keeping the right-hand side, tolerances, and options.
+ */
+
+int CVodeEnsembleReInit(void* cvens_mem, sunrealtype t0, N_Vector y0)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  if (ens_mem->MallocDone == SUNFALSE)
+  {
+    cvEnsProcessError(ens_mem, CV_NO_MALLOC, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MALLOC);
+    return (CV_NO_MALLOC);
+  }
+
+  if (y0 == NULL)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_NULL_Y0);
+    return (CV_ILL_INPUT);
+  }
+
+  if (!cvEnsCheckNvector(ens_mem, y0))
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGENS_BAD_NVECTOR);
+    return (CV_ILL_INPUT);
+  }
+
+  cvEnsReset(ens_mem, t0, y0);
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVodeEnsembleSStolerances and CVodeEnsembleSVtolerances
+ *
+ * These functions specify the integration tolerances, shared by all
+ * systems. With CVodeEnsembleSVtolerances the absolute tolerance
+ * vector is packed like the state and so may differ per system.
+ */
+
+int CVodeEnsembleSStolerances(void* cvens_mem, sunrealtype reltol,
+                              sunrealtype abstol)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  if (reltol < ZERO)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_BAD_RELTOL);
+    return (CV_ILL_INPUT);
+  }
+
+  if (abstol < ZERO)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_BAD_ABSTOL);
+    return (CV_ILL_INPUT);
+  }
+
+  ens_mem->reltol  = reltol;
+  ens_mem->Sabstol = abstol;
+  ens_mem->itol    = CV_SS;
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleSVtolerances(void* cvens_mem, sunrealtype reltol,
+                              N_Vector abstol)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  if (reltol < ZERO)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_BAD_RELTOL);
+    return (CV_ILL_INPUT);
+  }
+
+  if (abstol == NULL)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_NULL_ABSTOL);
+    return (CV_ILL_INPUT);
+  }
+
+  if (!cvEnsCheckNvector(ens_mem, abstol))
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGENS_BAD_NVECTOR);
+    return (CV_ILL_INPUT);
+  }
+
+  if (N_VMin(abstol) < ZERO)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_BAD_ABSTOL);
+    return (CV_ILL_INPUT);
+  }
+
+  if (ens_mem->Vabstol == NULL)
+  {
+    ens_mem->Vabstol = N_VClone(abstol);
+    if (ens_mem->Vabstol == NULL)
+    {
+      cvEnsProcessError(ens_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                        MSGCV_MEM_FAIL);
+      return (CV_MEM_FAIL);
+    }
+  }
+
+  ens_mem->reltol = reltol;
+  N_VScale(ONE, abstol, ens_mem->Vabstol);
+  ens_mem->itol = CV_SV;
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * Optional input functions
+ */
+
+int CVodeEnsembleSetUserData(void* cvens_mem, void* user_data)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  ens_mem->user_data = user_data;
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleSetJacFn(void* cvens_mem, CVEnsJacFn jac)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  /* A NULL jac selects the internal difference quotient Jacobian */
+  ens_mem->jac = jac;
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleSetMaxOrd(void* cvens_mem, int maxord)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  if ((maxord <= 0) || (maxord > BDF_Q_MAX))
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGENS_BAD_MAXORD);
+    return (CV_ILL_INPUT);
+  }
+
+  ens_mem->qmax = maxord;
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleSetMaxNumSteps(void* cvens_mem, long int mxsteps)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  /* Passing mxsteps=0 sets the default. Passing mxsteps<0 disables the test. */
+  if (mxsteps == 0) { ens_mem->mxstep = MXSTEP_DEFAULT; }
+  else { ens_mem->mxstep = mxsteps; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleSetInitStep(void* cvens_mem, sunrealtype hin)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  ens_mem->hin = hin;
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * =================================================================
+ * Exported function -- main solver
+ * =================================================================
+ */
+
+/*
+ * CVodeEnsemble
+ *
+ * This routine integrates every system of the ensemble to tout and
+ * returns the interpolated solutions in yout. Systems that have not
+ * taken a step yet are first initialized (f at t0 and the initial
+ * step size). The remaining work proceeds in rounds, each of which
+ * (1) starts a new step for the systems that completed the previous
+ * one, (2) predicts the systems starting a step attempt, and (3)
+ * performs one Newton iteration for all systems in the corrector,
+ * followed by the error test for those that converged.
+ *
+ * A system that fails keeps its solution at its current time (see
+ * CVodeEnsembleGetCurrentTime) in yout. The per-system return flags
+ * are available from CVodeEnsembleGetReturnFlags; the function
+ * returns CV_SUCCESS if all systems reached tout and otherwise the
+ * flag of the first failed system.
+ */
+
+int CVodeEnsemble(void* cvens_mem, sunrealtype tout, N_Vector yout,
+                  sunrealtype* tret)
+{
+  CVodeEnsembleMem ens_mem;
+  CVEnsSys sp;
+  sunindextype i, s, N, M, nfail, sfail;
+  sunrealtype *yd, *zd[L_MAX];
+  sunrealtype tfuzz, tp, tn1, r;
+  int j, retval;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  if (ens_mem->MallocDone == SUNFALSE)
+  {
+    cvEnsProcessError(ens_mem, CV_NO_MALLOC, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MALLOC);
+    return (CV_NO_MALLOC);
+  }
+
+  if (yout == NULL)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_YOUT_NULL);
+    return (CV_ILL_INPUT);
+  }
+
+  if (tret == NULL)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_TRET_NULL);
+    return (CV_ILL_INPUT);
+  }
+
+  if (!cvEnsCheckNvector(ens_mem, yout))
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGENS_BAD_NVECTOR);
+    return (CV_ILL_INPUT);
+  }
+
+  if (ens_mem->itol == CV_NN)
+  {
+    cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSGCV_NO_TOL);
+    return (CV_ILL_INPUT);
+  }
+
+  N = ens_mem->nstates;
+  M = ens_mem->nsystems;
+
+  for (s = 0; s < M; s++)
+  {
+    ens_mem->sys[s].flag   = CV_SUCCESS;
+    ens_mem->sys[s].phase  = CVENS_NEW_STEP;
+    ens_mem->sys[s].nstloc = 0;
+  }
+
+  /* Initialize the systems that have not started yet, then take steps
+     until every system reached tout or failed */
+
+  retval = cvEnsInitialStep(ens_mem, tout);
+
+  while (retval == CV_SUCCESS)
+  {
+    cvEnsBeginSteps(ens_mem, tout);
+    cvEnsPredict(ens_mem);
+
+    if (cvEnsSetActive(ens_mem, CVENS_NEWTON) == 0) { break; }
+
+    retval = cvEnsNlsIteration(ens_mem);
+    if (retval == CV_SUCCESS) { retval = cvEnsRestartOrder1(ens_mem); }
+  }
+
+  /* An unrecoverable failure of f stops every system still running */
+  if (retval != CV_SUCCESS)
+  {
+    if (retval == CV_RHSFUNC_FAIL)
+    {
+      cvEnsProcessError(ens_mem, retval, __LINE__, __func__, __FILE__,
+                        MSGCV_RHSFUNC_FAILED, tout);
+    }
+    for (s = 0; s < M; s++)
+    {
+      sp = &(ens_mem->sys[s]);
+      if (sp->phase == CVENS_NEWTON) { cvEnsRestore(ens_mem, s); }
+      if (sp->phase != CVENS_DONE) { cvEnsFail(ens_mem, s, retval); }
+    }
+  }
+
+  /* Load yout: interpolate the systems that reached tout (see
+     CVodeGetDky) and copy zn[0] for the others */
+
+  yd = N_VGetArrayPointer(yout);
+  for (j = 0; j <= ens_mem->qmax; j++)
+  {
+    zd[j] = N_VGetArrayPointer(ens_mem->zn[j]);
+  }
+
+  nfail = 0;
+  sfail = -1;
+  for (s = 0; s < M; s++)
+  {
+    sp = &(ens_mem->sys[s]);
+
+    if (sp->flag == CV_SUCCESS)
+    {
+      tfuzz = FUZZ_FACTOR * ens_mem->uround *
+              (SUNRabs(sp->tn) + SUNRabs(sp->hu));
+      if (sp->hu < ZERO) { tfuzz = -tfuzz; }
+      tp  = sp->tn - sp->hu - tfuzz;
+      tn1 = sp->tn + tfuzz;
+      if ((tout - tp) * (tout - tn1) > ZERO)
+      {
+        cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                          MSGENS_BAD_TOUT, (long int)s, tout);
+        sp->flag = CV_ILL_INPUT;
+      }
+    }
+
+    if (sp->flag == CV_SUCCESS)
+    {
+      r = (tout - sp->tn) / sp->h;
+      for (i = 0; i < N; i++) { yd[IDX(i, s)] = zd[sp->q][IDX(i, s)]; }
+      for (j = sp->q - 1; j >= 0; j--)
+      {
+        for (i = 0; i < N; i++)
+        {
+          yd[IDX(i, s)] = r * yd[IDX(i, s)] + zd[j][IDX(i, s)];
+        }
+      }
+    }
+    else
+    {
+      for (i = 0; i < N; i++) { yd[IDX(i, s)] = zd[0][IDX(i, s)]; }
+      if (nfail == 0) { sfail = s; }
+      nfail++;
+    }
+  }
+
+  *tret = tout;
+
+  if (nfail > 0)
+  {
+    cvEnsProcessError(ens_mem, ens_mem->sys[sfail].flag, __LINE__, __func__,
+                      __FILE__, MSGENS_SYS_FAILED, (long int)nfail,
+                      (long int)sfail);
+    return (ens_mem->sys[sfail].flag);
+  }
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * =================================================================
+ * Exported functions -- optional outputs and free
+ * =================================================================
+ */
+
+int CVodeEnsembleGetReturnFlags(void* cvens_mem, int* flags)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++) { flags[s] = ens_mem->sys[s].flag; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetCurrentTime(void* cvens_mem, sunrealtype* tcur)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++) { tcur[s] = ens_mem->sys[s].tn; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetCurrentStep(void* cvens_mem, sunrealtype* hcur)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++) { hcur[s] = ens_mem->sys[s].h; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetLastOrder(void* cvens_mem, int* qlast)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++) { qlast[s] = ens_mem->sys[s].qu; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetNumSteps(void* cvens_mem, long int* nsteps)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++) { nsteps[s] = ens_mem->sys[s].nst; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetNumErrTestFails(void* cvens_mem, long int* netfails)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++)
+  {
+    netfails[s] = ens_mem->sys[s].netf;
+  }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetNumNonlinSolvIters(void* cvens_mem, long int* nniters)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++) { nniters[s] = ens_mem->sys[s].nni; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetNumNonlinSolvConvFails(void* cvens_mem, long int* nncfails)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++)
+  {
+    nncfails[s] = ens_mem->sys[s].ncfn;
+  }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetNumJacEvals(void* cvens_mem, long int* njevals)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++) { njevals[s] = ens_mem->sys[s].nje; }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetNumLinSolvSetups(void* cvens_mem, long int* nlinsetups)
+{
+  CVodeEnsembleMem ens_mem;
+  sunindextype s;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  for (s = 0; s < ens_mem->nsystems; s++)
+  {
+    nlinsetups[s] = ens_mem->sys[s].nsetups;
+  }
+
+  return (CV_SUCCESS);
+}
+
+int CVodeEnsembleGetNumRhsEvals(void* cvens_mem, long int* nfevals)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (cvens_mem == NULL)
+  {
+    cvEnsProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__,
+                      MSGENS_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  ens_mem = (CVodeEnsembleMem)cvens_mem;
+
+  *nfevals = ens_mem->nfe;
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVodeEnsembleFree
+ *
+ * This routine frees the ensemble memory and sets *cvens_mem to
+ * NULL.
+ */
+
+void CVodeEnsembleFree(void** cvens_mem)
+{
+  CVodeEnsembleMem ens_mem;
+
+  if (*cvens_mem == NULL) { return; }
+
+  ens_mem = (CVodeEnsembleMem)(*cvens_mem);
+
+  cvEnsFreeVectors(ens_mem);
+  if (ens_mem->Vabstol != NULL) { N_VDestroy(ens_mem->Vabstol); }
+
+  free(ens_mem->sys);
+  free(ens_mem->t);
+  free(ens_mem->active);
+  free(ens_mem->ctmp1);
+  free(ens_mem->ctmp2);
+  free(ens_mem->nrm);
+  free(ens_mem->iwork);
+  free(ens_mem->J);
+  free(ens_mem->A);
+  free(ens_mem->piv);
+
+  free(*cvens_mem);
+  *cvens_mem = NULL;
+}
+
+/*
+ * =================================================================
+ * Private functions -- memory and bookkeeping
+ * =================================================================
+ */
+
+/*
+ * cvEnsCheckNvector
+ *
+ * This routine checks that v exposes its data and holds the whole
+ * ensemble.
+ */
+
+static sunbooleantype cvEnsCheckNvector(CVodeEnsembleMem ens_mem, N_Vector v)
+{
+  if ((v->ops->nvgetarraypointer == NULL) || (v->ops->nvgetlength == NULL))
+  {
+    return (SUNFALSE);
+  }
+  if (N_VGetLength(v) != ens_mem->nstates * ens_mem->nsystems)
+  {
+    return (SUNFALSE);
+  }
+  return (N_VGetArrayPointer(v) != NULL);
+}
+
+/*
+ * cvEnsAllocVectors
+ *
+ * This routine allocates the ensemble vectors, cloned from tmpl. If
+ * any allocation fails, the vectors allocated so far are freed and
+ * SUNFALSE is returned.
+ */
+
+static sunbooleantype cvEnsAllocVectors(CVodeEnsembleMem ens_mem,
+                                        N_Vector tmpl)
+{
+  int j;
+
+  ens_mem->ewt   = N_VClone(tmpl);
+  ens_mem->y     = N_VClone(tmpl);
+  ens_mem->acor  = N_VClone(tmpl);
+  ens_mem->tempv = N_VClone(tmpl);
+  ens_mem->ftemp = N_VClone(tmpl);
+  for (j = 0; j <= BDF_Q_MAX; j++) { ens_mem->zn[j] = N_VClone(tmpl); }
+
+  if ((ens_mem->ewt == NULL) || (ens_mem->y == NULL) ||
+      (ens_mem->acor == NULL) || (ens_mem->tempv == NULL) ||
+      (ens_mem->ftemp == NULL))
+  {
+    cvEnsFreeVectors(ens_mem);
+    return (SUNFALSE);
+  }
+  for (j = 0; j <= BDF_Q_MAX; j++)
+  {
+    if (ens_mem->zn[j] == NULL)
+    {
+      cvEnsFreeVectors(ens_mem);
+      return (SUNFALSE);
+    }
+  }
+
+  return (SUNTRUE);
+}
+
+/*
+ * cvEnsFreeVectors
+ *
+ * This routine frees the ensemble vectors allocated in
+ * cvEnsAllocVectors.
+ */
+
+static void cvEnsFreeVectors(CVodeEnsembleMem ens_mem)
+{
+  int j;
+
+  if (ens_mem->ewt != NULL) { N_VDestroy(ens_mem->ewt); }
+  if (ens_mem->y != NULL) { N_VDestroy(ens_mem->y); }
+  if (ens_mem->acor != NULL) { N_VDestroy(ens_mem->acor); }
+  if (ens_mem->tempv != NULL) { N_VDestroy(ens_mem->tempv); }
+  if (ens_mem->ftemp != NULL) { N_VDestroy(ens_mem->ftemp); }
+  ens_mem->ewt   = NULL;
+  ens_mem->y     = NULL;
+  ens_mem->acor  = NULL;
+  ens_mem->tempv = NULL;
+  ens_mem->ftemp = NULL;
+
+  for (j = 0; j <= BDF_Q_MAX; j++)
+  {
+    if (ens_mem->zn[j] != NULL) { N_VDestroy(ens_mem->zn[j]); }
+    ens_mem->zn[j] = NULL;
+  }
+}
+
+/*
+ * cvEnsReset
+ *
+ * This routine loads zn[0] with y0 and sets the step data and
+ * counters of every system as CVodeInit does.
+ */
+
+static void cvEnsReset(CVodeEnsembleMem ens_mem, sunrealtype t0, N_Vector y0)
+{
+  sunindextype s;
+  CVEnsSys sp;
+
+  /* y also holds valid states for the systems inactive in a call to f */
+  N_VScale(ONE, y0, ens_mem->zn[0]);
+  N_VScale(ONE, y0, ens_mem->y);
+
+  for (s = 0; s < ens_mem->nsystems; s++)
+  {
+    sp = &(ens_mem->sys[s]);
+    memset(sp, 0, sizeof(CVEnsSysRec));
+
+    sp->tn     = t0;
+    sp->q      = 1;
+    sp->L      = 2;
+    sp->qwait  = sp->L;
+    sp->etamax = ETA_MAX_FS_DEFAULT;
+    sp->flag   = CV_SUCCESS;
+  }
+
+  ens_mem->nfe = 0;
+}
+
+/*
+ * cvEnsSetActive
+ *
+ * This routine sets the active mask (and the time argument of f)
+ * to the systems in the given phase and returns their number.
+ */
+
+static sunindextype cvEnsSetActive(CVodeEnsembleMem ens_mem, int phase)
+{
+  sunindextype s, nactive;
+
+  nactive = 0;
+  for (s = 0; s < ens_mem->nsystems; s++)
+  {
+    ens_mem->active[s] = (ens_mem->sys[s].phase == phase);
+    ens_mem->t[s]      = ens_mem->sys[s].tn;
+    if (ens_mem->active[s]) { nactive++; }
+  }
+
+  return (nactive);
+}
+
+/*
+ * cvEnsFail
+ *
+ * This routine stops system s with the given return flag.
+ */
+
+static void cvEnsFail(CVodeEnsembleMem ens_mem, sunindextype s, int flag)
+{
+  ens_mem->sys[s].flag  = flag;
+  ens_mem->sys[s].phase = CVENS_DONE;
+}
+
+/*
+ * cvEnsEwtSet
+ *
+ * This routine computes the error weights of the active systems,
+ * ewt = 1 / (reltol * |zn[0]| + abstol). A system with a weight
+ * denominator <= 0 fails with CV_ILL_INPUT.
+ */
+
+static void cvEnsEwtSet(CVodeEnsembleMem ens_mem)
+{
+  sunindextype i, s, N, M;
+  sunrealtype *zd, *wd, *ad, *tmin;
+  sunrealtype tmp;
+
+  N    = ens_mem->nstates;
+  M    = ens_mem->nsystems;
+  zd   = N_VGetArrayPointer(ens_mem->zn[0]);
+  wd   = N_VGetArrayPointer(ens_mem->ewt);
+  ad   = (ens_mem->itol == CV_SV) ? N_VGetArrayPointer(ens_mem->Vabstol) : NULL;
+  tmin = ens_mem->ctmp1;
+
+  for (s = 0; s < M; s++) { tmin[s] = SUN_BIG_REAL; }
+
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (!ens_mem->active[s]) { continue; }
+      tmp = ens_mem->reltol * SUNRabs(zd[IDX(i, s)]) +
+            ((ad != NULL) ? ad[IDX(i, s)] : ens_mem->Sabstol);
+      tmin[s]        = SUNMIN(tmin[s], tmp);
+      wd[IDX(i, s)] = ONE / tmp;
+    }
+  }
+
+  for (s = 0; s < M; s++)
+  {
+    if (ens_mem->active[s] && (tmin[s] <= ZERO))
+    {
+      cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                        MSGCV_EWT_NOW_BAD, ens_mem->sys[s].tn);
+      cvEnsFail(ens_mem, s, CV_ILL_INPUT);
+      ens_mem->active[s] = SUNFALSE;
+    }
+  }
+}
+
+/*
+ * cvEnsWrmsNorms
+ *
+ * This routine computes the weighted RMS norm of x for each active
+ * system and stores it in nrm.
+ */
+
+static void cvEnsWrmsNorms(CVodeEnsembleMem ens_mem, N_Vector x)
+{
+  sunindextype i, s, N, M;
+  sunrealtype *xd, *wd, *nrm;
+
+  N   = ens_mem->nstates;
+  M   = ens_mem->nsystems;
+  xd  = N_VGetArrayPointer(x);
+  wd  = N_VGetArrayPointer(ens_mem->ewt);
+  nrm = ens_mem->nrm;
+
+  for (s = 0; s < M; s++) { nrm[s] = ZERO; }
+
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (ens_mem->active[s])
+      {
+        nrm[s] += SUNSQR(xd[IDX(i, s)] * wd[IDX(i, s)]);
+      }
+    }
+  }
+
+  for (s = 0; s < M; s++) { nrm[s] = SUNRsqrt(nrm[s] / N); }
+}
+
+/*
+ * cvEnsWrmsNorm
+ *
+ * This routine returns the weighted RMS norm of x for system s.
+ */
+
+static sunrealtype cvEnsWrmsNorm(CVodeEnsembleMem ens_mem, sunindextype s,
+                                 N_Vector x)
+{
+  sunindextype i, N, M;
+  sunrealtype *xd, *wd, sum;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  xd = N_VGetArrayPointer(x);
+  wd = N_VGetArrayPointer(ens_mem->ewt);
+
+  sum = ZERO;
+  for (i = 0; i < N; i++) { sum += SUNSQR(xd[IDX(i, s)] * wd[IDX(i, s)]); }
+
+  return (SUNRsqrt(sum / N));
+}
+
+/*
+ * =================================================================
+ * Private functions -- initial step
+ * =================================================================
+ */
+
+/*
+ * cvEnsInitialStep
+ *
+ * This routine performs the first call initializations of CVode for
+ * the systems that have not started yet (h = 0): it computes ewt,
+ * loads zn[1] = f(t0, y0) with one batched call, sets the initial
+ * step size (from hin or cvEnsHin), and scales zn[1] by h.
+ *
+ * A positive return from f fails the affected systems with
+ * CV_FIRST_RHSFUNC_ERR; a negative return is passed back as
+ * CV_RHSFUNC_FAIL.
+ */
+
+static int cvEnsInitialStep(CVodeEnsembleMem ens_mem, sunrealtype tout)
+{
+  sunindextype i, s, N, M;
+  sunrealtype *zd, *fd;
+  CVEnsSys sp;
+  int retval;
+
+  N = ens_mem->nstates;
+  M = ens_mem->nsystems;
+
+  cvEnsSetActive(ens_mem, CVENS_NEW_STEP);
+  for (s = 0; s < M; s++)
+  {
+    ens_mem->active[s] = ens_mem->active[s] && (ens_mem->sys[s].h == ZERO);
+  }
+
+  cvEnsEwtSet(ens_mem);
+
+  for (s = 0; s < M; s++)
+  {
+    if (ens_mem->active[s]) { break; }
+  }
+  if (s == M) { return (CV_SUCCESS); }
+
+  /* Call f at (t0,y0), set zn[1] = y'(t0) (f may write to the entries of
+     the systems that are already running, so evaluate into ftemp) */
+  retval = ens_mem->f(ens_mem->t, ens_mem->zn[0], ens_mem->ftemp,
+                      ens_mem->active, ens_mem->user_data);
+  ens_mem->nfe++;
+  if (retval < 0) { return (CV_RHSFUNC_FAIL); }
+  if (retval > 0)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (ens_mem->active[s]) { cvEnsFail(ens_mem, s, CV_FIRST_RHSFUNC_ERR); }
+    }
+    cvEnsProcessError(ens_mem, CV_FIRST_RHSFUNC_ERR, __LINE__, __func__,
+                      __FILE__, MSGCV_RHSFUNC_FIRST);
+    return (CV_SUCCESS);
+  }
+
+  zd = N_VGetArrayPointer(ens_mem->zn[1]);
+  fd = N_VGetArrayPointer(ens_mem->ftemp);
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (ens_mem->active[s]) { zd[IDX(i, s)] = fd[IDX(i, s)]; }
+    }
+  }
+
+  /* Set initial h (from hin or cvEnsHin) */
+  if (ens_mem->hin != ZERO)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (!ens_mem->active[s]) { continue; }
+      if ((tout - ens_mem->sys[s].tn) * ens_mem->hin < ZERO)
+      {
+        cvEnsProcessError(ens_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                          MSGCV_BAD_H0);
+        cvEnsFail(ens_mem, s, CV_ILL_INPUT);
+        ens_mem->active[s] = SUNFALSE;
+      }
+      else { ens_mem->sys[s].h = ens_mem->hin; }
+    }
+  }
+  else
+  {
+    for (s = 0; s < M; s++) { ens_mem->iwork[s] = ens_mem->active[s]; }
+    retval = cvEnsHin(ens_mem, tout);
+    if (retval != CV_SUCCESS) { return (retval); }
+    for (s = 0; s < M; s++)
+    {
+      ens_mem->active[s] = ens_mem->iwork[s] &&
+                           (ens_mem->sys[s].phase == CVENS_NEW_STEP);
+    }
+  }
+
+  /* Scale zn[1] by h */
+  for (s = 0; s < M; s++)
+  {
+    sp = &(ens_mem->sys[s]);
+    if (!ens_mem->active[s] || (sp->h == ZERO)) { continue; }
+    sp->hscale = sp->h;
+    sp->hprime = sp->h;
+    for (i = 0; i < N; i++) { zd[IDX(i, s)] *= sp->h; }
+  }
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * cvEnsHin
+ *
+ * This routine is the batched version of cvHin. Each active system
+ * runs the iteration of cvHin; the trial evaluations of f for all
+ * systems still iterating are combined into one call. Systems for
+ * which no initial step can be found fail with CV_TOO_CLOSE or
+ * CV_REPTD_RHSFUNC_ERR and keep h = 0.
+ */
+
+typedef struct
+{
+  sunbooleantype pending; /* still iterating?                 */
+  int sign;               /* direction of integration         */
+  int count1, count2;     /* outer and inner iteration counts */
+  sunrealtype hlb, hub;   /* bounds on |h0|                   */
+  sunrealtype hg, hs;     /* trial and last feasible |h0|     */
+  sunrealtype hnew;       /* proposed |h0|                    */
+} cvEnsHinData;
+
+static int cvEnsHin(CVodeEnsembleMem ens_mem, sunrealtype tout)
+{
+  sunindextype i, s, N, M, npending;
+  sunrealtype *z0, *z1, *yd, *wd, *td, *hubinv;
+  sunrealtype tdiff, tdist, tround, hrat, h0, yddnrm;
+  sunbooleantype finish;
+  cvEnsHinData* hd;
+  CVEnsSys sp;
+  int retval;
+
+  N      = ens_mem->nstates;
+  M      = ens_mem->nsystems;
+  z0     = N_VGetArrayPointer(ens_mem->zn[0]);
+  z1     = N_VGetArrayPointer(ens_mem->zn[1]);
+  yd     = N_VGetArrayPointer(ens_mem->y);
+  wd     = N_VGetArrayPointer(ens_mem->ewt);
+  td     = N_VGetArrayPointer(ens_mem->tempv);
+  hubinv = ens_mem->ctmp1;
+
+  hd = (cvEnsHinData*)malloc(M * sizeof(cvEnsHinData));
+  if (hd == NULL)
+  {
+    cvEnsProcessError(ens_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSGCV_MEM_FAIL);
+    return (CV_MEM_FAIL);
+  }
+
+  /* Bound based on |y0|/|y0'| (see cvUpperBoundH0) */
+  for (s = 0; s < M; s++) { hubinv[s] = ZERO; }
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (!ens_mem->active[s]) { continue; }
+      hubinv[s] = SUNMAX(hubinv[s],
+                         SUNRabs(z1[IDX(i, s)]) /
+                           (HUB_FACTOR * SUNRabs(z0[IDX(i, s)]) +
+                            ONE / wd[IDX(i, s)]));
+    }
+  }
+
+  /* Set the bounds on h0 and take their geometric mean as first trial */
+  npending = 0;
+  for (s = 0; s < M; s++)
+  {
+    sp             = &(ens_mem->sys[s]);
+    hd[s].pending = SUNFALSE;
+    if (!ens_mem->active[s]) { continue; }
+
+    tdiff  = tout - sp->tn;
+    tdist  = SUNRabs(tdiff);
+    tround = ens_mem->uround * SUNMAX(SUNRabs(sp->tn), SUNRabs(tout));
+    if ((tdiff == ZERO) || (tdist < TWO * tround))
+    {
+      cvEnsProcessError(ens_mem, CV_TOO_CLOSE, __LINE__, __func__, __FILE__,
+                        MSGCV_TOO_CLOSE);
+      cvEnsFail(ens_mem, s, CV_TOO_CLOSE);
+      continue;
+    }
+
+    hd[s].sign = (tdiff > ZERO) ? 1 : -1;
+    hd[s].hlb  = HLB_FACTOR * tround;
+    hd[s].hub  = HUB_FACTOR * tdist;
+    if (hd[s].hub * hubinv[s] > ONE) { hd[s].hub = ONE / hubinv[s]; }
+
+    hd[s].hg = SUNRsqrt(hd[s].hlb * hd[s].hub);
+
+    if (hd[s].hub < hd[s].hlb)
+    {
+      sp->h = hd[s].sign * hd[s].hg;
+      continue;
+    }
+
+    hd[s].hs      = hd[s].hg;
+    hd[s].count1  = 1;
+    hd[s].count2  = 1;
+    hd[s].pending = SUNTRUE;
+    npending++;
+  }
+
+  while (npending > 0)
+  {
+    /* Evaluate f at y = zn[0] + hg * zn[1] for the pending systems */
+    for (s = 0; s < M; s++)
+    {
+      ens_mem->active[s] = hd[s].pending;
+      ens_mem->ctmp2[s]  = hd[s].pending ? hd[s].hg * hd[s].sign : ONE;
+      ens_mem->t[s]      = ens_mem->sys[s].tn + ens_mem->ctmp2[s];
+    }
+    for (i = 0; i < N; i++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (!ens_mem->active[s]) { continue; }
+        yd[IDX(i, s)] = ens_mem->ctmp2[s] * z1[IDX(i, s)] + z0[IDX(i, s)];
+      }
+    }
+
+    retval = ens_mem->f(ens_mem->t, ens_mem->y, ens_mem->tempv,
+                        ens_mem->active, ens_mem->user_data);
+    ens_mem->nfe++;
+    if (retval < 0)
+    {
+      free(hd);
+      return (CV_RHSFUNC_FAIL);
+    }
+
+    /* Estimate ydd (see cvYddNorm) */
+    if (retval == 0)
+    {
+      for (i = 0; i < N; i++)
+      {
+        for (s = 0; s < M; s++)
+        {
+          if (!ens_mem->active[s]) { continue; }
+          td[IDX(i, s)] = (ONE / ens_mem->ctmp2[s]) *
+                          (td[IDX(i, s)] - z1[IDX(i, s)]);
+        }
+      }
+      cvEnsWrmsNorms(ens_mem, ens_mem->tempv);
+    }
+
+    for (s = 0; s < M; s++)
+    {
+      if (!hd[s].pending) { continue; }
+      finish = SUNFALSE;
+
+      if (retval > 0)
+      {
+        /* The RHS function failed recoverably; cut step size and test again */
+        hd[s].hg *= POINT2;
+        hd[s].count2++;
+        if (hd[s].count2 <= MAX_ITERS) { continue; }
+
+        /* Exit if this is the first or second pass. No recovery possible */
+        if (hd[s].count1 <= 2)
+        {
+          hd[s].pending = SUNFALSE;
+          npending--;
+          cvEnsProcessError(ens_mem, CV_REPTD_RHSFUNC_ERR, __LINE__, __func__,
+                            __FILE__, MSGCV_RHSFUNC_REPTD, ens_mem->sys[s].tn);
+          cvEnsFail(ens_mem, s, CV_REPTD_RHSFUNC_ERR);
+          continue;
+        }
+
+        /* Use the previous feasible step size */
+        hd[s].hnew = hd[s].hs;
+        finish     = SUNTRUE;
+      }
+      else
+      {
+        yddnrm = ens_mem->nrm[s];
+
+        /* The proposed step size is feasible. Save it. */
+        hd[s].hs = hd[s].hg;
+
+        /* Propose new step size */
+        hd[s].hnew = (yddnrm * hd[s].hub * hd[s].hub > TWO)
+                       ? SUNRsqrt(TWO / yddnrm)
+                       : SUNRsqrt(hd[s].hg * hd[s].hub);
+
+        hrat = hd[s].hnew / hd[s].hg;
+
+        if (hd[s].count1 == MAX_ITERS) { finish = SUNTRUE; }
+        else if ((hrat > HALF) && (hrat < TWO)) { finish = SUNTRUE; }
+        else if ((hd[s].count1 > 1) && (hrat > TWO))
+        {
+          hd[s].hnew = hd[s].hg;
+          finish     = SUNTRUE;
+        }
+        else
+        {
+          /* Send this value back through f() */
+          hd[s].hg = hd[s].hnew;
+          hd[s].count1++;
+          hd[s].count2 = 1;
+        }
+      }
+
+      if (finish)
+      {
+        /* Apply bounds, bias factor, and attach sign */
+        h0 = H_BIAS * hd[s].hnew;
+        if (h0 < hd[s].hlb) { h0 = hd[s].hlb; }
+        if (h0 > hd[s].hub) { h0 = hd[s].hub; }
+        ens_mem->sys[s].h = hd[s].sign * h0;
+        hd[s].pending     = SUNFALSE;
+        npending--;
+      }
+    }
+  }
+
+  for (s = 0; s < M; s++) { ens_mem->t[s] = ens_mem->sys[s].tn; }
+
+  free(hd);
+  return (CV_SUCCESS);
+}
+
+/*
+ * =================================================================
+ * Private functions -- step setup and prediction
+ * =================================================================
+ */
+
+/*
+ * cvEnsBeginSteps
+ *
+ * This routine starts a new step for every system in the NEW_STEP
+ * phase: systems that passed tout are done, the others are checked
+ * against mxstep, get a new ewt, and apply the step size and order
+ * chosen at the end of their previous step (see cvAdjustParams).
+ */
+
+static void cvEnsBeginSteps(CVodeEnsembleMem ens_mem, sunrealtype tout)
+{
+  sunindextype s, M;
+  CVEnsSys sp;
+
+  M = ens_mem->nsystems;
+
+  for (s = 0; s < M; s++)
+  {
+    sp = &(ens_mem->sys[s]);
+    if (sp->phase != CVENS_NEW_STEP) { continue; }
+
+    /* Test if tout was reached */
+    if ((sp->nst > 0) && ((sp->tn - tout) * sp->h >= ZERO))
+    {
+      sp->phase = CVENS_DONE;
+      continue;
+    }
+
+    /* Check for too many steps */
+    if ((ens_mem->mxstep > 0) && (sp->nstloc >= ens_mem->mxstep))
+    {
+      cvEnsProcessError(ens_mem, CV_TOO_MUCH_WORK, __LINE__, __func__,
+                        __FILE__, MSGCV_MAX_STEPS, sp->tn);
+      cvEnsFail(ens_mem, s, CV_TOO_MUCH_WORK);
+    }
+  }
+
+  /* Reset and check ewt */
+  if (cvEnsSetActive(ens_mem, CVENS_NEW_STEP) == 0) { return; }
+  cvEnsEwtSet(ens_mem);
+
+  for (s = 0; s < M; s++)
+  {
+    sp = &(ens_mem->sys[s]);
+    if (sp->phase != CVENS_NEW_STEP) { continue; }
+
+    /* If the step size has changed, update the history array */
+    if ((sp->nst > 0) && (sp->hprime != sp->h))
+    {
+      if (sp->qprime != sp->q)
+      {
+        cvEnsAdjustOrder(ens_mem, s, sp->qprime - sp->q);
+        sp->q     = sp->qprime;
+        sp->L     = sp->q + 1;
+        sp->qwait = sp->L;
+      }
+      cvEnsRescale(ens_mem, s);
+    }
+
+    sp->saved_t = sp->tn;
+    sp->nflag   = FIRST_CALL;
+    sp->ncf     = 0;
+    sp->nef     = 0;
+    sp->phase   = CVENS_PREDICT;
+  }
+}
+
+/*
+ * cvEnsAdjustOrder
+ *
+ * This routine handles an order change by deltaq (= +1 or -1) for
+ * system s (see cvAdjustOrder and cvAdjustBDF).
+ */
+
+static void cvEnsAdjustOrder(CVodeEnsembleMem ens_mem, sunindextype s,
+                             int deltaq)
+{
+  if ((ens_mem->sys[s].q == 2) && (deltaq != 1)) { return; }
+
+  switch (deltaq)
+  {
+  case 1: cvEnsIncreaseBDF(ens_mem, s); return;
+  case -1: cvEnsDecreaseBDF(ens_mem, s); return;
+  }
+}
+
+/*
+ * cvEnsIncreaseBDF
+ *
+ * This routine adjusts the history array of system s on an increase
+ * in the order q (see cvIncreaseBDF). The saved correction is kept
+ * in zn[qmax].
+ */
+
+static void cvEnsIncreaseBDF(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunindextype i, N, M;
+  sunrealtype A1, *zL, *zq, *zj;
+  CVEnsSys sp;
+  int j;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+
+  A1 = cvIncreaseBDFCoefs(sp->q, ens_mem->qmax, sp->hscale, sp->tau, sp->l);
+
+  zL = N_VGetArrayPointer(ens_mem->zn[sp->L]);
+  zq = N_VGetArrayPointer(ens_mem->zn[ens_mem->qmax]);
+  for (i = 0; i < N; i++) { zL[IDX(i, s)] = A1 * zq[IDX(i, s)]; }
+
+  for (j = 2; j <= sp->q; j++)
+  {
+    zj = N_VGetArrayPointer(ens_mem->zn[j]);
+    for (i = 0; i < N; i++) { zj[IDX(i, s)] += sp->l[j] * zL[IDX(i, s)]; }
+  }
+}
+
+/*
+ * cvEnsDecreaseBDF
+ *
+ * This routine adjusts the history array of system s on a decrease
+ * in the order q (see cvDecreaseBDF).
+ */
+
+static void cvEnsDecreaseBDF(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunindextype i, N, M;
+  sunrealtype *zq, *zj;
+  CVEnsSys sp;
+  int j;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+
+  cvDecreaseBDFCoefs(sp->q, ens_mem->qmax, sp->hscale, sp->tau, sp->l);
+
+  zq = N_VGetArrayPointer(ens_mem->zn[sp->q]);
+  for (j = 2; j < sp->q; j++)
+  {
+    zj = N_VGetArrayPointer(ens_mem->zn[j]);
+    for (i = 0; i < N; i++) { zj[IDX(i, s)] += -sp->l[j] * zq[IDX(i, s)]; }
+  }
+}
+
+/*
+ * cvEnsRescale
+ *
+ * This routine rescales the Nordsieck array of system s by eta and
+ * resets h and hscale (see cvRescale).
+ */
+
+static void cvEnsRescale(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunindextype i, N, M;
+  sunrealtype factor, *zj;
+  CVEnsSys sp;
+  int j;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+
+  factor = sp->eta;
+  for (j = 1; j <= sp->q; j++)
+  {
+    zj = N_VGetArrayPointer(ens_mem->zn[j]);
+    for (i = 0; i < N; i++) { zj[IDX(i, s)] *= factor; }
+    factor *= sp->eta;
+  }
+
+  sp->h      = sp->hscale * sp->eta;
+  sp->hscale = sp->h;
+  sp->nscon  = 0;
+}
+
+/*
+ * cvEnsRestore
+ *
+ * This routine restores tn of system s to saved_t and undoes its
+ * prediction (see cvRestore).
+ */
+
+static void cvEnsRestore(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunindextype i, N, M;
+  sunrealtype *zj, *zjm1;
+  CVEnsSys sp;
+  int j, k;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+
+  sp->tn = sp->saved_t;
+  for (k = 1; k <= sp->q; k++)
+  {
+    for (j = sp->q; j >= k; j--)
+    {
+      zj   = N_VGetArrayPointer(ens_mem->zn[j]);
+      zjm1 = N_VGetArrayPointer(ens_mem->zn[j - 1]);
+      for (i = 0; i < N; i++) { zjm1[IDX(i, s)] -= zj[IDX(i, s)]; }
+    }
+  }
+}
+
+/*
+ * cvEnsPredict
+ *
+ * This routine starts a step attempt for every system in the
+ * PREDICT phase: it advances tn by h, computes the predicted
+ * Nordsieck array (see cvPredict), sets the method coefficients,
+ * decides whether the Newton iteration starts with a linear solver
+ * setup (see cvNls), and zeroes the correction.
+ */
+
+static void cvEnsPredict(CVodeEnsembleMem ens_mem)
+{
+  sunindextype i, s, N, M;
+  sunrealtype *zd[L_MAX], *ad;
+  int* qpred;
+  CVEnsSys sp;
+  int j, k, qmax;
+
+  N     = ens_mem->nstates;
+  M     = ens_mem->nsystems;
+  qpred = ens_mem->iwork;
+
+  /* Order of each predicted system (zero for the others) */
+  qmax = 0;
+  for (s = 0; s < M; s++)
+  {
+    sp       = &(ens_mem->sys[s]);
+    qpred[s] = (sp->phase == CVENS_PREDICT) ? sp->q : 0;
+    qmax     = SUNMAX(qmax, qpred[s]);
+    if (qpred[s] > 0) { sp->tn += sp->h; }
+  }
+  if (qmax == 0) { return; }
+
+  /* Repeated additions over all predicted systems of order >= j */
+  for (j = 0; j <= qmax; j++) { zd[j] = N_VGetArrayPointer(ens_mem->zn[j]); }
+  for (k = 1; k <= qmax; k++)
+  {
+    for (j = qmax; j >= k; j--)
+    {
+      for (i = 0; i < N; i++)
+      {
+        for (s = 0; s < M; s++)
+        {
+          if ((qpred[s] >= j) && (k <= qpred[s]))
+          {
+            zd[j - 1][IDX(i, s)] += zd[j][IDX(i, s)];
+          }
+        }
+      }
+    }
+  }
+
+  /* Initial guess for the correction */
+  ad = N_VGetArrayPointer(ens_mem->acor);
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (qpred[s] > 0) { ad[IDX(i, s)] = ZERO; }
+    }
+  }
+
+  for (s = 0; s < M; s++)
+  {
+    if (qpred[s] == 0) { continue; }
+    sp = &(ens_mem->sys[s]);
+
+    cvEnsSet(ens_mem, s);
+
+    sp->callSetup = cvNlsCallSetup(sp->nflag, sp->nst, sp->nstlp,
+                                   MSBP_DEFAULT, sp->gamrat,
+                                   DGMAX_LSETUP_DEFAULT, &(sp->convfail));
+
+    sp->curiter = 0;
+    sp->phase   = CVENS_NEWTON;
+  }
+}
+
+/*
+ * cvEnsSet
+ *
+ * This routine sets the BDF coefficients l, the test quantities tq,
+ * and rl1, gamma, and gamrat of system s (see cvSet and cvBDFCoefs).
+ */
+
+static void cvEnsSet(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  CVEnsSys sp;
+
+  sp = &(ens_mem->sys[s]);
+
+  cvBDFCoefs(sp->q, sp->qwait, sp->h, sp->tau, CORTES, sp->l, sp->tq, NULL);
+
+  sp->rl1   = ONE / sp->l[1];
+  sp->gamma = sp->h * sp->rl1;
+  if (sp->nst == 0) { sp->gammap = sp->gamma; }
+  sp->gamrat = (sp->nst > 0) ? sp->gamma / sp->gammap
+                             : ONE; /* protect x / x != 1.0 */
+}
+
+/*
+ * =================================================================
+ * Private functions -- Newton iteration and linear algebra
+ * =================================================================
+ */
+
+/*
+ * cvEnsNlsIteration
+ *
+ * This routine performs one Newton iteration for every system in
+ * the NEWTON phase (see SUNNonlinSolSolve_Newton): it evaluates the
+ * residual with one call to f, sets up the linear systems where
+ * needed, solves for the update, and applies the convergence test of
+ * cvNlsConvTest. Systems that converged go on to the error test.
+ *
+ * The return value is CV_SUCCESS or CV_RHSFUNC_FAIL.
+ */
+
+static int cvEnsNlsIteration(CVodeEnsembleMem ens_mem)
+{
+  sunindextype i, s, N, M;
+  sunrealtype *z0, *z1, *yd, *ad, *fd, *dd, *c1, *c2;
+  sunrealtype del;
+  CVEnsSys sp;
+  int retval, m;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  z0 = N_VGetArrayPointer(ens_mem->zn[0]);
+  z1 = N_VGetArrayPointer(ens_mem->zn[1]);
+  yd = N_VGetArrayPointer(ens_mem->y);
+  ad = N_VGetArrayPointer(ens_mem->acor);
+  fd = N_VGetArrayPointer(ens_mem->ftemp);
+  dd = N_VGetArrayPointer(ens_mem->tempv);
+  c1 = ens_mem->ctmp1;
+  c2 = ens_mem->ctmp2;
+
+  /* Update the state based on the current correction and evaluate f
+     (the active set holds the systems in the NEWTON phase) */
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (ens_mem->active[s]) { yd[IDX(i, s)] = z0[IDX(i, s)] + ad[IDX(i, s)]; }
+    }
+  }
+
+  retval = ens_mem->f(ens_mem->t, ens_mem->y, ens_mem->ftemp, ens_mem->active,
+                      ens_mem->user_data);
+  ens_mem->nfe++;
+  if (retval < 0) { return (CV_RHSFUNC_FAIL); }
+  if (retval > 0)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (ens_mem->active[s]) { cvEnsNlsFail(ens_mem, s, RHSFUNC_RECVR); }
+    }
+    return (CV_SUCCESS);
+  }
+
+  /* Set up the linear systems of the systems starting an attempt */
+  for (s = 0; s < M; s++)
+  {
+    ens_mem->active[s] = (ens_mem->sys[s].phase == CVENS_NEWTON) &&
+                         ens_mem->sys[s].callSetup;
+  }
+  cvEnsLinSetup(ens_mem);
+
+  /* Newton update for the systems still in the iteration */
+  for (s = 0; s < M; s++)
+  {
+    sp                 = &(ens_mem->sys[s]);
+    ens_mem->active[s] = (sp->phase == CVENS_NEWTON) && !sp->callSetup;
+    if (ens_mem->active[s])
+    {
+      sp->nni++;
+      c1[s] = sp->rl1;
+      c2[s] = -sp->gamma;
+    }
+  }
+
+  /* delta = -(rl1 * zn[1] + acor - gamma * f) */
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (!ens_mem->active[s]) { continue; }
+      dd[IDX(i, s)] = -(c2[s] * fd[IDX(i, s)] +
+                        (c1[s] * z1[IDX(i, s)] + ad[IDX(i, s)]));
+    }
+  }
+
+  cvEnsDenseGETRS(ens_mem, ens_mem->tempv);
+
+  /* Scale the correction to account for change in gamma and update the
+     Newton iterate */
+  for (s = 0; s < M; s++)
+  {
+    sp    = &(ens_mem->sys[s]);
+    c1[s] = (sp->gamrat != ONE) ? TWO / (ONE + sp->gamrat) : ONE;
+  }
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (!ens_mem->active[s]) { continue; }
+      dd[IDX(i, s)] *= c1[s];
+      ad[IDX(i, s)] += dd[IDX(i, s)];
+    }
+  }
+
+  /* Test for convergence */
+  cvEnsWrmsNorms(ens_mem, ens_mem->tempv);
+
+  for (s = 0; s < M; s++)
+  {
+    if (!ens_mem->active[s]) { continue; }
+    sp  = &(ens_mem->sys[s]);
+    del = ens_mem->nrm[s];
+    m   = sp->curiter;
+
+    retval = cvNlsConvRateTest(m, del, sp->tq[4], &(sp->crate), &(sp->delp));
+
+    sp->curiter++;
+
+    if (retval == CV_SUCCESS)
+    {
+      sp->acnrm = (m == 0) ? del : cvEnsWrmsNorm(ens_mem, s, ens_mem->acor);
+      sp->jcur  = SUNFALSE;
+      cvEnsDoErrorTest(ens_mem, s);
+      continue;
+    }
+
+    if ((retval == SUN_NLS_CONV_RECVR) || (sp->curiter >= NLS_MAXCOR))
+    {
+      cvEnsNlsFail(ens_mem, s, SUN_NLS_CONV_RECVR);
+    }
+  }
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * cvEnsLinSetup
+ *
+ * This routine sets up the linear systems M = I - gamma J of the
+ * active systems (see cvLsSetup and cvNlsLSetup). The Jacobian is
+ * reevaluated where it is considered bad and restored from the saved
+ * copy otherwise. Failures are passed to cvEnsNlsFail.
+ */
+
+static void cvEnsLinSetup(CVodeEnsembleMem ens_mem)
+{
+  sunindextype i, j, s, N, M;
+  sunrealtype *J, *A, *c1, dgamma;
+  sunbooleantype any;
+  CVEnsSys sp;
+  int* info;
+  int retval;
+
+  N    = ens_mem->nstates;
+  M    = ens_mem->nsystems;
+  J    = ens_mem->J;
+  A    = ens_mem->A;
+  c1   = ens_mem->ctmp1;
+  info = ens_mem->iwork;
+
+  /* Use nst, gamma/gammap, and convfail to decide on Jacobian updates;
+     info holds the outcome of the setup of each system */
+  any = SUNFALSE;
+  for (s = 0; s < M; s++)
+  {
+    info[s] = 0;
+    if (!ens_mem->active[s]) { continue; }
+    sp       = &(ens_mem->sys[s]);
+    dgamma   = SUNRabs((sp->gamma / sp->gammap) - ONE);
+    sp->jbad = (sp->nst == 0) || (sp->nst >= sp->nstlj + CVLS_MSBJ) ||
+               ((sp->convfail == CV_FAIL_BAD_J) && (dgamma < CVLS_DGMAX)) ||
+               (sp->convfail == CV_FAIL_OTHER);
+    ens_mem->active[s] = sp->jbad;
+    any                = any || sp->jbad;
+  }
+
+  /* Evaluate the Jacobians of the systems flagged as bad */
+  if (any)
+  {
+    if (ens_mem->jac != NULL)
+    {
+      retval = ens_mem->jac(ens_mem->t, ens_mem->y, ens_mem->ftemp, J,
+                            ens_mem->active, ens_mem->user_data);
+    }
+    else { retval = cvEnsDenseDQJac(ens_mem); }
+
+    for (s = 0; s < M; s++)
+    {
+      if (!ens_mem->active[s]) { continue; }
+      sp = &(ens_mem->sys[s]);
+      sp->nje++;
+      sp->nstlj = sp->nst;
+      if (retval != 0) { info[s] = (retval < 0) ? -1 : 1; }
+    }
+  }
+
+  /* Form A = I - gamma J for every system being set up */
+  for (s = 0; s < M; s++)
+  {
+    sp                 = &(ens_mem->sys[s]);
+    ens_mem->active[s] = (sp->phase == CVENS_NEWTON) && sp->callSetup &&
+                         (info[s] == 0);
+    c1[s]              = -sp->gamma;
+  }
+  for (j = 0; j < N; j++)
+  {
+    for (i = 0; i < N; i++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (ens_mem->active[s]) { A[MIDX(i, j, s)] = c1[s] * J[MIDX(i, j, s)]; }
+      }
+    }
+  }
+  for (i = 0; i < N; i++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (ens_mem->active[s]) { A[MIDX(i, i, s)] += ONE; }
+    }
+  }
+
+  /* Factor; a zero pivot sets info[s] > 0 (a recoverable failure) */
+  cvEnsDenseGETRF(ens_mem);
+
+  for (s = 0; s < M; s++)
+  {
+    sp = &(ens_mem->sys[s]);
+    if ((sp->phase != CVENS_NEWTON) || !sp->callSetup) { continue; }
+
+    sp->jcur      = sp->jbad;
+    sp->callSetup = SUNFALSE;
+    sp->nsetups++;
+    sp->gamrat = ONE;
+    sp->gammap = sp->gamma;
+    sp->crate  = ONE;
+    sp->nstlp  = sp->nst;
+
+    if (info[s] < 0) { cvEnsNlsFail(ens_mem, s, CV_LSETUP_FAIL); }
+    else if (info[s] > 0) { cvEnsNlsFail(ens_mem, s, SUN_NLS_CONV_RECVR); }
+  }
+}
+
+/*
+ * cvEnsDenseDQJac
+ *
+ * This routine approximates the Jacobians of the active systems by
+ * difference quotients (see cvLsDenseDQJac). Column j of every
+ * Jacobian comes from one call to f with component j of each active
+ * system perturbed. On entry y = zn[0] and ftemp = f(tn, y).
+ */
+
+static int cvEnsDenseDQJac(CVodeEnsembleMem ens_mem)
+{
+  sunindextype i, j, s, N, M;
+  sunrealtype *J, *yd, *wd, *fd, *td, *minInc, *inc, *ysaved;
+  sunrealtype srur, inc_inv;
+  CVEnsSys sp;
+  int retval;
+
+  N      = ens_mem->nstates;
+  M      = ens_mem->nsystems;
+  J      = ens_mem->J;
+  yd     = N_VGetArrayPointer(ens_mem->y);
+  wd     = N_VGetArrayPointer(ens_mem->ewt);
+  fd     = N_VGetArrayPointer(ens_mem->ftemp);
+  td     = N_VGetArrayPointer(ens_mem->tempv);
+  inc    = ens_mem->ctmp1;
+  minInc = ens_mem->ctmp2;
+  ysaved = ens_mem->nrm;
+  retval = 0;
+
+  /* Set minimum increment based on uround and norm of f */
+  srur = SUNRsqrt(ens_mem->uround);
+  cvEnsWrmsNorms(ens_mem, ens_mem->ftemp);
+  for (s = 0; s < M; s++)
+  {
+    sp        = &(ens_mem->sys[s]);
+    minInc[s] = (ens_mem->nrm[s] != ZERO)
+                  ? (MIN_INC_MULT * SUNRabs(sp->h) * ens_mem->uround * N *
+                     ens_mem->nrm[s])
+                  : ONE;
+  }
+
+
+  for (j = 0; j < N; j++)
+  {
+    /* Perturb component j of every active system */
+    for (s = 0; s < M; s++)
+    {
+      if (!ens_mem->active[s]) { continue; }
+      ysaved[s] = yd[IDX(j, s)];
+      inc[s] = SUNMAX(srur * SUNRabs(ysaved[s]), minInc[s] / wd[IDX(j, s)]);
+      yd[IDX(j, s)] += inc[s];
+    }
+
+    retval = ens_mem->f(ens_mem->t, ens_mem->y, ens_mem->tempv,
+                        ens_mem->active, ens_mem->user_data);
+    ens_mem->nfe++;
+
+    for (s = 0; s < M; s++)
+    {
+      if (ens_mem->active[s]) { yd[IDX(j, s)] = ysaved[s]; }
+    }
+
+    if (retval != 0) { break; }
+
+    /* Generate the jth column of J(tn,y) */
+    for (i = 0; i < N; i++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (!ens_mem->active[s]) { continue; }
+        inc_inv          = ONE / inc[s];
+        J[MIDX(i, j, s)] = inc_inv * (td[IDX(i, s)] - fd[IDX(i, s)]);
+      }
+    }
+  }
+
+  return (retval);
+}
+
+/*
+ * cvEnsDenseGETRF
+ *
+ * This routine computes the LU factorization with partial pivoting
+ * of the matrices of the active systems (see SUNDlsMat_denseGETRF),
+ * with the loops over the systems innermost. A system with a zero
+ * pivot is dropped from the active set and iwork[s] is set to the
+ * (one-based) index of the zero pivot.
+ */
+
+static void cvEnsDenseGETRF(CVodeEnsembleMem ens_mem)
+{
+  sunindextype i, j, k, l, s, N, M;
+  sunrealtype *A, *amax, *mult, tmp;
+  sunindextype* piv;
+  sunbooleantype* act;
+
+  N    = ens_mem->nstates;
+  M    = ens_mem->nsystems;
+  A    = ens_mem->A;
+  piv  = ens_mem->piv;
+  act  = ens_mem->active;
+  amax = ens_mem->nrm;
+  mult = ens_mem->ctmp2;
+
+  for (k = 0; k < N; k++)
+  {
+    /* find l = pivot row number */
+    for (s = 0; s < M; s++)
+    {
+      if (!act[s]) { continue; }
+      piv[IDX(k, s)] = k;
+      amax[s]        = SUNRabs(A[MIDX(k, k, s)]);
+    }
+    for (i = k + 1; i < N; i++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (act[s] && (SUNRabs(A[MIDX(i, k, s)]) > amax[s]))
+        {
+          amax[s]        = SUNRabs(A[MIDX(i, k, s)]);
+          piv[IDX(k, s)] = i;
+        }
+      }
+    }
+
+    /* check for zero pivot element */
+    for (s = 0; s < M; s++)
+    {
+      if (act[s] && (amax[s] == ZERO))
+      {
+        act[s]            = SUNFALSE;
+        ens_mem->iwork[s] = (int)(k + 1);
+      }
+    }
+
+    /* swap a(k,1:n) and a(l,1:n) if necessary */
+    for (j = 0; j < N; j++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (!act[s]) { continue; }
+        l = piv[IDX(k, s)];
+        if (l != k)
+        {
+          tmp              = A[MIDX(l, j, s)];
+          A[MIDX(l, j, s)] = A[MIDX(k, j, s)];
+          A[MIDX(k, j, s)] = tmp;
+        }
+      }
+    }
+
+    /* scale the elements below the diagonal in column k by 1/a(k,k) */
+    for (s = 0; s < M; s++) { mult[s] = act[s] ? ONE / A[MIDX(k, k, s)] : ONE; }
+    for (i = k + 1; i < N; i++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (act[s]) { A[MIDX(i, k, s)] *= mult[s]; }
+      }
+    }
+
+    /* row_i = row_i - [a(i,k)/a(k,k)] row_k, i=k+1, ..., n-1 */
+    for (j = k + 1; j < N; j++)
+    {
+      for (i = k + 1; i < N; i++)
+      {
+        for (s = 0; s < M; s++)
+        {
+          if (act[s])
+          {
+            A[MIDX(i, j, s)] -= A[MIDX(k, j, s)] * A[MIDX(i, k, s)];
+          }
+        }
+      }
+    }
+  }
+}
+
+/*
+ * cvEnsDenseGETRS
+ *
+ * This routine solves the factored linear systems of the active
+ * systems with right-hand side b (see SUNDlsMat_denseGETRS).
+ */
+
+static void cvEnsDenseGETRS(CVodeEnsembleMem ens_mem, N_Vector b)
+{
+  sunindextype i, k, pk, s, N, M;
+  sunrealtype *A, *bd, tmp;
+  sunindextype* piv;
+  sunbooleantype* act;
+
+  N   = ens_mem->nstates;
+  M   = ens_mem->nsystems;
+  A   = ens_mem->A;
+  piv = ens_mem->piv;
+  act = ens_mem->active;
+  bd  = N_VGetArrayPointer(b);
+
+  /* Permute b, based on pivot information in piv */
+  for (k = 0; k < N; k++)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (!act[s]) { continue; }
+      pk = piv[IDX(k, s)];
+      if (pk != k)
+      {
+        tmp            = bd[IDX(k, s)];
+        bd[IDX(k, s)]  = bd[IDX(pk, s)];
+        bd[IDX(pk, s)] = tmp;
+      }
+    }
+  }
+
+  /* Solve Ly = b, store solution y in b */
+  for (k = 0; k < N - 1; k++)
+  {
+    for (i = k + 1; i < N; i++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (act[s]) { bd[IDX(i, s)] -= A[MIDX(i, k, s)] * bd[IDX(k, s)]; }
+      }
+    }
+  }
+
+  /* Solve Ux = y, store solution x in b */
+  for (k = N - 1; k >= 0; k--)
+  {
+    for (s = 0; s < M; s++)
+    {
+      if (act[s]) { bd[IDX(k, s)] /= A[MIDX(k, k, s)]; }
+    }
+    for (i = 0; i < k; i++)
+    {
+      for (s = 0; s < M; s++)
+      {
+        if (act[s]) { bd[IDX(i, s)] -= A[MIDX(i, k, s)] * bd[IDX(k, s)]; }
+      }
+    }
+  }
+}
+
+/*
+ * cvEnsNlsFail
+ *
+ * This routine handles a failed Newton iteration of system s. As in
+ * SUNNonlinSolSolve_Newton, a recoverable failure with a Jacobian
+ * that is not current restarts the iteration with a Jacobian update;
+ * otherwise the failure is passed to cvEnsHandleNFlag.
+ */
+
+static void cvEnsNlsFail(CVodeEnsembleMem ens_mem, sunindextype s, int nflag)
+{
+  sunindextype i, N, M;
+  sunrealtype* ad;
+  CVEnsSys sp;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+
+  if ((nflag > 0) && !sp->jcur)
+  {
+    sp->ncfn++;
+    ad = N_VGetArrayPointer(ens_mem->acor);
+    for (i = 0; i < N; i++) { ad[IDX(i, s)] = ZERO; }
+    sp->convfail  = CV_FAIL_BAD_J;
+    sp->callSetup = SUNTRUE;
+    sp->curiter   = 0;
+    return;
+  }
+
+  cvEnsHandleNFlag(ens_mem, s, nflag);
+}
+
+/*
+ * cvEnsHandleNFlag
+ *
+ * This routine handles a nonlinear solver failure of system s (see
+ * cvHandleNFlag): it restores zn and either reduces the step size
+ * for another attempt or fails the system.
+ */
+
+static void cvEnsHandleNFlag(CVodeEnsembleMem ens_mem, sunindextype s,
+                             int nflag)
+{
+  CVEnsSys sp;
+
+  sp = &(ens_mem->sys[s]);
+
+  /* The nonlinear solve failed; increment ncfn and restore zn */
+  sp->ncfn++;
+  cvEnsRestore(ens_mem, s);
+
+  /* Return if failed unrecoverably */
+  if (nflag < 0)
+  {
+    cvEnsProcessError(ens_mem, CV_LSETUP_FAIL, __LINE__, __func__, __FILE__,
+                      MSGCV_SETUP_FAILED, sp->tn);
+    cvEnsFail(ens_mem, s, CV_LSETUP_FAIL);
+    return;
+  }
+
+  /* At this point, a recoverable error occurred. */
+  sp->ncf++;
+  sp->etamax = ONE;
+
+  /* If we had maxncf failures, return failure. */
+  if (sp->ncf == MXNCF)
+  {
+    if (nflag == RHSFUNC_RECVR)
+    {
+      cvEnsProcessError(ens_mem, CV_REPTD_RHSFUNC_ERR, __LINE__, __func__,
+                        __FILE__, MSGCV_RHSFUNC_REPTD, sp->tn);
+      cvEnsFail(ens_mem, s, CV_REPTD_RHSFUNC_ERR);
+    }
+    else
+    {
+      cvEnsProcessError(ens_mem, CV_CONV_FAILURE, __LINE__, __func__, __FILE__,
+                        MSGCV_CONV_FAILS, sp->tn, sp->h);
+      cvEnsFail(ens_mem, s, CV_CONV_FAILURE);
+    }
+    return;
+  }
+
+  /* Reduce step size; return to reattempt the step */
+  sp->eta   = ETA_CF_DEFAULT;
+  sp->nflag = PREV_CONV_FAIL;
+  cvEnsRescale(ens_mem, s);
+  sp->phase = CVENS_PREDICT;
+}
+
+/*
+ * =================================================================
+ * Private functions -- error test and step completion
+ * =================================================================
+ */
+
+/*
+ * cvEnsDoErrorTest
+ *
+ * This routine performs the local error test of system s after a
+ * successful Newton iteration (see cvDoErrorTest). On success the
+ * step is completed and the next step size and order are chosen; on
+ * failure the step is reattempted with a smaller step size (and
+ * possibly order) or the system fails.
+ */
+
+static void cvEnsDoErrorTest(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunrealtype dsm;
+  CVEnsSys sp;
+
+  sp  = &(ens_mem->sys[s]);
+  dsm = sp->acnrm * sp->tq[2];
+
+  /* If est. local error norm dsm passes test, complete the step */
+  if (dsm <= ONE)
+  {
+    cvEnsCompleteStep(ens_mem, s);
+    cvEnsPrepareNextStep(ens_mem, s, dsm);
+    sp->etamax = (sp->nst <= SMALL_NST_DEFAULT) ? ETA_MAX_ES_DEFAULT
+                                                : ETA_MAX_GS_DEFAULT;
+    sp->nstloc++;
+    sp->phase = CVENS_NEW_STEP;
+    return;
+  }
+
+  /* Test failed; increment counters, set nflag, and restore zn array */
+  sp->nef++;
+  sp->netf++;
+  sp->nflag = PREV_ERR_FAIL;
+  cvEnsRestore(ens_mem, s);
+
+  /* At maxnef failures, return CV_ERR_FAILURE */
+  if (sp->nef == MXNEF)
+  {
+    cvEnsProcessError(ens_mem, CV_ERR_FAILURE, __LINE__, __func__, __FILE__,
+                      MSGCV_ERR_FAILS, sp->tn, sp->h);
+    cvEnsFail(ens_mem, s, CV_ERR_FAILURE);
+    return;
+  }
+
+  /* Set etamax = 1 to prevent step size increase at end of this step */
+  sp->etamax = ONE;
+  sp->phase  = CVENS_PREDICT;
+
+  /* Set h ratio eta from dsm, rescale, and return for retry of step */
+  if (sp->nef <= MXNEF1)
+  {
+    sp->eta = cvErrFailEta(dsm, sp->L, sp->nef, SMALL_NEF_DEFAULT,
+                           ETA_MIN_EF_DEFAULT, ETA_MAX_EF_DEFAULT, ZERO);
+    cvEnsRescale(ens_mem, s);
+    return;
+  }
+
+  /* After MXNEF1 failures, force an order reduction and retry step */
+  if (sp->q > 1)
+  {
+    sp->eta = ETA_MIN_EF_DEFAULT;
+    cvEnsAdjustOrder(ens_mem, s, -1);
+    sp->L = sp->q;
+    sp->q--;
+    sp->qwait = sp->L;
+    cvEnsRescale(ens_mem, s);
+    return;
+  }
+
+  /* If already at order 1, restart: reload zn[1] from scratch (in
+     cvEnsRestartOrder1) */
+  sp->eta = ETA_MIN_EF_DEFAULT;
+  sp->h *= sp->eta;
+  sp->hscale = sp->h;
+  sp->qwait  = LONG_WAIT;
+  sp->nscon  = 0;
+  sp->phase  = CVENS_RESTART;
+}
+
+/*
+ * cvEnsRestartOrder1
+ *
+ * This routine reloads zn[1] = h f(tn, zn[0]) with one call to f for
+ * the systems restarting at order 1 after repeated error test
+ * failures. A positive return from f fails those systems with
+ * CV_UNREC_RHSFUNC_ERR; a negative return gives CV_RHSFUNC_FAIL.
+ */
+
+static int cvEnsRestartOrder1(CVodeEnsembleMem ens_mem)
+{
+  sunindextype i, s, N, M;
+  sunrealtype *z1, *td;
+  CVEnsSys sp;
+  int retval;
+
+  N = ens_mem->nstates;
+  M = ens_mem->nsystems;
+
+  if (cvEnsSetActive(ens_mem, CVENS_RESTART) == 0) { return (CV_SUCCESS); }
+
+  retval = ens_mem->f(ens_mem->t, ens_mem->zn[0], ens_mem->tempv,
+                      ens_mem->active, ens_mem->user_data);
+  ens_mem->nfe++;
+  if (retval < 0) { return (CV_RHSFUNC_FAIL); }
+
+  z1 = N_VGetArrayPointer(ens_mem->zn[1]);
+  td = N_VGetArrayPointer(ens_mem->tempv);
+
+  for (s = 0; s < M; s++)
+  {
+    if (!ens_mem->active[s]) { continue; }
+    sp = &(ens_mem->sys[s]);
+
+    if (retval > 0)
+    {
+      cvEnsProcessError(ens_mem, CV_UNREC_RHSFUNC_ERR, __LINE__, __func__,
+                        __FILE__, MSGCV_RHSFUNC_UNREC, sp->tn);
+      cvEnsFail(ens_mem, s, CV_UNREC_RHSFUNC_ERR);
+      continue;
+    }
+
+    for (i = 0; i < N; i++) { z1[IDX(i, s)] = sp->h * td[IDX(i, s)]; }
+    sp->phase = CVENS_PREDICT;
+  }
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * cvEnsCompleteStep
+ *
+ * This routine updates the step data and applies the correction to
+ * the Nordsieck array of system s after a successful step (see
+ * cvCompleteStep).
+ */
+
+static void cvEnsCompleteStep(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunindextype i, N, M;
+  sunrealtype *ad, *zj;
+  CVEnsSys sp;
+  int j;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+  ad = N_VGetArrayPointer(ens_mem->acor);
+
+  sp->nst++;
+  sp->nscon++;
+  sp->hu = sp->h;
+  sp->qu = sp->q;
+
+  for (j = sp->q; j >= 2; j--) { sp->tau[j] = sp->tau[j - 1]; }
+  if ((sp->q == 1) && (sp->nst > 1)) { sp->tau[2] = sp->tau[1]; }
+  sp->tau[1] = sp->h;
+
+  /* Apply correction to column j of zn: l_j * Delta_n */
+  for (j = 0; j <= sp->q; j++)
+  {
+    zj = N_VGetArrayPointer(ens_mem->zn[j]);
+    for (i = 0; i < N; i++) { zj[IDX(i, s)] += sp->l[j] * ad[IDX(i, s)]; }
+  }
+
+  sp->qwait--;
+  if ((sp->qwait == 1) && (sp->q != ens_mem->qmax))
+  {
+    zj = N_VGetArrayPointer(ens_mem->zn[ens_mem->qmax]);
+    for (i = 0; i < N; i++) { zj[IDX(i, s)] = ad[IDX(i, s)]; }
+    sp->saved_tq5 = sp->tq[5];
+  }
+}
+
+/*
+ * cvEnsPrepareNextStep
+ *
+ * This routine chooses the step size and order of the next step of
+ * system s (see cvPrepareNextStep).
+ */
+
+static void cvEnsPrepareNextStep(CVodeEnsembleMem ens_mem, sunindextype s,
+                                 sunrealtype dsm)
+{
+  CVEnsSys sp;
+
+  sp = &(ens_mem->sys[s]);
+
+  /* If etamax = 1, defer step size or order changes */
+  if (sp->etamax == ONE)
+  {
+    sp->qwait  = SUNMAX(sp->qwait, 2);
+    sp->qprime = sp->q;
+    sp->hprime = sp->h;
+    sp->eta    = ONE;
+    return;
+  }
+
+  /* etaq is the ratio of new to old h at the current order */
+  sp->etaq = cvEtaFromNorm(BIAS2, dsm, sp->L);
+
+  /* If no order change, adjust eta and acor in cvEnsSetEta and return */
+  if (sp->qwait != 0)
+  {
+    sp->eta    = sp->etaq;
+    sp->qprime = sp->q;
+    cvEnsSetEta(ens_mem, s);
+    return;
+  }
+
+  /* If qwait = 0, consider an order change */
+  sp->qwait  = 2;
+  sp->etaqm1 = cvEnsComputeEtaqm1(ens_mem, s);
+  sp->etaqp1 = cvEnsComputeEtaqp1(ens_mem, s);
+  cvEnsChooseEta(ens_mem, s);
+  cvEnsSetEta(ens_mem, s);
+}
+
+/*
+ * cvEnsSetEta
+ *
+ * This routine adjusts eta of system s according to the heuristic
+ * limits (see cvSetEta).
+ */
+
+static void cvEnsSetEta(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  CVEnsSys sp;
+
+  sp = &(ens_mem->sys[s]);
+
+  /* The ensemble mode has no hmin or hmax */
+  sp->eta = cvLimitEta(sp->eta, sp->h, sp->etamax, ETA_MIN_FX_DEFAULT,
+                       ETA_MAX_FX_DEFAULT, ETA_MIN_DEFAULT, ZERO, ZERO);
+
+  sp->hprime = sp->h * sp->eta;
+  if (sp->qprime < sp->q) { sp->nscon = 0; }
+}
+
+/*
+ * cvEnsComputeEtaqm1
+ *
+ * This routine returns etaqm1 of system s for a possible decrease
+ * in order by 1 (see cvComputeEtaqm1).
+ */
+
+static sunrealtype cvEnsComputeEtaqm1(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunrealtype ddn;
+  CVEnsSys sp;
+
+  sp = &(ens_mem->sys[s]);
+
+  sp->etaqm1 = ZERO;
+  if (sp->q > 1)
+  {
+    ddn = cvEnsWrmsNorm(ens_mem, s, ens_mem->zn[sp->q]) * sp->tq[1];
+    sp->etaqm1 = cvEtaFromNorm(BIAS1, ddn, sp->q);
+  }
+  return (sp->etaqm1);
+}
+
+/*
+ * cvEnsComputeEtaqp1
+ *
+ * This routine returns etaqp1 of system s for a possible increase
+ * in order by 1 (see cvComputeEtaqp1).
+ */
+
+static sunrealtype cvEnsComputeEtaqp1(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunindextype i, N, M;
+  sunrealtype dup, cquot, sum, *zq, *ad, *wd;
+  CVEnsSys sp;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+
+  sp->etaqp1 = ZERO;
+  if (sp->q != ens_mem->qmax)
+  {
+    if (sp->saved_tq5 == ZERO) { return (sp->etaqp1); }
+    cquot = (sp->tq[5] / sp->saved_tq5) *
+            SUNRpowerI(sp->h / sp->tau[2], sp->L);
+
+    zq  = N_VGetArrayPointer(ens_mem->zn[ens_mem->qmax]);
+    ad  = N_VGetArrayPointer(ens_mem->acor);
+    wd  = N_VGetArrayPointer(ens_mem->ewt);
+    sum = ZERO;
+    for (i = 0; i < N; i++)
+    {
+      sum += SUNSQR((-cquot * zq[IDX(i, s)] + ad[IDX(i, s)]) * wd[IDX(i, s)]);
+    }
+    dup = SUNRsqrt(sum / N) * sp->tq[3];
+
+    sp->etaqp1 = cvEtaFromNorm(BIAS3, dup, sp->L + 1);
+  }
+  return (sp->etaqp1);
+}
+
+/*
+ * cvEnsChooseEta
+ *
+ * This routine chooses the largest of etaqm1, etaq, and etaqp1 for
+ * system s and sets eta and qprime accordingly (see cvChooseEta).
+ */
+
+static void cvEnsChooseEta(CVodeEnsembleMem ens_mem, sunindextype s)
+{
+  sunindextype i, N, M;
+  sunrealtype *zq, *ad;
+  CVEnsSys sp;
+  int deltaq;
+
+  N  = ens_mem->nstates;
+  M  = ens_mem->nsystems;
+  sp = &(ens_mem->sys[s]);
+
+  deltaq = cvChooseOrder(sp->etaqm1, sp->etaq, sp->etaqp1, ETA_MIN_FX_DEFAULT,
+                         ETA_MAX_FX_DEFAULT, &(sp->eta));
+
+  sp->qprime = sp->q + deltaq;
+
+  if (deltaq == 1)
+  {
+    /* Store Delta_n in zn[qmax] to be used in order increase */
+    zq = N_VGetArrayPointer(ens_mem->zn[ens_mem->qmax]);
+    ad = N_VGetArrayPointer(ens_mem->acor);
+    for (i = 0; i < N; i++) { zq[IDX(i, s)] = ad[IDX(i, s)]; }
+  }
+}
+
+/*
+ * =================================================================
+ * Error reporting
+ * =================================================================
+ */
+
+/*
+ * cvEnsProcessError
+ *
+ * This routine composes the error message and passes it to the
+ * SUNDIALS error handler of the ensemble's context (see
+ * cvProcessError).
+ */
+
+static void cvEnsProcessError(CVodeEnsembleMem ens_mem, int error_code,
+                              int line, const char* func, const char* file,
+                              const char* msgfmt, ...)
+{
+  /* We initialize the argument pointer variable before each vsnprintf call to avoid undefined behavior
+     (msgfmt is the last required argument to cvEnsProcessError) */
+  va_list ap;
+
+  /* Compose the message */
+  va_start(ap, msgfmt);
+  size_t msglen = vsnprintf(NULL, 0, msgfmt, ap) + 1;
+  va_end(ap);
+
+  char* msg = (char*)malloc(msglen);
+
+  va_start(ap, msgfmt);
+  vsnprintf(msg, msglen, msgfmt, ap);
+  va_end(ap);
+
+  if (ens_mem == NULL)
+  {
+    SUNGlobalFallbackErrHandler(line, func, file, msg, error_code);
+  }
+  else
+  {
+    /* Call the SUNDIALS main error handler */
+    SUNHandleErrWithMsg(line, func, file, msg, error_code, ens_mem->sunctx);
+
+    /* Clear the error now */
+    (void)SUNContext_GetLastError(ens_mem->sunctx);
+  }
+
+  free(msg);
+}
@@ -0,0 +1,171 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Implementation header file for the batched ensemble mode of
+ * CVODE, CVODE_ENSEMBLE.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _CVODE_ENSEMBLE_IMPL_H
+#define _CVODE_ENSEMBLE_IMPL_H
+
+#include <cvode/cvode_ensemble.h>
+
+#include "cvode_impl.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*
+ * -----------------------------------------------------------------
+ * Type : CVEnsSysRec
+ * -----------------------------------------------------------------
+ * The step control data of one system of the ensemble. The fields
+ * mirror the corresponding cv_* fields of CVodeMemRec.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct
+{
+  /* Step data */
+  int q;                         /* current order                         */
+  int qprime;                    /* order to be used on the next step     */
+  int qu;                        /* last successful order                 */
+  int L;                         /* L = q + 1                             */
+  int qwait;                     /* steps to wait before an order change  */
+  sunrealtype tn;                /* current internal time                 */
+  sunrealtype h;                 /* current step size                     */
+  sunrealtype hprime;            /* step size to be used on the next step */
+  sunrealtype hscale;            /* step size at the last rescaling of zn */
+  sunrealtype hu;                /* last successful step size             */
+  sunrealtype eta;               /* eta = hprime / h                      */
+  sunrealtype etamax;            /* upper bound on eta                    */
+  sunrealtype etaq;              /* ratio of new to old h for order q     */
+  sunrealtype etaqm1;            /* ratio of new to old h for order q-1   */
+  sunrealtype etaqp1;            /* ratio of new to old h for order q+1   */
+  sunrealtype saved_tq5;         /* saved value of tq[5]                  */
+  sunrealtype tau[L_MAX + 1];    /* previous successful step sizes        */
+  sunrealtype tq[NUM_TESTS + 1]; /* error test quantities                 */
+  sunrealtype l[L_MAX];          /* method coefficients                   */
+  sunrealtype rl1;               /* 1 / l[1]                              */
+  sunrealtype gamma;             /* gamma = h * rl1                       */
+  sunrealtype gammap;            /* gamma at the last linear solver setup */
+  sunrealtype gamrat;            /* gamma / gammap                        */
+  sunrealtype crate;             /* estimated corrector convergence rate  */
+  sunrealtype delp;              /* norm of the previous correction       */
+  sunrealtype acnrm;             /* weighted norm of the correction       */
+
+  /* Step attempt data */
+  int phase;                /* position of the system in the step loop  */
+  int flag;                 /* return flag of the last CVodeEnsemble    */
+  sunrealtype saved_t;      /* time to restore to if an attempt fails   */
+  int nflag;                /* FIRST_CALL, PREV_CONV_FAIL, PREV_ERR_FAIL */
+  int ncf;                  /* corrector failures in this step          */
+  int nef;                  /* error test failures in this step         */
+  int convfail;             /* convergence failure flag for the setup   */
+  int curiter;              /* current Newton iteration                 */
+  sunbooleantype callSetup; /* is a linear solver setup pending?        */
+  sunbooleantype jcur;      /* is the saved Jacobian current?           */
+  sunbooleantype jbad;      /* must the Jacobian be reevaluated?        */
+
+  /* Counters */
+  long int nst;     /* number of steps                             */
+  long int nstloc;  /* number of steps in the current call         */
+  long int nscon;   /* steps at the current order                  */
+  long int nstlp;   /* step number of the last linear solver setup */
+  long int nstlj;   /* step number of the last Jacobian evaluation */
+  long int netf;    /* number of error test failures               */
+  long int nni;     /* number of Newton iterations                 */
+  long int ncfn;    /* number of corrector convergence failures    */
+  long int nje;     /* number of Jacobian evaluations              */
+  long int nsetups; /* number of linear solver setups              */
+} CVEnsSysRec, *CVEnsSys;
+
+/*
+ * -----------------------------------------------------------------
+ * Types : CVodeEnsembleMemRec, CVodeEnsembleMem
+ * -----------------------------------------------------------------
+ * The ensemble integrator memory. All vectors and matrices store the
+ * systems innermost so that the loops over the ensemble vectorize.
+ * -----------------------------------------------------------------
+ */
+
+typedef struct CVodeEnsembleMemRec
+{
+  SUNContext sunctx;
+  sunrealtype uround;
+
+  /* Problem specification */
+  sunindextype nstates;  /* number of states per system (N)   */
+  sunindextype nsystems; /* number of systems (M)             */
+  CVEnsRhsFn f;          /* ensemble right-hand side          */
+  CVEnsJacFn jac;        /* ensemble Jacobian (NULL for DQ)   */
+  void* user_data;       /* user pointer passed to f and jac  */
+  int itol;              /* CV_NN, CV_SS, or CV_SV            */
+  sunrealtype reltol;    /* relative tolerance                */
+  sunrealtype Sabstol;   /* scalar absolute tolerance         */
+  N_Vector Vabstol;      /* vector absolute tolerance         */
+
+  /* Solver options */
+  int qmax;        /* maximum order                        */
+  long int mxstep; /* maximum number of steps per call     */
+  sunrealtype hin; /* initial step size (zero to estimate) */
+
+  /* Vectors of length N * M */
+  N_Vector zn[BDF_Q_MAX + 1]; /* Nordsieck arrays                   */
+  N_Vector ewt;               /* error weights                      */
+  N_Vector y;                 /* current iterate                    */
+  N_Vector acor;              /* accumulated correction             */
+  N_Vector tempv;             /* temporary storage                  */
+  N_Vector ftemp;             /* right-hand side at the iterate     */
+
+  /* Batched dense linear algebra */
+  sunrealtype* J;    /* saved Jacobians, N * N * M           */
+  sunrealtype* A;    /* LU factors of I - gamma J, N * N * M */
+  sunindextype* piv; /* pivots, N * M                        */
+
+  /* Per-system data and workspace */
+  CVEnsSys sys;           /* step control data of each system    */
+  sunrealtype* t;         /* time argument passed to f and jac   */
+  sunbooleantype* active; /* mask passed to f and jac            */
+  sunrealtype* ctmp1;     /* per-system coefficients             */
+  sunrealtype* ctmp2;     /* per-system coefficients             */
+  sunrealtype* nrm;       /* per-system norms                    */
+  int* iwork;             /* per-system integer workspace        */
+
+  /* Counters */
+  long int nfe; /* number of (batched) calls to f */
+
+  sunbooleantype MallocDone; /* has CVodeEnsembleInit been called? */
+
+} CVodeEnsembleMemRec, *CVodeEnsembleMem;
+
+/* Error Messages */
+
+#define MSGENS_NO_MEM    "cvens_mem = NULL illegal."
+#define MSGENS_NO_MALLOC "Attempt to call before CVodeEnsembleInit."
+#define MSGENS_BAD_SIZES "nstates and nsystems must be positive."
+#define MSGENS_BAD_NVECTOR                                               \
+  "The vector must provide N_VGetArrayPointer and have length nstates " \
+  "* nsystems."
+#define MSGENS_BAD_MAXORD "maxord must be between 1 and 5."
+#define MSGENS_BAD_TOUT \
+  "Trouble interpolating system %ld at " MSG_TIME_TOUT "."
+#define MSGENS_SYS_FAILED \
+  "%ld system(s) failed to reach tout; the first is system %ld."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,386 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file implements fused CPU kernels for CVODE. Each kernel is
+ * a single pass over the vector data of a serial or OpenMP vector.
+ * When compiled with USE_OPENMP the loops are shared among the
+ * threads of the OpenMP vector.
+ * -----------------------------------------------------------------
+ */
+
+#include <sundials/sundials_math.h>
+
+#include "cvode_impl.h"
+#include "sundials_macros.h"
+
+#ifdef USE_OPENMP
+#include <nvector/nvector_openmp.h>
+#include <omp.h>
+#endif
+
+#define ZERO   SUN_RCONST(0.0)
+#define PT1    SUN_RCONST(0.1)
+#define ONEPT5 SUN_RCONST(1.50)
+#define ONE    SUN_RCONST(1.0)
+
+/*
+ * -----------------------------------------------------------------
+ * Number of threads to use with the vector v (one unless v is an
+ * OpenMP vector and OpenMP is enabled).
+ * -----------------------------------------------------------------
+ */
+
+#ifdef USE_OPENMP
+static int cvFusedNumThreads(N_Vector v)
+{
+  if (N_VGetVectorID(v) == SUNDIALS_NVEC_OPENMP)
+  {
+    return NV_NUM_THREADS_OMP(v);
+  }
+  return 1;
+}
+#endif
+
+/*
+ * -----------------------------------------------------------------
+ * The kernels access the host data arrays of serial vectors, and of
+ * OpenMP vectors when built with OpenMP.
+ * -----------------------------------------------------------------
+ */
+
+sunbooleantype cvVectorSupported_fused(const N_Vector v)
+{
+  N_Vector_ID id = N_VGetVectorID(v);
+#ifdef USE_OPENMP
+  return (id == SUNDIALS_NVEC_SERIAL || id == SUNDIALS_NVEC_OPENMP);
+#else
+  return (id == SUNDIALS_NVEC_SERIAL);
+#endif
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the ewt vector when the tol type is CV_SS.
+ * -----------------------------------------------------------------
+ */
+
+int cvEwtSetSS_fused(SUNDIALS_MAYBE_UNUSED const sunbooleantype atolmin0,
+                     const sunrealtype reltol, const sunrealtype Sabstol,
+                     const N_Vector ycur, N_Vector tempv, N_Vector weight)
+{
+  sunindextype i, N;
+  sunrealtype *yd, *td, *wd;
+
+  N  = N_VGetLength(ycur);
+  yd = N_VGetArrayPointer(ycur);
+  td = N_VGetArrayPointer(tempv);
+  wd = N_VGetArrayPointer(weight);
+
+  /* weight is computed regardless of the component test (done by the
+     caller) since it will be thrown away in that case anyways */
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(ycur))
+#endif
+  for (i = 0; i < N; i++)
+  {
+    td[i] = reltol * SUNRabs(yd[i]) + Sabstol;
+    wd[i] = ONE / td[i];
+  }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the ewt vector when the tol type is CV_SV.
+ * -----------------------------------------------------------------
+ */
+
+int cvEwtSetSV_fused(SUNDIALS_MAYBE_UNUSED const sunbooleantype atolmin0,
+                     const sunrealtype reltol, const N_Vector Vabstol,
+                     const N_Vector ycur, N_Vector tempv, N_Vector weight)
+{
+  sunindextype i, N;
+  sunrealtype *ad, *yd, *td, *wd;
+
+  N  = N_VGetLength(ycur);
+  ad = N_VGetArrayPointer(Vabstol);
+  yd = N_VGetArrayPointer(ycur);
+  td = N_VGetArrayPointer(tempv);
+  wd = N_VGetArrayPointer(weight);
+
+  /* weight is computed regardless of the component test (done by the
+     caller) since it will be thrown away in that case anyways */
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(ycur))
+#endif
+  for (i = 0; i < N; i++)
+  {
+    td[i] = reltol * SUNRabs(yd[i]) + ad[i];
+    wd[i] = ONE / td[i];
+  }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Determine if the constraints of the problem are satisfied by
+ * the proposed step.
+ * -----------------------------------------------------------------
+ */
+
+int cvCheckConstraints_fused(const N_Vector c, const N_Vector ewt,
+                             const N_Vector y, const N_Vector mm, N_Vector tmp)
+{
+  sunindextype i, N;
+  sunrealtype *cd, *ed, *yd, *md, *td;
+
+  N  = N_VGetLength(c);
+  cd = N_VGetArrayPointer(c);
+  ed = N_VGetArrayPointer(ewt);
+  yd = N_VGetArrayPointer(y);
+  md = N_VGetArrayPointer(mm);
+  td = N_VGetArrayPointer(tmp);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(c))
+#endif
+  for (i = 0; i < N; i++)
+  {
+    /* v = mm*(y-0.1*a*c*wt) with a[i]=1 when |c[i]|=2 */
+    sunrealtype a = (SUNRabs(cd[i]) >= ONEPT5) ? cd[i] / ed[i] : ZERO;
+    td[i]         = (yd[i] - PT1 * a) * md[i];
+  }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the nonlinear residual.
+ * -----------------------------------------------------------------
+ */
+
+int cvNlsResid_fused(const sunrealtype rl1, const sunrealtype ngamma,
+                     const N_Vector zn1, const N_Vector ycor,
+                     const N_Vector ftemp, N_Vector res)
+{
+  sunindextype i, N;
+  sunrealtype *zd, *yd, *fd, *rd;
+
+  N  = N_VGetLength(res);
+  zd = N_VGetArrayPointer(zn1);
+  yd = N_VGetArrayPointer(ycor);
+  fd = N_VGetArrayPointer(ftemp);
+  rd = N_VGetArrayPointer(res);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(res))
+#endif
+  for (i = 0; i < N; i++) { rd[i] = ngamma * fd[i] + (rl1 * zd[i] + yd[i]); }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Form y with perturbation = FRACT*(func. iter. correction)
+ * -----------------------------------------------------------------
+ */
+
+int cvDiagSetup_formY(const sunrealtype h, const sunrealtype r,
+                      const N_Vector fpred, const N_Vector zn1,
+                      const N_Vector ypred, N_Vector ftemp, N_Vector y)
+{
+  sunindextype i, N;
+  sunrealtype *fpd, *zd, *pd, *ftd, *yd;
+
+  N   = N_VGetLength(y);
+  fpd = N_VGetArrayPointer(fpred);
+  zd  = N_VGetArrayPointer(zn1);
+  pd  = N_VGetArrayPointer(ypred);
+  ftd = N_VGetArrayPointer(ftemp);
+  yd  = N_VGetArrayPointer(y);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(y))
+#endif
+  for (i = 0; i < N; i++)
+  {
+    ftd[i] = h * fpd[i] - zd[i];
+    yd[i]  = r * ftd[i] + pd[i];
+  }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Construct M = I - gamma*J with J = diag(deltaf_i/deltay_i)
+ * protecting against deltay_i being at roundoff level.
+ * -----------------------------------------------------------------
+ */
+
+int cvDiagSetup_buildM(const sunrealtype fract, const sunrealtype uround,
+                       const sunrealtype h, const N_Vector ftemp,
+                       const N_Vector fpred, const N_Vector ewt, N_Vector bit,
+                       N_Vector bitcomp, N_Vector y, N_Vector M)
+{
+  sunindextype i, N;
+  sunrealtype *ftd, *fpd, *ed, *bd, *bcd, *yd, *Md;
+
+  N   = N_VGetLength(M);
+  ftd = N_VGetArrayPointer(ftemp);
+  fpd = N_VGetArrayPointer(fpred);
+  ed  = N_VGetArrayPointer(ewt);
+  bd  = N_VGetArrayPointer(bit);
+  bcd = N_VGetArrayPointer(bitcomp);
+  yd  = N_VGetArrayPointer(y);
+  Md  = N_VGetArrayPointer(M);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(M))
+#endif
+  for (i = 0; i < N; i++)
+  {
+    Md[i] = fract * ftd[i] - h * (Md[i] - fpd[i]);
+    yd[i] = ftd[i] * ed[i];
+
+    /* protect against deltay_i being at roundoff level */
+    if (SUNRabs(yd[i]) >= uround)
+    {
+      bd[i]  = ONE;
+      bcd[i] = ZERO;
+      yd[i]  = fract * ftd[i];
+      Md[i]  = Md[i] / yd[i];
+    }
+    else
+    {
+      bd[i]  = ZERO;
+      bcd[i] = -ONE;
+      yd[i]  = ONE;
+      Md[i]  = ONE;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ *  Update M with changed gamma so that M = I - gamma*J.
+ * -----------------------------------------------------------------
+ */
+
+int cvDiagSolve_updateM(const sunrealtype r, N_Vector M)
+{
+  sunindextype i, N;
+  sunrealtype* Md;
+
+  N  = N_VGetLength(M);
+  Md = N_VGetArrayPointer(M);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(M))
+#endif
+  for (i = 0; i < N; i++) { Md[i] = r * (ONE / Md[i] - ONE) + ONE; }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the predicted Nordsieck array. Each entry of zn[0..q-1]
+ * is updated by the q(q+1)/2 repeated additions of cvPredict while
+ * the entries of zn are loaded once.
+ * -----------------------------------------------------------------
+ */
+
+int cvPredict_fused(const int q, N_Vector* zn)
+{
+  sunindextype i, N;
+  sunrealtype* zd[L_MAX];
+  int j, k;
+
+  N = N_VGetLength(zn[0]);
+  for (j = 0; j <= q; j++) { zd[j] = N_VGetArrayPointer(zn[j]); }
+
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i, j, k) schedule(static) \
+  num_threads(cvFusedNumThreads(zn[0]))
+#endif
+  for (i = 0; i < N; i++)
+  {
+    sunrealtype z[L_MAX];
+    for (j = 0; j <= q; j++) { z[j] = zd[j][i]; }
+    for (k = 1; k <= q; k++)
+    {
+      for (j = q; j >= k; j--) { z[j - 1] += z[j]; }
+    }
+    for (j = 0; j < q; j++) { zd[j][i] = z[j]; }
+  }
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Update y = zn[0] + acor and, if requested, compute the weighted
+ * RMS norm of acor used in the local error test.
+ * -----------------------------------------------------------------
+ */
+
+int cvUpdateY_fused(const sunbooleantype compute_nrm, const N_Vector zn0,
+                    const N_Vector acor, const N_Vector ewt, N_Vector y,
+                    sunrealtype* acnrm)
+{
+  sunindextype i, N;
+  sunrealtype *zd, *ad, *ed, *yd, sum;
+
+  N  = N_VGetLength(y);
+  zd = N_VGetArrayPointer(zn0);
+  ad = N_VGetArrayPointer(acor);
+  ed = N_VGetArrayPointer(ewt);
+  yd = N_VGetArrayPointer(y);
+
+  if (!compute_nrm)
+  {
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) schedule(static) \
+  num_threads(cvFusedNumThreads(y))
+#endif
+    for (i = 0; i < N; i++) { yd[i] = zd[i] + ad[i]; }
+    return 0;
+  }
+
+  sum = ZERO;
+#ifdef USE_OPENMP
+#pragma omp parallel for private(i) reduction(+ : sum) schedule(static) \
+  num_threads(cvFusedNumThreads(y))
+#endif
+  for (i = 0; i < N; i++)
+  {
+    yd[i] = zd[i] + ad[i];
+    sum += SUNSQR(ad[i] * ed[i]);
+  }
+  *acnrm = SUNRsqrt(sum / N);
+
+  return 0;
+}
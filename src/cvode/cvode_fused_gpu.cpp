@@ -46,6 +46,22 @@ constexpr auto gpuAssert            = SUNDIALS_HIP_Assert;
 #error Incompatible GPU option for fused kernels
 #endif
 
+/*
+ * -----------------------------------------------------------------
+ * The kernels cast the vector content, so only the vector of the
+ * matching GPU backend is supported.
+ * -----------------------------------------------------------------
+ */
+
+extern "C" sunbooleantype cvVectorSupported_fused(const N_Vector v)
+{
+#ifdef USE_CUDA
+  return (N_VGetVectorID(v) == SUNDIALS_NVEC_CUDA);
+#else
+  return (N_VGetVectorID(v) == SUNDIALS_NVEC_HIP);
+#endif
+}
+
 /*
  * -----------------------------------------------------------------
  * Compute the ewt vector when the tol type is CV_SS.
@@ -404,3 +420,102 @@ extern "C" int cvDiagSolve_updateM(const sunrealtype r, N_Vector M)
 
   return 0;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the predicted Nordsieck array.
+ * -----------------------------------------------------------------
+ */
+
+// Maximum number of Nordsieck history vectors (L_MAX in cvode_impl.h)
+constexpr int cvFusedLMax = 13;
+
+struct cvNordsieckPtrs
+{
+  sunrealtype* zn[cvFusedLMax];
+};
+
+__global__ void cvPredict_kernel(const sunindextype length, const int q,
+                                 cvNordsieckPtrs zd)
+{
+  GRID_STRIDE_XLOOP(sunindextype, i, length)
+  {
+    // for (k = 1; k <= q; k++)
+    //   for (j = q; j >= k; j--)
+    //     N_VLinearSum(ONE, zn[j - 1], ONE, zn[j], zn[j - 1]);
+    sunrealtype z[cvFusedLMax];
+    for (int j = 0; j <= q; j++) { z[j] = zd.zn[j][i]; }
+    for (int k = 1; k <= q; k++)
+    {
+      for (int j = q; j >= k; j--) { z[j - 1] += z[j]; }
+    }
+    for (int j = 0; j < q; j++) { zd.zn[j][i] = z[j]; }
+  }
+}
+
+extern "C" int cvPredict_fused(const int q, N_Vector* zn)
+{
+  const SUNExecPolicy* exec_policy =
+    ((NVectorContent)zn[0]->content)->stream_exec_policy;
+  const sunindextype N = N_VGetLength(zn[0]);
+  size_t block         = exec_policy->blockSize(N);
+  size_t grid          = exec_policy->gridSize(N);
+
+  cvNordsieckPtrs zd;
+  for (int j = 0; j <= q; j++) { zd.zn[j] = N_VGetDeviceArrayPointer(zn[j]); }
+
+  cvPredict_kernel<<<grid, block, 0, *(exec_policy->stream())>>>(N, q, zd);
+
+#ifdef SUNDIALS_DEBUG_GPU_LASTERROR
+  gpuDeviceSynchronize();
+  if (!gpuAssert(gpuGetLastError(), __FILE__, __LINE__)) return -1;
+#endif
+
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Update y = zn[0] + acor and, if requested, compute the weighted
+ * RMS norm of acor used in the local error test.
+ * -----------------------------------------------------------------
+ */
+
+__global__ void cvUpdateY_kernel(const sunindextype length,
+                                 const sunrealtype* zn0,
+                                 const sunrealtype* acor, sunrealtype* y)
+{
+  GRID_STRIDE_XLOOP(sunindextype, i, length)
+  {
+    // N_VLinearSum(ONE, cv_mem->cv_zn[0], ONE, cv_mem->cv_acor, cv_mem->cv_y);
+    y[i] = zn0[i] + acor[i];
+  }
+}
+
+extern "C" int cvUpdateY_fused(const sunbooleantype compute_nrm,
+                               const N_Vector zn0, const N_Vector acor,
+                               const N_Vector ewt, N_Vector y,
+                               sunrealtype* acnrm)
+{
+  const SUNExecPolicy* exec_policy =
+    ((NVectorContent)y->content)->stream_exec_policy;
+  const sunindextype N = N_VGetLength(y);
+  size_t block         = exec_policy->blockSize(N);
+  size_t grid          = exec_policy->gridSize(N);
+
+  cvUpdateY_kernel<<<grid, block, 0,
+                     *(exec_policy->stream())>>>(N,
+                                                 N_VGetDeviceArrayPointer(zn0),
+                                                 N_VGetDeviceArrayPointer(acor),
+                                                 N_VGetDeviceArrayPointer(y));
+
+#ifdef SUNDIALS_DEBUG_GPU_LASTERROR
+  gpuDeviceSynchronize();
+  if (!gpuAssert(gpuGetLastError(), __FILE__, __LINE__)) return -1;
+#endif
+
+  // the norm is a reduction, use the vector's own kernel
+  if (compute_nrm) { *acnrm = N_VWrmsNorm(acor, ewt); }
+
+  return 0;
+}
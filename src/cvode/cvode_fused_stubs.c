@@ -26,6 +26,18 @@
 #define ONEPT5 SUN_RCONST(1.50)
 #define ONE    SUN_RCONST(1.0)
 
+/*
+ * -----------------------------------------------------------------
+ * The stub kernels only use generic vector operations and support
+ * any vector.
+ * -----------------------------------------------------------------
+ */
+
+sunbooleantype cvVectorSupported_fused(SUNDIALS_MAYBE_UNUSED const N_Vector v)
+{
+  return SUNTRUE;
+}
+
 /*
  * -----------------------------------------------------------------
  * Compute the ewt vector when the tol type is CV_SS.
@@ -156,3 +168,38 @@ int cvDiagSolve_updateM(const sunrealtype r, N_Vector M)
   N_VAddConst(M, ONE, M);
   return 0;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * Compute the predicted Nordsieck array.
+ * -----------------------------------------------------------------
+ */
+
+int cvPredict_fused(const int q, N_Vector* zn)
+{
+  int j, k;
+  for (k = 1; k <= q; k++)
+  {
+    for (j = q; j >= k; j--)
+    {
+      N_VLinearSum(ONE, zn[j - 1], ONE, zn[j], zn[j - 1]);
+    }
+  }
+  return 0;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Update y = zn[0] + acor and, if requested, compute the weighted
+ * RMS norm of acor used in the local error test.
+ * -----------------------------------------------------------------
+ */
+
+int cvUpdateY_fused(const sunbooleantype compute_nrm, const N_Vector zn0,
+                    const N_Vector acor, const N_Vector ewt, N_Vector y,
+                    sunrealtype* acnrm)
+{
+  N_VLinearSum(ONE, zn0, ONE, acor, y);
+  if (compute_nrm) { *acnrm = N_VWrmsNorm(acor, ewt); }
+  return 0;
+}
@@ -635,7 +635,38 @@ void cvRestore(CVodeMem cv_mem, sunrealtype saved_t);
 
 void cvRescale(CVodeMem cv_mem);
 
+/* Step control kernels (shared with the ensemble mode, cvode_ensemble.c) */
+
+void cvBDFCoefs(int q, int qwait, sunrealtype h, const sunrealtype* tau,
+                sunrealtype nlscoef, sunrealtype* l, sunrealtype* tq,
+                sunrealtype* p);
+sunrealtype cvIncreaseBDFCoefs(int q, int qmax, sunrealtype hscale,
+                               const sunrealtype* tau, sunrealtype* l);
+void cvDecreaseBDFCoefs(int q, int qmax, sunrealtype hscale,
+                        const sunrealtype* tau, sunrealtype* l);
+sunrealtype cvEtaFromNorm(sunrealtype bias, sunrealtype dnrm, int k);
+sunrealtype cvErrFailEta(sunrealtype dsm, int L, int nef, int small_nef,
+                         sunrealtype eta_min_ef, sunrealtype eta_max_ef,
+                         sunrealtype hmin_ratio);
+sunrealtype cvLimitEta(sunrealtype eta, sunrealtype h, sunrealtype etamax,
+                       sunrealtype eta_min_fx, sunrealtype eta_max_fx,
+                       sunrealtype eta_min, sunrealtype hmin,
+                       sunrealtype hmax_inv);
+int cvChooseOrder(sunrealtype etaqm1, sunrealtype etaq, sunrealtype etaqp1,
+                  sunrealtype eta_min_fx, sunrealtype eta_max_fx,
+                  sunrealtype* eta);
+
+/* Newton iteration kernels (shared with the ensemble mode) */
+
+sunbooleantype cvNlsCallSetup(int nflag, long int nst, long int nstlp,
+                              long int msbp, sunrealtype gamrat,
+                              sunrealtype dgmax_lsetup, int* convfail);
+int cvNlsConvRateTest(int m, sunrealtype del, sunrealtype tol,
+                      sunrealtype* crate, sunrealtype* delp);
+
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
+sunbooleantype cvVectorSupported_fused(const N_Vector v);
+
 int cvEwtSetSS_fused(const sunbooleantype atolmin0, const sunrealtype reltol,
                      const sunrealtype Sabstol, const N_Vector ycur,
                      N_Vector tempv, N_Vector weight);
@@ -661,6 +692,12 @@ int cvDiagSetup_buildM(const sunrealtype fract, const sunrealtype uround,
                        N_Vector bitcomp, N_Vector y, N_Vector M);
 
 int cvDiagSolve_updateM(const sunrealtype r, N_Vector M);
+
+int cvPredict_fused(const int q, N_Vector* zn);
+
+int cvUpdateY_fused(const sunbooleantype compute_nrm, const N_Vector zn0,
+                    const N_Vector acor, const N_Vector ewt, N_Vector y,
+                    sunrealtype* acnrm);
 #endif
 
 /*
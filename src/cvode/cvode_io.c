@@ -1001,10 +1001,6 @@ int CVodeSetConstraints(void* cvode_mem, N_Vector constraints)
 int CVodeSetUseIntegratorFusedKernels(void* cvode_mem, sunbooleantype onoff)
 {
   CVodeMem cv_mem;
-#ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  N_Vector_ID id;
-#endif
-
   if (cvode_mem == NULL)
   {
     cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
@@ -1014,13 +1010,13 @@ int CVodeSetUseIntegratorFusedKernels(void* cvode_mem, sunbooleantype onoff)
   cv_mem = (CVodeMem)cvode_mem;
 
 #ifdef SUNDIALS_BUILD_PACKAGE_FUSED_KERNELS
-  id = N_VGetVectorID(cv_mem->cv_ewt);
-  if (!cv_mem->cv_MallocDone ||
-      (id != SUNDIALS_NVEC_CUDA && id != SUNDIALS_NVEC_HIP))
+  /* the fused kernel library that is linked decides which vectors it can
+     operate on */
+  if (!cv_mem->cv_MallocDone || !cvVectorSupported_fused(cv_mem->cv_ewt))
   {
     cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
                    "Fused Kernels not supported for the provided vector");
-    return (CV_MEM_NULL);
+    return (CV_ILL_INPUT);
   }
   cv_mem->cv_usefused = onoff;
   return (CV_SUCCESS);
@@ -313,7 +313,6 @@ static int cvNlsConvTest(SUNNonlinearSolver NLS, N_Vector ycor, N_Vector delta,
   CVodeMem cv_mem;
   int m, retval;
   sunrealtype del;
-  sunrealtype dcon;
 
   if (cvode_mem == NULL)
   {
@@ -329,29 +328,46 @@ static int cvNlsConvTest(SUNNonlinearSolver NLS, N_Vector ycor, N_Vector delta,
   retval = SUNNonlinSolGetCurIter(NLS, &m);
   if (retval != CV_SUCCESS) { return (CV_MEM_NULL); }
 
-  /* Test for convergence. If m > 0, an estimate of the convergence
-     rate constant is stored in crate, and used in the test.        */
-  if (m > 0)
-  {
-    cv_mem->cv_crate = SUNMAX(CRDOWN * cv_mem->cv_crate, del / cv_mem->cv_delp);
-  }
-  dcon = del * SUNMIN(ONE, cv_mem->cv_crate) / tol;
+  /* Test for convergence */
+  retval = cvNlsConvRateTest(m, del, tol, &(cv_mem->cv_crate),
+                             &(cv_mem->cv_delp));
 
-  if (dcon <= ONE)
+  if (retval == CV_SUCCESS)
   {
     cv_mem->cv_acnrm    = (m == 0) ? del : N_VWrmsNorm(ycor, ewt);
     cv_mem->cv_acnrmcur = SUNTRUE;
-    return (CV_SUCCESS); /* Nonlinear system was solved successfully */
   }
 
+  return (retval);
+}
+
+/* -----------------------------------------------------------------------------
+ * cvNlsConvRateTest
+ *
+ * This routine applies the convergence test of cvNlsConvTest to the norm del
+ * of the correction in iteration m. If m > 0, an estimate of the convergence
+ * rate constant is stored in crate and used in the test; delp holds the norm
+ * of the previous correction. The return value is CV_SUCCESS (converged),
+ * SUN_NLS_CONV_RECVR (diverging), or SUN_NLS_CONTINUE. It is shared with the
+ * ensemble mode (cvode_ensemble.c).
+ * ---------------------------------------------------------------------------*/
+
+int cvNlsConvRateTest(int m, sunrealtype del, sunrealtype tol,
+                      sunrealtype* crate, sunrealtype* delp)
+{
+  sunrealtype dcon;
+
+  if (m > 0) { *crate = SUNMAX(CRDOWN * (*crate), del / (*delp)); }
+  dcon = del * SUNMIN(ONE, *crate) / tol;
+
+  /* Nonlinear system was solved successfully */
+  if (dcon <= ONE) { return (CV_SUCCESS); }
+
   /* check if the iteration seems to be diverging */
-  if ((m >= 1) && (del > RDIV * cv_mem->cv_delp))
-  {
-    return (SUN_NLS_CONV_RECVR);
-  }
+  if ((m >= 1) && (del > RDIV * (*delp))) { return (SUN_NLS_CONV_RECVR); }
 
   /* Save norm of correction and loop again */
-  cv_mem->cv_delp = del;
+  *delp = del;
 
   /* Not yet converged */
   return (SUN_NLS_CONTINUE);
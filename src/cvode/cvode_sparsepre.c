@@ -0,0 +1,435 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the sparse Jacobian-based
+ * preconditioner and solver routines for use with the CVLS linear
+ * solver interface. The preconditioner matrix P = I - gamma*J is
+ * factored and applied by a user-supplied matrix-based linear
+ * solver, typically an incomplete factorization (SUNLinSol_ILU).
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+
+#include "cvode_impl.h"
+#include "cvode_ls_impl.h"
+#include "cvode_sparsepre_impl.h"
+
+#define ZERO SUN_RCONST(0.0)
+
+/* Prototypes of CVSparsePrecSetup and CVSparsePrecSolve */
+static int CVSparsePrecSetup(sunrealtype t, N_Vector y, N_Vector fy,
+                             sunbooleantype jok, sunbooleantype* jcurPtr,
+                             sunrealtype gamma, void* sp_data);
+static int CVSparsePrecSolve(sunrealtype t, N_Vector y, N_Vector fy, N_Vector r,
+                             N_Vector z, sunrealtype gamma, sunrealtype delta,
+                             int lr, void* sp_data);
+
+/* Prototype for CVSparsePrecFree */
+static int CVSparsePrecFree(CVodeMem cv_mem);
+static void CVSparsePrecFreeData(CVSparsePrecData pdata);
+
+/*-----------------------------------------------------------------
+  Initialization, Free, and Get Functions
+  NOTE: The difference quotient Jacobian assumes a serial/OpenMP/
+        Pthreads implementation of the NVECTOR package. Therefore,
+        when jac is NULL, CVSparsePrecInit will first test for a
+        compatible N_Vector internal representation by checking
+        that the function N_VGetArrayPointer exists.
+  -----------------------------------------------------------------*/
+int CVSparsePrecInit(void* cvode_mem, SUNMatrix Jpattern, SUNLinearSolver LS,
+                     CVLsJacFn jac)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  CVSparsePrecData pdata;
+  sunindextype N;
+  int flag;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CVLS_MEM_NULL, __LINE__, __func__, __FILE__,
+                   MSGSP_MEM_NULL);
+    return (CVLS_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Test if the CVLS linear solver interface has been attached */
+  if (cv_mem->cv_lmem == NULL)
+  {
+    cvProcessError(cv_mem, CVLS_LMEM_NULL, __LINE__, __func__, __FILE__,
+                   MSGSP_LMEM_NULL);
+    return (CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem)cv_mem->cv_lmem;
+
+  /* Test the Jacobian pattern and the preconditioner linear solver */
+  N = N_VGetLength(cv_mem->cv_tempv);
+  if ((Jpattern == NULL) || (SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+      (SUNSparseMatrix_Rows(Jpattern) != N) ||
+      (SUNSparseMatrix_Columns(Jpattern) != N))
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGSP_BAD_PATTERN);
+    return (CVLS_ILL_INPUT);
+  }
+  if (LS == NULL)
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGSP_LS_NULL);
+    return (CVLS_ILL_INPUT);
+  }
+
+  /* Test compatibility of NVECTOR package with the DQ Jacobian */
+  if ((jac == NULL) && (cv_mem->cv_tempv->ops->nvgetarraypointer == NULL))
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGSP_BAD_NVECTOR);
+    return (CVLS_ILL_INPUT);
+  }
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (CVSparsePrecData)calloc(1, sizeof *pdata);
+  if (pdata == NULL)
+  {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSGSP_MEM_FAIL);
+    return (CVLS_MEM_FAIL);
+  }
+
+  /* Load pointers into pdata block */
+  pdata->cvode_mem = cvode_mem;
+  pdata->LS        = LS;
+  pdata->jac       = jac;
+  pdata->nfeSP     = 0;
+  pdata->njeSP     = 0;
+
+  /* Allocate a copy of the pattern and the saved J and P matrices */
+  pdata->Jpat   = SUNMatClone(Jpattern);
+  pdata->savedJ = SUNMatClone(Jpattern);
+  pdata->savedP = SUNMatClone(Jpattern);
+  pdata->tmp1   = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp2   = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp3   = N_VClone(cv_mem->cv_tempv);
+  if ((pdata->Jpat == NULL) || (pdata->savedJ == NULL) ||
+      (pdata->savedP == NULL) || (pdata->tmp1 == NULL) ||
+      (pdata->tmp2 == NULL) || (pdata->tmp3 == NULL))
+  {
+    CVSparsePrecFreeData(pdata);
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSGSP_MEM_FAIL);
+    return (CVLS_MEM_FAIL);
+  }
+  if (SUNMatCopy(Jpattern, pdata->Jpat))
+  {
+    CVSparsePrecFreeData(pdata);
+    cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                   MSGSP_SUNMAT_FAIL);
+    return (CVLS_SUNMAT_FAIL);
+  }
+
+  /* Color the columns of the pattern for the DQ Jacobian */
+  if (jac == NULL)
+  {
+    pdata->colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+    if (pdata->colors == NULL)
+    {
+      CVSparsePrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                     MSGSP_MEM_FAIL);
+      return (CVLS_MEM_FAIL);
+    }
+    if (SUNSparseMatrix_ColorColumns(pdata->Jpat, pdata->colors,
+                                     &pdata->ncolors))
+    {
+      CVSparsePrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                     MSGSP_SUNMAT_FAIL);
+      return (CVLS_SUNMAT_FAIL);
+    }
+  }
+
+  /* initialize the preconditioner linear solver object */
+  flag = SUNLinSolInitialize(pdata->LS);
+  if (flag != SUN_SUCCESS)
+  {
+    CVSparsePrecFreeData(pdata);
+    cvProcessError(cv_mem, CVLS_SUNLS_FAIL, __LINE__, __func__, __FILE__,
+                   MSGSP_SUNLS_FAIL);
+    return (CVLS_SUNLS_FAIL);
+  }
+
+  /* make sure P_data is free from any previous allocations */
+  if (cvls_mem->pfree) { cvls_mem->pfree(cv_mem); }
+
+  /* Point to the new P_data field in the LS memory */
+  cvls_mem->P_data = pdata;
+
+  /* Attach the pfree function */
+  cvls_mem->pfree = CVSparsePrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = CVodeSetPreconditioner(cvode_mem, CVSparsePrecSetup,
+                                CVSparsePrecSolve);
+  return (flag);
+}
+
+/* Access the preconditioner data attached to cvode_mem */
+static int cvSparsePrecAccess(void* cvode_mem, const char* fname,
+                              CVodeMem* cv_mem, CVSparsePrecData* pdata)
+{
+  CVLsMem cvls_mem;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CVLS_MEM_NULL, __LINE__, fname, __FILE__,
+                   MSGSP_MEM_NULL);
+    return (CVLS_MEM_NULL);
+  }
+  *cv_mem = (CVodeMem)cvode_mem;
+
+  if ((*cv_mem)->cv_lmem == NULL)
+  {
+    cvProcessError(*cv_mem, CVLS_LMEM_NULL, __LINE__, fname, __FILE__,
+                   MSGSP_LMEM_NULL);
+    return (CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem)(*cv_mem)->cv_lmem;
+
+  if ((cvls_mem->P_data == NULL) || (cvls_mem->pfree != CVSparsePrecFree))
+  {
+    cvProcessError(*cv_mem, CVLS_PMEM_NULL, __LINE__, fname, __FILE__,
+                   MSGSP_PMEM_NULL);
+    return (CVLS_PMEM_NULL);
+  }
+  *pdata = (CVSparsePrecData)cvls_mem->P_data;
+
+  return (CVLS_SUCCESS);
+}
+
+int CVSparsePrecGetWorkSpace(void* cvode_mem, long int* lenrwSP,
+                             long int* leniwSP)
+{
+  CVodeMem cv_mem;
+  CVSparsePrecData pdata;
+  sunindextype lrw1, liw1;
+  long int lrw, liw;
+  int flag;
+
+  flag = cvSparsePrecAccess(cvode_mem, __func__, &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) { return (flag); }
+
+  /* sum space requirements for all objects owned by pdata, the
+     preconditioner linear solver is owned by the user */
+  *leniwSP = 4;
+  *lenrwSP = 0;
+  if (pdata->colors) { *leniwSP += N_VGetLength(cv_mem->cv_tempv); }
+  if (cv_mem->cv_tempv->ops->nvspace)
+  {
+    N_VSpace(cv_mem->cv_tempv, &lrw1, &liw1);
+    *leniwSP += 3 * liw1;
+    *lenrwSP += 3 * lrw1;
+  }
+  if (pdata->Jpat->ops->space)
+  {
+    flag = SUNMatSpace(pdata->Jpat, &lrw, &liw);
+    if (flag != 0) { return (-1); }
+    *leniwSP += 3 * liw;
+    *lenrwSP += 3 * lrw;
+  }
+
+  return (CVLS_SUCCESS);
+}
+
+int CVSparsePrecGetNumRhsEvals(void* cvode_mem, long int* nfevalsSP)
+{
+  CVodeMem cv_mem;
+  CVSparsePrecData pdata;
+  int flag;
+
+  flag = cvSparsePrecAccess(cvode_mem, __func__, &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) { return (flag); }
+
+  *nfevalsSP = pdata->nfeSP;
+
+  return (CVLS_SUCCESS);
+}
+
+int CVSparsePrecGetNumJacEvals(void* cvode_mem, long int* njevalsSP)
+{
+  CVodeMem cv_mem;
+  CVSparsePrecData pdata;
+  int flag;
+
+  flag = cvSparsePrecAccess(cvode_mem, __func__, &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) { return (flag); }
+
+  *njevalsSP = pdata->njeSP;
+
+  return (CVLS_SUCCESS);
+}
+
+/*-----------------------------------------------------------------
+  CVSparsePrecSetup
+  -----------------------------------------------------------------
+  Together CVSparsePrecSetup and CVSparsePrecSolve use a sparse
+  Jacobian to create a preconditioner. CVSparsePrecSetup computes
+  a new J with the user's Jacobian function or a colored difference
+  quotient when jok == SUNFALSE, then forms P = I - gamma*J and
+  calls the setup of the preconditioner linear solver (e.g., the
+  incomplete factorization of P).
+
+  The value to be returned by the CVSparsePrecSetup function is
+    0  if successful,
+    1  if a recoverable failure occurred, or
+   -1  if an unrecoverable failure occurred.
+  -----------------------------------------------------------------*/
+static int CVSparsePrecSetup(sunrealtype t, N_Vector y, N_Vector fy,
+                             sunbooleantype jok, sunbooleantype* jcurPtr,
+                             sunrealtype gamma, void* sp_data)
+{
+  CVSparsePrecData pdata;
+  CVodeMem cv_mem;
+  int retval;
+
+  pdata  = (CVSparsePrecData)sp_data;
+  cv_mem = (CVodeMem)pdata->cvode_mem;
+
+  if (jok)
+  {
+    /* If jok = SUNTRUE, use saved copy of J. */
+    *jcurPtr = SUNFALSE;
+  }
+  else
+  {
+    /* If jok = SUNFALSE, compute a new J. */
+    *jcurPtr = SUNTRUE;
+    pdata->njeSP++;
+
+    if (pdata->jac)
+    {
+      retval = SUNMatZero(pdata->savedJ);
+      if (retval)
+      {
+        cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__,
+                       MSGSP_SUNMAT_FAIL);
+        return (-1);
+      }
+
+      retval = pdata->jac(t, y, fy, pdata->savedJ, cv_mem->cv_user_data,
+                          pdata->tmp1, pdata->tmp2, pdata->tmp3);
+      if (retval < 0)
+      {
+        cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__,
+                       MSGSP_JACFUNC_FAILED);
+        return (-1);
+      }
+      if (retval > 0) { return (1); }
+    }
+    else
+    {
+      /* Load the pattern into savedJ, then form the colored DQ Jacobian */
+      if (SUNMatCopy(pdata->Jpat, pdata->savedJ))
+      {
+        cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__,
+                       MSGSP_SUNMAT_FAIL);
+        return (-1);
+      }
+      retval = cvLsColoredDQJac(t, y, fy, pdata->savedJ, pdata->colors,
+                                pdata->ncolors, cv_mem, pdata->tmp1,
+                                pdata->tmp2, pdata->tmp3, &pdata->nfeSP);
+      if (retval < 0)
+      {
+        cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__,
+                       MSGSP_RHSFUNC_FAILED);
+        return (-1);
+      }
+      if (retval > 0) { return (1); }
+    }
+  }
+
+  /* Copy J and scale and add identity to get savedP = I - gamma*J. */
+  retval = SUNMatCopy(pdata->savedJ, pdata->savedP);
+  if (retval == SUN_SUCCESS)
+  {
+    retval = SUNMatScaleAddI(-gamma, pdata->savedP);
+  }
+  if (retval)
+  {
+    cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__, MSGSP_SUNMAT_FAIL);
+    return (-1);
+  }
+
+  /* Factor P and return the (recoverable) error flag */
+  retval = SUNLinSolSetup(pdata->LS, pdata->savedP);
+  if (retval < 0)
+  {
+    cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__, MSGSP_SUNLS_FAIL);
+    return (-1);
+  }
+  return (retval);
+}
+
+/*-----------------------------------------------------------------
+  CVSparsePrecSolve
+  -----------------------------------------------------------------
+  CVSparsePrecSolve solves a linear system P z = r with the
+  preconditioner linear solver, where P is the matrix computed by
+  CVSparsePrecSetup. For an incomplete factorization the solve is
+  approximate, which is all that is required of a preconditioner.
+  -----------------------------------------------------------------*/
+static int CVSparsePrecSolve(SUNDIALS_MAYBE_UNUSED sunrealtype t,
+                             SUNDIALS_MAYBE_UNUSED N_Vector y,
+                             SUNDIALS_MAYBE_UNUSED N_Vector fy, N_Vector r,
+                             N_Vector z,
+                             SUNDIALS_MAYBE_UNUSED sunrealtype gamma,
+                             SUNDIALS_MAYBE_UNUSED sunrealtype delta,
+                             SUNDIALS_MAYBE_UNUSED int lr, void* sp_data)
+{
+  CVSparsePrecData pdata;
+  int retval;
+
+  pdata = (CVSparsePrecData)sp_data;
+
+  retval = SUNLinSolSolve(pdata->LS, pdata->savedP, z, r, ZERO);
+  return (retval);
+}
+
+static int CVSparsePrecFree(CVodeMem cv_mem)
+{
+  CVLsMem cvls_mem;
+
+  if (cv_mem->cv_lmem == NULL) { return (0); }
+  cvls_mem = (CVLsMem)cv_mem->cv_lmem;
+
+  if (cvls_mem->P_data == NULL) { return (0); }
+  CVSparsePrecFreeData((CVSparsePrecData)cvls_mem->P_data);
+  cvls_mem->P_data = NULL;
+
+  return (0);
+}
+
+/* Free the objects owned by pdata, the linear solver belongs to the user */
+static void CVSparsePrecFreeData(CVSparsePrecData pdata)
+{
+  if (pdata->Jpat) { SUNMatDestroy(pdata->Jpat); }
+  if (pdata->savedJ) { SUNMatDestroy(pdata->savedJ); }
+  if (pdata->savedP) { SUNMatDestroy(pdata->savedP); }
+  if (pdata->tmp1) { N_VDestroy(pdata->tmp1); }
+  if (pdata->tmp2) { N_VDestroy(pdata->tmp2); }
+  if (pdata->tmp3) { N_VDestroy(pdata->tmp3); }
+  free(pdata->colors);
+  free(pdata);
+}
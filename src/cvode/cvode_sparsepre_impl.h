@@ -0,0 +1,84 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Implementation header file for the CVSPARSEPRE module.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _CVSPARSEPRE_IMPL_H
+#define _CVSPARSEPRE_IMPL_H
+
+#include <cvode/cvode_sparsepre.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------------
+  Type: CVSparsePrecData
+  -----------------------------------------------------------------*/
+
+typedef struct CVSparsePrecDataRec
+{
+  /* Data set by user in CVSparsePrecInit */
+  SUNMatrix Jpat;
+  SUNLinearSolver LS;
+  CVLsJacFn jac;
+
+  /* Column coloring of Jpat for the difference quotient Jacobian */
+  sunindextype* colors;
+  sunindextype ncolors;
+
+  /* Data set by CVSparsePrecSetup */
+  SUNMatrix savedJ;
+  SUNMatrix savedP;
+  N_Vector tmp1;
+  N_Vector tmp2;
+  N_Vector tmp3;
+
+  /* Rhs calls and Jacobian evaluations */
+  long int nfeSP;
+  long int njeSP;
+
+  /* Pointer to cvode_mem */
+  void* cvode_mem;
+
+}* CVSparsePrecData;
+
+/*-----------------------------------------------------------------
+  CVSPARSEPRE error messages
+  -----------------------------------------------------------------*/
+
+#define MSGSP_MEM_NULL "Integrator memory is NULL."
+#define MSGSP_LMEM_NULL                                                    \
+  "Linear solver memory is NULL. One of the SPILS linear solvers must be " \
+  "attached."
+#define MSGSP_MEM_FAIL    "A memory request failed."
+#define MSGSP_BAD_NVECTOR "A required vector operation is not implemented."
+#define MSGSP_BAD_PATTERN \
+  "The Jacobian pattern must be a square SUNSparseMatrix of the system size."
+#define MSGSP_LS_NULL     "The preconditioner linear solver is NULL."
+#define MSGSP_SUNMAT_FAIL "An error arose from a SUNSparseMatrix routine."
+#define MSGSP_SUNLS_FAIL  "An error arose from the SUNLinearSolver routine."
+#define MSGSP_PMEM_NULL \
+  "Sparse preconditioner memory is NULL. CVSparsePrecInit must be called."
+#define MSGSP_RHSFUNC_FAILED \
+  "The right-hand side routine failed in an unrecoverable manner."
+#define MSGSP_JACFUNC_FAILED \
+  "The Jacobian routine failed in an unrecoverable manner."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
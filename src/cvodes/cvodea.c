@@ -22,6 +22,7 @@
  * =================================================================
  */
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sundials/sundials_math.h>
@@ -55,7 +56,17 @@
 
 static CVckpntMem CVAckpntInit(CVodeMem cv_mem);
 static CVckpntMem CVAckpntNew(CVodeMem cv_mem);
-static void CVAckpntDelete(CVckpntMem* ck_memPtr);
+static void CVAckpntDelete(CVadjMem ca_mem, CVckpntMem* ck_memPtr);
+static int CVAckpntPack(CVodeMem cv_mem, CVckpntMem ck_mem,
+                        sunbooleantype pack);
+static sunbooleantype CVAckpntCanPack(CVodeMem cv_mem);
+static void CVAckpntRemove(CVadjMem ca_mem, CVckpntMem* ck_memPtr);
+static sunbooleantype CVAckpntRemoveBest(CVadjMem ca_mem,
+                                         CVckpntMem* ck_memPtr);
+static void CVAckpntThin(CVadjMem ca_mem);
+static int CVAckpntRefine(CVodeMem cv_mem, CVckpntMem* ck_memPtr,
+                          sunrealtype tB);
+static int CVAckpntMaxFromMem(CVodeMem cv_mem);
 
 static void CVAbckpbDelete(CVodeBMem* cvB_memPtr);
 
@@ -162,6 +173,17 @@ int CVodeAdjInit(void* cvode_mem, long int steps, int interp)
   /* No interpolation data is available */
   ca_mem->ca_ckpntData = NULL;
 
+  /* No limit on the number of check points */
+  ca_mem->ca_maxckpnts = 0;
+  ca_mem->ca_ckpntMem  = 0;
+  ca_mem->ca_nrecomp   = 0;
+
+  /* Check points are kept in vectors */
+  ca_mem->ca_ckstore  = NULL;
+  ca_mem->ca_ckkey    = 0;
+  ca_mem->ca_ckbuf    = NULL;
+  ca_mem->ca_ckbuflen = 0;
+
   /* ------------------------------------
    * Initialization of interpolation data
    * ------------------------------------ */
@@ -322,13 +344,14 @@ int CVodeAdjReInit(void* cvode_mem)
 
   /* Free current list of Check Points */
 
-  while (ca_mem->ck_mem != NULL) { CVAckpntDelete(&(ca_mem->ck_mem)); }
+  while (ca_mem->ck_mem != NULL) { CVAckpntDelete(ca_mem, &(ca_mem->ck_mem)); }
 
   /* Initialization of check points */
 
   ca_mem->ck_mem       = NULL;
   ca_mem->ca_nckpnts   = 0;
   ca_mem->ca_ckpntData = NULL;
+  ca_mem->ca_nrecomp   = 0;
 
   /* CVodeF and CVodeB not called yet */
 
@@ -360,7 +383,7 @@ void CVodeAdjFree(void* cvode_mem)
     ca_mem = cv_mem->cv_adj_mem;
 
     /* Delete check points one by one */
-    while (ca_mem->ck_mem != NULL) { CVAckpntDelete(&(ca_mem->ck_mem)); }
+    while (ca_mem->ck_mem != NULL) { CVAckpntDelete(ca_mem, &(ca_mem->ck_mem)); }
 
     /* Free vectors at all data points */
     if (ca_mem->ca_IMmallocDone) { ca_mem->ca_IMfree(cv_mem); }
@@ -375,6 +398,9 @@ void CVodeAdjFree(void* cvode_mem)
     /* Delete backward problems one by one */
     while (ca_mem->cvB_mem != NULL) { CVAbckpbDelete(&(ca_mem->cvB_mem)); }
 
+    /* Free the check point pack buffer */
+    free(ca_mem->ca_ckbuf);
+
     /* Free CVODEA memory */
     free(ca_mem);
     cv_mem->cv_adj_mem = NULL;
@@ -451,6 +477,28 @@ int CVodeF(void* cvode_mem, sunrealtype tout, N_Vector yout, sunrealtype* tret,
     return (CV_ILL_INPUT);
   }
 
+  /* Convert the check point memory budget to a number of check points */
+  if (ca_mem->ca_ckpntMem > 0)
+  {
+    ca_mem->ca_maxckpnts = CVAckpntMaxFromMem(cv_mem);
+    if (ca_mem->ca_maxckpnts < 3)
+    {
+      cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                     MSGCV_BAD_CKPNTMEM);
+      SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+      return (CV_ILL_INPUT);
+    }
+  }
+
+  /* A check point store needs the vector buffer operations */
+  if (ca_mem->ca_ckstore != NULL && !CVAckpntCanPack(cv_mem))
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_BAD_CKSTORE);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
   /* All error checking done */
 
   dt_mem = ca_mem->dt_mem;
@@ -579,7 +627,8 @@ int CVodeF(void* cvode_mem, sunrealtype tout, N_Vector yout, sunrealtype* tret,
 
     if (cv_mem->cv_nst % ca_mem->ca_nsteps == 0)
     {
-      ca_mem->ck_mem->ck_t1 = cv_mem->cv_tn;
+      ca_mem->ck_mem->ck_t1   = cv_mem->cv_tn;
+      ca_mem->ck_mem->ck_nst1 = cv_mem->cv_nst;
 
       /* Create a new check point, load it, and append it to the list */
       tmp = CVAckpntNew(cv_mem);
@@ -595,6 +644,9 @@ int CVodeF(void* cvode_mem, sunrealtype tout, N_Vector yout, sunrealtype* tret,
       ca_mem->ca_nckpnts++;
       cv_mem->cv_forceSetup = SUNTRUE;
 
+      /* Keep the number of check points within the limit (if any) */
+      CVAckpntThin(ca_mem);
+
       /* Reset i=0 and load dt_mem[0] */
       dt_mem[0]->t = ca_mem->ck_mem->ck_t0;
       ca_mem->ca_IMstore(cv_mem, dt_mem[0]);
@@ -609,7 +661,8 @@ int CVodeF(void* cvode_mem, sunrealtype tout, N_Vector yout, sunrealtype* tret,
     /* Set t1 field of the current ckeck point structure
        for the case in which there will be no future
        check points */
-    ca_mem->ck_mem->ck_t1 = cv_mem->cv_tn;
+    ca_mem->ck_mem->ck_t1   = cv_mem->cv_tn;
+    ca_mem->ck_mem->ck_nst1 = cv_mem->cv_nst;
 
     /* tfinal is now set to tn */
     ca_mem->ca_tfinal = cv_mem->cv_tn;
@@ -1525,6 +1578,32 @@ int CVodeB(void* cvode_mem, sunrealtype tBout, int itaskB)
       tmp_cvB_mem = tmp_cvB_mem->cv_next;
     }
 
+    /* If the forward solution was thinned out between this check point and
+       the next one, place new check points in between and search again */
+    if (gotCheckpoint &&
+        (ck_mem->ck_nst1 - ck_mem->ck_nst > ca_mem->ca_nsteps))
+    {
+      tBn         = cvB_mem->cv_mem->cv_tn;
+      tmp_cvB_mem = cvB_mem->cv_next;
+      while (tmp_cvB_mem != NULL)
+      {
+        if (sign * (tmp_cvB_mem->cv_mem->cv_tn - tBn) > ZERO)
+        {
+          tBn = tmp_cvB_mem->cv_mem->cv_tn;
+        }
+        tmp_cvB_mem = tmp_cvB_mem->cv_next;
+      }
+
+      flag = CVAckpntRefine(cv_mem, &ck_mem, tBn);
+      if (flag != CV_SUCCESS)
+      {
+        SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+        return (flag);
+      }
+      gotCheckpoint = SUNFALSE;
+      continue;
+    }
+
     if (gotCheckpoint) { break; }
 
     if (ck_mem->ck_next == NULL) { break; }
@@ -1537,6 +1616,14 @@ int CVodeB(void* cvode_mem, sunrealtype tBout, int itaskB)
 
   for (;;)
   {
+    /* Place new check points if the forward solution was thinned out */
+
+    if (ck_mem->ck_nst1 - ck_mem->ck_nst > ca_mem->ca_nsteps)
+    {
+      flag = CVAckpntRefine(cv_mem, &ck_mem, ck_mem->ck_t1);
+      if (flag != CV_SUCCESS) { break; }
+    }
+
     /* Store interpolation data if not available.
        This is the 2nd forward integration pass */
 
@@ -1790,10 +1877,13 @@ static CVckpntMem CVAckpntInit(CVodeMem cv_mem)
 
   /* Load ckdata from cv_mem */
   N_VScale(ONE, cv_mem->cv_zn[0], ck_mem->ck_zn[0]);
-  ck_mem->ck_t0  = cv_mem->cv_tn;
-  ck_mem->ck_nst = 0;
-  ck_mem->ck_q   = 1;
-  ck_mem->ck_h   = ZERO;
+  ck_mem->ck_t0     = cv_mem->cv_tn;
+  ck_mem->ck_nst    = 0;
+  ck_mem->ck_nst1   = 0;
+  ck_mem->ck_q      = 1;
+  ck_mem->ck_h      = ZERO;
+  ck_mem->ck_stored = SUNFALSE;
+  ck_mem->ck_key    = 0;
 
   /* Do we need to carry quadratures */
   ck_mem->ck_quadr = cv_mem->cv_quadr && cv_mem->cv_errconQ;
@@ -1892,6 +1982,49 @@ static CVckpntMem CVAckpntNew(CVodeMem cv_mem)
   qmax           = cv_mem->cv_qmax;
   ck_mem->ck_zqm = (cv_mem->cv_q < qmax) ? qmax : 0;
 
+  /* Load step data from cv_mem */
+  for (j = 0; j <= L_MAX; j++) { ck_mem->ck_tau[j] = cv_mem->cv_tau[j]; }
+  for (j = 0; j <= NUM_TESTS; j++) { ck_mem->ck_tq[j] = cv_mem->cv_tq[j]; }
+  for (j = 0; j <= cv_mem->cv_q; j++) { ck_mem->ck_l[j] = cv_mem->cv_l[j]; }
+  ck_mem->ck_nst       = cv_mem->cv_nst;
+  ck_mem->ck_nst1      = cv_mem->cv_nst;
+  ck_mem->ck_tretlast  = cv_mem->cv_tretlast;
+  ck_mem->ck_q         = cv_mem->cv_q;
+  ck_mem->ck_qprime    = cv_mem->cv_qprime;
+  ck_mem->ck_qwait     = cv_mem->cv_qwait;
+  ck_mem->ck_L         = cv_mem->cv_L;
+  ck_mem->ck_gammap    = cv_mem->cv_gammap;
+  ck_mem->ck_h         = cv_mem->cv_h;
+  ck_mem->ck_hprime    = cv_mem->cv_hprime;
+  ck_mem->ck_hscale    = cv_mem->cv_hscale;
+  ck_mem->ck_eta       = cv_mem->cv_eta;
+  ck_mem->ck_etamax    = cv_mem->cv_etamax;
+  ck_mem->ck_t0        = cv_mem->cv_tn;
+  ck_mem->ck_t1        = cv_mem->cv_tn;
+  ck_mem->ck_saved_tq5 = cv_mem->cv_saved_tq5;
+  ck_mem->ck_stored    = SUNFALSE;
+  ck_mem->ck_key       = 0;
+
+  /* With a check point store, pack the arrays into the store instead of
+     copying them to new vectors */
+  if (cv_mem->cv_adj_mem->ca_ckstore != NULL)
+  {
+    ck_mem->ck_quadr       = cv_mem->cv_quadr && cv_mem->cv_errconQ;
+    ck_mem->ck_sensi       = cv_mem->cv_sensi;
+    ck_mem->ck_Ns          = cv_mem->cv_Ns;
+    ck_mem->ck_quadr_sensi = cv_mem->cv_quadr_sensi && cv_mem->cv_errconQS;
+    ck_mem->ck_stored      = SUNTRUE;
+    ck_mem->ck_key         = cv_mem->cv_adj_mem->ca_ckkey++;
+
+    if (CVAckpntPack(cv_mem, ck_mem, SUNTRUE) != CV_SUCCESS)
+    {
+      free(ck_mem);
+      ck_mem = NULL;
+    }
+
+    return (ck_mem);
+  }
+
   for (j = 0; j <= cv_mem->cv_q; j++)
   {
     ck_mem->ck_zn[j] = N_VClone(cv_mem->cv_tempv);
@@ -2170,24 +2303,6 @@ static CVckpntMem CVAckpntNew(CVodeMem cv_mem)
     }
   }
 
-  for (j = 0; j <= L_MAX; j++) { ck_mem->ck_tau[j] = cv_mem->cv_tau[j]; }
-  for (j = 0; j <= NUM_TESTS; j++) { ck_mem->ck_tq[j] = cv_mem->cv_tq[j]; }
-  for (j = 0; j <= cv_mem->cv_q; j++) { ck_mem->ck_l[j] = cv_mem->cv_l[j]; }
-  ck_mem->ck_nst       = cv_mem->cv_nst;
-  ck_mem->ck_tretlast  = cv_mem->cv_tretlast;
-  ck_mem->ck_q         = cv_mem->cv_q;
-  ck_mem->ck_qprime    = cv_mem->cv_qprime;
-  ck_mem->ck_qwait     = cv_mem->cv_qwait;
-  ck_mem->ck_L         = cv_mem->cv_L;
-  ck_mem->ck_gammap    = cv_mem->cv_gammap;
-  ck_mem->ck_h         = cv_mem->cv_h;
-  ck_mem->ck_hprime    = cv_mem->cv_hprime;
-  ck_mem->ck_hscale    = cv_mem->cv_hscale;
-  ck_mem->ck_eta       = cv_mem->cv_eta;
-  ck_mem->ck_etamax    = cv_mem->cv_etamax;
-  ck_mem->ck_t0        = cv_mem->cv_tn;
-  ck_mem->ck_saved_tq5 = cv_mem->cv_saved_tq5;
-
   return (ck_mem);
 }
 
@@ -2198,7 +2313,7 @@ static CVckpntMem CVAckpntNew(CVodeMem cv_mem)
  * the new list head
  */
 
-static void CVAckpntDelete(CVckpntMem* ck_memPtr)
+static void CVAckpntDelete(CVadjMem ca_mem, CVckpntMem* ck_memPtr)
 {
   CVckpntMem tmp;
   int j;
@@ -2211,6 +2326,15 @@ static void CVAckpntDelete(CVckpntMem* ck_memPtr)
   /* move head of list */
   *ck_memPtr = (*ck_memPtr)->ck_next;
 
+  /* a stored check point has no vectors, only a record in the store */
+  if (tmp->ck_stored)
+  {
+    (void)SUNCheckpointStore_Remove(ca_mem->ca_ckstore, tmp->ck_key);
+    free(tmp);
+    tmp = NULL;
+    return;
+  }
+
   /* free N_Vectors in tmp */
   for (j = 0; j <= tmp->ck_q; j++) { N_VDestroy(tmp->ck_zn[j]); }
   if (tmp->ck_zqm != 0) { N_VDestroy(tmp->ck_zn[tmp->ck_zqm]); }
@@ -2270,6 +2394,500 @@ static void CVAckpntDelete(CVckpntMem* ck_memPtr)
   tmp = NULL;
 }
 
+/*
+ * CVAckpntPack
+ *
+ * This routine packs the Nordsieck arrays of cv_mem into the check
+ * point store under the key of ck_mem (pack = SUNTRUE) or unpacks
+ * them from the store into cv_mem (pack = SUNFALSE). The record
+ * holds zn, znQ, znS, and znQS for j = 0,...,q and, if needed, qmax.
+ */
+
+static int CVAckpntPack(CVodeMem cv_mem, CVckpntMem ck_mem, sunbooleantype pack)
+{
+  CVadjMem ca_mem;
+  sunindextype ysize, qsize;
+  size_t nvecs, nbytes, offset;
+  char* buf;
+  int j, jj, is, nj;
+  SUNErrCode err;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  /* Size of one state and one quadrature vector */
+  if (N_VBufSize(cv_mem->cv_zn[0], &ysize) != SUN_SUCCESS)
+  {
+    return (CV_VECTOROP_ERR);
+  }
+  qsize = 0;
+  if (ck_mem->ck_quadr || ck_mem->ck_quadr_sensi)
+  {
+    if (N_VBufSize(cv_mem->cv_znQ[0], &qsize) != SUN_SUCCESS)
+    {
+      return (CV_VECTOROP_ERR);
+    }
+  }
+
+  /* Size of the record */
+  nj     = (ck_mem->ck_zqm != 0) ? ck_mem->ck_q + 2 : ck_mem->ck_q + 1;
+  nvecs  = (size_t)nj;
+  nbytes = nvecs * (size_t)ysize;
+  if (ck_mem->ck_quadr) { nbytes += nvecs * (size_t)qsize; }
+  if (ck_mem->ck_sensi) { nbytes += nvecs * ck_mem->ck_Ns * (size_t)ysize; }
+  if (ck_mem->ck_quadr_sensi)
+  {
+    nbytes += nvecs * ck_mem->ck_Ns * (size_t)qsize;
+  }
+
+  /* Grow the staging buffer if needed */
+  if (nbytes > ca_mem->ca_ckbuflen)
+  {
+    buf = (char*)realloc(ca_mem->ca_ckbuf, nbytes);
+    if (buf == NULL) { return (CV_MEM_FAIL); }
+    ca_mem->ca_ckbuf    = buf;
+    ca_mem->ca_ckbuflen = nbytes;
+  }
+  buf = ca_mem->ca_ckbuf;
+
+  if (!pack)
+  {
+    err = SUNCheckpointStore_Read(ca_mem->ca_ckstore, ck_mem->ck_key, buf,
+                                  nbytes);
+    if (err != SUN_SUCCESS) { return (CV_MEM_FAIL); }
+
+    /* The next check point back is the one needed after this one */
+    if (ck_mem->ck_next != NULL && ck_mem->ck_next->ck_stored)
+    {
+      (void)SUNCheckpointStore_Prefetch(ca_mem->ca_ckstore,
+                                        ck_mem->ck_next->ck_key);
+    }
+  }
+
+  offset = 0;
+  for (jj = 0; jj < nj; jj++)
+  {
+    j = (jj <= ck_mem->ck_q) ? jj : ck_mem->ck_zqm;
+
+    if (pack) { err = N_VBufPack(cv_mem->cv_zn[j], buf + offset); }
+    else { err = N_VBufUnpack(cv_mem->cv_zn[j], buf + offset); }
+    if (err != SUN_SUCCESS) { return (CV_VECTOROP_ERR); }
+    offset += ysize;
+
+    if (ck_mem->ck_quadr)
+    {
+      if (pack) { err = N_VBufPack(cv_mem->cv_znQ[j], buf + offset); }
+      else { err = N_VBufUnpack(cv_mem->cv_znQ[j], buf + offset); }
+      if (err != SUN_SUCCESS) { return (CV_VECTOROP_ERR); }
+      offset += qsize;
+    }
+
+    if (ck_mem->ck_sensi)
+    {
+      for (is = 0; is < ck_mem->ck_Ns; is++)
+      {
+        if (pack) { err = N_VBufPack(cv_mem->cv_znS[j][is], buf + offset); }
+        else { err = N_VBufUnpack(cv_mem->cv_znS[j][is], buf + offset); }
+        if (err != SUN_SUCCESS) { return (CV_VECTOROP_ERR); }
+        offset += ysize;
+      }
+    }
+
+    if (ck_mem->ck_quadr_sensi)
+    {
+      for (is = 0; is < ck_mem->ck_Ns; is++)
+      {
+        if (pack) { err = N_VBufPack(cv_mem->cv_znQS[j][is], buf + offset); }
+        else { err = N_VBufUnpack(cv_mem->cv_znQS[j][is], buf + offset); }
+        if (err != SUN_SUCCESS) { return (CV_VECTOROP_ERR); }
+        offset += qsize;
+      }
+    }
+  }
+
+  if (pack)
+  {
+    err = SUNCheckpointStore_Write(ca_mem->ca_ckstore, ck_mem->ck_key, buf,
+                                   nbytes);
+    if (err != SUN_SUCCESS) { return (CV_MEM_FAIL); }
+  }
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVAckpntCanPack
+ *
+ * This routine checks that the vectors carried in check points
+ * implement the buffer operations used by CVAckpntPack.
+ */
+
+static sunbooleantype CVAckpntCanPack(CVodeMem cv_mem)
+{
+  N_Vector v;
+
+  v = cv_mem->cv_zn[0];
+  if (v->ops->nvbufsize == NULL || v->ops->nvbufpack == NULL ||
+      v->ops->nvbufunpack == NULL)
+  {
+    return (SUNFALSE);
+  }
+
+  if ((cv_mem->cv_quadr && cv_mem->cv_errconQ) ||
+      (cv_mem->cv_quadr_sensi && cv_mem->cv_errconQS))
+  {
+    v = cv_mem->cv_znQ[0];
+    if (v->ops->nvbufsize == NULL || v->ops->nvbufpack == NULL ||
+        v->ops->nvbufunpack == NULL)
+    {
+      return (SUNFALSE);
+    }
+  }
+
+  return (SUNTRUE);
+}
+
+/*
+ * CVAckpntRemove
+ *
+ * This routine removes the check point *ck_memPtr from the list.
+ * The check point before it (which must exist) is extended to cover
+ * the interval of the removed one.
+ */
+
+static void CVAckpntRemove(CVadjMem ca_mem, CVckpntMem* ck_memPtr)
+{
+  CVckpntMem ck_mem, ck_prev;
+
+  ck_mem  = *ck_memPtr;
+  ck_prev = ck_mem->ck_next;
+
+  ck_prev->ck_t1   = ck_mem->ck_t1;
+  ck_prev->ck_nst1 = ck_mem->ck_nst1;
+
+  /* The interpolation data no longer matches a check point interval */
+  if ((ca_mem->ca_ckpntData == ck_mem) || (ca_mem->ca_ckpntData == ck_prev))
+  {
+    ca_mem->ca_ckpntData = NULL;
+  }
+
+  CVAckpntDelete(ca_mem, ck_memPtr);
+  ca_mem->ca_nckpnts--;
+}
+
+/*
+ * CVAckpntRemoveBest
+ *
+ * This routine removes, among the check points starting at *ck_memPtr
+ * (excluding the one at the initial time), the one whose removal
+ * creates the shortest interval (the oldest one in case of a tie).
+ * It returns SUNFALSE if there is no such check point.
+ */
+
+static sunbooleantype CVAckpntRemoveBest(CVadjMem ca_mem, CVckpntMem* ck_memPtr)
+{
+  CVckpntMem* minPtr;
+  long int len, minlen;
+
+  minPtr = NULL;
+  minlen = 0;
+
+  while ((*ck_memPtr != NULL) && ((*ck_memPtr)->ck_next != NULL))
+  {
+    len = (*ck_memPtr)->ck_nst1 - (*ck_memPtr)->ck_next->ck_nst;
+    if ((minPtr == NULL) || (len <= minlen))
+    {
+      minPtr = ck_memPtr;
+      minlen = len;
+    }
+    ck_memPtr = &((*ck_memPtr)->ck_next);
+  }
+
+  if (minPtr == NULL) { return (SUNFALSE); }
+
+  CVAckpntRemove(ca_mem, minPtr);
+
+  return (SUNTRUE);
+}
+
+/*
+ * CVAckpntThin
+ *
+ * This routine enforces the limit on the number of check points
+ * during the forward integration. One check point is kept in reserve
+ * for CVodeB. The first and last check points are never removed.
+ */
+
+static void CVAckpntThin(CVadjMem ca_mem)
+{
+  if (ca_mem->ca_maxckpnts == 0) { return; }
+
+  while (ca_mem->ca_nckpnts + 1 > ca_mem->ca_maxckpnts - 1)
+  {
+    if (!CVAckpntRemoveBest(ca_mem, &(ca_mem->ck_mem->ck_next))) { break; }
+  }
+}
+
+/*
+ * CVAckpntRefine
+ *
+ * This routine is called by CVodeB for a check point *ck_memPtr
+ * whose interval spans more than nsteps steps (after check points
+ * in between were removed to respect the limit on the number of
+ * check points). It integrates the forward problem again from
+ * *ck_memPtr and inserts new check points at multiples of nsteps
+ * steps, until the interval containing tB spans at most nsteps steps.
+ * On return, *ck_memPtr is the check point at the start of that
+ * interval.
+ *
+ * If tB is before the end of the interval, a first pass finds the
+ * first multiple of nsteps steps past tB and stores a check point
+ * there. The check points before it are then placed with the binomial
+ * (revolve) schedule: with s free check points and m blocks of nsteps
+ * steps left, let r be the smallest integer with C(s+r,s) >= m. The
+ * next check point leaves at most C(s+r-1,s-1) blocks after it, so
+ * that no block is integrated more than r times in the backward
+ * sweep.
+ *
+ * If the number of check points is limited, the check points after
+ * the next one are no longer needed by the backward sweep and are
+ * removed to free storage. If this is not enough, check points
+ * before *ck_memPtr are removed as in CVAckpntThin.
+ *
+ * Return values:
+ * CV_SUCCESS
+ * CV_REIFWD_FAIL
+ * CV_FWD_FAIL
+ * CV_MEM_FAIL
+ */
+
+static int CVAckpntRefine(CVodeMem cv_mem, CVckpntMem* ck_memPtr,
+                          sunrealtype tB)
+{
+  CVadjMem ca_mem;
+  CVckpntMem ck_mem, tmp;
+  CVckpntMem* prevPtr;
+  long int nsteps, nst1, m, s, r, beta, nfree, nneed, target;
+  sunrealtype t1, t;
+  sunbooleantype findtB;
+  int flag, sign;
+
+  ca_mem = cv_mem->cv_adj_mem;
+  ck_mem = *ck_memPtr;
+  nsteps = ca_mem->ca_nsteps;
+  nst1   = ck_mem->ck_nst1;
+  t1     = ck_mem->ck_t1;
+
+  sign   = (ca_mem->ca_tfinal - ca_mem->ca_tinitial > ZERO) ? 1 : -1;
+  findtB = (sign * (t1 - tB) > ZERO);
+
+  /* Find the link to ck_mem in the list */
+  prevPtr = &(ca_mem->ck_mem);
+  while (*prevPtr != ck_mem) { prevPtr = &((*prevPtr)->ck_next); }
+
+  /* Number of blocks of nsteps steps in the interval */
+  m = (nst1 - ck_mem->ck_nst + nsteps - 1) / nsteps;
+
+  /* Number of check points that can be added */
+  if (ca_mem->ca_maxckpnts > 0)
+  {
+    nfree = ca_mem->ca_maxckpnts - (ca_mem->ca_nckpnts + 1);
+    nneed = findtB ? 2 : 1;
+
+    while ((nfree < m - 1) && (ca_mem->ck_mem != ck_mem) &&
+           (ca_mem->ck_mem->ck_next != ck_mem))
+    {
+      CVAckpntRemove(ca_mem, &(ca_mem->ck_mem));
+      nfree++;
+    }
+
+    while (nfree < nneed)
+    {
+      if (!CVAckpntRemoveBest(ca_mem, &(ck_mem->ck_next))) { break; }
+      nfree++;
+    }
+
+    /* Always allow one new check point so that CVodeB can proceed */
+    if (nfree < 1) { nfree = 1; }
+  }
+  else { nfree = m - 1; }
+
+  /* Restart the forward problem from ck_mem */
+  flag = CVAckpntGet(cv_mem, ck_mem);
+  if (flag != CV_SUCCESS) { return (CV_REIFWD_FAIL); }
+
+  if (ca_mem->ca_tstopCVodeFcall)
+  {
+    CVodeSetStopTime(cv_mem, ca_mem->ca_tstopCVodeF);
+  }
+
+  /* Find the end of the block containing tB */
+  if (findtB && (nfree > 1))
+  {
+    while (cv_mem->cv_nst < nst1)
+    {
+      flag = CVode(cv_mem, t1, ca_mem->ca_ytmp, &t, CV_ONE_STEP);
+      if (flag < 0) { return (CV_FWD_FAIL); }
+
+      ca_mem->ca_nrecomp++;
+
+      if (cv_mem->cv_nst % nsteps == 0)
+      {
+        cv_mem->cv_forceSetup = SUNTRUE;
+        if (sign * (cv_mem->cv_tn - tB) >= ZERO) { break; }
+      }
+    }
+
+    if (cv_mem->cv_nst < nst1)
+    {
+      tmp = CVAckpntNew(cv_mem);
+      if (tmp == NULL)
+      {
+        cvProcessError(cv_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                       MSGCV_MEM_FAIL);
+        return (CV_MEM_FAIL);
+      }
+
+      tmp->ck_t1      = t1;
+      tmp->ck_nst1    = nst1;
+      ck_mem->ck_t1   = tmp->ck_t0;
+      ck_mem->ck_nst1 = tmp->ck_nst;
+
+      tmp->ck_next = ck_mem;
+      *prevPtr     = tmp;
+      prevPtr      = &(tmp->ck_next);
+      ca_mem->ca_nckpnts++;
+      nfree--;
+
+      nst1 = ck_mem->ck_nst1;
+      t1   = ck_mem->ck_t1;
+    }
+
+    flag = CVAckpntGet(cv_mem, ck_mem);
+    if (flag != CV_SUCCESS) { return (CV_REIFWD_FAIL); }
+
+    if (ca_mem->ca_tstopCVodeFcall)
+    {
+      CVodeSetStopTime(cv_mem, ca_mem->ca_tstopCVodeF);
+    }
+  }
+
+  /* Place the check points with the binomial schedule */
+  while ((nst1 - ck_mem->ck_nst > nsteps) && (nfree > 0))
+  {
+    m = (nst1 - ck_mem->ck_nst + nsteps - 1) / nsteps;
+    s = (nfree < m - 1) ? nfree : m - 1;
+
+    /* beta = C(s+r,s) for the smallest r with C(s+r,s) >= m */
+    r    = 0;
+    beta = 1;
+    while (beta < m)
+    {
+      r++;
+      beta = beta * (s + r) / r;
+    }
+
+    /* Leave C(s+r-1,s-1) blocks after the new check point */
+    target = m - beta * s / (s + r);
+    if (target < 1) { target = 1; }
+    target = ck_mem->ck_nst + target * nsteps;
+
+    /* Integrate to the new check point, forcing a linear solver setup
+       wherever CVodeF created a check point */
+    while (cv_mem->cv_nst < target)
+    {
+      flag = CVode(cv_mem, t1, ca_mem->ca_ytmp, &t, CV_ONE_STEP);
+      if (flag < 0) { return (CV_FWD_FAIL); }
+
+      ca_mem->ca_nrecomp++;
+
+      if (cv_mem->cv_nst % nsteps == 0) { cv_mem->cv_forceSetup = SUNTRUE; }
+    }
+
+    /* Create the new check point and insert it after ck_mem */
+    tmp = CVAckpntNew(cv_mem);
+    if (tmp == NULL)
+    {
+      cvProcessError(cv_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                     MSGCV_MEM_FAIL);
+      return (CV_MEM_FAIL);
+    }
+
+    tmp->ck_t1      = t1;
+    tmp->ck_nst1    = nst1;
+    ck_mem->ck_t1   = tmp->ck_t0;
+    ck_mem->ck_nst1 = tmp->ck_nst;
+
+    tmp->ck_next = ck_mem;
+    *prevPtr     = tmp;
+    ca_mem->ca_nckpnts++;
+
+    ck_mem = tmp;
+    nfree--;
+  }
+
+  *ck_memPtr = ck_mem;
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVAckpntMaxFromMem
+ *
+ * This routine returns the number of check points that fit in the
+ * check point memory budget.
+ */
+
+static int CVAckpntMaxFromMem(CVodeMem cv_mem)
+{
+  CVadjMem ca_mem;
+  sunindextype lrw, liw, lrwQ, liwQ;
+  size_t nvec, nvecQ, ckbytes, maxck;
+
+  ca_mem = cv_mem->cv_adj_mem;
+
+  /* Storage for one state vector */
+  if (cv_mem->cv_tempv->ops->nvspace != NULL)
+  {
+    N_VSpace(cv_mem->cv_tempv, &lrw, &liw);
+  }
+  else
+  {
+    lrw = N_VGetLength(cv_mem->cv_tempv);
+    liw = 0;
+  }
+
+  /* Number of state and quadrature vectors in a check point (at most
+     qmax+1 Nordsieck vectors of each kind) */
+  nvec  = 1;
+  nvecQ = 0;
+  if (cv_mem->cv_sensi) { nvec += cv_mem->cv_Ns; }
+  if (cv_mem->cv_quadr && cv_mem->cv_errconQ) { nvecQ += 1; }
+  if (cv_mem->cv_quadr_sensi && cv_mem->cv_errconQS) { nvecQ += cv_mem->cv_Ns; }
+
+  ckbytes = sizeof(struct CVckpntMemRec) +
+            (cv_mem->cv_qmax + 1) * nvec *
+              (lrw * sizeof(sunrealtype) + liw * sizeof(sunindextype));
+
+  if (nvecQ > 0)
+  {
+    if (cv_mem->cv_tempvQ->ops->nvspace != NULL)
+    {
+      N_VSpace(cv_mem->cv_tempvQ, &lrwQ, &liwQ);
+    }
+    else
+    {
+      lrwQ = N_VGetLength(cv_mem->cv_tempvQ);
+      liwQ = 0;
+    }
+    ckbytes += (cv_mem->cv_qmax + 1) * nvecQ *
+               (lrwQ * sizeof(sunrealtype) + liwQ * sizeof(sunindextype));
+  }
+
+  maxck = ca_mem->ca_ckpntMem / ckbytes;
+
+  return ((maxck > INT_MAX) ? INT_MAX : (int)maxck);
+}
+
 /*
  * =================================================================
  * PRIVATE FUNCTIONS FOR BACKWARD PROBLEMS
@@ -2434,83 +3052,92 @@ static int CVAckpntGet(CVodeMem cv_mem, CVckpntMem ck_mem)
 
     /* Copy the arrays from check point data structure */
 
-    for (j = 0; j <= cv_mem->cv_q; j++) { cv_mem->cv_cvals[j] = ONE; }
-
-    retval = N_VScaleVectorArray(cv_mem->cv_q + 1, cv_mem->cv_cvals,
-                                 ck_mem->ck_zn, cv_mem->cv_zn);
-    if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
-
-    if (cv_mem->cv_q < qmax)
+    if (ck_mem->ck_stored)
     {
-      N_VScale(ONE, ck_mem->ck_zn[qmax], cv_mem->cv_zn[qmax]);
+      retval = CVAckpntPack(cv_mem, ck_mem, SUNFALSE);
+      if (retval != CV_SUCCESS) { return (retval); }
     }
-
-    if (ck_mem->ck_quadr)
+    else
     {
       for (j = 0; j <= cv_mem->cv_q; j++) { cv_mem->cv_cvals[j] = ONE; }
 
       retval = N_VScaleVectorArray(cv_mem->cv_q + 1, cv_mem->cv_cvals,
-                                   ck_mem->ck_znQ, cv_mem->cv_znQ);
+                                   ck_mem->ck_zn, cv_mem->cv_zn);
       if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
 
       if (cv_mem->cv_q < qmax)
       {
-        N_VScale(ONE, ck_mem->ck_znQ[qmax], cv_mem->cv_znQ[qmax]);
+        N_VScale(ONE, ck_mem->ck_zn[qmax], cv_mem->cv_zn[qmax]);
       }
-    }
 
-    if (ck_mem->ck_sensi)
-    {
-      for (j = 0; j <= cv_mem->cv_q; j++)
+      if (ck_mem->ck_quadr)
       {
-        for (is = 0; is < cv_mem->cv_Ns; is++)
+        for (j = 0; j <= cv_mem->cv_q; j++) { cv_mem->cv_cvals[j] = ONE; }
+
+        retval = N_VScaleVectorArray(cv_mem->cv_q + 1, cv_mem->cv_cvals,
+                                     ck_mem->ck_znQ, cv_mem->cv_znQ);
+        if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
+
+        if (cv_mem->cv_q < qmax)
         {
-          cv_mem->cv_cvals[j * cv_mem->cv_Ns + is] = ONE;
-          cv_mem->cv_Xvecs[j * cv_mem->cv_Ns + is] = ck_mem->ck_znS[j][is];
-          cv_mem->cv_Zvecs[j * cv_mem->cv_Ns + is] = cv_mem->cv_znS[j][is];
+          N_VScale(ONE, ck_mem->ck_znQ[qmax], cv_mem->cv_znQ[qmax]);
         }
       }
 
-      retval = N_VScaleVectorArray(cv_mem->cv_Ns * (cv_mem->cv_q + 1),
-                                   cv_mem->cv_cvals, cv_mem->cv_Xvecs,
-                                   cv_mem->cv_Zvecs);
-      if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
-
-      if (cv_mem->cv_q < qmax)
+      if (ck_mem->ck_sensi)
       {
-        for (is = 0; is < cv_mem->cv_Ns; is++) { cv_mem->cv_cvals[is] = ONE; }
+        for (j = 0; j <= cv_mem->cv_q; j++)
+        {
+          for (is = 0; is < cv_mem->cv_Ns; is++)
+          {
+            cv_mem->cv_cvals[j * cv_mem->cv_Ns + is] = ONE;
+            cv_mem->cv_Xvecs[j * cv_mem->cv_Ns + is] = ck_mem->ck_znS[j][is];
+            cv_mem->cv_Zvecs[j * cv_mem->cv_Ns + is] = cv_mem->cv_znS[j][is];
+          }
+        }
 
-        retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
-                                     ck_mem->ck_znS[qmax], cv_mem->cv_znS[qmax]);
+        retval = N_VScaleVectorArray(cv_mem->cv_Ns * (cv_mem->cv_q + 1),
+                                     cv_mem->cv_cvals, cv_mem->cv_Xvecs,
+                                     cv_mem->cv_Zvecs);
         if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
-      }
-    }
 
-    if (ck_mem->ck_quadr_sensi)
-    {
-      for (j = 0; j <= cv_mem->cv_q; j++)
-      {
-        for (is = 0; is < cv_mem->cv_Ns; is++)
+        if (cv_mem->cv_q < qmax)
         {
-          cv_mem->cv_cvals[j * cv_mem->cv_Ns + is] = ONE;
-          cv_mem->cv_Xvecs[j * cv_mem->cv_Ns + is] = ck_mem->ck_znQS[j][is];
-          cv_mem->cv_Zvecs[j * cv_mem->cv_Ns + is] = cv_mem->cv_znQS[j][is];
+          for (is = 0; is < cv_mem->cv_Ns; is++) { cv_mem->cv_cvals[is] = ONE; }
+
+          retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
+                                       ck_mem->ck_znS[qmax],
+                                       cv_mem->cv_znS[qmax]);
+          if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
         }
       }
 
-      retval = N_VScaleVectorArray(cv_mem->cv_Ns * (cv_mem->cv_q + 1),
-                                   cv_mem->cv_cvals, cv_mem->cv_Xvecs,
-                                   cv_mem->cv_Zvecs);
-      if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
-
-      if (cv_mem->cv_q < qmax)
+      if (ck_mem->ck_quadr_sensi)
       {
-        for (is = 0; is < cv_mem->cv_Ns; is++) { cv_mem->cv_cvals[is] = ONE; }
+        for (j = 0; j <= cv_mem->cv_q; j++)
+        {
+          for (is = 0; is < cv_mem->cv_Ns; is++)
+          {
+            cv_mem->cv_cvals[j * cv_mem->cv_Ns + is] = ONE;
+            cv_mem->cv_Xvecs[j * cv_mem->cv_Ns + is] = ck_mem->ck_znQS[j][is];
+            cv_mem->cv_Zvecs[j * cv_mem->cv_Ns + is] = cv_mem->cv_znQS[j][is];
+          }
+        }
 
-        retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
-                                     ck_mem->ck_znQS[qmax],
-                                     cv_mem->cv_znQS[qmax]);
+        retval = N_VScaleVectorArray(cv_mem->cv_Ns * (cv_mem->cv_q + 1),
+                                     cv_mem->cv_cvals, cv_mem->cv_Xvecs,
+                                     cv_mem->cv_Zvecs);
         if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
+
+        if (cv_mem->cv_q < qmax)
+        {
+          for (is = 0; is < cv_mem->cv_Ns; is++) { cv_mem->cv_cvals[is] = ONE; }
+
+          retval = N_VScaleVectorArray(cv_mem->cv_Ns, cv_mem->cv_cvals,
+                                       ck_mem->ck_znQS[qmax],
+                                       cv_mem->cv_znQS[qmax]);
+          if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
+        }
       }
     }
 
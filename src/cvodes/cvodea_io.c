@@ -78,6 +78,102 @@ int CVodeSetAdjNoSensi(void* cvode_mem)
   return (CV_SUCCESS);
 }
 
+int CVodeSetAdjMaxCheckPoints(void* cvode_mem, int maxckpnts)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_ADJ, __LINE__, __func__, __FILE__, MSGCV_NO_ADJ);
+    return (CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  if ((maxckpnts < 0) || (maxckpnts == 1) || (maxckpnts == 2))
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_BAD_MAXCKPNTS);
+    return (CV_ILL_INPUT);
+  }
+
+  ca_mem->ca_maxckpnts = maxckpnts;
+  ca_mem->ca_ckpntMem  = 0;
+
+  return (CV_SUCCESS);
+}
+
+int CVodeSetAdjCheckPointMemory(void* cvode_mem, size_t ckpntmem)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_ADJ, __LINE__, __func__, __FILE__, MSGCV_NO_ADJ);
+    return (CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  /* The number of check points is computed in CVodeF */
+  ca_mem->ca_maxckpnts = 0;
+  ca_mem->ca_ckpntMem  = ckpntmem;
+
+  return (CV_SUCCESS);
+}
+
+int CVodeSetAdjCheckPointStore(void* cvode_mem, SUNCheckpointStore store)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_ADJ, __LINE__, __func__, __FILE__, MSGCV_NO_ADJ);
+    return (CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  /* Stored check points must stay readable until they are deleted */
+  if (!ca_mem->ca_firstCVodeFcall)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_LATE_CKSTORE);
+    return (CV_ILL_INPUT);
+  }
+
+  ca_mem->ca_ckstore = store;
+
+  return (CV_SUCCESS);
+}
+
 /*
  * -----------------------------------------------------------------
  * Optional input functions for backward integration
@@ -661,6 +757,72 @@ int CVodeGetAdjCheckPointsInfo(void* cvode_mem, CVadjCheckPointRec* ckpnt)
   return (CV_SUCCESS);
 }
 
+/*
+ * CVodeGetAdjNumCheckPoints
+ *
+ * Returns the number of check points currently stored (not counting
+ * the one at the initial time).
+ */
+
+int CVodeGetAdjNumCheckPoints(void* cvode_mem, int* nckpnts)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_ADJ, __LINE__, __func__, __FILE__, MSGCV_NO_ADJ);
+    return (CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  *nckpnts = ca_mem->ca_nckpnts;
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVodeGetAdjNumRecompSteps
+ *
+ * Returns the number of forward steps recomputed by CVodeB to place
+ * check points removed by a limit on the number of check points.
+ */
+
+int CVodeGetAdjNumRecompSteps(void* cvode_mem, long int* nrecomp)
+{
+  CVodeMem cv_mem;
+  CVadjMem ca_mem;
+
+  /* Check if cvode_mem exists */
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Was ASA initialized? */
+  if (cv_mem->cv_adjMallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_ADJ, __LINE__, __func__, __FILE__, MSGCV_NO_ADJ);
+    return (CV_NO_ADJ);
+  }
+  ca_mem = cv_mem->cv_adj_mem;
+
+  *nrecomp = ca_mem->ca_nrecomp;
+
+  return (CV_SUCCESS);
+}
+
 /*
  * -----------------------------------------------------------------
  * Undocumented Development User-Callable Functions
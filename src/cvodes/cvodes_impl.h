@@ -741,6 +741,7 @@ struct CVckpntMemRec
 
   /* Step data */
   long int ck_nst;
+  long int ck_nst1; /* step number at ck_t1 */
   sunrealtype ck_tretlast;
   int ck_q;
   int ck_qprime;
@@ -759,6 +760,11 @@ struct CVckpntMemRec
   /* Saved values */
   sunrealtype ck_saved_tq5;
 
+  /* Are the history arrays in the check point store (under ck_key)
+     rather than in the vectors above? */
+  sunbooleantype ck_stored;
+  long int ck_key;
+
   /* Pointer to next structure in list */
   struct CVckpntMemRec* ck_next;
 };
@@ -936,6 +942,21 @@ struct CVadjMemRec
   /* address of the check point structure for which data is available */
   struct CVckpntMemRec* ca_ckpntData;
 
+  /* Limit on the number of check points (0 for no limit) and the memory
+     budget from which it is computed in CVodeF (0 if not used) */
+  int ca_maxckpnts;
+  size_t ca_ckpntMem;
+
+  /* Number of forward steps recomputed to place check points in CVodeB */
+  long int ca_nrecomp;
+
+  /* Check point store (NULL to keep check points in vectors), key of the
+     next stored check point, and buffer for packing the history arrays */
+  SUNCheckpointStore ca_ckstore;
+  long int ca_ckkey;
+  char* ca_ckbuf;
+  size_t ca_ckbuflen;
+
   /* ------------------
    * Interpolation data
    * ------------------ */
@@ -1450,6 +1471,14 @@ int cvSensRhs1InternalDQ(int Ns, sunrealtype t, N_Vector y, N_Vector ydot,
 #define MSGCV_BAD_TINTERP "Bad t = %g for interpolation."
 #define MSGCV_WRONG_INTERP \
   "This function cannot be called for the specified interp type."
+#define MSGCV_BAD_MAXCKPNTS "maxckpnts must be zero or at least three."
+#define MSGCV_BAD_CKSTORE                                              \
+  "The N_Vector does not implement the buffer operations needed by a " \
+  "check point store."
+#define MSGCV_LATE_CKSTORE \
+  "The check point store must be set before the first call to CVodeF."
+#define MSGCV_BAD_CKPNTMEM \
+  "The check point memory budget is smaller than three check points."
 
 #ifdef __cplusplus
 }
@@ -670,6 +670,79 @@ int CVodeSetLinSysFn(void* cvode_mem, CVLsLinSysFn linsys)
   return (CVLS_SUCCESS);
 }
 
+/* CVodeSetJacSparsityPattern specifies the nonzero pattern used by the
+   internal sparse difference quotient Jacobian. A NULL pattern clears any
+   stored pattern so that it is probed on the next Jacobian evaluation. */
+int CVodeSetJacSparsityPattern(void* cvode_mem, SUNMatrix Jpattern)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  SUNMatrix Jpat;
+  int retval;
+
+  /* access CVLsMem structure */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  /* a pattern can only be used with a sparse linear system matrix */
+  if ((cvls_mem->A == NULL) || (SUNMatGetID(cvls_mem->A) != SUNMATRIX_SPARSE))
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   "A sparsity pattern requires a sparse SUNMatrix");
+    return (CVLS_ILL_INPUT);
+  }
+
+  /* copy the pattern in the storage format of A */
+  Jpat = NULL;
+  if (Jpattern != NULL)
+  {
+    if ((SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+        (SUNSparseMatrix_Rows(Jpattern) != SUNSparseMatrix_Rows(cvls_mem->A)) ||
+        (SUNSparseMatrix_Columns(Jpattern) !=
+         SUNSparseMatrix_Columns(cvls_mem->A)))
+    {
+      cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                     "The sparsity pattern is incompatible with the SUNMatrix");
+      return (CVLS_ILL_INPUT);
+    }
+
+    if (SUNSparseMatrix_SparseType(Jpattern) ==
+        SUNSparseMatrix_SparseType(cvls_mem->A))
+    {
+      Jpat = SUNMatClone(Jpattern);
+      if (Jpat != NULL && SUNMatCopy(Jpattern, Jpat))
+      {
+        SUNMatDestroy(Jpat);
+        Jpat = NULL;
+      }
+    }
+    else if (SUNSparseMatrix_SparseType(cvls_mem->A) == CSC_MAT)
+    {
+      if (SUNSparseMatrix_ToCSC(Jpattern, &Jpat)) { Jpat = NULL; }
+    }
+    else if (SUNSparseMatrix_ToCSR(Jpattern, &Jpat)) { Jpat = NULL; }
+
+    if (Jpat == NULL)
+    {
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                     MSG_LS_MEM_FAIL);
+      return (CVLS_MEM_FAIL);
+    }
+  }
+
+  /* replace the stored pattern and invalidate the column coloring */
+  if (cvls_mem->Jpat) { SUNMatDestroy(cvls_mem->Jpat); }
+  cvls_mem->Jpat = Jpat;
+  if (cvls_mem->colors)
+  {
+    free(cvls_mem->colors);
+    cvls_mem->colors = NULL;
+  }
+  cvls_mem->ncolors = 0;
+
+  return (CVLS_SUCCESS);
+}
+
 /*===============================================================
   Optional Get routines
   ===============================================================*/
@@ -1050,13 +1123,12 @@ int cvLsPSolve(void* cvode_mem, N_Vector r, N_Vector z, sunrealtype tol, int lr)
 /*-----------------------------------------------------------------
   cvLsDQJac
 
-  This routine is a wrapper for the Dense and Band
+  This routine is a wrapper for the Dense, Band and Sparse
   implementations of the difference quotient Jacobian
   approximation routines.
   ---------------------------------------------------------------*/
 int cvLsDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
-              void* cvode_mem, N_Vector tmp1, N_Vector tmp2,
-              SUNDIALS_MAYBE_UNUSED N_Vector tmp3)
+              void* cvode_mem, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
 {
   CVodeMem cv_mem;
   int retval;
@@ -1101,6 +1173,10 @@ int cvLsDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   {
     retval = cvLsBandDQJac(t, y, fy, Jac, cv_mem, tmp1, tmp2);
   }
+  else if (SUNMatGetID(Jac) == SUNMATRIX_SPARSE)
+  {
+    retval = cvLsSparseDQJac(t, y, fy, Jac, cv_mem, tmp1, tmp2, tmp3);
+  }
   else
   {
     cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
@@ -1330,6 +1406,348 @@ int cvLsBandDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   return (retval);
 }
 
+/*-----------------------------------------------------------------
+  cvLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of f(t,y) with the column grouping of Curtis,
+  Powell and Reid. Columns that do not share a nonzero row are
+  given the same color by SUNSparseMatrix_ColorColumns and are
+  perturbed together, so each f evaluation fills every column of
+  one color. The nonzero pattern is either supplied through
+  CVodeSetJacSparsityPattern or probed on the first call (see
+  cvLsSparseDQPattern), and the coloring is computed once and
+  reused until the pattern changes. The difference quotients are
+  formed by cvLsColoredDQJac.
+  -----------------------------------------------------------------*/
+int cvLsSparseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                    CVodeMem cv_mem, N_Vector tmp1, N_Vector tmp2,
+                    N_Vector tmp3)
+{
+  sunindextype N;
+  CVLsMem cvls_mem;
+  int retval = 0;
+
+  /* access LsMem interface structure */
+  cvls_mem = (CVLsMem)cv_mem->cv_lmem;
+
+  /* access matrix dimension */
+  N = SUNSparseMatrix_Columns(Jac);
+
+  /* Probe the nonzero pattern if one was not supplied */
+  if (cvls_mem->Jpat == NULL)
+  {
+    retval = cvLsSparseDQPattern(t, y, fy, Jac, cv_mem, tmp1, tmp2);
+    if (retval != 0) { return (retval); }
+  }
+
+  /* Color the columns of the pattern */
+  if (cvls_mem->colors == NULL)
+  {
+    cvls_mem->colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+    if (cvls_mem->colors == NULL)
+    {
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                     MSG_LS_MEM_FAIL);
+      return (CVLS_MEM_FAIL);
+    }
+    if (SUNSparseMatrix_ColorColumns(cvls_mem->Jpat, cvls_mem->colors,
+                                     &cvls_mem->ncolors))
+    {
+      free(cvls_mem->colors);
+      cvls_mem->colors = NULL;
+      cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                     MSG_LS_SUNMAT_FAILED);
+      return (CVLS_SUNMAT_FAIL);
+    }
+  }
+
+  /* Load the pattern into Jac, every stored entry is overwritten */
+  if (SUNMatCopy(cvls_mem->Jpat, Jac))
+  {
+    cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                   MSG_LS_SUNMAT_FAILED);
+    return (CVLS_SUNMAT_FAIL);
+  }
+
+  return (cvLsColoredDQJac(t, y, fy, Jac, cvls_mem->colors, cvls_mem->ncolors,
+                           cv_mem, tmp1, tmp2, tmp3, &cvls_mem->nfeDQ));
+}
+
+/*-----------------------------------------------------------------
+  cvLsColoredDQJac
+
+  This routine overwrites the entries of the sparse matrix Jac,
+  which holds the Jacobian pattern, with difference quotients of
+  f(t,y). The columns given the same color are perturbed together
+  and the f evaluations are counted in nfe. The work vectors hold
+  the perturbed f (ftemp), the perturbed y (ytemp), and the column
+  increments (incs).
+  -----------------------------------------------------------------*/
+int cvLsColoredDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                     const sunindextype* colors, sunindextype ncolors,
+                     CVodeMem cv_mem, N_Vector ftemp, N_Vector ytemp,
+                     N_Vector incs, long int* nfe)
+{
+  sunrealtype fnorm, minInc, inc, srur, conj;
+  sunrealtype *ewt_data, *fy_data, *ftemp_data, *y_data, *ytemp_data;
+  sunrealtype *inc_data, *cns_data, *J_data;
+  sunindextype *J_ptrs, *J_vals;
+  sunindextype c, i, j, k, N;
+  int retval = 0;
+
+  /* initialize cns_data to avoid compiler warning */
+  cns_data = NULL;
+
+  N      = SUNSparseMatrix_Columns(Jac);
+  J_data = SUNSparseMatrix_Data(Jac);
+  J_ptrs = SUNSparseMatrix_IndexPointers(Jac);
+  J_vals = SUNSparseMatrix_IndexValues(Jac);
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp, increments */
+  ewt_data   = N_VGetArrayPointer(cv_mem->cv_ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  inc_data   = N_VGetArrayPointer(incs);
+  if (cv_mem->cv_constraintsSet)
+  {
+    cns_data = N_VGetArrayPointer(cv_mem->cv_constraints);
+  }
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur   = SUNRsqrt(cv_mem->cv_uround);
+  fnorm  = N_VWrmsNorm(fy, cv_mem->cv_ewt);
+  minInc = (fnorm != ZERO) ? (MIN_INC_MULT * SUNRabs(cv_mem->cv_h) *
+                              cv_mem->cv_uround * N * fnorm)
+                           : ONE;
+
+  /* Compute the increment for each column */
+  for (j = 0; j < N; j++)
+  {
+    inc = SUNMAX(srur * SUNRabs(y_data[j]), minInc / ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (cv_mem->cv_constraintsSet)
+    {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)
+      {
+        if ((y_data[j] + inc) * conj < ZERO) { inc = -inc; }
+      }
+      else if (SUNRabs(conj) == TWO)
+      {
+        if ((y_data[j] + inc) * conj <= ZERO) { inc = -inc; }
+      }
+    }
+
+    inc_data[j] = inc;
+  }
+
+  /* Loop over column colors. */
+  for (c = 0; c < ncolors; c++)
+  {
+    /* Increment all y_j with color c */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] == c) { ytemp_data[j] += inc_data[j]; }
+    }
+
+    /* Evaluate f with incremented y */
+    retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
+    (*nfe)++;
+    if (retval != 0) { break; }
+
+    /* Restore ytemp, then form and load difference quotients */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] == c) { ytemp_data[j] = y_data[j]; }
+    }
+
+    if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT)
+    {
+      for (j = 0; j < N; j++)
+      {
+        if (colors[j] != c) { continue; }
+        for (k = J_ptrs[j]; k < J_ptrs[j + 1]; k++)
+        {
+          i         = J_vals[k];
+          J_data[k] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+        }
+      }
+    }
+    else
+    {
+      for (i = 0; i < N; i++)
+      {
+        for (k = J_ptrs[i]; k < J_ptrs[i + 1]; k++)
+        {
+          j = J_vals[k];
+          if (colors[j] == c)
+          {
+            J_data[k] = (ftemp_data[i] - fy_data[i]) / inc_data[j];
+          }
+        }
+      }
+    }
+  }
+
+  return (retval);
+}
+
+/*-----------------------------------------------------------------
+  cvLsSparseDQPattern
+
+  This routine determines the nonzero pattern of the Jacobian of
+  f(t,y) when none was supplied, by perturbing one column at a
+  time and recording the rows of f that change (N evaluations of
+  f, counted in nfeDQ). The diagonal is always included. Entries
+  that happen to vanish at the probed state are missed, so the
+  pattern should be supplied with CVodeSetJacSparsityPattern when
+  this is a concern. The pattern is stored in the format of Jac.
+  -----------------------------------------------------------------*/
+int cvLsSparseDQPattern(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                        CVodeMem cv_mem, N_Vector tmp1, N_Vector tmp2)
+{
+  N_Vector ftemp, ytemp;
+  SUNMatrix Jcsc, Jcsr;
+  sunrealtype fnorm, minInc, inc, srur, conj;
+  sunrealtype *ewt_data, *fy_data, *ftemp_data, *y_data, *ytemp_data;
+  sunrealtype *cns_data, *P_data;
+  sunindextype *colptrs, *rowvals;
+  sunindextype i, j, N, nnz, nz;
+  CVLsMem cvls_mem;
+  int retval = 0;
+
+  /* initialize cns_data to avoid compiler warning */
+  cns_data = NULL;
+
+  /* access LsMem interface structure */
+  cvls_mem = (CVLsMem)cv_mem->cv_lmem;
+
+  /* access matrix dimension and create the pattern in CSC format */
+  N    = SUNSparseMatrix_Columns(Jac);
+  nnz  = SUNMAX(SUNSparseMatrix_NNZ(Jac), N);
+  Jcsc = SUNSparseMatrix(N, N, nnz, CSC_MAT, cv_mem->cv_sunctx);
+  if (Jcsc == NULL)
+  {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSG_LS_MEM_FAIL);
+    return (CVLS_MEM_FAIL);
+  }
+  colptrs = SUNSparseMatrix_IndexPointers(Jcsc);
+  rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+  P_data  = SUNSparseMatrix_Data(Jcsc);
+
+  /* Rename work vectors for use as temporary values of y and f */
+  ftemp = tmp1;
+  ytemp = tmp2;
+
+  /* Obtain pointers to the data for ewt, fy, ftemp, y, ytemp */
+  ewt_data   = N_VGetArrayPointer(cv_mem->cv_ewt);
+  fy_data    = N_VGetArrayPointer(fy);
+  ftemp_data = N_VGetArrayPointer(ftemp);
+  y_data     = N_VGetArrayPointer(y);
+  ytemp_data = N_VGetArrayPointer(ytemp);
+  if (cv_mem->cv_constraintsSet)
+  {
+    cns_data = N_VGetArrayPointer(cv_mem->cv_constraints);
+  }
+
+  /* Load ytemp with y = predicted y vector */
+  N_VScale(ONE, y, ytemp);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur   = SUNRsqrt(cv_mem->cv_uround);
+  fnorm  = N_VWrmsNorm(fy, cv_mem->cv_ewt);
+  minInc = (fnorm != ZERO) ? (MIN_INC_MULT * SUNRabs(cv_mem->cv_h) *
+                              cv_mem->cv_uround * N * fnorm)
+                           : ONE;
+
+  nz = 0;
+  for (j = 0; j < N; j++)
+  {
+    inc = SUNMAX(srur * SUNRabs(y_data[j]), minInc / ewt_data[j]);
+
+    /* Adjust sign(inc) if yj has an inequality constraint. */
+    if (cv_mem->cv_constraintsSet)
+    {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)
+      {
+        if ((y_data[j] + inc) * conj < ZERO) { inc = -inc; }
+      }
+      else if (SUNRabs(conj) == TWO)
+      {
+        if ((y_data[j] + inc) * conj <= ZERO) { inc = -inc; }
+      }
+    }
+
+    /* Evaluate f with incremented y_j */
+    ytemp_data[j] += inc;
+    retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
+    cvls_mem->nfeDQ++;
+    if (retval != 0) { break; }
+    ytemp_data[j] = y_data[j];
+
+    /* Record the rows of f that depend on y_j */
+    colptrs[j] = nz;
+    for (i = 0; i < N; i++)
+    {
+      if ((i != j) && (ftemp_data[i] == fy_data[i])) { continue; }
+      if (nz == nnz)
+      {
+        nnz *= 2;
+        if (SUNSparseMatrix_Reallocate(Jcsc, nnz))
+        {
+          retval = CVLS_MEM_FAIL;
+          break;
+        }
+        rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+        P_data  = SUNSparseMatrix_Data(Jcsc);
+      }
+      rowvals[nz] = i;
+      P_data[nz]  = ONE;
+      nz++;
+    }
+    if (retval != 0) { break; }
+  }
+  colptrs[N] = nz;
+
+  if (retval == CVLS_MEM_FAIL)
+  {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSG_LS_MEM_FAIL);
+  }
+  if (retval != 0)
+  {
+    SUNMatDestroy(Jcsc);
+    return (retval);
+  }
+
+  /* Store the pattern in the format of Jac */
+  if (SUNSparseMatrix_SparseType(Jac) == CSR_MAT)
+  {
+    Jcsr   = NULL;
+    retval = SUNSparseMatrix_ToCSR(Jcsc, &Jcsr);
+    SUNMatDestroy(Jcsc);
+    if (retval != 0 || Jcsr == NULL)
+    {
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                     MSG_LS_MEM_FAIL);
+      return (CVLS_MEM_FAIL);
+    }
+    cvls_mem->Jpat = Jcsr;
+  }
+  else { cvls_mem->Jpat = Jcsc; }
+
+  return (0);
+}
+
 /*-----------------------------------------------------------------
   cvLsDQJtimes
 
@@ -1508,13 +1926,14 @@ int cvLsInitialize(CVodeMem cv_mem)
       /* Check if an internal or user-supplied Jacobian function is used */
       if (cvls_mem->jacDQ)
       {
-        /* Internal difference quotient Jacobian. Check that A is dense or band,
-           otherwise return an error */
+        /* Internal difference quotient Jacobian. Check that A is dense, band
+           or sparse, otherwise return an error */
         retval = 0;
         if (cvls_mem->A->ops->getid)
         {
           if ((SUNMatGetID(cvls_mem->A) == SUNMATRIX_DENSE) ||
-              (SUNMatGetID(cvls_mem->A) == SUNMATRIX_BAND))
+              (SUNMatGetID(cvls_mem->A) == SUNMATRIX_BAND) ||
+              (SUNMatGetID(cvls_mem->A) == SUNMATRIX_SPARSE))
           {
             cvls_mem->jac    = cvLsDQJac;
             cvls_mem->J_data = cv_mem;
@@ -1722,9 +2141,10 @@ int cvLsSolve(CVodeMem cv_mem, N_Vector b, N_Vector weight, N_Vector ynow,
 {
   CVLsMem cvls_mem;
   sunrealtype bnorm = ZERO;
-  sunrealtype deltar, delta, w_mean;
+  sunrealtype deltar, delta, w_mean, eta;
   int curiter, nli_inc, retval;
   sunbooleantype do_sensi_sim, do_sensi_stg, do_sensi_stg1;
+  SUNNonlinearSolver NLS;
 #if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
   sunrealtype resnorm;
   long int nps_inc;
@@ -1744,20 +2164,22 @@ int cvLsSolve(CVodeMem cv_mem, N_Vector b, N_Vector weight, N_Vector ynow,
   do_sensi_stg  = (cv_mem->cv_sensi && (cv_mem->cv_ism == CV_STAGGERED));
   do_sensi_stg1 = (cv_mem->cv_sensi && (cv_mem->cv_ism == CV_STAGGERED1));
 
-  /* get current nonlinear solver iteration */
-  if (do_sensi_sim)
-  {
-    retval = SUNNonlinSolGetCurIter(cv_mem->NLSsim, &curiter);
-  }
-  else if (do_sensi_stg && cv_mem->sens_solve)
-  {
-    retval = SUNNonlinSolGetCurIter(cv_mem->NLSstg, &curiter);
-  }
-  else if (do_sensi_stg1 && cv_mem->sens_solve)
+  /* get the nonlinear solver in use and its current iteration */
+  if (do_sensi_sim) { NLS = cv_mem->NLSsim; }
+  else if (do_sensi_stg && cv_mem->sens_solve) { NLS = cv_mem->NLSstg; }
+  else if (do_sensi_stg1 && cv_mem->sens_solve) { NLS = cv_mem->NLSstg1; }
+  else { NLS = cv_mem->NLS; }
+
+  retval = SUNNonlinSolGetCurIter(NLS, &curiter);
+  if (retval != SUN_SUCCESS)
   {
-    retval = SUNNonlinSolGetCurIter(cv_mem->NLSstg1, &curiter);
+    cvls_mem->last_flag = CVLS_SUNLS_FAIL;
+    return (cvls_mem->last_flag);
   }
-  else { retval = SUNNonlinSolGetCurIter(cv_mem->NLS, &curiter); }
+
+  /* the tolerance is not relaxed if the forcing term is unavailable */
+  retval = SUNNonlinSolGetForcingTerm(NLS, &eta);
+  if (retval != SUN_SUCCESS) { eta = ZERO; }
 
   /* If the linear solver is iterative:
      test norm(b), if small, return x = 0 or x = b;
@@ -1772,6 +2194,9 @@ int cvLsSolve(CVodeMem cv_mem, N_Vector b, N_Vector weight, N_Vector ynow,
       cvls_mem->last_flag = CVLS_SUCCESS;
       return (cvls_mem->last_flag);
     }
+    /* Relax the tolerance to the nonlinear solver forcing term, if any,
+       limited by the nonlinear solver tolerance */
+    deltar = SUNMAX(deltar, SUNMIN(eta * bnorm, cv_mem->cv_tq[4]));
     /* Adjust tolerance for 2-norm */
     delta = deltar * cvls_mem->nrmfac;
   }
@@ -1956,6 +2381,18 @@ int cvLsFree(CVodeMem cv_mem)
     cvls_mem->savedJ = NULL;
   }
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (cvls_mem->Jpat)
+  {
+    SUNMatDestroy(cvls_mem->Jpat);
+    cvls_mem->Jpat = NULL;
+  }
+  if (cvls_mem->colors)
+  {
+    free(cvls_mem->colors);
+    cvls_mem->colors = NULL;
+  }
+
   /* Nullify other N_Vector pointers */
   cvls_mem->ycur = NULL;
   cvls_mem->fcur = NULL;
@@ -80,6 +80,11 @@ typedef struct CVLsMemRec
   N_Vector ycur;      /* CVODE current y vector in Newton Iteration   */
   N_Vector fcur;      /* fcur = f(tn, ycur)                           */
 
+  /* Sparse difference quotient Jacobian data */
+  SUNMatrix Jpat;       /* nonzero pattern of J (user-supplied or probed) */
+  sunindextype* colors; /* column colors of Jpat                          */
+  sunindextype ncolors; /* number of column colors                        */
+
   /* Statistics and associated parameters */
   long int msbj;     /* max num steps between jac/pset calls         */
   long int nje;      /* nje = no. of calls to jac                    */
@@ -154,6 +159,15 @@ int cvLsDenseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
                    CVodeMem cv_mem, N_Vector tmp1);
 int cvLsBandDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
                   CVodeMem cv_mem, N_Vector tmp1, N_Vector tmp2);
+int cvLsSparseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                    CVodeMem cv_mem, N_Vector tmp1, N_Vector tmp2,
+                    N_Vector tmp3);
+int cvLsColoredDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                     const sunindextype* colors, sunindextype ncolors,
+                     CVodeMem cv_mem, N_Vector ftemp, N_Vector ytemp,
+                     N_Vector incs, long int* nfe);
+int cvLsSparseDQPattern(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
+                        CVodeMem cv_mem, N_Vector tmp1, N_Vector tmp2);
 
 /* Generic linit/lsetup/lsolve/lfree interface routines for CVode to call */
 int cvLsInitialize(CVodeMem cv_mem);
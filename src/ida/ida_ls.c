@@ -536,6 +536,80 @@ int IDASetJacTimesResFn(void* ida_mem, IDAResFn jtimesResFn)
   return (IDALS_SUCCESS);
 }
 
+/* IDASetJacSparsityPattern specifies the nonzero pattern used by the
+   internal sparse difference quotient Jacobian. A NULL pattern clears any
+   stored pattern so that it is probed on the next Jacobian evaluation. */
+int IDASetJacSparsityPattern(void* ida_mem, SUNMatrix Jpattern)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  SUNMatrix Jpat;
+  int retval;
+
+  /* access IDALsMem structure */
+  retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS) { return (retval); }
+
+  /* a pattern can only be used with a sparse linear system matrix */
+  if ((idals_mem->J == NULL) || (SUNMatGetID(idals_mem->J) != SUNMATRIX_SPARSE))
+  {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "A sparsity pattern requires a sparse SUNMatrix");
+    return (IDALS_ILL_INPUT);
+  }
+
+  /* copy the pattern in the storage format of J */
+  Jpat = NULL;
+  if (Jpattern != NULL)
+  {
+    if ((SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+        (SUNSparseMatrix_Rows(Jpattern) !=
+         SUNSparseMatrix_Rows(idals_mem->J)) ||
+        (SUNSparseMatrix_Columns(Jpattern) !=
+         SUNSparseMatrix_Columns(idals_mem->J)))
+    {
+      IDAProcessError(IDA_mem, IDALS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "The sparsity pattern is incompatible with the SUNMatrix");
+      return (IDALS_ILL_INPUT);
+    }
+
+    if (SUNSparseMatrix_SparseType(Jpattern) ==
+        SUNSparseMatrix_SparseType(idals_mem->J))
+    {
+      Jpat = SUNMatClone(Jpattern);
+      if (Jpat != NULL && SUNMatCopy(Jpattern, Jpat))
+      {
+        SUNMatDestroy(Jpat);
+        Jpat = NULL;
+      }
+    }
+    else if (SUNSparseMatrix_SparseType(idals_mem->J) == CSC_MAT)
+    {
+      if (SUNSparseMatrix_ToCSC(Jpattern, &Jpat)) { Jpat = NULL; }
+    }
+    else if (SUNSparseMatrix_ToCSR(Jpattern, &Jpat)) { Jpat = NULL; }
+
+    if (Jpat == NULL)
+    {
+      IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (IDALS_MEM_FAIL);
+    }
+  }
+
+  /* replace the stored pattern and invalidate the column coloring */
+  if (idals_mem->Jpat) { SUNMatDestroy(idals_mem->Jpat); }
+  idals_mem->Jpat = Jpat;
+  if (idals_mem->colors)
+  {
+    free(idals_mem->colors);
+    idals_mem->colors = NULL;
+  }
+  idals_mem->ncolors = 0;
+
+  return (IDALS_SUCCESS);
+}
+
 /*===============================================================
   Optional Get routines
   ===============================================================*/
@@ -882,7 +956,7 @@ int idaLsPSolve(void* ida_mem, N_Vector r, N_Vector z, sunrealtype tol,
 /*---------------------------------------------------------------
   idaLsDQJac:
 
-  This routine is a wrapper for the Dense and Band
+  This routine is a wrapper for the Dense, Band and Sparse
   implementations of the difference quotient Jacobian
   approximation routines.
 ---------------------------------------------------------------*/
@@ -932,6 +1006,10 @@ int idaLsDQJac(sunrealtype t, sunrealtype c_j, N_Vector y, N_Vector yp,
   {
     retval = idaLsBandDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1, tmp2, tmp3);
   }
+  else if (SUNMatGetID(Jac) == SUNMATRIX_SPARSE)
+  {
+    retval = idaLsSparseDQJac(t, c_j, y, yp, r, Jac, IDA_mem, tmp1, tmp2, tmp3);
+  }
   else
   {
     IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
@@ -1188,6 +1266,368 @@ int idaLsBandDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy, N_Vector yp,
   return (retval);
 }
 
+/*---------------------------------------------------------------
+  idaLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian F_y + c_j*F_y' with the column grouping of Curtis,
+  Powell and Reid. Columns that do not share a nonzero row are
+  given the same color by SUNSparseMatrix_ColorColumns and are
+  perturbed together, so each residual evaluation fills every
+  column of one color. The nonzero pattern is either supplied
+  through IDASetJacSparsityPattern or probed on the first call
+  (see idaLsSparseDQPattern), and the coloring is computed once
+  and reused until the pattern changes. The difference quotients
+  are formed by idaLsColoredDQJac.
+---------------------------------------------------------------*/
+int idaLsSparseDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy,
+                     N_Vector yp, N_Vector rr, SUNMatrix Jac, IDAMem IDA_mem,
+                     N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  sunindextype N;
+  IDALsMem idals_mem;
+  int retval = 0;
+
+  /* access LsMem interface structure */
+  idals_mem = (IDALsMem)IDA_mem->ida_lmem;
+
+  /* access matrix dimension */
+  N = SUNSparseMatrix_Columns(Jac);
+
+  /* Probe the nonzero pattern if one was not supplied */
+  if (idals_mem->Jpat == NULL)
+  {
+    retval = idaLsSparseDQPattern(tt, c_j, yy, yp, rr, Jac, IDA_mem, tmp1, tmp2,
+                                  tmp3);
+    if (retval != 0) { return (retval); }
+  }
+
+  /* Color the columns of the pattern */
+  if (idals_mem->colors == NULL)
+  {
+    idals_mem->colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+    if (idals_mem->colors == NULL)
+    {
+      IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (IDALS_MEM_FAIL);
+    }
+    if (SUNSparseMatrix_ColorColumns(idals_mem->Jpat, idals_mem->colors,
+                                     &idals_mem->ncolors))
+    {
+      free(idals_mem->colors);
+      idals_mem->colors = NULL;
+      IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_SUNMAT_FAILED);
+      return (IDALS_SUNMAT_FAIL);
+    }
+  }
+
+  /* Load the pattern into Jac, every stored entry is overwritten */
+  if (SUNMatCopy(idals_mem->Jpat, Jac))
+  {
+    IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_SUNMAT_FAILED);
+    return (IDALS_SUNMAT_FAIL);
+  }
+
+  return (idaLsColoredDQJac(tt, c_j, yy, yp, rr, Jac, idals_mem->colors,
+                            idals_mem->ncolors, IDA_mem, tmp1, tmp2, tmp3,
+                            &idals_mem->nreDQ));
+}
+
+/*---------------------------------------------------------------
+  idaLsColoredDQJac
+
+  This routine overwrites the entries of the sparse matrix Jac,
+  which holds the pattern of F_y + c_j*F_y', with difference
+  quotients. The columns given the same color are perturbed
+  together (y_j by inc and y'_j by c_j*inc) and the residual
+  evaluations are counted in nre. It is shared by idaLsSparseDQJac
+  and the sparse preconditioner (ida_sparsepre.c). The increment of
+  column j is recovered as ytemp[j] - yy[j] before ytemp is
+  restored.
+---------------------------------------------------------------*/
+int idaLsColoredDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy,
+                      N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                      const sunindextype* colors, sunindextype ncolors,
+                      IDAMem IDA_mem, N_Vector rtemp, N_Vector ytemp,
+                      N_Vector yptemp, long int* nre)
+{
+  sunrealtype inc, yj, ypj, srur, conj, ewtj;
+  sunrealtype *y_data, *yp_data, *ewt_data, *cns_data = NULL;
+  sunrealtype *ytemp_data, *yptemp_data, *rtemp_data, *r_data, *J_data;
+  sunindextype *J_ptrs, *J_vals;
+  sunindextype c, i, j, k, N;
+  int retval = 0;
+
+  N      = SUNSparseMatrix_Columns(Jac);
+  J_data = SUNSparseMatrix_Data(Jac);
+  J_ptrs = SUNSparseMatrix_IndexPointers(Jac);
+  J_vals = SUNSparseMatrix_IndexValues(Jac);
+
+  /* Obtain pointers to the data for all eight vectors used.  */
+  ewt_data    = N_VGetArrayPointer(IDA_mem->ida_ewt);
+  r_data      = N_VGetArrayPointer(rr);
+  y_data      = N_VGetArrayPointer(yy);
+  yp_data     = N_VGetArrayPointer(yp);
+  rtemp_data  = N_VGetArrayPointer(rtemp);
+  ytemp_data  = N_VGetArrayPointer(ytemp);
+  yptemp_data = N_VGetArrayPointer(yptemp);
+  if (IDA_mem->ida_constraintsSet)
+  {
+    cns_data = N_VGetArrayPointer(IDA_mem->ida_constraints);
+  }
+
+  /* Initialize ytemp and yptemp. */
+  N_VScale(ONE, yy, ytemp);
+  N_VScale(ONE, yp, yptemp);
+
+  /* Compute miscellaneous values for the Jacobian computation. */
+  srur = SUNRsqrt(IDA_mem->ida_uround);
+
+  /* Loop over column colors. */
+  for (c = 0; c < ncolors; c++)
+  {
+    /* Increment all yy[j] and yp[j] for j with color c. */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] != c) { continue; }
+
+      yj   = y_data[j];
+      ypj  = yp_data[j];
+      ewtj = ewt_data[j];
+
+      /* Set increment inc to yj based on sqrt(uround)*abs(yj), with
+        adjustments using ypj and ewtj if this is small, and a further
+        adjustment to give it the same sign as hh*ypj. */
+      inc = SUNMAX(srur * SUNMAX(SUNRabs(yj), SUNRabs(IDA_mem->ida_hh * ypj)),
+                   ONE / ewtj);
+      if (IDA_mem->ida_hh * ypj < ZERO) { inc = -inc; }
+      inc = (yj + inc) - yj;
+
+      /* Adjust sign(inc) again if yj has an inequality constraint. */
+      if (IDA_mem->ida_constraintsSet)
+      {
+        conj = cns_data[j];
+        if (SUNRabs(conj) == ONE)
+        {
+          if ((yj + inc) * conj < ZERO) { inc = -inc; }
+        }
+        else if (SUNRabs(conj) == TWO)
+        {
+          if ((yj + inc) * conj <= ZERO) { inc = -inc; }
+        }
+      }
+
+      /* Increment yj and ypj. */
+      ytemp_data[j] += inc;
+      yptemp_data[j] += c_j * inc;
+    }
+
+    /* Call res routine with incremented arguments. */
+    retval = IDA_mem->ida_res(tt, ytemp, yptemp, rtemp, IDA_mem->ida_user_data);
+    (*nre)++;
+    if (retval != 0) { break; }
+
+    /* Load the difference quotient Jacobian elements for color c */
+    if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT)
+    {
+      for (j = 0; j < N; j++)
+      {
+        if (colors[j] != c) { continue; }
+        inc = ytemp_data[j] - y_data[j];
+        for (k = J_ptrs[j]; k < J_ptrs[j + 1]; k++)
+        {
+          i         = J_vals[k];
+          J_data[k] = (rtemp_data[i] - r_data[i]) / inc;
+        }
+      }
+    }
+    else
+    {
+      for (i = 0; i < N; i++)
+      {
+        for (k = J_ptrs[i]; k < J_ptrs[i + 1]; k++)
+        {
+          j = J_vals[k];
+          if (colors[j] == c)
+          {
+            inc       = ytemp_data[j] - y_data[j];
+            J_data[k] = (rtemp_data[i] - r_data[i]) / inc;
+          }
+        }
+      }
+    }
+
+    /* Reset ytemp and yptemp components that were perturbed. */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] != c) { continue; }
+      ytemp_data[j]  = y_data[j];
+      yptemp_data[j] = yp_data[j];
+    }
+  }
+
+  return (retval);
+}
+
+/*---------------------------------------------------------------
+  idaLsSparseDQPattern
+
+  This routine determines the nonzero pattern of F_y + c_j*F_y'
+  when none was supplied, by perturbing one column at a time and
+  recording the residual components that change (N residual
+  evaluations, counted in nreDQ). The diagonal is always included.
+  Entries that happen to vanish at the probed state are missed, so
+  the pattern should be supplied with IDASetJacSparsityPattern when
+  this is a concern. The pattern is stored in the format of Jac.
+---------------------------------------------------------------*/
+int idaLsSparseDQPattern(sunrealtype tt, sunrealtype c_j, N_Vector yy,
+                         N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                         IDAMem IDA_mem, N_Vector tmp1, N_Vector tmp2,
+                         N_Vector tmp3)
+{
+  sunrealtype inc, yj, ypj, srur, conj, ewtj;
+  sunrealtype *y_data, *yp_data, *ewt_data, *cns_data = NULL;
+  sunrealtype *ytemp_data, *yptemp_data, *rtemp_data, *r_data, *P_data;
+  sunindextype *colptrs, *rowvals;
+  N_Vector rtemp, ytemp, yptemp;
+  SUNMatrix Jcsc, Jcsr;
+  sunindextype i, j, N, nnz, nz;
+  IDALsMem idals_mem;
+  int retval = 0;
+
+  /* access LsMem interface structure */
+  idals_mem = (IDALsMem)IDA_mem->ida_lmem;
+
+  /* access matrix dimension and create the pattern in CSC format */
+  N    = SUNSparseMatrix_Columns(Jac);
+  nnz  = SUNMAX(SUNSparseMatrix_NNZ(Jac), N);
+  Jcsc = SUNSparseMatrix(N, N, nnz, CSC_MAT, IDA_mem->ida_sunctx);
+  if (Jcsc == NULL)
+  {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_MEM_FAIL);
+    return (IDALS_MEM_FAIL);
+  }
+  colptrs = SUNSparseMatrix_IndexPointers(Jcsc);
+  rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+  P_data  = SUNSparseMatrix_Data(Jcsc);
+
+  /* Rename work vectors for use as temporary values of r, y and yp */
+  rtemp  = tmp1;
+  ytemp  = tmp2;
+  yptemp = tmp3;
+
+  /* Obtain pointers to the data for all eight vectors used.  */
+  ewt_data    = N_VGetArrayPointer(IDA_mem->ida_ewt);
+  r_data      = N_VGetArrayPointer(rr);
+  y_data      = N_VGetArrayPointer(yy);
+  yp_data     = N_VGetArrayPointer(yp);
+  rtemp_data  = N_VGetArrayPointer(rtemp);
+  ytemp_data  = N_VGetArrayPointer(ytemp);
+  yptemp_data = N_VGetArrayPointer(yptemp);
+  if (IDA_mem->ida_constraintsSet)
+  {
+    cns_data = N_VGetArrayPointer(IDA_mem->ida_constraints);
+  }
+
+  /* Initialize ytemp and yptemp. */
+  N_VScale(ONE, yy, ytemp);
+  N_VScale(ONE, yp, yptemp);
+
+  /* Compute miscellaneous values for the Jacobian computation. */
+  srur = SUNRsqrt(IDA_mem->ida_uround);
+
+  nz = 0;
+  for (j = 0; j < N; j++)
+  {
+    yj   = y_data[j];
+    ypj  = yp_data[j];
+    ewtj = ewt_data[j];
+
+    /* Set increment inc to yj as in idaLsBandDQJac. */
+    inc = SUNMAX(srur * SUNMAX(SUNRabs(yj), SUNRabs(IDA_mem->ida_hh * ypj)),
+                 ONE / ewtj);
+    if (IDA_mem->ida_hh * ypj < ZERO) { inc = -inc; }
+    inc = (yj + inc) - yj;
+    if (IDA_mem->ida_constraintsSet)
+    {
+      conj = cns_data[j];
+      if (SUNRabs(conj) == ONE)
+      {
+        if ((yj + inc) * conj < ZERO) { inc = -inc; }
+      }
+      else if (SUNRabs(conj) == TWO)
+      {
+        if ((yj + inc) * conj <= ZERO) { inc = -inc; }
+      }
+    }
+
+    /* Call res routine with incremented yj and ypj. */
+    ytemp_data[j] += inc;
+    yptemp_data[j] += c_j * inc;
+    retval = IDA_mem->ida_res(tt, ytemp, yptemp, rtemp, IDA_mem->ida_user_data);
+    idals_mem->nreDQ++;
+    if (retval != 0) { break; }
+    ytemp_data[j]  = yj;
+    yptemp_data[j] = ypj;
+
+    /* Record the residual components that depend on yj */
+    colptrs[j] = nz;
+    for (i = 0; i < N; i++)
+    {
+      if ((i != j) && (rtemp_data[i] == r_data[i])) { continue; }
+      if (nz == nnz)
+      {
+        nnz *= 2;
+        if (SUNSparseMatrix_Reallocate(Jcsc, nnz))
+        {
+          retval = IDALS_MEM_FAIL;
+          break;
+        }
+        rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+        P_data  = SUNSparseMatrix_Data(Jcsc);
+      }
+      rowvals[nz] = i;
+      P_data[nz]  = ONE;
+      nz++;
+    }
+    if (retval != 0) { break; }
+  }
+  colptrs[N] = nz;
+
+  if (retval == IDALS_MEM_FAIL)
+  {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_MEM_FAIL);
+  }
+  if (retval != 0)
+  {
+    SUNMatDestroy(Jcsc);
+    return (retval);
+  }
+
+  /* Store the pattern in the format of Jac */
+  if (SUNSparseMatrix_SparseType(Jac) == CSR_MAT)
+  {
+    Jcsr   = NULL;
+    retval = SUNSparseMatrix_ToCSR(Jcsc, &Jcsr);
+    SUNMatDestroy(Jcsc);
+    if (retval != 0 || Jcsr == NULL)
+    {
+      IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (IDALS_MEM_FAIL);
+    }
+    idals_mem->Jpat = Jcsr;
+  }
+  else { idals_mem->Jpat = Jcsc; }
+
+  return (0);
+}
+
 /*---------------------------------------------------------------
   idaLsDQJtimes
 
@@ -1282,13 +1722,14 @@ int idaLsInitialize(IDAMem IDA_mem)
   else if (idals_mem->jacDQ)
   {
     /* If J is non-NULL, and 'jac' is not user-supplied:
-       - if J is dense or band, ensure that our DQ approx. is used
+       - if J is dense, band or sparse, ensure that our DQ approx. is used
        - otherwise => error */
     retval = 0;
     if (idals_mem->J->ops->getid)
     {
       if ((SUNMatGetID(idals_mem->J) == SUNMATRIX_DENSE) ||
-          (SUNMatGetID(idals_mem->J) == SUNMATRIX_BAND))
+          (SUNMatGetID(idals_mem->J) == SUNMATRIX_BAND) ||
+          (SUNMatGetID(idals_mem->J) == SUNMATRIX_SPARSE))
       {
         idals_mem->jac    = idaLsDQJac;
         idals_mem->J_data = IDA_mem;
@@ -1436,7 +1877,7 @@ int idaLsSolve(IDAMem IDA_mem, N_Vector b, N_Vector weight, N_Vector ycur,
 {
   IDALsMem idals_mem;
   int nli_inc, retval;
-  sunrealtype tol, w_mean;
+  sunrealtype tol, w_mean, eta;
 
   /* access IDALsMem structure */
   if (IDA_mem->ida_lmem == NULL)
@@ -1455,6 +1896,18 @@ int idaLsSolve(IDAMem IDA_mem, N_Vector b, N_Vector weight, N_Vector ycur,
   if (idals_mem->iterative)
   {
     tol = idals_mem->nrmfac * idals_mem->eplifac * IDA_mem->ida_epsNewt;
+
+    /* Relax the tolerance to the nonlinear solver forcing term, if any,
+       limited by the nonlinear solver tolerance */
+    retval = SUNNonlinSolGetForcingTerm(IDA_mem->NLS, &eta);
+    if (retval != SUN_SUCCESS) { eta = ZERO; }
+    if (eta > ZERO)
+    {
+      /* scale ||b|| by 1/cj to express it in units of the correction */
+      eta = SUNMIN(eta * N_VWrmsNorm(b, weight) / IDA_mem->ida_cj,
+                   IDA_mem->ida_epsNewt);
+      tol = SUNMAX(tol, idals_mem->nrmfac * eta);
+    }
   }
   else { tol = ZERO; }
 
@@ -1687,6 +2140,18 @@ int idaLsFree(IDAMem IDA_mem)
   idals_mem->ypcur = NULL;
   idals_mem->rcur  = NULL;
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (idals_mem->Jpat)
+  {
+    SUNMatDestroy(idals_mem->Jpat);
+    idals_mem->Jpat = NULL;
+  }
+  if (idals_mem->colors)
+  {
+    free(idals_mem->colors);
+    idals_mem->colors = NULL;
+  }
+
   /* Nullify SUNMatrix pointer */
   idals_mem->J = NULL;
 
@@ -0,0 +1,411 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the sparse Jacobian-based
+ * preconditioner and solver routines for use with the IDALS linear
+ * solver interface. The preconditioner matrix
+ * P = dF/dy + c_j*dF/dy' is factored and applied by a user-supplied
+ * matrix-based linear solver, typically an incomplete factorization
+ * (SUNLinSol_ILU).
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+
+#include "ida_impl.h"
+#include "ida_ls_impl.h"
+#include "ida_sparsepre_impl.h"
+
+#define ZERO SUN_RCONST(0.0)
+
+/* Prototypes of IDASparsePrecSetup and IDASparsePrecSolve */
+static int IDASparsePrecSetup(sunrealtype tt, N_Vector yy, N_Vector yp,
+                              N_Vector rr, sunrealtype c_j, void* sp_data);
+static int IDASparsePrecSolve(sunrealtype tt, N_Vector yy, N_Vector yp,
+                              N_Vector rr, N_Vector rvec, N_Vector zvec,
+                              sunrealtype c_j, sunrealtype delta,
+                              void* sp_data);
+
+/* Prototype for IDASparsePrecFree */
+static int IDASparsePrecFree(IDAMem IDA_mem);
+static void IDASparsePrecFreeData(IDASparsePrecData pdata);
+
+/*-----------------------------------------------------------------
+  Initialization, Free, and Get Functions
+  NOTE: The difference quotient Jacobian assumes a serial/OpenMP/
+        Pthreads implementation of the NVECTOR package. Therefore,
+        when jac is NULL, IDASparsePrecInit will first test for a
+        compatible N_Vector internal representation by checking
+        that the function N_VGetArrayPointer exists.
+  -----------------------------------------------------------------*/
+int IDASparsePrecInit(void* ida_mem, SUNMatrix Jpattern, SUNLinearSolver LS,
+                      IDALsJacFn jac)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  IDASparsePrecData pdata;
+  sunindextype N;
+  int flag;
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDALS_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSGSP_MEM_NULL);
+    return (IDALS_MEM_NULL);
+  }
+  IDA_mem = (IDAMem)ida_mem;
+
+  /* Test if the LS linear solver interface has been created */
+  if (IDA_mem->ida_lmem == NULL)
+  {
+    IDAProcessError(IDA_mem, IDALS_LMEM_NULL, __LINE__, __func__, __FILE__,
+                    MSGSP_LMEM_NULL);
+    return (IDALS_LMEM_NULL);
+  }
+  idals_mem = (IDALsMem)IDA_mem->ida_lmem;
+
+  /* Test the Jacobian pattern and the preconditioner linear solver */
+  N = N_VGetLength(IDA_mem->ida_tempv1);
+  if ((Jpattern == NULL) || (SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+      (SUNSparseMatrix_Rows(Jpattern) != N) ||
+      (SUNSparseMatrix_Columns(Jpattern) != N))
+  {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGSP_BAD_PATTERN);
+    return (IDALS_ILL_INPUT);
+  }
+  if (LS == NULL)
+  {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGSP_LS_NULL);
+    return (IDALS_ILL_INPUT);
+  }
+
+  /* Test compatibility of NVECTOR package with the DQ Jacobian */
+  if ((jac == NULL) && (IDA_mem->ida_tempv1->ops->nvgetarraypointer == NULL))
+  {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGSP_BAD_NVECTOR);
+    return (IDALS_ILL_INPUT);
+  }
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (IDASparsePrecData)calloc(1, sizeof *pdata);
+  if (pdata == NULL)
+  {
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_MEM_FAIL);
+    return (IDALS_MEM_FAIL);
+  }
+
+  /* Load pointers into pdata block */
+  pdata->ida_mem = IDA_mem;
+  pdata->LS      = LS;
+  pdata->jac     = jac;
+  pdata->nreSP   = 0;
+  pdata->njeSP   = 0;
+
+  /* Allocate a copy of the pattern and the preconditioner matrix */
+  pdata->Jpat = SUNMatClone(Jpattern);
+  pdata->PP   = SUNMatClone(Jpattern);
+  pdata->tmp1 = N_VClone(IDA_mem->ida_tempv1);
+  pdata->tmp2 = N_VClone(IDA_mem->ida_tempv1);
+  pdata->tmp3 = N_VClone(IDA_mem->ida_tempv1);
+  if ((pdata->Jpat == NULL) || (pdata->PP == NULL) || (pdata->tmp1 == NULL) ||
+      (pdata->tmp2 == NULL) || (pdata->tmp3 == NULL))
+  {
+    IDASparsePrecFreeData(pdata);
+    IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_MEM_FAIL);
+    return (IDALS_MEM_FAIL);
+  }
+  if (SUNMatCopy(Jpattern, pdata->Jpat))
+  {
+    IDASparsePrecFreeData(pdata);
+    IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_SUNMAT_FAIL);
+    return (IDALS_SUNMAT_FAIL);
+  }
+
+  /* Color the columns of the pattern for the DQ Jacobian */
+  if (jac == NULL)
+  {
+    pdata->colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+    if (pdata->colors == NULL)
+    {
+      IDASparsePrecFreeData(pdata);
+      IDAProcessError(IDA_mem, IDALS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSGSP_MEM_FAIL);
+      return (IDALS_MEM_FAIL);
+    }
+    if (SUNSparseMatrix_ColorColumns(pdata->Jpat, pdata->colors,
+                                     &pdata->ncolors))
+    {
+      IDASparsePrecFreeData(pdata);
+      IDAProcessError(IDA_mem, IDALS_SUNMAT_FAIL, __LINE__, __func__,
+                      __FILE__, MSGSP_SUNMAT_FAIL);
+      return (IDALS_SUNMAT_FAIL);
+    }
+  }
+
+  /* initialize the preconditioner linear solver object */
+  flag = SUNLinSolInitialize(pdata->LS);
+  if (flag != SUN_SUCCESS)
+  {
+    IDASparsePrecFreeData(pdata);
+    IDAProcessError(IDA_mem, IDALS_SUNLS_FAIL, __LINE__, __func__, __FILE__,
+                    MSGSP_SUNLS_FAIL);
+    return (IDALS_SUNLS_FAIL);
+  }
+
+  /* make sure pdata is free from any previous allocations */
+  if (idals_mem->pfree) { idals_mem->pfree(IDA_mem); }
+
+  /* Point to the new pdata field in the LS memory */
+  idals_mem->pdata = pdata;
+
+  /* Attach the pfree function */
+  idals_mem->pfree = IDASparsePrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = IDASetPreconditioner(ida_mem, IDASparsePrecSetup, IDASparsePrecSolve);
+  return (flag);
+}
+
+/* Access the preconditioner data attached to ida_mem */
+static int idaSparsePrecAccess(void* ida_mem, const char* fname,
+                               IDAMem* IDA_mem, IDASparsePrecData* pdata)
+{
+  IDALsMem idals_mem;
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDALS_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSGSP_MEM_NULL);
+    return (IDALS_MEM_NULL);
+  }
+  *IDA_mem = (IDAMem)ida_mem;
+
+  if ((*IDA_mem)->ida_lmem == NULL)
+  {
+    IDAProcessError(*IDA_mem, IDALS_LMEM_NULL, __LINE__, fname, __FILE__,
+                    MSGSP_LMEM_NULL);
+    return (IDALS_LMEM_NULL);
+  }
+  idals_mem = (IDALsMem)(*IDA_mem)->ida_lmem;
+
+  if ((idals_mem->pdata == NULL) || (idals_mem->pfree != IDASparsePrecFree))
+  {
+    IDAProcessError(*IDA_mem, IDALS_PMEM_NULL, __LINE__, fname, __FILE__,
+                    MSGSP_PMEM_NULL);
+    return (IDALS_PMEM_NULL);
+  }
+  *pdata = (IDASparsePrecData)idals_mem->pdata;
+
+  return (IDALS_SUCCESS);
+}
+
+int IDASparsePrecGetWorkSpace(void* ida_mem, long int* lenrwSP,
+                              long int* leniwSP)
+{
+  IDAMem IDA_mem;
+  IDASparsePrecData pdata;
+  sunindextype lrw1, liw1;
+  long int lrw, liw;
+  int flag;
+
+  flag = idaSparsePrecAccess(ida_mem, __func__, &IDA_mem, &pdata);
+  if (flag != IDALS_SUCCESS) { return (flag); }
+
+  /* sum space requirements for all objects owned by pdata, the
+     preconditioner linear solver is owned by the user */
+  *leniwSP = 4;
+  *lenrwSP = 0;
+  if (pdata->colors) { *leniwSP += N_VGetLength(IDA_mem->ida_tempv1); }
+  if (IDA_mem->ida_tempv1->ops->nvspace)
+  {
+    N_VSpace(IDA_mem->ida_tempv1, &lrw1, &liw1);
+    *leniwSP += 3 * liw1;
+    *lenrwSP += 3 * lrw1;
+  }
+  if (pdata->Jpat->ops->space)
+  {
+    flag = SUNMatSpace(pdata->Jpat, &lrw, &liw);
+    if (flag != 0) { return (-1); }
+    *leniwSP += 2 * liw;
+    *lenrwSP += 2 * lrw;
+  }
+
+  return (IDALS_SUCCESS);
+}
+
+int IDASparsePrecGetNumResEvals(void* ida_mem, long int* nrevalsSP)
+{
+  IDAMem IDA_mem;
+  IDASparsePrecData pdata;
+  int flag;
+
+  flag = idaSparsePrecAccess(ida_mem, __func__, &IDA_mem, &pdata);
+  if (flag != IDALS_SUCCESS) { return (flag); }
+
+  *nrevalsSP = pdata->nreSP;
+
+  return (IDALS_SUCCESS);
+}
+
+int IDASparsePrecGetNumJacEvals(void* ida_mem, long int* njevalsSP)
+{
+  IDAMem IDA_mem;
+  IDASparsePrecData pdata;
+  int flag;
+
+  flag = idaSparsePrecAccess(ida_mem, __func__, &IDA_mem, &pdata);
+  if (flag != IDALS_SUCCESS) { return (flag); }
+
+  *njevalsSP = pdata->njeSP;
+
+  return (IDALS_SUCCESS);
+}
+
+/*-----------------------------------------------------------------
+  IDASparsePrecSetup
+  -----------------------------------------------------------------
+  IDASparsePrecSetup computes P = dF/dy + c_j*dF/dy' with the
+  user's Jacobian function or a colored difference quotient and
+  calls the setup of the preconditioner linear solver (e.g., the
+  incomplete factorization of P). IDA calls the preconditioner
+  setup only when the iteration matrix is out of date, so P is
+  recomputed on every call.
+
+  The value to be returned by the IDASparsePrecSetup function is
+    0  if successful,
+    1  if a recoverable failure occurred, or
+   -1  if an unrecoverable failure occurred.
+  -----------------------------------------------------------------*/
+static int IDASparsePrecSetup(sunrealtype tt, N_Vector yy, N_Vector yp,
+                              N_Vector rr, sunrealtype c_j, void* sp_data)
+{
+  IDASparsePrecData pdata;
+  IDAMem IDA_mem;
+  int retval;
+
+  pdata   = (IDASparsePrecData)sp_data;
+  IDA_mem = (IDAMem)pdata->ida_mem;
+
+  pdata->njeSP++;
+
+  if (pdata->jac)
+  {
+    retval = SUNMatZero(pdata->PP);
+    if (retval)
+    {
+      IDAProcessError(IDA_mem, -1, __LINE__, __func__, __FILE__,
+                      MSGSP_SUNMAT_FAIL);
+      return (-1);
+    }
+
+    retval = pdata->jac(tt, c_j, yy, yp, rr, pdata->PP,
+                        IDA_mem->ida_user_data, pdata->tmp1, pdata->tmp2,
+                        pdata->tmp3);
+    if (retval < 0)
+    {
+      IDAProcessError(IDA_mem, -1, __LINE__, __func__, __FILE__,
+                      MSGSP_JACFUNC_FAILED);
+      return (-1);
+    }
+    if (retval > 0) { return (1); }
+  }
+  else
+  {
+    /* Load the pattern into PP, then form the colored DQ Jacobian */
+    if (SUNMatCopy(pdata->Jpat, pdata->PP))
+    {
+      IDAProcessError(IDA_mem, -1, __LINE__, __func__, __FILE__,
+                      MSGSP_SUNMAT_FAIL);
+      return (-1);
+    }
+    retval = idaLsColoredDQJac(tt, c_j, yy, yp, rr, pdata->PP, pdata->colors,
+                               pdata->ncolors, IDA_mem, pdata->tmp1,
+                               pdata->tmp2, pdata->tmp3, &pdata->nreSP);
+    if (retval < 0)
+    {
+      IDAProcessError(IDA_mem, -1, __LINE__, __func__, __FILE__,
+                      MSGSP_RESFUNC_FAILED);
+      return (-1);
+    }
+    if (retval > 0) { return (1); }
+  }
+
+  /* Factor P and return the (recoverable) error flag */
+  retval = SUNLinSolSetup(pdata->LS, pdata->PP);
+  if (retval < 0)
+  {
+    IDAProcessError(IDA_mem, -1, __LINE__, __func__, __FILE__,
+                    MSGSP_SUNLS_FAIL);
+    return (-1);
+  }
+  return (retval);
+}
+
+/*-----------------------------------------------------------------
+  IDASparsePrecSolve
+  -----------------------------------------------------------------
+  IDASparsePrecSolve solves a linear system P z = r with the
+  preconditioner linear solver, where P is the matrix computed by
+  IDASparsePrecSetup.
+  -----------------------------------------------------------------*/
+static int IDASparsePrecSolve(SUNDIALS_MAYBE_UNUSED sunrealtype tt,
+                              SUNDIALS_MAYBE_UNUSED N_Vector yy,
+                              SUNDIALS_MAYBE_UNUSED N_Vector yp,
+                              SUNDIALS_MAYBE_UNUSED N_Vector rr, N_Vector rvec,
+                              N_Vector zvec,
+                              SUNDIALS_MAYBE_UNUSED sunrealtype c_j,
+                              SUNDIALS_MAYBE_UNUSED sunrealtype delta,
+                              void* sp_data)
+{
+  IDASparsePrecData pdata;
+  int retval;
+
+  pdata = (IDASparsePrecData)sp_data;
+
+  retval = SUNLinSolSolve(pdata->LS, pdata->PP, zvec, rvec, ZERO);
+  return (retval);
+}
+
+static int IDASparsePrecFree(IDAMem IDA_mem)
+{
+  IDALsMem idals_mem;
+
+  if (IDA_mem->ida_lmem == NULL) { return (0); }
+  idals_mem = (IDALsMem)IDA_mem->ida_lmem;
+
+  if (idals_mem->pdata == NULL) { return (0); }
+  IDASparsePrecFreeData((IDASparsePrecData)idals_mem->pdata);
+  idals_mem->pdata = NULL;
+
+  return (0);
+}
+
+/* Free the objects owned by pdata, the linear solver belongs to the user */
+static void IDASparsePrecFreeData(IDASparsePrecData pdata)
+{
+  if (pdata->Jpat) { SUNMatDestroy(pdata->Jpat); }
+  if (pdata->PP) { SUNMatDestroy(pdata->PP); }
+  if (pdata->tmp1) { N_VDestroy(pdata->tmp1); }
+  if (pdata->tmp2) { N_VDestroy(pdata->tmp2); }
+  if (pdata->tmp3) { N_VDestroy(pdata->tmp3); }
+  free(pdata->colors);
+  free(pdata);
+}
@@ -50,7 +50,10 @@ static IDAckpntMem IDAAckpntInit(IDAMem IDA_mem);
 static IDAckpntMem IDAAckpntNew(IDAMem IDA_mem);
 static void IDAAckpntCopyVectors(IDAMem IDA_mem, IDAckpntMem ck_mem);
 static sunbooleantype IDAAckpntAllocVectors(IDAMem IDA_mem, IDAckpntMem ck_mem);
-static void IDAAckpntDelete(IDAckpntMem* ck_memPtr);
+static void IDAAckpntDelete(IDAadjMem IDAADJ_mem, IDAckpntMem* ck_memPtr);
+static int IDAAckpntPack(IDAMem IDA_mem, IDAckpntMem ck_mem,
+                         sunbooleantype pack);
+static sunbooleantype IDAAckpntCanPack(IDAMem IDA_mem);
 
 static void IDAAbckpbDelete(IDABMem* IDAB_memPtr);
 
@@ -148,6 +151,10 @@ int IDAAdjInit(void* ida_mem, long int steps, int interp)
   IDAADJ_mem->ck_mem       = NULL;
   IDAADJ_mem->ia_nckpnts   = 0;
   IDAADJ_mem->ia_ckpntData = NULL;
+  IDAADJ_mem->ia_ckstore   = NULL;
+  IDAADJ_mem->ia_ckkey     = 0;
+  IDAADJ_mem->ia_ckbuf     = NULL;
+  IDAADJ_mem->ia_ckbuflen  = 0;
 
   /* Initialization of interpolation data. */
   IDAADJ_mem->ia_interpType = interp;
@@ -257,7 +264,10 @@ int IDAAdjReInit(void* ida_mem)
   IDAADJ_mem = IDA_mem->ida_adj_mem;
 
   /* Free all stored  checkpoints. */
-  while (IDAADJ_mem->ck_mem != NULL) { IDAAckpntDelete(&(IDAADJ_mem->ck_mem)); }
+  while (IDAADJ_mem->ck_mem != NULL)
+  {
+    IDAAckpntDelete(IDAADJ_mem, &(IDAADJ_mem->ck_mem));
+  }
 
   IDAADJ_mem->ck_mem       = NULL;
   IDAADJ_mem->ia_nckpnts   = 0;
@@ -294,8 +304,9 @@ void IDAAdjFree(void* ida_mem)
     /* Delete check points one by one */
     while (IDAADJ_mem->ck_mem != NULL)
     {
-      IDAAckpntDelete(&(IDAADJ_mem->ck_mem));
+      IDAAckpntDelete(IDAADJ_mem, &(IDAADJ_mem->ck_mem));
     }
+    free(IDAADJ_mem->ia_ckbuf);
 
     IDAAdataFree(IDA_mem);
 
@@ -433,6 +444,15 @@ int IDASolveF(void* ida_mem, sunrealtype tout, sunrealtype* tret, N_Vector yret,
     return (IDA_ILL_INPUT);
   }
 
+  /* Check that the check points can be packed into the store */
+  if (IDAADJ_mem->ia_ckstore != NULL && !IDAAckpntCanPack(IDA_mem))
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGAM_BAD_CKSTORE);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
   /* All memory checks done, proceed ... */
 
   dt_mem = IDAADJ_mem->dt_mem;
@@ -2000,6 +2020,10 @@ static IDAckpntMem IDAAckpntInit(IDAMem IDA_mem)
   /* Alloc 3: current order, i.e. 1,  +   2. */
   ck_mem->ck_phi_alloc = 3;
 
+  /* The initial check point is always kept in memory */
+  ck_mem->ck_stored = SUNFALSE;
+  ck_mem->ck_key    = 0;
+
   if (!IDAAckpntAllocVectors(IDA_mem, ck_mem))
   {
     free(ck_mem);
@@ -2071,6 +2095,25 @@ static IDAckpntMem IDAAckpntNew(IDAMem IDA_mem)
   ck_mem->ck_phi_alloc = (IDA_mem->ida_kk + 2 < MXORDP1) ? IDA_mem->ida_kk + 2
                                                          : MXORDP1;
 
+  ck_mem->ck_stored = SUNFALSE;
+  ck_mem->ck_key    = 0;
+
+  /* With a check point store, pack the arrays into the store instead of
+     copying them to new vectors */
+  if (IDA_mem->ida_adj_mem->ia_ckstore != NULL)
+  {
+    ck_mem->ck_stored = SUNTRUE;
+    ck_mem->ck_key    = IDA_mem->ida_adj_mem->ia_ckkey++;
+
+    if (IDAAckpntPack(IDA_mem, ck_mem, SUNTRUE) != IDA_SUCCESS)
+    {
+      free(ck_mem);
+      ck_mem = NULL;
+    }
+
+    return (ck_mem);
+  }
+
   if (!IDAAckpntAllocVectors(IDA_mem, ck_mem))
   {
     free(ck_mem);
@@ -2089,7 +2132,7 @@ static IDAckpntMem IDAAckpntNew(IDAMem IDA_mem)
  * This routine deletes the first check point in list.
 */
 
-static void IDAAckpntDelete(IDAckpntMem* ck_memPtr)
+static void IDAAckpntDelete(IDAadjMem IDAADJ_mem, IDAckpntMem* ck_memPtr)
 {
   IDAckpntMem tmp;
   int j;
@@ -2101,6 +2144,15 @@ static void IDAAckpntDelete(IDAckpntMem* ck_memPtr)
     /* move head of list */
     *ck_memPtr = (*ck_memPtr)->ck_next;
 
+    /* a stored check point has no vectors, only a record in the store */
+    if (tmp->ck_stored)
+    {
+      (void)SUNCheckpointStore_Remove(IDAADJ_mem->ia_ckstore, tmp->ck_key);
+      free(tmp);
+      tmp = NULL;
+      return;
+    }
+
     /* free N_Vectors in tmp */
     for (j = 0; j < tmp->ck_phi_alloc; j++) { N_VDestroy(tmp->ck_phi[j]); }
 
@@ -2311,6 +2363,159 @@ static void IDAAckpntCopyVectors(IDAMem IDA_mem, IDAckpntMem ck_mem)
   }
 }
 
+/*
+ * IDAAckpntPack
+ *
+ * This routine packs the phi* arrays of IDA_mem into the check point
+ * store under the key of ck_mem (pack = SUNTRUE) or unpacks them from
+ * the store into IDA_mem (pack = SUNFALSE). The record holds phi,
+ * phiQ, phiS, and phiQS for j = 0,...,ck_phi_alloc-1.
+ */
+
+static int IDAAckpntPack(IDAMem IDA_mem, IDAckpntMem ck_mem,
+                         sunbooleantype pack)
+{
+  IDAadjMem IDAADJ_mem;
+  sunindextype ysize, qsize;
+  size_t nvecs, nbytes, offset;
+  char* buf;
+  int j, is;
+  SUNErrCode err;
+
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  /* Size of one state and one quadrature vector */
+  if (N_VBufSize(IDA_mem->ida_phi[0], &ysize) != SUN_SUCCESS)
+  {
+    return (IDA_VECTOROP_ERR);
+  }
+  qsize = 0;
+  if (ck_mem->ck_quadr || ck_mem->ck_quadr_sensi)
+  {
+    if (N_VBufSize(IDA_mem->ida_phiQ[0], &qsize) != SUN_SUCCESS)
+    {
+      return (IDA_VECTOROP_ERR);
+    }
+  }
+
+  /* Size of the record */
+  nvecs  = (size_t)ck_mem->ck_phi_alloc;
+  nbytes = nvecs * (size_t)ysize;
+  if (ck_mem->ck_quadr) { nbytes += nvecs * (size_t)qsize; }
+  if (ck_mem->ck_sensi)
+  {
+    nbytes += nvecs * IDA_mem->ida_Ns * (size_t)ysize;
+  }
+  if (ck_mem->ck_quadr_sensi)
+  {
+    nbytes += nvecs * IDA_mem->ida_Ns * (size_t)qsize;
+  }
+
+  /* Grow the staging buffer if needed */
+  if (nbytes > IDAADJ_mem->ia_ckbuflen)
+  {
+    buf = (char*)realloc(IDAADJ_mem->ia_ckbuf, nbytes);
+    if (buf == NULL) { return (IDA_MEM_FAIL); }
+    IDAADJ_mem->ia_ckbuf    = buf;
+    IDAADJ_mem->ia_ckbuflen = nbytes;
+  }
+  buf = IDAADJ_mem->ia_ckbuf;
+
+  if (!pack)
+  {
+    err = SUNCheckpointStore_Read(IDAADJ_mem->ia_ckstore, ck_mem->ck_key, buf,
+                                  nbytes);
+    if (err != SUN_SUCCESS) { return (IDA_MEM_FAIL); }
+
+    /* The next check point back is the one needed after this one */
+    if (ck_mem->ck_next != NULL && ck_mem->ck_next->ck_stored)
+    {
+      (void)SUNCheckpointStore_Prefetch(IDAADJ_mem->ia_ckstore,
+                                        ck_mem->ck_next->ck_key);
+    }
+  }
+
+  offset = 0;
+  for (j = 0; j < ck_mem->ck_phi_alloc; j++)
+  {
+    if (pack) { err = N_VBufPack(IDA_mem->ida_phi[j], buf + offset); }
+    else { err = N_VBufUnpack(IDA_mem->ida_phi[j], buf + offset); }
+    if (err != SUN_SUCCESS) { return (IDA_VECTOROP_ERR); }
+    offset += ysize;
+
+    if (ck_mem->ck_quadr)
+    {
+      if (pack) { err = N_VBufPack(IDA_mem->ida_phiQ[j], buf + offset); }
+      else { err = N_VBufUnpack(IDA_mem->ida_phiQ[j], buf + offset); }
+      if (err != SUN_SUCCESS) { return (IDA_VECTOROP_ERR); }
+      offset += qsize;
+    }
+
+    if (ck_mem->ck_sensi)
+    {
+      for (is = 0; is < IDA_mem->ida_Ns; is++)
+      {
+        if (pack) { err = N_VBufPack(IDA_mem->ida_phiS[j][is], buf + offset); }
+        else { err = N_VBufUnpack(IDA_mem->ida_phiS[j][is], buf + offset); }
+        if (err != SUN_SUCCESS) { return (IDA_VECTOROP_ERR); }
+        offset += ysize;
+      }
+    }
+
+    if (ck_mem->ck_quadr_sensi)
+    {
+      for (is = 0; is < IDA_mem->ida_Ns; is++)
+      {
+        if (pack) { err = N_VBufPack(IDA_mem->ida_phiQS[j][is], buf + offset); }
+        else { err = N_VBufUnpack(IDA_mem->ida_phiQS[j][is], buf + offset); }
+        if (err != SUN_SUCCESS) { return (IDA_VECTOROP_ERR); }
+        offset += qsize;
+      }
+    }
+  }
+
+  if (pack)
+  {
+    err = SUNCheckpointStore_Write(IDAADJ_mem->ia_ckstore, ck_mem->ck_key, buf,
+                                   nbytes);
+    if (err != SUN_SUCCESS) { return (IDA_MEM_FAIL); }
+  }
+
+  return (IDA_SUCCESS);
+}
+
+/*
+ * IDAAckpntCanPack
+ *
+ * This routine checks that the vectors carried in check points
+ * implement the buffer operations used by IDAAckpntPack.
+ */
+
+static sunbooleantype IDAAckpntCanPack(IDAMem IDA_mem)
+{
+  N_Vector v;
+
+  v = IDA_mem->ida_phi[0];
+  if (v->ops->nvbufsize == NULL || v->ops->nvbufpack == NULL ||
+      v->ops->nvbufunpack == NULL)
+  {
+    return (SUNFALSE);
+  }
+
+  if ((IDA_mem->ida_quadr && IDA_mem->ida_errconQ) ||
+      (IDA_mem->ida_quadr_sensi && IDA_mem->ida_errconQS))
+  {
+    v = IDA_mem->ida_phiQ[0];
+    if (v->ops->nvbufsize == NULL || v->ops->nvbufpack == NULL ||
+        v->ops->nvbufunpack == NULL)
+    {
+      return (SUNFALSE);
+    }
+  }
+
+  return (SUNTRUE);
+}
+
 /*
  * IDAAdataMalloc
  *
@@ -2506,37 +2711,45 @@ static int IDAAckpntGet(IDAMem IDA_mem, IDAckpntMem ck_mem)
     IDA_mem->ida_ssS      = ck_mem->ck_ssS;
 
     /* Copy the arrays from check point data structure */
-    for (j = 0; j < ck_mem->ck_phi_alloc; j++)
+    if (ck_mem->ck_stored)
     {
-      N_VScale(ONE, ck_mem->ck_phi[j], IDA_mem->ida_phi[j]);
+      flag = IDAAckpntPack(IDA_mem, ck_mem, SUNFALSE);
+      if (flag != IDA_SUCCESS) { return (flag); }
     }
-
-    if (ck_mem->ck_quadr)
+    else
     {
       for (j = 0; j < ck_mem->ck_phi_alloc; j++)
       {
-        N_VScale(ONE, ck_mem->ck_phiQ[j], IDA_mem->ida_phiQ[j]);
+        N_VScale(ONE, ck_mem->ck_phi[j], IDA_mem->ida_phi[j]);
       }
-    }
 
-    if (ck_mem->ck_sensi)
-    {
-      for (is = 0; is < IDA_mem->ida_Ns; is++)
+      if (ck_mem->ck_quadr)
       {
         for (j = 0; j < ck_mem->ck_phi_alloc; j++)
         {
-          N_VScale(ONE, ck_mem->ck_phiS[j][is], IDA_mem->ida_phiS[j][is]);
+          N_VScale(ONE, ck_mem->ck_phiQ[j], IDA_mem->ida_phiQ[j]);
         }
       }
-    }
 
-    if (ck_mem->ck_quadr_sensi)
-    {
-      for (is = 0; is < IDA_mem->ida_Ns; is++)
+      if (ck_mem->ck_sensi)
       {
-        for (j = 0; j < ck_mem->ck_phi_alloc; j++)
+        for (is = 0; is < IDA_mem->ida_Ns; is++)
         {
-          N_VScale(ONE, ck_mem->ck_phiQS[j][is], IDA_mem->ida_phiQS[j][is]);
+          for (j = 0; j < ck_mem->ck_phi_alloc; j++)
+          {
+            N_VScale(ONE, ck_mem->ck_phiS[j][is], IDA_mem->ida_phiS[j][is]);
+          }
+        }
+      }
+
+      if (ck_mem->ck_quadr_sensi)
+      {
+        for (is = 0; is < IDA_mem->ida_Ns; is++)
+        {
+          for (j = 0; j < ck_mem->ck_phi_alloc; j++)
+          {
+            N_VScale(ONE, ck_mem->ck_phiQS[j][is], IDA_mem->ida_phiQS[j][is]);
+          }
         }
       }
     }
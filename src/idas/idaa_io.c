@@ -82,6 +82,42 @@ int IDAAdjSetNoSensi(void* ida_mem)
   return (IDA_SUCCESS);
 }
 
+int IDAAdjSetCheckPointStore(void* ida_mem, SUNCheckpointStore store)
+{
+  IDAMem IDA_mem;
+  IDAadjMem IDAADJ_mem;
+
+  /* Is ida_mem valid? */
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDA_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSGAM_NULL_IDAMEM);
+    return IDA_MEM_NULL;
+  }
+  IDA_mem = (IDAMem)ida_mem;
+
+  /* Is ASA initialized? */
+  if (IDA_mem->ida_adjMallocDone == SUNFALSE)
+  {
+    IDAProcessError(IDA_mem, IDA_NO_ADJ, __LINE__, __func__, __FILE__,
+                    MSGAM_NO_ADJ);
+    return (IDA_NO_ADJ);
+  }
+  IDAADJ_mem = IDA_mem->ida_adj_mem;
+
+  /* Stored check points must stay readable until they are deleted */
+  if (!IDAADJ_mem->ia_firstIDAFcall)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSGAM_LATE_CKSTORE);
+    return (IDA_ILL_INPUT);
+  }
+
+  IDAADJ_mem->ia_ckstore = store;
+
+  return (IDA_SUCCESS);
+}
+
 /*
  * -----------------------------------------------------------------
  * Optional input functions for backward integration
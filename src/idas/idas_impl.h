@@ -638,6 +638,11 @@ struct IDAckpntMemRec
   /* How many phi, phiS, phiQ and phiQS were allocated? */
   int ck_phi_alloc;
 
+  /* Are the phi* arrays in the check point store (under ck_key) rather
+     than in the vectors above? */
+  sunbooleantype ck_stored;
+  long int ck_key;
+
   /* Pointer to next structure in list */
   struct IDAckpntMemRec* ck_next;
 };
@@ -801,6 +806,13 @@ struct IDAadjMemRec
   /* Number of checkpoints. */
   int ia_nckpnts;
 
+  /* Optional store for the check point arrays, the next key, and the
+     buffer used to pack and unpack a check point */
+  SUNCheckpointStore ia_ckstore;
+  long int ia_ckkey;
+  char* ia_ckbuf;
+  size_t ia_ckbuflen;
+
   /* ------------------
    * Interpolation data
    * ------------------ */
@@ -1250,6 +1262,11 @@ int IDASensResDQ(int Ns, sunrealtype t, N_Vector yy, N_Vector yp,
   "This function cannot be called for the specified interp type."
 #define MSGAM_MEM_FAIL  "A memory request failed."
 #define MSGAM_NO_INITBS "Illegal attempt to call before calling IDAInitBS."
+#define MSGAM_BAD_CKSTORE                                              \
+  "The N_Vector does not implement the buffer operations needed by a " \
+  "check point store."
+#define MSGAM_LATE_CKSTORE \
+  "The check point store must be set before the first call to IDASolveF."
 
 #ifdef __cplusplus
 }
@@ -54,6 +54,11 @@ typedef struct IDALsMemRec
   N_Vector ypcur;     /* current yp vector in Newton iteration         */
   N_Vector rcur;      /* rcur = F(tn, ycur, ypcur)                     */
 
+  /* Sparse difference quotient Jacobian data */
+  SUNMatrix Jpat;       /* nonzero pattern of J (user-supplied or probed) */
+  sunindextype* colors; /* column colors of Jpat                          */
+  sunindextype ncolors; /* number of column colors                        */
+
   /* Matrix-based solver, scale solution to account for change in cj */
   sunbooleantype scalesol;
 
@@ -131,6 +136,18 @@ int idaLsDenseDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy, N_Vector yp,
 int idaLsBandDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy, N_Vector yp,
                    N_Vector rr, SUNMatrix Jac, IDAMem IDA_mem, N_Vector tmp1,
                    N_Vector tmp2, N_Vector tmp3);
+int idaLsSparseDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy,
+                     N_Vector yp, N_Vector rr, SUNMatrix Jac, IDAMem IDA_mem,
+                     N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+int idaLsColoredDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy,
+                      N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                      const sunindextype* colors, sunindextype ncolors,
+                      IDAMem IDA_mem, N_Vector rtemp, N_Vector ytemp,
+                      N_Vector yptemp, long int* nre);
+int idaLsSparseDQPattern(sunrealtype tt, sunrealtype c_j, N_Vector yy,
+                         N_Vector yp, N_Vector rr, SUNMatrix Jac,
+                         IDAMem IDA_mem, N_Vector tmp1, N_Vector tmp2,
+                         N_Vector tmp3);
 
 /* Generic linit/lsetup/lsolve/lperf/lfree interface routines for IDA to call */
 int idaLsInitialize(IDAMem IDA_mem);
@@ -185,6 +202,8 @@ int idaLs_AccessLMem(void* ida_mem, const char* fname, IDAMem* IDA_mem,
   "The Jacobian routine failed in an unrecoverable manner."
 #define MSG_LS_MATZERO_FAILED \
   "The SUNMatZero routine failed in an unrecoverable manner."
+#define MSG_LS_SUNMAT_FAILED \
+  "A SUNMatrix routine failed in an unrecoverable manner."
 
 /* Warning Messages */
 #define MSG_LS_WARN \
@@ -377,6 +377,83 @@ int KINSetJacTimesVecSysFn(void* kinmem, KINSysFn jtimesSysFn)
   return (KINLS_SUCCESS);
 }
 
+/*------------------------------------------------------------------
+  KINSetJacSparsityPattern specifies the nonzero pattern used by the
+  internal sparse difference quotient Jacobian. A NULL pattern clears
+  any stored pattern so that it is probed on the next Jacobian
+  evaluation.
+  ------------------------------------------------------------------*/
+int KINSetJacSparsityPattern(void* kinmem, SUNMatrix Jpattern)
+{
+  KINMem kin_mem;
+  KINLsMem kinls_mem;
+  SUNMatrix Jpat;
+  int retval;
+
+  /* access KINLsMem structure */
+  retval = kinLs_AccessLMem(kinmem, __func__, &kin_mem, &kinls_mem);
+  if (retval != KIN_SUCCESS) { return (retval); }
+
+  /* a pattern can only be used with a sparse linear system matrix */
+  if ((kinls_mem->J == NULL) || (SUNMatGetID(kinls_mem->J) != SUNMATRIX_SPARSE))
+  {
+    KINProcessError(kin_mem, KINLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "A sparsity pattern requires a sparse SUNMatrix");
+    return (KINLS_ILL_INPUT);
+  }
+
+  /* copy the pattern in the storage format of J */
+  Jpat = NULL;
+  if (Jpattern != NULL)
+  {
+    if ((SUNMatGetID(Jpattern) != SUNMATRIX_SPARSE) ||
+        (SUNSparseMatrix_Rows(Jpattern) !=
+         SUNSparseMatrix_Rows(kinls_mem->J)) ||
+        (SUNSparseMatrix_Columns(Jpattern) !=
+         SUNSparseMatrix_Columns(kinls_mem->J)))
+    {
+      KINProcessError(kin_mem, KINLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "The sparsity pattern is incompatible with the SUNMatrix");
+      return (KINLS_ILL_INPUT);
+    }
+
+    if (SUNSparseMatrix_SparseType(Jpattern) ==
+        SUNSparseMatrix_SparseType(kinls_mem->J))
+    {
+      Jpat = SUNMatClone(Jpattern);
+      if (Jpat != NULL && SUNMatCopy(Jpattern, Jpat))
+      {
+        SUNMatDestroy(Jpat);
+        Jpat = NULL;
+      }
+    }
+    else if (SUNSparseMatrix_SparseType(kinls_mem->J) == CSC_MAT)
+    {
+      if (SUNSparseMatrix_ToCSC(Jpattern, &Jpat)) { Jpat = NULL; }
+    }
+    else if (SUNSparseMatrix_ToCSR(Jpattern, &Jpat)) { Jpat = NULL; }
+
+    if (Jpat == NULL)
+    {
+      KINProcessError(kin_mem, KINLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (KINLS_MEM_FAIL);
+    }
+  }
+
+  /* replace the stored pattern and invalidate the column coloring */
+  if (kinls_mem->Jpat) { SUNMatDestroy(kinls_mem->Jpat); }
+  kinls_mem->Jpat = Jpat;
+  if (kinls_mem->colors)
+  {
+    free(kinls_mem->colors);
+    kinls_mem->colors = NULL;
+  }
+  kinls_mem->ncolors = 0;
+
+  return (KINLS_SUCCESS);
+}
+
 /*==================================================================
   Optional Get routines
   ==================================================================*/
@@ -706,8 +783,9 @@ int kinLsPSolve(void* kinmem, N_Vector r, N_Vector z,
 /*------------------------------------------------------------------
   kinLsDQJac
 
-  This routine is a wrapper for the Dense and Band implementations
-  of the difference quotient Jacobian approximation routines.
+  This routine is a wrapper for the Dense, Band and Sparse
+  implementations of the difference quotient Jacobian approximation
+  routines.
   ------------------------------------------------------------------*/
 int kinLsDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac, void* kinmem,
                N_Vector tmp1, N_Vector tmp2)
@@ -741,6 +819,10 @@ int kinLsDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac, void* kinmem,
   {
     retval = kinLsBandDQJac(u, fu, Jac, kin_mem, tmp1, tmp2);
   }
+  else if (SUNMatGetID(Jac) == SUNMATRIX_SPARSE)
+  {
+    retval = kinLsSparseDQJac(u, fu, Jac, kin_mem, tmp1, tmp2);
+  }
   else
   {
     KINProcessError(kin_mem, KIN_ILL_INPUT, __LINE__, __func__, __FILE__,
@@ -925,6 +1007,269 @@ int kinLsBandDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac, KINMem kin_mem,
   return (0);
 }
 
+/*------------------------------------------------------------------
+  kinLsSparseDQJac
+
+  This routine generates a sparse difference quotient approximation
+  to the Jacobian of F(u) with the column grouping of Curtis, Powell
+  and Reid. Columns that do not share a nonzero row are given the
+  same color by SUNSparseMatrix_ColorColumns and are perturbed
+  together, so each evaluation of F fills every column of one
+  color. The nonzero pattern is either supplied through
+  KINSetJacSparsityPattern or probed on the first call (see
+  kinLsSparseDQPattern), and the coloring is computed once and
+  reused until the pattern changes. The increment of column j is
+  recovered as utemp[j] - u[j] before utemp is restored.
+  ------------------------------------------------------------------*/
+int kinLsSparseDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac, KINMem kin_mem,
+                     N_Vector tmp1, N_Vector tmp2)
+{
+  sunrealtype inc;
+  N_Vector futemp, utemp;
+  sunindextype c, i, j, k, N;
+  sunindextype *J_ptrs, *J_vals, *colors;
+  sunrealtype *fu_data, *futemp_data, *u_data, *utemp_data, *uscale_data;
+  sunrealtype* J_data;
+  KINLsMem kinls_mem;
+  int retval = 0;
+
+  /* access LsMem interface structure */
+  kinls_mem = (KINLsMem)kin_mem->kin_lmem;
+
+  /* access matrix dimension */
+  N = SUNSparseMatrix_Columns(Jac);
+
+  /* Probe the nonzero pattern if one was not supplied */
+  if (kinls_mem->Jpat == NULL)
+  {
+    retval = kinLsSparseDQPattern(u, fu, Jac, kin_mem, tmp1, tmp2);
+    if (retval != 0) { return (retval); }
+  }
+
+  /* Color the columns of the pattern */
+  if (kinls_mem->colors == NULL)
+  {
+    kinls_mem->colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+    if (kinls_mem->colors == NULL)
+    {
+      KINProcessError(kin_mem, KINLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (KINLS_MEM_FAIL);
+    }
+    if (SUNSparseMatrix_ColorColumns(kinls_mem->Jpat, kinls_mem->colors,
+                                     &kinls_mem->ncolors))
+    {
+      free(kinls_mem->colors);
+      kinls_mem->colors = NULL;
+      KINProcessError(kin_mem, KINLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_SUNMAT_FAILED);
+      return (KINLS_SUNMAT_FAIL);
+    }
+  }
+  colors = kinls_mem->colors;
+
+  /* Load the pattern into Jac, every stored entry is overwritten below */
+  if (SUNMatCopy(kinls_mem->Jpat, Jac))
+  {
+    KINProcessError(kin_mem, KINLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_SUNMAT_FAILED);
+    return (KINLS_SUNMAT_FAIL);
+  }
+  J_data = SUNSparseMatrix_Data(Jac);
+  J_ptrs = SUNSparseMatrix_IndexPointers(Jac);
+  J_vals = SUNSparseMatrix_IndexValues(Jac);
+
+  /* Rename work vectors for use as temporary values of u and fu */
+  futemp = tmp1;
+  utemp  = tmp2;
+
+  /* Obtain pointers to the data for fu, futemp, u, uscale, utemp */
+  fu_data     = N_VGetArrayPointer(fu);
+  futemp_data = N_VGetArrayPointer(futemp);
+  u_data      = N_VGetArrayPointer(u);
+  uscale_data = N_VGetArrayPointer(kin_mem->kin_uscale);
+  utemp_data  = N_VGetArrayPointer(utemp);
+
+  /* Load utemp with u */
+  N_VScale(ONE, u, utemp);
+
+  for (c = 0; c < kinls_mem->ncolors; c++)
+  {
+    /* Increment all utemp components with color c */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] != c) { continue; }
+      inc = kin_mem->kin_sqrt_relfunc *
+            SUNMAX(SUNRabs(u_data[j]), ONE / SUNRabs(uscale_data[j]));
+      utemp_data[j] += inc;
+    }
+
+    /* Evaluate f with incremented u */
+    retval = kin_mem->kin_func(utemp, futemp, kin_mem->kin_user_data);
+    kinls_mem->nfeDQ++;
+    if (retval != 0) { return (retval); }
+
+    /* Form and load difference quotients for color c */
+    if (SUNSparseMatrix_SparseType(Jac) == CSC_MAT)
+    {
+      for (j = 0; j < N; j++)
+      {
+        if (colors[j] != c) { continue; }
+        inc = utemp_data[j] - u_data[j];
+        for (k = J_ptrs[j]; k < J_ptrs[j + 1]; k++)
+        {
+          i         = J_vals[k];
+          J_data[k] = (futemp_data[i] - fu_data[i]) / inc;
+        }
+      }
+    }
+    else
+    {
+      for (i = 0; i < N; i++)
+      {
+        for (k = J_ptrs[i]; k < J_ptrs[i + 1]; k++)
+        {
+          j = J_vals[k];
+          if (colors[j] == c)
+          {
+            inc       = utemp_data[j] - u_data[j];
+            J_data[k] = (futemp_data[i] - fu_data[i]) / inc;
+          }
+        }
+      }
+    }
+
+    /* Restore utemp components */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] == c) { utemp_data[j] = u_data[j]; }
+    }
+  }
+
+  return (0);
+}
+
+/*------------------------------------------------------------------
+  kinLsSparseDQPattern
+
+  This routine determines the nonzero pattern of the Jacobian of
+  F(u) when none was supplied, by perturbing one column at a time
+  and recording the components of F that change (N evaluations of
+  F, counted in nfeDQ). The diagonal is always included. Entries
+  that happen to vanish at the probed state are missed, so the
+  pattern should be supplied with KINSetJacSparsityPattern when
+  this is a concern. The pattern is stored in the format of Jac.
+  ------------------------------------------------------------------*/
+int kinLsSparseDQPattern(N_Vector u, N_Vector fu, SUNMatrix Jac,
+                         KINMem kin_mem, N_Vector tmp1, N_Vector tmp2)
+{
+  sunrealtype inc;
+  N_Vector futemp, utemp;
+  SUNMatrix Jcsc, Jcsr;
+  sunindextype i, j, N, nnz, nz;
+  sunindextype *colptrs, *rowvals;
+  sunrealtype *fu_data, *futemp_data, *u_data, *utemp_data, *uscale_data;
+  sunrealtype* P_data;
+  KINLsMem kinls_mem;
+  int retval = 0;
+
+  /* access LsMem interface structure */
+  kinls_mem = (KINLsMem)kin_mem->kin_lmem;
+
+  /* access matrix dimension and create the pattern in CSC format */
+  N    = SUNSparseMatrix_Columns(Jac);
+  nnz  = SUNMAX(SUNSparseMatrix_NNZ(Jac), N);
+  Jcsc = SUNSparseMatrix(N, N, nnz, CSC_MAT, kin_mem->kin_sunctx);
+  if (Jcsc == NULL)
+  {
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_MEM_FAIL);
+    return (KINLS_MEM_FAIL);
+  }
+  colptrs = SUNSparseMatrix_IndexPointers(Jcsc);
+  rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+  P_data  = SUNSparseMatrix_Data(Jcsc);
+
+  /* Rename work vectors for use as temporary values of u and fu */
+  futemp = tmp1;
+  utemp  = tmp2;
+
+  /* Obtain pointers to the data for fu, futemp, u, uscale, utemp */
+  fu_data     = N_VGetArrayPointer(fu);
+  futemp_data = N_VGetArrayPointer(futemp);
+  u_data      = N_VGetArrayPointer(u);
+  uscale_data = N_VGetArrayPointer(kin_mem->kin_uscale);
+  utemp_data  = N_VGetArrayPointer(utemp);
+
+  /* Load utemp with u */
+  N_VScale(ONE, u, utemp);
+
+  nz = 0;
+  for (j = 0; j < N; j++)
+  {
+    /* Evaluate f with incremented u_j */
+    inc = kin_mem->kin_sqrt_relfunc *
+          SUNMAX(SUNRabs(u_data[j]), ONE / SUNRabs(uscale_data[j]));
+    utemp_data[j] += inc;
+    retval = kin_mem->kin_func(utemp, futemp, kin_mem->kin_user_data);
+    kinls_mem->nfeDQ++;
+    if (retval != 0) { break; }
+    utemp_data[j] = u_data[j];
+
+    /* Record the components of f that depend on u_j */
+    colptrs[j] = nz;
+    for (i = 0; i < N; i++)
+    {
+      if ((i != j) && (futemp_data[i] == fu_data[i])) { continue; }
+      if (nz == nnz)
+      {
+        nnz *= 2;
+        if (SUNSparseMatrix_Reallocate(Jcsc, nnz))
+        {
+          retval = KINLS_MEM_FAIL;
+          break;
+        }
+        rowvals = SUNSparseMatrix_IndexValues(Jcsc);
+        P_data  = SUNSparseMatrix_Data(Jcsc);
+      }
+      rowvals[nz] = i;
+      P_data[nz]  = ONE;
+      nz++;
+    }
+    if (retval != 0) { break; }
+  }
+  colptrs[N] = nz;
+
+  if (retval == KINLS_MEM_FAIL)
+  {
+    KINProcessError(kin_mem, KINLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_LS_MEM_FAIL);
+  }
+  if (retval != 0)
+  {
+    SUNMatDestroy(Jcsc);
+    return (retval);
+  }
+
+  /* Store the pattern in the format of Jac */
+  if (SUNSparseMatrix_SparseType(Jac) == CSR_MAT)
+  {
+    Jcsr   = NULL;
+    retval = SUNSparseMatrix_ToCSR(Jcsc, &Jcsr);
+    SUNMatDestroy(Jcsc);
+    if (retval != 0 || Jcsr == NULL)
+    {
+      KINProcessError(kin_mem, KINLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_LS_MEM_FAIL);
+      return (KINLS_MEM_FAIL);
+    }
+    kinls_mem->Jpat = Jcsr;
+  }
+  else { kinls_mem->Jpat = Jcsc; }
+
+  return (0);
+}
+
 /*------------------------------------------------------------------
   kinLsDQJtimes
 
@@ -1027,13 +1372,14 @@ int kinLsInitialize(KINMem kin_mem)
   else if (kinls_mem->jacDQ)
   {
     /* If J is non-NULL, and 'jac' is not user-supplied:
-       - if A is dense or band, ensure that our DQ approx. is used
+       - if A is dense, band or sparse, ensure that our DQ approx. is used
        - otherwise => error */
     retval = 0;
     if (kinls_mem->J->ops->getid)
     {
       if ((SUNMatGetID(kinls_mem->J) == SUNMATRIX_DENSE) ||
-          (SUNMatGetID(kinls_mem->J) == SUNMATRIX_BAND))
+          (SUNMatGetID(kinls_mem->J) == SUNMATRIX_BAND) ||
+          (SUNMatGetID(kinls_mem->J) == SUNMATRIX_SPARSE))
       {
         kinls_mem->jac    = kinLsDQJac;
         kinls_mem->J_data = kin_mem;
@@ -1357,6 +1703,18 @@ int kinLsFree(KINMem kin_mem)
   if (kin_mem->kin_lmem == NULL) { return (KINLS_SUCCESS); }
   kinls_mem = (KINLsMem)kin_mem->kin_lmem;
 
+  /* Free sparse DQ Jacobian pattern and coloring */
+  if (kinls_mem->Jpat)
+  {
+    SUNMatDestroy(kinls_mem->Jpat);
+    kinls_mem->Jpat = NULL;
+  }
+  if (kinls_mem->colors)
+  {
+    free(kinls_mem->colors);
+    kinls_mem->colors = NULL;
+  }
+
   /* Nullify SUNMatrix pointer */
   kinls_mem->J = NULL;
 
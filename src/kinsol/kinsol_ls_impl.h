@@ -54,6 +54,11 @@ typedef struct KINLsMemRec
   SUNLinearSolver LS; /* generic iterative linear solver object        */
   SUNMatrix J;        /* problem Jacobian                              */
 
+  /* Sparse difference quotient Jacobian data */
+  SUNMatrix Jpat;       /* nonzero pattern of J (user-supplied or probed) */
+  sunindextype* colors; /* column colors of Jpat                          */
+  sunindextype ncolors; /* number of column colors                        */
+
   /* Solver tolerance adjustment factor (if needed, see kinLsSolve)     */
   sunrealtype tol_fac;
 
@@ -122,6 +127,10 @@ int kinLsDenseDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac, KINMem kin_mem,
 
 int kinLsBandDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac, KINMem kin_mem,
                    N_Vector tmp1, N_Vector tmp2);
+int kinLsSparseDQJac(N_Vector u, N_Vector fu, SUNMatrix Jac, KINMem kin_mem,
+                     N_Vector tmp1, N_Vector tmp2);
+int kinLsSparseDQPattern(N_Vector u, N_Vector fu, SUNMatrix Jac,
+                         KINMem kin_mem, N_Vector tmp1, N_Vector tmp2);
 
 /* Generic linit/lsetup/lsolve/lfree interface routines for KINSOL to call */
 int kinLsInitialize(KINMem kin_mem);
@@ -157,6 +166,8 @@ int kinLs_AccessLMem(void* kinmem, const char* fname, KINMem* kin_mem,
   "The Jacobian x vector routine failed in an unrecoverable manner."
 #define MSG_LS_MATZERO_FAILED \
   "The SUNMatZero routine failed in an unrecoverable manner."
+#define MSG_LS_SUNMAT_FAILED \
+  "A SUNMatrix routine failed in an unrecoverable manner."
 
 /*------------------------------------------------------------------
   Info messages
@@ -0,0 +1,1269 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the Lazy implementation of
+ * the NVECTOR package.
+ *
+ * Every lazy vector holds a postfix program computing its pending
+ * value elementwise from the data arrays of other vectors (leaves).
+ * An elementwise operation builds the program of its output from the
+ * programs of its inputs, so chains of operations are inlined into
+ * one program. A vector whose data is read as a leaf keeps a list of
+ * the vectors reading it (dependents). The dependents are evaluated
+ * before the vector receives a program of its own, so the leaves of
+ * a program are never pending, except for the vector itself, and the
+ * pending vectors can be evaluated in any order.
+ *
+ * Programs are evaluated over blocks of elements one instruction at
+ * a time, so each instruction is a short loop over data kept in
+ * cache. Several vectors are materialized in the same loop when
+ * needed and a reduction is computed in the loop that materializes
+ * its arguments.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <nvector/nvector_lazy.h>
+#include <nvector/nvector_openmp.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "sundials_macros.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Limits on the recorded programs and the fused loops */
+#define LAZY_MAX_INSTR  32  /* instructions in one program       */
+#define LAZY_MAX_LEAVES 8   /* data arrays read by one program   */
+#define LAZY_MAX_DEPTH  8   /* evaluation stack depth            */
+#define LAZY_MAX_FUSE   8   /* vectors materialized in one loop  */
+#define LAZY_BLOCK      128 /* elements processed by instruction */
+
+/* -----------------------------------------------------------------
+   Lazy content accessor macros
+   -----------------------------------------------------------------*/
+#define LAZY_CONTENT(v)  ((N_VectorContent_Lazy)(v->content))
+#define LAZY_BASE(v)     (LAZY_CONTENT(v)->base)
+#define LAZY_OWN_BASE(v) (LAZY_CONTENT(v)->own_base)
+#define LAZY_EXPR(v)     (LAZY_CONTENT(v)->expr)
+#define LAZY_PROG(v)     (&(LAZY_EXPR(v)->prog))
+#define LAZY_PENDING(v)  (LAZY_PROG(v)->ninstr > 0)
+
+/* -----------------------------------------------------------------
+   Recorded programs
+   -----------------------------------------------------------------*/
+
+typedef enum
+{
+  LAZY_LOAD,     /* push a leaf data array           */
+  LAZY_CONST,    /* push a                           */
+  LAZY_LINSUM,   /* a*x + b*y                        */
+  LAZY_PROD,     /* x*y                              */
+  LAZY_DIV,      /* x/y                              */
+  LAZY_SCALE,    /* a*x                              */
+  LAZY_ABS,      /* |x|                              */
+  LAZY_INV,      /* 1/x                              */
+  LAZY_ADDCONST, /* x + a                            */
+  LAZY_COMPARE   /* |x| >= a ? 1 : 0                 */
+} lazyOpcode;
+
+typedef struct
+{
+  lazyOpcode op;
+  int arg; /* leaf index of a load or operand swap flag of a binary op */
+  sunrealtype a;
+  sunrealtype b;
+} lazyInstr;
+
+typedef struct
+{
+  int ninstr;
+  int nleaves;
+  int depth;
+  lazyInstr instr[LAZY_MAX_INSTR];
+  N_Vector leaves[LAZY_MAX_LEAVES];
+} lazyProgram;
+
+struct _N_VLazyExpr
+{
+  lazyProgram prog; /* pending value, no instructions if data is current */
+  N_Vector* deps;   /* pending vectors reading the data of this vector   */
+  int ndeps;
+  int maxdeps;
+  sunbooleantype eager; /* data attached by the user is always current */
+  long int nops;   /* number of operations recorded      */
+  long int nloops; /* number of loops materializing data */
+};
+
+typedef struct _N_VLazyExpr* lazyExpr;
+
+/* -----------------------------------------------------------------
+   Fused loops
+   -----------------------------------------------------------------*/
+
+typedef enum
+{
+  LAZY_RED_NONE,
+  LAZY_RED_DOT,      /* sum x*y                    */
+  LAZY_RED_WSQR,     /* sum (x*w)^2                */
+  LAZY_RED_WSQRMASK, /* sum (x*w)^2 where id > 0   */
+  LAZY_RED_MAXABS,   /* max |x|                    */
+  LAZY_RED_SUMABS,   /* sum |x|                    */
+  LAZY_RED_MIN,      /* min x                      */
+  LAZY_RED_MINQUOT   /* min x/y where y != 0       */
+} lazyReduction;
+
+typedef struct
+{
+  int nout;
+  const lazyProgram* prog[LAZY_MAX_FUSE];
+  sunrealtype* leafdata[LAZY_MAX_FUSE][LAZY_MAX_LEAVES];
+  sunrealtype* outdata[LAZY_MAX_FUSE];
+  lazyReduction kind;
+  int nargs;
+  int argout[3];
+  sunrealtype* argdata[3];
+} lazyLoopData;
+
+/* -----------------------------------------------------------------
+   Prototypes of utility routines
+   -----------------------------------------------------------------*/
+static N_Vector LazyClone(N_Vector w, sunbooleantype cloneempty);
+static N_Vector LazyNew(N_Vector base, sunbooleantype own_base,
+                        SUNContext sunctx);
+static void lazyOperand(N_Vector x, N_Vector z, lazyProgram* p);
+static int lazyApply(lazyProgram* p, lazyOpcode op, sunrealtype a);
+static int lazyCombine(lazyProgram* p, const lazyProgram* q, lazyOpcode op,
+                       sunrealtype a, sunrealtype b);
+static void lazyRecordUnary(lazyOpcode op, sunrealtype a, N_Vector x,
+                            N_Vector z);
+static void lazyRecordBinary(lazyOpcode op, sunrealtype a, N_Vector x,
+                             sunrealtype b, N_Vector y, N_Vector z);
+static void lazySetProgram(N_Vector z, const lazyProgram* p);
+static void lazyClearProgram(N_Vector v);
+static int lazyAddDep(N_Vector v, N_Vector d);
+static void lazyRemoveDep(N_Vector v, N_Vector d);
+static int lazyCollect(N_Vector v, sunbooleantype write, N_Vector* set, int n);
+static int lazyInsert(N_Vector v, N_Vector* set, int n);
+static void lazySync(int nvec, N_Vector* V, sunbooleantype write);
+static void lazySyncDeps(N_Vector v);
+static sunrealtype lazyReduce(lazyReduction kind, int nargs, N_Vector* args);
+static sunrealtype lazyLoop(int nout, N_Vector* out, lazyReduction kind,
+                            int nargs, N_Vector* args);
+static sunrealtype lazyLoopRange(const lazyLoopData* d, sunindextype start,
+                                 sunindextype end);
+static sunrealtype* lazyRun(const lazyProgram* p, sunrealtype* const* leafdata,
+                            sunindextype i0, sunindextype nb,
+                            sunrealtype stack[][LAZY_BLOCK], sunrealtype* dst);
+static inline void lazyExec(const lazyInstr* in, const sunrealtype* restrict x,
+                            const sunrealtype* restrict y,
+                            sunrealtype* restrict r, sunindextype nb);
+static sunrealtype lazyReduceBlock(lazyReduction kind, sunrealtype acc,
+                                   sunindextype nb, const sunrealtype* const* x);
+static sunrealtype lazyReduceInit(lazyReduction kind);
+#ifdef _OPENMP
+static sunrealtype lazyReduceCombine(lazyReduction kind, sunrealtype a,
+                                     sunrealtype b);
+#endif
+static int lazyNumThreads(N_Vector base);
+
+/* -----------------------------------------------------------------
+   Lazy API routines
+   -----------------------------------------------------------------*/
+
+/* This function creates a lazy vector wrapping an existing serial or
+   OpenMP vector. The wrapped vector is not destroyed with the lazy
+   vector. */
+N_Vector N_VMake_Lazy(N_Vector base, SUNContext sunctx)
+{
+  N_Vector_ID id;
+
+  if (base == NULL) { return NULL; }
+
+  id = N_VGetVectorID(base);
+  if (id != SUNDIALS_NVEC_SERIAL && id != SUNDIALS_NVEC_OPENMP)
+  {
+    return NULL;
+  }
+
+  return (LazyNew(base, SUNFALSE, sunctx));
+}
+
+/* This function returns the wrapped vector after applying all pending
+   operations to it. Pending operations of other vectors reading its data
+   are applied as well, so the wrapped vector may be modified directly
+   until the next operation on the lazy vector. */
+N_Vector N_VGetBaseVector_Lazy(N_Vector v)
+{
+  lazySync(1, &v, SUNTRUE);
+  return (LAZY_BASE(v));
+}
+
+/* This function applies the pending operations of a lazy vector */
+SUNErrCode N_VFlush_Lazy(N_Vector v)
+{
+  if (v == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  lazySync(1, &v, SUNFALSE);
+  return SUN_SUCCESS;
+}
+
+/* This function returns the number of operations recorded for a lazy
+   vector and the number of loops that materialized its data */
+SUNErrCode N_VGetNumOps_Lazy(N_Vector v, long int* nops, long int* nloops)
+{
+  if (v == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  if (nops) { *nops = LAZY_EXPR(v)->nops; }
+  if (nloops) { *nloops = LAZY_EXPR(v)->nloops; }
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+   Lazy implementations of generic NVector routines
+   -----------------------------------------------------------------*/
+
+/* Returns vector type ID. Used to identify vector implementation
+   from abstract N_Vector interface. */
+N_Vector_ID N_VGetVectorID_Lazy(SUNDIALS_MAYBE_UNUSED N_Vector v)
+{
+  return (SUNDIALS_NVEC_LAZY);
+}
+
+/* Prints the vector to stdout, calling Print on the wrapped vector. */
+void N_VPrint_Lazy(N_Vector x) { N_VPrintFile_Lazy(x, stdout); }
+
+/* Prints the vector to an output file, calling PrintFile on the wrapped
+   vector. */
+void N_VPrintFile_Lazy(N_Vector x, FILE* outfile)
+{
+  lazySync(1, &x, SUNFALSE);
+  N_VPrintFile(LAZY_BASE(x), outfile);
+}
+
+/* Clones a lazy vector, calling CloneEmpty on the wrapped vector. */
+N_Vector N_VCloneEmpty_Lazy(N_Vector w) { return (LazyClone(w, SUNTRUE)); }
+
+/* Clones a lazy vector, calling Clone on the wrapped vector. */
+N_Vector N_VClone_Lazy(N_Vector w) { return (LazyClone(w, SUNFALSE)); }
+
+/* Destroys a lazy vector */
+void N_VDestroy_Lazy(N_Vector v)
+{
+  if (v == NULL) { return; }
+
+  /* free content */
+  if (v->content != NULL)
+  {
+    if (LAZY_EXPR(v) != NULL)
+    {
+      /* pending vectors reading the data need it before it is freed */
+      lazySyncDeps(v);
+      lazyClearProgram(v);
+      free(LAZY_EXPR(v)->deps);
+      free(LAZY_EXPR(v));
+      LAZY_EXPR(v) = NULL;
+    }
+
+    /* destroy the wrapped vector if it is owned by v */
+    if (LAZY_OWN_BASE(v) == SUNTRUE) { N_VDestroy(LAZY_BASE(v)); }
+    LAZY_BASE(v) = NULL;
+
+    free(v->content);
+    v->content = NULL;
+  }
+
+  /* free ops and vector */
+  if (v->ops != NULL)
+  {
+    free(v->ops);
+    v->ops = NULL;
+  }
+  free(v);
+  v = NULL;
+
+  return;
+}
+
+/* Returns the space requirements of the wrapped vector */
+void N_VSpace_Lazy(N_Vector v, sunindextype* lrw, sunindextype* liw)
+{
+  N_VSpace(LAZY_BASE(v), lrw, liw);
+}
+
+/* Applies the pending operations and returns the data array of the wrapped
+   vector. The data may be modified until the next operation that writes the
+   vector. */
+sunrealtype* N_VGetArrayPointer_Lazy(N_Vector v)
+{
+  lazySync(1, &v, SUNTRUE);
+  return (N_VGetArrayPointer(LAZY_BASE(v)));
+}
+
+/* Replaces the data array of the wrapped vector, pending operations of the
+   vector are discarded. The user may read the attached array at any time, so
+   operations writing the vector are no longer deferred. */
+void N_VSetArrayPointer_Lazy(sunrealtype* v_data, N_Vector v)
+{
+  lazySyncDeps(v);
+  lazyClearProgram(v);
+  N_VSetArrayPointer(v_data, LAZY_BASE(v));
+  LAZY_EXPR(v)->eager = (v_data != NULL);
+}
+
+/* Returns the length of the wrapped vector */
+sunindextype N_VGetLength_Lazy(N_Vector v)
+{
+  return (N_VGetLength(LAZY_BASE(v)));
+}
+
+/* The elementwise operations below record the operation into the program
+   of the output vector. */
+
+void N_VLinearSum_Lazy(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
+                       N_Vector z)
+{
+  lazyRecordBinary(LAZY_LINSUM, a, x, b, y, z);
+}
+
+void N_VConst_Lazy(sunrealtype c, N_Vector z)
+{
+  lazyProgram p;
+
+  p.ninstr       = 1;
+  p.nleaves      = 0;
+  p.depth        = 1;
+  p.instr[0].op  = LAZY_CONST;
+  p.instr[0].arg = 0;
+  p.instr[0].a   = c;
+  p.instr[0].b   = ZERO;
+
+  lazySetProgram(z, &p);
+}
+
+void N_VProd_Lazy(N_Vector x, N_Vector y, N_Vector z)
+{
+  lazyRecordBinary(LAZY_PROD, ONE, x, ONE, y, z);
+}
+
+void N_VDiv_Lazy(N_Vector x, N_Vector y, N_Vector z)
+{
+  lazyRecordBinary(LAZY_DIV, ONE, x, ONE, y, z);
+}
+
+void N_VScale_Lazy(sunrealtype c, N_Vector x, N_Vector z)
+{
+  lazyRecordUnary(LAZY_SCALE, c, x, z);
+}
+
+void N_VAbs_Lazy(N_Vector x, N_Vector z)
+{
+  lazyRecordUnary(LAZY_ABS, ZERO, x, z);
+}
+
+void N_VInv_Lazy(N_Vector x, N_Vector z)
+{
+  lazyRecordUnary(LAZY_INV, ZERO, x, z);
+}
+
+void N_VAddConst_Lazy(N_Vector x, sunrealtype b, N_Vector z)
+{
+  lazyRecordUnary(LAZY_ADDCONST, b, x, z);
+}
+
+void N_VCompare_Lazy(sunrealtype c, N_Vector x, N_Vector z)
+{
+  lazyRecordUnary(LAZY_COMPARE, c, x, z);
+}
+
+/* The reductions below are computed in the loop materializing the pending
+   operations of their arguments. */
+
+sunrealtype N_VDotProd_Lazy(N_Vector x, N_Vector y)
+{
+  N_Vector args[2];
+  args[0] = x;
+  args[1] = y;
+  return (lazyReduce(LAZY_RED_DOT, 2, args));
+}
+
+sunrealtype N_VMaxNorm_Lazy(N_Vector x)
+{
+  return (lazyReduce(LAZY_RED_MAXABS, 1, &x));
+}
+
+sunrealtype N_VWSqrSumLocal_Lazy(N_Vector x, N_Vector w)
+{
+  N_Vector args[2];
+  args[0] = x;
+  args[1] = w;
+  return (lazyReduce(LAZY_RED_WSQR, 2, args));
+}
+
+sunrealtype N_VWrmsNorm_Lazy(N_Vector x, N_Vector w)
+{
+  return (SUNRsqrt(N_VWSqrSumLocal_Lazy(x, w) / N_VGetLength_Lazy(x)));
+}
+
+sunrealtype N_VWSqrSumMaskLocal_Lazy(N_Vector x, N_Vector w, N_Vector id)
+{
+  N_Vector args[3];
+  args[0] = x;
+  args[1] = w;
+  args[2] = id;
+  return (lazyReduce(LAZY_RED_WSQRMASK, 3, args));
+}
+
+sunrealtype N_VWrmsNormMask_Lazy(N_Vector x, N_Vector w, N_Vector id)
+{
+  return (SUNRsqrt(N_VWSqrSumMaskLocal_Lazy(x, w, id) / N_VGetLength_Lazy(x)));
+}
+
+sunrealtype N_VMin_Lazy(N_Vector x)
+{
+  return (lazyReduce(LAZY_RED_MIN, 1, &x));
+}
+
+sunrealtype N_VWL2Norm_Lazy(N_Vector x, N_Vector w)
+{
+  return (SUNRsqrt(N_VWSqrSumLocal_Lazy(x, w)));
+}
+
+sunrealtype N_VL1Norm_Lazy(N_Vector x)
+{
+  return (lazyReduce(LAZY_RED_SUMABS, 1, &x));
+}
+
+sunrealtype N_VMinQuotient_Lazy(N_Vector num, N_Vector denom)
+{
+  N_Vector args[2];
+  args[0] = num;
+  args[1] = denom;
+  return (lazyReduce(LAZY_RED_MINQUOT, 2, args));
+}
+
+/* The operations below only write some elements of their output, they are
+   applied to the wrapped vectors after materializing the inputs. */
+
+sunbooleantype N_VInvTest_Lazy(N_Vector x, N_Vector z)
+{
+  lazySync(1, &x, SUNFALSE);
+  lazySync(1, &z, SUNTRUE);
+  return (N_VInvTest(LAZY_BASE(x), LAZY_BASE(z)));
+}
+
+sunbooleantype N_VConstrMask_Lazy(N_Vector c, N_Vector x, N_Vector m)
+{
+  N_Vector args[2];
+  args[0] = c;
+  args[1] = x;
+  lazySync(2, args, SUNFALSE);
+  lazySync(1, &m, SUNTRUE);
+  return (N_VConstrMask(LAZY_BASE(c), LAZY_BASE(x), LAZY_BASE(m)));
+}
+
+/* -----------------------------------------------------------------
+   OPTIONAL XBraid interface operations
+   -----------------------------------------------------------------*/
+
+SUNErrCode N_VBufSize_Lazy(N_Vector x, sunindextype* size)
+{
+  return (N_VBufSize(LAZY_BASE(x), size));
+}
+
+SUNErrCode N_VBufPack_Lazy(N_Vector x, void* buf)
+{
+  lazySync(1, &x, SUNFALSE);
+  return (N_VBufPack(LAZY_BASE(x), buf));
+}
+
+SUNErrCode N_VBufUnpack_Lazy(N_Vector x, void* buf)
+{
+  lazySync(1, &x, SUNTRUE);
+  return (N_VBufUnpack(LAZY_BASE(x), buf));
+}
+
+/* -----------------------------------------------------------------
+   private functions for special cases of vector operations
+   -----------------------------------------------------------------*/
+
+/* This function creates a lazy vector with the operations of the module
+   wrapping the input vector. */
+static N_Vector LazyNew(N_Vector base, sunbooleantype own_base,
+                        SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  N_Vector v;
+  N_VectorContent_Lazy content;
+
+  /* Create vector */
+  v = NULL;
+  v = N_VNewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+
+  /* constructors, destructors, and utility operations */
+  v->ops->nvgetvectorid     = N_VGetVectorID_Lazy;
+  v->ops->nvclone           = N_VClone_Lazy;
+  v->ops->nvcloneempty      = N_VCloneEmpty_Lazy;
+  v->ops->nvdestroy         = N_VDestroy_Lazy;
+  v->ops->nvspace           = N_VSpace_Lazy;
+  v->ops->nvgetarraypointer = N_VGetArrayPointer_Lazy;
+  v->ops->nvsetarraypointer = N_VSetArrayPointer_Lazy;
+  v->ops->nvgetlength       = N_VGetLength_Lazy;
+  v->ops->nvgetlocallength  = N_VGetLength_Lazy;
+
+  /* standard vector operations */
+  v->ops->nvlinearsum    = N_VLinearSum_Lazy;
+  v->ops->nvconst        = N_VConst_Lazy;
+  v->ops->nvprod         = N_VProd_Lazy;
+  v->ops->nvdiv          = N_VDiv_Lazy;
+  v->ops->nvscale        = N_VScale_Lazy;
+  v->ops->nvabs          = N_VAbs_Lazy;
+  v->ops->nvinv          = N_VInv_Lazy;
+  v->ops->nvaddconst     = N_VAddConst_Lazy;
+  v->ops->nvdotprod      = N_VDotProd_Lazy;
+  v->ops->nvmaxnorm      = N_VMaxNorm_Lazy;
+  v->ops->nvwrmsnormmask = N_VWrmsNormMask_Lazy;
+  v->ops->nvwrmsnorm     = N_VWrmsNorm_Lazy;
+  v->ops->nvmin          = N_VMin_Lazy;
+  v->ops->nvwl2norm      = N_VWL2Norm_Lazy;
+  v->ops->nvl1norm       = N_VL1Norm_Lazy;
+  v->ops->nvcompare      = N_VCompare_Lazy;
+  v->ops->nvinvtest      = N_VInvTest_Lazy;
+  v->ops->nvconstrmask   = N_VConstrMask_Lazy;
+  v->ops->nvminquotient  = N_VMinQuotient_Lazy;
+
+  /* fused and vector array operations use the default implementations,
+     which are recorded as sequences of the operations above */
+
+  /* local reduction operations */
+  v->ops->nvdotprodlocal     = N_VDotProd_Lazy;
+  v->ops->nvmaxnormlocal     = N_VMaxNorm_Lazy;
+  v->ops->nvminlocal         = N_VMin_Lazy;
+  v->ops->nvl1normlocal      = N_VL1Norm_Lazy;
+  v->ops->nvinvtestlocal     = N_VInvTest_Lazy;
+  v->ops->nvconstrmasklocal  = N_VConstrMask_Lazy;
+  v->ops->nvminquotientlocal = N_VMinQuotient_Lazy;
+  v->ops->nvwsqrsumlocal     = N_VWSqrSumLocal_Lazy;
+  v->ops->nvwsqrsummasklocal = N_VWSqrSumMaskLocal_Lazy;
+
+  /* XBraid interface operations */
+  v->ops->nvbufsize   = N_VBufSize_Lazy;
+  v->ops->nvbufpack   = N_VBufPack_Lazy;
+  v->ops->nvbufunpack = N_VBufUnpack_Lazy;
+
+  /* debugging functions */
+  v->ops->nvprint     = N_VPrint_Lazy;
+  v->ops->nvprintfile = N_VPrintFile_Lazy;
+
+  /* Create content */
+  content = NULL;
+  content = (N_VectorContent_Lazy)malloc(sizeof *content);
+  if (content == NULL)
+  {
+    N_VFreeEmpty(v);
+    return NULL;
+  }
+
+  /* Attach content */
+  v->content = content;
+
+  /* Initialize content */
+  content->base     = base;
+  content->own_base = own_base;
+  content->expr     = (lazyExpr)calloc(1, sizeof(struct _N_VLazyExpr));
+  if (content->expr == NULL)
+  {
+    free(content);
+    v->content = NULL;
+    N_VFreeEmpty(v);
+    return NULL;
+  }
+
+  return (v);
+}
+
+/* This function clones a lazy vector, the clone owns its wrapped vector.
+   Based on the 'cloneempty' flag it will either call "nvclone" or
+   "nvcloneempty" when creating the wrapped vector. */
+static N_Vector LazyClone(N_Vector w, sunbooleantype cloneempty)
+{
+  N_Vector base, v;
+
+  base = cloneempty ? N_VCloneEmpty(LAZY_BASE(w)) : N_VClone(LAZY_BASE(w));
+  if (base == NULL) { return NULL; }
+
+  v = LazyNew(base, SUNTRUE, w->sunctx);
+  if (v == NULL)
+  {
+    N_VDestroy(base);
+    return NULL;
+  }
+
+  return (v);
+}
+
+/* -----------------------------------------------------------------
+   Recording operations
+   -----------------------------------------------------------------*/
+
+/* Initializes p to the current value of x for use in the program of z: the
+   pending program of x or a load of its data. A program reading the data of
+   x itself is only inlined into the program of x, otherwise x is evaluated
+   first. */
+static void lazyOperand(N_Vector x, N_Vector z, lazyProgram* p)
+{
+  const lazyProgram* xp = LAZY_PROG(x);
+  int i;
+
+  if (LAZY_PENDING(x))
+  {
+    for (i = 0; i < xp->nleaves && (x == z || xp->leaves[i] != x); i++) {}
+    if (i == xp->nleaves)
+    {
+      *p = *xp;
+      return;
+    }
+    lazyLoop(1, &x, LAZY_RED_NONE, 0, NULL);
+  }
+
+  p->ninstr       = 1;
+  p->nleaves      = 1;
+  p->depth        = 1;
+  p->leaves[0]    = x;
+  p->instr[0].op  = LAZY_LOAD;
+  p->instr[0].arg = 0;
+  p->instr[0].a   = ZERO;
+  p->instr[0].b   = ZERO;
+}
+
+/* Appends a unary operation to p, returns nonzero if p is full */
+static int lazyApply(lazyProgram* p, lazyOpcode op, sunrealtype a)
+{
+  lazyInstr* in;
+
+  if (p->ninstr == LAZY_MAX_INSTR) { return 1; }
+
+  in      = p->instr + p->ninstr;
+  in->op  = op;
+  in->arg = 0;
+  in->a   = a;
+  in->b   = ZERO;
+  p->ninstr++;
+
+  return 0;
+}
+
+/* Replaces p with the binary operation op(p, q), returns nonzero if the
+   result exceeds the program limits. The operand needing the deeper stack
+   is evaluated first to keep chains of operations at a small depth. */
+static int lazyCombine(lazyProgram* p, const lazyProgram* q, lazyOpcode op,
+                       sunrealtype a, sunrealtype b)
+{
+  lazyProgram r;
+  const lazyProgram* first;
+  const lazyProgram* second;
+  int map[LAZY_MAX_LEAVES];
+  int i, j, swap, depth;
+
+  if (p->ninstr + q->ninstr + 1 > LAZY_MAX_INSTR) { return 1; }
+
+  /* merge the leaves of q into the leaves of p */
+  r.nleaves = p->nleaves;
+  for (i = 0; i < p->nleaves; i++) { r.leaves[i] = p->leaves[i]; }
+  for (i = 0; i < q->nleaves; i++)
+  {
+    for (j = 0; j < r.nleaves; j++)
+    {
+      if (r.leaves[j] == q->leaves[i]) { break; }
+    }
+    if (j == r.nleaves)
+    {
+      if (r.nleaves == LAZY_MAX_LEAVES) { return 1; }
+      r.leaves[r.nleaves++] = q->leaves[i];
+    }
+    map[i] = j;
+  }
+
+  swap  = (q->depth > p->depth);
+  depth = swap ? SUNMAX(q->depth, p->depth + 1)
+               : SUNMAX(p->depth, q->depth + 1);
+  if (depth > LAZY_MAX_DEPTH) { return 1; }
+
+  first  = swap ? q : p;
+  second = swap ? p : q;
+
+  r.ninstr = 0;
+  for (i = 0; i < first->ninstr; i++)
+  {
+    r.instr[r.ninstr] = first->instr[i];
+    if (swap && first->instr[i].op == LAZY_LOAD)
+    {
+      r.instr[r.ninstr].arg = map[first->instr[i].arg];
+    }
+    r.ninstr++;
+  }
+  for (i = 0; i < second->ninstr; i++)
+  {
+    r.instr[r.ninstr] = second->instr[i];
+    if (!swap && second->instr[i].op == LAZY_LOAD)
+    {
+      r.instr[r.ninstr].arg = map[second->instr[i].arg];
+    }
+    r.ninstr++;
+  }
+
+  r.instr[r.ninstr].op  = op;
+  r.instr[r.ninstr].arg = swap;
+  r.instr[r.ninstr].a   = a;
+  r.instr[r.ninstr].b   = b;
+  r.ninstr++;
+  r.depth = depth;
+
+  *p = r;
+  return 0;
+}
+
+/* Records z = op(x) */
+static void lazyRecordUnary(lazyOpcode op, sunrealtype a, N_Vector x,
+                            N_Vector z)
+{
+  lazyProgram p;
+
+  lazyOperand(x, z, &p);
+  if (lazyApply(&p, op, a))
+  {
+    /* the program of x is full, materialize x and start over */
+    lazySync(1, &x, SUNFALSE);
+    lazyOperand(x, z, &p);
+    lazyApply(&p, op, a);
+  }
+
+  lazySetProgram(z, &p);
+}
+
+/* Records z = op(x, y) */
+static void lazyRecordBinary(lazyOpcode op, sunrealtype a, N_Vector x,
+                             sunrealtype b, N_Vector y, N_Vector z)
+{
+  lazyProgram p, q;
+  N_Vector args[2];
+
+  lazyOperand(x, z, &p);
+  lazyOperand(y, z, &q);
+  if (lazyCombine(&p, &q, op, a, b))
+  {
+    /* the combined program is too large, materialize x and y */
+    args[0] = x;
+    args[1] = y;
+    lazySync(2, args, SUNFALSE);
+    lazyOperand(x, z, &p);
+    lazyOperand(y, z, &q);
+    lazyCombine(&p, &q, op, a, b);
+  }
+
+  lazySetProgram(z, &p);
+}
+
+/* Replaces the pending program of z after evaluating the vectors reading the
+   data of z */
+static void lazySetProgram(N_Vector z, const lazyProgram* p)
+{
+  lazyExpr e = LAZY_EXPR(z);
+  int i, fail;
+
+  lazySyncDeps(z);
+  lazyClearProgram(z);
+  e->prog = *p;
+  e->nops++;
+
+  fail = 0;
+  for (i = 0; i < p->nleaves; i++)
+  {
+    if (p->leaves[i] != z) { fail += lazyAddDep(p->leaves[i], z); }
+  }
+
+  /* evaluate right away if the dependencies could not be recorded or the
+     data is attached by the user */
+  if (fail || e->eager) { lazySync(1, &z, SUNFALSE); }
+}
+
+/* Discards the pending program of v */
+static void lazyClearProgram(N_Vector v)
+{
+  lazyProgram* p = LAZY_PROG(v);
+  int i;
+
+  for (i = 0; i < p->nleaves; i++)
+  {
+    if (p->leaves[i] != v) { lazyRemoveDep(p->leaves[i], v); }
+  }
+
+  p->ninstr  = 0;
+  p->nleaves = 0;
+  p->depth   = 0;
+}
+
+/* Records that the pending program of d reads the data of v */
+static int lazyAddDep(N_Vector v, N_Vector d)
+{
+  lazyExpr e = LAZY_EXPR(v);
+  N_Vector* deps;
+  int i, maxdeps;
+
+  for (i = 0; i < e->ndeps; i++)
+  {
+    if (e->deps[i] == d) { return 0; }
+  }
+
+  if (e->ndeps == e->maxdeps)
+  {
+    maxdeps = (e->maxdeps > 0) ? 2 * e->maxdeps : 4;
+    deps    = (N_Vector*)realloc(e->deps, maxdeps * sizeof(N_Vector));
+    if (deps == NULL) { return 1; }
+    e->deps    = deps;
+    e->maxdeps = maxdeps;
+  }
+
+  e->deps[e->ndeps++] = d;
+  return 0;
+}
+
+static void lazyRemoveDep(N_Vector v, N_Vector d)
+{
+  lazyExpr e = LAZY_EXPR(v);
+  int i;
+
+  for (i = 0; i < e->ndeps; i++)
+  {
+    if (e->deps[i] == d)
+    {
+      e->deps[i] = e->deps[--e->ndeps];
+      return;
+    }
+  }
+}
+
+/* -----------------------------------------------------------------
+   Materializing vectors
+   -----------------------------------------------------------------*/
+
+/* Adds v to the set if it is pending, or for write access the vectors reading
+   the data of v. Returns the new size of the set or -1 if it does not fit in
+   one loop. */
+static int lazyCollect(N_Vector v, sunbooleantype write, N_Vector* set, int n)
+{
+  lazyExpr e = LAZY_EXPR(v);
+  int i;
+
+  /* a pending vector has no dependents */
+  if (LAZY_PENDING(v)) { return (lazyInsert(v, set, n)); }
+  if (!write) { return n; }
+
+  for (i = 0; i < e->ndeps && n >= 0; i++)
+  {
+    n = lazyInsert(e->deps[i], set, n);
+  }
+
+  return n;
+}
+
+/* Adds v to the set unless it is already included */
+static int lazyInsert(N_Vector v, N_Vector* set, int n)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+  {
+    if (set[i] == v) { return n; }
+  }
+  if (n == LAZY_MAX_FUSE) { return -1; }
+  set[n++] = v;
+
+  return n;
+}
+
+/* Materializes the vectors in V. For write access the pending vectors reading
+   their data are materialized as well. */
+static void lazySync(int nvec, N_Vector* V, sunbooleantype write)
+{
+  N_Vector set[LAZY_MAX_FUSE];
+  int i, n;
+
+  n = 0;
+  for (i = 0; i < nvec && n >= 0; i++)
+  {
+    n = lazyCollect(V[i], write, set, n);
+  }
+
+  if (n > 0) { lazyLoop(n, set, LAZY_RED_NONE, 0, NULL); }
+  if (n >= 0) { return; }
+
+  /* too many vectors for one loop, the pending vectors are independent */
+  for (i = 0; i < nvec; i++)
+  {
+    if (LAZY_PENDING(V[i])) { lazyLoop(1, V + i, LAZY_RED_NONE, 0, NULL); }
+    else if (write) { lazySyncDeps(V[i]); }
+  }
+}
+
+/* Materializes the pending vectors reading the data of v */
+static void lazySyncDeps(N_Vector v)
+{
+  lazyExpr e = LAZY_EXPR(v);
+  N_Vector set[LAZY_MAX_FUSE];
+  int i, n;
+
+  /* materializing a vector removes it from the dependents of v */
+  while (e->ndeps > 0)
+  {
+    n = SUNMIN(e->ndeps, LAZY_MAX_FUSE);
+    for (i = 0; i < n; i++) { set[i] = e->deps[e->ndeps - 1 - i]; }
+    lazyLoop(n, set, LAZY_RED_NONE, 0, NULL);
+  }
+}
+
+/* Computes a reduction over the arguments in the loop materializing them */
+static sunrealtype lazyReduce(lazyReduction kind, int nargs, N_Vector* args)
+{
+  N_Vector set[LAZY_MAX_FUSE];
+  int i, n;
+
+  n = 0;
+  for (i = 0; i < nargs && n >= 0; i++)
+  {
+    n = lazyCollect(args[i], SUNFALSE, set, n);
+  }
+
+  if (n < 0)
+  {
+    lazySync(nargs, args, SUNFALSE);
+    n = 0;
+  }
+
+  return (lazyLoop(n, set, kind, nargs, args));
+}
+
+/* Evaluates the programs of the vectors in out, writes the results to their
+   data and clears the programs. The reduction of the given kind over args is
+   computed in the same loop. */
+static sunrealtype lazyLoop(int nout, N_Vector* out, lazyReduction kind,
+                            int nargs, N_Vector* args)
+{
+  lazyLoopData d;
+  N_Vector ref;
+  sunindextype n;
+  sunrealtype result;
+  int i, j, nthreads;
+
+  ref = (nargs > 0) ? args[0] : out[0];
+  n   = N_VGetLength(LAZY_BASE(ref));
+
+  d.nout = nout;
+  for (i = 0; i < nout; i++)
+  {
+    d.prog[i]    = LAZY_PROG(out[i]);
+    d.outdata[i] = N_VGetArrayPointer(LAZY_BASE(out[i]));
+    for (j = 0; j < d.prog[i]->nleaves; j++)
+    {
+      d.leafdata[i][j] = N_VGetArrayPointer(LAZY_BASE(d.prog[i]->leaves[j]));
+    }
+  }
+
+  d.kind  = kind;
+  d.nargs = nargs;
+  for (i = 0; i < nargs; i++)
+  {
+    d.argout[i]  = -1;
+    d.argdata[i] = N_VGetArrayPointer(LAZY_BASE(args[i]));
+    for (j = 0; j < nout; j++)
+    {
+      if (out[j] == args[i]) { d.argout[i] = j; }
+    }
+  }
+
+  result   = lazyReduceInit(kind);
+  nthreads = lazyNumThreads(LAZY_BASE(ref));
+
+#ifdef _OPENMP
+  if (nthreads > 1 && n > LAZY_BLOCK)
+  {
+    sunrealtype* partial;
+    sunindextype nblocks;
+
+    partial = (sunrealtype*)malloc(nthreads * sizeof(sunrealtype));
+    if (partial != NULL)
+    {
+      for (i = 0; i < nthreads; i++) { partial[i] = result; }
+      nblocks = (n + LAZY_BLOCK - 1) / LAZY_BLOCK;
+
+#pragma omp parallel num_threads(nthreads)
+      {
+        sunindextype start, end;
+        int tid = omp_get_thread_num();
+        int nt  = omp_get_num_threads();
+
+        start = (nblocks * tid / nt) * LAZY_BLOCK;
+        end   = SUNMIN((nblocks * (tid + 1) / nt) * LAZY_BLOCK, n);
+        if (start < end) { partial[tid] = lazyLoopRange(&d, start, end); }
+      }
+
+      for (i = 0; i < nthreads; i++)
+      {
+        result = lazyReduceCombine(kind, result, partial[i]);
+      }
+      free(partial);
+      nthreads = 0;
+    }
+  }
+#endif
+
+  if (nthreads > 0) { result = lazyLoopRange(&d, 0, n); }
+
+  for (i = 0; i < nout; i++)
+  {
+    lazyClearProgram(out[i]);
+    LAZY_EXPR(out[i])->nloops++;
+  }
+
+  return result;
+}
+
+/* Executes the loop over the elements start to end-1 */
+static sunrealtype lazyLoopRange(const lazyLoopData* d, sunindextype start,
+                                 sunindextype end)
+{
+  sunrealtype stack[2 * LAZY_MAX_DEPTH][LAZY_BLOCK];
+  const sunrealtype* val[LAZY_MAX_FUSE];
+  const sunrealtype* argval[3];
+  sunrealtype acc;
+  sunindextype i0, nb;
+  int k;
+
+  acc = lazyReduceInit(d->kind);
+
+  for (i0 = start; i0 < end; i0 += LAZY_BLOCK)
+  {
+    nb = SUNMIN(LAZY_BLOCK, end - i0);
+
+    /* the outputs are not read by the other programs */
+    for (k = 0; k < d->nout; k++)
+    {
+      val[k] = lazyRun(d->prog[k], d->leafdata[k], i0, nb, stack,
+                       d->outdata[k] + i0);
+    }
+
+    if (d->kind != LAZY_RED_NONE)
+    {
+      for (k = 0; k < d->nargs; k++)
+      {
+        argval[k] = (d->argout[k] >= 0) ? val[d->argout[k]]
+                                        : d->argdata[k] + i0;
+      }
+      acc = lazyReduceBlock(d->kind, acc, nb, argval);
+    }
+  }
+
+  return acc;
+}
+
+/* Evaluates a program over the elements i0 to i0+nb-1 and stores the result
+   in dst. Every level of the evaluation stack has two buffers so that no
+   instruction overwrites its own operands. */
+static sunrealtype* lazyRun(const lazyProgram* p, sunrealtype* const* leafdata,
+                            sunindextype i0, sunindextype nb,
+                            sunrealtype stack[][LAZY_BLOCK], sunrealtype* dst)
+{
+  const sunrealtype* sp[LAZY_MAX_DEPTH];
+  const sunrealtype* x;
+  const sunrealtype* y;
+  const lazyInstr* in;
+  sunrealtype* r;
+  int ip, top;
+
+  top = -1;
+
+  for (ip = 0; ip < p->ninstr; ip++)
+  {
+    in = p->instr + ip;
+    x = y = NULL;
+
+    switch (in->op)
+    {
+    case LAZY_LOAD: sp[++top] = leafdata[in->arg] + i0; continue;
+    case LAZY_CONST: top++; break;
+    case LAZY_LINSUM:
+    case LAZY_PROD:
+    case LAZY_DIV:
+      x = in->arg ? sp[top] : sp[top - 1];
+      y = in->arg ? sp[top - 1] : sp[top];
+      top--;
+      break;
+    default: x = sp[top]; break;
+    }
+
+    /* the last instruction writes the result unless it reads dst */
+    if (ip == p->ninstr - 1 && x != dst && y != dst) { r = dst; }
+    else if (x == stack[2 * top] || y == stack[2 * top])
+    {
+      r = stack[2 * top + 1];
+    }
+    else { r = stack[2 * top]; }
+
+    /* full blocks have a constant trip count the compiler can vectorize */
+    if (nb == LAZY_BLOCK) { lazyExec(in, x, y, r, LAZY_BLOCK); }
+    else { lazyExec(in, x, y, r, nb); }
+
+    sp[top] = r;
+  }
+
+  /* a single load or a result computed in the stack is copied */
+  if (sp[0] != dst) { memcpy(dst, sp[0], nb * sizeof(sunrealtype)); }
+
+  return dst;
+}
+
+/* Executes one instruction on nb elements */
+static inline void lazyExec(const lazyInstr* in, const sunrealtype* restrict x,
+                            const sunrealtype* restrict y,
+                            sunrealtype* restrict r, sunindextype nb)
+{
+  const sunrealtype a = in->a;
+  const sunrealtype b = in->b;
+  sunindextype j;
+
+  switch (in->op)
+  {
+  case LAZY_CONST:
+    for (j = 0; j < nb; j++) { r[j] = a; }
+    break;
+  case LAZY_LINSUM:
+    for (j = 0; j < nb; j++) { r[j] = a * x[j] + b * y[j]; }
+    break;
+  case LAZY_PROD:
+    for (j = 0; j < nb; j++) { r[j] = x[j] * y[j]; }
+    break;
+  case LAZY_DIV:
+    for (j = 0; j < nb; j++) { r[j] = x[j] / y[j]; }
+    break;
+  case LAZY_SCALE:
+    for (j = 0; j < nb; j++) { r[j] = a * x[j]; }
+    break;
+  case LAZY_ABS:
+    for (j = 0; j < nb; j++) { r[j] = SUNRabs(x[j]); }
+    break;
+  case LAZY_INV:
+    for (j = 0; j < nb; j++) { r[j] = ONE / x[j]; }
+    break;
+  case LAZY_ADDCONST:
+    for (j = 0; j < nb; j++) { r[j] = x[j] + a; }
+    break;
+  case LAZY_COMPARE:
+    for (j = 0; j < nb; j++) { r[j] = (SUNRabs(x[j]) >= a) ? ONE : ZERO; }
+    break;
+  default: break;
+  }
+}
+
+static sunrealtype lazyReduceBlock(lazyReduction kind, sunrealtype acc,
+                                   sunindextype nb, const sunrealtype* const* x)
+{
+  sunrealtype t;
+  sunindextype j;
+
+  switch (kind)
+  {
+  case LAZY_RED_DOT:
+    for (j = 0; j < nb; j++) { acc += x[0][j] * x[1][j]; }
+    break;
+  case LAZY_RED_WSQR:
+    for (j = 0; j < nb; j++)
+    {
+      t = x[0][j] * x[1][j];
+      acc += t * t;
+    }
+    break;
+  case LAZY_RED_WSQRMASK:
+    for (j = 0; j < nb; j++)
+    {
+      if (x[2][j] > ZERO)
+      {
+        t = x[0][j] * x[1][j];
+        acc += t * t;
+      }
+    }
+    break;
+  case LAZY_RED_MAXABS:
+    for (j = 0; j < nb; j++)
+    {
+      if (SUNRabs(x[0][j]) > acc) { acc = SUNRabs(x[0][j]); }
+    }
+    break;
+  case LAZY_RED_SUMABS:
+    for (j = 0; j < nb; j++) { acc += SUNRabs(x[0][j]); }
+    break;
+  case LAZY_RED_MIN:
+    for (j = 0; j < nb; j++)
+    {
+      if (x[0][j] < acc) { acc = x[0][j]; }
+    }
+    break;
+  case LAZY_RED_MINQUOT:
+    for (j = 0; j < nb; j++)
+    {
+      if (x[1][j] == ZERO) { continue; }
+      t = x[0][j] / x[1][j];
+      if (t < acc) { acc = t; }
+    }
+    break;
+  default: break;
+  }
+
+  return acc;
+}
+
+static sunrealtype lazyReduceInit(lazyReduction kind)
+{
+  return (kind == LAZY_RED_MIN || kind == LAZY_RED_MINQUOT) ? SUN_BIG_REAL
+                                                            : ZERO;
+}
+
+#ifdef _OPENMP
+static sunrealtype lazyReduceCombine(lazyReduction kind, sunrealtype a,
+                                     sunrealtype b)
+{
+  switch (kind)
+  {
+  case LAZY_RED_MAXABS: return SUNMAX(a, b);
+  case LAZY_RED_MIN:
+  case LAZY_RED_MINQUOT: return SUNMIN(a, b);
+  default: return a + b;
+  }
+}
+#endif
+
+/* Returns the number of threads used by the loops over a wrapped vector */
+static int lazyNumThreads(N_Vector base)
+{
+  if (N_VGetVectorID(base) == SUNDIALS_NVEC_OPENMP)
+  {
+    return (NV_NUM_THREADS_OMP(base));
+  }
+  return 1;
+}
@@ -57,11 +57,24 @@
 #define MANYVECTOR_SUBVECS(v)     (MANYVECTOR_CONTENT(v)->subvec_array)
 #define MANYVECTOR_SUBVEC(v, i)   (MANYVECTOR_SUBVECS(v)[i])
 #define MANYVECTOR_OWN_DATA(v)    (MANYVECTOR_CONTENT(v)->own_data)
+#define MANYVECTOR_NUM_THREADS(v) (MANYVECTOR_CONTENT(v)->num_threads)
+#define MANYVECTOR_OFFSETS(v)     (MANYVECTOR_CONTENT(v)->thread_offsets)
+#define MANYVECTOR_THREAD_RED(v)  (MANYVECTOR_CONTENT(v)->thread_reductions)
+
+/* The groups of subvectors set with N_VSetNumThreads are processed by OpenMP
+   threads. The SUNDIALS profiler timers are not thread-safe, so profiling
+   builds process the groups in turn with the calling thread. */
+#if defined(_OPENMP) && !(defined(SUNDIALS_BUILD_WITH_PROFILING) && \
+                          !defined(SUNDIALS_CALIPER_ENABLED))
+#define MANYVECTOR_USE_OPENMP
+#endif
 
 /* -----------------------------------------------------------------
    Prototypes of utility routines
    -----------------------------------------------------------------*/
 static N_Vector ManyVectorClone(N_Vector w, sunbooleantype cloneempty);
+static SUNErrCode ManyVectorPartition(N_Vector v, int num_threads);
+static sunrealtype SubvectorLocalLength(N_Vector x);
 #ifdef MANYVECTOR_BUILD_WITH_MPI
 static int SubvectorMPIRank(N_Vector w);
 #endif
@@ -172,10 +185,13 @@ N_Vector N_VMake_MPIManyVector(MPI_Comm comm, sunindextype num_subvectors,
   /* Attach content components */
 
   /* set scalar content entries, and allocate/set subvector array */
-  content->comm           = MPI_COMM_NULL;
-  content->num_subvectors = num_subvectors;
-  content->own_data       = SUNFALSE;
-  content->subvec_array   = NULL;
+  content->comm              = MPI_COMM_NULL;
+  content->num_subvectors    = num_subvectors;
+  content->own_data          = SUNFALSE;
+  content->subvec_array      = NULL;
+  content->num_threads       = 1;
+  content->thread_offsets    = NULL;
+  content->thread_reductions = SUNFALSE;
   content->subvec_array = (N_Vector*)malloc(num_subvectors * sizeof(N_Vector));
   SUNAssertNull(content->subvec_array, SUN_ERR_MALLOC_FAIL);
 
@@ -228,6 +244,9 @@ N_Vector N_VMake_MPIManyVector(MPI_Comm comm, sunindextype num_subvectors,
   }
   else { content->global_length = local_length; }
 
+  /* operate on all subvectors with the calling thread */
+  SUNCheckCallNull(ManyVectorPartition(v, 1));
+
   return (v);
 }
 #endif
@@ -391,8 +410,11 @@ N_Vector N_VNew_ManyVector(sunindextype num_subvectors, N_Vector* vec_array,
   /* Attach content components */
 
   /* allocate and set subvector array */
-  content->num_subvectors = num_subvectors;
-  content->own_data       = SUNFALSE;
+  content->num_subvectors    = num_subvectors;
+  content->own_data          = SUNFALSE;
+  content->num_threads       = 1;
+  content->thread_offsets    = NULL;
+  content->thread_reductions = SUNFALSE;
 
   content->subvec_array = NULL;
   content->subvec_array = (N_Vector*)malloc(num_subvectors * sizeof(N_Vector));
@@ -413,6 +435,9 @@ N_Vector N_VNew_ManyVector(sunindextype num_subvectors, N_Vector* vec_array,
   }
   content->global_length = local_length;
 
+  /* operate on all subvectors with the calling thread */
+  SUNCheckCallNull(ManyVectorPartition(v, 1));
+
   return (v);
 }
 #endif
@@ -468,6 +493,25 @@ sunindextype MVAPPEND(N_VGetNumSubvectors)(N_Vector v)
   return (MANYVECTOR_NUM_SUBVECS(v));
 }
 
+/* This function sets the number of threads operating concurrently on the
+   subvectors. The subvectors are split into num_threads groups of consecutive
+   subvectors with similar local lengths, and each thread operates on one
+   group. The number of threads is limited to the number of subvectors. */
+SUNErrCode MVAPPEND(N_VSetNumThreads)(N_Vector v, int num_threads)
+{
+  SUNFunctionBegin(v->sunctx);
+  SUNAssert(num_threads > 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  if (num_threads > MANYVECTOR_NUM_SUBVECS(v))
+  {
+    num_threads = (int)MANYVECTOR_NUM_SUBVECS(v);
+  }
+  if (num_threads < 1) { num_threads = 1; }
+
+  SUNCheckCall(ManyVectorPartition(v, num_threads));
+  return SUN_SUCCESS;
+}
+
 /* -----------------------------------------------------------------
    ManyVector implementations of generic NVector routines
    -----------------------------------------------------------------*/
@@ -543,6 +587,10 @@ void MVAPPEND(N_VDestroy)(N_Vector v)
     free(MANYVECTOR_SUBVECS(v));
     MANYVECTOR_SUBVECS(v) = NULL;
 
+    /* free thread partition */
+    free(MANYVECTOR_OFFSETS(v));
+    MANYVECTOR_OFFSETS(v) = NULL;
+
 #ifdef MANYVECTOR_BUILD_WITH_MPI
     /* free communicator */
     if (MANYVECTOR_COMM(v) != MPI_COMM_NULL)
@@ -622,13 +670,25 @@ void MVAPPEND(N_VLinearSum)(sunrealtype a, N_Vector x, sunrealtype b,
                             N_Vector y, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VLinearSum(a, MANYVECTOR_SUBVEC(x, i), b, MANYVECTOR_SUBVEC(y, i),
-                 MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VLinearSum(a, MANYVECTOR_SUBVEC(x, i), b, MANYVECTOR_SUBVEC(y, i),
+                   MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -636,12 +696,24 @@ void MVAPPEND(N_VLinearSum)(sunrealtype a, N_Vector x, sunrealtype b,
 void MVAPPEND(N_VConst)(sunrealtype c, N_Vector z)
 {
   SUNFunctionBegin(z->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(z); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(z);
+  off = MANYVECTOR_OFFSETS(z);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VConst(c, MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VConst(c, MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -651,13 +723,25 @@ void MVAPPEND(N_VConst)(sunrealtype c, N_Vector z)
 void MVAPPEND(N_VProd)(N_Vector x, N_Vector y, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VProd(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i),
-            MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VProd(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i),
+              MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -667,13 +751,25 @@ void MVAPPEND(N_VProd)(N_Vector x, N_Vector y, N_Vector z)
 void MVAPPEND(N_VDiv)(N_Vector x, N_Vector y, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VDiv(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i),
-           MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VDiv(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i),
+             MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -683,12 +779,24 @@ void MVAPPEND(N_VDiv)(N_Vector x, N_Vector y, N_Vector z)
 void MVAPPEND(N_VScale)(sunrealtype c, N_Vector x, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VScale(c, MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VScale(c, MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -698,12 +806,24 @@ void MVAPPEND(N_VScale)(sunrealtype c, N_Vector x, N_Vector z)
 void MVAPPEND(N_VAbs)(N_Vector x, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VAbs(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VAbs(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -713,12 +833,24 @@ void MVAPPEND(N_VAbs)(N_Vector x, N_Vector z)
 void MVAPPEND(N_VInv)(N_Vector x, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VInv(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VInv(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -728,12 +860,24 @@ void MVAPPEND(N_VInv)(N_Vector x, N_Vector z)
 void MVAPPEND(N_VAddConst)(N_Vector x, sunrealtype b, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VAddConst(MANYVECTOR_SUBVEC(x, i), b, MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VAddConst(MANYVECTOR_SUBVEC(x, i), b, MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -749,47 +893,53 @@ void MVAPPEND(N_VAddConst)(N_Vector x, sunrealtype b, N_Vector z)
 sunrealtype MVAPPEND(N_VDotProdLocal)(N_Vector x, N_Vector y)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
+  sunindextype i, *off;
+  int t, nt;
   sunrealtype sum;
-#ifdef MANYVECTOR_BUILD_WITH_MPI
-  sunrealtype contrib;
-  int rank;
-#endif
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
   /* initialize output*/
   sum = ZERO;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) reduction(+ : sum) \
+  schedule(static) num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
+  for (t = 0; t < nt; t++)
   {
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
 #ifdef MANYVECTOR_BUILD_WITH_MPI
 
-    /* check for nvdotprodlocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvdotprodlocal)
-    {
-      sum += N_VDotProdLocal(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i));
-      SUNCheckLastErrNoRet();
-      /* otherwise, call nvdotprod and root tasks accumulate to overall sum */
-    }
-    else
-    {
-      contrib = N_VDotProd(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i));
-      SUNCheckLastErrNoRet();
-
-      /* get this task's rank in subvector communicator (note: serial
-         subvectors will result in rank==0) */
-      rank = SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i));
-      if (rank < 0) { return (ZERO); }
-      if (rank == 0) { sum += contrib; }
-    }
+      /* check for nvdotprodlocal in subvector */
+      if (MANYVECTOR_SUBVEC(x, i)->ops->nvdotprodlocal)
+      {
+        sum += N_VDotProdLocal(MANYVECTOR_SUBVEC(x, i),
+                               MANYVECTOR_SUBVEC(y, i));
+
+        /* otherwise, call nvdotprod and root tasks accumulate to overall sum */
+      }
+      else
+      {
+        sunrealtype contrib = N_VDotProd(MANYVECTOR_SUBVEC(x, i),
+                                         MANYVECTOR_SUBVEC(y, i));
+
+        /* get this task's rank in subvector communicator (note: serial
+           subvectors will result in rank==0) */
+        if (SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i)) == 0) { sum += contrib; }
+      }
 
 #else
 
-    /* add subvector contribution */
-    sum += N_VDotProd(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i));
-    SUNCheckLastErrNoRet();
+      /* add subvector contribution */
+      sum += N_VDotProd(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(y, i));
 
 #endif
+    }
   }
+  SUNCheckLastErrNoRet();
 
   return (sum);
 }
@@ -822,30 +972,48 @@ sunrealtype N_VDotProd_MPIManyVector(N_Vector x, N_Vector y)
 sunrealtype MVAPPEND(N_VMaxNormLocal)(N_Vector x)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  sunrealtype max, lmax;
+  sunindextype i, *off;
+  int t, nt;
+  sunrealtype max, tmax, lmax;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
   /* initialize output*/
   max = ZERO;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel default(shared) private(i, t, tmax, lmax) \
+  num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
   {
-    /* check for nvmaxnormlocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvmaxnormlocal)
+    tmax = ZERO;
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (t = 0; t < nt; t++)
     {
-      lmax = N_VMaxNormLocal(MANYVECTOR_SUBVEC(x, i));
-      SUNCheckLastErrNoRet();
-      max = (max > lmax) ? max : lmax;
-
-      /* otherwise, call nvmaxnorm and accumulate to overall max */
+      for (i = off[t]; i < off[t + 1]; i++)
+      {
+        /* check for nvmaxnormlocal in subvector */
+        if (MANYVECTOR_SUBVEC(x, i)->ops->nvmaxnormlocal)
+        {
+          lmax = N_VMaxNormLocal(MANYVECTOR_SUBVEC(x, i));
+
+          /* otherwise, call nvmaxnorm and accumulate to overall max */
+        }
+        else { lmax = N_VMaxNorm(MANYVECTOR_SUBVEC(x, i)); }
+        tmax = (tmax > lmax) ? tmax : lmax;
+      }
     }
-    else
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
     {
-      lmax = N_VMaxNorm(MANYVECTOR_SUBVEC(x, i));
-      SUNCheckLastErrNoRet();
-      max = (max > lmax) ? max : lmax;
+      max = (max > tmax) ? max : tmax;
     }
   }
+  SUNCheckLastErrNoRet();
 
   return (max);
 }
@@ -881,55 +1049,62 @@ sunrealtype N_VMaxNorm_MPIManyVector(N_Vector x)
 sunrealtype MVAPPEND(N_VWSqrSumLocal)(N_Vector x, N_Vector w)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i, N;
-  sunrealtype sum, contrib;
-#ifdef MANYVECTOR_BUILD_WITH_MPI
-  int rank;
-#endif
+  sunindextype i, *off;
+  int t, nt;
+  sunrealtype sum;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
   /* initialize output*/
   sum = ZERO;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) reduction(+ : sum) \
+  schedule(static) num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
+  for (t = 0; t < nt; t++)
   {
-#ifdef MANYVECTOR_BUILD_WITH_MPI
-
-    /* check for nvwsqrsumlocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvwsqrsumlocal)
+    for (i = off[t]; i < off[t + 1]; i++)
     {
-      sum += N_VWSqrSumLocal(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i));
-      SUNCheckLastErrNoRet();
+      sunindextype N;
+      sunrealtype contrib;
 
-      /* otherwise, call nvwrmsnorm, and accumulate to overall sum on root task */
-    }
-    else
-    {
-      contrib = N_VWrmsNorm(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i));
-      SUNCheckLastErrNoRet();
+#ifdef MANYVECTOR_BUILD_WITH_MPI
 
-      /* get this task's rank in subvector communicator (note: serial
-         subvectors will result in rank==0) */
-      rank = SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i));
-      if (rank < 0) { return (ZERO); }
-      if (rank == 0)
+      /* check for nvwsqrsumlocal in subvector */
+      if (MANYVECTOR_SUBVEC(x, i)->ops->nvwsqrsumlocal)
       {
-        N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
-        SUNCheckLastErrNoRet();
-        sum += (contrib * contrib * N);
+        sum += N_VWSqrSumLocal(MANYVECTOR_SUBVEC(x, i),
+                               MANYVECTOR_SUBVEC(w, i));
+
+        /* otherwise, call nvwrmsnorm, and accumulate to overall sum on root
+           task */
+      }
+      else
+      {
+        contrib = N_VWrmsNorm(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i));
+
+        /* get this task's rank in subvector communicator (note: serial
+           subvectors will result in rank==0) */
+        if (SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i)) == 0)
+        {
+          N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
+          sum += (contrib * contrib * N);
+        }
       }
-    }
 
 #else
 
-    /* accumulate subvector contribution to overall sum */
-    contrib = N_VWrmsNorm(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i));
-    SUNCheckLastErrNoRet();
-    N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
-    SUNCheckLastErrNoRet();
-    sum += (contrib * contrib * N);
+      /* accumulate subvector contribution to overall sum */
+      contrib = N_VWrmsNorm(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i));
+      N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
+      sum += (contrib * contrib * N);
 
 #endif
+    }
   }
+  SUNCheckLastErrNoRet();
 
   return (sum);
 }
@@ -972,58 +1147,67 @@ sunrealtype MVAPPEND(N_VWrmsNorm)(N_Vector x, N_Vector w)
 sunrealtype MVAPPEND(N_VWSqrSumMaskLocal)(N_Vector x, N_Vector w, N_Vector id)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i, N;
-  sunrealtype sum, contrib;
-#ifdef MANYVECTOR_BUILD_WITH_MPI
-  int rank;
-#endif
+  sunindextype i, *off;
+  int t, nt;
+  sunrealtype sum;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
   /* initialize output*/
   sum = ZERO;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) reduction(+ : sum) \
+  schedule(static) num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
+  for (t = 0; t < nt; t++)
   {
-#ifdef MANYVECTOR_BUILD_WITH_MPI
-
-    /* check for nvwsqrsummasklocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvwsqrsummasklocal)
+    for (i = off[t]; i < off[t + 1]; i++)
     {
-      sum += N_VWSqrSumMaskLocal(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i),
-                                 MANYVECTOR_SUBVEC(id, i));
-      SUNCheckLastErrNoRet();
+      sunindextype N;
+      sunrealtype contrib;
 
-      /* otherwise, call nvwrmsnormmask, and accumulate to overall sum on root task */
-    }
-    else
-    {
-      contrib = N_VWrmsNormMask(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i),
-                                MANYVECTOR_SUBVEC(id, i));
-      SUNCheckLastErrNoRet();
+#ifdef MANYVECTOR_BUILD_WITH_MPI
 
-      /* get this task's rank in subvector communicator (note: serial
-         subvectors will result in rank==0) */
-      rank = SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i));
-      if (rank < 0) { return (ZERO); }
-      if (rank == 0)
+      /* check for nvwsqrsummasklocal in subvector */
+      if (MANYVECTOR_SUBVEC(x, i)->ops->nvwsqrsummasklocal)
+      {
+        sum += N_VWSqrSumMaskLocal(MANYVECTOR_SUBVEC(x, i),
+                                   MANYVECTOR_SUBVEC(w, i),
+                                   MANYVECTOR_SUBVEC(id, i));
+
+        /* otherwise, call nvwrmsnormmask, and accumulate to overall sum on
+           root task */
+      }
+      else
       {
-        N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
-        SUNCheckLastErrNoRet();
-        sum += (contrib * contrib * N);
+        contrib = N_VWrmsNormMask(MANYVECTOR_SUBVEC(x, i),
+                                  MANYVECTOR_SUBVEC(w, i),
+                                  MANYVECTOR_SUBVEC(id, i));
+
+        /* get this task's rank in subvector communicator (note: serial
+           subvectors will result in rank==0) */
+        if (SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i)) == 0)
+        {
+          N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
+          sum += (contrib * contrib * N);
+        }
       }
-    }
 
 #else
 
-    /* accumulate subvector contribution to overall sum */
-    contrib = N_VWrmsNormMask(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(w, i),
-                              MANYVECTOR_SUBVEC(id, i));
-    SUNCheckLastErrNoRet();
-    N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
-    SUNCheckLastErrNoRet();
-    sum += (contrib * contrib * N);
+      /* accumulate subvector contribution to overall sum */
+      contrib = N_VWrmsNormMask(MANYVECTOR_SUBVEC(x, i),
+                                MANYVECTOR_SUBVEC(w, i),
+                                MANYVECTOR_SUBVEC(id, i));
+      N = N_VGetLength(MANYVECTOR_SUBVEC(x, i));
+      sum += (contrib * contrib * N);
 
 #endif
+    }
   }
+  SUNCheckLastErrNoRet();
 
   return (sum);
 }
@@ -1060,30 +1244,48 @@ sunrealtype MVAPPEND(N_VWrmsNormMask)(N_Vector x, N_Vector w, N_Vector id)
 sunrealtype MVAPPEND(N_VMinLocal)(N_Vector x)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  sunrealtype min, lmin;
+  sunindextype i, *off;
+  int t, nt;
+  sunrealtype min, tmin, lmin;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
   /* initialize output*/
   min = SUN_BIG_REAL;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel default(shared) private(i, t, tmin, lmin) \
+  num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
   {
-    /* check for nvminlocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvminlocal)
+    tmin = SUN_BIG_REAL;
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (t = 0; t < nt; t++)
     {
-      lmin = N_VMinLocal(MANYVECTOR_SUBVEC(x, i));
-      SUNCheckLastErrNoRet();
-      min = (min < lmin) ? min : lmin;
-
-      /* otherwise, call nvmin and accumulate to overall min */
+      for (i = off[t]; i < off[t + 1]; i++)
+      {
+        /* check for nvminlocal in subvector */
+        if (MANYVECTOR_SUBVEC(x, i)->ops->nvminlocal)
+        {
+          lmin = N_VMinLocal(MANYVECTOR_SUBVEC(x, i));
+
+          /* otherwise, call nvmin and accumulate to overall min */
+        }
+        else { lmin = N_VMin(MANYVECTOR_SUBVEC(x, i)); }
+        tmin = (tmin < lmin) ? tmin : lmin;
+      }
     }
-    else
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
     {
-      lmin = N_VMin(MANYVECTOR_SUBVEC(x, i));
-      SUNCheckLastErrNoRet();
-      min = (min < lmin) ? min : lmin;
+      min = (min < tmin) ? min : tmin;
     }
   }
+  SUNCheckLastErrNoRet();
 
   return (min);
 }
@@ -1138,48 +1340,51 @@ sunrealtype MVAPPEND(N_VWL2Norm)(N_Vector x, N_Vector w)
 sunrealtype MVAPPEND(N_VL1NormLocal)(N_Vector x)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
+  sunindextype i, *off;
+  int t, nt;
   sunrealtype sum;
-#ifdef MANYVECTOR_BUILD_WITH_MPI
-  sunrealtype contrib;
-  int rank;
-#endif
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
   /* initialize output*/
   sum = ZERO;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) reduction(+ : sum) \
+  schedule(static) num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
+  for (t = 0; t < nt; t++)
   {
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
 #ifdef MANYVECTOR_BUILD_WITH_MPI
 
-    /* check for nvl1normlocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvl1normlocal)
-    {
-      sum += N_VL1NormLocal(MANYVECTOR_SUBVEC(x, i));
-      SUNCheckLastErrNoRet();
+      /* check for nvl1normlocal in subvector */
+      if (MANYVECTOR_SUBVEC(x, i)->ops->nvl1normlocal)
+      {
+        sum += N_VL1NormLocal(MANYVECTOR_SUBVEC(x, i));
 
-      /* otherwise, call nvl1norm and root tasks accumulate to overall sum */
-    }
-    else
-    {
-      contrib = N_VL1Norm(MANYVECTOR_SUBVEC(x, i));
-      SUNCheckLastErrNoRet();
-
-      /* get this task's rank in subvector communicator (note: serial
-         subvectors will result in rank==0) */
-      rank = SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i));
-      if (rank < 0) { return (ZERO); }
-      if (rank == 0) { sum += contrib; }
-    }
+        /* otherwise, call nvl1norm and root tasks accumulate to overall sum */
+      }
+      else
+      {
+        sunrealtype contrib = N_VL1Norm(MANYVECTOR_SUBVEC(x, i));
+
+        /* get this task's rank in subvector communicator (note: serial
+           subvectors will result in rank==0) */
+        if (SubvectorMPIRank(MANYVECTOR_SUBVEC(x, i)) == 0) { sum += contrib; }
+      }
 
 #else
 
-    /* accumulate subvector contribution to overall sum */
-    sum += N_VL1Norm(MANYVECTOR_SUBVEC(x, i));
-    SUNCheckLastErrNoRet();
+      /* accumulate subvector contribution to overall sum */
+      sum += N_VL1Norm(MANYVECTOR_SUBVEC(x, i));
 
 #endif
+    }
   }
+  SUNCheckLastErrNoRet();
 
   return (sum);
 }
@@ -1208,12 +1413,24 @@ sunrealtype N_VL1Norm_MPIManyVector(N_Vector x)
 void MVAPPEND(N_VCompare)(sunrealtype c, N_Vector x, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+  sunindextype i, *off;
+  int t, nt;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    N_VCompare(c, MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
-    SUNCheckLastErrVoid();
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      N_VCompare(c, MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
+    }
   }
+  SUNCheckLastErrVoid();
   return;
 }
 
@@ -1227,30 +1444,41 @@ void MVAPPEND(N_VCompare)(sunrealtype c, N_Vector x, N_Vector z)
 sunbooleantype MVAPPEND(N_VInvTestLocal)(N_Vector x, N_Vector z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
+  sunindextype i, *off;
+  int t, nt;
   sunbooleantype val, subval;
 
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
   /* initialize output*/
   val = SUNTRUE;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, subval) \
+  reduction(&& : val) schedule(static) num_threads(nt)          \
+  if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* check for nvinvtestlocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvinvtestlocal)
+    for (i = off[t]; i < off[t + 1]; i++)
     {
-      subval = N_VInvTestLocal(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
-      SUNCheckLastErrNoRet();
-      val = (val && subval);
+      /* check for nvinvtestlocal in subvector */
+      if (MANYVECTOR_SUBVEC(x, i)->ops->nvinvtestlocal)
+      {
+        subval = N_VInvTestLocal(MANYVECTOR_SUBVEC(x, i),
+                                 MANYVECTOR_SUBVEC(z, i));
 
-      /* otherwise, call nvinvtest and accumulate to overall val */
-    }
-    else
-    {
-      subval = N_VInvTest(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
-      SUNCheckLastErrNoRet();
+        /* otherwise, call nvinvtest and accumulate to overall val */
+      }
+      else
+      {
+        subval = N_VInvTest(MANYVECTOR_SUBVEC(x, i), MANYVECTOR_SUBVEC(z, i));
+      }
       val = (val && subval);
     }
   }
+  SUNCheckLastErrNoRet();
 
   return (val);
 }
@@ -1286,33 +1514,43 @@ sunbooleantype N_VInvTest_MPIManyVector(N_Vector x, N_Vector z)
 sunbooleantype MVAPPEND(N_VConstrMaskLocal)(N_Vector c, N_Vector x, N_Vector m)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i;
+  sunindextype i, *off;
+  int t, nt;
   sunbooleantype val, subval;
 
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
+
   /* initialize output*/
   val = SUNTRUE;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, subval) \
+  reduction(&& : val) schedule(static) num_threads(nt)          \
+  if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* check for nvconstrmasklocal in subvector */
-    if (MANYVECTOR_SUBVEC(x, i)->ops->nvconstrmasklocal)
+    for (i = off[t]; i < off[t + 1]; i++)
     {
-      subval = N_VConstrMaskLocal(MANYVECTOR_SUBVEC(c, i),
-                                  MANYVECTOR_SUBVEC(x, i),
-                                  MANYVECTOR_SUBVEC(m, i));
-      SUNCheckLastErrNoRet();
-      val = (val && subval);
+      /* check for nvconstrmasklocal in subvector */
+      if (MANYVECTOR_SUBVEC(x, i)->ops->nvconstrmasklocal)
+      {
+        subval = N_VConstrMaskLocal(MANYVECTOR_SUBVEC(c, i),
+                                    MANYVECTOR_SUBVEC(x, i),
+                                    MANYVECTOR_SUBVEC(m, i));
 
-      /* otherwise, call nvconstrmask and accumulate to overall val */
-    }
-    else
-    {
-      subval = N_VConstrMask(MANYVECTOR_SUBVEC(c, i), MANYVECTOR_SUBVEC(x, i),
-                             MANYVECTOR_SUBVEC(m, i));
-      SUNCheckLastErrNoRet();
+        /* otherwise, call nvconstrmask and accumulate to overall val */
+      }
+      else
+      {
+        subval = N_VConstrMask(MANYVECTOR_SUBVEC(c, i), MANYVECTOR_SUBVEC(x, i),
+                               MANYVECTOR_SUBVEC(m, i));
+      }
       val = (val && subval);
     }
   }
+  SUNCheckLastErrNoRet();
 
   return (val);
 }
@@ -1348,32 +1586,53 @@ sunbooleantype N_VConstrMask_MPIManyVector(N_Vector c, N_Vector x, N_Vector m)
 sunrealtype MVAPPEND(N_VMinQuotientLocal)(N_Vector num, N_Vector denom)
 {
   SUNFunctionBegin(num->sunctx);
-  sunindextype i;
-  sunrealtype min, lmin;
+  sunindextype i, *off;
+  int t, nt;
+  sunrealtype min, tmin, lmin;
+
+  nt  = MANYVECTOR_NUM_THREADS(num);
+  off = MANYVECTOR_OFFSETS(num);
 
   /* initialize output*/
   min = SUN_BIG_REAL;
 
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(num); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel default(shared) private(i, t, tmin, lmin) \
+  num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(num))
+#endif
   {
-    /* check for nvminquotientlocal in subvector */
-    if (MANYVECTOR_SUBVEC(num, i)->ops->nvminquotientlocal)
+    tmin = SUN_BIG_REAL;
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (t = 0; t < nt; t++)
     {
-      lmin = N_VMinQuotientLocal(MANYVECTOR_SUBVEC(num, i),
-                                 MANYVECTOR_SUBVEC(denom, i));
-      SUNCheckLastErrNoRet();
-      min = (min < lmin) ? min : lmin;
-
-      /* otherwise, call nvmin and accumulate to overall min */
+      for (i = off[t]; i < off[t + 1]; i++)
+      {
+        /* check for nvminquotientlocal in subvector */
+        if (MANYVECTOR_SUBVEC(num, i)->ops->nvminquotientlocal)
+        {
+          lmin = N_VMinQuotientLocal(MANYVECTOR_SUBVEC(num, i),
+                                     MANYVECTOR_SUBVEC(denom, i));
+
+          /* otherwise, call nvmin and accumulate to overall min */
+        }
+        else
+        {
+          lmin = N_VMinQuotient(MANYVECTOR_SUBVEC(num, i),
+                                MANYVECTOR_SUBVEC(denom, i));
+        }
+        tmin = (tmin < lmin) ? tmin : lmin;
+      }
     }
-    else
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
     {
-      lmin = N_VMinQuotient(MANYVECTOR_SUBVEC(num, i),
-                            MANYVECTOR_SUBVEC(denom, i));
-      SUNCheckLastErrNoRet();
-      min = (min < lmin) ? min : lmin;
+      min = (min < tmin) ? min : tmin;
     }
   }
+  SUNCheckLastErrNoRet();
 
   return (min);
 }
@@ -1406,40 +1665,77 @@ SUNErrCode MVAPPEND(N_VDotProdMultiLocal)(int nvec, N_Vector x, N_Vector* Y,
                                           sunrealtype* dotprods)
 {
   SUNFunctionBegin(x->sunctx);
-  int j;
-  sunindextype i;
+  int j, t, nt;
+  sunindextype i, *off;
   N_Vector* Ysub;
-  sunrealtype* contrib;
+  sunrealtype *contrib, *tsum;
+  SUNErrCode retval;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
-  /* create temporary workspace arrays */
+  /* create temporary workspace arrays for each thread */
   Ysub = NULL;
-  Ysub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Ysub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Ysub, SUN_ERR_MALLOC_FAIL);
 
   contrib = NULL;
-  contrib = (sunrealtype*)malloc(nvec * sizeof(sunrealtype));
+  contrib = (sunrealtype*)malloc(2 * nt * nvec * sizeof(sunrealtype));
   SUNAssert(contrib, SUN_ERR_MALLOC_FAIL);
+  tsum = contrib + nt * nvec;
 
-  /* initialize output */
-  for (j = 0; j < nvec; j++) { dotprods[j] = ZERO; }
+  /* initialize the sums of each thread */
+  for (j = 0; j < nt * nvec; j++) { tsum[j] = ZERO; }
+
+  retval = SUN_SUCCESS;
 
   /* loop over subvectors */
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, j) schedule(static) \
+  num_threads(nt) if (nt > 1 && MANYVECTOR_THREAD_RED(x))
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* extract subvectors from vector array */
-    for (j = 0; j < nvec; j++) { Ysub[j] = MANYVECTOR_SUBVEC(Y[j], i); }
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      /* extract subvectors from vector array */
+      for (j = 0; j < nvec; j++)
+      {
+        Ysub[t * nvec + j] = MANYVECTOR_SUBVEC(Y[j], i);
+      }
+
+      /* compute dot products */
+      SUNErrCode ierr = N_VDotProdMultiLocal(nvec, MANYVECTOR_SUBVEC(x, i),
+                                             Ysub + t * nvec,
+                                             contrib + t * nvec);
+      if (ierr != SUN_SUCCESS)
+      {
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
+        retval = ierr;
+      }
 
-    /* compute dot products */
-    SUNCheckCall(
-      N_VDotProdMultiLocal(nvec, MANYVECTOR_SUBVEC(x, i), Ysub, contrib));
+      /* accumulate contributions */
+      for (j = 0; j < nvec; j++)
+      {
+        tsum[t * nvec + j] += contrib[t * nvec + j];
+      }
+    }
+  }
 
-    /* accumulate contributions */
-    for (j = 0; j < nvec; j++) { dotprods[j] += contrib[j]; }
+  /* combine the sums of the threads */
+  for (j = 0; j < nvec; j++)
+  {
+    dotprods[j] = ZERO;
+    for (t = 0; t < nt; t++) { dotprods[j] += tsum[t * nvec + j]; }
   }
 
   free(Ysub);
   free(contrib);
 
+  SUNCheckCall(retval);
+
   /* return with success */
   return SUN_SUCCESS;
 }
@@ -1477,26 +1773,52 @@ SUNErrCode MVAPPEND(N_VLinearCombination)(int nvec, sunrealtype* c, N_Vector* X,
                                           N_Vector z)
 {
   SUNFunctionBegin(z->sunctx);
-  sunindextype i, j;
+  sunindextype i, j, *off;
+  int t, nt;
   N_Vector* Xsub;
+  SUNErrCode retval;
+
+  nt  = MANYVECTOR_NUM_THREADS(z);
+  off = MANYVECTOR_OFFSETS(z);
 
-  /* create array of nvec N_Vector pointers for reuse within loop */
+  /* create arrays of nvec N_Vector pointers for each thread */
   Xsub = NULL;
-  Xsub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Xsub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Xsub, SUN_ERR_MALLOC_FAIL);
 
+  retval = SUN_SUCCESS;
+
   /* perform operation by calling N_VLinearCombination for each subvector */
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(z); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, j) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* for each subvector, create the array of subvectors of X */
-    for (j = 0; j < nvec; j++) { Xsub[j] = MANYVECTOR_SUBVEC(X[j], i); }
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      /* for each subvector, create the array of subvectors of X */
+      for (j = 0; j < nvec; j++)
+      {
+        Xsub[t * nvec + j] = MANYVECTOR_SUBVEC(X[j], i);
+      }
 
-    /* now call N_VLinearCombination for this array of subvectors */
-    SUNCheckCall(N_VLinearCombination(nvec, c, Xsub, MANYVECTOR_SUBVEC(z, i)));
+      /* now call N_VLinearCombination for this array of subvectors */
+      SUNErrCode ierr = N_VLinearCombination(nvec, c, Xsub + t * nvec,
+                                             MANYVECTOR_SUBVEC(z, i));
+      if (ierr != SUN_SUCCESS)
+      {
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
+        retval = ierr;
+      }
+    }
   }
 
   /* clean up and return */
   free(Xsub);
+  SUNCheckCall(retval);
   return SUN_SUCCESS;
 }
 
@@ -1513,33 +1835,57 @@ SUNErrCode MVAPPEND(N_VScaleAddMulti)(int nvec, sunrealtype* a, N_Vector x,
                                       N_Vector* Y, N_Vector* Z)
 {
   SUNFunctionBegin(x->sunctx);
-  sunindextype i, j;
+  sunindextype i, j, *off;
+  int t, nt;
   N_Vector *Ysub, *Zsub;
+  SUNErrCode retval;
+
+  nt  = MANYVECTOR_NUM_THREADS(x);
+  off = MANYVECTOR_OFFSETS(x);
 
-  /* create arrays of nvec N_Vector pointers for reuse within loop */
-  Ysub = Zsub = NULL;
-  Ysub        = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  /* create arrays of nvec N_Vector pointers for each thread */
+  Ysub = NULL;
+  Ysub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Ysub, SUN_ERR_MALLOC_FAIL);
-  Zsub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Zsub = NULL;
+  Zsub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Zsub, SUN_ERR_MALLOC_FAIL);
 
+  retval = SUN_SUCCESS;
+
   /* perform operation by calling N_VScaleAddMulti for each subvector */
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(x); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, j) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* for each subvector, create the array of subvectors of Y and Z */
-    for (j = 0; j < nvec; j++)
+    for (i = off[t]; i < off[t + 1]; i++)
     {
-      Ysub[j] = MANYVECTOR_SUBVEC(Y[j], i);
-      Zsub[j] = MANYVECTOR_SUBVEC(Z[j], i);
-    }
+      /* for each subvector, create the array of subvectors of Y and Z */
+      for (j = 0; j < nvec; j++)
+      {
+        Ysub[t * nvec + j] = MANYVECTOR_SUBVEC(Y[j], i);
+        Zsub[t * nvec + j] = MANYVECTOR_SUBVEC(Z[j], i);
+      }
 
-    /* now call N_VScaleAddMulti for this array of subvectors */
-    SUNCheckCall(N_VScaleAddMulti(nvec, a, MANYVECTOR_SUBVEC(x, i), Ysub, Zsub));
+      /* now call N_VScaleAddMulti for this array of subvectors */
+      SUNErrCode ierr = N_VScaleAddMulti(nvec, a, MANYVECTOR_SUBVEC(x, i),
+                                         Ysub + t * nvec, Zsub + t * nvec);
+      if (ierr != SUN_SUCCESS)
+      {
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
+        retval = ierr;
+      }
+    }
   }
 
   /* clean up and return */
   free(Ysub);
   free(Zsub);
+  SUNCheckCall(retval);
   return SUN_SUCCESS;
 }
 
@@ -1595,41 +1941,65 @@ SUNErrCode MVAPPEND(N_VLinearSumVectorArray)(int nvec, sunrealtype a,
                                              N_Vector* Y, N_Vector* Z)
 {
   SUNFunctionBegin(X[0]->sunctx);
-  sunindextype i, j;
+  sunindextype i, j, *off;
+  int t, nt;
   N_Vector *Xsub, *Ysub, *Zsub;
+  SUNErrCode retval;
 
   SUNAssert(nvec > 0, SUN_ERR_ARG_OUTOFRANGE);
 
-  /* create arrays of nvec N_Vector pointers for reuse within loop */
+  nt  = MANYVECTOR_NUM_THREADS(X[0]);
+  off = MANYVECTOR_OFFSETS(X[0]);
+
+  /* create arrays of nvec N_Vector pointers for each thread */
   Xsub = NULL;
-  Ysub = NULL;
-  Zsub = NULL;
-  Xsub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Xsub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Xsub, SUN_ERR_MALLOC_FAIL);
-  Ysub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Ysub = NULL;
+  Ysub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Ysub, SUN_ERR_MALLOC_FAIL);
-  Zsub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Zsub = NULL;
+  Zsub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Zsub, SUN_ERR_MALLOC_FAIL);
 
+  retval = SUN_SUCCESS;
+
   /* perform operation by calling N_VLinearSumVectorArray for each subvector */
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(X[0]); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, j) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* for each subvector, create the array of subvectors of X, Y and Z */
-    for (j = 0; j < nvec; j++)
+    for (i = off[t]; i < off[t + 1]; i++)
     {
-      Xsub[j] = MANYVECTOR_SUBVEC(X[j], i);
-      Ysub[j] = MANYVECTOR_SUBVEC(Y[j], i);
-      Zsub[j] = MANYVECTOR_SUBVEC(Z[j], i);
-    }
+      /* for each subvector, create the array of subvectors of X, Y and Z */
+      for (j = 0; j < nvec; j++)
+      {
+        Xsub[t * nvec + j] = MANYVECTOR_SUBVEC(X[j], i);
+        Ysub[t * nvec + j] = MANYVECTOR_SUBVEC(Y[j], i);
+        Zsub[t * nvec + j] = MANYVECTOR_SUBVEC(Z[j], i);
+      }
 
-    /* now call N_VLinearSumVectorArray for this array of subvectors */
-    SUNCheckCall(N_VLinearSumVectorArray(nvec, a, Xsub, b, Ysub, Zsub));
+      /* now call N_VLinearSumVectorArray for this array of subvectors */
+      SUNErrCode ierr = N_VLinearSumVectorArray(nvec, a, Xsub + t * nvec, b,
+                                                Ysub + t * nvec,
+                                                Zsub + t * nvec);
+      if (ierr != SUN_SUCCESS)
+      {
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
+        retval = ierr;
+      }
+    }
   }
 
   /* clean up and return */
   free(Xsub);
   free(Ysub);
   free(Zsub);
+  SUNCheckCall(retval);
   return SUN_SUCCESS;
 }
 
@@ -1646,36 +2016,59 @@ SUNErrCode MVAPPEND(N_VScaleVectorArray)(int nvec, sunrealtype* c, N_Vector* X,
                                          N_Vector* Z)
 {
   SUNFunctionBegin(X[0]->sunctx);
-  sunindextype i, j;
+  sunindextype i, j, *off;
+  int t, nt;
   N_Vector *Xsub, *Zsub;
+  SUNErrCode retval;
 
   SUNAssert(nvec > 0, SUN_ERR_ARG_OUTOFRANGE);
 
-  /* create arrays of nvec N_Vector pointers for reuse within loop */
+  nt  = MANYVECTOR_NUM_THREADS(X[0]);
+  off = MANYVECTOR_OFFSETS(X[0]);
+
+  /* create arrays of nvec N_Vector pointers for each thread */
   Xsub = NULL;
-  Zsub = NULL;
-  Xsub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Xsub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Xsub, SUN_ERR_MALLOC_FAIL);
-  Zsub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Zsub = NULL;
+  Zsub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Zsub, SUN_ERR_MALLOC_FAIL);
 
+  retval = SUN_SUCCESS;
+
   /* perform operation by calling N_VScaleVectorArray for each subvector */
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(X[0]); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, j) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* for each subvector, create the array of subvectors of X, Y and Z */
-    for (j = 0; j < nvec; j++)
+    for (i = off[t]; i < off[t + 1]; i++)
     {
-      Xsub[j] = MANYVECTOR_SUBVEC(X[j], i);
-      Zsub[j] = MANYVECTOR_SUBVEC(Z[j], i);
-    }
+      /* for each subvector, create the array of subvectors of X and Z */
+      for (j = 0; j < nvec; j++)
+      {
+        Xsub[t * nvec + j] = MANYVECTOR_SUBVEC(X[j], i);
+        Zsub[t * nvec + j] = MANYVECTOR_SUBVEC(Z[j], i);
+      }
 
-    /* now call N_VScaleVectorArray for this array of subvectors */
-    SUNCheckCall(N_VScaleVectorArray(nvec, c, Xsub, Zsub));
+      /* now call N_VScaleVectorArray for this array of subvectors */
+      SUNErrCode ierr = N_VScaleVectorArray(nvec, c, Xsub + t * nvec,
+                                            Zsub + t * nvec);
+      if (ierr != SUN_SUCCESS)
+      {
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
+        retval = ierr;
+      }
+    }
   }
 
   /* clean up and return */
   free(Xsub);
   free(Zsub);
+  SUNCheckCall(retval);
   return SUN_SUCCESS;
 }
 
@@ -1689,28 +2082,53 @@ SUNErrCode MVAPPEND(N_VScaleVectorArray)(int nvec, sunrealtype* c, N_Vector* X,
 SUNErrCode MVAPPEND(N_VConstVectorArray)(int nvec, sunrealtype c, N_Vector* Z)
 {
   SUNFunctionBegin(Z[0]->sunctx);
-  sunindextype i, j;
+  sunindextype i, j, *off;
+  int t, nt;
   N_Vector* Zsub;
+  SUNErrCode retval;
 
   SUNAssert(nvec > 0, SUN_ERR_ARG_OUTOFRANGE);
 
-  /* create array of N_Vector pointers for reuse within loop */
+  nt  = MANYVECTOR_NUM_THREADS(Z[0]);
+  off = MANYVECTOR_OFFSETS(Z[0]);
+
+  /* create arrays of nvec N_Vector pointers for each thread */
   Zsub = NULL;
-  Zsub = (N_Vector*)malloc(nvec * sizeof(N_Vector));
+  Zsub = (N_Vector*)malloc(nt * nvec * sizeof(N_Vector));
   SUNAssert(Zsub, SUN_ERR_MALLOC_FAIL);
 
+  retval = SUN_SUCCESS;
+
   /* perform operation by calling N_VConstVectorArray for each subvector */
-  for (i = 0; i < MANYVECTOR_NUM_SUBVECS(Z[0]); i++)
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp parallel for default(shared) private(i, j) schedule(static) \
+  num_threads(nt) if (nt > 1)
+#endif
+  for (t = 0; t < nt; t++)
   {
-    /* for each subvector, create the array of subvectors of X, Y and Z */
-    for (j = 0; j < nvec; j++) { Zsub[j] = MANYVECTOR_SUBVEC(Z[j], i); }
+    for (i = off[t]; i < off[t + 1]; i++)
+    {
+      /* for each subvector, create the array of subvectors of Z */
+      for (j = 0; j < nvec; j++)
+      {
+        Zsub[t * nvec + j] = MANYVECTOR_SUBVEC(Z[j], i);
+      }
 
-    /* now call N_VConstVectorArray for this array of subvectors */
-    SUNCheckCall(N_VConstVectorArray(nvec, c, Zsub));
+      /* now call N_VConstVectorArray for this array of subvectors */
+      SUNErrCode ierr = N_VConstVectorArray(nvec, c, Zsub + t * nvec);
+      if (ierr != SUN_SUCCESS)
+      {
+#ifdef MANYVECTOR_USE_OPENMP
+#pragma omp critical
+#endif
+        retval = ierr;
+      }
+    }
   }
 
   /* clean up and return */
   free(Zsub);
+  SUNCheckCall(retval);
   return SUN_SUCCESS;
 }
 
@@ -2037,6 +2455,7 @@ static N_Vector ManyVectorClone(N_Vector w, sunbooleantype cloneempty)
   N_Vector v;
   MVAPPEND(N_VectorContent) content;
   sunindextype i;
+  int t;
 
   /* Create vector */
   v = NULL;
@@ -2060,9 +2479,22 @@ static N_Vector ManyVectorClone(N_Vector w, sunbooleantype cloneempty)
 #ifdef MANYVECTOR_BUILD_WITH_MPI
   content->comm = MPI_COMM_NULL;
 #endif
-  content->num_subvectors = MANYVECTOR_NUM_SUBVECS(w);
-  content->global_length  = MANYVECTOR_GLOBLENGTH(w);
-  content->own_data       = SUNTRUE;
+  content->num_subvectors    = MANYVECTOR_NUM_SUBVECS(w);
+  content->global_length     = MANYVECTOR_GLOBLENGTH(w);
+  content->own_data          = SUNTRUE;
+  content->num_threads       = MANYVECTOR_NUM_THREADS(w);
+  content->thread_reductions = MANYVECTOR_THREAD_RED(w);
+
+  /* Copy the thread partition */
+  content->thread_offsets = NULL;
+  content->thread_offsets =
+    (sunindextype*)malloc((content->num_threads + 1) * sizeof(sunindextype));
+  SUNAssertNull(content->thread_offsets, SUN_ERR_MALLOC_FAIL);
+
+  for (t = 0; t <= content->num_threads; t++)
+  {
+    content->thread_offsets[t] = MANYVECTOR_OFFSETS(w)[t];
+  }
 
   /* Allocate the subvector array */
   content->subvec_array = NULL;
@@ -2102,6 +2534,92 @@ static N_Vector ManyVectorClone(N_Vector w, sunbooleantype cloneempty)
   return (v);
 }
 
+/* This function splits the subvectors of v into num_threads groups of
+   consecutive subvectors, one for each thread. Each group ends at the
+   subvector boundary nearest to its share of the total local length, and
+   every group holds at least one subvector. It also determines whether the
+   reductions may be computed by the threads, which requires that no
+   subvector communicates in the reductions called by the ManyVector. */
+static SUNErrCode ManyVectorPartition(N_Vector v, int num_threads)
+{
+  SUNFunctionBegin(v->sunctx);
+  sunindextype i, nsub, *offsets;
+  sunrealtype total, sum, target;
+  sunbooleantype reductions;
+  N_Vector sv;
+  int t;
+
+  nsub = MANYVECTOR_NUM_SUBVECS(v);
+
+  offsets = NULL;
+  offsets = (sunindextype*)malloc((num_threads + 1) * sizeof(sunindextype));
+  SUNAssert(offsets, SUN_ERR_MALLOC_FAIL);
+
+  /* total local length of the subvectors */
+  total = ZERO;
+  for (i = 0; i < nsub; i++)
+  {
+    total += SubvectorLocalLength(MANYVECTOR_SUBVEC(v, i));
+  }
+
+  /* assign subvectors to each group until its share of the total is reached,
+     leaving at least one subvector for each of the remaining groups */
+  offsets[0] = 0;
+  sum        = ZERO;
+  i          = 0;
+  for (t = 1; t < num_threads; t++)
+  {
+    target = total * t / num_threads;
+    sum += SubvectorLocalLength(MANYVECTOR_SUBVEC(v, i));
+    i++;
+    while ((i < nsub - (num_threads - t)) &&
+           (sum + SubvectorLocalLength(MANYVECTOR_SUBVEC(v, i)) / 2 <= target))
+    {
+      sum += SubvectorLocalLength(MANYVECTOR_SUBVEC(v, i));
+      i++;
+    }
+    offsets[t] = i;
+  }
+  offsets[num_threads] = nsub;
+
+  /* subvectors without a communicator only perform local reductions */
+  reductions = SUNTRUE;
+  for (i = 0; i < nsub; i++)
+  {
+    sv = MANYVECTOR_SUBVEC(v, i);
+    if (N_VGetCommunicator(sv) == SUN_COMM_NULL) { continue; }
+#ifdef MANYVECTOR_BUILD_WITH_MPI
+    /* the MPIManyVector only calls the local reductions if available */
+    if (sv->ops->nvdotprodlocal && sv->ops->nvmaxnormlocal &&
+        sv->ops->nvminlocal && sv->ops->nvl1normlocal &&
+        sv->ops->nvinvtestlocal && sv->ops->nvconstrmasklocal &&
+        sv->ops->nvminquotientlocal && sv->ops->nvwsqrsumlocal &&
+        sv->ops->nvwsqrsummasklocal && sv->ops->nvdotprodmultilocal)
+    {
+      continue;
+    }
+#endif
+    reductions = SUNFALSE;
+  }
+
+  /* replace the previous partition */
+  free(MANYVECTOR_OFFSETS(v));
+  MANYVECTOR_OFFSETS(v)     = offsets;
+  MANYVECTOR_NUM_THREADS(v) = num_threads;
+  MANYVECTOR_THREAD_RED(v)  = reductions;
+
+  return SUN_SUCCESS;
+}
+
+/* This function returns the length of the data of x stored by this task, used
+   to balance the work of the threads. */
+static sunrealtype SubvectorLocalLength(N_Vector x)
+{
+  if (x->ops->nvgetlocallength) { return ((sunrealtype)N_VGetLocalLength(x)); }
+  if (x->ops->nvgetlength) { return ((sunrealtype)N_VGetLength(x)); }
+  return (ONE);
+}
+
 #ifdef MANYVECTOR_BUILD_WITH_MPI
 /* This function returns the rank of this task in the MPI communicator
    associated with the input N_Vector.  If the input N_Vector is MPI-unaware, it
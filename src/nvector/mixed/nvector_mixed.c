@@ -0,0 +1,1290 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the mixed-precision
+ * implementation of the NVECTOR module. The data is stored as
+ * float and every operation loads it into the working precision
+ * mxreal, computes in that precision, and rounds the result once
+ * when storing it. The sums of the reductions are accumulated in
+ * mxreal as well.
+ *
+ * The fused operations process the vectors in blocks of
+ * MIXED_BLOCK elements so that each input is converted once per
+ * call and the linear combinations are rounded to float once,
+ * instead of once per term.
+ * -----------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <nvector/nvector_mixed.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_math.h>
+
+#include "sundials_macros.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define ZERO   SUN_RCONST(0.0)
+#define HALF   SUN_RCONST(0.5)
+#define ONE    SUN_RCONST(1.0)
+#define ONEPT5 SUN_RCONST(1.5)
+
+/* Working precision of the operations: sunrealtype, but at least double so
+   that single precision builds also accumulate the reductions in double */
+#if defined(SUNDIALS_SINGLE_PRECISION)
+typedef double mxreal;
+#else
+typedef sunrealtype mxreal;
+#endif
+
+/* Number of elements processed at a time by the fused operations */
+#define MIXED_BLOCK 512
+
+/* Private function to allocate the data array of a vector */
+static float* VAllocData_Mixed(sunindextype N);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------
+ * Returns vector type ID. Used to identify vector implementation
+ * from abstract N_Vector interface.
+ */
+N_Vector_ID N_VGetVectorID_Mixed(SUNDIALS_MAYBE_UNUSED N_Vector v)
+{
+  return SUNDIALS_NVEC_MIXED;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new empty vector
+ */
+
+N_Vector N_VNewEmpty_Mixed(sunindextype length, SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  N_Vector v;
+  N_VectorContent_Mixed content;
+
+  SUNAssertNull(length >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  /* Create vector */
+  v = NULL;
+  v = N_VNewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+
+  /* constructors, destructors, and utility operations; the data is not a
+     sunrealtype array so the array pointer operations are not provided */
+  v->ops->nvgetvectorid    = N_VGetVectorID_Mixed;
+  v->ops->nvclone          = N_VClone_Mixed;
+  v->ops->nvcloneempty     = N_VCloneEmpty_Mixed;
+  v->ops->nvdestroy        = N_VDestroy_Mixed;
+  v->ops->nvspace          = N_VSpace_Mixed;
+  v->ops->nvgetlength      = N_VGetLength_Mixed;
+  v->ops->nvgetlocallength = N_VGetLength_Mixed;
+
+  /* standard vector operations */
+  v->ops->nvlinearsum    = N_VLinearSum_Mixed;
+  v->ops->nvconst        = N_VConst_Mixed;
+  v->ops->nvprod         = N_VProd_Mixed;
+  v->ops->nvdiv          = N_VDiv_Mixed;
+  v->ops->nvscale        = N_VScale_Mixed;
+  v->ops->nvabs          = N_VAbs_Mixed;
+  v->ops->nvinv          = N_VInv_Mixed;
+  v->ops->nvaddconst     = N_VAddConst_Mixed;
+  v->ops->nvdotprod      = N_VDotProd_Mixed;
+  v->ops->nvmaxnorm      = N_VMaxNorm_Mixed;
+  v->ops->nvwrmsnormmask = N_VWrmsNormMask_Mixed;
+  v->ops->nvwrmsnorm     = N_VWrmsNorm_Mixed;
+  v->ops->nvmin          = N_VMin_Mixed;
+  v->ops->nvwl2norm      = N_VWL2Norm_Mixed;
+  v->ops->nvl1norm       = N_VL1Norm_Mixed;
+  v->ops->nvcompare      = N_VCompare_Mixed;
+  v->ops->nvinvtest      = N_VInvTest_Mixed;
+  v->ops->nvconstrmask   = N_VConstrMask_Mixed;
+  v->ops->nvminquotient  = N_VMinQuotient_Mixed;
+
+  /* fused vector operations are disabled (NULL) by default */
+
+  /* local reduction kernels */
+  v->ops->nvdotprodlocal     = N_VDotProd_Mixed;
+  v->ops->nvmaxnormlocal     = N_VMaxNorm_Mixed;
+  v->ops->nvminlocal         = N_VMin_Mixed;
+  v->ops->nvl1normlocal      = N_VL1Norm_Mixed;
+  v->ops->nvinvtestlocal     = N_VInvTest_Mixed;
+  v->ops->nvconstrmasklocal  = N_VConstrMask_Mixed;
+  v->ops->nvminquotientlocal = N_VMinQuotient_Mixed;
+  v->ops->nvwsqrsumlocal     = N_VWSqrSumLocal_Mixed;
+  v->ops->nvwsqrsummasklocal = N_VWSqrSumMaskLocal_Mixed;
+
+  /* single buffer reduction operations */
+  v->ops->nvdotprodmultilocal = N_VDotProdMulti_Mixed;
+
+  /* XBraid interface operations */
+  v->ops->nvbufsize   = N_VBufSize_Mixed;
+  v->ops->nvbufpack   = N_VBufPack_Mixed;
+  v->ops->nvbufunpack = N_VBufUnpack_Mixed;
+
+  /* debugging functions */
+  v->ops->nvprint     = N_VPrint_Mixed;
+  v->ops->nvprintfile = N_VPrintFile_Mixed;
+
+  /* Create content */
+  content = NULL;
+  content = (N_VectorContent_Mixed)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach content */
+  v->content = content;
+
+  /* Initialize content */
+  content->length      = length;
+  content->own_data    = SUNFALSE;
+  content->data        = NULL;
+  content->num_threads = 1;
+
+  return (v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new vector
+ */
+
+N_Vector N_VNew_Mixed(sunindextype length, SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  N_Vector v;
+  float* data;
+
+  SUNAssertNull(length >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  v = NULL;
+  v = N_VNewEmpty_Mixed(length, sunctx);
+  SUNCheckLastErrNull();
+
+  /* Create data */
+  data = NULL;
+  if (length > 0)
+  {
+    data = VAllocData_Mixed(length);
+    SUNAssertNull(data, SUN_ERR_MALLOC_FAIL);
+
+    /* Attach data */
+    NV_OWN_DATA_MX(v) = SUNTRUE;
+    NV_DATA_MX(v)     = data;
+  }
+
+  return (v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a vector with user data component
+ */
+
+N_Vector N_VMake_Mixed(sunindextype length, float* v_data, SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  N_Vector v;
+
+  SUNAssertNull(length >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  v = NULL;
+  v = N_VNewEmpty_Mixed(length, sunctx);
+  SUNCheckLastErrNull();
+
+  if (length > 0)
+  {
+    /* Attach data */
+    NV_OWN_DATA_MX(v) = SUNFALSE;
+    NV_DATA_MX(v)     = v_data;
+  }
+
+  return (v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to return number of vector elements
+ */
+sunindextype N_VGetLength_Mixed(N_Vector v) { return NV_LENGTH_MX(v); }
+
+/* ----------------------------------------------------------------------------
+ * Function to print a vector to stdout
+ */
+
+void N_VPrint_Mixed(N_Vector x) { N_VPrintFile_Mixed(x, stdout); }
+
+/* ----------------------------------------------------------------------------
+ * Function to print a vector to outfile
+ */
+
+void N_VPrintFile_Mixed(N_Vector x, FILE* outfile)
+{
+  sunindextype i, N;
+  float* xd;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+
+  for (i = 0; i < N; i++) { fprintf(outfile, "%11.8g\n", (double)xd[i]); }
+  fprintf(outfile, "\n");
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Return the single precision data array of the vector
+ */
+
+float* N_VGetFloatArrayPointer_Mixed(N_Vector v) { return NV_DATA_MX(v); }
+
+/* ----------------------------------------------------------------------------
+ * Attach a single precision data array to the vector
+ */
+
+void N_VSetFloatArrayPointer_Mixed(float* v_data, N_Vector v)
+{
+  if (NV_LENGTH_MX(v) > 0) { NV_DATA_MX(v) = v_data; }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Copy the vector into the sunrealtype array v_data of the same length
+ */
+
+SUNErrCode N_VCopyToArray_Mixed(N_Vector v, sunrealtype* v_data)
+{
+  SUNFunctionBegin(v->sunctx);
+  sunindextype i, N;
+  float* xd;
+
+  SUNAssert(v_data || NV_LENGTH_MX(v) == 0, SUN_ERR_ARG_CORRUPT);
+
+  N  = NV_LENGTH_MX(v);
+  xd = NV_DATA_MX(v);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(v)) if (parallel : NV_NUM_THREADS_MX(v) > 1)
+#endif
+  for (i = 0; i < N; i++) { v_data[i] = (sunrealtype)xd[i]; }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Round the sunrealtype array v_data of the same length into the vector
+ */
+
+SUNErrCode N_VCopyFromArray_Mixed(const sunrealtype* v_data, N_Vector v)
+{
+  SUNFunctionBegin(v->sunctx);
+  sunindextype i, N;
+  float* zd;
+
+  SUNAssert(v_data || NV_LENGTH_MX(v) == 0, SUN_ERR_ARG_CORRUPT);
+
+  N  = NV_LENGTH_MX(v);
+  zd = NV_DATA_MX(v);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(v)) if (parallel : NV_NUM_THREADS_MX(v) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = (float)v_data[i]; }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Set the number of OpenMP threads used by the operations of the vector and
+ * of vectors cloned from it. Without OpenMP the operations are serial.
+ */
+
+SUNErrCode N_VSetNumThreads_Mixed(N_Vector v, int num_threads)
+{
+  SUNFunctionBegin(v->sunctx);
+
+  SUNAssert(num_threads >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  NV_NUM_THREADS_MX(v) = num_threads;
+
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of vector operations
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Create new vector from existing vector without attaching data
+ */
+
+N_Vector N_VCloneEmpty_Mixed(N_Vector w)
+{
+  N_Vector v;
+  N_VectorContent_Mixed content;
+
+  SUNFunctionBegin(w->sunctx);
+
+  /* Create vector */
+  v = NULL;
+  v = N_VNewEmpty(w->sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+  SUNCheckCallNull(N_VCopyOps(w, v));
+
+  /* Create content */
+  content = NULL;
+  content = (N_VectorContent_Mixed)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach content */
+  v->content = content;
+
+  /* Initialize content */
+  content->length      = NV_LENGTH_MX(w);
+  content->own_data    = SUNFALSE;
+  content->data        = NULL;
+  content->num_threads = NV_NUM_THREADS_MX(w);
+
+  return (v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Create new vector from existing vector and attach data
+ */
+
+N_Vector N_VClone_Mixed(N_Vector w)
+{
+  SUNFunctionBegin(w->sunctx);
+  N_Vector v;
+  float* data;
+  sunindextype length;
+
+  v = NULL;
+  v = N_VCloneEmpty_Mixed(w);
+  SUNCheckLastErrNull();
+
+  length = NV_LENGTH_MX(w);
+
+  /* Create data */
+  data = NULL;
+  if (length > 0)
+  {
+    data = VAllocData_Mixed(length);
+    SUNAssertNull(data, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /* Attach data */
+  NV_OWN_DATA_MX(v) = SUNTRUE;
+  NV_DATA_MX(v)     = data;
+
+  return (v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Destroy vector and free vector memory
+ */
+
+void N_VDestroy_Mixed(N_Vector v)
+{
+  if (v == NULL) { return; }
+
+  /* free content */
+  if (v->content != NULL)
+  {
+    /* free data array if it's owned by the vector */
+    if (NV_OWN_DATA_MX(v) && NV_DATA_MX(v) != NULL)
+    {
+      free(NV_DATA_MX(v));
+      NV_DATA_MX(v) = NULL;
+    }
+    free(v->content);
+    v->content = NULL;
+  }
+
+  /* free ops and vector */
+  if (v->ops != NULL)
+  {
+    free(v->ops);
+    v->ops = NULL;
+  }
+  free(v);
+  v = NULL;
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Get storage requirement for N_Vector, the data array is counted in units of
+ * sunrealtype words
+ */
+
+void N_VSpace_Mixed(N_Vector v, sunindextype* lrw, sunindextype* liw)
+{
+  SUNFunctionBegin(v->sunctx);
+
+  SUNAssertVoid(lrw, SUN_ERR_ARG_CORRUPT);
+  SUNAssertVoid(liw, SUN_ERR_ARG_CORRUPT);
+
+  *lrw = (NV_LENGTH_MX(v) * (sunindextype)sizeof(float) +
+          (sunindextype)sizeof(sunrealtype) - 1) /
+         (sunindextype)sizeof(sunrealtype);
+  *liw = 2;
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute linear combination z[i] = a*x[i]+b*y[i]
+ */
+
+void N_VLinearSum_Mixed(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
+                        N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *yd, *zd;
+  mxreal ma, mb;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  yd = NV_DATA_MX(y);
+  zd = NV_DATA_MX(z);
+  ma = (mxreal)a;
+  mb = (mxreal)b;
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++)
+  {
+    zd[i] = (float)(ma * (mxreal)xd[i] + mb * (mxreal)yd[i]);
+  }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Assigns constant value to all vector elements, z[i] = c
+ */
+
+void N_VConst_Mixed(sunrealtype c, N_Vector z)
+{
+  sunindextype i, N;
+  float *zd, fc;
+
+  N  = NV_LENGTH_MX(z);
+  zd = NV_DATA_MX(z);
+  fc = (float)c;
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(z)) if (parallel : NV_NUM_THREADS_MX(z) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = fc; }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise product z[i] = x[i]*y[i]
+ */
+
+void N_VProd_Mixed(N_Vector x, N_Vector y, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *yd, *zd;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  yd = NV_DATA_MX(y);
+  zd = NV_DATA_MX(z);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = (float)((mxreal)xd[i] * (mxreal)yd[i]); }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise division z[i] = x[i]/y[i]
+ */
+
+void N_VDiv_Mixed(N_Vector x, N_Vector y, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *yd, *zd;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  yd = NV_DATA_MX(y);
+  zd = NV_DATA_MX(z);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = (float)((mxreal)xd[i] / (mxreal)yd[i]); }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute scaler multiplication z[i] = c*x[i]
+ */
+
+void N_VScale_Mixed(sunrealtype c, N_Vector x, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *zd;
+  mxreal mc;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  zd = NV_DATA_MX(z);
+  mc = (mxreal)c;
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = (float)(mc * (mxreal)xd[i]); }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute absolute value of vector components z[i] = SUNRabs(x[i])
+ */
+
+void N_VAbs_Mixed(N_Vector x, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *zd;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  zd = NV_DATA_MX(z);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = fabsf(xd[i]); }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise inverse z[i] = 1 / x[i]
+ */
+
+void N_VInv_Mixed(N_Vector x, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *zd;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  zd = NV_DATA_MX(z);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = (float)(ONE / (mxreal)xd[i]); }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise addition of a scaler to a vector z[i] = x[i] + b
+ */
+
+void N_VAddConst_Mixed(N_Vector x, sunrealtype b, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *zd;
+  mxreal mb;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  zd = NV_DATA_MX(z);
+  mb = (mxreal)b;
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { zd[i] = (float)((mxreal)xd[i] + mb); }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes the dot product of two vectors, a = sum(x[i]*y[i])
+ */
+
+sunrealtype N_VDotProd_Mixed(N_Vector x, N_Vector y)
+{
+  sunindextype i, N;
+  float *xd, *yd;
+  mxreal sum;
+
+  sum = ZERO;
+  N   = NV_LENGTH_MX(x);
+  xd  = NV_DATA_MX(x);
+  yd  = NV_DATA_MX(y);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(+ : sum) num_threads(NV_NUM_THREADS_MX(x))               \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { sum += (mxreal)xd[i] * (mxreal)yd[i]; }
+
+  return ((sunrealtype)sum);
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes max norm of a vector
+ */
+
+sunrealtype N_VMaxNorm_Mixed(N_Vector x)
+{
+  sunindextype i, N;
+  float* xd;
+  mxreal max;
+
+  max = ZERO;
+  N   = NV_LENGTH_MX(x);
+  xd  = NV_DATA_MX(x);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(max : max) num_threads(NV_NUM_THREADS_MX(x))                \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++)
+  {
+    mxreal absx = SUNRabs((mxreal)xd[i]);
+    max         = (absx > max) ? absx : max;
+  }
+
+  return ((sunrealtype)max);
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted root mean square norm of a vector
+ */
+
+sunrealtype N_VWrmsNorm_Mixed(N_Vector x, N_Vector w)
+{
+  SUNFunctionBegin(x->sunctx);
+  sunrealtype sqr_sum = N_VWSqrSumLocal_Mixed(x, w);
+  SUNCheckLastErrNoRet();
+  return (SUNRsqrt(sqr_sum / (NV_LENGTH_MX(x))));
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted root mean square norm of a masked vector
+ */
+
+sunrealtype N_VWrmsNormMask_Mixed(N_Vector x, N_Vector w, N_Vector id)
+{
+  SUNFunctionBegin(x->sunctx);
+  sunrealtype sqr_sum = N_VWSqrSumMaskLocal_Mixed(x, w, id);
+  SUNCheckLastErrNoRet();
+  return (SUNRsqrt(sqr_sum / (NV_LENGTH_MX(x))));
+}
+
+/* ----------------------------------------------------------------------------
+ * Finds the minimum component of a vector
+ */
+
+sunrealtype N_VMin_Mixed(N_Vector x)
+{
+  sunindextype i, N;
+  float* xd;
+  mxreal min;
+
+  N   = NV_LENGTH_MX(x);
+  xd  = NV_DATA_MX(x);
+  min = (mxreal)xd[0];
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(min : min) num_threads(NV_NUM_THREADS_MX(x))                \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 1; i < N; i++)
+  {
+    mxreal val = (mxreal)xd[i];
+    min        = (val < min) ? val : min;
+  }
+
+  return ((sunrealtype)min);
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted L2 norm of a vector
+ */
+
+sunrealtype N_VWL2Norm_Mixed(N_Vector x, N_Vector w)
+{
+  SUNFunctionBegin(x->sunctx);
+  sunrealtype sqr_sum = N_VWSqrSumLocal_Mixed(x, w);
+  SUNCheckLastErrNoRet();
+  return (SUNRsqrt(sqr_sum));
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes L1 norm of a vector
+ */
+
+sunrealtype N_VL1Norm_Mixed(N_Vector x)
+{
+  sunindextype i, N;
+  float* xd;
+  mxreal sum;
+
+  sum = ZERO;
+  N   = NV_LENGTH_MX(x);
+  xd  = NV_DATA_MX(x);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(+ : sum) num_threads(NV_NUM_THREADS_MX(x))               \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { sum += SUNRabs((mxreal)xd[i]); }
+
+  return ((sunrealtype)sum);
+}
+
+/* ----------------------------------------------------------------------------
+ * Compare vector component values to a scaler
+ */
+
+void N_VCompare_Mixed(sunrealtype c, N_Vector x, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *zd;
+  mxreal mc;
+
+  N  = NV_LENGTH_MX(x);
+  xd = NV_DATA_MX(x);
+  zd = NV_DATA_MX(z);
+  mc = (mxreal)c;
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++)
+  {
+    zd[i] = (SUNRabs((mxreal)xd[i]) >= mc) ? 1.0f : 0.0f;
+  }
+
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute componentwise inverse z[i] = ONE/x[i] and checks if x[i] == ZERO
+ */
+
+sunbooleantype N_VInvTest_Mixed(N_Vector x, N_Vector z)
+{
+  sunindextype i, N;
+  float *xd, *zd;
+  int nzero;
+
+  nzero = 0;
+  N     = NV_LENGTH_MX(x);
+  xd    = NV_DATA_MX(x);
+  zd    = NV_DATA_MX(z);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(+ : nzero) num_threads(NV_NUM_THREADS_MX(x))             \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++)
+  {
+    if (xd[i] == 0.0f) { nzero++; }
+    else { zd[i] = (float)(ONE / (mxreal)xd[i]); }
+  }
+
+  return (nzero > 0) ? SUNFALSE : SUNTRUE;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute constraint mask of a vector
+ */
+
+sunbooleantype N_VConstrMask_Mixed(N_Vector c, N_Vector x, N_Vector m)
+{
+  sunindextype i, N;
+  float *cd, *xd, *md;
+  int nfail;
+
+  nfail = 0;
+  N     = NV_LENGTH_MX(x);
+  xd    = NV_DATA_MX(x);
+  cd    = NV_DATA_MX(c);
+  md    = NV_DATA_MX(m);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(+ : nfail) num_threads(NV_NUM_THREADS_MX(x))             \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++)
+  {
+    mxreal ci = (mxreal)cd[i];
+    mxreal xi = (mxreal)xd[i];
+
+    md[i] = 0.0f;
+
+    /* Continue if no constraints were set for the variable */
+    if (ci == ZERO) { continue; }
+
+    /* Check if a set constraint has been violated */
+    if ((SUNRabs(ci) > ONEPT5 && xi * ci <= ZERO) ||
+        (SUNRabs(ci) > HALF && xi * ci < ZERO))
+    {
+      md[i] = 1.0f;
+      nfail++;
+    }
+  }
+
+  /* Return false if any constraint was violated */
+  return (nfail > 0) ? SUNFALSE : SUNTRUE;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute minimum componentwise quotient
+ */
+
+sunrealtype N_VMinQuotient_Mixed(N_Vector num, N_Vector denom)
+{
+  sunindextype i, N;
+  float *nd, *dd;
+  mxreal min;
+
+  N   = NV_LENGTH_MX(num);
+  nd  = NV_DATA_MX(num);
+  dd  = NV_DATA_MX(denom);
+  min = SUN_BIG_REAL;
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(min : min) num_threads(NV_NUM_THREADS_MX(num))              \
+  if (parallel : NV_NUM_THREADS_MX(num) > 1)
+#endif
+  for (i = 0; i < N; i++)
+  {
+    if (dd[i] != 0.0f)
+    {
+      mxreal val = (mxreal)nd[i] / (mxreal)dd[i];
+      min        = (val < min) ? val : min;
+    }
+  }
+
+  return ((sunrealtype)min);
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted square sum of a vector
+ */
+
+sunrealtype N_VWSqrSumLocal_Mixed(N_Vector x, N_Vector w)
+{
+  sunindextype i, N;
+  float *xd, *wd;
+  mxreal sum;
+
+  sum = ZERO;
+  N   = NV_LENGTH_MX(x);
+  xd  = NV_DATA_MX(x);
+  wd  = NV_DATA_MX(w);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(+ : sum) num_threads(NV_NUM_THREADS_MX(x))               \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++) { sum += SUNSQR((mxreal)xd[i] * (mxreal)wd[i]); }
+
+  return ((sunrealtype)sum);
+}
+
+/* ----------------------------------------------------------------------------
+ * Computes weighted square sum of a masked vector
+ */
+
+sunrealtype N_VWSqrSumMaskLocal_Mixed(N_Vector x, N_Vector w, N_Vector id)
+{
+  sunindextype i, N;
+  float *xd, *wd, *idd;
+  mxreal sum;
+
+  sum = ZERO;
+  N   = NV_LENGTH_MX(x);
+  xd  = NV_DATA_MX(x);
+  wd  = NV_DATA_MX(w);
+  idd = NV_DATA_MX(id);
+
+#ifdef _OPENMP
+#pragma omp parallel for simd default(shared) private(i) schedule(static) \
+  reduction(+ : sum) num_threads(NV_NUM_THREADS_MX(x))               \
+  if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (i = 0; i < N; i++)
+  {
+    if (idd[i] > 0.0f) { sum += SUNSQR((mxreal)xd[i] * (mxreal)wd[i]); }
+  }
+
+  return ((sunrealtype)sum);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * fused vector operations
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Compute z = sum c[i] X[i]. The sum of each block is accumulated in mxreal
+ * and rounded once, and z may be any of the X[i].
+ */
+
+SUNErrCode N_VLinearCombination_Mixed(int nvec, sunrealtype* c, N_Vector* X,
+                                      N_Vector z)
+{
+  SUNFunctionBegin(X[0]->sunctx);
+  sunindextype N, nblocks, b;
+  float* zd;
+
+  /* invalid number of vectors */
+  SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  /* should have called N_VScale */
+  if (nvec == 1)
+  {
+    N_VScale_Mixed(c[0], X[0], z);
+    SUNCheckLastErr();
+    return SUN_SUCCESS;
+  }
+
+  N       = NV_LENGTH_MX(z);
+  zd      = NV_DATA_MX(z);
+  nblocks = (N + MIXED_BLOCK - 1) / MIXED_BLOCK;
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(b) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(z)) if (parallel : NV_NUM_THREADS_MX(z) > 1)
+#endif
+  for (b = 0; b < nblocks; b++)
+  {
+    mxreal acc[MIXED_BLOCK];
+    sunindextype j, jstart, len;
+    int i;
+    float* xd;
+
+    jstart = b * MIXED_BLOCK;
+    len    = SUNMIN(N - jstart, MIXED_BLOCK);
+
+    xd = NV_DATA_MX(X[0]) + jstart;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (j = 0; j < len; j++) { acc[j] = (mxreal)c[0] * (mxreal)xd[j]; }
+    for (i = 1; i < nvec; i++)
+    {
+      mxreal ci = (mxreal)c[i];
+      xd        = NV_DATA_MX(X[i]) + jstart;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for (j = 0; j < len; j++) { acc[j] += ci * (mxreal)xd[j]; }
+    }
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (j = 0; j < len; j++) { zd[jstart + j] = (float)acc[j]; }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute Z[i] = a[i] x + Y[i]. Each block of x is converted once and reused
+ * for all the sums.
+ */
+
+SUNErrCode N_VScaleAddMulti_Mixed(int nvec, sunrealtype* a, N_Vector x,
+                                  N_Vector* Y, N_Vector* Z)
+{
+  SUNFunctionBegin(x->sunctx);
+  sunindextype N, nblocks, b;
+
+  /* invalid number of vectors */
+  SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  /* should have called N_VLinearSum */
+  if (nvec == 1)
+  {
+    N_VLinearSum_Mixed(a[0], x, ONE, Y[0], Z[0]);
+    SUNCheckLastErr();
+    return SUN_SUCCESS;
+  }
+
+  N       = NV_LENGTH_MX(x);
+  nblocks = (N + MIXED_BLOCK - 1) / MIXED_BLOCK;
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(b) schedule(static) \
+  num_threads(NV_NUM_THREADS_MX(x)) if (parallel : NV_NUM_THREADS_MX(x) > 1)
+#endif
+  for (b = 0; b < nblocks; b++)
+  {
+    mxreal xb[MIXED_BLOCK];
+    sunindextype j, jstart, len;
+    int i;
+    float *xd, *yd, *zd;
+
+    jstart = b * MIXED_BLOCK;
+    len    = SUNMIN(N - jstart, MIXED_BLOCK);
+
+    xd = NV_DATA_MX(x) + jstart;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for (j = 0; j < len; j++) { xb[j] = (mxreal)xd[j]; }
+    for (i = 0; i < nvec; i++)
+    {
+      mxreal ai = (mxreal)a[i];
+      yd        = NV_DATA_MX(Y[i]) + jstart;
+      zd        = NV_DATA_MX(Z[i]) + jstart;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for (j = 0; j < len; j++)
+      {
+        zd[j] = (float)(ai * xb[j] + (mxreal)yd[j]);
+      }
+    }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute dotprods[i] = x . Y[i]. The blocks of x are reused from the cache
+ * for all the products, and the sums of the threads are combined in thread
+ * order.
+ */
+
+SUNErrCode N_VDotProdMulti_Mixed(int nvec, N_Vector x, N_Vector* Y,
+                                 sunrealtype* dotprods)
+{
+  SUNFunctionBegin(x->sunctx);
+  sunindextype N, nblocks;
+  mxreal* sums;
+  int i, t, nt;
+
+  /* invalid number of vectors */
+  SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  /* should have called N_VDotProd */
+  if (nvec == 1)
+  {
+    dotprods[0] = N_VDotProd_Mixed(x, Y[0]);
+    SUNCheckLastErr();
+    return SUN_SUCCESS;
+  }
+
+  N       = NV_LENGTH_MX(x);
+  nblocks = (N + MIXED_BLOCK - 1) / MIXED_BLOCK;
+#ifdef _OPENMP
+  nt = NV_NUM_THREADS_MX(x);
+#else
+  nt = 1;
+#endif
+
+  /* partial sums of each thread */
+  sums = (mxreal*)calloc((size_t)nt * (size_t)nvec, sizeof(mxreal));
+  SUNAssert(sums, SUN_ERR_MALLOC_FAIL);
+
+#ifdef _OPENMP
+#pragma omp parallel default(shared) num_threads(nt) if (nt > 1)
+#endif
+  {
+    sunindextype b, j, jstart, len;
+    mxreal* tsums;
+    float *xd, *yd;
+    int k;
+
+#ifdef _OPENMP
+    tsums = sums + (size_t)omp_get_thread_num() * (size_t)nvec;
+#pragma omp for schedule(static)
+#else
+    tsums = sums;
+#endif
+    for (b = 0; b < nblocks; b++)
+    {
+      jstart = b * MIXED_BLOCK;
+      len    = SUNMIN(N - jstart, MIXED_BLOCK);
+      xd     = NV_DATA_MX(x) + jstart;
+      for (k = 0; k < nvec; k++)
+      {
+        mxreal sum = ZERO;
+        yd         = NV_DATA_MX(Y[k]) + jstart;
+#ifdef _OPENMP
+#pragma omp simd reduction(+ : sum)
+#endif
+        for (j = 0; j < len; j++) { sum += (mxreal)xd[j] * (mxreal)yd[j]; }
+        tsums[k] += sum;
+      }
+    }
+  }
+
+  for (i = 0; i < nvec; i++)
+  {
+    mxreal sum = ZERO;
+    for (t = 0; t < nt; t++) { sum += sums[(size_t)t * (size_t)nvec + i]; }
+    dotprods[i] = (sunrealtype)sum;
+  }
+
+  free(sums);
+
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * OPTIONAL XBraid interface operations
+ * -----------------------------------------------------------------
+ */
+
+/* The buffer holds sunrealtype values like the buffers of the other vectors,
+   so buffers may be exchanged with vectors of any implementation */
+
+SUNErrCode N_VBufSize_Mixed(N_Vector x, sunindextype* size)
+{
+  *size = NV_LENGTH_MX(x) * ((sunindextype)sizeof(sunrealtype));
+  return SUN_SUCCESS;
+}
+
+SUNErrCode N_VBufPack_Mixed(N_Vector x, void* buf)
+{
+  SUNFunctionBegin(x->sunctx);
+
+  SUNAssert(buf, SUN_ERR_ARG_CORRUPT);
+
+  SUNCheckCall(N_VCopyToArray_Mixed(x, (sunrealtype*)buf));
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode N_VBufUnpack_Mixed(N_Vector x, void* buf)
+{
+  SUNFunctionBegin(x->sunctx);
+
+  SUNAssert(buf, SUN_ERR_ARG_CORRUPT);
+
+  SUNCheckCall(N_VCopyFromArray_Mixed((sunrealtype*)buf, x));
+
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Allocate a data array
+ */
+
+static float* VAllocData_Mixed(sunindextype N)
+{
+  return (float*)malloc((size_t)N * sizeof(float));
+}
+
+/*
+ * -----------------------------------------------------------------
+ * Enable / Disable fused vector operations
+ * -----------------------------------------------------------------
+ */
+
+SUNErrCode N_VEnableFusedOps_Mixed(N_Vector v, sunbooleantype tf)
+{
+  if (tf)
+  {
+    /* enable all fused vector operations */
+    v->ops->nvlinearcombination = N_VLinearCombination_Mixed;
+    v->ops->nvscaleaddmulti     = N_VScaleAddMulti_Mixed;
+    v->ops->nvdotprodmulti      = N_VDotProdMulti_Mixed;
+    /* enable single buffer reduction operations */
+    v->ops->nvdotprodmultilocal = N_VDotProdMulti_Mixed;
+  }
+  else
+  {
+    /* disable all fused vector operations */
+    v->ops->nvlinearcombination = NULL;
+    v->ops->nvscaleaddmulti     = NULL;
+    v->ops->nvdotprodmulti      = NULL;
+    /* disable single buffer reduction operations */
+    v->ops->nvdotprodmultilocal = NULL;
+  }
+
+  /* return success */
+  return SUN_SUCCESS;
+}
+
+SUNErrCode N_VEnableLinearCombination_Mixed(N_Vector v, sunbooleantype tf)
+{
+  v->ops->nvlinearcombination = tf ? N_VLinearCombination_Mixed : NULL;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode N_VEnableScaleAddMulti_Mixed(N_Vector v, sunbooleantype tf)
+{
+  v->ops->nvscaleaddmulti = tf ? N_VScaleAddMulti_Mixed : NULL;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode N_VEnableDotProdMulti_Mixed(N_Vector v, sunbooleantype tf)
+{
+  v->ops->nvdotprodmulti      = tf ? N_VDotProdMulti_Mixed : NULL;
+  v->ops->nvdotprodmultilocal = tf ? N_VDotProdMulti_Mixed : NULL;
+  return SUN_SUCCESS;
+}
@@ -31,6 +31,7 @@
 #include <sundials/sundials_core.h>
 #include <sundials/sundials_errors.h>
 
+#include "sundials_binned_sum_impl.h"
 #include "sundials_macros.h"
 
 #define ZERO   SUN_RCONST(0.0)
@@ -38,6 +39,14 @@
 #define ONE    SUN_RCONST(1.0)
 #define ONEPT5 SUN_RCONST(1.5)
 
+/* Private function to allocate the data array of a vector */
+static sunrealtype* VAllocData_OpenMP(sunindextype N, int num_threads,
+                                      sunbooleantype first_touch);
+
+/* Private function for reproducible reductions */
+static sunrealtype VBinnedSum_OpenMP(sunBinnedTerm term, N_Vector x,
+                                     sunrealtype* yd, sunrealtype* zd);
+
 /* Private functions for special cases of vector operations */
 static void VCopy_OpenMP(N_Vector x, N_Vector z);             /* z=x */
 static void VSum_OpenMP(N_Vector x, N_Vector y, N_Vector z);  /* z=x+y     */
@@ -178,7 +187,9 @@ N_Vector N_VNewEmpty_OpenMP(sunindextype length, int num_threads,
   content->length      = length;
   content->num_threads = num_threads;
   content->own_data    = SUNFALSE;
-  content->data        = NULL;
+  content->data         = NULL;
+  content->first_touch  = SUNFALSE;
+  content->reproducible = SUNFALSE;
 
   return (v);
 }
@@ -317,7 +328,9 @@ N_Vector N_VCloneEmpty_OpenMP(N_Vector w)
   content->length      = NV_LENGTH_OMP(w);
   content->num_threads = NV_NUM_THREADS_OMP(w);
   content->own_data    = SUNFALSE;
-  content->data        = NULL;
+  content->data         = NULL;
+  content->first_touch  = NV_FIRST_TOUCH_OMP(w);
+  content->reproducible = NV_REPRODUCIBLE_OMP(w);
 
   return (v);
 }
@@ -343,7 +356,8 @@ N_Vector N_VClone_OpenMP(N_Vector w)
   data = NULL;
   if (length > 0)
   {
-    data = (sunrealtype*)malloc(length * sizeof(sunrealtype));
+    data = VAllocData_OpenMP(length, NV_NUM_THREADS_OMP(w),
+                             NV_FIRST_TOUCH_OMP(w));
     SUNAssertNull(data, SUN_ERR_MALLOC_FAIL);
   }
 
@@ -424,6 +438,140 @@ void N_VSetArrayPointer_OpenMP(sunrealtype* v_data, N_Vector v)
   return;
 }
 
+/* ----------------------------------------------------------------------------
+ * Enable or disable the parallel first touch of the data arrays allocated for
+ * clones of the vector. The pages of such an array are first written by the
+ * threads that access them in the vector operations, which places them in the
+ * memory of those threads on NUMA systems. When enabling, data owned by the
+ * vector is moved to a new array placed in the same way.
+ */
+
+SUNErrCode N_VSetFirstTouch_OpenMP(N_Vector v, sunbooleantype first_touch)
+{
+  SUNFunctionBegin(v->sunctx);
+  sunindextype i, N;
+  sunrealtype *xd, *zd;
+
+  i = 0; /* initialize to suppress clang warning */
+
+  NV_FIRST_TOUCH_OMP(v) = first_touch;
+
+  if (!first_touch || !NV_OWN_DATA_OMP(v) || NV_DATA_OMP(v) == NULL)
+  {
+    return SUN_SUCCESS;
+  }
+
+  N  = NV_LENGTH_OMP(v);
+  xd = NV_DATA_OMP(v);
+  zd = (sunrealtype*)malloc(N * sizeof(sunrealtype));
+  SUNAssert(zd, SUN_ERR_MALLOC_FAIL);
+
+#pragma omp parallel for default(none) private(i) shared(N, xd, zd) \
+  schedule(static) num_threads(NV_NUM_THREADS_OMP(v))
+  for (i = 0; i < N; i++) { zd[i] = xd[i]; }
+
+  free(xd);
+  NV_DATA_OMP(v) = zd;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Return the static partition of the vector elements among the threads used by
+ * the vector operations: thread t works on the elements offsets[t] to
+ * offsets[t+1]-1. The offsets array must have num_threads+1 entries.
+ */
+
+SUNErrCode N_VGetThreadPartition_OpenMP(N_Vector v, sunindextype* offsets)
+{
+  SUNFunctionBegin(v->sunctx);
+  sunindextype i, N;
+  int t, nt;
+
+  SUNAssert(offsets, SUN_ERR_ARG_CORRUPT);
+
+  i  = 0; /* initialize to suppress clang warning */
+  N  = NV_LENGTH_OMP(v);
+  nt = NV_NUM_THREADS_OMP(v);
+
+  for (t = 0; t <= nt; t++) { offsets[t] = 0; }
+
+  /* the static schedule assigns one contiguous chunk to each thread in
+     thread order, count the iterations of each thread in a loop with the
+     same number of iterations and threads as the vector operations */
+#pragma omp parallel default(none) private(i) shared(N, offsets) \
+  num_threads(nt)
+  {
+    sunindextype count = 0;
+
+#pragma omp for schedule(static)
+    for (i = 0; i < N; i++) { count++; }
+
+    offsets[omp_get_thread_num() + 1] = count;
+  }
+
+  for (t = 0; t < nt; t++) { offsets[t + 1] += offsets[t]; }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Check whether every thread used by the vector operations is bound to a
+ * place, i.e., to a set of processors. Unbound threads may migrate away from
+ * the memory placed by the parallel first touch.
+ */
+
+SUNErrCode N_VGetThreadsBound_OpenMP(N_Vector v, sunbooleantype* bound)
+{
+  SUNFunctionBegin(v->sunctx);
+  int nbound, nteam;
+
+  SUNAssert(bound, SUN_ERR_ARG_CORRUPT);
+
+  nbound = 0;
+  nteam  = 0;
+
+#pragma omp parallel default(none) shared(nbound, nteam) \
+  num_threads(NV_NUM_THREADS_OMP(v))
+  {
+#if _OPENMP >= 201511
+    int is_bound = (omp_get_place_num() >= 0);
+#elif _OPENMP >= 201307
+    int is_bound = (omp_get_proc_bind() != omp_proc_bind_false);
+#else
+    int is_bound = 0;
+#endif
+
+#pragma omp atomic
+    nbound += is_bound;
+
+#pragma omp master
+    nteam = omp_get_num_threads();
+  }
+
+  *bound = (nbound == nteam) ? SUNTRUE : SUNFALSE;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Enable or disable reproducible reductions for a vector and its future
+ * clones. When enabled, the dot product, the norms other than the max norm,
+ * and the weighted square sums are computed with a binned accumulator whose
+ * result does not depend on the number of threads.
+ */
+
+SUNErrCode N_VSetReproducibleReductions_OpenMP(N_Vector v,
+                                               sunbooleantype reproducible)
+{
+  SUNFunctionBegin(v->sunctx);
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  if (reproducible) { return SUN_ERR_NOT_IMPLEMENTED; }
+#endif
+  NV_REPRODUCIBLE_OMP(v) = reproducible;
+  return SUN_SUCCESS;
+}
+
 /* ----------------------------------------------------------------------------
  * Compute linear combination z[i] = a*x[i]+b*y[i]
  */
@@ -715,6 +863,11 @@ sunrealtype N_VDotProd_OpenMP(N_Vector x, N_Vector y)
   xd = NV_DATA_OMP(x);
   yd = NV_DATA_OMP(y);
 
+  if (NV_REPRODUCIBLE_OMP(x))
+  {
+    return (VBinnedSum_OpenMP(SUN_BINNED_DOT, x, yd, NULL));
+  }
+
 #pragma omp parallel for default(none) private(i) shared(N, xd, yd) \
   reduction(+ : sum) schedule(static) num_threads(NV_NUM_THREADS_OMP(x))
   for (i = 0; i < N; i++) { sum += xd[i] * yd[i]; }
@@ -835,6 +988,11 @@ sunrealtype N_VWL2Norm_OpenMP(N_Vector x, N_Vector w)
   xd = NV_DATA_OMP(x);
   wd = NV_DATA_OMP(w);
 
+  if (NV_REPRODUCIBLE_OMP(x))
+  {
+    return (SUNRsqrt(VBinnedSum_OpenMP(SUN_BINNED_WSQR, x, wd, NULL)));
+  }
+
 #pragma omp parallel for default(none) private(i) shared(N, xd, wd) \
   reduction(+ : sum) schedule(static) num_threads(NV_NUM_THREADS_OMP(x))
   for (i = 0; i < N; i++) { sum += SUNSQR(xd[i] * wd[i]); }
@@ -858,6 +1016,11 @@ sunrealtype N_VL1Norm_OpenMP(N_Vector x)
   N  = NV_LENGTH_OMP(x);
   xd = NV_DATA_OMP(x);
 
+  if (NV_REPRODUCIBLE_OMP(x))
+  {
+    return (VBinnedSum_OpenMP(SUN_BINNED_ABS, x, NULL, NULL));
+  }
+
 #pragma omp parallel for default(none) private(i) shared(N, xd) \
   reduction(+ : sum) schedule(static) num_threads(NV_NUM_THREADS_OMP(x))
   for (i = 0; i < N; i++) { sum += SUNRabs(xd[i]); }
@@ -1018,6 +1181,11 @@ sunrealtype N_VWSqrSumLocal_OpenMP(N_Vector x, N_Vector w)
   xd = NV_DATA_OMP(x);
   wd = NV_DATA_OMP(w);
 
+  if (NV_REPRODUCIBLE_OMP(x))
+  {
+    return (VBinnedSum_OpenMP(SUN_BINNED_WSQR, x, wd, NULL));
+  }
+
 #pragma omp parallel for default(none) private(i) shared(N, xd, wd) \
   reduction(+ : sum) schedule(static) num_threads(NV_NUM_THREADS_OMP(x))
   for (i = 0; i < N; i++) { sum += SUNSQR(xd[i] * wd[i]); }
@@ -1043,6 +1211,11 @@ sunrealtype N_VWSqrSumMaskLocal_OpenMP(N_Vector x, N_Vector w, N_Vector id)
   wd  = NV_DATA_OMP(w);
   idd = NV_DATA_OMP(id);
 
+  if (NV_REPRODUCIBLE_OMP(x))
+  {
+    return (VBinnedSum_OpenMP(SUN_BINNED_WSQR_MASK, x, wd, idd));
+  }
+
 #pragma omp parallel for default(none) private(i) shared(N, xd, wd, idd) \
   reduction(+ : sum) schedule(static) num_threads(NV_NUM_THREADS_OMP(x))
   for (i = 0; i < N; i++)
@@ -1236,10 +1409,13 @@ SUNErrCode N_VDotProdMulti_OpenMP(int nvec, N_Vector x, N_Vector* Y,
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
 
   /* should have called N_VDotProd */
-  if (nvec == 1)
+  if (nvec == 1 || NV_REPRODUCIBLE_OMP(x))
   {
-    dotprods[0] = N_VDotProd_OpenMP(x, Y[0]);
-    SUNCheckLastErr();
+    for (i = 0; i < nvec; i++)
+    {
+      dotprods[i] = N_VDotProd_OpenMP(x, Y[i]);
+      SUNCheckLastErr();
+    }
     return SUN_SUCCESS;
   }
 
@@ -1522,10 +1698,13 @@ SUNErrCode N_VWrmsNormVectorArray_OpenMP(int nvec, N_Vector* X, N_Vector* W,
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
 
   /* should have called N_VWrmsNorm */
-  if (nvec == 1)
+  if (nvec == 1 || NV_REPRODUCIBLE_OMP(X[0]))
   {
-    nrm[0] = N_VWrmsNorm_OpenMP(X[0], W[0]);
-    SUNCheckLastErr();
+    for (i = 0; i < nvec; i++)
+    {
+      nrm[i] = N_VWrmsNorm_OpenMP(X[i], W[i]);
+      SUNCheckLastErr();
+    }
     return SUN_SUCCESS;
   }
 
@@ -1577,10 +1756,13 @@ SUNErrCode N_VWrmsNormMaskVectorArray_OpenMP(int nvec, N_Vector* X, N_Vector* W,
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
 
   /* should have called N_VWrmsNorm */
-  if (nvec == 1)
+  if (nvec == 1 || NV_REPRODUCIBLE_OMP(X[0]))
   {
-    nrm[0] = N_VWrmsNormMask_OpenMP(X[0], W[0], id);
-    SUNCheckLastErr();
+    for (i = 0; i < nvec; i++)
+    {
+      nrm[i] = N_VWrmsNormMask_OpenMP(X[i], W[i], id);
+      SUNCheckLastErr();
+    }
     return SUN_SUCCESS;
   }
 
@@ -1948,6 +2130,70 @@ SUNErrCode N_VBufUnpack_OpenMP(N_Vector x, void* buf)
  * -----------------------------------------------------------------
  */
 
+/* ----------------------------------------------------------------------------
+ * Reproducible sum of the terms of x and the data arrays yd and zd. Each
+ * thread accumulates its blocks in a binned sum and the exact merge of the
+ * partial sums makes the result independent of the number of threads.
+ */
+
+static sunrealtype VBinnedSum_OpenMP(sunBinnedTerm term, N_Vector x,
+                                     sunrealtype* yd, sunrealtype* zd)
+{
+  sunindextype b, nb, N;
+  sunrealtype* xd;
+  sunBinnedSum sum, lsum;
+
+  b = 0; /* initialize to suppress clang warning */
+
+  N  = NV_LENGTH_OMP(x);
+  xd = NV_DATA_OMP(x);
+  nb = (N + SUN_BINNED_BLOCK - 1) / SUN_BINNED_BLOCK;
+
+  sunBinnedSum_Init(&sum);
+
+#pragma omp parallel default(none) private(b, lsum) \
+  shared(term, N, nb, xd, yd, zd, sum) num_threads(NV_NUM_THREADS_OMP(x))
+  {
+    sunBinnedSum_Init(&lsum);
+#pragma omp for schedule(static)
+    for (b = 0; b < nb; b++)
+    {
+      sunBinnedSum_AddRange(&lsum, term, xd, yd, zd, b * SUN_BINNED_BLOCK,
+                            SUNMIN(N, (b + 1) * SUN_BINNED_BLOCK));
+    }
+#pragma omp critical
+    {
+      sunBinnedSum_Merge(&sum, &lsum);
+    }
+  }
+
+  return ((sunrealtype)sunBinnedSum_Value(&sum));
+}
+
+/* ----------------------------------------------------------------------------
+ * Allocate a data array, optionally writing it with the static partition of
+ * the vector operations so that each page is first touched by its thread
+ */
+
+static sunrealtype* VAllocData_OpenMP(sunindextype N, int num_threads,
+                                      sunbooleantype first_touch)
+{
+  sunindextype i;
+  sunrealtype* xd;
+
+  i  = 0; /* initialize to suppress clang warning */
+  xd = (sunrealtype*)malloc(N * sizeof(sunrealtype));
+
+  if (xd != NULL && first_touch)
+  {
+#pragma omp parallel for default(none) private(i) shared(N, xd) \
+  schedule(static) num_threads(num_threads)
+    for (i = 0; i < N; i++) { xd[i] = ZERO; }
+  }
+
+  return xd;
+}
+
 /* ----------------------------------------------------------------------------
  * Copy vector components into a second vector
  */
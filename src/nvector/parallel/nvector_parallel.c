@@ -25,6 +25,7 @@
 #include <sundials/sundials_errors.h>
 #include <sundials/sundials_types.h>
 
+#include "sundials_binned_sum_impl.h"
 #include "sundials_macros.h"
 
 #define ZERO   SUN_RCONST(0.0)
@@ -65,6 +66,13 @@ static void VLin2VectorArray_Parallel(int nvec, sunrealtype a, N_Vector* X,
 static void VaxpyVectorArray_Parallel(int nvec, sunrealtype a, N_Vector* X,
                                       N_Vector* Y); /* Y <- aX+Y */
 
+/* Private functions for reproducible reductions */
+static sunrealtype VBinnedSum_Parallel(sunBinnedTerm term, N_Vector x,
+                                       sunrealtype* yd, sunrealtype* zd,
+                                       sunbooleantype global);
+static SUNErrCode VBinnedAllReduce_Parallel(sunBinnedSum* sums, int nsums,
+                                            MPI_Comm comm, SUNContext sunctx);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -178,6 +186,7 @@ N_Vector N_VNewEmpty_Parallel(MPI_Comm comm, sunindextype local_length,
   content->comm          = comm;
   content->own_data      = SUNFALSE;
   content->data          = NULL;
+  content->reproducible  = SUNFALSE;
 
   return (v);
 }
@@ -337,6 +346,7 @@ N_Vector N_VCloneEmpty_Parallel(N_Vector w)
   content->comm          = NV_COMM_P(w);
   content->own_data      = SUNFALSE;
   content->data          = NULL;
+  content->reproducible  = NV_REPRODUCIBLE_P(w);
 
   return (v);
 }
@@ -429,6 +439,29 @@ void N_VSetArrayPointer_Parallel(sunrealtype* v_data, N_Vector v)
   return;
 }
 
+/* ----------------------------------------------------------------
+ * Enable or disable reproducible reductions for a vector and its
+ * future clones. When enabled, the dot product, the norms other than
+ * the max norm, and the weighted square sums are computed with binned
+ * accumulators that are combined exactly across the ranks, so their
+ * results do not depend on the number of ranks. The single buffer
+ * reduction N_VDotProdMultiAllReduce sums rounded local values and is
+ * disabled while the option is on.
+ */
+
+SUNErrCode N_VSetReproducibleReductions_Parallel(N_Vector v,
+                                                 sunbooleantype reproducible)
+{
+  SUNFunctionBegin(v->sunctx);
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  if (reproducible) { return SUN_ERR_NOT_IMPLEMENTED; }
+#endif
+  NV_REPRODUCIBLE_P(v) = reproducible;
+  v->ops->nvdotprodmultiallreduce =
+    reproducible ? NULL : N_VDotProdMultiAllReduce_Parallel;
+  return SUN_SUCCESS;
+}
+
 MPI_Comm N_VGetCommunicator_Parallel(N_Vector v) { return NV_COMM_P(v); }
 
 void N_VLinearSum_Parallel(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
@@ -657,6 +690,12 @@ sunrealtype N_VDotProdLocal_Parallel(N_Vector x, N_Vector y)
   sum = ZERO;
   xd = yd = NULL;
 
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    return (
+      VBinnedSum_Parallel(SUN_BINNED_DOT, x, NV_DATA_P(y), NULL, SUNFALSE));
+  }
+
   N  = NV_LOCLENGTH_P(x);
   xd = NV_DATA_P(x);
   yd = NV_DATA_P(y);
@@ -669,6 +708,11 @@ sunrealtype N_VDotProd_Parallel(N_Vector x, N_Vector y)
 {
   SUNFunctionBegin(x->sunctx);
   sunrealtype lsum, gsum;
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    return (
+      VBinnedSum_Parallel(SUN_BINNED_DOT, x, NV_DATA_P(y), NULL, SUNTRUE));
+  }
   lsum = N_VDotProdLocal_Parallel(x, y);
   SUNCheckLastErrNoRet();
   SUNCheckMPICallNoRet(
@@ -715,6 +759,12 @@ sunrealtype N_VWSqrSumLocal_Parallel(N_Vector x, N_Vector w)
   sum = ZERO;
   xd = wd = NULL;
 
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    return (
+      VBinnedSum_Parallel(SUN_BINNED_WSQR, x, NV_DATA_P(w), NULL, SUNFALSE));
+  }
+
   N  = NV_LOCLENGTH_P(x);
   xd = NV_DATA_P(x);
   wd = NV_DATA_P(w);
@@ -732,6 +782,11 @@ sunrealtype N_VWrmsNorm_Parallel(N_Vector x, N_Vector w)
 {
   SUNFunctionBegin(x->sunctx);
   sunrealtype lsum, gsum;
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    gsum = VBinnedSum_Parallel(SUN_BINNED_WSQR, x, NV_DATA_P(w), NULL, SUNTRUE);
+    return (SUNRsqrt(gsum / (NV_GLOBLENGTH_P(x))));
+  }
   lsum = N_VWSqrSumLocal_Parallel(x, w);
   SUNCheckLastErrNoRet();
   SUNCheckMPICallNoRet(
@@ -747,6 +802,12 @@ sunrealtype N_VWSqrSumMaskLocal_Parallel(N_Vector x, N_Vector w, N_Vector id)
   sum = ZERO;
   xd = wd = idd = NULL;
 
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    return (VBinnedSum_Parallel(SUN_BINNED_WSQR_MASK, x, NV_DATA_P(w),
+                                NV_DATA_P(id), SUNFALSE));
+  }
+
   N   = NV_LOCLENGTH_P(x);
   xd  = NV_DATA_P(x);
   wd  = NV_DATA_P(w);
@@ -767,6 +828,12 @@ sunrealtype N_VWrmsNormMask_Parallel(N_Vector x, N_Vector w, N_Vector id)
 {
   SUNFunctionBegin(x->sunctx);
   sunrealtype lsum, gsum;
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    gsum = VBinnedSum_Parallel(SUN_BINNED_WSQR_MASK, x, NV_DATA_P(w),
+                               NV_DATA_P(id), SUNTRUE);
+    return (SUNRsqrt(gsum / (NV_GLOBLENGTH_P(x))));
+  }
   lsum = N_VWSqrSumMaskLocal_Parallel(x, w, id);
   SUNCheckLastErrNoRet();
   SUNCheckMPICallNoRet(
@@ -810,6 +877,11 @@ sunrealtype N_VWL2Norm_Parallel(N_Vector x, N_Vector w)
 {
   SUNFunctionBegin(x->sunctx);
   sunrealtype lsum, gsum;
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    gsum = VBinnedSum_Parallel(SUN_BINNED_WSQR, x, NV_DATA_P(w), NULL, SUNTRUE);
+    return (SUNRsqrt(gsum));
+  }
   lsum = N_VWSqrSumLocal_Parallel(x, w);
   SUNCheckLastErrNoRet();
   SUNCheckMPICallNoRet(
@@ -822,6 +894,11 @@ sunrealtype N_VL1NormLocal_Parallel(N_Vector x)
   sunindextype i, N;
   sunrealtype sum, *xd;
 
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    return (VBinnedSum_Parallel(SUN_BINNED_ABS, x, NULL, NULL, SUNFALSE));
+  }
+
   sum = ZERO;
   xd  = NULL;
   N   = NV_LOCLENGTH_P(x);
@@ -836,6 +913,10 @@ sunrealtype N_VL1Norm_Parallel(N_Vector x)
 {
   SUNFunctionBegin(x->sunctx);
   sunrealtype lsum, gsum;
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    return (VBinnedSum_Parallel(SUN_BINNED_ABS, x, NULL, NULL, SUNTRUE));
+  }
   lsum = N_VL1NormLocal_Parallel(x);
   SUNCheckLastErrNoRet();
   SUNCheckMPICallNoRet(
@@ -1117,6 +1198,7 @@ SUNErrCode N_VDotProdMulti_Parallel(int nvec, N_Vector x, N_Vector* Y,
   sunindextype j, N;
   sunrealtype* xd = NULL;
   sunrealtype* yd = NULL;
+  sunBinnedSum* sums;
   MPI_Comm comm;
 
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
@@ -1134,6 +1216,26 @@ SUNErrCode N_VDotProdMulti_Parallel(int nvec, N_Vector x, N_Vector* Y,
   xd   = NV_DATA_P(x);
   comm = NV_COMM_P(x);
 
+  /* reproducible dot products with a single reduction */
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    sums = (sunBinnedSum*)malloc(nvec * sizeof(sunBinnedSum));
+    SUNAssert(sums, SUN_ERR_MALLOC_FAIL);
+    for (i = 0; i < nvec; i++)
+    {
+      sunBinnedSum_Init(&sums[i]);
+      sunBinnedSum_AddRange(&sums[i], SUN_BINNED_DOT, xd, NV_DATA_P(Y[i]),
+                            NULL, 0, N);
+    }
+    SUNCheckCall(VBinnedAllReduce_Parallel(sums, nvec, comm, x->sunctx));
+    for (i = 0; i < nvec; i++)
+    {
+      dotprods[i] = (sunrealtype)sunBinnedSum_Value(&sums[i]);
+    }
+    free(sums);
+    return SUN_SUCCESS;
+  }
+
   /* compute multiple dot products */
   for (i = 0; i < nvec; i++)
   {
@@ -1166,6 +1268,17 @@ SUNErrCode N_VDotProdMultiLocal_Parallel(int nvec, N_Vector x, N_Vector* Y,
 
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
 
+  /* local dot products are reproducible for a fixed number of ranks */
+  if (NV_REPRODUCIBLE_P(x))
+  {
+    for (i = 0; i < nvec; i++)
+    {
+      dotprods[i] = N_VDotProdLocal_Parallel(x, Y[i]);
+      SUNCheckLastErr();
+    }
+    return SUN_SUCCESS;
+  }
+
   /* get vector length and data array */
   N  = NV_LOCLENGTH_P(x);
   xd = NV_DATA_P(x);
@@ -1409,6 +1522,7 @@ SUNErrCode N_VWrmsNormVectorArray_Parallel(int nvec, N_Vector* X, N_Vector* W,
   sunindextype j, Nl, Ng;
   sunrealtype* wd = NULL;
   sunrealtype* xd = NULL;
+  sunBinnedSum* sums;
   MPI_Comm comm;
 
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
@@ -1426,6 +1540,26 @@ SUNErrCode N_VWrmsNormVectorArray_Parallel(int nvec, N_Vector* X, N_Vector* W,
   Ng   = NV_GLOBLENGTH_P(X[0]);
   comm = NV_COMM_P(X[0]);
 
+  /* reproducible norms with a single reduction */
+  if (NV_REPRODUCIBLE_P(X[0]))
+  {
+    sums = (sunBinnedSum*)malloc(nvec * sizeof(sunBinnedSum));
+    SUNAssert(sums, SUN_ERR_MALLOC_FAIL);
+    for (int i = 0; i < nvec; i++)
+    {
+      sunBinnedSum_Init(&sums[i]);
+      sunBinnedSum_AddRange(&sums[i], SUN_BINNED_WSQR, NV_DATA_P(X[i]),
+                            NV_DATA_P(W[i]), NULL, 0, Nl);
+    }
+    SUNCheckCall(VBinnedAllReduce_Parallel(sums, nvec, comm, X[0]->sunctx));
+    for (int i = 0; i < nvec; i++)
+    {
+      nrm[i] = SUNRsqrt((sunrealtype)sunBinnedSum_Value(&sums[i]) / Ng);
+    }
+    free(sums);
+    return SUN_SUCCESS;
+  }
+
   /* compute the WRMS norm for each vector in the vector array */
   for (int i = 0; i < nvec; i++)
   {
@@ -1451,6 +1585,7 @@ SUNErrCode N_VWrmsNormMaskVectorArray_Parallel(int nvec, N_Vector* X, N_Vector*
   sunrealtype* wd  = NULL;
   sunrealtype* xd  = NULL;
   sunrealtype* idd = NULL;
+  sunBinnedSum* sums;
   MPI_Comm comm;
 
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
@@ -1469,6 +1604,26 @@ SUNErrCode N_VWrmsNormMaskVectorArray_Parallel(int nvec, N_Vector* X, N_Vector*
   comm = NV_COMM_P(X[0]);
   idd  = NV_DATA_P(id);
 
+  /* reproducible norms with a single reduction */
+  if (NV_REPRODUCIBLE_P(X[0]))
+  {
+    sums = (sunBinnedSum*)malloc(nvec * sizeof(sunBinnedSum));
+    SUNAssert(sums, SUN_ERR_MALLOC_FAIL);
+    for (int i = 0; i < nvec; i++)
+    {
+      sunBinnedSum_Init(&sums[i]);
+      sunBinnedSum_AddRange(&sums[i], SUN_BINNED_WSQR_MASK, NV_DATA_P(X[i]),
+                            NV_DATA_P(W[i]), idd, 0, Nl);
+    }
+    SUNCheckCall(VBinnedAllReduce_Parallel(sums, nvec, comm, X[0]->sunctx));
+    for (int i = 0; i < nvec; i++)
+    {
+      nrm[i] = SUNRsqrt((sunrealtype)sunBinnedSum_Value(&sums[i]) / Ng);
+    }
+    free(sums);
+    return SUN_SUCCESS;
+  }
+
   /* compute the WRMS norm for each vector in the vector array */
   for (int i = 0; i < nvec; i++)
   {
@@ -2126,6 +2281,64 @@ static void VaxpyVectorArray_Parallel(int nvec, sunrealtype a, N_Vector* X,
   }
 }
 
+/*
+ * -----------------------------------------------------------------
+ * private functions for reproducible reductions
+ * -----------------------------------------------------------------
+ */
+
+/* Binned sum of the terms of x (and yd, zd) on this rank, combined
+   across the ranks when global is true */
+static sunrealtype VBinnedSum_Parallel(sunBinnedTerm term, N_Vector x,
+                                       sunrealtype* yd, sunrealtype* zd,
+                                       sunbooleantype global)
+{
+  SUNFunctionBegin(x->sunctx);
+  sunBinnedSum sum;
+
+  sunBinnedSum_Init(&sum);
+  sunBinnedSum_AddRange(&sum, term, NV_DATA_P(x), yd, zd, 0, NV_LOCLENGTH_P(x));
+
+  if (global)
+  {
+    SUNCheckCallNoRet(
+      VBinnedAllReduce_Parallel(&sum, 1, NV_COMM_P(x), x->sunctx));
+  }
+
+  return ((sunrealtype)sunBinnedSum_Value(&sum));
+}
+
+/* MPI reduction operation merging arrays of binned sums */
+static void VBinnedSumOp_Parallel(void* in, void* inout, int* len,
+                                  SUNDIALS_MAYBE_UNUSED MPI_Datatype* type)
+{
+  sunBinnedSum* a = (sunBinnedSum*)inout;
+  sunBinnedSum* b = (sunBinnedSum*)in;
+  for (int i = 0; i < *len; i++) { sunBinnedSum_Merge(&a[i], &b[i]); }
+}
+
+/* Combine the binned sums of all ranks in place. Since merging binned
+   sums is exact, the result does not depend on the reduction order. */
+static SUNErrCode VBinnedAllReduce_Parallel(sunBinnedSum* sums, int nsums,
+                                            MPI_Comm comm, SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  MPI_Datatype type;
+  MPI_Op op;
+
+  SUNCheckMPICall(
+    MPI_Type_contiguous((int)sizeof(sunBinnedSum), MPI_BYTE, &type));
+  SUNCheckMPICall(MPI_Type_commit(&type));
+  SUNCheckMPICall(MPI_Op_create(VBinnedSumOp_Parallel, 1, &op));
+
+  SUNCheckMPICall(MPI_Allreduce(MPI_IN_PLACE, sums, nsums, type, op, comm));
+
+  SUNCheckMPICall(MPI_Op_free(&op));
+  SUNCheckMPICall(MPI_Type_free(&type));
+
+  return SUN_SUCCESS;
+}
+
 /*
  * -----------------------------------------------------------------
  * Enable / Disable fused and vector array operations
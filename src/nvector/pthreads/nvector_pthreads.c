@@ -31,6 +31,7 @@
 #include <sundials/sundials_core.h>
 #include <sundials/sundials_errors.h>
 
+#include "sundials_binned_sum_impl.h"
 #include "sundials_macros.h"
 
 #define ZERO   SUN_RCONST(0.0)
@@ -38,6 +39,41 @@
 #define ONE    SUN_RCONST(1.0)
 #define ONEPT5 SUN_RCONST(1.5)
 
+/* Persistent worker pool shared by a vector and its clones. The calling thread
+   acts as thread 0 and the pool holds num_threads - 1 workers that wait on a
+   generation counter for the next companion function to run. An idle thread
+   may poll the shared state a bounded number of times before sleeping on a
+   condition. Each poll only reads the state after acquiring the mutex with
+   pthread_mutex_trylock, so no state is accessed outside of the mutex. */
+
+struct _N_VectorPool_Pthreads
+{
+  int num_threads; /* number of threads (workers + calling thread) */
+  int refcount;    /* number of vectors sharing the pool           */
+  int spin_count;  /* polls before sleeping on a condition         */
+
+  pthread_t* workers;        /* worker threads                     */
+  pthread_mutex_t run_mutex; /* serializes tasks on the pool       */
+  pthread_mutex_t mutex;     /* protects the shared state below    */
+  pthread_cond_t start_cond; /* signals a new task                 */
+  pthread_cond_t done_cond;  /* signals all workers have finished  */
+
+  unsigned long generation; /* task counter                  */
+  int pending;              /* workers yet to finish a task  */
+  int num_active;           /* threads taking part in a task */
+  sunbooleantype shutdown;  /* workers should exit           */
+
+  void* (*task)(void*);   /* companion function to run   */
+  Pthreads_Data* td;      /* per-thread companion data   */
+};
+
+/* Argument passed to a worker thread on creation */
+typedef struct
+{
+  N_VectorPool_Pthreads pool;
+  int id;
+} Pthreads_WorkerArg;
+
 /* Private functions for special cases of vector operations */
 static void VCopy_Pthreads(N_Vector x, N_Vector z);             /* z=x       */
 static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z);  /* z=x+y     */
@@ -144,6 +180,22 @@ static void nvSplitLoop(int myid, int* nthreads, sunindextype* N,
 /* Function to initialize thread data */
 static void nvInitThreadData(Pthreads_Data* thread_data);
 
+/* Functions to manage the persistent worker pool */
+static N_VectorPool_Pthreads nvPoolCreate(int num_threads);
+static void nvPoolRetain(N_VectorPool_Pthreads pool);
+static void nvPoolRelease(N_VectorPool_Pthreads pool);
+static void nvPoolRun(N_VectorPool_Pthreads pool, void* (*task)(void*),
+                      Pthreads_Data* thread_data, int nthreads);
+static void* nvPoolWorker(void* arg);
+
+/* Function to determine the number of threads used for an operation */
+static int nvActiveThreads(N_Vector v);
+
+/* Reproducible reductions and their companion function */
+static sunrealtype VBinnedSum_Pthreads(sunBinnedTerm term, N_Vector x,
+                                       sunrealtype* yd, sunrealtype* zd);
+static void* nvBinnedSumPt(void* thread_data);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -246,10 +298,22 @@ N_Vector N_VNewEmpty_Pthreads(sunindextype length, int num_threads,
   v->content = content;
 
   /* Initialize content */
-  content->length      = length;
-  content->num_threads = num_threads;
-  content->own_data    = SUNFALSE;
-  content->data        = NULL;
+  content->length        = length;
+  content->num_threads   = num_threads;
+  content->own_data      = SUNFALSE;
+  content->data          = NULL;
+  content->serial_length = 0;
+  content->pool          = NULL;
+  content->reproducible  = SUNFALSE;
+
+  /* Create the worker pool */
+  content->pool = nvPoolCreate(num_threads);
+  if (content->pool == NULL)
+  {
+    N_VDestroy_Pthreads(v);
+    SUNAssertNull(SUNFALSE, SUN_ERR_EXT_FAIL);
+    return NULL;
+  }
 
   return (v);
 }
@@ -388,10 +452,16 @@ N_Vector N_VCloneEmpty_Pthreads(N_Vector w)
   v->content = content;
 
   /* Initialize content */
-  content->length      = NV_LENGTH_PT(w);
-  content->num_threads = NV_NUM_THREADS_PT(w);
-  content->own_data    = SUNFALSE;
-  content->data        = NULL;
+  content->length        = NV_LENGTH_PT(w);
+  content->num_threads   = NV_NUM_THREADS_PT(w);
+  content->own_data      = SUNFALSE;
+  content->data          = NULL;
+  content->serial_length = NV_SERIAL_LENGTH_PT(w);
+  content->pool          = NV_POOL_PT(w);
+  content->reproducible  = NV_REPRODUCIBLE_PT(w);
+
+  /* Share the worker pool with the template vector */
+  nvPoolRetain(content->pool);
 
   return (v);
 }
@@ -446,6 +516,8 @@ void N_VDestroy_Pthreads(N_Vector v)
       free(NV_DATA_PT(v));
       NV_DATA_PT(v) = NULL;
     }
+    nvPoolRelease(NV_POOL_PT(v));
+    NV_POOL_PT(v) = NULL;
     free(v->content);
     v->content = NULL;
   }
@@ -499,6 +571,62 @@ void N_VSetArrayPointer_Pthreads(sunrealtype* v_data, N_Vector v)
   return;
 }
 
+/* ----------------------------------------------------------------------------
+ * Set the vector length below which operations are computed by the calling
+ * thread alone rather than dispatched to the worker pool
+ */
+
+SUNErrCode N_VSetSerialLength_Pthreads(N_Vector v, sunindextype serial_length)
+{
+  SUNFunctionBegin(v->sunctx);
+
+  SUNAssert(serial_length >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  NV_SERIAL_LENGTH_PT(v) = serial_length;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Set the number of times an idle thread polls for new work (or for the
+ * workers to finish) before sleeping on a condition variable. The setting
+ * applies to the worker pool shared by the vector and its clones.
+ */
+
+SUNErrCode N_VSetSpinCount_Pthreads(N_Vector v, int spin_count)
+{
+  SUNFunctionBegin(v->sunctx);
+
+  N_VectorPool_Pthreads pool = NV_POOL_PT(v);
+
+  SUNAssert(spin_count >= 0, SUN_ERR_ARG_OUTOFRANGE);
+  SUNAssert(pool, SUN_ERR_ARG_CORRUPT);
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->spin_count = spin_count;
+  pthread_mutex_unlock(&pool->mutex);
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Enable or disable reproducible reductions for a vector and its future
+ * clones. When enabled, the dot product, the norms other than the max norm,
+ * and the weighted square sums are computed with a binned accumulator whose
+ * result does not depend on the number of threads.
+ */
+
+SUNErrCode N_VSetReproducibleReductions_Pthreads(N_Vector v,
+                                                 sunbooleantype reproducible)
+{
+  SUNFunctionBegin(v->sunctx);
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  if (reproducible) { return SUN_ERR_NOT_IMPLEMENTED; }
+#endif
+  NV_REPRODUCIBLE_PT(v) = reproducible;
+  return SUN_SUCCESS;
+}
+
 /* ----------------------------------------------------------------------------
  * Compute linear sum z[i] = a*x[i]+b*y[i]
  */
@@ -510,9 +638,7 @@ void N_VLinearSum_Pthreads(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   sunrealtype c;
   N_Vector v1, v2;
@@ -593,18 +719,14 @@ void N_VLinearSum_Pthreads(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
      (2) a == 0.0, b == other - user should have called N_VScale
      (3) a,b == other, a !=b, a != -b */
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -619,17 +741,12 @@ void N_VLinearSum_Pthreads(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvLinearSumPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvLinearSumPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -662,7 +779,7 @@ static void* nvLinearSumPt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = (a * xd[i]) + (b * yd[i]); }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -675,22 +792,16 @@ void N_VConst_Pthreads(sunrealtype c, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(z);
-  nthreads = NV_NUM_THREADS_PT(z);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(z);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -702,17 +813,12 @@ void N_VConst_Pthreads(sunrealtype c, N_Vector z)
     /* pack thread data */
     thread_data[i].c1 = c;
     thread_data[i].v1 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvConstPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(z), nvConstPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -742,7 +848,7 @@ static void* nvConstPt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = c; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -755,22 +861,16 @@ void N_VProd_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -783,17 +883,12 @@ void N_VProd_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvProdPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvProdPt, thread_data, nthreads);
 
   /* clean up and exit */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -823,7 +918,7 @@ static void* nvProdPt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = xd[i] * yd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -836,22 +931,16 @@ void N_VDiv_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -864,17 +953,12 @@ void N_VDiv_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvDivPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvDivPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -904,7 +988,7 @@ static void* nvDivPt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = xd[i] / yd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -917,9 +1001,7 @@ void N_VScale_Pthreads(sunrealtype c, N_Vector x, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   if (z == x)
   { /* BLAS usage: scale x <- cx */
@@ -939,18 +1021,14 @@ void N_VScale_Pthreads(sunrealtype c, N_Vector x, N_Vector z)
   }
   else
   {
-    /* allocate threads and thread data structs */
+    /* get vector length and number of active threads */
     N        = NV_LENGTH_PT(x);
-    nthreads = NV_NUM_THREADS_PT(x);
-    threads  = malloc(nthreads * sizeof(pthread_t));
-    SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+    nthreads = nvActiveThreads(x);
+
+    /* allocate thread data structs */
     thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
     SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-    /* set thread attributes */
-    pthread_attr_init(&attr);
-    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
     for (i = 0; i < nthreads; i++)
     {
       /* initialize thread data */
@@ -963,17 +1041,12 @@ void N_VScale_Pthreads(sunrealtype c, N_Vector x, N_Vector z)
       thread_data[i].c1 = c;
       thread_data[i].v1 = NV_DATA_PT(x);
       thread_data[i].v2 = NV_DATA_PT(z);
-
-      /* create threads and call pthread companion function */
-      pthread_create(&threads[i], &attr, nvScalePt, (void*)&thread_data[i]);
     }
 
-    /* wait for all threads to finish */
-    for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+    /* run companion function on the thread pool */
+    nvPoolRun(NV_POOL_PT(x), nvScalePt, thread_data, nthreads);
 
     /* clean up */
-    pthread_attr_destroy(&attr);
-    free(threads);
     free(thread_data);
   }
 
@@ -1005,7 +1078,7 @@ static void* nvScalePt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = c * xd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1018,22 +1091,16 @@ void N_VAbs_Pthreads(N_Vector x, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -1045,17 +1112,12 @@ void N_VAbs_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvAbsPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvAbsPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -1084,7 +1146,7 @@ static void* nvAbsPt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = SUNRabs(xd[i]); }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1097,22 +1159,16 @@ void N_VInv_Pthreads(N_Vector x, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -1124,17 +1180,12 @@ void N_VInv_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvInvPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvInvPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -1163,7 +1214,7 @@ static void* nvInvPt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = ONE / xd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1176,22 +1227,16 @@ void N_VAddConst_Pthreads(N_Vector x, sunrealtype b, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -1204,17 +1249,12 @@ void N_VAddConst_Pthreads(N_Vector x, sunrealtype b, N_Vector z)
     thread_data[i].c1 = b;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvAddConstPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvAddConstPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -1245,7 +1285,7 @@ static void* nvAddConstPt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = xd[i] + b; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1258,24 +1298,23 @@ sunrealtype N_VDotProd_Pthreads(N_Vector x, N_Vector y)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  if (NV_REPRODUCIBLE_PT(x))
+  {
+    return (VBinnedSum_Pthreads(SUN_BINNED_DOT, x, NV_DATA_PT(y), NULL));
+  }
+
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1292,18 +1331,13 @@ sunrealtype N_VDotProd_Pthreads(N_Vector x, N_Vector y)
     thread_data[i].v2           = NV_DATA_PT(y);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvDotProdPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvDotProdPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (sum);
@@ -1343,7 +1377,7 @@ static void* nvDotProdPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1356,24 +1390,18 @@ sunrealtype N_VMaxNorm_Pthreads(N_Vector x)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype max = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1389,18 +1417,13 @@ sunrealtype N_VMaxNorm_Pthreads(N_Vector x)
     thread_data[i].v1           = NV_DATA_PT(x);
     thread_data[i].global_val   = &max;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvMaxNormPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvMaxNormPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (max);
@@ -1442,7 +1465,7 @@ static void* nvMaxNormPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1467,24 +1490,23 @@ sunrealtype N_VWSqrSumLocal_Pthreads(N_Vector x, N_Vector w)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  if (NV_REPRODUCIBLE_PT(x))
+  {
+    return (VBinnedSum_Pthreads(SUN_BINNED_WSQR, x, NV_DATA_PT(w), NULL));
+  }
+
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1501,18 +1523,13 @@ sunrealtype N_VWSqrSumLocal_Pthreads(N_Vector x, N_Vector w)
     thread_data[i].v2           = NV_DATA_PT(w);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvWSqrSumPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvWSqrSumPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (sum);
@@ -1552,7 +1569,7 @@ static void* nvWSqrSumPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1577,24 +1594,24 @@ sunrealtype N_VWSqrSumMaskLocal_Pthreads(N_Vector x, N_Vector w, N_Vector id)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  if (NV_REPRODUCIBLE_PT(x))
+  {
+    return (VBinnedSum_Pthreads(SUN_BINNED_WSQR_MASK, x, NV_DATA_PT(w),
+                                NV_DATA_PT(id)));
+  }
+
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1612,18 +1629,13 @@ sunrealtype N_VWSqrSumMaskLocal_Pthreads(N_Vector x, N_Vector w, N_Vector id)
     thread_data[i].v3           = NV_DATA_PT(id);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvWSqrSumMaskPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvWSqrSumMaskPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (sum);
@@ -1667,7 +1679,7 @@ static void* nvWSqrSumMaskPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1680,27 +1692,21 @@ sunrealtype N_VMin_Pthreads(N_Vector x)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype min;
 
   /* initialize global min */
   min = NV_Ith_PT(x, 0);
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1716,18 +1722,13 @@ sunrealtype N_VMin_Pthreads(N_Vector x)
     thread_data[i].v1           = NV_DATA_PT(x);
     thread_data[i].global_val   = &min;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvMinPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvMinPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (min);
@@ -1769,7 +1770,7 @@ static void* nvMinPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1782,24 +1783,24 @@ sunrealtype N_VWL2Norm_Pthreads(N_Vector x, N_Vector w)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  if (NV_REPRODUCIBLE_PT(x))
+  {
+    return (SUNRsqrt(VBinnedSum_Pthreads(SUN_BINNED_WSQR, x, NV_DATA_PT(w),
+                                         NULL)));
+  }
+
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1816,18 +1817,13 @@ sunrealtype N_VWL2Norm_Pthreads(N_Vector x, N_Vector w)
     thread_data[i].v2           = NV_DATA_PT(w);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvWL2NormPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvWL2NormPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (SUNRsqrt(sum));
@@ -1867,7 +1863,7 @@ static void* nvWL2NormPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1880,24 +1876,23 @@ sunrealtype N_VL1Norm_Pthreads(N_Vector x)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype sum = ZERO;
 
-  /* allocate threads and thread data structs */
+  if (NV_REPRODUCIBLE_PT(x))
+  {
+    return (VBinnedSum_Pthreads(SUN_BINNED_ABS, x, NULL, NULL));
+  }
+
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -1913,18 +1908,13 @@ sunrealtype N_VL1Norm_Pthreads(N_Vector x)
     thread_data[i].v1           = NV_DATA_PT(x);
     thread_data[i].global_val   = &sum;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvL1NormPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvL1NormPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (sum);
@@ -1963,7 +1953,7 @@ static void* nvL1NormPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -1976,22 +1966,16 @@ void N_VCompare_Pthreads(sunrealtype c, N_Vector x, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -2004,17 +1988,12 @@ void N_VCompare_Pthreads(sunrealtype c, N_Vector x, N_Vector z)
     thread_data[i].c1 = c;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvComparePt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvComparePt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -2045,7 +2024,7 @@ static void* nvComparePt(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = (SUNRabs(xd[i]) >= c) ? ONE : ZERO; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -2058,24 +2037,18 @@ sunbooleantype N_VInvTest_Pthreads(N_Vector x, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   sunrealtype val = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -2088,17 +2061,12 @@ sunbooleantype N_VInvTest_Pthreads(N_Vector x, N_Vector z)
     thread_data[i].v1         = NV_DATA_PT(x);
     thread_data[i].v2         = NV_DATA_PT(z);
     thread_data[i].global_val = &val;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvInvTestPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvInvTestPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   if (val > ZERO) { return (SUNFALSE); }
@@ -2139,7 +2107,7 @@ static void* nvInvTestPt(void* thread_data)
   if (local_val > ZERO) { *global_val = local_val; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -2152,24 +2120,18 @@ sunbooleantype N_VConstrMask_Pthreads(N_Vector c, N_Vector x, N_Vector m)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   sunrealtype val = ZERO;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -2183,17 +2145,12 @@ sunbooleantype N_VConstrMask_Pthreads(N_Vector c, N_Vector x, N_Vector m)
     thread_data[i].v2         = NV_DATA_PT(x);
     thread_data[i].v3         = NV_DATA_PT(m);
     thread_data[i].global_val = &val;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvConstrMaskPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvConstrMaskPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   if (val > ZERO) { return (SUNFALSE); }
@@ -2244,7 +2201,7 @@ static void* nvConstrMaskPt(void* thread_data)
   if (local_val > ZERO) { *global_val = local_val; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -2257,24 +2214,18 @@ sunrealtype N_VMinQuotient_Pthreads(N_Vector num, N_Vector denom)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
   sunrealtype min = SUN_BIG_REAL;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(num);
-  nthreads = NV_NUM_THREADS_PT(num);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(num);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -2291,18 +2242,13 @@ sunrealtype N_VMinQuotient_Pthreads(N_Vector num, N_Vector denom)
     thread_data[i].v2           = NV_DATA_PT(denom);
     thread_data[i].global_val   = &min;
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvMinQuotientPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(num), nvMinQuotientPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return (min);
@@ -2346,7 +2292,7 @@ static void* nvMinQuotientPt(void* thread_data)
   pthread_mutex_unlock(global_mutex);
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /*
@@ -2366,9 +2312,7 @@ SUNErrCode N_VLinearCombination_Pthreads(int nvec, sunrealtype* c, N_Vector* X,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
@@ -2391,16 +2335,12 @@ SUNErrCode N_VLinearCombination_Pthreads(int nvec, sunrealtype* c, N_Vector* X,
 
   /* get vector length and data array */
   N        = NV_LENGTH_PT(z);
-  nthreads = NV_NUM_THREADS_PT(z);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(z);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -2414,18 +2354,12 @@ SUNErrCode N_VLinearCombination_Pthreads(int nvec, sunrealtype* c, N_Vector* X,
     thread_data[i].cvals = c;
     thread_data[i].Y1    = X;
     thread_data[i].x1    = z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvLinearCombinationPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(z), nvLinearCombinationPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -2464,7 +2398,7 @@ static void* nvLinearCombinationPt(void* thread_data)
       xd = NV_DATA_PT(my_data->Y1[i]);
       for (j = start; j < end; j++) { zd[j] += c[i] * xd[j]; }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   /*
@@ -2478,7 +2412,7 @@ static void* nvLinearCombinationPt(void* thread_data)
       xd = NV_DATA_PT(my_data->Y1[i]);
       for (j = start; j < end; j++) { zd[j] += c[i] * xd[j]; }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   /*
@@ -2491,7 +2425,7 @@ static void* nvLinearCombinationPt(void* thread_data)
     xd = NV_DATA_PT(my_data->Y1[i]);
     for (j = start; j < end; j++) { zd[j] += c[i] * xd[j]; }
   }
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* -----------------------------------------------------------------------------
@@ -2505,9 +2439,7 @@ SUNErrCode N_VScaleAddMulti_Pthreads(int nvec, sunrealtype* a, N_Vector x,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
@@ -2522,16 +2454,12 @@ SUNErrCode N_VScaleAddMulti_Pthreads(int nvec, sunrealtype* a, N_Vector x,
 
   /* get vector length and data array */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -2546,17 +2474,12 @@ SUNErrCode N_VScaleAddMulti_Pthreads(int nvec, sunrealtype* a, N_Vector x,
     thread_data[i].x1    = x;
     thread_data[i].Y1    = Y;
     thread_data[i].Y2    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvScaleAddMultiPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvScaleAddMultiPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -2596,7 +2519,7 @@ static void* nvScaleAddMultiPt(void* thread_data)
       yd = NV_DATA_PT(my_data->Y1[i]);
       for (j = start; j < end; j++) { yd[j] += a[i] * xd[j]; }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   /*
@@ -2608,7 +2531,7 @@ static void* nvScaleAddMultiPt(void* thread_data)
     zd = NV_DATA_PT(my_data->Y2[i]);
     for (j = start; j < end; j++) { zd[j] = a[i] * xd[j] + yd[j]; }
   }
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* -----------------------------------------------------------------------------
@@ -2622,37 +2545,34 @@ SUNErrCode N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
 
   /* should have called N_VDotProd */
-  if (nvec == 1)
+  if (nvec == 1 || NV_REPRODUCIBLE_PT(x))
   {
-    dotprods[0] = N_VDotProd_Pthreads(x, Y[0]);
-    SUNCheckLastErr();
+    for (i = 0; i < nvec; i++)
+    {
+      dotprods[i] = N_VDotProd_Pthreads(x, Y[i]);
+      SUNCheckLastErr();
+    }
     return SUN_SUCCESS;
   }
 
   /* initialize output array */
   for (i = 0; i < nvec; i++) { dotprods[i] = ZERO; }
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -2671,18 +2591,13 @@ SUNErrCode N_VDotProdMulti_Pthreads(int nvec, N_Vector x, N_Vector* Y,
     thread_data[i].cvals = dotprods;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvDotProdMultiPt, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvDotProdMultiPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -2727,7 +2642,7 @@ static void* nvDotProdMultiPt(void* thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /*
@@ -2748,9 +2663,7 @@ SUNErrCode N_VLinearSumVectorArray_Pthreads(int nvec, sunrealtype a,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   sunrealtype c;
   N_Vector* V1;
@@ -2847,16 +2760,12 @@ SUNErrCode N_VLinearSumVectorArray_Pthreads(int nvec, sunrealtype a,
 
   /* get vector length and data array */
   N        = NV_LENGTH_PT(Z[0]);
-  nthreads = NV_NUM_THREADS_PT(Z[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(Z[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -2872,18 +2781,12 @@ SUNErrCode N_VLinearSumVectorArray_Pthreads(int nvec, sunrealtype a,
     thread_data[i].Y1   = X;
     thread_data[i].Y2   = Y;
     thread_data[i].Y3   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvLinearSumVectorArrayPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(Z[0]), nvLinearSumVectorArrayPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -2923,7 +2826,7 @@ static void* nvLinearSumVectorArrayPt(void* thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* -----------------------------------------------------------------------------
@@ -2937,9 +2840,7 @@ SUNErrCode N_VScaleVectorArray_Pthreads(int nvec, sunrealtype* c, N_Vector* X,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
@@ -2954,16 +2855,12 @@ SUNErrCode N_VScaleVectorArray_Pthreads(int nvec, sunrealtype* c, N_Vector* X,
 
   /* get vector length and data array */
   N        = NV_LENGTH_PT(Z[0]);
-  nthreads = NV_NUM_THREADS_PT(Z[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(Z[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -2977,18 +2874,12 @@ SUNErrCode N_VScaleVectorArray_Pthreads(int nvec, sunrealtype* c, N_Vector* X,
     thread_data[i].cvals = c;
     thread_data[i].Y1    = X;
     thread_data[i].Y2    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvScaleVectorArrayPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(Z[0]), nvScaleVectorArrayPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3026,7 +2917,7 @@ static void* nvScaleVectorArrayPt(void* thread_data)
       xd = NV_DATA_PT(my_data->Y1[i]);
       for (j = start; j < end; j++) { xd[j] *= c[i]; }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   /*
@@ -3038,7 +2929,7 @@ static void* nvScaleVectorArrayPt(void* thread_data)
     zd = NV_DATA_PT(my_data->Y2[i]);
     for (j = start; j < end; j++) { zd[j] = c[i] * xd[j]; }
   }
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* -----------------------------------------------------------------------------
@@ -3051,9 +2942,7 @@ SUNErrCode N_VConstVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* Z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   /* invalid number of vectors */
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
@@ -3068,16 +2957,12 @@ SUNErrCode N_VConstVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* Z)
 
   /* get vector length and data array */
   N        = NV_LENGTH_PT(Z[0]);
-  nthreads = NV_NUM_THREADS_PT(Z[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(Z[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -3090,18 +2975,12 @@ SUNErrCode N_VConstVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* Z)
     thread_data[i].nvec = nvec;
     thread_data[i].c1   = c;
     thread_data[i].Y1   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvConstVectorArrayPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(Z[0]), nvConstVectorArrayPt, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3133,7 +3012,7 @@ static void* nvConstVectorArrayPt(void* thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -3147,37 +3026,34 @@ SUNErrCode N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
 
   /* should have called N_VWrmsNorm */
-  if (nvec == 1)
+  if (nvec == 1 || NV_REPRODUCIBLE_PT(X[0]))
   {
-    nrm[0] = N_VWrmsNorm_Pthreads(X[0], W[0]);
-    SUNCheckLastErr();
+    for (i = 0; i < nvec; i++)
+    {
+      nrm[i] = N_VWrmsNorm_Pthreads(X[i], W[i]);
+      SUNCheckLastErr();
+    }
     return SUN_SUCCESS;
   }
 
   /* initialize output array */
   for (i = 0; i < nvec; i++) { nrm[i] = ZERO; }
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -3196,22 +3072,16 @@ SUNErrCode N_VWrmsNormVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* W,
     thread_data[i].cvals = nrm;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvWrmsNormVectorArrayPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), nvWrmsNormVectorArrayPt, thread_data, nthreads);
 
   /* finalize wrms calculation */
   for (i = 0; i < nvec; i++) { nrm[i] = SUNRsqrt(nrm[i] / N); }
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3256,7 +3126,7 @@ static void* nvWrmsNormVectorArrayPt(void* thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -3270,37 +3140,34 @@ SUNErrCode N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector*
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
   pthread_mutex_t global_mutex;
 
   /* invalid number of vectors */
   SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
 
   /* should have called N_VWrmsNorm */
-  if (nvec == 1)
+  if (nvec == 1 || NV_REPRODUCIBLE_PT(X[0]))
   {
-    nrm[0] = N_VWrmsNormMask_Pthreads(X[0], W[0], id);
-    SUNCheckLastErr();
+    for (i = 0; i < nvec; i++)
+    {
+      nrm[i] = N_VWrmsNormMask_Pthreads(X[i], W[i], id);
+      SUNCheckLastErr();
+    }
     return SUN_SUCCESS;
   }
 
   /* initialize output array */
   for (i = 0; i < nvec; i++) { nrm[i] = ZERO; }
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   /* lock for reduction */
   pthread_mutex_init(&global_mutex, NULL);
 
@@ -3320,22 +3187,17 @@ SUNErrCode N_VWrmsNormMaskVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector*
     thread_data[i].cvals = nrm;
 
     thread_data[i].global_mutex = &global_mutex;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvWrmsNormMaskVectorArrayPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), nvWrmsNormMaskVectorArrayPt, thread_data,
+            nthreads);
 
   /* finalize wrms calculation */
   for (i = 0; i < nvec; i++) { nrm[i] = SUNRsqrt(nrm[i] / N); }
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
   pthread_mutex_destroy(&global_mutex);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3385,7 +3247,7 @@ static void* nvWrmsNormMaskVectorArrayPt(void* thread_data)
   }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* -----------------------------------------------------------------------------
@@ -3400,9 +3262,7 @@ SUNErrCode N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum,
 
   sunindextype N;
   int i, j, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   N_Vector* YY;
   N_Vector* ZZ;
@@ -3460,16 +3320,12 @@ SUNErrCode N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum,
 
   /* get vector length and data array */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -3485,18 +3341,13 @@ SUNErrCode N_VScaleAddMultiVectorArray_Pthreads(int nvec, int nsum,
     thread_data[i].Y1    = X;
     thread_data[i].ZZ1   = Y;
     thread_data[i].ZZ2   = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvScaleAddMultiVectorArrayPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), nvScaleAddMultiVectorArrayPt, thread_data,
+            nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3539,7 +3390,7 @@ static void* nvScaleAddMultiVectorArrayPt(void* thread_data)
         for (k = start; k < end; k++) { yd[k] += a[j] * xd[k]; }
       }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   /*
@@ -3555,7 +3406,7 @@ static void* nvScaleAddMultiVectorArrayPt(void* thread_data)
       for (k = start; k < end; k++) { zd[k] = a[j] * xd[k] + yd[k]; }
     }
   }
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* -----------------------------------------------------------------------------
@@ -3570,9 +3421,7 @@ SUNErrCode N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum,
 
   sunindextype N;
   int i, j, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   sunrealtype* ctmp;
   N_Vector* Y;
@@ -3645,16 +3494,12 @@ SUNErrCode N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum,
 
   /* get vector length and data array */
   N        = NV_LENGTH_PT(Z[0]);
-  nthreads = NV_NUM_THREADS_PT(Z[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(Z[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -3669,18 +3514,13 @@ SUNErrCode N_VLinearCombinationVectorArray_Pthreads(int nvec, int nsum,
     thread_data[i].cvals = c;
     thread_data[i].ZZ1   = X;
     thread_data[i].Y1    = Z;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, nvLinearCombinationVectorArrayPt,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(Z[0]), nvLinearCombinationVectorArrayPt, thread_data,
+            nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3723,7 +3563,7 @@ static void* nvLinearCombinationVectorArrayPt(void* thread_data)
         for (k = start; k < end; k++) { zd[k] += c[i] * xd[k]; }
       }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   /*
@@ -3741,7 +3581,7 @@ static void* nvLinearCombinationVectorArrayPt(void* thread_data)
         for (k = start; k < end; k++) { zd[k] += c[i] * xd[k]; }
       }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   /*
@@ -3758,7 +3598,7 @@ static void* nvLinearCombinationVectorArrayPt(void* thread_data)
       for (k = start; k < end; k++) { zd[k] += c[i] * xd[k]; }
     }
   }
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /*
@@ -3787,24 +3627,18 @@ SUNErrCode N_VBufPack_Pthreads(N_Vector x, void* buf)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   SUNAssert(buf, SUN_ERR_ARG_CORRUPT);
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -3816,17 +3650,12 @@ SUNErrCode N_VBufPack_Pthreads(N_Vector x, void* buf)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = (sunrealtype*)buf;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VBufPack_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VBufPack_PT, thread_data, nthreads);
 
   /* clean up */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3855,7 +3684,7 @@ static void* VBufPack_PT(void* thread_data)
   for (i = start; i < end; i++) { bd[i] = xd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* -----------------------------------------------------------------------------
@@ -3868,24 +3697,18 @@ SUNErrCode N_VBufUnpack_Pthreads(N_Vector x, void* buf)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
   SUNAssert(buf, SUN_ERR_ARG_CORRUPT);
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssert(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -3897,17 +3720,12 @@ SUNErrCode N_VBufUnpack_Pthreads(N_Vector x, void* buf)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = (sunrealtype*)buf;
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VBufUnpack_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VBufUnpack_PT, thread_data, nthreads);
 
   /* clean up */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return SUN_SUCCESS;
@@ -3936,7 +3754,7 @@ static void* VBufUnpack_PT(void* thread_data)
   for (i = start; i < end; i++) { xd[i] = bd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /*
@@ -3955,22 +3773,16 @@ static void VCopy_Pthreads(N_Vector x, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -3982,17 +3794,12 @@ static void VCopy_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VCopy_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VCopy_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4021,7 +3828,7 @@ static void* VCopy_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = xd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4034,22 +3841,16 @@ static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4062,17 +3863,12 @@ static void VSum_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VSum_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VSum_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4102,7 +3898,7 @@ static void* VSum_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = xd[i] + yd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4115,22 +3911,16 @@ static void VDiff_Pthreads(N_Vector x, N_Vector y, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4143,17 +3933,12 @@ static void VDiff_Pthreads(N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VDiff_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VDiff_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4183,7 +3968,7 @@ static void* VDiff_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = xd[i] - yd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4196,22 +3981,16 @@ static void VNeg_Pthreads(N_Vector x, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4223,17 +4002,12 @@ static void VNeg_Pthreads(N_Vector x, N_Vector z)
     /* pack thread data */
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VNeg_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VNeg_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4262,7 +4036,7 @@ static void* VNeg_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = -xd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4275,22 +4049,16 @@ static void VScaleSum_Pthreads(sunrealtype c, N_Vector x, N_Vector y, N_Vector z
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4304,17 +4072,12 @@ static void VScaleSum_Pthreads(sunrealtype c, N_Vector x, N_Vector y, N_Vector z
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleSum_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VScaleSum_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4346,7 +4109,7 @@ static void* VScaleSum_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = c * (xd[i] + yd[i]); }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4359,22 +4122,16 @@ static void VScaleDiff_Pthreads(sunrealtype c, N_Vector x, N_Vector y, N_Vector
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4388,17 +4145,12 @@ static void VScaleDiff_Pthreads(sunrealtype c, N_Vector x, N_Vector y, N_Vector
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleDiff_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VScaleDiff_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4430,7 +4182,7 @@ static void* VScaleDiff_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = c * (xd[i] - yd[i]); }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4443,22 +4195,16 @@ static void VLin1_Pthreads(sunrealtype a, N_Vector x, N_Vector y, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4472,17 +4218,12 @@ static void VLin1_Pthreads(sunrealtype a, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VLin1_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VLin1_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4514,7 +4255,7 @@ static void* VLin1_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = (a * xd[i]) + yd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4527,22 +4268,16 @@ static void VLin2_Pthreads(sunrealtype a, N_Vector x, N_Vector y, N_Vector z)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4556,17 +4291,12 @@ static void VLin2_Pthreads(sunrealtype a, N_Vector x, N_Vector y, N_Vector z)
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
     thread_data[i].v3 = NV_DATA_PT(z);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VLin2_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VLin2_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4598,7 +4328,7 @@ static void* VLin2_PT(void* thread_data)
   for (i = start; i < end; i++) { zd[i] = (a * xd[i]) - yd[i]; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4611,22 +4341,16 @@ static void Vaxpy_Pthreads(sunrealtype a, N_Vector x, N_Vector y)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4639,17 +4363,12 @@ static void Vaxpy_Pthreads(sunrealtype a, N_Vector x, N_Vector y)
     thread_data[i].c1 = a;
     thread_data[i].v1 = NV_DATA_PT(x);
     thread_data[i].v2 = NV_DATA_PT(y);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, Vaxpy_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), Vaxpy_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4682,7 +4401,7 @@ static void* Vaxpy_PT(void* thread_data)
     for (i = start; i < end; i++) { yd[i] += xd[i]; }
 
     /* exit */
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   if (a == -ONE)
@@ -4690,13 +4409,13 @@ static void* Vaxpy_PT(void* thread_data)
     for (i = start; i < end; i++) { yd[i] -= xd[i]; }
 
     /* exit */
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   for (i = start; i < end; i++) { yd[i] += a * xd[i]; }
 
   /* return */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /* ----------------------------------------------------------------------------
@@ -4709,22 +4428,16 @@ static void VScaleBy_Pthreads(sunrealtype a, N_Vector x)
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(x);
-  nthreads = NV_NUM_THREADS_PT(x);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
   for (i = 0; i < nthreads; i++)
   {
     /* initialize thread data */
@@ -4736,17 +4449,12 @@ static void VScaleBy_Pthreads(sunrealtype a, N_Vector x)
     /* pack thread data */
     thread_data[i].c1 = a;
     thread_data[i].v1 = NV_DATA_PT(x);
-
-    /* create threads and call pthread companion function */
-    pthread_create(&threads[i], &attr, VScaleBy_PT, (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), VScaleBy_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 
   return;
@@ -4776,7 +4484,7 @@ static void* VScaleBy_PT(void* thread_data)
   for (i = start; i < end; i++) { xd[i] *= a; }
 
   /* exit */
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /*
@@ -4792,23 +4500,17 @@ static void VSumVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i = 0; i < nthreads; i++)
   {
     nvInitThreadData(&thread_data[i]);
@@ -4819,17 +4521,12 @@ static void VSumVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y,
     thread_data[i].Y3   = Z;
 
     nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VSumVectorArray_PT,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), VSumVectorArray_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 }
 
@@ -4855,7 +4552,7 @@ static void* VSumVectorArray_PT(void* thread_data)
     for (j = start; j < end; j++) { zd[j] = xd[j] + yd[j]; }
   }
 
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 static void VDiffVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y,
@@ -4865,23 +4562,17 @@ static void VDiffVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i = 0; i < nthreads; i++)
   {
     nvInitThreadData(&thread_data[i]);
@@ -4892,17 +4583,12 @@ static void VDiffVectorArray_Pthreads(int nvec, N_Vector* X, N_Vector* Y,
     thread_data[i].Y3   = Z;
 
     nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VDiffVectorArray_PT,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), VDiffVectorArray_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 }
 
@@ -4928,7 +4614,7 @@ static void* VDiffVectorArray_PT(void* thread_data)
     for (j = start; j < end; j++) { zd[j] = xd[j] - yd[j]; }
   }
 
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 static void VScaleSumVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* X,
@@ -4938,23 +4624,17 @@ static void VScaleSumVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* X,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i = 0; i < nthreads; i++)
   {
     nvInitThreadData(&thread_data[i]);
@@ -4966,17 +4646,12 @@ static void VScaleSumVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* X,
     thread_data[i].Y3   = Z;
 
     nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VScaleSumVectorArray_PT,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), VScaleSumVectorArray_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 }
 
@@ -5004,7 +4679,7 @@ static void* VScaleSumVectorArray_PT(void* thread_data)
     for (j = start; j < end; j++) { zd[j] = c * (xd[j] + yd[j]); }
   }
 
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 static void VScaleDiffVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* X,
@@ -5014,23 +4689,17 @@ static void VScaleDiffVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* X,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i = 0; i < nthreads; i++)
   {
     nvInitThreadData(&thread_data[i]);
@@ -5042,17 +4711,12 @@ static void VScaleDiffVectorArray_Pthreads(int nvec, sunrealtype c, N_Vector* X,
     thread_data[i].Y3   = Z;
 
     nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VScaleDiffVectorArray_PT,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), VScaleDiffVectorArray_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 }
 
@@ -5080,7 +4744,7 @@ static void* VScaleDiffVectorArray_PT(void* thread_data)
     for (j = start; j < end; j++) { zd[j] = c * (xd[j] - yd[j]); }
   }
 
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 static void VLin1VectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
@@ -5090,23 +4754,17 @@ static void VLin1VectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i = 0; i < nthreads; i++)
   {
     nvInitThreadData(&thread_data[i]);
@@ -5118,17 +4776,12 @@ static void VLin1VectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
     thread_data[i].Y3   = Z;
 
     nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VLin1VectorArray_PT,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), VLin1VectorArray_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 }
 
@@ -5156,7 +4809,7 @@ static void* VLin1VectorArray_PT(void* thread_data)
     for (j = start; j < end; j++) { zd[j] = (a * xd[j]) + yd[j]; }
   }
 
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 static void VLin2VectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
@@ -5166,23 +4819,17 @@ static void VLin2VectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i = 0; i < nthreads; i++)
   {
     nvInitThreadData(&thread_data[i]);
@@ -5194,17 +4841,12 @@ static void VLin2VectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
     thread_data[i].Y3   = Z;
 
     nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VLin2VectorArray_PT,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), VLin2VectorArray_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 }
 
@@ -5232,7 +4874,7 @@ static void* VLin2VectorArray_PT(void* thread_data)
     for (j = start; j < end; j++) { zd[j] = (a * xd[j]) - yd[j]; }
   }
 
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 static void VaxpyVectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
@@ -5242,23 +4884,17 @@ static void VaxpyVectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
 
   sunindextype N;
   int i, nthreads;
-  pthread_t* threads;
   Pthreads_Data* thread_data;
-  pthread_attr_t attr;
 
-  /* allocate threads and thread data structs */
+  /* get vector length and number of active threads */
   N        = NV_LENGTH_PT(X[0]);
-  nthreads = NV_NUM_THREADS_PT(X[0]);
-  threads  = malloc(nthreads * sizeof(pthread_t));
-  SUNAssertVoid(threads, SUN_ERR_MALLOC_FAIL);
+  nthreads = nvActiveThreads(X[0]);
+
+  /* allocate thread data structs */
   thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
   SUNAssertVoid(thread_data, SUN_ERR_MALLOC_FAIL);
 
-  /* set thread attributes */
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  /* pack thread data, distribute loop indices, and create threads/call kernel */
+  /* pack thread data and distribute loop indices */
   for (i = 0; i < nthreads; i++)
   {
     nvInitThreadData(&thread_data[i]);
@@ -5269,17 +4905,12 @@ static void VaxpyVectorArray_Pthreads(int nvec, sunrealtype a, N_Vector* X,
     thread_data[i].Y2   = Y;
 
     nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
-
-    pthread_create(&threads[i], &attr, VaxpyVectorArray_PT,
-                   (void*)&thread_data[i]);
   }
 
-  /* wait for all threads to finish */
-  for (i = 0; i < nthreads; i++) { pthread_join(threads[i], NULL); }
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(X[0]), VaxpyVectorArray_PT, thread_data, nthreads);
 
   /* clean up and return */
-  pthread_attr_destroy(&attr);
-  free(threads);
   free(thread_data);
 }
 
@@ -5306,7 +4937,7 @@ static void* VaxpyVectorArray_PT(void* thread_data)
       yd = NV_DATA_PT(my_data->Y2[i]);
       for (j = start; j < end; j++) { yd[j] += xd[j]; }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   if (a == -ONE)
@@ -5317,7 +4948,7 @@ static void* VaxpyVectorArray_PT(void* thread_data)
       yd = NV_DATA_PT(my_data->Y2[i]);
       for (j = start; j < end; j++) { yd[j] -= xd[j]; }
     }
-    pthread_exit(NULL);
+    return (NULL);
   }
 
   for (i = 0; i < my_data->nvec; i++)
@@ -5326,7 +4957,7 @@ static void* VaxpyVectorArray_PT(void* thread_data)
     yd = NV_DATA_PT(my_data->Y2[i]);
     for (j = start; j < end; j++) { yd[j] += a * xd[j]; }
   }
-  pthread_exit(NULL);
+  return (NULL);
 }
 
 /*
@@ -5390,6 +5021,335 @@ static void nvInitThreadData(Pthreads_Data* thread_data)
   thread_data->Y1    = NULL;
   thread_data->Y2    = NULL;
   thread_data->Y3    = NULL;
+
+  thread_data->term       = 0;
+  thread_data->global_sum = NULL;
+}
+
+/* ----------------------------------------------------------------------------
+ * Reproducible sum of the terms of x and the data arrays yd and zd. Each
+ * thread accumulates its part of the vector in a binned sum and the exact
+ * merge of the partial sums makes the result independent of the number of
+ * threads.
+ */
+
+static sunrealtype VBinnedSum_Pthreads(sunBinnedTerm term, N_Vector x,
+                                       sunrealtype* yd, sunrealtype* zd)
+{
+  SUNFunctionBegin(x->sunctx);
+
+  sunindextype N;
+  int i, nthreads;
+  Pthreads_Data* thread_data;
+  pthread_mutex_t global_mutex;
+  sunBinnedSum sum;
+
+  /* get vector length and number of active threads */
+  N        = NV_LENGTH_PT(x);
+  nthreads = nvActiveThreads(x);
+
+  /* allocate thread data structs */
+  thread_data = (Pthreads_Data*)malloc(nthreads * sizeof(struct _Pthreads_Data));
+  SUNAssert(thread_data, SUN_ERR_MALLOC_FAIL);
+
+  /* lock for reduction */
+  pthread_mutex_init(&global_mutex, NULL);
+  sunBinnedSum_Init(&sum);
+
+  for (i = 0; i < nthreads; i++)
+  {
+    /* initialize thread data */
+    nvInitThreadData(&thread_data[i]);
+
+    /* compute start and end loop index for thread */
+    nvSplitLoop(i, &nthreads, &N, &thread_data[i].start, &thread_data[i].end);
+
+    /* pack thread data */
+    thread_data[i].v1           = NV_DATA_PT(x);
+    thread_data[i].v2           = yd;
+    thread_data[i].v3           = zd;
+    thread_data[i].term         = (int)term;
+    thread_data[i].global_sum   = &sum;
+    thread_data[i].global_mutex = &global_mutex;
+  }
+
+  /* run companion function on the thread pool */
+  nvPoolRun(NV_POOL_PT(x), nvBinnedSumPt, thread_data, nthreads);
+
+  /* clean up and return */
+  pthread_mutex_destroy(&global_mutex);
+  free(thread_data);
+
+  return ((sunrealtype)sunBinnedSum_Value(&sum));
+}
+
+/* ----------------------------------------------------------------------------
+ * Pthread companion function to the reproducible reductions
+ */
+
+static void* nvBinnedSumPt(void* thread_data)
+{
+  Pthreads_Data* my_data;
+  sunBinnedSum local_sum;
+
+  /* extract thread data */
+  my_data = (Pthreads_Data*)thread_data;
+
+  /* accumulate the terms of this thread */
+  sunBinnedSum_Init(&local_sum);
+  sunBinnedSum_AddRange(&local_sum, (sunBinnedTerm)my_data->term, my_data->v1,
+                        my_data->v2, my_data->v3, my_data->start, my_data->end);
+
+  /* update global sum */
+  pthread_mutex_lock(my_data->global_mutex);
+  sunBinnedSum_Merge((sunBinnedSum*)my_data->global_sum, &local_sum);
+  pthread_mutex_unlock(my_data->global_mutex);
+
+  /* exit */
+  return (NULL);
+}
+
+/* ----------------------------------------------------------------------------
+ * Determine the number of threads used for an operation on v
+ */
+
+static int nvActiveThreads(N_Vector v)
+{
+  if (NV_LENGTH_PT(v) < NV_SERIAL_LENGTH_PT(v)) { return 1; }
+  return NV_NUM_THREADS_PT(v);
+}
+
+/* ----------------------------------------------------------------------------
+ * Create a worker pool with num_threads - 1 worker threads
+ */
+
+static N_VectorPool_Pthreads nvPoolCreate(int num_threads)
+{
+  int i, nworkers;
+  N_VectorPool_Pthreads pool;
+  Pthreads_WorkerArg* args;
+
+  pool = (N_VectorPool_Pthreads)malloc(sizeof *pool);
+  if (pool == NULL) { return NULL; }
+
+  pool->num_threads = (num_threads > 1) ? num_threads : 1;
+  pool->refcount    = 1;
+  pool->spin_count  = 0;
+  pool->workers     = NULL;
+  pool->generation  = 0;
+  pool->pending     = 0;
+  pool->num_active  = 0;
+  pool->shutdown    = SUNFALSE;
+  pool->task        = NULL;
+  pool->td          = NULL;
+
+  pthread_mutex_init(&pool->run_mutex, NULL);
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->start_cond, NULL);
+  pthread_cond_init(&pool->done_cond, NULL);
+
+  nworkers = pool->num_threads - 1;
+  if (nworkers == 0) { return pool; }
+
+  pool->workers = (pthread_t*)malloc(nworkers * sizeof(pthread_t));
+  args = (Pthreads_WorkerArg*)malloc(nworkers * sizeof(Pthreads_WorkerArg));
+  if (pool->workers == NULL || args == NULL)
+  {
+    free(args);
+    pool->num_threads = 1;
+    nvPoolRelease(pool);
+    return NULL;
+  }
+
+  /* the workers copy their argument before signaling they have started */
+  pthread_mutex_lock(&pool->mutex);
+  for (i = 0; i < nworkers; i++)
+  {
+    args[i].pool = pool;
+    args[i].id   = i + 1;
+    if (pthread_create(&pool->workers[i], NULL, nvPoolWorker, &args[i]))
+    {
+      /* stop the workers created so far */
+      pool->num_threads = i + 1;
+      pool->pending += i;
+      while (pool->pending > 0)
+      {
+        pthread_cond_wait(&pool->done_cond, &pool->mutex);
+      }
+      pthread_mutex_unlock(&pool->mutex);
+      free(args);
+      nvPoolRelease(pool);
+      return NULL;
+    }
+  }
+  pool->pending += nworkers;
+  while (pool->pending > 0) { pthread_cond_wait(&pool->done_cond, &pool->mutex); }
+  pthread_mutex_unlock(&pool->mutex);
+
+  free(args);
+
+  return pool;
+}
+
+/* ----------------------------------------------------------------------------
+ * Add or remove a reference to a worker pool, the last release joins the
+ * workers and frees the pool
+ */
+
+static void nvPoolRetain(N_VectorPool_Pthreads pool)
+{
+  if (pool == NULL) { return; }
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->refcount++;
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+static void nvPoolRelease(N_VectorPool_Pthreads pool)
+{
+  int i, refcount;
+
+  if (pool == NULL) { return; }
+
+  pthread_mutex_lock(&pool->mutex);
+  refcount = --pool->refcount;
+  if (refcount == 0)
+  {
+    pool->shutdown = SUNTRUE;
+    pthread_cond_broadcast(&pool->start_cond);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+
+  if (refcount > 0) { return; }
+
+  for (i = 0; i < pool->num_threads - 1; i++)
+  {
+    pthread_join(pool->workers[i], NULL);
+  }
+
+  pthread_cond_destroy(&pool->done_cond);
+  pthread_cond_destroy(&pool->start_cond);
+  pthread_mutex_destroy(&pool->mutex);
+  pthread_mutex_destroy(&pool->run_mutex);
+  free(pool->workers);
+  free(pool);
+}
+
+/* ----------------------------------------------------------------------------
+ * Run a companion function on nthreads threads of the pool. The calling
+ * thread computes thread_data[0] and the workers compute the remaining
+ * entries. Returns once every thread has finished.
+ */
+
+static void nvPoolRun(N_VectorPool_Pthreads pool, void* (*task)(void*),
+                      Pthreads_Data* thread_data, int nthreads)
+{
+  int k, spin_count;
+  sunbooleantype locked;
+
+  /* nothing to share, compute on the calling thread */
+  if (nthreads <= 1 || pool->num_threads <= 1)
+  {
+    task((void*)&thread_data[0]);
+    return;
+  }
+
+  pthread_mutex_lock(&pool->run_mutex);
+
+  /* publish the task and wake the workers */
+  pthread_mutex_lock(&pool->mutex);
+  pool->task       = task;
+  pool->td         = thread_data;
+  pool->num_active = SUNMIN(nthreads, pool->num_threads);
+  pool->pending    = pool->num_active - 1;
+  pool->generation++;
+  spin_count = pool->spin_count;
+  pthread_cond_broadcast(&pool->start_cond);
+  pthread_mutex_unlock(&pool->mutex);
+
+  /* compute this thread's share */
+  task((void*)&thread_data[0]);
+
+  /* poll then sleep until the workers are done */
+  locked = SUNFALSE;
+  for (k = 0; k < spin_count && !locked; k++)
+  {
+    if (pthread_mutex_trylock(&pool->mutex)) { continue; }
+    if (pool->pending == 0) { locked = SUNTRUE; }
+    else { pthread_mutex_unlock(&pool->mutex); }
+  }
+  if (!locked) { pthread_mutex_lock(&pool->mutex); }
+  while (pool->pending > 0) { pthread_cond_wait(&pool->done_cond, &pool->mutex); }
+  pool->task = NULL;
+  pool->td   = NULL;
+  pthread_mutex_unlock(&pool->mutex);
+
+  pthread_mutex_unlock(&pool->run_mutex);
+}
+
+/* ----------------------------------------------------------------------------
+ * Worker thread loop, wait for a new task generation and run the companion
+ * function on the worker's share of the data
+ */
+
+static void* nvPoolWorker(void* arg)
+{
+  int id, k, spin_count;
+  sunbooleantype locked;
+  unsigned long generation;
+  void* (*task)(void*);
+  Pthreads_Data* td;
+  N_VectorPool_Pthreads pool;
+
+  pool = ((Pthreads_WorkerArg*)arg)->pool;
+  id   = ((Pthreads_WorkerArg*)arg)->id;
+
+  /* signal the creating thread that the argument has been read */
+  pthread_mutex_lock(&pool->mutex);
+  generation = pool->generation;
+  if (--pool->pending == 0) { pthread_cond_signal(&pool->done_cond); }
+
+  for (;;)
+  {
+    /* poll then sleep until a new task is posted */
+    if (pool->generation == generation && !pool->shutdown)
+    {
+      spin_count = pool->spin_count;
+      pthread_mutex_unlock(&pool->mutex);
+      locked = SUNFALSE;
+      for (k = 0; k < spin_count && !locked; k++)
+      {
+        if (pthread_mutex_trylock(&pool->mutex)) { continue; }
+        if (pool->generation != generation || pool->shutdown)
+        {
+          locked = SUNTRUE;
+        }
+        else { pthread_mutex_unlock(&pool->mutex); }
+      }
+      if (!locked) { pthread_mutex_lock(&pool->mutex); }
+    }
+    while (pool->generation == generation && !pool->shutdown)
+    {
+      pthread_cond_wait(&pool->start_cond, &pool->mutex);
+    }
+    if (pool->shutdown) { break; }
+
+    generation = pool->generation;
+    if (id >= pool->num_active) { continue; }
+
+    task = pool->task;
+    td   = pool->td;
+    pthread_mutex_unlock(&pool->mutex);
+
+    task((void*)&td[id]);
+
+    pthread_mutex_lock(&pool->mutex);
+    if (--pool->pending == 0) { pthread_cond_signal(&pool->done_cond); }
+  }
+
+  pthread_mutex_unlock(&pool->mutex);
+
+  return (NULL);
 }
 
 /*
@@ -25,6 +25,7 @@
 #include <sundials/sundials_core.h>
 #include <sundials/sundials_errors.h>
 
+#include "nvector_serial_simd.h"
 #include "sundials_macros.h"
 
 #define ZERO   SUN_RCONST(0.0)
@@ -182,7 +183,7 @@ N_Vector N_VNew_Serial(sunindextype length, SUNContext sunctx)
   data = NULL;
   if (length > 0)
   {
-    data = (sunrealtype*)malloc(length * sizeof(sunrealtype));
+    data = nvSerialSIMDAlloc(length);
     SUNAssertNull(data, SUN_ERR_MALLOC_FAIL);
   }
 
@@ -326,7 +327,7 @@ N_Vector N_VClone_Serial(N_Vector w)
   data = NULL;
   if (length > 0)
   {
-    data = (sunrealtype*)malloc(length * sizeof(sunrealtype));
+    data = nvSerialSIMDAlloc(length);
     SUNAssertNull(data, SUN_ERR_MALLOC_FAIL);
 
     /* Attach data */
@@ -481,6 +482,12 @@ void N_VLinearSum_Serial(sunrealtype a, N_Vector x, sunrealtype b, N_Vector y,
   yd = NV_DATA_S(y);
   zd = NV_DATA_S(z);
 
+  if (nvSerialSIMD)
+  {
+    nvSerialSIMD->linearsum(N, a, xd, b, yd, zd);
+    return;
+  }
+
   for (i = 0; i < N; i++) { zd[i] = (a * xd[i]) + (b * yd[i]); }
 
   return;
@@ -621,6 +628,8 @@ sunrealtype N_VDotProd_Serial(N_Vector x, N_Vector y)
   xd = NV_DATA_S(x);
   yd = NV_DATA_S(y);
 
+  if (nvSerialSIMD) { return nvSerialSIMD->dotprod(N, xd, yd); }
+
   for (i = 0; i < N; i++) { sum += xd[i] * yd[i]; }
 
   return (sum);
@@ -637,6 +646,8 @@ sunrealtype N_VMaxNorm_Serial(N_Vector x)
   N  = NV_LENGTH_S(x);
   xd = NV_DATA_S(x);
 
+  if (nvSerialSIMD) { return nvSerialSIMD->maxnorm(N, xd); }
+
   for (i = 0; i < N; i++)
   {
     if (SUNRabs(xd[i]) > max) { max = SUNRabs(xd[i]); }
@@ -666,6 +677,8 @@ sunrealtype N_VWSqrSumLocal_Serial(N_Vector x, N_Vector w)
   xd = NV_DATA_S(x);
   wd = NV_DATA_S(w);
 
+  if (nvSerialSIMD) { return nvSerialSIMD->wsqrsum(N, xd, wd); }
+
   for (i = 0; i < N; i++)
   {
     prodi = xd[i] * wd[i];
@@ -697,6 +710,8 @@ sunrealtype N_VWSqrSumMaskLocal_Serial(N_Vector x, N_Vector w, N_Vector id)
   wd  = NV_DATA_S(w);
   idd = NV_DATA_S(id);
 
+  if (nvSerialSIMD) { return nvSerialSIMD->wsqrsummask(N, xd, wd, idd); }
+
   for (i = 0; i < N; i++)
   {
     if (idd[i] > ZERO)
@@ -719,6 +734,8 @@ sunrealtype N_VMin_Serial(N_Vector x)
   N  = NV_LENGTH_S(x);
   xd = NV_DATA_S(x);
 
+  if (nvSerialSIMD) { return nvSerialSIMD->min(N, xd); }
+
   min = xd[0];
 
   for (i = 1; i < N; i++)
@@ -741,6 +758,8 @@ sunrealtype N_VWL2Norm_Serial(N_Vector x, N_Vector w)
   xd = NV_DATA_S(x);
   wd = NV_DATA_S(w);
 
+  if (nvSerialSIMD) { return SUNRsqrt(nvSerialSIMD->wsqrsum(N, xd, wd)); }
+
   for (i = 0; i < N; i++)
   {
     prodi = xd[i] * wd[i];
@@ -761,6 +780,8 @@ sunrealtype N_VL1Norm_Serial(N_Vector x)
   N  = NV_LENGTH_S(x);
   xd = NV_DATA_S(x);
 
+  if (nvSerialSIMD) { return nvSerialSIMD->l1norm(N, xd); }
+
   for (i = 0; i < N; i++) { sum += SUNRabs(xd[i]); }
 
   return (sum);
@@ -849,6 +870,8 @@ sunrealtype N_VMinQuotient_Serial(N_Vector num, N_Vector denom)
   nd = NV_DATA_S(num);
   dd = NV_DATA_S(denom);
 
+  if (nvSerialSIMD) { return nvSerialSIMD->minquotient(N, nd, dd); }
+
   notEvenOnce = SUNTRUE;
   min         = SUN_BIG_REAL;
 
@@ -904,6 +927,13 @@ SUNErrCode N_VLinearCombination_Serial(int nvec, sunrealtype* c, N_Vector* X,
     return SUN_SUCCESS;
   }
 
+  /* one pass over z covers all of the cases below, X[0] may be z */
+  if (nvSerialSIMD)
+  {
+    nvSerialSIMDLinearCombination(nvec, c, X, z);
+    return SUN_SUCCESS;
+  }
+
   /* get vector length and data array */
   N  = NV_LENGTH_S(z);
   zd = NV_DATA_S(z);
@@ -969,6 +999,13 @@ SUNErrCode N_VScaleAddMulti_Serial(int nvec, sunrealtype* a, N_Vector x,
     return SUN_SUCCESS;
   }
 
+  /* Y may be Z */
+  if (nvSerialSIMD)
+  {
+    nvSerialSIMDScaleAddMulti(nvec, a, x, Y, Z);
+    return SUN_SUCCESS;
+  }
+
   /* get vector length and data array */
   N  = NV_LENGTH_S(x);
   xd = NV_DATA_S(x);
@@ -1018,6 +1055,12 @@ SUNErrCode N_VDotProdMulti_Serial(int nvec, N_Vector x, N_Vector* Y,
     return SUN_SUCCESS;
   }
 
+  if (nvSerialSIMD)
+  {
+    nvSerialSIMDDotProdMulti(nvec, x, Y, dotprods);
+    return SUN_SUCCESS;
+  }
+
   /* get vector length and data array */
   N  = NV_LENGTH_S(x);
   xd = NV_DATA_S(x);
@@ -1151,6 +1194,11 @@ SUNErrCode N_VLinearSumVectorArray_Serial(int nvec, sunrealtype a, N_Vector* X,
     xd = NV_DATA_S(X[i]);
     yd = NV_DATA_S(Y[i]);
     zd = NV_DATA_S(Z[i]);
+    if (nvSerialSIMD)
+    {
+      nvSerialSIMD->linearsum(N, a, xd, b, yd, zd);
+      continue;
+    }
     for (j = 0; j < N; j++) { zd[j] = a * xd[j] + b * yd[j]; }
   }
 
@@ -1265,7 +1313,11 @@ SUNErrCode N_VWrmsNormVectorArray_Serial(int nvec, N_Vector* X, N_Vector* W,
     xd     = NV_DATA_S(X[i]);
     wd     = NV_DATA_S(W[i]);
     nrm[i] = ZERO;
-    for (j = 0; j < N; j++) { nrm[i] += SUNSQR(xd[j] * wd[j]); }
+    if (nvSerialSIMD) { nrm[i] = nvSerialSIMD->wsqrsum(N, xd, wd); }
+    else
+    {
+      for (j = 0; j < N; j++) { nrm[i] += SUNSQR(xd[j] * wd[j]); }
+    }
     nrm[i] = SUNRsqrt(nrm[i] / N);
   }
 
@@ -1303,9 +1355,13 @@ SUNErrCode N_VWrmsNormMaskVectorArray_Serial(int nvec, N_Vector* X, N_Vector* W,
     xd     = NV_DATA_S(X[i]);
     wd     = NV_DATA_S(W[i]);
     nrm[i] = ZERO;
-    for (j = 0; j < N; j++)
+    if (nvSerialSIMD) { nrm[i] = nvSerialSIMD->wsqrsummask(N, xd, wd, idd); }
+    else
     {
-      if (idd[j] > ZERO) { nrm[i] += SUNSQR(xd[j] * wd[j]); }
+      for (j = 0; j < N; j++)
+      {
+        if (idd[j] > ZERO) { nrm[i] += SUNSQR(xd[j] * wd[j]); }
+      }
     }
     nrm[i] = SUNRsqrt(nrm[i] / N);
   }
@@ -1378,6 +1434,16 @@ SUNErrCode N_VScaleAddMultiVectorArray_Serial(int nvec, int nsum,
    * Compute multiple linear sums
    * ---------------------------- */
 
+  /* Y may be Z */
+  if (nvSerialSIMD)
+  {
+    for (i = 0; i < nvec; i++)
+    {
+      nvSerialSIMDScaleAddMultiArray(nsum, a, X[i], Y, Z, i);
+    }
+    return SUN_SUCCESS;
+  }
+
   /* get vector length */
   N = NV_LENGTH_S(X[0]);
 
@@ -1495,6 +1561,16 @@ SUNErrCode N_VLinearCombinationVectorArray_Serial(int nvec, int nsum,
    * Compute linear combination
    * -------------------------- */
 
+  /* one pass over each Z[j] covers all of the cases below */
+  if (nvSerialSIMD)
+  {
+    for (j = 0; j < nvec; j++)
+    {
+      nvSerialSIMDLinearCombinationArray(nsum, c, X, j, Z[j]);
+    }
+    return SUN_SUCCESS;
+  }
+
   /* get vector length */
   N = NV_LENGTH_S(Z[0]);
 
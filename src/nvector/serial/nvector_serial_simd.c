@@ -0,0 +1,395 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the SIMD kernels of the
+ * serial NVECTOR. The kernels are compiled for SSE2, AVX2, and
+ * AVX-512 with function target attributes, so the library does not
+ * need to be built for a particular CPU. The kernels change the
+ * order of the floating-point operations, so they are only used
+ * after N_VSetSIMDLevel_Serial selects an instruction set.
+ * -----------------------------------------------------------------*/
+
+#if defined(SUNDIALS_NVECSERIAL_SIMD) && !defined(_WIN32) && \
+  !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L /* posix_memalign */
+#endif
+
+#include <stdlib.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_math.h>
+
+#include "nvector_serial_simd.h"
+#include "sundials_macros.h"
+
+#if defined(SUNDIALS_NVECSERIAL_SIMD) &&                                   \
+  (defined(SUNDIALS_DOUBLE_PRECISION) || defined(SUNDIALS_SINGLE_PRECISION))
+#define NVSIMD_ENABLED
+#include <immintrin.h>
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+
+/* The scalar loops are used until an instruction set is selected, so no
+   initialization is needed when vectors are created */
+const nvSerialSIMDKernels* nvSerialSIMD = NULL;
+
+static N_VSIMDLevel nvsimd_level = N_VSIMD_NONE;
+
+#if defined(NVSIMD_ENABLED)
+
+#define SIMD_PASTE_(name, isa) name##_##isa
+#define SIMD_PASTE(name, isa)  SIMD_PASTE_(name, isa)
+#define SIMD_FN(name)          SIMD_PASTE(nvSIMD##name, SIMD_ISA)
+
+/* -----------------------------------------------------------------
+ * SSE2
+ * ----------------------------------------------------------------*/
+
+#define SIMD_ISA    sse2
+#define SIMD_TARGET __attribute__((target("sse2")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_T            __m128d
+#define SIMD_W            2
+#define SIMD_LOAD(p)      _mm_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm_set1_pd(s)
+#define SIMD_ADD(a, b)    _mm_add_pd(a, b)
+#define SIMD_MUL(a, b)    _mm_mul_pd(a, b)
+#define SIMD_DIV(a, b)    _mm_div_pd(a, b)
+#define SIMD_MAX(a, b)    _mm_max_pd(a, b)
+#define SIMD_MIN(a, b)    _mm_min_pd(a, b)
+#define SIMD_FMA(a, b, c) _mm_add_pd(_mm_mul_pd(a, b), c)
+#define SIMD_ABS(v)       _mm_andnot_pd(_mm_set1_pd(-0.0), v)
+#define SIMD_MASK_GT0(v, m) \
+  _mm_and_pd(_mm_cmpgt_pd(m, _mm_setzero_pd()), v)
+#define SIMD_CMP_NZ(d)    _mm_cmpneq_pd(d, _mm_setzero_pd())
+#define SIMD_AND(a, b)    _mm_and_pd(a, b)
+#define SIMD_ANDNOT(a, b) _mm_andnot_pd(a, b)
+#define SIMD_OR(a, b)     _mm_or_pd(a, b)
+#else
+#define SIMD_T            __m128
+#define SIMD_W            4
+#define SIMD_LOAD(p)      _mm_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm_set1_ps(s)
+#define SIMD_ADD(a, b)    _mm_add_ps(a, b)
+#define SIMD_MUL(a, b)    _mm_mul_ps(a, b)
+#define SIMD_DIV(a, b)    _mm_div_ps(a, b)
+#define SIMD_MAX(a, b)    _mm_max_ps(a, b)
+#define SIMD_MIN(a, b)    _mm_min_ps(a, b)
+#define SIMD_FMA(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+#define SIMD_ABS(v)       _mm_andnot_ps(_mm_set1_ps(-0.0f), v)
+#define SIMD_MASK_GT0(v, m) \
+  _mm_and_ps(_mm_cmpgt_ps(m, _mm_setzero_ps()), v)
+#define SIMD_CMP_NZ(d)    _mm_cmpneq_ps(d, _mm_setzero_ps())
+#define SIMD_AND(a, b)    _mm_and_ps(a, b)
+#define SIMD_ANDNOT(a, b) _mm_andnot_ps(a, b)
+#define SIMD_OR(a, b)     _mm_or_ps(a, b)
+#endif
+
+SIMD_TARGET static SIMD_T SIMD_FN(SelectNZ)(SIMD_T d, SIMD_T q, SIMD_T s)
+{
+  SIMD_T m = SIMD_CMP_NZ(d);
+  return SIMD_OR(SIMD_AND(m, q), SIMD_ANDNOT(m, s));
+}
+
+#define SIMD_SELECT_NZ(d, q, s) SIMD_FN(SelectNZ)(d, q, s)
+
+#include "nvector_serial_simd_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_T
+#undef SIMD_W
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ADD
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_MAX
+#undef SIMD_MIN
+#undef SIMD_FMA
+#undef SIMD_ABS
+#undef SIMD_MASK_GT0
+#undef SIMD_CMP_NZ
+#undef SIMD_AND
+#undef SIMD_ANDNOT
+#undef SIMD_OR
+#undef SIMD_SELECT_NZ
+
+/* -----------------------------------------------------------------
+ * AVX2 and FMA
+ * ----------------------------------------------------------------*/
+
+#define SIMD_ISA    avx2
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_T            __m256d
+#define SIMD_W            4
+#define SIMD_LOAD(p)      _mm256_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm256_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm256_set1_pd(s)
+#define SIMD_ADD(a, b)    _mm256_add_pd(a, b)
+#define SIMD_MUL(a, b)    _mm256_mul_pd(a, b)
+#define SIMD_DIV(a, b)    _mm256_div_pd(a, b)
+#define SIMD_MAX(a, b)    _mm256_max_pd(a, b)
+#define SIMD_MIN(a, b)    _mm256_min_pd(a, b)
+#define SIMD_FMA(a, b, c) _mm256_fmadd_pd(a, b, c)
+#define SIMD_ABS(v)       _mm256_andnot_pd(_mm256_set1_pd(-0.0), v)
+#define SIMD_MASK_GT0(v, m) \
+  _mm256_and_pd(_mm256_cmp_pd(m, _mm256_setzero_pd(), _CMP_GT_OQ), v)
+#define SIMD_SELECT_NZ(d, q, s) \
+  _mm256_blendv_pd(s, q, _mm256_cmp_pd(d, _mm256_setzero_pd(), _CMP_NEQ_UQ))
+#else
+#define SIMD_T            __m256
+#define SIMD_W            8
+#define SIMD_LOAD(p)      _mm256_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm256_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm256_set1_ps(s)
+#define SIMD_ADD(a, b)    _mm256_add_ps(a, b)
+#define SIMD_MUL(a, b)    _mm256_mul_ps(a, b)
+#define SIMD_DIV(a, b)    _mm256_div_ps(a, b)
+#define SIMD_MAX(a, b)    _mm256_max_ps(a, b)
+#define SIMD_MIN(a, b)    _mm256_min_ps(a, b)
+#define SIMD_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define SIMD_ABS(v)       _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v)
+#define SIMD_MASK_GT0(v, m) \
+  _mm256_and_ps(_mm256_cmp_ps(m, _mm256_setzero_ps(), _CMP_GT_OQ), v)
+#define SIMD_SELECT_NZ(d, q, s) \
+  _mm256_blendv_ps(s, q, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_NEQ_UQ))
+#endif
+
+#include "nvector_serial_simd_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_T
+#undef SIMD_W
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_ADD
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_MAX
+#undef SIMD_MIN
+#undef SIMD_FMA
+#undef SIMD_ABS
+#undef SIMD_MASK_GT0
+#undef SIMD_SELECT_NZ
+
+/* -----------------------------------------------------------------
+ * AVX-512
+ * ----------------------------------------------------------------*/
+
+#define SIMD_ISA    avx512
+#define SIMD_TARGET __attribute__((target("avx512f")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_T            __m512d
+#define SIMD_W            8
+#define SIMD_LOAD(p)      _mm512_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm512_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm512_set1_pd(s)
+#define SIMD_ADD(a, b)    _mm512_add_pd(a, b)
+#define SIMD_MUL(a, b)    _mm512_mul_pd(a, b)
+#define SIMD_DIV(a, b)    _mm512_div_pd(a, b)
+#define SIMD_MAX(a, b)    _mm512_max_pd(a, b)
+#define SIMD_MIN(a, b)    _mm512_min_pd(a, b)
+#define SIMD_FMA(a, b, c) _mm512_fmadd_pd(a, b, c)
+#define SIMD_ABS(v)       _mm512_abs_pd(v)
+#define SIMD_MASK_GT0(v, m)                                                 \
+  _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(m, _mm512_setzero_pd(), _CMP_GT_OQ), \
+                      v)
+#define SIMD_SELECT_NZ(d, q, s)                                          \
+  _mm512_mask_blend_pd(_mm512_cmp_pd_mask(d, _mm512_setzero_pd(),        \
+                                          _CMP_NEQ_UQ),                  \
+                       s, q)
+#else
+#define SIMD_T            __m512
+#define SIMD_W            16
+#define SIMD_LOAD(p)      _mm512_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm512_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm512_set1_ps(s)
+#define SIMD_ADD(a, b)    _mm512_add_ps(a, b)
+#define SIMD_MUL(a, b)    _mm512_mul_ps(a, b)
+#define SIMD_DIV(a, b)    _mm512_div_ps(a, b)
+#define SIMD_MAX(a, b)    _mm512_max_ps(a, b)
+#define SIMD_MIN(a, b)    _mm512_min_ps(a, b)
+#define SIMD_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define SIMD_ABS(v)       _mm512_abs_ps(v)
+#define SIMD_MASK_GT0(v, m)                                                 \
+  _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(m, _mm512_setzero_ps(), _CMP_GT_OQ), \
+                      v)
+#define SIMD_SELECT_NZ(d, q, s)                                          \
+  _mm512_mask_blend_ps(_mm512_cmp_ps_mask(d, _mm512_setzero_ps(),        \
+                                          _CMP_NEQ_UQ),                  \
+                       s, q)
+#endif
+
+#include "nvector_serial_simd_kernels.h"
+
+/* -----------------------------------------------------------------
+ * Run time selection
+ * ----------------------------------------------------------------*/
+
+static N_VSIMDLevel nvSIMDMaxLevel(void)
+{
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) { return N_VSIMD_AVX512; }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    return N_VSIMD_AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) { return N_VSIMD_SSE2; }
+  return N_VSIMD_NONE;
+}
+
+static const nvSerialSIMDKernels* nvSIMDSelect(N_VSIMDLevel level)
+{
+  switch (level)
+  {
+  case N_VSIMD_SSE2: return &nvSIMDKernels_sse2;
+  case N_VSIMD_AVX2: return &nvSIMDKernels_avx2;
+  case N_VSIMD_AVX512: return &nvSIMDKernels_avx512;
+  default: return NULL;
+  }
+}
+
+#else
+
+static N_VSIMDLevel nvSIMDMaxLevel(void) { return N_VSIMD_NONE; }
+
+static const nvSerialSIMDKernels* nvSIMDSelect(
+  SUNDIALS_MAYBE_UNUSED N_VSIMDLevel level)
+{
+  return NULL;
+}
+
+#endif
+
+SUNErrCode N_VSetSIMDLevel_Serial(N_VSIMDLevel level)
+{
+  if (level < N_VSIMD_NONE || level > nvSIMDMaxLevel())
+  {
+    return SUN_ERR_ARG_OUTOFRANGE;
+  }
+  nvsimd_level = level;
+  nvSerialSIMD = nvSIMDSelect(level);
+  return SUN_SUCCESS;
+}
+
+N_VSIMDLevel N_VGetSIMDLevel_Serial(void) { return nvsimd_level; }
+
+sunrealtype* nvSerialSIMDAlloc(sunindextype length)
+{
+#if defined(NVSIMD_ENABLED) && !defined(_WIN32)
+  void* data = NULL;
+  if (posix_memalign(&data, NVSIMD_ALIGNMENT, length * sizeof(sunrealtype)))
+  {
+    return NULL;
+  }
+  return (sunrealtype*)data;
+#else
+  return (sunrealtype*)malloc(length * sizeof(sunrealtype));
+#endif
+}
+
+/* -----------------------------------------------------------------
+ * Fused operations in blocks of vectors
+ * ----------------------------------------------------------------*/
+
+void nvSerialSIMDLinearCombination(int nvec, const sunrealtype* c,
+                                   N_Vector* X, N_Vector z)
+{
+  sunrealtype* xd[NVSIMD_MAXVEC];
+  int i, k, nb;
+
+  for (i = 0; i < nvec; i += nb)
+  {
+    nb = SUNMIN(nvec - i, NVSIMD_MAXVEC);
+    for (k = 0; k < nb; k++) { xd[k] = NV_DATA_S(X[i + k]); }
+    nvSerialSIMD->linearcombination(NV_LENGTH_S(z), nb, c + i, xd,
+                                    NV_DATA_S(z), i > 0);
+  }
+}
+
+void nvSerialSIMDLinearCombinationArray(int nsum, const sunrealtype* c,
+                                        N_Vector** X, int j, N_Vector z)
+{
+  sunrealtype* xd[NVSIMD_MAXVEC];
+  int i, k, nb;
+
+  for (i = 0; i < nsum; i += nb)
+  {
+    nb = SUNMIN(nsum - i, NVSIMD_MAXVEC);
+    for (k = 0; k < nb; k++) { xd[k] = NV_DATA_S(X[i + k][j]); }
+    nvSerialSIMD->linearcombination(NV_LENGTH_S(z), nb, c + i, xd,
+                                    NV_DATA_S(z), i > 0);
+  }
+}
+
+void nvSerialSIMDScaleAddMulti(int nvec, const sunrealtype* a, N_Vector x,
+                               N_Vector* Y, N_Vector* Z)
+{
+  sunrealtype *yd[NVSIMD_MAXVEC], *zd[NVSIMD_MAXVEC];
+  int i, k, nb;
+
+  for (i = 0; i < nvec; i += nb)
+  {
+    nb = SUNMIN(nvec - i, NVSIMD_MAXVEC);
+    for (k = 0; k < nb; k++)
+    {
+      yd[k] = NV_DATA_S(Y[i + k]);
+      zd[k] = NV_DATA_S(Z[i + k]);
+    }
+    nvSerialSIMD->scaleaddmulti(NV_LENGTH_S(x), nb, a + i, NV_DATA_S(x), yd,
+                                zd);
+  }
+}
+
+void nvSerialSIMDScaleAddMultiArray(int nsum, const sunrealtype* a, N_Vector x,
+                                    N_Vector** Y, N_Vector** Z, int j)
+{
+  sunrealtype *yd[NVSIMD_MAXVEC], *zd[NVSIMD_MAXVEC];
+  int i, k, nb;
+
+  for (i = 0; i < nsum; i += nb)
+  {
+    nb = SUNMIN(nsum - i, NVSIMD_MAXVEC);
+    for (k = 0; k < nb; k++)
+    {
+      yd[k] = NV_DATA_S(Y[i + k][j]);
+      zd[k] = NV_DATA_S(Z[i + k][j]);
+    }
+    nvSerialSIMD->scaleaddmulti(NV_LENGTH_S(x), nb, a + i, NV_DATA_S(x), yd,
+                                zd);
+  }
+}
+
+void nvSerialSIMDDotProdMulti(int nvec, N_Vector x, N_Vector* Y,
+                              sunrealtype* dotprods)
+{
+  sunrealtype* yd[NVSIMD_MAXDOT];
+  int i, k, nb;
+
+  for (i = 0; i < nvec; i += nb)
+  {
+    nb = SUNMIN(nvec - i, NVSIMD_MAXDOT);
+    for (k = 0; k < nb; k++) { yd[k] = NV_DATA_S(Y[i + k]); }
+    nvSerialSIMD->dotprodmulti(NV_LENGTH_S(x), nb, NV_DATA_S(x), yd,
+                               dotprods + i);
+  }
+}
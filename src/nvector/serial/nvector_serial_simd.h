@@ -0,0 +1,82 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Private header for the SIMD kernels of the serial NVECTOR. The
+ * kernels work on the data arrays and are selected at run time for
+ * the instruction sets supported by the CPU.
+ * -----------------------------------------------------------------*/
+
+#ifndef _NVECTOR_SERIAL_SIMD_H
+#define _NVECTOR_SERIAL_SIMD_H
+
+#include <nvector/nvector_serial.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Largest number of vectors handled by one call of the fused kernels */
+#define NVSIMD_MAXVEC 8
+#define NVSIMD_MAXDOT 4
+
+/* Alignment of the data arrays allocated by the serial NVECTOR */
+#define NVSIMD_ALIGNMENT 64
+
+typedef struct
+{
+  sunrealtype (*dotprod)(sunindextype n, const sunrealtype* x,
+                         const sunrealtype* y);
+  sunrealtype (*l1norm)(sunindextype n, const sunrealtype* x);
+  sunrealtype (*maxnorm)(sunindextype n, const sunrealtype* x);
+  sunrealtype (*min)(sunindextype n, const sunrealtype* x);
+  sunrealtype (*wsqrsum)(sunindextype n, const sunrealtype* x,
+                         const sunrealtype* w);
+  sunrealtype (*wsqrsummask)(sunindextype n, const sunrealtype* x,
+                             const sunrealtype* w, const sunrealtype* id);
+  sunrealtype (*minquotient)(sunindextype n, const sunrealtype* num,
+                             const sunrealtype* denom);
+  void (*linearsum)(sunindextype n, sunrealtype a, const sunrealtype* x,
+                    sunrealtype b, const sunrealtype* y, sunrealtype* z);
+  void (*linearcombination)(sunindextype n, int nvec, const sunrealtype* c,
+                            sunrealtype* const* x, sunrealtype* z,
+                            sunbooleantype accumulate);
+  void (*scaleaddmulti)(sunindextype n, int nvec, const sunrealtype* a,
+                        const sunrealtype* x, sunrealtype* const* y,
+                        sunrealtype* const* z);
+  void (*dotprodmulti)(sunindextype n, int nvec, const sunrealtype* x,
+                       sunrealtype* const* y, sunrealtype* dots);
+} nvSerialSIMDKernels;
+
+/* The kernels for the selected instruction set or NULL if the scalar loops
+   are used */
+extern const nvSerialSIMDKernels* nvSerialSIMD;
+
+/* Allocates a data array aligned to NVSIMD_ALIGNMENT bytes when the SIMD
+   kernels are built, the array is released with free */
+sunrealtype* nvSerialSIMDAlloc(sunindextype length);
+
+/* Fused operations on vector arrays using the kernels in blocks of vectors */
+void nvSerialSIMDLinearCombination(int nvec, const sunrealtype* c,
+                                   N_Vector* X, N_Vector z);
+void nvSerialSIMDLinearCombinationArray(int nsum, const sunrealtype* c,
+                                        N_Vector** X, int j, N_Vector z);
+void nvSerialSIMDScaleAddMulti(int nvec, const sunrealtype* a, N_Vector x,
+                               N_Vector* Y, N_Vector* Z);
+void nvSerialSIMDScaleAddMultiArray(int nsum, const sunrealtype* a, N_Vector x,
+                                    N_Vector** Y, N_Vector** Z, int j);
+void nvSerialSIMDDotProdMulti(int nvec, N_Vector x, N_Vector* Y,
+                              sunrealtype* dotprods);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
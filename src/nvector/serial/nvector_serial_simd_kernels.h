@@ -0,0 +1,391 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SIMD kernels for the serial NVECTOR. This file is included once
+ * for each instruction set by nvector_serial_simd.c after defining
+ * the following macros:
+ *
+ *   SIMD_FN(name)         - name of the kernel for the instruction set
+ *   SIMD_TARGET           - function attribute enabling the set
+ *   SIMD_T                - vector register type
+ *   SIMD_W                - number of sunrealtype values in SIMD_T
+ *   SIMD_LOAD(p)          - unaligned load
+ *   SIMD_STORE(p, v)      - unaligned store
+ *   SIMD_SET1(s)          - broadcast
+ *   SIMD_ADD, SIMD_MUL, SIMD_DIV, SIMD_MAX, SIMD_MIN
+ *   SIMD_FMA(a, b, c)     - a * b + c
+ *   SIMD_ABS(v)           - absolute value
+ *   SIMD_MASK_GT0(v, m)   - v where m > 0, otherwise 0
+ *   SIMD_SELECT_NZ(d, q, s) - q where d != 0, otherwise s
+ *
+ * Reductions use NVSIMD_NACC independent accumulators so that the
+ * loop is not serialized on the latency of the add. The max and min
+ * kernels pass the accumulator as the second operand so that NaN
+ * entries are skipped as in the scalar loops.
+ * -----------------------------------------------------------------*/
+
+SIMD_TARGET static sunrealtype SIMD_FN(Reduce)(SIMD_T v)
+{
+  sunrealtype buf[SIMD_W], sum = ZERO;
+  int k;
+  SIMD_STORE(buf, v);
+  for (k = 0; k < SIMD_W; k++) { sum += buf[k]; }
+  return sum;
+}
+
+SIMD_TARGET static sunrealtype SIMD_FN(DotProd)(sunindextype n,
+                                                const sunrealtype* x,
+                                                const sunrealtype* y)
+{
+  sunindextype i = 0;
+  sunrealtype sum;
+  SIMD_T s0 = SIMD_SET1(ZERO), s1 = s0, s2 = s0, s3 = s0;
+
+  for (; i + 4 * SIMD_W <= n; i += 4 * SIMD_W)
+  {
+    s0 = SIMD_FMA(SIMD_LOAD(x + i), SIMD_LOAD(y + i), s0);
+    s1 = SIMD_FMA(SIMD_LOAD(x + i + SIMD_W), SIMD_LOAD(y + i + SIMD_W), s1);
+    s2 = SIMD_FMA(SIMD_LOAD(x + i + 2 * SIMD_W),
+                  SIMD_LOAD(y + i + 2 * SIMD_W), s2);
+    s3 = SIMD_FMA(SIMD_LOAD(x + i + 3 * SIMD_W),
+                  SIMD_LOAD(y + i + 3 * SIMD_W), s3);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    s0 = SIMD_FMA(SIMD_LOAD(x + i), SIMD_LOAD(y + i), s0);
+  }
+
+  sum = SIMD_FN(Reduce)(SIMD_ADD(SIMD_ADD(s0, s1), SIMD_ADD(s2, s3)));
+  for (; i < n; i++) { sum += x[i] * y[i]; }
+  return sum;
+}
+
+SIMD_TARGET static sunrealtype SIMD_FN(L1Norm)(sunindextype n,
+                                               const sunrealtype* x)
+{
+  sunindextype i = 0;
+  sunrealtype sum;
+  SIMD_T s0 = SIMD_SET1(ZERO), s1 = s0, s2 = s0, s3 = s0;
+
+  for (; i + 4 * SIMD_W <= n; i += 4 * SIMD_W)
+  {
+    s0 = SIMD_ADD(SIMD_ABS(SIMD_LOAD(x + i)), s0);
+    s1 = SIMD_ADD(SIMD_ABS(SIMD_LOAD(x + i + SIMD_W)), s1);
+    s2 = SIMD_ADD(SIMD_ABS(SIMD_LOAD(x + i + 2 * SIMD_W)), s2);
+    s3 = SIMD_ADD(SIMD_ABS(SIMD_LOAD(x + i + 3 * SIMD_W)), s3);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    s0 = SIMD_ADD(SIMD_ABS(SIMD_LOAD(x + i)), s0);
+  }
+
+  sum = SIMD_FN(Reduce)(SIMD_ADD(SIMD_ADD(s0, s1), SIMD_ADD(s2, s3)));
+  for (; i < n; i++) { sum += SUNRabs(x[i]); }
+  return sum;
+}
+
+SIMD_TARGET static sunrealtype SIMD_FN(MaxNorm)(sunindextype n,
+                                                const sunrealtype* x)
+{
+  sunindextype i = 0;
+  sunrealtype buf[SIMD_W], max = ZERO;
+  SIMD_T m0 = SIMD_SET1(ZERO), m1 = m0, m2 = m0, m3 = m0;
+  int k;
+
+  for (; i + 4 * SIMD_W <= n; i += 4 * SIMD_W)
+  {
+    m0 = SIMD_MAX(SIMD_ABS(SIMD_LOAD(x + i)), m0);
+    m1 = SIMD_MAX(SIMD_ABS(SIMD_LOAD(x + i + SIMD_W)), m1);
+    m2 = SIMD_MAX(SIMD_ABS(SIMD_LOAD(x + i + 2 * SIMD_W)), m2);
+    m3 = SIMD_MAX(SIMD_ABS(SIMD_LOAD(x + i + 3 * SIMD_W)), m3);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    m0 = SIMD_MAX(SIMD_ABS(SIMD_LOAD(x + i)), m0);
+  }
+
+  SIMD_STORE(buf, SIMD_MAX(SIMD_MAX(m0, m1), SIMD_MAX(m2, m3)));
+  for (k = 0; k < SIMD_W; k++)
+  {
+    if (buf[k] > max) { max = buf[k]; }
+  }
+  for (; i < n; i++)
+  {
+    if (SUNRabs(x[i]) > max) { max = SUNRabs(x[i]); }
+  }
+  return max;
+}
+
+SIMD_TARGET static sunrealtype SIMD_FN(Min)(sunindextype n,
+                                            const sunrealtype* x)
+{
+  sunindextype i = 0;
+  sunrealtype buf[SIMD_W], min = x[0];
+  SIMD_T m0 = SIMD_SET1(x[0]), m1 = m0, m2 = m0, m3 = m0;
+  int k;
+
+  for (; i + 4 * SIMD_W <= n; i += 4 * SIMD_W)
+  {
+    m0 = SIMD_MIN(SIMD_LOAD(x + i), m0);
+    m1 = SIMD_MIN(SIMD_LOAD(x + i + SIMD_W), m1);
+    m2 = SIMD_MIN(SIMD_LOAD(x + i + 2 * SIMD_W), m2);
+    m3 = SIMD_MIN(SIMD_LOAD(x + i + 3 * SIMD_W), m3);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    m0 = SIMD_MIN(SIMD_LOAD(x + i), m0);
+  }
+
+  SIMD_STORE(buf, SIMD_MIN(SIMD_MIN(m0, m1), SIMD_MIN(m2, m3)));
+  for (k = 0; k < SIMD_W; k++)
+  {
+    if (buf[k] < min) { min = buf[k]; }
+  }
+  for (; i < n; i++)
+  {
+    if (x[i] < min) { min = x[i]; }
+  }
+  return min;
+}
+
+SIMD_TARGET static sunrealtype SIMD_FN(WSqrSum)(sunindextype n,
+                                                const sunrealtype* x,
+                                                const sunrealtype* w)
+{
+  sunindextype i = 0;
+  sunrealtype sum, prodi;
+  SIMD_T s0 = SIMD_SET1(ZERO), s1 = s0, s2 = s0, s3 = s0, p;
+
+  for (; i + 4 * SIMD_W <= n; i += 4 * SIMD_W)
+  {
+    p  = SIMD_MUL(SIMD_LOAD(x + i), SIMD_LOAD(w + i));
+    s0 = SIMD_FMA(p, p, s0);
+    p  = SIMD_MUL(SIMD_LOAD(x + i + SIMD_W), SIMD_LOAD(w + i + SIMD_W));
+    s1 = SIMD_FMA(p, p, s1);
+    p  = SIMD_MUL(SIMD_LOAD(x + i + 2 * SIMD_W), SIMD_LOAD(w + i + 2 * SIMD_W));
+    s2 = SIMD_FMA(p, p, s2);
+    p  = SIMD_MUL(SIMD_LOAD(x + i + 3 * SIMD_W), SIMD_LOAD(w + i + 3 * SIMD_W));
+    s3 = SIMD_FMA(p, p, s3);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    p  = SIMD_MUL(SIMD_LOAD(x + i), SIMD_LOAD(w + i));
+    s0 = SIMD_FMA(p, p, s0);
+  }
+
+  sum = SIMD_FN(Reduce)(SIMD_ADD(SIMD_ADD(s0, s1), SIMD_ADD(s2, s3)));
+  for (; i < n; i++)
+  {
+    prodi = x[i] * w[i];
+    sum += SUNSQR(prodi);
+  }
+  return sum;
+}
+
+SIMD_TARGET static sunrealtype SIMD_FN(WSqrSumMask)(sunindextype n,
+                                                    const sunrealtype* x,
+                                                    const sunrealtype* w,
+                                                    const sunrealtype* id)
+{
+  sunindextype i = 0;
+  sunrealtype sum, prodi;
+  SIMD_T s0 = SIMD_SET1(ZERO), s1 = s0, p;
+
+  for (; i + 2 * SIMD_W <= n; i += 2 * SIMD_W)
+  {
+    p  = SIMD_MASK_GT0(SIMD_MUL(SIMD_LOAD(x + i), SIMD_LOAD(w + i)),
+                       SIMD_LOAD(id + i));
+    s0 = SIMD_FMA(p, p, s0);
+    p  = SIMD_MASK_GT0(SIMD_MUL(SIMD_LOAD(x + i + SIMD_W),
+                                SIMD_LOAD(w + i + SIMD_W)),
+                       SIMD_LOAD(id + i + SIMD_W));
+    s1 = SIMD_FMA(p, p, s1);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    p  = SIMD_MASK_GT0(SIMD_MUL(SIMD_LOAD(x + i), SIMD_LOAD(w + i)),
+                       SIMD_LOAD(id + i));
+    s0 = SIMD_FMA(p, p, s0);
+  }
+
+  sum = SIMD_FN(Reduce)(SIMD_ADD(s0, s1));
+  for (; i < n; i++)
+  {
+    if (id[i] > ZERO)
+    {
+      prodi = x[i] * w[i];
+      sum += SUNSQR(prodi);
+    }
+  }
+  return sum;
+}
+
+/* Zero denominators are replaced by SUN_BIG_REAL, the value returned when
+   all denominators are zero */
+SIMD_TARGET static sunrealtype SIMD_FN(MinQuotient)(sunindextype n,
+                                                    const sunrealtype* num,
+                                                    const sunrealtype* denom)
+{
+  sunindextype i = 0;
+  sunrealtype buf[SIMD_W], min = SUN_BIG_REAL;
+  SIMD_T big = SIMD_SET1(SUN_BIG_REAL), m0 = big, m1 = big, d;
+  int k;
+
+  for (; i + 2 * SIMD_W <= n; i += 2 * SIMD_W)
+  {
+    d  = SIMD_LOAD(denom + i);
+    m0 = SIMD_MIN(SIMD_SELECT_NZ(d, SIMD_DIV(SIMD_LOAD(num + i), d), big), m0);
+    d  = SIMD_LOAD(denom + i + SIMD_W);
+    m1 = SIMD_MIN(SIMD_SELECT_NZ(d, SIMD_DIV(SIMD_LOAD(num + i + SIMD_W), d),
+                                 big),
+                  m1);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    d  = SIMD_LOAD(denom + i);
+    m0 = SIMD_MIN(SIMD_SELECT_NZ(d, SIMD_DIV(SIMD_LOAD(num + i), d), big), m0);
+  }
+
+  SIMD_STORE(buf, SIMD_MIN(m0, m1));
+  for (k = 0; k < SIMD_W; k++) { min = SUNMIN(min, buf[k]); }
+  for (; i < n; i++)
+  {
+    if (denom[i] != ZERO) { min = SUNMIN(min, num[i] / denom[i]); }
+  }
+  return min;
+}
+
+/* z = a x + b y */
+SIMD_TARGET static void SIMD_FN(LinearSum)(sunindextype n, sunrealtype a,
+                                           const sunrealtype* x, sunrealtype b,
+                                           const sunrealtype* y, sunrealtype* z)
+{
+  sunindextype i = 0;
+  SIMD_T av = SIMD_SET1(a), bv = SIMD_SET1(b);
+
+  for (; i + 2 * SIMD_W <= n; i += 2 * SIMD_W)
+  {
+    SIMD_STORE(z + i, SIMD_FMA(av, SIMD_LOAD(x + i),
+                               SIMD_MUL(bv, SIMD_LOAD(y + i))));
+    SIMD_STORE(z + i + SIMD_W,
+               SIMD_FMA(av, SIMD_LOAD(x + i + SIMD_W),
+                        SIMD_MUL(bv, SIMD_LOAD(y + i + SIMD_W))));
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    SIMD_STORE(z + i, SIMD_FMA(av, SIMD_LOAD(x + i),
+                               SIMD_MUL(bv, SIMD_LOAD(y + i))));
+  }
+  for (; i < n; i++) { z[i] = (a * x[i]) + (b * y[i]); }
+}
+
+/* z = sum c[k] x[k] or, if accumulate is true, z += sum c[k] x[k] for
+   nvec <= NVSIMD_MAXVEC vectors. x[0] may be z. */
+SIMD_TARGET static void SIMD_FN(LinearCombination)(sunindextype n, int nvec,
+                                                   const sunrealtype* c,
+                                                   sunrealtype* const* x,
+                                                   sunrealtype* z,
+                                                   sunbooleantype accumulate)
+{
+  sunindextype i = 0;
+  SIMD_T cv[NVSIMD_MAXVEC], s0, s1;
+  sunrealtype sum;
+  int k;
+
+  for (k = 0; k < nvec; k++) { cv[k] = SIMD_SET1(c[k]); }
+
+  for (; i + 2 * SIMD_W <= n; i += 2 * SIMD_W)
+  {
+    s0 = accumulate ? SIMD_LOAD(z + i) : SIMD_SET1(ZERO);
+    s1 = accumulate ? SIMD_LOAD(z + i + SIMD_W) : SIMD_SET1(ZERO);
+    for (k = 0; k < nvec; k++)
+    {
+      s0 = SIMD_FMA(cv[k], SIMD_LOAD(x[k] + i), s0);
+      s1 = SIMD_FMA(cv[k], SIMD_LOAD(x[k] + i + SIMD_W), s1);
+    }
+    SIMD_STORE(z + i, s0);
+    SIMD_STORE(z + i + SIMD_W, s1);
+  }
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    s0 = accumulate ? SIMD_LOAD(z + i) : SIMD_SET1(ZERO);
+    for (k = 0; k < nvec; k++) { s0 = SIMD_FMA(cv[k], SIMD_LOAD(x[k] + i), s0); }
+    SIMD_STORE(z + i, s0);
+  }
+  for (; i < n; i++)
+  {
+    sum = accumulate ? z[i] : ZERO;
+    for (k = 0; k < nvec; k++) { sum += c[k] * x[k][i]; }
+    z[i] = sum;
+  }
+}
+
+/* z[k] = a[k] x + y[k] for nvec <= NVSIMD_MAXVEC vectors, y[k] may be z[k] */
+SIMD_TARGET static void SIMD_FN(ScaleAddMulti)(sunindextype n, int nvec,
+                                               const sunrealtype* a,
+                                               const sunrealtype* x,
+                                               sunrealtype* const* y,
+                                               sunrealtype* const* z)
+{
+  sunindextype i = 0;
+  SIMD_T av[NVSIMD_MAXVEC], xv;
+  int k;
+
+  for (k = 0; k < nvec; k++) { av[k] = SIMD_SET1(a[k]); }
+
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    xv = SIMD_LOAD(x + i);
+    for (k = 0; k < nvec; k++)
+    {
+      SIMD_STORE(z[k] + i, SIMD_FMA(av[k], xv, SIMD_LOAD(y[k] + i)));
+    }
+  }
+  for (; i < n; i++)
+  {
+    for (k = 0; k < nvec; k++) { z[k][i] = a[k] * x[i] + y[k][i]; }
+  }
+}
+
+/* dots[k] = x . y[k] for nvec <= NVSIMD_MAXDOT vectors */
+SIMD_TARGET static void SIMD_FN(DotProdMulti)(sunindextype n, int nvec,
+                                              const sunrealtype* x,
+                                              sunrealtype* const* y,
+                                              sunrealtype* dots)
+{
+  sunindextype i = 0;
+  SIMD_T s[NVSIMD_MAXDOT], xv;
+  int k;
+
+  for (k = 0; k < nvec; k++) { s[k] = SIMD_SET1(ZERO); }
+
+  for (; i + SIMD_W <= n; i += SIMD_W)
+  {
+    xv = SIMD_LOAD(x + i);
+    for (k = 0; k < nvec; k++)
+    {
+      s[k] = SIMD_FMA(xv, SIMD_LOAD(y[k] + i), s[k]);
+    }
+  }
+
+  for (k = 0; k < nvec; k++)
+  {
+    sunindextype j;
+    dots[k] = SIMD_FN(Reduce)(s[k]);
+    for (j = i; j < n; j++) { dots[k] += x[j] * y[k][j]; }
+  }
+}
+
+static const nvSerialSIMDKernels SIMD_FN(Kernels) = {
+  SIMD_FN(DotProd),     SIMD_FN(L1Norm),        SIMD_FN(MaxNorm),
+  SIMD_FN(Min),         SIMD_FN(WSqrSum),       SIMD_FN(WSqrSumMask),
+  SIMD_FN(MinQuotient), SIMD_FN(LinearSum),     SIMD_FN(LinearCombination),
+  SIMD_FN(ScaleAddMulti), SIMD_FN(DotProdMulti)};
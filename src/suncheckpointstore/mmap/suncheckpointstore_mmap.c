@@ -0,0 +1,218 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the SUNCheckpointStore_MMap
+ * module. The records are copied into a shared mapping of a file
+ * that grows geometrically; the operating system writes dirty
+ * pages back and evicts them under memory pressure.
+ * -----------------------------------------------------------------*/
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <suncheckpointstore/suncheckpointstore_mmap.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+
+#include "sundials_checkpointstore_impl.h"
+
+/* Smallest size of the mapping in bytes */
+#define MMAP_MIN_SIZE (1 << 20)
+
+/* Content of the store */
+typedef struct
+{
+  char* filename;           /* name of the backing file     */
+  int fd;                   /* descriptor of the file       */
+  char* map;                /* start of the mapping         */
+  size_t mapsize;           /* size of the file and mapping */
+  size_t pagesize;          /* system page size             */
+  SUNCheckpointIndex index; /* location of the records      */
+}* SUNCheckpointStoreContent_MMap;
+
+#define MMAP_CONTENT(S) ((SUNCheckpointStoreContent_MMap)(S->content))
+
+/* Resizes the file and the mapping to hold at least 'needed' bytes */
+static SUNErrCode mmapResize(SUNCheckpointStoreContent_MMap content,
+                             size_t needed)
+{
+  size_t newsize;
+  void* map;
+
+  newsize = (content->mapsize < MMAP_MIN_SIZE) ? MMAP_MIN_SIZE
+                                               : 2 * content->mapsize;
+  if (newsize < needed) { newsize = needed; }
+  newsize = ((newsize + content->pagesize - 1) / content->pagesize) *
+            content->pagesize;
+
+  if (ftruncate(content->fd, (off_t)newsize) != 0) { return SUN_ERR_OP_FAIL; }
+
+  if (content->map != NULL) { munmap(content->map, content->mapsize); }
+  content->map     = NULL;
+  content->mapsize = 0;
+
+  map = mmap(NULL, newsize, PROT_READ | PROT_WRITE, MAP_SHARED, content->fd, 0);
+  if (map == MAP_FAILED) { return SUN_ERR_MEM_FAIL; }
+
+  content->map     = (char*)map;
+  content->mapsize = newsize;
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Constructor
+ * ----------------------------------------------------------------- */
+
+SUNCheckpointStore SUNCheckpointStore_MMap(const char* filename,
+                                           SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  SUNCheckpointStore S;
+  SUNCheckpointStoreContent_MMap content;
+
+  SUNAssertNull(filename, SUN_ERR_ARG_CORRUPT);
+
+  S = SUNCheckpointStore_NewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  S->ops->write    = SUNCheckpointStore_Write_MMap;
+  S->ops->read     = SUNCheckpointStore_Read_MMap;
+  S->ops->remove   = SUNCheckpointStore_Remove_MMap;
+  S->ops->prefetch = SUNCheckpointStore_Prefetch_MMap;
+  S->ops->destroy  = SUNCheckpointStore_Destroy_MMap;
+
+  content = (SUNCheckpointStoreContent_MMap)malloc(sizeof(*content));
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+  S->content = content;
+
+  content->fd       = -1;
+  content->map      = NULL;
+  content->mapsize  = 0;
+  content->pagesize = (size_t)sysconf(_SC_PAGESIZE);
+  content->index    = NULL;
+
+  content->filename = (char*)malloc(strlen(filename) + 1);
+  SUNAssertNull(content->filename, SUN_ERR_MALLOC_FAIL);
+  strcpy(content->filename, filename);
+
+  SUNCheckCallNull(SUNCheckpointIndex_New(&(content->index)));
+
+  content->fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (content->fd < 0)
+  {
+    SUNHandleErrWithFmtMsg(__LINE__, __func__, __FILE__,
+                           "Unable to open the check point file %s",
+                           SUN_ERR_FILE_OPEN, sunctx, filename);
+    SUNCheckpointStore_Destroy_MMap(S);
+    return NULL;
+  }
+
+  return S;
+}
+
+/* -----------------------------------------------------------------
+ * Implementation of the store operations
+ * ----------------------------------------------------------------- */
+
+SUNErrCode SUNCheckpointStore_Write_MMap(SUNCheckpointStore S, long int key,
+                                         const void* buf, size_t nbytes)
+{
+  SUNCheckpointStoreContent_MMap content = MMAP_CONTENT(S);
+  SUNCheckpointRecord* rec;
+  SUNErrCode err;
+
+  SUNCheckpointIndex_Erase(content->index, key);
+
+  err = SUNCheckpointIndex_Insert(content->index, key, nbytes, &rec);
+  if (err != SUN_SUCCESS) { return err; }
+
+  if (content->index->end > content->mapsize)
+  {
+    err = mmapResize(content, content->index->end);
+    if (err != SUN_SUCCESS)
+    {
+      SUNCheckpointIndex_Erase(content->index, key);
+      return err;
+    }
+    rec = SUNCheckpointIndex_Find(content->index, key);
+  }
+
+  memcpy(content->map + rec->offset, buf, nbytes);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Read_MMap(SUNCheckpointStore S, long int key,
+                                        void* buf, size_t nbytes)
+{
+  SUNCheckpointStoreContent_MMap content = MMAP_CONTENT(S);
+  SUNCheckpointRecord* rec;
+
+  rec = SUNCheckpointIndex_Find(content->index, key);
+  if (rec == NULL || rec->nbytes < nbytes) { return SUN_ERR_ARG_OUTOFRANGE; }
+
+  memcpy(buf, content->map + rec->offset, nbytes);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Remove_MMap(SUNCheckpointStore S, long int key)
+{
+  SUNCheckpointIndex_Erase(MMAP_CONTENT(S)->index, key);
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Prefetch_MMap(SUNCheckpointStore S, long int key)
+{
+  SUNCheckpointStoreContent_MMap content = MMAP_CONTENT(S);
+  SUNCheckpointRecord* rec;
+  size_t start;
+
+  rec = SUNCheckpointIndex_Find(content->index, key);
+  if (rec == NULL) { return SUN_SUCCESS; }
+
+  /* ask the system to page the record in ahead of the read */
+  start = (rec->offset / content->pagesize) * content->pagesize;
+  (void)posix_madvise(content->map + start, rec->offset + rec->nbytes - start,
+                      POSIX_MADV_WILLNEED);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Destroy_MMap(SUNCheckpointStore S)
+{
+  SUNCheckpointStoreContent_MMap content;
+
+  if (S == NULL) { return SUN_SUCCESS; }
+
+  content = MMAP_CONTENT(S);
+  if (content != NULL)
+  {
+    if (content->map != NULL) { munmap(content->map, content->mapsize); }
+    if (content->fd >= 0)
+    {
+      close(content->fd);
+      unlink(content->filename);
+    }
+    SUNCheckpointIndex_Destroy(&(content->index));
+    free(content->filename);
+    free(content);
+    S->content = NULL;
+  }
+
+  SUNCheckpointStore_DestroyEmpty(S);
+
+  return SUN_SUCCESS;
+}
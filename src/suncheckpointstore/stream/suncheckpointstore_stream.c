@@ -0,0 +1,559 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the SUNCheckpointStore_Stream
+ * module. Write copies the record into a queue and returns; a
+ * worker thread writes the queue to the file in order. Prefetch
+ * asks the worker to read one record into a read-ahead buffer,
+ * which Read then consumes. All shared state is protected by one
+ * mutex, and the file is only accessed with pread and pwrite.
+ * -----------------------------------------------------------------*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <suncheckpointstore/suncheckpointstore_stream.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+
+#include "sundials_checkpointstore_impl.h"
+
+/* Default number of bytes that may wait in the write queue */
+#define STREAM_BUFFER_SIZE (16 << 20)
+
+/* States of the read-ahead buffer */
+#define AHEAD_NONE      0 /* no record                        */
+#define AHEAD_REQUESTED 1 /* the worker should load ahead_key */
+#define AHEAD_LOADING   2 /* the worker is loading ahead_key  */
+#define AHEAD_READY     3 /* ahead_buf holds ahead_key        */
+
+/* A record waiting to be written */
+typedef struct StreamPending_
+{
+  long int key;
+  size_t offset;
+  size_t nbytes;
+  char* buf;
+  struct StreamPending_* next;
+} StreamPending;
+
+/* Content of the store */
+typedef struct
+{
+  char* filename;           /* name of the backing file           */
+  int fd;                   /* descriptor of the file             */
+  SUNCheckpointIndex index; /* location of the records            */
+  SUNErrCode werr;          /* first error hit by the worker      */
+
+  /* write-behind queue */
+  StreamPending* head;    /* oldest queued record               */
+  StreamPending* tail;    /* newest queued record               */
+  StreamPending* writing; /* record being written by the worker */
+  size_t queued;          /* bytes in the queue and writing     */
+  size_t maxqueued;       /* bytes allowed in the queue         */
+
+  /* read-ahead buffer */
+  int ahead_state;
+  long int ahead_key;
+  char* ahead_buf;
+  size_t ahead_len;    /* capacity of ahead_buf           */
+  size_t ahead_nbytes; /* length of the record it holds   */
+
+  /* worker thread */
+  pthread_t worker;
+  pthread_mutex_t mutex;
+  pthread_cond_t work_cond; /* new work for the worker        */
+  pthread_cond_t done_cond; /* the worker finished some work  */
+  sunbooleantype started;   /* was the worker created?        */
+  sunbooleantype shutdown;  /* should the worker exit?        */
+}* SUNCheckpointStoreContent_Stream;
+
+#define STREAM_CONTENT(S) ((SUNCheckpointStoreContent_Stream)(S->content))
+
+/* -----------------------------------------------------------------
+ * Private helpers
+ * ----------------------------------------------------------------- */
+
+static sunbooleantype streamWriteAll(int fd, const char* buf, size_t nbytes,
+                                     size_t offset)
+{
+  while (nbytes > 0)
+  {
+    ssize_t n = pwrite(fd, buf, nbytes, (off_t)offset);
+    if (n < 0)
+    {
+      if (errno == EINTR) { continue; }
+      return SUNFALSE;
+    }
+    buf += n;
+    offset += (size_t)n;
+    nbytes -= (size_t)n;
+  }
+  return SUNTRUE;
+}
+
+static sunbooleantype streamReadAll(int fd, char* buf, size_t nbytes,
+                                    size_t offset)
+{
+  while (nbytes > 0)
+  {
+    ssize_t n = pread(fd, buf, nbytes, (off_t)offset);
+    if (n < 0)
+    {
+      if (errno == EINTR) { continue; }
+      return SUNFALSE;
+    }
+    if (n == 0) { return SUNFALSE; }
+    buf += n;
+    offset += (size_t)n;
+    nbytes -= (size_t)n;
+  }
+  return SUNTRUE;
+}
+
+/* Returns the queued record with the given key or NULL (mutex held) */
+static StreamPending* streamFindPending(SUNCheckpointStoreContent_Stream content,
+                                        long int key)
+{
+  StreamPending* p;
+  if (content->writing != NULL && content->writing->key == key)
+  {
+    return content->writing;
+  }
+  for (p = content->head; p != NULL; p = p->next)
+  {
+    if (p->key == key) { return p; }
+  }
+  return NULL;
+}
+
+/* Drops a record from the queue, the read-ahead buffer, and the index, so
+   that its range of the file can be reused (mutex held) */
+static void streamDrop(SUNCheckpointStoreContent_Stream content, long int key)
+{
+  StreamPending *p, *prev;
+
+  /* a record being written or loaded must be finished first */
+  while ((content->writing != NULL && content->writing->key == key) ||
+         (content->ahead_key == key && (content->ahead_state == AHEAD_LOADING ||
+                                        content->ahead_state == AHEAD_REQUESTED)))
+  {
+    pthread_cond_wait(&(content->done_cond), &(content->mutex));
+  }
+
+  prev = NULL;
+  for (p = content->head; p != NULL; prev = p, p = p->next)
+  {
+    if (p->key != key) { continue; }
+    if (prev == NULL) { content->head = p->next; }
+    else { prev->next = p->next; }
+    if (content->tail == p) { content->tail = prev; }
+    content->queued -= p->nbytes;
+    free(p->buf);
+    free(p);
+    pthread_cond_broadcast(&(content->done_cond));
+    break;
+  }
+
+  if (content->ahead_key == key) { content->ahead_state = AHEAD_NONE; }
+
+  SUNCheckpointIndex_Erase(content->index, key);
+}
+
+static void* streamWorker(void* arg)
+{
+  SUNCheckpointStoreContent_Stream content = (SUNCheckpointStoreContent_Stream)arg;
+  SUNCheckpointRecord* rec;
+  StreamPending* p;
+  sunbooleantype ok;
+  size_t offset, nbytes;
+  char* buf;
+
+  pthread_mutex_lock(&(content->mutex));
+
+  for (;;)
+  {
+    while (!content->shutdown && content->head == NULL &&
+           content->ahead_state != AHEAD_REQUESTED)
+    {
+      pthread_cond_wait(&(content->work_cond), &(content->mutex));
+    }
+
+    if (content->shutdown) { break; }
+
+    /* writes come first so that reads never see stale data */
+    if (content->head != NULL)
+    {
+      p             = content->head;
+      content->head = p->next;
+      if (content->head == NULL) { content->tail = NULL; }
+      content->writing = p;
+
+      pthread_mutex_unlock(&(content->mutex));
+      ok = streamWriteAll(content->fd, p->buf, p->nbytes, p->offset);
+      pthread_mutex_lock(&(content->mutex));
+
+      if (!ok && content->werr == SUN_SUCCESS) { content->werr = SUN_ERR_OP_FAIL; }
+      content->queued -= p->nbytes;
+      content->writing = NULL;
+      free(p->buf);
+      free(p);
+      pthread_cond_broadcast(&(content->done_cond));
+      continue;
+    }
+
+    /* otherwise load the requested record */
+    rec = SUNCheckpointIndex_Find(content->index, content->ahead_key);
+    if (rec == NULL)
+    {
+      content->ahead_state = AHEAD_NONE;
+      pthread_cond_broadcast(&(content->done_cond));
+      continue;
+    }
+
+    if (content->ahead_len < rec->nbytes)
+    {
+      buf = (char*)realloc(content->ahead_buf, rec->nbytes);
+      if (buf == NULL)
+      {
+        content->ahead_state = AHEAD_NONE;
+        pthread_cond_broadcast(&(content->done_cond));
+        continue;
+      }
+      content->ahead_buf = buf;
+      content->ahead_len = rec->nbytes;
+    }
+
+    offset               = rec->offset;
+    nbytes               = rec->nbytes;
+    buf                  = content->ahead_buf;
+    content->ahead_state = AHEAD_LOADING;
+
+    pthread_mutex_unlock(&(content->mutex));
+    ok = streamReadAll(content->fd, buf, nbytes, offset);
+    pthread_mutex_lock(&(content->mutex));
+
+    content->ahead_nbytes = nbytes;
+    content->ahead_state  = ok ? AHEAD_READY : AHEAD_NONE;
+    pthread_cond_broadcast(&(content->done_cond));
+  }
+
+  pthread_mutex_unlock(&(content->mutex));
+
+  return NULL;
+}
+
+/* -----------------------------------------------------------------
+ * Constructor
+ * ----------------------------------------------------------------- */
+
+SUNCheckpointStore SUNCheckpointStore_Stream(const char* filename,
+                                             SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  SUNCheckpointStore S;
+  SUNCheckpointStoreContent_Stream content;
+
+  SUNAssertNull(filename, SUN_ERR_ARG_CORRUPT);
+
+  S = SUNCheckpointStore_NewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  S->ops->write    = SUNCheckpointStore_Write_Stream;
+  S->ops->read     = SUNCheckpointStore_Read_Stream;
+  S->ops->remove   = SUNCheckpointStore_Remove_Stream;
+  S->ops->prefetch = SUNCheckpointStore_Prefetch_Stream;
+  S->ops->destroy  = SUNCheckpointStore_Destroy_Stream;
+
+  content = (SUNCheckpointStoreContent_Stream)malloc(sizeof(*content));
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+  S->content = content;
+
+  content->fd           = -1;
+  content->index        = NULL;
+  content->werr         = SUN_SUCCESS;
+  content->head         = NULL;
+  content->tail         = NULL;
+  content->writing      = NULL;
+  content->queued       = 0;
+  content->maxqueued    = STREAM_BUFFER_SIZE;
+  content->ahead_state  = AHEAD_NONE;
+  content->ahead_key    = 0;
+  content->ahead_buf    = NULL;
+  content->ahead_len    = 0;
+  content->ahead_nbytes = 0;
+  content->started      = SUNFALSE;
+  content->shutdown     = SUNFALSE;
+
+  content->filename = (char*)malloc(strlen(filename) + 1);
+  SUNAssertNull(content->filename, SUN_ERR_MALLOC_FAIL);
+  strcpy(content->filename, filename);
+
+  SUNCheckCallNull(SUNCheckpointIndex_New(&(content->index)));
+
+  pthread_mutex_init(&(content->mutex), NULL);
+  pthread_cond_init(&(content->work_cond), NULL);
+  pthread_cond_init(&(content->done_cond), NULL);
+
+  content->fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (content->fd < 0)
+  {
+    SUNHandleErrWithFmtMsg(__LINE__, __func__, __FILE__,
+                           "Unable to open the check point file %s",
+                           SUN_ERR_FILE_OPEN, sunctx, filename);
+    SUNCheckpointStore_Destroy_Stream(S);
+    return NULL;
+  }
+
+  if (pthread_create(&(content->worker), NULL, streamWorker, content) != 0)
+  {
+    SUNHandleErrWithMsg(__LINE__, __func__, __FILE__,
+                        "Unable to create the check point writer thread",
+                        SUN_ERR_EXT_FAIL, sunctx);
+    SUNCheckpointStore_Destroy_Stream(S);
+    return NULL;
+  }
+  content->started = SUNTRUE;
+
+  return S;
+}
+
+SUNErrCode SUNCheckpointStore_SetBufferSize_Stream(SUNCheckpointStore S,
+                                                   size_t nbytes)
+{
+  SUNCheckpointStoreContent_Stream content;
+
+  if (S == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  content = STREAM_CONTENT(S);
+
+  pthread_mutex_lock(&(content->mutex));
+  content->maxqueued = nbytes;
+  pthread_mutex_unlock(&(content->mutex));
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Implementation of the store operations
+ * ----------------------------------------------------------------- */
+
+SUNErrCode SUNCheckpointStore_Write_Stream(SUNCheckpointStore S, long int key,
+                                           const void* buf, size_t nbytes)
+{
+  SUNCheckpointStoreContent_Stream content = STREAM_CONTENT(S);
+  SUNCheckpointRecord* rec;
+  StreamPending* p;
+  SUNErrCode err;
+
+  /* copy the record before taking the lock */
+  p = (StreamPending*)malloc(sizeof(*p));
+  if (p == NULL) { return SUN_ERR_MALLOC_FAIL; }
+  p->buf = (char*)malloc(nbytes > 0 ? nbytes : 1);
+  if (p->buf == NULL)
+  {
+    free(p);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+  memcpy(p->buf, buf, nbytes);
+  p->key    = key;
+  p->nbytes = nbytes;
+  p->next   = NULL;
+
+  pthread_mutex_lock(&(content->mutex));
+
+  err = content->werr;
+  if (err == SUN_SUCCESS)
+  {
+    streamDrop(content, key);
+    err = SUNCheckpointIndex_Insert(content->index, key, nbytes, &rec);
+  }
+  if (err != SUN_SUCCESS)
+  {
+    pthread_mutex_unlock(&(content->mutex));
+    free(p->buf);
+    free(p);
+    return err;
+  }
+  p->offset = rec->offset;
+
+  /* wait for room in the queue */
+  while (content->queued > 0 && content->queued + nbytes > content->maxqueued)
+  {
+    pthread_cond_wait(&(content->done_cond), &(content->mutex));
+  }
+
+  if (content->tail == NULL) { content->head = p; }
+  else { content->tail->next = p; }
+  content->tail = p;
+  content->queued += nbytes;
+
+  pthread_cond_signal(&(content->work_cond));
+  pthread_mutex_unlock(&(content->mutex));
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Read_Stream(SUNCheckpointStore S, long int key,
+                                          void* buf, size_t nbytes)
+{
+  SUNCheckpointStoreContent_Stream content = STREAM_CONTENT(S);
+  SUNCheckpointRecord* rec;
+  StreamPending* p;
+  SUNErrCode err;
+  size_t offset;
+
+  pthread_mutex_lock(&(content->mutex));
+
+  err = content->werr;
+  if (err != SUN_SUCCESS)
+  {
+    pthread_mutex_unlock(&(content->mutex));
+    return err;
+  }
+
+  rec = SUNCheckpointIndex_Find(content->index, key);
+  if (rec == NULL || rec->nbytes < nbytes)
+  {
+    pthread_mutex_unlock(&(content->mutex));
+    return SUN_ERR_ARG_OUTOFRANGE;
+  }
+  offset = rec->offset;
+
+  /* the record has not reached the file yet */
+  p = streamFindPending(content, key);
+  if (p != NULL)
+  {
+    memcpy(buf, p->buf, nbytes);
+    pthread_mutex_unlock(&(content->mutex));
+    return SUN_SUCCESS;
+  }
+
+  /* the record is (being) read ahead */
+  if (content->ahead_key == key && content->ahead_state != AHEAD_NONE)
+  {
+    while (content->ahead_state == AHEAD_REQUESTED ||
+           content->ahead_state == AHEAD_LOADING)
+    {
+      pthread_cond_wait(&(content->done_cond), &(content->mutex));
+    }
+    if (content->ahead_key == key && content->ahead_state == AHEAD_READY)
+    {
+      memcpy(buf, content->ahead_buf, nbytes);
+      pthread_mutex_unlock(&(content->mutex));
+      return SUN_SUCCESS;
+    }
+  }
+
+  pthread_mutex_unlock(&(content->mutex));
+
+  /* the caller is the only one that can remove the record, so its range
+     stays valid without the lock */
+  if (!streamReadAll(content->fd, (char*)buf, nbytes, offset))
+  {
+    return SUN_ERR_OP_FAIL;
+  }
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Remove_Stream(SUNCheckpointStore S, long int key)
+{
+  SUNCheckpointStoreContent_Stream content = STREAM_CONTENT(S);
+
+  pthread_mutex_lock(&(content->mutex));
+  streamDrop(content, key);
+  pthread_mutex_unlock(&(content->mutex));
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Prefetch_Stream(SUNCheckpointStore S, long int key)
+{
+  SUNCheckpointStoreContent_Stream content = STREAM_CONTENT(S);
+
+  pthread_mutex_lock(&(content->mutex));
+
+  /* nothing to do if the record is in memory or already requested */
+  if (SUNCheckpointIndex_Find(content->index, key) == NULL ||
+      streamFindPending(content, key) != NULL ||
+      (content->ahead_key == key && content->ahead_state != AHEAD_NONE))
+  {
+    pthread_mutex_unlock(&(content->mutex));
+    return SUN_SUCCESS;
+  }
+
+  /* the buffer is reused, so wait for a load in progress */
+  while (content->ahead_state == AHEAD_LOADING)
+  {
+    pthread_cond_wait(&(content->done_cond), &(content->mutex));
+  }
+
+  content->ahead_key   = key;
+  content->ahead_state = AHEAD_REQUESTED;
+
+  pthread_cond_signal(&(content->work_cond));
+  pthread_mutex_unlock(&(content->mutex));
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNCheckpointStore_Destroy_Stream(SUNCheckpointStore S)
+{
+  SUNCheckpointStoreContent_Stream content;
+  StreamPending* p;
+
+  if (S == NULL) { return SUN_SUCCESS; }
+
+  content = STREAM_CONTENT(S);
+  if (content != NULL)
+  {
+    /* the file is removed, so queued records are discarded */
+    if (content->started)
+    {
+      pthread_mutex_lock(&(content->mutex));
+      content->shutdown = SUNTRUE;
+      pthread_cond_signal(&(content->work_cond));
+      pthread_mutex_unlock(&(content->mutex));
+      pthread_join(content->worker, NULL);
+    }
+
+    while (content->head != NULL)
+    {
+      p             = content->head;
+      content->head = p->next;
+      free(p->buf);
+      free(p);
+    }
+
+    pthread_cond_destroy(&(content->done_cond));
+    pthread_cond_destroy(&(content->work_cond));
+    pthread_mutex_destroy(&(content->mutex));
+
+    if (content->fd >= 0)
+    {
+      close(content->fd);
+      unlink(content->filename);
+    }
+    SUNCheckpointIndex_Destroy(&(content->index));
+    free(content->ahead_buf);
+    free(content->filename);
+    free(content);
+    S->content = NULL;
+  }
+
+  SUNCheckpointStore_DestroyEmpty(S);
+
+  return SUN_SUCCESS;
+}
@@ -160,13 +160,15 @@ module fsundials_core_mod
   enumerator :: SUNDIALS_NVEC_MANYVECTOR
   enumerator :: SUNDIALS_NVEC_MPIMANYVECTOR
   enumerator :: SUNDIALS_NVEC_MPIPLUSX
+  enumerator :: SUNDIALS_NVEC_LAZY
+  enumerator :: SUNDIALS_NVEC_MIXED
   enumerator :: SUNDIALS_NVEC_CUSTOM
  end enum
  integer, parameter, public :: N_Vector_ID = kind(SUNDIALS_NVEC_SERIAL)
  public :: SUNDIALS_NVEC_SERIAL, SUNDIALS_NVEC_PARALLEL, SUNDIALS_NVEC_OPENMP, SUNDIALS_NVEC_PTHREADS, SUNDIALS_NVEC_PARHYP, &
     SUNDIALS_NVEC_PETSC, SUNDIALS_NVEC_CUDA, SUNDIALS_NVEC_HIP, SUNDIALS_NVEC_SYCL, SUNDIALS_NVEC_RAJA, SUNDIALS_NVEC_KOKKOS, &
     SUNDIALS_NVEC_OPENMPDEV, SUNDIALS_NVEC_TRILINOS, SUNDIALS_NVEC_MANYVECTOR, SUNDIALS_NVEC_MPIMANYVECTOR, &
-    SUNDIALS_NVEC_MPIPLUSX, SUNDIALS_NVEC_CUSTOM
+    SUNDIALS_NVEC_MPIPLUSX, SUNDIALS_NVEC_LAZY, SUNDIALS_NVEC_MIXED, SUNDIALS_NVEC_CUSTOM
  ! struct struct _generic_N_Vector_Ops
  type, bind(C), public :: N_Vector_Ops
   type(C_FUNPTR), public :: nvgetvectorid
@@ -308,11 +310,12 @@ module fsundials_core_mod
   enumerator :: SUNMATRIX_CUSPARSE
   enumerator :: SUNMATRIX_GINKGO
   enumerator :: SUNMATRIX_KOKKOSDENSE
+  enumerator :: SUNMATRIX_BLOCKSPARSE
   enumerator :: SUNMATRIX_CUSTOM
  end enum
  integer, parameter, public :: SUNMatrix_ID = kind(SUNMATRIX_DENSE)
  public :: SUNMATRIX_DENSE, SUNMATRIX_MAGMADENSE, SUNMATRIX_ONEMKLDENSE, SUNMATRIX_BAND, SUNMATRIX_SPARSE, SUNMATRIX_SLUNRLOC, &
-    SUNMATRIX_CUSPARSE, SUNMATRIX_GINKGO, SUNMATRIX_KOKKOSDENSE, SUNMATRIX_CUSTOM
+    SUNMATRIX_CUSPARSE, SUNMATRIX_GINKGO, SUNMATRIX_KOKKOSDENSE, SUNMATRIX_BLOCKSPARSE, SUNMATRIX_CUSTOM
  ! struct struct _generic_SUNMatrix_Ops
  type, bind(C), public :: SUNMatrix_Ops
   type(C_FUNPTR), public :: getid
@@ -396,6 +399,10 @@ module fsundials_core_mod
   enumerator :: SUNLINEARSOLVER_ONEMKLDENSE
   enumerator :: SUNLINEARSOLVER_GINKGO
   enumerator :: SUNLINEARSOLVER_KOKKOSDENSE
+  enumerator :: SUNLINEARSOLVER_BATCHEDDENSE
+  enumerator :: SUNLINEARSOLVER_GCRODR
+  enumerator :: SUNLINEARSOLVER_ILU
+  enumerator :: SUNLINEARSOLVER_CHEBYSHEV
   enumerator :: SUNLINEARSOLVER_CUSTOM
  end enum
  integer, parameter, public :: SUNLinearSolver_ID = kind(SUNLINEARSOLVER_BAND)
@@ -403,7 +410,8 @@ module fsundials_core_mod
     SUNLINEARSOLVER_LAPACKDENSE, SUNLINEARSOLVER_PCG, SUNLINEARSOLVER_SPBCGS, SUNLINEARSOLVER_SPFGMR, SUNLINEARSOLVER_SPGMR, &
     SUNLINEARSOLVER_SPTFQMR, SUNLINEARSOLVER_SUPERLUDIST, SUNLINEARSOLVER_SUPERLUMT, SUNLINEARSOLVER_CUSOLVERSP_BATCHQR, &
     SUNLINEARSOLVER_MAGMADENSE, SUNLINEARSOLVER_ONEMKLDENSE, SUNLINEARSOLVER_GINKGO, SUNLINEARSOLVER_KOKKOSDENSE, &
-    SUNLINEARSOLVER_CUSTOM
+    SUNLINEARSOLVER_BATCHEDDENSE, SUNLINEARSOLVER_GCRODR, SUNLINEARSOLVER_ILU, &
+    SUNLINEARSOLVER_CHEBYSHEV, SUNLINEARSOLVER_CUSTOM
  ! struct struct _generic_SUNLinearSolver_Ops
  type, bind(C), public :: SUNLinearSolver_Ops
   type(C_FUNPTR), public :: gettype
@@ -483,6 +491,7 @@ module fsundials_core_mod
   type(C_FUNPTR), public :: getnumiters
   type(C_FUNPTR), public :: getcuriter
   type(C_FUNPTR), public :: getnumconvfails
+  type(C_FUNPTR), public :: getforcingterm
  end type SUNNonlinearSolver_Ops
  ! struct struct _generic_SUNNonlinearSolver
  type, bind(C), public :: SUNNonlinearSolver
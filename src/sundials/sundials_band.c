@@ -65,154 +65,54 @@ void SUNDlsMat_BandMatvec(SUNDlsMat A, sunrealtype* x, sunrealtype* y)
  * -----------------------------------------------------
  */
 
-sunindextype SUNDlsMat_bandGBTRF(sunrealtype** a, sunindextype n,
-                                 sunindextype mu, sunindextype ml,
-                                 sunindextype smu, sunindextype* p)
-{
-  sunindextype c, r, num_rows;
-  sunindextype i, j, k, l, storage_l, storage_k, last_col_k, last_row_k;
-  sunrealtype *a_c, *col_k, *diag_k, *sub_diag_k, *col_j, *kptr, *jptr;
-  sunrealtype max, temp, mult, a_kj;
-  sunbooleantype swap;
-
-  /* zero out the first smu - mu rows of the rectangular array a */
-
-  num_rows = smu - mu;
-  if (num_rows > 0)
-  {
-    for (c = 0; c < n; c++)
-    {
-      a_c = a[c];
-      for (r = 0; r < num_rows; r++) { a_c[r] = ZERO; }
-    }
-  }
-
-  /* k = elimination step number */
-
-  for (k = 0; k < n - 1; k++, p++)
-  {
-    col_k      = a[k];
-    diag_k     = col_k + smu;
-    sub_diag_k = diag_k + 1;
-    last_row_k = SUNMIN(n - 1, k + ml);
-
-    /* find l = pivot row number */
-
-    l   = k;
-    max = SUNRabs(*diag_k);
-    for (i = k + 1, kptr = sub_diag_k; i <= last_row_k; i++, kptr++)
-    {
-      if (SUNRabs(*kptr) > max)
-      {
-        l   = i;
-        max = SUNRabs(*kptr);
-      }
-    }
-    storage_l = ROW(l, k, smu);
-    *p        = l;
-
-    /* check for zero pivot element */
-
-    if (col_k[storage_l] == ZERO) { return (k + 1); }
-
-    /* swap a(l,k) and a(k,k) if necessary */
-
-    if ((swap = (l != k)))
-    {
-      temp             = col_k[storage_l];
-      col_k[storage_l] = *diag_k;
-      *diag_k          = temp;
-    }
-
-    /* Scale the elements below the diagonal in         */
-    /* column k by -1.0 / a(k,k). After the above swap, */
-    /* a(k,k) holds the pivot element. This scaling     */
-    /* stores the pivot row multipliers -a(i,k)/a(k,k)  */
-    /* in a(i,k), i=k+1, ..., SUNMIN(n-1,k+ml).            */
-
-    mult = -ONE / (*diag_k);
-    for (i = k + 1, kptr = sub_diag_k; i <= last_row_k; i++, kptr++)
-    {
-      (*kptr) *= mult;
-    }
-
-    /* row_i = row_i - [a(i,k)/a(k,k)] row_k, i=k+1, ..., SUNMIN(n-1,k+ml) */
-    /* row k is the pivot row after swapping with row l.                */
-    /* The computation is done one column at a time,                    */
-    /* column j=k+1, ..., SUNMIN(k+smu,n-1).                               */
+#define BAND_R        sunrealtype
+#define BAND_FN(name) band##name
+#define BAND_ABS(x)   SUNRabs(x)
+#define BAND_ONE      ONE
 
-    last_col_k = SUNMIN(k + smu, n - 1);
-    for (j = k + 1; j <= last_col_k; j++)
-    {
-      col_j     = a[j];
-      storage_l = ROW(l, j, smu);
-      storage_k = ROW(k, j, smu);
-      a_kj      = col_j[storage_l];
+#include "sundials_band_lu.h"
 
-      /* Swap the elements a(k,j) and a(k,l) if l!=k. */
+#if !defined(SUNDIALS_SINGLE_PRECISION)
+#define BAND_R        float
+#define BAND_FN(name) bandS##name
+#define BAND_ABS(x)   fabsf(x)
+#define BAND_ONE      1.0f
 
-      if (swap)
-      {
-        col_j[storage_l] = col_j[storage_k];
-        col_j[storage_k] = a_kj;
-      }
+#include "sundials_band_lu.h"
+#endif
 
-      /* a(i,j) = a(i,j) - [a(i,k)/a(k,k)]*a(k,j) */
-      /* a_kj = a(k,j), *kptr = - a(i,k)/a(k,k), *jptr = a(i,j) */
-
-      if (a_kj != ZERO)
-      {
-        for (i = k + 1, kptr = sub_diag_k, jptr = col_j + ROW(k + 1, j, smu);
-             i <= last_row_k; i++, kptr++, jptr++)
-        {
-          (*jptr) += a_kj * (*kptr);
-        }
-      }
-    }
-  }
-
-  /* set the last pivot row to be n-1 and check for a zero pivot */
-
-  *p = n - 1;
-  if (a[n - 1][smu] == ZERO) { return (n); }
-
-  /* return 0 to indicate success */
-
-  return (0);
+sunindextype SUNDlsMat_bandGBTRF(sunrealtype** a, sunindextype n,
+                                 sunindextype mu, sunindextype ml,
+                                 sunindextype smu, sunindextype* p)
+{
+  return (bandGBTRF(a, n, mu, ml, smu, p));
 }
 
 void SUNDlsMat_bandGBTRS(sunrealtype** a, sunindextype n, sunindextype smu,
                          sunindextype ml, sunindextype* p, sunrealtype* b)
 {
-  sunindextype k, l, i, first_row_k, last_row_k;
-  sunrealtype mult, *diag_k;
-
-  /* Solve Ly = Pb, store solution y in b */
-
-  for (k = 0; k < n - 1; k++)
-  {
-    l    = p[k];
-    mult = b[l];
-    if (l != k)
-    {
-      b[l] = b[k];
-      b[k] = mult;
-    }
-    diag_k     = a[k] + smu;
-    last_row_k = SUNMIN(n - 1, k + ml);
-    for (i = k + 1; i <= last_row_k; i++) { b[i] += mult * diag_k[i - k]; }
-  }
+  bandGBTRS(a, n, smu, ml, p, b);
+}
 
-  /* Solve Ux = y, store solution x in b */
+sunindextype SUNDlsMat_bandSGBTRF(float** a, sunindextype n, sunindextype mu,
+                                  sunindextype ml, sunindextype smu,
+                                  sunindextype* p)
+{
+#if defined(SUNDIALS_SINGLE_PRECISION)
+  return (bandGBTRF(a, n, mu, ml, smu, p));
+#else
+  return (bandSGBTRF(a, n, mu, ml, smu, p));
+#endif
+}
 
-  for (k = n - 1; k >= 0; k--)
-  {
-    diag_k      = a[k] + smu;
-    first_row_k = SUNMAX(0, k - smu);
-    b[k] /= (*diag_k);
-    mult = -b[k];
-    for (i = first_row_k; i <= k - 1; i++) { b[i] += mult * diag_k[i - k]; }
-  }
+void SUNDlsMat_bandSGBTRS(float** a, sunindextype n, sunindextype smu,
+                          sunindextype ml, sunindextype* p, sunrealtype* b)
+{
+#if defined(SUNDIALS_SINGLE_PRECISION)
+  bandGBTRS(a, n, smu, ml, p, b);
+#else
+  bandSGBTRS(a, n, smu, ml, p, b);
+#endif
 }
 
 void SUNDlsMat_bandCopy(sunrealtype** a, sunrealtype** b, sunindextype n,
@@ -0,0 +1,179 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Band LU factorization with partial pivoting and the corresponding
+ * solve. This file is included by sundials_band.c once for
+ * sunrealtype and, when sunrealtype is not float, once for float,
+ * after defining the following macros:
+ *
+ *   BAND_R        - type of the matrix entries
+ *   BAND_FN(name) - name of the function for BAND_R
+ *   BAND_ABS(x)   - absolute value of a BAND_R
+ *   BAND_ONE      - the constant one as a BAND_R
+ *
+ * The right-hand side of the solve is always in sunrealtype.
+ * -----------------------------------------------------------------*/
+
+static sunindextype BAND_FN(GBTRF)(BAND_R** a, sunindextype n, sunindextype mu,
+                                   sunindextype ml, sunindextype smu,
+                                   sunindextype* p)
+{
+  sunindextype c, r, num_rows;
+  sunindextype i, j, k, l, storage_l, storage_k, last_col_k, last_row_k;
+  BAND_R *a_c, *col_k, *diag_k, *sub_diag_k, *col_j, *kptr, *jptr;
+  BAND_R max, temp, mult, a_kj;
+  sunbooleantype swap;
+
+  /* zero out the first smu - mu rows of the rectangular array a */
+
+  num_rows = smu - mu;
+  if (num_rows > 0)
+  {
+    for (c = 0; c < n; c++)
+    {
+      a_c = a[c];
+      for (r = 0; r < num_rows; r++) { a_c[r] = ZERO; }
+    }
+  }
+
+  /* k = elimination step number */
+
+  for (k = 0; k < n - 1; k++, p++)
+  {
+    col_k      = a[k];
+    diag_k     = col_k + smu;
+    sub_diag_k = diag_k + 1;
+    last_row_k = SUNMIN(n - 1, k + ml);
+
+    /* find l = pivot row number */
+
+    l   = k;
+    max = BAND_ABS(*diag_k);
+    for (i = k + 1, kptr = sub_diag_k; i <= last_row_k; i++, kptr++)
+    {
+      if (BAND_ABS(*kptr) > max)
+      {
+        l   = i;
+        max = BAND_ABS(*kptr);
+      }
+    }
+    storage_l = ROW(l, k, smu);
+    *p        = l;
+
+    /* check for zero pivot element */
+
+    if (col_k[storage_l] == ZERO) { return (k + 1); }
+
+    /* swap a(l,k) and a(k,k) if necessary */
+
+    if ((swap = (l != k)))
+    {
+      temp             = col_k[storage_l];
+      col_k[storage_l] = *diag_k;
+      *diag_k          = temp;
+    }
+
+    /* Scale the elements below the diagonal in         */
+    /* column k by -1.0 / a(k,k). After the above swap, */
+    /* a(k,k) holds the pivot element. This scaling     */
+    /* stores the pivot row multipliers -a(i,k)/a(k,k)  */
+    /* in a(i,k), i=k+1, ..., SUNMIN(n-1,k+ml).            */
+
+    mult = -BAND_ONE / (*diag_k);
+    for (i = k + 1, kptr = sub_diag_k; i <= last_row_k; i++, kptr++)
+    {
+      (*kptr) *= mult;
+    }
+
+    /* row_i = row_i - [a(i,k)/a(k,k)] row_k, i=k+1, ..., SUNMIN(n-1,k+ml) */
+    /* row k is the pivot row after swapping with row l.                */
+    /* The computation is done one column at a time,                    */
+    /* column j=k+1, ..., SUNMIN(k+smu,n-1).                               */
+
+    last_col_k = SUNMIN(k + smu, n - 1);
+    for (j = k + 1; j <= last_col_k; j++)
+    {
+      col_j     = a[j];
+      storage_l = ROW(l, j, smu);
+      storage_k = ROW(k, j, smu);
+      a_kj      = col_j[storage_l];
+
+      /* Swap the elements a(k,j) and a(k,l) if l!=k. */
+
+      if (swap)
+      {
+        col_j[storage_l] = col_j[storage_k];
+        col_j[storage_k] = a_kj;
+      }
+
+      /* a(i,j) = a(i,j) - [a(i,k)/a(k,k)]*a(k,j) */
+      /* a_kj = a(k,j), *kptr = - a(i,k)/a(k,k), *jptr = a(i,j) */
+
+      if (a_kj != ZERO)
+      {
+        for (i = k + 1, kptr = sub_diag_k, jptr = col_j + ROW(k + 1, j, smu);
+             i <= last_row_k; i++, kptr++, jptr++)
+        {
+          (*jptr) += a_kj * (*kptr);
+        }
+      }
+    }
+  }
+
+  /* set the last pivot row to be n-1 and check for a zero pivot */
+
+  *p = n - 1;
+  if (a[n - 1][smu] == ZERO) { return (n); }
+
+  /* return 0 to indicate success */
+
+  return (0);
+}
+
+static void BAND_FN(GBTRS)(BAND_R** a, sunindextype n, sunindextype smu,
+                           sunindextype ml, sunindextype* p, sunrealtype* b)
+{
+  sunindextype k, l, i, first_row_k, last_row_k;
+  sunrealtype mult;
+  BAND_R* diag_k;
+
+  /* Solve Ly = Pb, store solution y in b */
+
+  for (k = 0; k < n - 1; k++)
+  {
+    l    = p[k];
+    mult = b[l];
+    if (l != k)
+    {
+      b[l] = b[k];
+      b[k] = mult;
+    }
+    diag_k     = a[k] + smu;
+    last_row_k = SUNMIN(n - 1, k + ml);
+    for (i = k + 1; i <= last_row_k; i++) { b[i] += mult * diag_k[i - k]; }
+  }
+
+  /* Solve Ux = y, store solution x in b */
+
+  for (k = n - 1; k >= 0; k--)
+  {
+    diag_k      = a[k] + smu;
+    first_row_k = SUNMAX(0, k - smu);
+    b[k] /= (*diag_k);
+    mult = -b[k];
+    for (i = first_row_k; i <= k - 1; i++) { b[i] += mult * diag_k[i - k]; }
+  }
+}
+
+#undef BAND_R
+#undef BAND_FN
+#undef BAND_ABS
+#undef BAND_ONE
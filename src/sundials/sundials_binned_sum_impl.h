@@ -0,0 +1,338 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * A binned accumulator for reproducible sums, following the
+ * indexed floating-point summation of Demmel, Ahrens and Nguyen
+ * (ReproBLAS).
+ *
+ * The exponent range of double is split into bins of
+ * SUN_BINNED_WIDTH bits and a sum keeps SUN_BINNED_FOLDS
+ * consecutive bins, starting at the highest bin that can hold the
+ * largest term added so far. Each bin j holds a primary field
+ * p[j] = 1.5 E + s with |s| < 0.25 E, where E is the power of two of
+ * the bin, and a carry count c[j] of multiples of 0.25 E. A term is
+ * split exactly among the bins by rounding it to the resolution of
+ * each bin in turn and the part below the last bin is rounded away.
+ * Since the split of a term does not depend on the other terms and
+ * the bins are added exactly, the value of the accumulator depends
+ * only on the set of terms added, not on their order or on how they
+ * were partitioned into partial sums that were merged. The sum is
+ * rounded to double once, by sunBinnedSum_Value, and its error is
+ * about one rounding plus n 2^(-2 SUN_BINNED_WIDTH) times the largest
+ * term.
+ *
+ * Terms are added in double, so the sums are exact for products of
+ * single precision values. Non-finite terms and terms larger than
+ * 2^1007 are accumulated separately in an ordinary sum, which is
+ * reproducible for Inf and NaN but not for such huge finite values.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_BINNED_SUM_IMPL_H
+#define _SUNDIALS_BINNED_SUM_IMPL_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <sundials/sundials_types.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define SUN_BINNED_FOLDS    3    /* number of bins kept by a sum        */
+#define SUN_BINNED_WIDTH    38   /* bits per bin                        */
+#define SUN_BINNED_TOPEXP   1022 /* exponent of the highest bin         */
+#define SUN_BINNED_MAXINDEX 51   /* lowest first bin, keeps E normal    */
+#define SUN_BINNED_BLOCK    2048 /* terms added between renormalization */
+
+/* terms that can be added by sunBinnedSum_AddRange */
+typedef enum
+{
+  SUN_BINNED_DOT,       /* x[i] * y[i]                 */
+  SUN_BINNED_WSQR,      /* (x[i] * y[i])^2             */
+  SUN_BINNED_WSQR_MASK, /* (x[i] * y[i])^2 if z[i] > 0 */
+  SUN_BINNED_ABS        /* |x[i]|                      */
+} sunBinnedTerm;
+
+typedef struct
+{
+  int index;                  /* bin of the first fold             */
+  double p[SUN_BINNED_FOLDS]; /* primary fields, in [1.25E, 1.75E) */
+  double c[SUN_BINNED_FOLDS]; /* carry counts, in units of 0.25E   */
+  double other;               /* sum of non-finite and huge terms  */
+} sunBinnedSum;
+
+/* Power of two E of bin i */
+static inline double sunBinnedSum_Bin(int i)
+{
+  return ldexp(1.0, SUN_BINNED_TOPEXP - SUN_BINNED_WIDTH * i);
+}
+
+/* Set the lowest bit of x so that rounding it never ties */
+static inline double sunBinnedSum_Odd(double x)
+{
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  bits |= 1;
+  memcpy(&x, &bits, sizeof(bits));
+  return x;
+}
+
+static inline void sunBinnedSum_Init(sunBinnedSum* s)
+{
+  int j;
+  s->index = SUN_BINNED_MAXINDEX;
+  for (j = 0; j < SUN_BINNED_FOLDS; j++)
+  {
+    s->p[j] = 1.5 * sunBinnedSum_Bin(s->index + j);
+    s->c[j] = 0.0;
+  }
+  s->other = 0.0;
+}
+
+/* Move the first fold up to bin index, dropping the lowest bins */
+static inline void sunBinnedSum_Raise(sunBinnedSum* s, int index)
+{
+  int j, shift = s->index - index;
+  if (shift <= 0) { return; }
+  for (j = SUN_BINNED_FOLDS - 1; j >= 0; j--)
+  {
+    if (j >= shift)
+    {
+      s->p[j] = s->p[j - shift];
+      s->c[j] = s->c[j - shift];
+    }
+    else
+    {
+      s->p[j] = 1.5 * sunBinnedSum_Bin(index + j);
+      s->c[j] = 0.0;
+    }
+  }
+  s->index = index;
+}
+
+/* Bring the primary fields back to [1.25E, 1.75E) */
+static inline void sunBinnedSum_Renorm(sunBinnedSum* s)
+{
+  int j;
+  double E;
+  for (j = 0; j < SUN_BINNED_FOLDS; j++)
+  {
+    E = sunBinnedSum_Bin(s->index + j);
+    if (s->p[j] >= 1.75 * E)
+    {
+      s->p[j] -= 0.25 * E;
+      s->c[j] += 1.0;
+    }
+    else if (s->p[j] < 1.25 * E)
+    {
+      s->p[j] += 0.25 * E;
+      s->c[j] -= 1.0;
+    }
+  }
+}
+
+/* Largest magnitude of the n terms in t, or NaN if one of them is NaN */
+static inline double sunBinnedSum_AbsMax(const double* t, int n)
+{
+  int i = 0;
+  double a, amax = 0.0, bad = 0.0;
+#if defined(__SSE2__)
+  const __m128d sign = _mm_set1_pd(-0.0);
+  __m128d A0, A1, M0 = _mm_setzero_pd(), M1 = M0, U = M0;
+  double m[2];
+  for (; i + 4 <= n; i += 4)
+  {
+    A0 = _mm_andnot_pd(sign, _mm_loadu_pd(t + i));
+    A1 = _mm_andnot_pd(sign, _mm_loadu_pd(t + i + 2));
+    M0 = _mm_max_pd(M0, A0);
+    M1 = _mm_max_pd(M1, A1);
+    U  = _mm_or_pd(U, _mm_cmpunord_pd(A0, A1));
+  }
+  _mm_storeu_pd(m, _mm_max_pd(M0, M1));
+  amax = (m[1] > m[0]) ? m[1] : m[0];
+  if (_mm_movemask_pd(U)) { bad = NAN; }
+#endif
+  for (; i < n; i++)
+  {
+    a    = fabs(t[i]);
+    amax = (a > amax) ? a : amax;
+    if (a != a) { bad = a; }
+  }
+  return (bad != bad) ? bad : amax;
+}
+
+/* Deposit the n terms in t in the bin with power of two E and replace them
+   with the parts below the bin, unless this is the last bin. The terms are
+   split among independent lanes and the change of the primary field is
+   returned. */
+static inline double sunBinnedSum_Deposit(double* t, int n, double E,
+                                          sunbooleantype last)
+{
+  int i = 0;
+  double q, p = 1.5 * E, d = 0.0;
+#if defined(__SSE2__)
+  const __m128d odd = _mm_castsi128_pd(_mm_set1_epi64x(1));
+  __m128d P0 = _mm_set1_pd(p), P1 = P0, P2 = P0, P3 = P0;
+  __m128d X0, X1, X2, X3, Q0, Q1, Q2, Q3;
+  double lane[8];
+  int l;
+  for (; i + 8 <= n; i += 8)
+  {
+    X0 = _mm_loadu_pd(t + i);
+    X1 = _mm_loadu_pd(t + i + 2);
+    X2 = _mm_loadu_pd(t + i + 4);
+    X3 = _mm_loadu_pd(t + i + 6);
+    Q0 = _mm_add_pd(_mm_or_pd(X0, odd), P0);
+    Q1 = _mm_add_pd(_mm_or_pd(X1, odd), P1);
+    Q2 = _mm_add_pd(_mm_or_pd(X2, odd), P2);
+    Q3 = _mm_add_pd(_mm_or_pd(X3, odd), P3);
+    if (!last)
+    {
+      _mm_storeu_pd(t + i, _mm_add_pd(X0, _mm_sub_pd(P0, Q0)));
+      _mm_storeu_pd(t + i + 2, _mm_add_pd(X1, _mm_sub_pd(P1, Q1)));
+      _mm_storeu_pd(t + i + 4, _mm_add_pd(X2, _mm_sub_pd(P2, Q2)));
+      _mm_storeu_pd(t + i + 6, _mm_add_pd(X3, _mm_sub_pd(P3, Q3)));
+    }
+    P0 = Q0;
+    P1 = Q1;
+    P2 = Q2;
+    P3 = Q3;
+  }
+  _mm_storeu_pd(lane, P0);
+  _mm_storeu_pd(lane + 2, P1);
+  _mm_storeu_pd(lane + 4, P2);
+  _mm_storeu_pd(lane + 6, P3);
+  for (l = 0; l < 8; l++) { d += lane[l] - 1.5 * E; }
+#endif
+  for (; i < n; i++)
+  {
+    q = sunBinnedSum_Odd(t[i]) + p;
+    if (!last) { t[i] += p - q; }
+    p = q;
+  }
+  return d + (p - 1.5 * E);
+}
+
+/* Add the n <= SUN_BINNED_BLOCK terms in t, which are overwritten */
+static inline void sunBinnedSum_Add(sunBinnedSum* s, double* t, int n)
+{
+  int i, j, e, index;
+  double amax, a;
+  const double huge = ldexp(1.0, SUN_BINNED_TOPEXP - 15);
+
+  /* find the largest term, moving non-finite and huge ones aside */
+  amax = sunBinnedSum_AbsMax(t, n);
+  if (!(amax < huge))
+  {
+    amax = 0.0;
+    for (i = 0; i < n; i++)
+    {
+      a = fabs(t[i]);
+      if (a < huge) { amax = (a > amax) ? a : amax; }
+      else
+      {
+        s->other += t[i];
+        t[i] = 0.0;
+      }
+    }
+  }
+  if (amax == 0.0) { return; }
+
+  /* the first bin must satisfy amax < 2^(e-15) so that the bin above
+     it never receives any part of a term */
+  (void)frexp(amax, &e);
+  index = (SUN_BINNED_TOPEXP - 15 - e) / SUN_BINNED_WIDTH;
+  if (index > SUN_BINNED_MAXINDEX) { index = SUN_BINNED_MAXINDEX; }
+  sunBinnedSum_Raise(s, index);
+
+  /* the lanes moved by less than 0.125E in total, so adding them to the
+     renormalized primary fields is exact */
+  for (j = 0; j < SUN_BINNED_FOLDS; j++)
+  {
+    s->p[j] += sunBinnedSum_Deposit(t, n, sunBinnedSum_Bin(s->index + j),
+                                    j == SUN_BINNED_FOLDS - 1);
+  }
+  sunBinnedSum_Renorm(s);
+}
+
+/* Add the terms with indices start <= i < end */
+static inline void sunBinnedSum_AddRange(sunBinnedSum* s, sunBinnedTerm term,
+                                         const sunrealtype* x,
+                                         const sunrealtype* y,
+                                         const sunrealtype* z,
+                                         sunindextype start, sunindextype end)
+{
+  sunindextype i;
+  int k, n;
+  double t[SUN_BINNED_BLOCK];
+
+  for (i = start; i < end; i += n)
+  {
+    n = (end - i < SUN_BINNED_BLOCK) ? (int)(end - i) : SUN_BINNED_BLOCK;
+    switch (term)
+    {
+    case SUN_BINNED_DOT:
+      for (k = 0; k < n; k++) { t[k] = (double)x[i + k] * (double)y[i + k]; }
+      break;
+    case SUN_BINNED_WSQR:
+      for (k = 0; k < n; k++)
+      {
+        t[k] = (double)x[i + k] * (double)y[i + k];
+        t[k] = t[k] * t[k];
+      }
+      break;
+    case SUN_BINNED_WSQR_MASK:
+      for (k = 0; k < n; k++)
+      {
+        t[k] = (double)x[i + k] * (double)y[i + k];
+        t[k] = (z[i + k] > 0) ? t[k] * t[k] : 0.0;
+      }
+      break;
+    case SUN_BINNED_ABS:
+      for (k = 0; k < n; k++) { t[k] = fabs((double)x[i + k]); }
+      break;
+    }
+    sunBinnedSum_Add(s, t, n);
+  }
+}
+
+/* Add the sum b to a; the result does not depend on the order */
+static inline void sunBinnedSum_Merge(sunBinnedSum* a, const sunBinnedSum* b)
+{
+  int j, shift;
+
+  if (b->index < a->index) { sunBinnedSum_Raise(a, b->index); }
+  shift = b->index - a->index;
+
+  for (j = 0; j + shift < SUN_BINNED_FOLDS; j++)
+  {
+    a->p[j + shift] += b->p[j] - 1.5 * sunBinnedSum_Bin(b->index + j);
+    a->c[j + shift] += b->c[j];
+  }
+  sunBinnedSum_Renorm(a);
+  a->other += b->other;
+}
+
+/* Round the sum to double */
+static inline double sunBinnedSum_Value(const sunBinnedSum* s)
+{
+  int j;
+  double E, sum = 0.0;
+  for (j = 0; j < SUN_BINNED_FOLDS; j++)
+  {
+    E = sunBinnedSum_Bin(s->index + j);
+    sum += (s->p[j] - 1.5 * E) + 0.25 * E * s->c[j];
+  }
+  return sum + s->other;
+}
+
+#endif
@@ -0,0 +1,337 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for a generic SUNCheckpointStore
+ * package. It contains the implementation of the SUNCheckpointStore
+ * operations listed in sundials_checkpointstore.h
+ * -----------------------------------------------------------------*/
+
+#include <string.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_checkpointstore.h>
+
+#include "sundials/sundials_errors.h"
+#include "sundials_checkpointstore_impl.h"
+
+/* -----------------------------------------------------------------
+ * Create a new empty SUNCheckpointStore object
+ * ----------------------------------------------------------------- */
+
+SUNCheckpointStore SUNCheckpointStore_NewEmpty(SUNContext sunctx)
+{
+  SUNCheckpointStore S;
+  SUNCheckpointStore_Ops ops;
+
+  /* a context is required */
+  if (sunctx == NULL) { return (NULL); }
+
+  SUNFunctionBegin(sunctx);
+
+  /* create store object */
+  S = NULL;
+  S = (SUNCheckpointStore)malloc(sizeof *S);
+  SUNAssertNull(S, SUN_ERR_MALLOC_FAIL);
+
+  /* create store ops structure */
+  ops = NULL;
+  ops = (SUNCheckpointStore_Ops)malloc(sizeof *ops);
+  SUNAssertNull(ops, SUN_ERR_MALLOC_FAIL);
+
+  /* initialize operations to NULL */
+  ops->write    = NULL;
+  ops->read     = NULL;
+  ops->remove   = NULL;
+  ops->prefetch = NULL;
+  ops->destroy  = NULL;
+
+  /* attach ops and initialize content to NULL */
+  S->ops     = ops;
+  S->content = NULL;
+  S->sunctx  = sunctx;
+
+  return (S);
+}
+
+/* -----------------------------------------------------------------
+ * Free a generic SUNCheckpointStore (assumes content is already empty)
+ * ----------------------------------------------------------------- */
+
+void SUNCheckpointStore_DestroyEmpty(SUNCheckpointStore S)
+{
+  if (S == NULL) { return; }
+
+  /* free non-NULL ops structure */
+  if (S->ops) { free(S->ops); }
+  S->ops = NULL;
+
+  /* free overall SUNCheckpointStore object and return */
+  free(S);
+  return;
+}
+
+/* -----------------------------------------------------------------
+ * Required functions in the 'ops' structure for non-NULL store
+ * ----------------------------------------------------------------- */
+
+SUNErrCode SUNCheckpointStore_Write(SUNCheckpointStore S, long int key,
+                                    const void* buf, size_t nbytes)
+{
+  if (S == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(buf || nbytes == 0, SUN_ERR_ARG_CORRUPT);
+  if (S->ops->write == NULL) { return SUN_ERR_NOT_IMPLEMENTED; }
+  return (S->ops->write(S, key, buf, nbytes));
+}
+
+SUNErrCode SUNCheckpointStore_Read(SUNCheckpointStore S, long int key,
+                                   void* buf, size_t nbytes)
+{
+  if (S == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(buf || nbytes == 0, SUN_ERR_ARG_CORRUPT);
+  if (S->ops->read == NULL) { return SUN_ERR_NOT_IMPLEMENTED; }
+  return (S->ops->read(S, key, buf, nbytes));
+}
+
+SUNErrCode SUNCheckpointStore_Remove(SUNCheckpointStore S, long int key)
+{
+  if (S == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  if (S->ops->remove == NULL) { return SUN_ERR_NOT_IMPLEMENTED; }
+  return (S->ops->remove(S, key));
+}
+
+/* -----------------------------------------------------------------
+ * Optional functions in the 'ops' structure
+ * ----------------------------------------------------------------- */
+
+SUNErrCode SUNCheckpointStore_Prefetch(SUNCheckpointStore S, long int key)
+{
+  if (S == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  if (S->ops->prefetch) { return (S->ops->prefetch(S, key)); }
+  return (SUN_SUCCESS);
+}
+
+SUNErrCode SUNCheckpointStore_Destroy(SUNCheckpointStore S)
+{
+  if (S == NULL) { return (SUN_SUCCESS); }
+
+  /* if the destroy operation exists use it */
+  if (S->ops)
+  {
+    if (S->ops->destroy) { return (S->ops->destroy(S)); }
+  }
+
+  /* if we reach this point, either ops == NULL or destroy == NULL,
+     try to cleanup by freeing the content, ops, and store */
+  if (S->content)
+  {
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops)
+  {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S);
+  S = NULL;
+
+  return (SUN_SUCCESS);
+}
+
+/* -----------------------------------------------------------------
+ * Record index for the file based implementations
+ * ----------------------------------------------------------------- */
+
+SUNErrCode SUNCheckpointIndex_New(SUNCheckpointIndex* index)
+{
+  *index = (SUNCheckpointIndex)malloc(sizeof(**index));
+  if (*index == NULL) { return SUN_ERR_MALLOC_FAIL; }
+
+  (*index)->rec     = NULL;
+  (*index)->nrec    = 0;
+  (*index)->maxrec  = 0;
+  (*index)->hole    = NULL;
+  (*index)->nhole   = 0;
+  (*index)->maxhole = 0;
+  (*index)->end     = 0;
+
+  return SUN_SUCCESS;
+}
+
+void SUNCheckpointIndex_Destroy(SUNCheckpointIndex* index)
+{
+  if (index == NULL || *index == NULL) { return; }
+  free((*index)->rec);
+  free((*index)->hole);
+  free(*index);
+  *index = NULL;
+}
+
+/* Position of the first record whose key is not less than key */
+static size_t sunIndexLowerBound(SUNCheckpointIndex index, long int key)
+{
+  size_t lo = 0;
+  size_t hi = index->nrec;
+
+  while (lo < hi)
+  {
+    size_t mid = lo + (hi - lo) / 2;
+    if (index->rec[mid].key < key) { lo = mid + 1; }
+    else { hi = mid; }
+  }
+
+  return lo;
+}
+
+SUNCheckpointRecord* SUNCheckpointIndex_Find(SUNCheckpointIndex index,
+                                             long int key)
+{
+  size_t i = sunIndexLowerBound(index, key);
+  if (i < index->nrec && index->rec[i].key == key) { return &(index->rec[i]); }
+  return NULL;
+}
+
+SUNErrCode SUNCheckpointIndex_Insert(SUNCheckpointIndex index, long int key,
+                                     size_t nbytes, SUNCheckpointRecord** rec)
+{
+  size_t i, h, extent, offset;
+
+  /* grow the record array if needed */
+  if (index->nrec == index->maxrec)
+  {
+    size_t maxrec = (index->maxrec == 0) ? 64 : 2 * index->maxrec;
+    SUNCheckpointRecord* tmp =
+      (SUNCheckpointRecord*)realloc(index->rec, maxrec * sizeof(*tmp));
+    if (tmp == NULL) { return SUN_ERR_MALLOC_FAIL; }
+    index->rec    = tmp;
+    index->maxrec = maxrec;
+  }
+
+  extent = ((nbytes + SUN_CHECKPOINTINDEX_ALIGN - 1) /
+            SUN_CHECKPOINTINDEX_ALIGN) *
+           SUN_CHECKPOINTINDEX_ALIGN;
+  if (extent == 0) { extent = SUN_CHECKPOINTINDEX_ALIGN; }
+
+  /* first fit among the holes, otherwise append */
+  for (h = 0; h < index->nhole; h++)
+  {
+    if (index->hole[h].length >= extent) { break; }
+  }
+
+  if (h < index->nhole)
+  {
+    offset = index->hole[h].offset;
+    index->hole[h].offset += extent;
+    index->hole[h].length -= extent;
+    if (index->hole[h].length == 0)
+    {
+      memmove(&(index->hole[h]), &(index->hole[h + 1]),
+              (index->nhole - h - 1) * sizeof(SUNCheckpointHole));
+      index->nhole--;
+    }
+  }
+  else
+  {
+    offset = index->end;
+    index->end += extent;
+  }
+
+  i = sunIndexLowerBound(index, key);
+  memmove(&(index->rec[i + 1]), &(index->rec[i]),
+          (index->nrec - i) * sizeof(SUNCheckpointRecord));
+  index->nrec++;
+
+  index->rec[i].key    = key;
+  index->rec[i].offset = offset;
+  index->rec[i].nbytes = nbytes;
+  index->rec[i].extent = extent;
+
+  *rec = &(index->rec[i]);
+
+  return SUN_SUCCESS;
+}
+
+void SUNCheckpointIndex_Erase(SUNCheckpointIndex index, long int key)
+{
+  size_t i, h, offset, extent;
+
+  i = sunIndexLowerBound(index, key);
+  if (i == index->nrec || index->rec[i].key != key) { return; }
+
+  offset = index->rec[i].offset;
+  extent = index->rec[i].extent;
+
+  memmove(&(index->rec[i]), &(index->rec[i + 1]),
+          (index->nrec - i - 1) * sizeof(SUNCheckpointRecord));
+  index->nrec--;
+
+  /* a range at the end shrinks the space in use, together with any holes
+     that then reach the end */
+  if (offset + extent == index->end)
+  {
+    index->end = offset;
+    while (index->nhole > 0 &&
+           index->hole[index->nhole - 1].offset +
+               index->hole[index->nhole - 1].length ==
+             index->end)
+    {
+      index->end = index->hole[index->nhole - 1].offset;
+      index->nhole--;
+    }
+    return;
+  }
+
+  /* otherwise insert a hole, merging it with its neighbors */
+  for (h = 0; h < index->nhole; h++)
+  {
+    if (index->hole[h].offset > offset) { break; }
+  }
+
+  if (h > 0 && index->hole[h - 1].offset + index->hole[h - 1].length == offset)
+  {
+    index->hole[h - 1].length += extent;
+    if (h < index->nhole &&
+        index->hole[h - 1].offset + index->hole[h - 1].length ==
+          index->hole[h].offset)
+    {
+      index->hole[h - 1].length += index->hole[h].length;
+      memmove(&(index->hole[h]), &(index->hole[h + 1]),
+              (index->nhole - h - 1) * sizeof(SUNCheckpointHole));
+      index->nhole--;
+    }
+    return;
+  }
+
+  if (h < index->nhole && offset + extent == index->hole[h].offset)
+  {
+    index->hole[h].offset = offset;
+    index->hole[h].length += extent;
+    return;
+  }
+
+  if (index->nhole == index->maxhole)
+  {
+    size_t maxhole = (index->maxhole == 0) ? 16 : 2 * index->maxhole;
+    SUNCheckpointHole* tmp =
+      (SUNCheckpointHole*)realloc(index->hole, maxhole * sizeof(*tmp));
+    /* without memory for the hole, the range is simply not reused */
+    if (tmp == NULL) { return; }
+    index->hole    = tmp;
+    index->maxhole = maxhole;
+  }
+
+  memmove(&(index->hole[h + 1]), &(index->hole[h]),
+          (index->nhole - h) * sizeof(SUNCheckpointHole));
+  index->nhole++;
+  index->hole[h].offset = offset;
+  index->hole[h].length = extent;
+}
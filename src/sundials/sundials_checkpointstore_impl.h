@@ -0,0 +1,75 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Record index shared by the file based SUNCheckpointStore
+ * implementations. It maps keys to byte ranges of a file and
+ * recycles the ranges of removed records.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_CHECKPOINTSTORE_IMPL_H
+#define _SUNDIALS_CHECKPOINTSTORE_IMPL_H
+
+#include <stdlib.h>
+#include <sundials/sundials_types.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Records start on multiples of this many bytes */
+#define SUN_CHECKPOINTINDEX_ALIGN 64
+
+typedef struct
+{
+  long int key;  /* record key                   */
+  size_t offset; /* start of the record in bytes */
+  size_t nbytes; /* length of the record         */
+  size_t extent; /* allocated (aligned) length   */
+} SUNCheckpointRecord;
+
+typedef struct
+{
+  size_t offset;
+  size_t length;
+} SUNCheckpointHole;
+
+typedef struct SUNCheckpointIndex_
+{
+  SUNCheckpointRecord* rec; /* records sorted by key          */
+  size_t nrec;
+  size_t maxrec;
+  SUNCheckpointHole* hole; /* free ranges sorted by offset   */
+  size_t nhole;
+  size_t maxhole;
+  size_t end; /* end of the space in use        */
+}* SUNCheckpointIndex;
+
+SUNErrCode SUNCheckpointIndex_New(SUNCheckpointIndex* index);
+void SUNCheckpointIndex_Destroy(SUNCheckpointIndex* index);
+
+/* Returns the record with the given key or NULL. The pointer is valid until
+   the next call to Insert or Erase. */
+SUNCheckpointRecord* SUNCheckpointIndex_Find(SUNCheckpointIndex index,
+                                             long int key);
+
+/* Adds a record of nbytes bytes, reusing the first hole that is large
+   enough or appending at the end. The key must not be in the index. */
+SUNErrCode SUNCheckpointIndex_Insert(SUNCheckpointIndex index, long int key,
+                                     size_t nbytes, SUNCheckpointRecord** rec);
+
+/* Removes a record and returns its range to the free space */
+void SUNCheckpointIndex_Erase(SUNCheckpointIndex index, long int key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,10 +23,253 @@
 #include <sundials/sundials_dense.h>
 #include <sundials/sundials_math.h>
 
+#if defined(SUNDIALS_DENSE_SIMD)
+#define DENSE_SIMD_ENABLED
+#include <immintrin.h>
+#endif
+
 #define ZERO SUN_RCONST(0.0)
 #define ONE  SUN_RCONST(1.0)
 #define TWO  SUN_RCONST(2.0)
 
+/* Block sizes of the LU factorization: panel width, and numbers of rows
+ * and columns in a block of the trailing update */
+#define DENSE_NB 32
+#define DENSE_NI 256
+#define DENSE_NJ 64
+
+/*
+ * -----------------------------------------------------
+ * Kernels of the blocked LU factorization
+ * -----------------------------------------------------
+ */
+
+/* The kernels for sunrealtype are named denseSIMDUpdate_<isa> and, when
+ * sunrealtype is not float, the kernels for float denseSIMDSUpdate_<isa>.
+ * In single precision the float kernels are the sunrealtype kernels. */
+
+typedef void (*DenseUpdateFn)(sunrealtype** a, sunindextype i0,
+                              sunindextype i1, sunindextype k0,
+                              sunindextype k1, sunindextype j0,
+                              sunindextype j1);
+
+typedef void (*DenseSUpdateFn)(float** a, sunindextype i0, sunindextype i1,
+                               sunindextype k0, sunindextype k1,
+                               sunindextype j0, sunindextype j1);
+
+#define SIMD_PASTE_(name, isa) name##_##isa
+#define SIMD_PASTE(name, isa)  SIMD_PASTE_(name, isa)
+
+#if defined(SUNDIALS_SINGLE_PRECISION)
+#define SIMD_FN_FLOAT(name) SIMD_PASTE(denseSIMD##name, SIMD_ISA)
+#else
+#define SIMD_FN_FLOAT(name) SIMD_PASTE(denseSIMDS##name, SIMD_ISA)
+#endif
+
+/* generic kernels */
+
+#define SIMD_ISA
+#define SIMD_TARGET
+
+#define SIMD_FN(name)     SIMD_PASTE(denseSIMD##name, SIMD_ISA)
+#define SIMD_R            sunrealtype
+#define SIMD_T            sunrealtype
+#define SIMD_W            1
+#define SIMD_LOAD(p)      (*(p))
+#define SIMD_STORE(p, v)  (*(p) = (v))
+#define SIMD_SET1(s)      (s)
+#define SIMD_FMA(a, b, c) ((c) + (a) * (b))
+
+#include "sundials_dense_kernels.h"
+
+#if !defined(SUNDIALS_SINGLE_PRECISION)
+#define SIMD_FN(name)     SIMD_FN_FLOAT(name)
+#define SIMD_R            float
+#define SIMD_T            float
+#define SIMD_W            1
+#define SIMD_LOAD(p)      (*(p))
+#define SIMD_STORE(p, v)  (*(p) = (v))
+#define SIMD_SET1(s)      (s)
+#define SIMD_FMA(a, b, c) ((c) + (a) * (b))
+
+#include "sundials_dense_kernels.h"
+#endif
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+
+#if defined(DENSE_SIMD_ENABLED)
+
+/* SSE2 kernels, without fused multiply-add */
+
+#define SIMD_ISA    sse2
+#define SIMD_TARGET __attribute__((target("sse2")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_FN(name)     SIMD_PASTE(denseSIMD##name, SIMD_ISA)
+#define SIMD_R            double
+#define SIMD_T            __m128d
+#define SIMD_W            2
+#define SIMD_LOAD(p)      _mm_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm_set1_pd(s)
+#define SIMD_FMA(a, b, c) _mm_add_pd(c, _mm_mul_pd(a, b))
+
+#include "sundials_dense_kernels.h"
+#endif
+
+#define SIMD_FN(name)     SIMD_FN_FLOAT(name)
+#define SIMD_R            float
+#define SIMD_T            __m128
+#define SIMD_W            4
+#define SIMD_LOAD(p)      _mm_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm_set1_ps(s)
+#define SIMD_FMA(a, b, c) _mm_add_ps(c, _mm_mul_ps(a, b))
+
+#include "sundials_dense_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+
+/* AVX2 and FMA kernels */
+
+#define SIMD_ISA    avx2
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_FN(name)     SIMD_PASTE(denseSIMD##name, SIMD_ISA)
+#define SIMD_R            double
+#define SIMD_T            __m256d
+#define SIMD_W            4
+#define SIMD_LOAD(p)      _mm256_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm256_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm256_set1_pd(s)
+#define SIMD_FMA(a, b, c) _mm256_fmadd_pd(a, b, c)
+
+#include "sundials_dense_kernels.h"
+#endif
+
+#define SIMD_FN(name)     SIMD_FN_FLOAT(name)
+#define SIMD_R            float
+#define SIMD_T            __m256
+#define SIMD_W            8
+#define SIMD_LOAD(p)      _mm256_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm256_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm256_set1_ps(s)
+#define SIMD_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+
+#include "sundials_dense_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+
+/* AVX-512 kernels */
+
+#define SIMD_ISA    avx512
+#define SIMD_TARGET __attribute__((target("avx512f")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_FN(name)     SIMD_PASTE(denseSIMD##name, SIMD_ISA)
+#define SIMD_R            double
+#define SIMD_T            __m512d
+#define SIMD_W            8
+#define SIMD_LOAD(p)      _mm512_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm512_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm512_set1_pd(s)
+#define SIMD_FMA(a, b, c) _mm512_fmadd_pd(a, b, c)
+
+#include "sundials_dense_kernels.h"
+#endif
+
+#define SIMD_FN(name)     SIMD_FN_FLOAT(name)
+#define SIMD_R            float
+#define SIMD_T            __m512
+#define SIMD_W            16
+#define SIMD_LOAD(p)      _mm512_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm512_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm512_set1_ps(s)
+#define SIMD_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+
+#include "sundials_dense_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+
+#endif /* DENSE_SIMD_ENABLED */
+
+/* SIMD kernels for sunrealtype exist in double and single precision */
+#if defined(DENSE_SIMD_ENABLED) && \
+  (defined(SUNDIALS_DOUBLE_PRECISION) || defined(SUNDIALS_SINGLE_PRECISION))
+#define DENSE_SIMD_REAL
+#endif
+
+/* Select the widest kernel supported by the CPU. The selection is cached;
+ * concurrent first calls may race but store the same value. */
+static DenseUpdateFn denseSelectUpdate(void)
+{
+  static DenseUpdateFn update = NULL;
+
+  if (update) { return update; }
+
+#if defined(DENSE_SIMD_REAL)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) { update = denseSIMDUpdate_avx512; }
+  else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    update = denseSIMDUpdate_avx2;
+  }
+  else if (__builtin_cpu_supports("sse2")) { update = denseSIMDUpdate_sse2; }
+  else { update = denseSIMDUpdate_; }
+#else
+  update = denseSIMDUpdate_;
+#endif
+
+  return update;
+}
+
+#define DENSE_R        sunrealtype
+#define DENSE_FN(name) dense##name
+#define DENSE_UPDATE_T DenseUpdateFn
+#define DENSE_ABS(x)   SUNRabs(x)
+#define DENSE_ONE      ONE
+
+#include "sundials_dense_lu.h"
+
+#if !defined(SUNDIALS_SINGLE_PRECISION)
+
+static DenseSUpdateFn denseSSelectUpdate(void)
+{
+  static DenseSUpdateFn update = NULL;
+
+  if (update) { return update; }
+
+#if defined(DENSE_SIMD_ENABLED)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) { update = denseSIMDSUpdate_avx512; }
+  else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    update = denseSIMDSUpdate_avx2;
+  }
+  else if (__builtin_cpu_supports("sse2")) { update = denseSIMDSUpdate_sse2; }
+  else { update = denseSIMDSUpdate_; }
+#else
+  update = denseSIMDSUpdate_;
+#endif
+
+  return update;
+}
+
+#define DENSE_R        float
+#define DENSE_FN(name) denseS##name
+#define DENSE_UPDATE_T DenseSUpdateFn
+#define DENSE_ABS(x)   fabsf(x)
+#define DENSE_ONE      1.0f
+
+#include "sundials_dense_lu.h"
+
+#endif
+
 /*
  * -----------------------------------------------------
  * Functions working on SUNDlsMat
@@ -82,104 +325,40 @@ void SUNDlsMat_DenseMatvec(SUNDlsMat A, sunrealtype* x, sunrealtype* y)
 sunindextype SUNDlsMat_denseGETRF(sunrealtype** a, sunindextype m,
                                   sunindextype n, sunindextype* p)
 {
-  sunindextype i, j, k, l;
-  sunrealtype *col_j, *col_k;
-  sunrealtype temp, mult, a_kj;
-
-  /* k-th elimination step number */
-  for (k = 0; k < n; k++)
-  {
-    col_k = a[k];
-
-    /* find l = pivot row number */
-    l = k;
-    for (i = k + 1; i < m; i++)
-    {
-      if (SUNRabs(col_k[i]) > SUNRabs(col_k[l])) { l = i; }
-    }
-    p[k] = l;
-
-    /* check for zero pivot element */
-    if (col_k[l] == ZERO) { return (k + 1); }
-
-    /* swap a(k,1:n) and a(l,1:n) if necessary */
-    if (l != k)
-    {
-      for (i = 0; i < n; i++)
-      {
-        temp    = a[i][l];
-        a[i][l] = a[i][k];
-        a[i][k] = temp;
-      }
-    }
-
-    /* Scale the elements below the diagonal in
-     * column k by 1.0/a(k,k). After the above swap
-     * a(k,k) holds the pivot element. This scaling
-     * stores the pivot row multipliers a(i,k)/a(k,k)
-     * in a(i,k), i=k+1, ..., m-1.
-     */
-    mult = ONE / col_k[k];
-    for (i = k + 1; i < m; i++) { col_k[i] *= mult; }
-
-    /* row_i = row_i - [a(i,k)/a(k,k)] row_k, i=k+1, ..., m-1 */
-    /* row k is the pivot row after swapping with row l.      */
-    /* The computation is done one column at a time,          */
-    /* column j=k+1, ..., n-1.                                */
-
-    for (j = k + 1; j < n; j++)
-    {
-      col_j = a[j];
-      a_kj  = col_j[k];
-
-      /* a(i,j) = a(i,j) - [a(i,k)/a(k,k)]*a(k,j)  */
-      /* a_kj = a(k,j), col_k[i] = - a(i,k)/a(k,k) */
-
-      if (a_kj != ZERO)
-      {
-        for (i = k + 1; i < m; i++) { col_j[i] -= a_kj * col_k[i]; }
-      }
-    }
-  }
-
-  /* return 0 to indicate success */
+  return (SUNDlsMat_denseGETRFThreads(a, m, n, p, 1));
+}
 
-  return (0);
+sunindextype SUNDlsMat_denseGETRFThreads(sunrealtype** a, sunindextype m,
+                                         sunindextype n, sunindextype* p,
+                                         int num_threads)
+{
+  return (denseGETRF(a, m, n, p, num_threads));
 }
 
 void SUNDlsMat_denseGETRS(sunrealtype** a, sunindextype n, sunindextype* p,
                           sunrealtype* b)
 {
-  sunindextype i, k, pk;
-  sunrealtype *col_k, tmp;
-
-  /* Permute b, based on pivot information in p */
-  for (k = 0; k < n; k++)
-  {
-    pk = p[k];
-    if (pk != k)
-    {
-      tmp   = b[k];
-      b[k]  = b[pk];
-      b[pk] = tmp;
-    }
-  }
+  denseGETRS(a, n, p, b);
+}
 
-  /* Solve Ly = b, store solution y in b */
-  for (k = 0; k < n - 1; k++)
-  {
-    col_k = a[k];
-    for (i = k + 1; i < n; i++) { b[i] -= col_k[i] * b[k]; }
-  }
+sunindextype SUNDlsMat_denseSGETRF(float** a, sunindextype m, sunindextype n,
+                                   sunindextype* p, int num_threads)
+{
+#if defined(SUNDIALS_SINGLE_PRECISION)
+  return (denseGETRF(a, m, n, p, num_threads));
+#else
+  return (denseSGETRF(a, m, n, p, num_threads));
+#endif
+}
 
-  /* Solve Ux = y, store solution x in b */
-  for (k = n - 1; k > 0; k--)
-  {
-    col_k = a[k];
-    b[k] /= col_k[k];
-    for (i = 0; i < k; i++) { b[i] -= col_k[i] * b[k]; }
-  }
-  b[0] /= a[0][0];
+void SUNDlsMat_denseSGETRS(float** a, sunindextype n, sunindextype* p,
+                           sunrealtype* b)
+{
+#if defined(SUNDIALS_SINGLE_PRECISION)
+  denseGETRS(a, n, p, b);
+#else
+  denseSGETRS(a, n, p, b);
+#endif
 }
 
 /*
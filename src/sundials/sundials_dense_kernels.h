@@ -0,0 +1,151 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Kernels for the blocked dense LU factorization. This file is
+ * included once for each instruction set by sundials_dense.c after
+ * defining the following macros:
+ *
+ *   SIMD_FN(name)     - name of the kernel for the instruction set
+ *   SIMD_TARGET       - function attribute enabling the set
+ *   SIMD_R            - type of the matrix entries
+ *   SIMD_T            - vector register type
+ *   SIMD_W            - number of SIMD_R values in SIMD_T
+ *   SIMD_LOAD(p)      - unaligned load
+ *   SIMD_STORE(p, v)  - unaligned store
+ *   SIMD_SET1(s)      - broadcast
+ *   SIMD_FMA(a, b, c) - a * b + c
+ *
+ * The generic kernels use SIMD_T = SIMD_R and SIMD_W = 1. All the
+ * macros but SIMD_TARGET are undefined at the end of this file.
+ * -----------------------------------------------------------------*/
+
+/* -----------------------------------------------------------------
+ * Trailing update of the blocked LU factorization,
+ *
+ *   a(i0:i1-1, j0:j1-1) -= a(i0:i1-1, k0:k1-1) * a(k0:k1-1, j0:j1-1)
+ *
+ * where a holds pointers to the columns and i0 >= k1. Tiles of two
+ * vectors of rows by four columns are kept in registers while the
+ * products are accumulated over k, in increasing k as in the
+ * unblocked factorization, so each entry of L is loaded once per
+ * four columns.
+ * ----------------------------------------------------------------*/
+
+SIMD_TARGET static void SIMD_FN(Update)(SIMD_R** a, sunindextype i0,
+                                        sunindextype i1, sunindextype k0,
+                                        sunindextype k1, sunindextype j0,
+                                        sunindextype j1)
+{
+  sunindextype i, j, k;
+  SIMD_R *c0, *c1, *c2, *c3, l, s0, s1, s2, s3;
+
+  for (j = j0; j + 4 <= j1; j += 4)
+  {
+    c0 = a[j];
+    c1 = a[j + 1];
+    c2 = a[j + 2];
+    c3 = a[j + 3];
+
+    for (i = i0; i + 2 * SIMD_W <= i1; i += 2 * SIMD_W)
+    {
+      SIMD_T x00 = SIMD_LOAD(c0 + i);
+      SIMD_T x01 = SIMD_LOAD(c0 + i + SIMD_W);
+      SIMD_T x10 = SIMD_LOAD(c1 + i);
+      SIMD_T x11 = SIMD_LOAD(c1 + i + SIMD_W);
+      SIMD_T x20 = SIMD_LOAD(c2 + i);
+      SIMD_T x21 = SIMD_LOAD(c2 + i + SIMD_W);
+      SIMD_T x30 = SIMD_LOAD(c3 + i);
+      SIMD_T x31 = SIMD_LOAD(c3 + i + SIMD_W);
+
+      for (k = k0; k < k1; k++)
+      {
+        SIMD_T l0 = SIMD_LOAD(a[k] + i);
+        SIMD_T l1 = SIMD_LOAD(a[k] + i + SIMD_W);
+        SIMD_T u;
+
+        u   = SIMD_SET1(-c0[k]);
+        x00 = SIMD_FMA(u, l0, x00);
+        x01 = SIMD_FMA(u, l1, x01);
+        u   = SIMD_SET1(-c1[k]);
+        x10 = SIMD_FMA(u, l0, x10);
+        x11 = SIMD_FMA(u, l1, x11);
+        u   = SIMD_SET1(-c2[k]);
+        x20 = SIMD_FMA(u, l0, x20);
+        x21 = SIMD_FMA(u, l1, x21);
+        u   = SIMD_SET1(-c3[k]);
+        x30 = SIMD_FMA(u, l0, x30);
+        x31 = SIMD_FMA(u, l1, x31);
+      }
+
+      SIMD_STORE(c0 + i, x00);
+      SIMD_STORE(c0 + i + SIMD_W, x01);
+      SIMD_STORE(c1 + i, x10);
+      SIMD_STORE(c1 + i + SIMD_W, x11);
+      SIMD_STORE(c2 + i, x20);
+      SIMD_STORE(c2 + i + SIMD_W, x21);
+      SIMD_STORE(c3 + i, x30);
+      SIMD_STORE(c3 + i + SIMD_W, x31);
+    }
+
+    /* remaining rows */
+    for (; i < i1; i++)
+    {
+      s0 = c0[i];
+      s1 = c1[i];
+      s2 = c2[i];
+      s3 = c3[i];
+      for (k = k0; k < k1; k++)
+      {
+        l = a[k][i];
+        s0 -= c0[k] * l;
+        s1 -= c1[k] * l;
+        s2 -= c2[k] * l;
+        s3 -= c3[k] * l;
+      }
+      c0[i] = s0;
+      c1[i] = s1;
+      c2[i] = s2;
+      c3[i] = s3;
+    }
+  }
+
+  /* remaining columns */
+  for (; j < j1; j++)
+  {
+    c0 = a[j];
+
+    for (i = i0; i + SIMD_W <= i1; i += SIMD_W)
+    {
+      SIMD_T x0 = SIMD_LOAD(c0 + i);
+      for (k = k0; k < k1; k++)
+      {
+        x0 = SIMD_FMA(SIMD_SET1(-c0[k]), SIMD_LOAD(a[k] + i), x0);
+      }
+      SIMD_STORE(c0 + i, x0);
+    }
+
+    for (; i < i1; i++)
+    {
+      s0 = c0[i];
+      for (k = k0; k < k1; k++) { s0 -= c0[k] * a[k][i]; }
+      c0[i] = s0;
+    }
+  }
+}
+
+#undef SIMD_FN
+#undef SIMD_R
+#undef SIMD_T
+#undef SIMD_W
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_FMA
@@ -0,0 +1,189 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Blocked LU factorization with partial pivoting and the
+ * corresponding solve. This file is included by sundials_dense.c
+ * once for sunrealtype and, when sunrealtype is not float, once for
+ * float, after defining the following macros:
+ *
+ *   DENSE_R        - type of the matrix entries
+ *   DENSE_FN(name) - name of the function for DENSE_R, where
+ *                    DENSE_FN(SelectUpdate) returns the trailing
+ *                    update kernel for the CPU
+ *   DENSE_UPDATE_T - type of the trailing update kernel
+ *   DENSE_ABS(x)   - absolute value of a DENSE_R
+ *   DENSE_ONE      - the constant one as a DENSE_R
+ *
+ * The right-hand side of the solve is always in sunrealtype.
+ * -----------------------------------------------------------------*/
+
+static sunindextype DENSE_FN(GETRF)(DENSE_R** a, sunindextype m,
+                                    sunindextype n, sunindextype* p,
+                                    int num_threads)
+{
+  sunindextype i, j, k, l, kb, kend, nblocks;
+  DENSE_R *col_j, *col_k;
+  DENSE_R temp, mult, a_kj;
+  DENSE_UPDATE_T update;
+
+  if (num_threads < 1) { num_threads = 1; }
+  update = DENSE_FN(SelectUpdate)();
+
+  /* The columns are factored in panels of DENSE_NB columns. Each panel is
+   * factored as in the unblocked algorithm, except that the elimination
+   * only updates the columns of the panel, and the columns to the right
+   * are then updated at once with the multipliers of the whole panel. */
+  for (kb = 0; kb < n; kb += DENSE_NB)
+  {
+    kend = SUNMIN(kb + DENSE_NB, n);
+
+    /* k-th elimination step number */
+    for (k = kb; k < kend; k++)
+    {
+      col_k = a[k];
+
+      /* find l = pivot row number */
+      l = k;
+      for (i = k + 1; i < m; i++)
+      {
+        if (DENSE_ABS(col_k[i]) > DENSE_ABS(col_k[l])) { l = i; }
+      }
+      p[k] = l;
+
+      /* check for zero pivot element */
+      if (col_k[l] == ZERO) { return (k + 1); }
+
+      /* swap a(k,1:n) and a(l,1:n) if necessary */
+      if (l != k)
+      {
+        for (i = 0; i < n; i++)
+        {
+          temp    = a[i][l];
+          a[i][l] = a[i][k];
+          a[i][k] = temp;
+        }
+      }
+
+      /* Scale the elements below the diagonal in
+       * column k by 1.0/a(k,k). After the above swap
+       * a(k,k) holds the pivot element. This scaling
+       * stores the pivot row multipliers a(i,k)/a(k,k)
+       * in a(i,k), i=k+1, ..., m-1.
+       */
+      mult = DENSE_ONE / col_k[k];
+      for (i = k + 1; i < m; i++) { col_k[i] *= mult; }
+
+      /* row_i = row_i - [a(i,k)/a(k,k)] row_k, i=k+1, ..., m-1 */
+      /* row k is the pivot row after swapping with row l.      */
+      /* The computation is done one column at a time,          */
+      /* column j=k+1, ..., kend-1 of the panel.                */
+
+      for (j = k + 1; j < kend; j++)
+      {
+        col_j = a[j];
+        a_kj  = col_j[k];
+
+        /* a(i,j) = a(i,j) - [a(i,k)/a(k,k)]*a(k,j)  */
+        /* a_kj = a(k,j), col_k[i] = - a(i,k)/a(k,k) */
+
+        if (a_kj != ZERO)
+        {
+          for (i = k + 1; i < m; i++) { col_j[i] -= a_kj * col_k[i]; }
+        }
+      }
+    }
+
+    if (kend == n) { break; }
+
+    /* Update the columns to the right of the panel in blocks of DENSE_NJ
+     * columns, which are independent of each other. Rows kb..kend-1 are
+     * updated with the unit lower triangle of the panel and the rows
+     * below with the matrix product, in blocks of DENSE_NI rows so the
+     * multipliers stay in cache. */
+    nblocks = (n - kend + DENSE_NJ - 1) / DENSE_NJ;
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) schedule(static) \
+  num_threads(num_threads) if (num_threads > 1 && nblocks > 1)
+#endif
+    for (sunindextype b = 0; b < nblocks; b++)
+    {
+      sunindextype i0, i1, jj, kk, ii;
+      sunindextype j0 = kend + b * DENSE_NJ;
+      sunindextype j1 = SUNMIN(j0 + DENSE_NJ, n);
+
+      for (jj = j0; jj < j1; jj++)
+      {
+        DENSE_R* cj = a[jj];
+        for (kk = kb; kk < kend - 1; kk++)
+        {
+          DENSE_R u = cj[kk];
+          if (u != ZERO)
+          {
+            for (ii = kk + 1; ii < kend; ii++) { cj[ii] -= u * a[kk][ii]; }
+          }
+        }
+      }
+
+      for (i0 = kend; i0 < m; i0 += DENSE_NI)
+      {
+        i1 = SUNMIN(i0 + DENSE_NI, m);
+        update(a, i0, i1, kb, kend, j0, j1);
+      }
+    }
+  }
+
+  /* return 0 to indicate success */
+
+  return (0);
+}
+
+static void DENSE_FN(GETRS)(DENSE_R** a, sunindextype n, sunindextype* p,
+                            sunrealtype* b)
+{
+  sunindextype i, k, pk;
+  DENSE_R* col_k;
+  sunrealtype tmp;
+
+  /* Permute b, based on pivot information in p */
+  for (k = 0; k < n; k++)
+  {
+    pk = p[k];
+    if (pk != k)
+    {
+      tmp   = b[k];
+      b[k]  = b[pk];
+      b[pk] = tmp;
+    }
+  }
+
+  /* Solve Ly = b, store solution y in b */
+  for (k = 0; k < n - 1; k++)
+  {
+    col_k = a[k];
+    for (i = k + 1; i < n; i++) { b[i] -= col_k[i] * b[k]; }
+  }
+
+  /* Solve Ux = y, store solution x in b */
+  for (k = n - 1; k > 0; k--)
+  {
+    col_k = a[k];
+    b[k] /= col_k[k];
+    for (i = 0; i < k; i++) { b[i] -= col_k[i] * b[k]; }
+  }
+  b[0] /= a[0][0];
+}
+
+#undef DENSE_R
+#undef DENSE_FN
+#undef DENSE_UPDATE_T
+#undef DENSE_ABS
+#undef DENSE_ONE
@@ -67,6 +67,7 @@ SUNNonlinearSolver SUNNonlinSolNewEmpty(SUNContext sunctx)
   ops->getnumiters     = NULL;
   ops->getcuriter      = NULL;
   ops->getnumconvfails = NULL;
+  ops->getforcingterm  = NULL;
 
   /* attach context and ops, initialize content to NULL */
   NLS->sunctx  = sunctx;
@@ -244,3 +245,14 @@ SUNErrCode SUNNonlinSolGetNumConvFails(SUNNonlinearSolver NLS,
     return (SUN_SUCCESS);
   }
 }
+
+/* get the relative tolerance for the current linear solve (optional) */
+SUNErrCode SUNNonlinSolGetForcingTerm(SUNNonlinearSolver NLS, sunrealtype* eta)
+{
+  if (NLS->ops->getforcingterm) { return (NLS->ops->getforcingterm(NLS, eta)); }
+  else
+  {
+    *eta = SUN_RCONST(0.0);
+    return (SUN_SUCCESS);
+  }
+}
@@ -37,12 +37,21 @@
 #error SUNProfiler needs POSIX or Windows timers
 #endif
 
+#if defined(SUNDIALS_PROFILER_PTHREADS)
+#include <pthread.h>
+#elif defined(WIN32) || defined(_WIN32)
+#include <windows.h>
+#endif
+
 #include "sundials_debug.h"
 #include "sundials_hashmap_impl.h"
 #include "sundials_macros.h"
 
 #define SUNDIALS_ROOT_TIMER ((const char*)"From profiler epoch")
 
+/* Number of begin/end pairs timed to estimate the profiler overhead */
+#define SUNDIALS_OVERHEAD_SAMPLES 1000
+
 #if defined(SUNDIALS_HAVE_POSIX_TIMERS)
 typedef struct timespec sunTimespec;
 #else
@@ -53,143 +62,539 @@ typedef struct _sunTimespec
 } sunTimespec;
 #endif
 
-/* Private functions */
-#if SUNDIALS_MPI_ENABLED
-static SUNErrCode sunCollectTimers(SUNProfiler p);
+/*
+  Locks and thread identifiers.
+
+  Without a thread library all timers are kept on a single stack.
+ */
+
+#if defined(SUNDIALS_PROFILER_PTHREADS)
+typedef pthread_mutex_t sunProfilerLock;
+typedef pthread_t sunThreadId;
+#define SUN_PROFILER_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define sunLockInit(l)                pthread_mutex_init((l), NULL)
+#define sunLockDestroy(l)             pthread_mutex_destroy(l)
+#define sunLock(l)                    pthread_mutex_lock(l)
+#define sunUnlock(l)                  pthread_mutex_unlock(l)
+#define sunThreadSelf()               pthread_self()
+#define sunThreadEqual(a, b)          pthread_equal((a), (b))
+#elif defined(WIN32) || defined(_WIN32)
+typedef SRWLOCK sunProfilerLock;
+typedef DWORD sunThreadId;
+#define SUN_PROFILER_LOCK_INITIALIZER SRWLOCK_INIT
+#define sunLockInit(l)                InitializeSRWLock(l)
+#define sunLockDestroy(l)             ((void)(l))
+#define sunLock(l)                    AcquireSRWLockExclusive(l)
+#define sunUnlock(l)                  ReleaseSRWLockExclusive(l)
+#define sunThreadSelf()               GetCurrentThreadId()
+#define sunThreadEqual(a, b)          ((a) == (b))
+#else
+typedef int sunProfilerLock;
+typedef int sunThreadId;
+#define SUN_PROFILER_LOCK_INITIALIZER 0
+#define sunLockInit(l)                (*(l) = 0)
+#define sunLockDestroy(l)             ((void)(l))
+#define sunLock(l)                    ((void)(l))
+#define sunUnlock(l)                  ((void)(l))
+#define sunThreadSelf()               0
+#define sunThreadEqual(a, b)          1
 #endif
-static void sunPrintTimer(SUNHashMapKeyValue kv, FILE* fp, void* pvoid);
-static int sunCompareTimes(const void* l, const void* r);
-static int sunclock_gettime_monotonic(sunTimespec* tp);
+
+/*
+  sunTimerNode.
+  A region in the call tree of a thread. The children of a node are the
+  regions entered while it was the innermost open region.
+ */
+
+typedef struct _sunTimerNode sunTimerNode;
+
+struct _sunTimerNode
+{
+  int timer;            /* timer handle, -1 for the root of the tree */
+  long count;           /* number of times the region was entered    */
+  double elapsed;       /* inclusive time spent in the region        */
+  sunTimespec tic;      /* start of the current visit                */
+  sunTimerNode* parent; /* enclosing region                          */
+  sunTimerNode* child;  /* first region entered from this one        */
+  sunTimerNode* next;   /* next region entered from the parent       */
+};
 
 /*
   sunTimerStruct.
-  A private structure holding timing information.
+  The totals of one timer on one thread, irrespective of the call path.
  */
 
 struct _sunTimerStruct
 {
-  sunTimespec* tic;
-  sunTimespec* toc;
-  double average;
-  double maximum;
-  double elapsed;
-  long count;
+  long count;      /* number of times the timer was started      */
+  int depth;       /* number of open regions of the timer        */
+  double elapsed;  /* time with at least one region open         */
+  sunTimespec tic; /* start of the outermost open region         */
 };
 
 typedef struct _sunTimerStruct sunTimerStruct;
 
-static sunTimerStruct* sunTimerStructNew(void)
-{
-  sunTimerStruct* ts = (sunTimerStruct*)malloc(sizeof(sunTimerStruct));
-  ts->tic            = (sunTimespec*)malloc(sizeof(sunTimespec));
-  ts->toc            = (sunTimespec*)malloc(sizeof(sunTimespec));
-  ts->tic->tv_sec    = 0;
-  ts->tic->tv_nsec   = 0;
-  ts->elapsed        = 0.0;
-  ts->average        = 0.0;
-  ts->maximum        = 0.0;
-  ts->count          = 0;
-  return ts;
+/*
+  sunThreadState.
+  The timer stack and call tree of one thread.
+ */
+
+typedef struct _sunThreadState sunThreadState;
+
+struct _sunThreadState
+{
+  sunThreadId id;         /* thread that owns the state               */
+  int index;              /* order in which the threads first timed   */
+  sunTimerNode root;      /* root of the call tree                    */
+  sunTimerNode* current;  /* innermost open region (top of the stack) */
+  sunTimerStruct* timers; /* totals indexed by timer handle           */
+  int ntimers;            /* length of timers                         */
+  long nbegin;            /* number of regions entered                */
+  sunThreadState* next;   /* next thread of the profiler              */
+};
+
+/*
+  SUNProfiler.
+
+  The timers of each thread are kept in a separate state so that the begin
+  and end calls of different threads do not interfere.
+ */
+
+struct SUNProfiler_
+{
+  SUNComm comm;
+  char* title;
+  unsigned long serial;    /* identifies the profiler in the thread caches */
+  sunProfilerLock lock;    /* protects the list of thread states           */
+  sunThreadState* threads; /* timing state of each thread                  */
+  int nthreads;
+  sunTimespec epoch;       /* start of the timing                          */
+  double pair_overhead;    /* estimated cost of a begin/end pair           */
+  double sundials_time;
+};
+
+/*
+  The timer registry.
+
+  Timer handles index the registered names. The registry is shared by all
+  profilers and kept for the lifetime of the process since the handles may
+  be cached, e.g., by SUNDIALS_MARK_FUNCTION_BEGIN.
+ */
+
+static struct
+{
+  SUNHashMap map; /* name to handle */
+  char** names;   /* handle to name */
+  int size;
+  int capacity;
+  unsigned long nprofilers; /* profilers created so far */
+} sunTimerRegistry = {NULL, NULL, 0, 0, 0};
+
+static sunProfilerLock sunTimerRegistryLock = SUN_PROFILER_LOCK_INITIALIZER;
+
+/* The state of the calling thread for the profiler last used on it */
+#if defined(SUNDIALS_THREAD_LOCAL)
+static SUNDIALS_THREAD_LOCAL unsigned long sunCachedSerial = 0;
+static SUNDIALS_THREAD_LOCAL sunThreadState* sunCachedState = NULL;
+#endif
+
+/*
+  The timer names looked up by the calling thread, indexed by the address of
+  the name. An entry refers to the registry's copy of the name, which is never
+  freed or changed, so a hit is checked and used without taking the registry
+  lock.
+ */
+
+#if defined(SUNDIALS_THREAD_LOCAL)
+#define SUNDIALS_NAME_CACHE_SIZE 64
+
+typedef struct
+{
+  const char* name; /* address passed by the caller */
+  const char* key;  /* registry copy of the name    */
+  int timer;
+} sunNameCacheEntry;
+
+static SUNDIALS_THREAD_LOCAL sunNameCacheEntry
+  sunNameCache[SUNDIALS_NAME_CACHE_SIZE];
+#endif
+
+/* A row of the printed results */
+typedef struct
+{
+  const char* name;
+  double maximum;
+  double average;
+  long count;
+} sunTimerSummary;
+
+/* Private functions */
+#if SUNDIALS_MPI_ENABLED
+static SUNErrCode sunCollectTimers(SUNProfiler p, sunTimerSummary* rows,
+                                   int nrows);
+#endif
+static void sunPrintTimer(sunTimerSummary* row, FILE* fp, SUNProfiler p);
+static SUNErrCode sunPrintCallTree(sunTimerNode* node, int depth, FILE* fp,
+                                   SUNProfiler p);
+static int sunCompareTimes(const void* l, const void* r);
+#if SUNDIALS_MPI_ENABLED
+static int sunCompareNames(const void* l, const void* r);
+#endif
+static int sunCompareNodes(const void* l, const void* r);
+static int sunclock_gettime_monotonic(sunTimespec* tp);
+
+static double sunElapsedTime(const sunTimespec* tic, const sunTimespec* toc)
+{
+  return ((double)(toc->tv_sec - tic->tv_sec)) +
+         ((double)(toc->tv_nsec - tic->tv_nsec)) * 1e-9;
 }
 
-static void sunTimerStructFree(void* TS)
+/* -----------------------------------------------------------------
+ * Timer registry
+ * ----------------------------------------------------------------- */
+
+/* Finds the handle of a timer, registering the name if insert is nonzero.
+   The registry lock must be held. */
+static SUNErrCode sunTimerRegistryFind(const char* name, int insert, int* timer)
 {
-  sunTimerStruct* ts = (sunTimerStruct*)TS;
-  if (ts)
+  int ier;
+  int* value;
+  char* key;
+
+  if (sunTimerRegistry.map == NULL)
   {
-    if (ts->tic) { free(ts->tic); }
-    if (ts->toc) { free(ts->toc); }
-    free(ts);
+    int max_entries;
+    char* max_entries_env;
+
+    if (!insert) { return SUN_ERR_PROFILER_MAPKEYNOTFOUND; }
+
+    /* Check to see if max entries env variable was set, and use if it was. */
+    max_entries     = 2560;
+    max_entries_env = getenv("SUNPROFILER_MAX_ENTRIES");
+    if (max_entries_env) { max_entries = atoi(max_entries_env); }
+    if (max_entries <= 0) { max_entries = 2560; }
+
+    if (SUNHashMap_New(max_entries, &sunTimerRegistry.map))
+    {
+      return SUN_ERR_MALLOC_FAIL;
+    }
   }
-}
 
-static void sunStartTiming(sunTimerStruct* entry)
-{
-  sunclock_gettime_monotonic(entry->tic);
+  ier = SUNHashMap_GetValue(sunTimerRegistry.map, name, (void**)&value);
+  if (ier == 0)
+  {
+    *timer = *value;
+    return SUN_SUCCESS;
+  }
+  if (ier == -1) { return SUN_ERR_PROFILER_MAPGET; }
+  if (!insert) { return SUN_ERR_PROFILER_MAPKEYNOTFOUND; }
+
+  if (sunTimerRegistry.size == sunTimerRegistry.capacity)
+  {
+    int capacity = (sunTimerRegistry.capacity == 0)
+                     ? 64
+                     : 2 * sunTimerRegistry.capacity;
+    char** names = (char**)realloc(sunTimerRegistry.names,
+                                   capacity * sizeof(char*));
+    if (names == NULL) { return SUN_ERR_MALLOC_FAIL; }
+    sunTimerRegistry.names    = names;
+    sunTimerRegistry.capacity = capacity;
+  }
+
+  /* The map keeps a pointer to the key, so the name is copied */
+  key   = (char*)malloc((strlen(name) + 1) * sizeof(char));
+  value = (int*)malloc(sizeof(int));
+  if (key == NULL || value == NULL)
+  {
+    free(key);
+    free(value);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+  strcpy(key, name);
+  *value = sunTimerRegistry.size;
+
+  ier = SUNHashMap_Insert(sunTimerRegistry.map, key, (void*)value);
+  if (ier)
+  {
+    free(key);
+    free(value);
+    if (ier == -2) { return SUN_ERR_PROFILER_MAPFULL; }
+    return SUN_ERR_PROFILER_MAPINSERT;
+  }
+
+  sunTimerRegistry.names[sunTimerRegistry.size++] = key;
+  *timer                                          = *value;
+
+  return SUN_SUCCESS;
 }
 
-static void sunStopTiming(sunTimerStruct* entry)
+/* Finds the handle of a timer, registering the name if insert is nonzero.
+   Names found before by the calling thread do not take the registry lock. */
+static SUNErrCode sunTimerLookup(const char* name, int insert, int* timer)
 {
-  long s_difference  = 0;
-  long ns_difference = 0;
+  SUNErrCode ier;
+  const char* key = NULL;
+#if defined(SUNDIALS_THREAD_LOCAL)
+  size_t addr              = (size_t)name;
+  sunNameCacheEntry* entry = &sunNameCache[(addr ^ (addr >> 6)) %
+                                           SUNDIALS_NAME_CACHE_SIZE];
+
+  /* The caller may reuse the memory of a name for another one, so a hit
+     needs the same address and the same contents */
+  if (entry->name == name && !strcmp(entry->key, name))
+  {
+    *timer = entry->timer;
+    return SUN_SUCCESS;
+  }
+#endif
 
-  sunclock_gettime_monotonic(entry->toc);
+  sunLock(&sunTimerRegistryLock);
+  ier = sunTimerRegistryFind(name, insert, timer);
+  if (ier == SUN_SUCCESS) { key = sunTimerRegistry.names[*timer]; }
+  sunUnlock(&sunTimerRegistryLock);
 
-  s_difference  = entry->toc->tv_sec - entry->tic->tv_sec;
-  ns_difference = entry->toc->tv_nsec - entry->tic->tv_nsec;
-  if (ns_difference < 0)
+#if defined(SUNDIALS_THREAD_LOCAL)
+  if (ier == SUN_SUCCESS)
   {
-    s_difference--;
-    ns_difference = 1000000000 + entry->toc->tv_nsec - entry->tic->tv_nsec;
+    entry->name  = name;
+    entry->key   = key;
+    entry->timer = *timer;
   }
+#else
+  (void)key;
+#endif
 
-  entry->elapsed += ((double)s_difference) + ((double)ns_difference) * 1e-9;
-  entry->average = entry->elapsed;
-  entry->maximum = entry->elapsed;
+  return ier;
 }
 
-static void sunResetTiming(sunTimerStruct* entry)
+static const char* sunTimerName(int timer)
 {
-  entry->tic->tv_sec  = 0;
-  entry->tic->tv_nsec = 0;
-  entry->toc->tv_sec  = 0;
-  entry->toc->tv_nsec = 0;
-  entry->elapsed      = 0.0;
-  entry->average      = 0.0;
-  entry->maximum      = 0.0;
-  entry->count        = 0;
+  const char* name;
+  sunLock(&sunTimerRegistryLock);
+  name = sunTimerRegistry.names[timer];
+  sunUnlock(&sunTimerRegistryLock);
+  return name;
 }
 
-/*
-  SUNProfiler.
+/* -----------------------------------------------------------------
+ * Thread states
+ * ----------------------------------------------------------------- */
 
-  This structure holds all of the timers in a map.s
- */
+static sunThreadState* sunThreadStateNew(sunThreadId id, int index)
+{
+  sunThreadState* ts = (sunThreadState*)malloc(sizeof(sunThreadState));
+  if (ts == NULL) { return NULL; }
+
+  ts->id           = id;
+  ts->index        = index;
+  ts->root.timer   = -1;
+  ts->root.count   = 0;
+  ts->root.elapsed = 0.0;
+  ts->root.parent  = NULL;
+  ts->root.child   = NULL;
+  ts->root.next    = NULL;
+  ts->current      = &ts->root;
+  ts->timers       = NULL;
+  ts->ntimers      = 0;
+  ts->nbegin       = 0;
+  ts->next         = NULL;
 
-struct SUNProfiler_
+  return ts;
+}
+
+static void sunTimerNodeFree(sunTimerNode* node)
 {
-  SUNComm comm;
-  char* title;
-  SUNHashMap map;
-  sunTimerStruct* overhead;
-  double sundials_time;
-};
+  while (node)
+  {
+    sunTimerNode* next = node->next;
+    sunTimerNodeFree(node->child);
+    free(node);
+    node = next;
+  }
+}
 
-SUNErrCode SUNProfiler_Create(SUNComm comm, const char* title, SUNProfiler* p)
+static void sunThreadStateFree(sunThreadState* ts)
 {
-  SUNProfiler profiler;
-  int max_entries;
-  char* max_entries_env;
+  sunTimerNodeFree(ts->root.child);
+  free(ts->timers);
+  free(ts);
+}
 
-  *p = profiler = (SUNProfiler)malloc(sizeof(struct SUNProfiler_));
+/* Makes room for the totals of the timer with the given handle */
+static SUNErrCode sunThreadStateGrow(sunThreadState* ts, int timer)
+{
+  int i;
+  int ntimers = (ts->ntimers == 0) ? 64 : 2 * ts->ntimers;
+  sunTimerStruct* timers;
+
+  if (ntimers <= timer) { ntimers = timer + 1; }
 
-  if (profiler == NULL) { return SUN_SUCCESS; }
+  timers = (sunTimerStruct*)realloc(ts->timers,
+                                    ntimers * sizeof(sunTimerStruct));
+  if (timers == NULL) { return SUN_ERR_MALLOC_FAIL; }
 
-  profiler->overhead = sunTimerStructNew();
-  if (!profiler->overhead)
+  for (i = ts->ntimers; i < ntimers; i++)
   {
-    free(profiler);
-    *p = profiler = NULL;
-    return SUN_ERR_MALLOC_FAIL;
+    timers[i].count   = 0;
+    timers[i].depth   = 0;
+    timers[i].elapsed = 0.0;
   }
 
-  sunStartTiming(profiler->overhead);
+  ts->timers  = timers;
+  ts->ntimers = ntimers;
+
+  return SUN_SUCCESS;
+}
+
+/* Returns the state of the calling thread, creating it on first use */
+static sunThreadState* sunGetThreadState(SUNProfiler p)
+{
+  sunThreadState* ts;
+  sunThreadState** link;
+  sunThreadId self;
 
-  /* Check to see if max entries env variable was set, and use if it was. */
-  max_entries     = 2560;
-  max_entries_env = getenv("SUNPROFILER_MAX_ENTRIES");
-  if (max_entries_env) { max_entries = atoi(max_entries_env); }
-  if (max_entries <= 0) { max_entries = 2560; }
+#if defined(SUNDIALS_THREAD_LOCAL)
+  if (sunCachedSerial == p->serial) { return sunCachedState; }
+#endif
 
-  /* Create the hashmap used to store the timers */
-  if (SUNHashMap_New(max_entries, &profiler->map))
+  self = sunThreadSelf();
+
+  sunLock(&p->lock);
+  for (link = &p->threads; *link; link = &(*link)->next)
+  {
+    if (sunThreadEqual((*link)->id, self)) { break; }
+  }
+  ts = *link;
+  if (ts == NULL)
+  {
+    ts = *link = sunThreadStateNew(self, p->nthreads);
+    if (ts) { p->nthreads++; }
+  }
+  sunUnlock(&p->lock);
+
+#if defined(SUNDIALS_THREAD_LOCAL)
+  if (ts)
+  {
+    sunCachedSerial = p->serial;
+    sunCachedState  = ts;
+  }
+#endif
+
+  return ts;
+}
+
+/* Enters the region of a timer from the innermost open region */
+static SUNErrCode sunBeginTimer(sunThreadState* ts, int timer)
+{
+  sunTimerNode* node;
+  sunTimerNode** link;
+  sunTimerStruct* entry;
+
+  if (timer >= ts->ntimers && sunThreadStateGrow(ts, timer))
   {
-    sunTimerStructFree((void*)profiler->overhead);
-    free(profiler);
-    *p = profiler = NULL;
     return SUN_ERR_MALLOC_FAIL;
   }
 
+  /* Find the region among those entered from the current one and move it
+     to the front of the list, so a repeated call finds it first. */
+  for (link = &ts->current->child; *link; link = &(*link)->next)
+  {
+    if ((*link)->timer == timer) { break; }
+  }
+
+  node = *link;
+  if (node) { *link = node->next; }
+  else
+  {
+    node = (sunTimerNode*)malloc(sizeof(sunTimerNode));
+    if (node == NULL) { return SUN_ERR_MALLOC_FAIL; }
+    node->timer   = timer;
+    node->count   = 0;
+    node->elapsed = 0.0;
+    node->parent  = ts->current;
+    node->child   = NULL;
+  }
+  node->next         = ts->current->child;
+  ts->current->child = node;
+  ts->current        = node;
+
+  entry = &ts->timers[timer];
+  node->count++;
+  entry->count++;
+  ts->nbegin++;
+
+  sunclock_gettime_monotonic(&node->tic);
+  if (entry->depth++ == 0) { entry->tic = node->tic; }
+
+  return SUN_SUCCESS;
+}
+
+/* Leaves the innermost open region of a timer. Regions left open inside
+   it are closed with it. */
+static SUNErrCode sunEndTimer(sunThreadState* ts, int timer)
+{
+  sunTimespec toc;
+  sunTimerNode* node;
+  sunTimerStruct* entry;
+
+  for (node = ts->current; node != &ts->root; node = node->parent)
+  {
+    if (node->timer == timer) { break; }
+  }
+  if (node == &ts->root) { return SUN_ERR_PROFILER_MAPKEYNOTFOUND; }
+
+  sunclock_gettime_monotonic(&toc);
+
+  do {
+    node = ts->current;
+    node->elapsed += sunElapsedTime(&node->tic, &toc);
+    entry = &ts->timers[node->timer];
+    if (--entry->depth == 0)
+    {
+      entry->elapsed += sunElapsedTime(&entry->tic, &toc);
+    }
+    ts->current = node->parent;
+  }
+  while (node->timer != timer);
+
+  return SUN_SUCCESS;
+}
+
+/* Estimates the cost of a begin/end pair by timing pairs on a scratch
+   thread state */
+static double sunEstimatePairOverhead(void)
+{
+  int i;
+  sunTimespec tic, toc;
+  sunThreadState* ts = sunThreadStateNew(sunThreadSelf(), 0);
+
+  if (ts == NULL) { return 0.0; }
+
+  sunclock_gettime_monotonic(&tic);
+  for (i = 0; i < SUNDIALS_OVERHEAD_SAMPLES; i++)
+  {
+    sunBeginTimer(ts, 0);
+    sunEndTimer(ts, 0);
+  }
+  sunclock_gettime_monotonic(&toc);
+
+  sunThreadStateFree(ts);
+
+  return sunElapsedTime(&tic, &toc) / SUNDIALS_OVERHEAD_SAMPLES;
+}
+
+/* -----------------------------------------------------------------
+ * Exported functions
+ * ----------------------------------------------------------------- */
+
+SUNErrCode SUNProfiler_Create(SUNComm comm, const char* title, SUNProfiler* p)
+{
+  SUNProfiler profiler;
+
+  *p = profiler = (SUNProfiler)malloc(sizeof(struct SUNProfiler_));
+
+  if (profiler == NULL) { return SUN_ERR_MALLOC_FAIL; }
+
   /* Attach the comm, duplicating it if MPI is used. */
 #if SUNDIALS_MPI_ENABLED
   profiler->comm = SUN_COMM_NULL;
@@ -198,6 +603,7 @@ SUNErrCode SUNProfiler_Create(SUNComm comm, const char* title, SUNProfiler* p)
   if (comm != SUN_COMM_NULL)
   {
     free(profiler);
+    *p = NULL;
     return -1;
   }
   profiler->comm = SUN_COMM_NULL;
@@ -208,86 +614,108 @@ SUNErrCode SUNProfiler_Create(SUNComm comm, const char* title, SUNProfiler* p)
   profiler->title = malloc((strlen(title) + 1) * sizeof(char));
   strcpy(profiler->title, title);
 
+  /* Serial numbers are never reused, so a thread cache can not refer to a
+     freed profiler. */
+  sunLock(&sunTimerRegistryLock);
+  profiler->serial = ++sunTimerRegistry.nprofilers;
+  sunUnlock(&sunTimerRegistryLock);
+
+  sunLockInit(&profiler->lock);
+  profiler->threads  = NULL;
+  profiler->nthreads = 0;
+
+  profiler->pair_overhead = sunEstimatePairOverhead();
+
   /* Initialize the overall timer to 0. */
   profiler->sundials_time = 0.0;
-
-  SUNDIALS_MARK_BEGIN(profiler, SUNDIALS_ROOT_TIMER);
-  sunStopTiming(profiler->overhead);
+  sunclock_gettime_monotonic(&profiler->epoch);
 
   return SUN_SUCCESS;
 }
 
 SUNErrCode SUNProfiler_Free(SUNProfiler* p)
 {
-  if (!p || !(*p)) { return SUN_SUCCESS; }
+  sunThreadState* ts;
 
-  SUNDIALS_MARK_END(*p, SUNDIALS_ROOT_TIMER);
+  if (!p || !(*p)) { return SUN_SUCCESS; }
 
-  if (*p)
+  ts = (*p)->threads;
+  while (ts)
   {
-    SUNHashMap_Destroy(&(*p)->map, sunTimerStructFree);
-    sunTimerStructFree((void*)(*p)->overhead);
+    sunThreadState* next = ts->next;
+    sunThreadStateFree(ts);
+    ts = next;
+  }
+  sunLockDestroy(&(*p)->lock);
+
 #if SUNDIALS_MPI_ENABLED
-    if ((*p)->comm != SUN_COMM_NULL) { MPI_Comm_free(&(*p)->comm); }
+  if ((*p)->comm != SUN_COMM_NULL) { MPI_Comm_free(&(*p)->comm); }
 #endif
-    free((*p)->title);
-    free(*p);
-  }
+  free((*p)->title);
+  free(*p);
   *p = NULL;
 
   return SUN_SUCCESS;
 }
 
-SUNErrCode SUNProfiler_Begin(SUNProfiler p, const char* name)
+SUNErrCode SUNProfiler_RegisterTimer(SUNDIALS_MAYBE_UNUSED SUNProfiler p,
+                                     const char* name, int* timer)
 {
-  SUNErrCode ier;
-  sunTimerStruct* timer = NULL;
+  if (!name || !timer) { return SUN_ERR_ARG_CORRUPT; }
+
+  return sunTimerLookup(name, 1, timer);
+}
+
+SUNErrCode SUNProfiler_BeginTimer(SUNProfiler p, int timer)
+{
+  sunThreadState* ts;
 
   if (!p) { return SUN_ERR_ARG_CORRUPT; }
+  if (timer < 0) { return SUN_ERR_ARG_OUTOFRANGE; }
 
-  sunStartTiming(p->overhead);
+  ts = sunGetThreadState(p);
+  if (ts == NULL) { return SUN_ERR_MALLOC_FAIL; }
 
-  if (SUNHashMap_GetValue(p->map, name, (void**)&timer))
-  {
-    timer = sunTimerStructNew();
-    ier   = SUNHashMap_Insert(p->map, name, (void*)timer);
-    if (ier)
-    {
-      sunTimerStructFree(timer);
-      sunStopTiming(p->overhead);
-      if (ier == -1) { return SUN_ERR_PROFILER_MAPINSERT; }
-      if (ier == -2) { return SUN_ERR_PROFILER_MAPFULL; }
-    }
-  }
+  return sunBeginTimer(ts, timer);
+}
+
+SUNErrCode SUNProfiler_EndTimer(SUNProfiler p, int timer)
+{
+  sunThreadState* ts;
 
-  timer->count++;
-  sunStartTiming(timer);
+  if (!p) { return SUN_ERR_ARG_CORRUPT; }
+  if (timer < 0) { return SUN_ERR_ARG_OUTOFRANGE; }
 
-  sunStopTiming(p->overhead);
-  return SUN_SUCCESS;
+  ts = sunGetThreadState(p);
+  if (ts == NULL) { return SUN_ERR_MALLOC_FAIL; }
+
+  return sunEndTimer(ts, timer);
 }
 
-SUNErrCode SUNProfiler_End(SUNProfiler p, const char* name)
+SUNErrCode SUNProfiler_Begin(SUNProfiler p, const char* name)
 {
   SUNErrCode ier;
-  sunTimerStruct* timer;
+  int timer;
 
   if (!p) { return SUN_ERR_ARG_CORRUPT; }
 
-  sunStartTiming(p->overhead);
+  ier = SUNProfiler_RegisterTimer(p, name, &timer);
+  if (ier) { return ier; }
 
-  ier = SUNHashMap_GetValue(p->map, name, (void**)&timer);
-  if (ier)
-  {
-    sunStopTiming(p->overhead);
-    if (ier == -1) { return SUN_ERR_PROFILER_MAPGET; }
-    if (ier == -2) { return SUN_ERR_PROFILER_MAPKEYNOTFOUND; }
-  }
+  return SUNProfiler_BeginTimer(p, timer);
+}
 
-  sunStopTiming(timer);
+SUNErrCode SUNProfiler_End(SUNProfiler p, const char* name)
+{
+  SUNErrCode ier;
+  int timer;
 
-  sunStopTiming(p->overhead);
-  return SUN_SUCCESS;
+  if (!p || !name) { return SUN_ERR_ARG_CORRUPT; }
+
+  ier = sunTimerLookup(name, 0, &timer);
+  if (ier) { return ier; }
+
+  return SUNProfiler_EndTimer(p, timer);
 }
 
 SUNErrCode SUNProfiler_GetTimerResolution(SUNProfiler p, double* resolution)
@@ -320,72 +748,148 @@ SUNErrCode SUNProfiler_GetTimerResolution(SUNProfiler p, double* resolution)
 SUNErrCode SUNProfiler_GetElapsedTime(SUNProfiler p, const char* name,
                                       double* time)
 {
-  sunTimerStruct* timer;
+  int timer;
+  sunTimespec toc;
+  sunThreadState* ts;
 
   if (!p) { return SUN_ERR_ARG_CORRUPT; }
 
-  if (SUNHashMap_GetValue(p->map, name, (void**)&timer)) { return (-1); }
+  if (!strcmp(name, SUNDIALS_ROOT_TIMER))
+  {
+    sunclock_gettime_monotonic(&toc);
+    *time = sunElapsedTime(&p->epoch, &toc);
+    return SUN_SUCCESS;
+  }
 
-  *time = timer->elapsed;
+  if (sunTimerLookup(name, 0, &timer)) { return (-1); }
+
+  /* The time of a timer used on several threads is the largest one */
+  *time = 0.0;
+  sunLock(&p->lock);
+  for (ts = p->threads; ts; ts = ts->next)
+  {
+    if (timer >= ts->ntimers) { continue; }
+    *time = SUNMAX(*time, ts->timers[timer].elapsed);
+  }
+  sunUnlock(&p->lock);
 
   return SUN_SUCCESS;
 }
 
+static void sunResetTimerNode(sunTimerNode* node)
+{
+  for (; node; node = node->next)
+  {
+    node->count   = 0;
+    node->elapsed = 0.0;
+    sunResetTimerNode(node->child);
+  }
+}
+
 SUNErrCode SUNProfiler_Reset(SUNProfiler p)
 {
-  int i                 = 0;
-  sunTimerStruct* timer = NULL;
+  int i;
+  sunTimespec now;
+  sunTimerNode* node;
+  sunThreadState* ts;
 
   if (!p) { return SUN_ERR_ARG_CORRUPT; }
 
-  /* Reset the overhead timer */
-  sunResetTiming(p->overhead);
-  sunStartTiming(p->overhead);
+  sunclock_gettime_monotonic(&now);
 
-  /* Reset all timers */
-  for (i = 0; i < p->map->max_size; i++)
+  /* Reset all timers, open regions are timed from now on */
+  sunLock(&p->lock);
+  for (ts = p->threads; ts; ts = ts->next)
   {
-    if (!(p->map->buckets[i])) { continue; }
-    timer = p->map->buckets[i]->value;
-    if (timer) { sunResetTiming(timer); }
+    sunResetTimerNode(ts->root.child);
+    for (node = ts->current; node != &ts->root; node = node->parent)
+    {
+      node->tic = now;
+    }
+    for (i = 0; i < ts->ntimers; i++)
+    {
+      ts->timers[i].count   = 0;
+      ts->timers[i].elapsed = 0.0;
+      ts->timers[i].tic     = now;
+    }
+    ts->nbegin = 0;
   }
+  sunUnlock(&p->lock);
 
   /* Reset the overall timer. */
   p->sundials_time = 0.0;
-
-  SUNDIALS_MARK_BEGIN(p, SUNDIALS_ROOT_TIMER);
-  sunStopTiming(p->overhead);
+  p->epoch         = now;
 
   return SUN_SUCCESS;
 }
 
 SUNErrCode SUNProfiler_Print(SUNProfiler p, FILE* fp)
 {
-  SUNErrCode ier             = 0;
-  int i                      = 0;
-  int rank                   = 0;
-  sunTimerStruct* timer      = NULL;
-  SUNHashMapKeyValue* sorted = NULL;
+  SUNErrCode ier        = 0;
+  int i                 = 0;
+  int nrows             = 0;
+  int ntimers           = 0;
+  int rank              = 0;
+  long nbegin           = 0;
+  double overhead       = 0.0;
+  sunTimespec toc;
+  sunThreadState* ts    = NULL;
+  sunTimerSummary* rows = NULL;
 
   if (!p) { return SUN_ERR_ARG_CORRUPT; }
 
-  sunStartTiming(p->overhead);
-
   /* Get the total SUNDIALS time up to this point */
-  SUNDIALS_MARK_END(p, SUNDIALS_ROOT_TIMER);
-  SUNDIALS_MARK_BEGIN(p, SUNDIALS_ROOT_TIMER);
+  sunclock_gettime_monotonic(&toc);
+  p->sundials_time = sunElapsedTime(&p->epoch, &toc);
 
-  ier = SUNHashMap_GetValue(p->map, SUNDIALS_ROOT_TIMER, (void**)&timer);
-  if (ier == -1) { return SUN_ERR_PROFILER_MAPGET; }
-  if (ier == -2) { return SUN_ERR_PROFILER_MAPKEYNOTFOUND; }
-  p->sundials_time = timer->elapsed;
+  sunLock(&sunTimerRegistryLock);
+  ntimers = sunTimerRegistry.size;
+  sunUnlock(&sunTimerRegistryLock);
+
+  rows = (sunTimerSummary*)malloc((ntimers + 1) * sizeof(sunTimerSummary));
+  if (rows == NULL) { return SUN_ERR_MALLOC_FAIL; }
+
+  rows[nrows].name    = SUNDIALS_ROOT_TIMER;
+  rows[nrows].maximum = p->sundials_time;
+  rows[nrows].average = p->sundials_time;
+  rows[nrows].count   = 1;
+  nrows++;
+
+  /* Combine the threads, the time of a timer is the largest one */
+  sunLock(&p->lock);
+  for (i = 0; i < ntimers; i++)
+  {
+    double elapsed = 0.0;
+    long count     = 0;
+    for (ts = p->threads; ts; ts = ts->next)
+    {
+      if (i >= ts->ntimers) { continue; }
+      elapsed = SUNMAX(elapsed, ts->timers[i].elapsed);
+      count += ts->timers[i].count;
+    }
+    if (count == 0) { continue; }
+    rows[nrows].name    = sunTimerName(i);
+    rows[nrows].maximum = elapsed;
+    rows[nrows].average = elapsed;
+    rows[nrows].count   = count;
+    nrows++;
+  }
+  for (ts = p->threads; ts; ts = ts->next) { nbegin += ts->nbegin; }
+  sunUnlock(&p->lock);
+
+  overhead = ((double)nbegin) * p->pair_overhead;
 
 #if SUNDIALS_MPI_ENABLED
   if (p->comm != SUN_COMM_NULL)
   {
     MPI_Comm_rank(p->comm, &rank);
     /* Find the max and average time across all ranks */
-    sunCollectTimers(p);
+    ier = sunCollectTimers(p, rows, nrows);
+    if (ier)
+    {
+      free(rows);
+      return ier;
+    }
   }
 #endif
 
@@ -393,10 +897,7 @@ SUNErrCode SUNProfiler_Print(SUNProfiler p, FILE* fp)
   {
     double resolution;
     /* Sort the timers in descending order */
-    if (SUNHashMap_Sort(p->map, &sorted, sunCompareTimes))
-    {
-      return SUN_ERR_PROFILER_MAPSORT;
-    }
+    qsort(rows, nrows, sizeof(sunTimerSummary), sunCompareTimes);
     SUNProfiler_GetTimerResolution(p, &resolution);
     fprintf(fp, "\n============================================================"
                 "====================================================\n");
@@ -417,104 +918,78 @@ SUNErrCode SUNProfiler_Print(SUNProfiler p, FILE* fp)
 #endif
 
     /* Print all the other timers out */
-    for (i = 0; i < p->map->size; i++)
-    {
-      if (sorted[i]) { sunPrintTimer(sorted[i], fp, (void*)p); }
-    }
-    free(sorted);
-  }
-
-  sunStopTiming(p->overhead);
+    for (i = 0; i < nrows; i++) { sunPrintTimer(&rows[i], fp, p); }
 
-  if (rank == 0)
-  {
-    /* Print out the total time and the profiler overhead */
+    /* Print out the profiler overhead */
     fprintf(fp, "%-40s\t %6.2f%% \t         %.6fs \t -- \t\t -- \n",
-            "Est. profiler overhead", p->overhead->elapsed / p->sundials_time,
-            p->overhead->elapsed);
+            "Est. profiler overhead", overhead / p->sundials_time * 100,
+            overhead);
+
+    /* Print the call tree of each thread on this rank */
+    for (ts = p->threads; ts; ts = ts->next)
+    {
+      if (ts->root.child == NULL) { continue; }
+      fprintf(fp, "\n");
+      if (p->nthreads > 1)
+      {
+        char heading[40];
+        snprintf(heading, sizeof(heading), "CALL TREE (thread %d):", ts->index);
+        fprintf(fp, "%-40s\t %% time (inclusive) \t time \t\t count \n",
+                heading);
+      }
+      else
+      {
+        fprintf(fp, "%-40s\t %% time (inclusive) \t time \t\t count \n",
+                "CALL TREE:");
+      }
+      fprintf(fp, "============================================================"
+                  "====================================================\n");
+      ier = sunPrintCallTree(ts->root.child, 0, fp, p);
+      if (ier) { break; }
+    }
 
     /* End of output */
     fprintf(fp, "\n");
   }
 
-  return SUN_SUCCESS;
-}
+  free(rows);
 
-#if SUNDIALS_MPI_ENABLED
-static void sunTimerStructReduceMaxAndSum(void* a, void* b, int* len,
-                                          SUNDIALS_MAYBE_UNUSED MPI_Datatype* dType)
-{
-  sunTimerStruct* a_ts = (sunTimerStruct*)a;
-  sunTimerStruct* b_ts = (sunTimerStruct*)b;
-  int i;
-  for (i = 0; i < *len; ++i)
-  {
-    b_ts[i].average += a_ts[i].elapsed;
-    b_ts[i].maximum = SUNMAX(a_ts[i].maximum, b_ts[i].maximum);
-  }
+  return ier;
 }
 
-/* Find the max and average time across all ranks */
-SUNErrCode sunCollectTimers(SUNProfiler p)
+#if SUNDIALS_MPI_ENABLED
+/* Find the max and average time across all ranks. The timers are matched by
+   name, so every rank must have used the same timers. */
+static SUNErrCode sunCollectTimers(SUNProfiler p, sunTimerSummary* rows,
+                                   int nrows)
 {
-  int i, rank, nranks;
+  int i, nranks;
+  double* elapsed;
+  double* reduced;
 
   MPI_Comm comm = p->comm;
-  MPI_Comm_rank(comm, &rank);
   MPI_Comm_size(comm, &nranks);
 
-  sunTimerStruct** values = NULL;
-
-  /* Extract the elapsed times from the hash map */
-  SUNHashMap_Values(p->map, (void***)&values, sizeof(sunTimerStruct));
-  sunTimerStruct* reduced =
-    (sunTimerStruct*)malloc(p->map->size * sizeof(sunTimerStruct));
-  for (i = 0; i < p->map->size; ++i) { reduced[i] = *values[i]; }
-
-  /* Register MPI datatype for sunTimerStruct */
-  MPI_Datatype tmp_type, MPI_sunTimerStruct;
-  const int block_lens[2]     = {5, 1};
-  const MPI_Datatype types[2] = {MPI_DOUBLE, MPI_LONG};
-  const MPI_Aint displ[2]     = {offsetof(sunTimerStruct, tic),
-                                 offsetof(sunTimerStruct, count)};
-  MPI_Aint lb, extent;
+  /* Handles depend on the order of registration, names do not */
+  qsort(rows, nrows, sizeof(sunTimerSummary), sunCompareNames);
 
-  MPI_Type_create_struct(2, block_lens, displ, types, &tmp_type);
-  MPI_Type_get_extent(tmp_type, &lb, &extent);
-  extent = sizeof(sunTimerStruct);
-  MPI_Type_create_resized(tmp_type, lb, extent, &MPI_sunTimerStruct);
-  MPI_Type_commit(&MPI_sunTimerStruct);
+  elapsed = (double*)malloc(2 * nrows * sizeof(double));
+  if (elapsed == NULL) { return SUN_ERR_MALLOC_FAIL; }
+  reduced = elapsed + nrows;
 
-  /* Register max and sum MPI reduction operations for our datatype */
-  MPI_Op MPI_sunTimerStruct_MAXANDSUM;
-  MPI_Op_create(sunTimerStructReduceMaxAndSum, 1, &MPI_sunTimerStruct_MAXANDSUM);
+  for (i = 0; i < nrows; i++) { elapsed[i] = rows[i].maximum; }
 
   /* Compute max and average time across all ranks */
-  if (rank == 0)
-  {
-    MPI_Reduce(MPI_IN_PLACE, reduced, p->map->size, MPI_sunTimerStruct,
-               MPI_sunTimerStruct_MAXANDSUM, 0, comm);
-  }
-  else
-  {
-    MPI_Reduce(reduced, reduced, p->map->size, MPI_sunTimerStruct,
-               MPI_sunTimerStruct_MAXANDSUM, 0, comm);
-  }
-
-  /* Cleanup custom MPI datatype and operations */
-  MPI_Type_free(&tmp_type);
-  MPI_Type_free(&MPI_sunTimerStruct);
-  MPI_Op_free(&MPI_sunTimerStruct_MAXANDSUM);
+  MPI_Reduce(elapsed, reduced, nrows, MPI_DOUBLE, MPI_MAX, 0, comm);
+  for (i = 0; i < nrows; i++) { rows[i].maximum = reduced[i]; }
 
-  /* Update the values that are in this rank's hash map. */
-  for (i = 0; i < p->map->size; ++i)
+  MPI_Reduce(elapsed, reduced, nrows, MPI_DOUBLE, MPI_SUM, 0, comm);
+  for (i = 0; i < nrows; i++)
   {
-    values[i]->average = reduced[i].average / (double)nranks;
-    values[i]->maximum = reduced[i].maximum;
+    rows[i].average = reduced[i] / (double)nranks;
   }
 
-  free(reduced);
-  free(values);
+  free(elapsed);
 
   return SUN_SUCCESS;
 }
@@ -522,35 +997,64 @@ SUNErrCode sunCollectTimers(SUNProfiler p)
 
 /* Print out the: timer name, percentage of exec time (based on the max),
    max across ranks, average across ranks, and the timer counter. */
-void sunPrintTimer(SUNHashMapKeyValue kv, FILE* fp, void* pvoid)
-{
-  SUNProfiler p      = (SUNProfiler)pvoid;
-  sunTimerStruct* ts = (sunTimerStruct*)kv->value;
-  double maximum     = ts->maximum;
-  double average     = ts->average;
-  double percent = strcmp((const char*)kv->key, (const char*)SUNDIALS_ROOT_TIMER)
-                     ? maximum / p->sundials_time * 100
+static void sunPrintTimer(sunTimerSummary* row, FILE* fp, SUNProfiler p)
+{
+  double percent = strcmp(row->name, SUNDIALS_ROOT_TIMER)
+                     ? row->maximum / p->sundials_time * 100
                      : 100;
-  fprintf(fp, "%-40s\t %6.2f%% \t         %.6fs \t %.6fs \t %ld\n", kv->key,
-          percent, maximum, average, ts->count);
+  fprintf(fp, "%-40s\t %6.2f%% \t         %.6fs \t %.6fs \t %ld\n", row->name,
+          percent, row->maximum, row->average, row->count);
 }
 
-/* Comparator for qsort that compares key-value pairs
-   based on the maximum time in the sunTimerStruct. */
-int sunCompareTimes(const void* l, const void* r)
+/* Print a list of sibling regions, longest first, followed by the regions
+   entered from each of them indented below it. */
+static SUNErrCode sunPrintCallTree(sunTimerNode* node, int depth, FILE* fp,
+                                   SUNProfiler p)
 {
-  double left_max;
-  double right_max;
+  int i, n, indent, width;
+  sunTimerNode* sibling;
+  sunTimerNode** sorted;
+  SUNErrCode ier = SUN_SUCCESS;
+
+  for (n = 0, sibling = node; sibling; sibling = sibling->next) { n++; }
+
+  sorted = (sunTimerNode**)malloc(n * sizeof(sunTimerNode*));
+  if (sorted == NULL) { return SUN_ERR_MALLOC_FAIL; }
+
+  for (i = 0, sibling = node; sibling; sibling = sibling->next)
+  {
+    sorted[i++] = sibling;
+  }
+  qsort(sorted, n, sizeof(sunTimerNode*), sunCompareNodes);
+
+  indent = 2 * depth;
+  width  = SUNMAX(40 - indent, 0);
+
+  for (i = 0; i < n && ier == SUN_SUCCESS; i++)
+  {
+    /* regions not entered since the last reset */
+    if (sorted[i]->count == 0) { continue; }
+    fprintf(fp, "%*s%-*s\t %6.2f%% \t         %.6fs \t %ld\n", indent, "",
+            width, sunTimerName(sorted[i]->timer),
+            sorted[i]->elapsed / p->sundials_time * 100, sorted[i]->elapsed,
+            sorted[i]->count);
+    if (sorted[i]->child)
+    {
+      ier = sunPrintCallTree(sorted[i]->child, depth + 1, fp, p);
+    }
+  }
 
-  const SUNHashMapKeyValue left  = *((const SUNHashMapKeyValue*)l);
-  const SUNHashMapKeyValue right = *((const SUNHashMapKeyValue*)r);
+  free(sorted);
 
-  if (left == NULL && right == NULL) { return 0; }
-  if (left == NULL) { return 1; }
-  if (right == NULL) { return -1; }
+  return ier;
+}
 
-  left_max  = ((sunTimerStruct*)left->value)->maximum;
-  right_max = ((sunTimerStruct*)right->value)->maximum;
+/* Comparator for qsort that compares timer summaries
+   based on the maximum time. */
+static int sunCompareTimes(const void* l, const void* r)
+{
+  double left_max  = ((const sunTimerSummary*)l)->maximum;
+  double right_max = ((const sunTimerSummary*)r)->maximum;
 
   if (left_max < right_max) { return 1; }
   if (left_max > right_max) { return -1; }
@@ -558,6 +1062,28 @@ int sunCompareTimes(const void* l, const void* r)
   return 0;
 }
 
+#if SUNDIALS_MPI_ENABLED
+/* Comparator for qsort that compares timer summaries by name. */
+static int sunCompareNames(const void* l, const void* r)
+{
+  return strcmp(((const sunTimerSummary*)l)->name,
+                ((const sunTimerSummary*)r)->name);
+}
+#endif
+
+/* Comparator for qsort that compares call tree nodes
+   based on the inclusive time. */
+static int sunCompareNodes(const void* l, const void* r)
+{
+  double left  = (*((sunTimerNode* const*)l))->elapsed;
+  double right = (*((sunTimerNode* const*)r))->elapsed;
+
+  if (left < right) { return 1; }
+  if (left > right) { return -1; }
+
+  return 0;
+}
+
 int sunclock_gettime_monotonic(sunTimespec* ts)
 {
 #if defined(SUNDIALS_HAVE_POSIX_TIMERS)
@@ -26,6 +26,7 @@
 #include "sundials_macros.h"
 
 #define ZERO           SUN_RCONST(0.0)
+#define HALF           SUN_RCONST(0.5)
 #define ONE            SUN_RCONST(1.0)
 #define ROW(i, j, smu) (i - j + smu)
 
@@ -38,6 +39,26 @@
 #define BAND_CONTENT(S) ((SUNLinearSolverContent_Band)(S->content))
 #define PIVOTS(S)       (BAND_CONTENT(S)->pivots)
 #define LASTFLAG(S)     (BAND_CONTENT(S)->last_flag)
+#define MIXED(S)        (BAND_CONTENT(S)->mixed)
+#define MAXREFINE(S)    (BAND_CONTENT(S)->max_refine)
+#define DFACTORED(S)    (BAND_CONTENT(S)->dfactored)
+#define SLDIM(S)        (BAND_CONTENT(S)->sldim)
+#define SDATA(S)        (BAND_CONTENT(S)->sdata)
+#define SCOLS(S)        (BAND_CONTENT(S)->scols)
+#define RES(S)          (BAND_CONTENT(S)->res)
+#define RTOL(S)         (BAND_CONTENT(S)->rtol)
+#define LASTREFINE(S)   (BAND_CONTENT(S)->last_refine)
+#define NUMREFINE(S)    (BAND_CONTENT(S)->num_refine)
+#define NUMFALLBACK(S)  (BAND_CONTENT(S)->num_fallback)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static sunbooleantype bandRefine(SUNLinearSolver S, SUNMatrix A,
+                                 sunrealtype* x, sunrealtype* b);
 
 /*
  * -----------------------------------------------------------------
@@ -81,6 +102,7 @@ SUNLinearSolver SUNLinSol_Band(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   S->ops->initialize = SUNLinSolInitialize_Band;
   S->ops->setup      = SUNLinSolSetup_Band;
   S->ops->solve      = SUNLinSolSolve_Band;
+  S->ops->numiters   = SUNLinSolNumIters_Band;
   S->ops->lastflag   = SUNLinSolLastFlag_Band;
   S->ops->space      = SUNLinSolSpace_Band;
   S->ops->free       = SUNLinSolFree_Band;
@@ -94,9 +116,20 @@ SUNLinearSolver SUNLinSol_Band(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   S->content = content;
 
   /* Fill content */
-  content->N         = MatrixRows;
-  content->last_flag = 0;
-  content->pivots    = NULL;
+  content->N            = MatrixRows;
+  content->last_flag    = 0;
+  content->pivots       = NULL;
+  content->mixed        = SUNFALSE;
+  content->max_refine   = 0;
+  content->dfactored    = SUNTRUE;
+  content->sldim        = 0;
+  content->sdata        = NULL;
+  content->scols        = NULL;
+  content->res          = NULL;
+  content->rtol         = ZERO;
+  content->last_refine  = 0;
+  content->num_refine   = 0;
+  content->num_fallback = 0;
 
   /* Allocate content */
   content->pivots = (sunindextype*)malloc(MatrixRows * sizeof(sunindextype));
@@ -105,6 +138,53 @@ SUNLinearSolver SUNLinSol_Band(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   return (S);
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to factor the matrix in single precision and refine the solutions
+ */
+
+SUNErrCode SUNLinSol_Band_SetMixedPrecision(SUNLinearSolver S,
+                                            sunbooleantype onoff,
+                                            int max_refine)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_BAND, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(max_refine >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  MIXED(S)     = onoff;
+  MAXREFINE(S) = max_refine;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to get the total numbers of refinement iterations and of
+ * factorizations in sunrealtype after a failure in single precision
+ */
+
+SUNErrCode SUNLinSol_Band_GetNumRefinements(SUNLinearSolver S,
+                                            long int* num_refine)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_BAND, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_refine, SUN_ERR_ARG_CORRUPT);
+
+  *num_refine = NUMREFINE(S);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_Band_GetNumFallbacks(SUNLinearSolver S,
+                                          long int* num_fallback)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_BAND, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_fallback, SUN_ERR_ARG_CORRUPT);
+
+  *num_fallback = NUMFALLBACK(S);
+
+  return SUN_SUCCESS;
+}
+
 /*
  * -----------------------------------------------------------------
  * implementation of linear solver operations
@@ -131,8 +211,9 @@ SUNErrCode SUNLinSolInitialize_Band(SUNLinearSolver S)
 int SUNLinSolSetup_Band(SUNLinearSolver S, SUNMatrix A)
 {
   SUNFunctionBegin(S->sunctx);
-  sunrealtype** A_cols;
+  sunrealtype **A_cols, *col_j, anorm;
   sunindextype* pivots;
+  sunindextype i, j, n, ldim, mu, ml, smu;
 
   SUNAssert(A, SUN_ERR_ARG_CORRUPT);
   SUNAssert(SUNMatGetID(A) == SUNMATRIX_BAND, SUN_ERR_ARG_WRONGTYPE);
@@ -150,6 +231,56 @@ int SUNLinSolSetup_Band(SUNLinearSolver S, SUNMatrix A)
               SUNMIN(SM_COLUMNS_B(A) - 1, SM_UBAND_B(A) + SM_LBAND_B(A)),
             SUN_ERR_ARG_INCOMPATIBLE);
 
+  /* in mixed precision, factor a single precision copy of A and keep A for
+     the residuals of the refinement */
+  if (MIXED(S))
+  {
+    n    = SM_COLUMNS_B(A);
+    ldim = SM_LDIM_B(A);
+    mu   = SM_UBAND_B(A);
+    ml   = SM_LBAND_B(A);
+    smu  = SM_SUBAND_B(A);
+
+    if (SLDIM(S) != ldim)
+    {
+      free(SDATA(S));
+      free(SCOLS(S));
+      free(RES(S));
+      SDATA(S) = (float*)malloc(n * ldim * sizeof(float));
+      SCOLS(S) = (float**)malloc(n * sizeof(float*));
+      RES(S)   = (sunrealtype*)malloc(n * sizeof(sunrealtype));
+      SUNAssert(SDATA(S) && SCOLS(S) && RES(S), SUN_ERR_MALLOC_FAIL);
+      for (j = 0; j < n; j++) { SCOLS(S)[j] = SDATA(S) + j * ldim; }
+      SLDIM(S) = ldim;
+    }
+
+    /* copy A and compute its infinity norm from the row sums */
+    for (i = 0; i < n; i++) { RES(S)[i] = ZERO; }
+    for (j = 0; j < n; j++)
+    {
+      col_j = A_cols[j];
+      for (i = 0; i < ldim; i++) { SCOLS(S)[j][i] = (float)col_j[i]; }
+      for (i = SUNMAX(0, j - mu); i <= SUNMIN(n - 1, j + ml); i++)
+      {
+        RES(S)[i] += SUNRabs(col_j[ROW(i, j, smu)]);
+      }
+    }
+    anorm = ZERO;
+    for (i = 0; i < n; i++) { anorm = SUNMAX(anorm, RES(S)[i]); }
+    RTOL(S) = SUNRsqrt((sunrealtype)n) * SUN_UNIT_ROUNDOFF * anorm;
+
+    LASTFLAG(S) = SUNDlsMat_bandSGBTRF(SCOLS(S), n, mu, ml, smu, pivots);
+    if (LASTFLAG(S) == 0)
+    {
+      DFACTORED(S) = SUNFALSE;
+      return SUN_SUCCESS;
+    }
+
+    /* the copy is singular in single precision, factor A instead */
+    NUMFALLBACK(S)++;
+  }
+  DFACTORED(S) = SUNTRUE;
+
   /* perform LU factorization of input matrix */
   LASTFLAG(S) = SUNDlsMat_bandGBTRF(A_cols, SM_COLUMNS_B(A), SM_UBAND_B(A),
                                     SM_LBAND_B(A), SM_SUBAND_B(A), pivots);
@@ -163,9 +294,11 @@ int SUNLinSolSolve_Band(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
                         SUNDIALS_MAYBE_UNUSED sunrealtype tol)
 {
   SUNFunctionBegin(S->sunctx);
-  sunrealtype **A_cols, *xdata;
+  sunrealtype **A_cols, *xdata, *bdata;
   sunindextype* pivots;
 
+  LASTREFINE(S) = 0;
+
   /* copy b into x */
   N_VScale(ONE, b, x);
   SUNCheckLastErr();
@@ -181,6 +314,30 @@ int SUNLinSolSolve_Band(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   pivots = PIVOTS(S);
   SUNAssert(pivots, SUN_ERR_ARG_CORRUPT);
 
+  /* solve with the single precision factors and refine the solution */
+  if (!DFACTORED(S))
+  {
+    bdata = N_VGetArrayPointer(b);
+    SUNCheckLastErr();
+    SUNAssert(bdata, SUN_ERR_ARG_CORRUPT);
+
+    if (bandRefine(S, A, xdata, bdata))
+    {
+      LASTFLAG(S) = SUN_SUCCESS;
+      return SUN_SUCCESS;
+    }
+
+    /* the refinement did not converge, factor A in sunrealtype */
+    NUMFALLBACK(S)++;
+    DFACTORED(S) = SUNTRUE;
+    LASTFLAG(S)  = SUNDlsMat_bandGBTRF(A_cols, SM_COLUMNS_B(A), SM_UBAND_B(A),
+                                       SM_LBAND_B(A), SM_SUBAND_B(A), pivots);
+    if (LASTFLAG(S) > 0) { return (SUNLS_LUFACT_FAIL); }
+
+    N_VScale(ONE, b, x);
+    SUNCheckLastErr();
+  }
+
   /* solve using LU factors */
   SUNDlsMat_bandGBTRS(A_cols, SM_COLUMNS_B(A), SM_SUBAND_B(A), SM_LBAND_B(A),
                       pivots, xdata);
@@ -188,6 +345,12 @@ int SUNLinSolSolve_Band(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   return SUN_SUCCESS;
 }
 
+int SUNLinSolNumIters_Band(SUNLinearSolver S)
+{
+  /* return the number of refinement iterations in the last solve */
+  return (LASTREFINE(S));
+}
+
 sunindextype SUNLinSolLastFlag_Band(SUNLinearSolver S)
 {
   /* return the stored 'last_flag' value */
@@ -201,6 +364,14 @@ SUNErrCode SUNLinSolSpace_Band(SUNLinearSolver S, long int* lenrwLS,
   SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_BAND, SUN_ERR_ARG_WRONGTYPE);
   *leniwLS = 2 + BAND_CONTENT(S)->N;
   *lenrwLS = 0;
+  if (SDATA(S))
+  {
+    /* single precision factors and residual */
+    *lenrwLS = BAND_CONTENT(S)->N +
+               (BAND_CONTENT(S)->N * SLDIM(S) * sizeof(float) +
+                sizeof(sunrealtype) - 1) /
+                 sizeof(sunrealtype);
+  }
   return SUN_SUCCESS;
 }
 
@@ -217,6 +388,9 @@ SUNErrCode SUNLinSolFree_Band(SUNLinearSolver S)
       free(PIVOTS(S));
       PIVOTS(S) = NULL;
     }
+    free(SDATA(S));
+    free(SCOLS(S));
+    free(RES(S));
     free(S->content);
     S->content = NULL;
   }
@@ -229,3 +403,63 @@ SUNErrCode SUNLinSolFree_Band(SUNLinearSolver S)
   S = NULL;
   return SUN_SUCCESS;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Solve with the single precision factors and refine the solution x, which
+ * holds b on input, with residuals computed in sunrealtype. Returns SUNFALSE
+ * if the residual does not meet the tolerance within max_refine iterations or
+ * is not at least halved by an iteration.
+ */
+
+static sunbooleantype bandRefine(SUNLinearSolver S, SUNMatrix A,
+                                 sunrealtype* x, sunrealtype* b)
+{
+  sunindextype i, n, ml, smu;
+  sunrealtype *r, rnorm, rnorm_old, xnorm;
+  int iter;
+
+  n   = SM_COLUMNS_B(A);
+  ml  = SM_LBAND_B(A);
+  smu = SM_SUBAND_B(A);
+  r   = RES(S);
+
+  SUNDlsMat_bandSGBTRS(SCOLS(S), n, smu, ml, PIVOTS(S), x);
+
+  rnorm_old = SUN_BIG_REAL;
+  for (iter = 0;; iter++)
+  {
+    /* r = b - A x */
+    SUNDlsMat_bandMatvec(SM_COLS_B(A), x, r, n, SM_UBAND_B(A), ml, smu);
+    rnorm = ZERO;
+    xnorm = ZERO;
+    for (i = 0; i < n; i++)
+    {
+      r[i]  = b[i] - r[i];
+      rnorm = SUNMAX(rnorm, SUNRabs(r[i]));
+      xnorm = SUNMAX(xnorm, SUNRabs(x[i]));
+    }
+
+    if (rnorm <= RTOL(S) * xnorm) { break; }
+    if (iter == MAXREFINE(S) || rnorm > HALF * rnorm_old)
+    {
+      LASTREFINE(S) = iter;
+      NUMREFINE(S) += iter;
+      return SUNFALSE;
+    }
+    rnorm_old = rnorm;
+
+    /* x = x + (LU)^{-1} r */
+    SUNDlsMat_bandSGBTRS(SCOLS(S), n, smu, ml, PIVOTS(S), r);
+    for (i = 0; i < n; i++) { x[i] += r[i]; }
+  }
+
+  LASTREFINE(S) = iter;
+  NUMREFINE(S) += iter;
+  return SUNTRUE;
+}
@@ -0,0 +1,628 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the batched dense
+ * implementation of the SUNLINSOL package.
+ *
+ * The diagonal blocks are processed in batches of LANES blocks. The
+ * blocks of a batch are stored interleaved: entry (i,j) of the b-th
+ * block of the batch is at lu[(j*bs + i)*LANES + b]. Every step of
+ * the factorization and of the solve then operates on vectors that
+ * hold one block in each SIMD lane. Only the row swaps, which depend
+ * on the pivots of each block, are done one block at a time. The
+ * batches are independent and are divided among OpenMP threads.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_math.h>
+#include <sunlinsol/sunlinsol_batcheddense.h>
+
+#include "sundials_macros.h"
+
+#if defined(SUNDIALS_BATCHEDDENSE_SIMD) && \
+  (defined(SUNDIALS_DOUBLE_PRECISION) || defined(SUNDIALS_SINGLE_PRECISION))
+#define BATCHEDDENSE_SIMD_ENABLED
+#include <immintrin.h>
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+#define LANES SUNLINSOL_BATCHEDDENSE_LANES
+
+/*
+ * -----------------------------------------------------------------
+ * Kernels, compiled for SSE2, AVX2, and AVX-512 with function target
+ * attributes when the compiler supports them, and selected at run
+ * time as in the serial NVECTOR
+ * -----------------------------------------------------------------
+ */
+
+typedef sunindextype (*BatchFactorFn)(sunindextype bs, sunrealtype* lu,
+                                      sunindextype* piv);
+typedef void (*BatchSolveFn)(sunindextype bs, sunrealtype* lu,
+                             sunindextype* piv, sunrealtype* w);
+
+static BatchFactorFn batchFactor = NULL;
+static BatchSolveFn batchSolve   = NULL;
+
+#define SIMD_PASTE_(name, isa) name##_##isa
+#define SIMD_PASTE(name, isa)  SIMD_PASTE_(name, isa)
+#define SIMD_FN(name)          SIMD_PASTE(batchSIMD##name, SIMD_ISA)
+
+/* generic kernels */
+
+#define SIMD_ISA
+#define SIMD_TARGET
+#define SIMD_T                     sunrealtype
+#define SIMD_W                     1
+#define SIMD_LOAD(p)               (*(p))
+#define SIMD_STORE(p, v)           (*(p) = (v))
+#define SIMD_SET1(s)               (s)
+#define SIMD_MUL(a, b)             ((a) * (b))
+#define SIMD_DIV(a, b)             ((a) / (b))
+#define SIMD_FMA(a, b, c)          ((c) + (a) * (b))
+#define SIMD_ABS(v)                SUNRabs(v)
+#define SIMD_GT_SELECT(a, b, x, y) (((a) > (b)) ? (x) : (y))
+
+#include "sunlinsol_batcheddense_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_T
+#undef SIMD_W
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_FMA
+#undef SIMD_ABS
+#undef SIMD_GT_SELECT
+
+#if defined(BATCHEDDENSE_SIMD_ENABLED)
+
+/* SSE2 kernels, without fused multiply-add */
+
+#define SIMD_ISA    sse2
+#define SIMD_TARGET __attribute__((target("sse2")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_T            __m128d
+#define SIMD_W            2
+#define SIMD_LOAD(p)      _mm_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm_set1_pd(s)
+#define SIMD_MUL(a, b)    _mm_mul_pd(a, b)
+#define SIMD_DIV(a, b)    _mm_div_pd(a, b)
+#define SIMD_FMA(a, b, c) _mm_add_pd(c, _mm_mul_pd(a, b))
+#define SIMD_ABS(v)       _mm_andnot_pd(_mm_set1_pd(-0.0), v)
+#define SIMD_GT_SELECT(a, b, x, y)                    \
+  _mm_or_pd(_mm_and_pd(_mm_cmpgt_pd(a, b), x),        \
+            _mm_andnot_pd(_mm_cmpgt_pd(a, b), y))
+#else
+#define SIMD_T            __m128
+#define SIMD_W            4
+#define SIMD_LOAD(p)      _mm_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm_set1_ps(s)
+#define SIMD_MUL(a, b)    _mm_mul_ps(a, b)
+#define SIMD_DIV(a, b)    _mm_div_ps(a, b)
+#define SIMD_FMA(a, b, c) _mm_add_ps(c, _mm_mul_ps(a, b))
+#define SIMD_ABS(v)       _mm_andnot_ps(_mm_set1_ps(-0.0f), v)
+#define SIMD_GT_SELECT(a, b, x, y)                    \
+  _mm_or_ps(_mm_and_ps(_mm_cmpgt_ps(a, b), x),        \
+            _mm_andnot_ps(_mm_cmpgt_ps(a, b), y))
+#endif
+
+#include "sunlinsol_batcheddense_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_T
+#undef SIMD_W
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_FMA
+#undef SIMD_ABS
+#undef SIMD_GT_SELECT
+
+/* AVX2 and FMA kernels */
+
+#define SIMD_ISA    avx2
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_T            __m256d
+#define SIMD_W            4
+#define SIMD_LOAD(p)      _mm256_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm256_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm256_set1_pd(s)
+#define SIMD_MUL(a, b)    _mm256_mul_pd(a, b)
+#define SIMD_DIV(a, b)    _mm256_div_pd(a, b)
+#define SIMD_FMA(a, b, c) _mm256_fmadd_pd(a, b, c)
+#define SIMD_ABS(v)       _mm256_andnot_pd(_mm256_set1_pd(-0.0), v)
+#define SIMD_GT_SELECT(a, b, x, y) \
+  _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, _CMP_GT_OQ))
+#else
+#define SIMD_T            __m256
+#define SIMD_W            8
+#define SIMD_LOAD(p)      _mm256_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm256_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm256_set1_ps(s)
+#define SIMD_MUL(a, b)    _mm256_mul_ps(a, b)
+#define SIMD_DIV(a, b)    _mm256_div_ps(a, b)
+#define SIMD_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define SIMD_ABS(v)       _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v)
+#define SIMD_GT_SELECT(a, b, x, y) \
+  _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_GT_OQ))
+#endif
+
+#include "sunlinsol_batcheddense_kernels.h"
+
+#undef SIMD_ISA
+#undef SIMD_TARGET
+#undef SIMD_T
+#undef SIMD_W
+#undef SIMD_LOAD
+#undef SIMD_STORE
+#undef SIMD_SET1
+#undef SIMD_MUL
+#undef SIMD_DIV
+#undef SIMD_FMA
+#undef SIMD_ABS
+#undef SIMD_GT_SELECT
+
+/* AVX-512 kernels */
+
+#define SIMD_ISA    avx512
+#define SIMD_TARGET __attribute__((target("avx512f")))
+
+#if defined(SUNDIALS_DOUBLE_PRECISION)
+#define SIMD_T            __m512d
+#define SIMD_W            8
+#define SIMD_LOAD(p)      _mm512_loadu_pd(p)
+#define SIMD_STORE(p, v)  _mm512_storeu_pd(p, v)
+#define SIMD_SET1(s)      _mm512_set1_pd(s)
+#define SIMD_MUL(a, b)    _mm512_mul_pd(a, b)
+#define SIMD_DIV(a, b)    _mm512_div_pd(a, b)
+#define SIMD_FMA(a, b, c) _mm512_fmadd_pd(a, b, c)
+#define SIMD_ABS(v)       _mm512_abs_pd(v)
+#define SIMD_GT_SELECT(a, b, x, y) \
+  _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_GT_OQ), y, x)
+#else
+#define SIMD_T            __m512
+#define SIMD_W            16
+#define SIMD_LOAD(p)      _mm512_loadu_ps(p)
+#define SIMD_STORE(p, v)  _mm512_storeu_ps(p, v)
+#define SIMD_SET1(s)      _mm512_set1_ps(s)
+#define SIMD_MUL(a, b)    _mm512_mul_ps(a, b)
+#define SIMD_DIV(a, b)    _mm512_div_ps(a, b)
+#define SIMD_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define SIMD_ABS(v)       _mm512_abs_ps(v)
+#define SIMD_GT_SELECT(a, b, x, y) \
+  _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ), y, x)
+#endif
+
+#include "sunlinsol_batcheddense_kernels.h"
+
+#endif /* BATCHEDDENSE_SIMD_ENABLED */
+
+/*
+ * -----------------------------------------------------------------
+ * Batched dense solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define BD_CONTENT(S) ((SUNLinearSolverContent_BatchedDense)(S->content))
+#define NBLOCKS(S)    (BD_CONTENT(S)->nblocks)
+#define BLOCKSIZE(S)  (BD_CONTENT(S)->bs)
+#define NBATCHES(S)   (BD_CONTENT(S)->nbatches)
+#define LU(S)         (BD_CONTENT(S)->lu)
+#define WORK(S)       (BD_CONTENT(S)->work)
+#define PIVOTS(S)     (BD_CONTENT(S)->pivots)
+#define LASTFLAG(S)   (BD_CONTENT(S)->last_flag)
+#define NUMTHREADS(S) (BD_CONTENT(S)->num_threads)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static void batchLoad(SUNMatrix A, sunindextype batch, sunrealtype* lu);
+static void batchSelectKernels(void);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new batched dense linear solver
+ */
+
+SUNLinearSolver SUNLinSol_BatchedDense(SUNDIALS_MAYBE_UNUSED N_Vector y,
+                                       SUNMatrix A, SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  SUNLinearSolver S;
+  SUNLinearSolverContent_BatchedDense content;
+  sunindextype nblocks, bs, nbatches;
+
+  SUNAssertNull(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssertNull(SUNBlockSparseMatrix_BlockRows(A) ==
+                  SUNBlockSparseMatrix_BlockColumns(A),
+                SUN_ERR_ARG_DIMSMISMATCH);
+  SUNAssertNull(y->ops->nvgetarraypointer, SUN_ERR_ARG_INCOMPATIBLE);
+
+  nblocks = SUNBlockSparseMatrix_BlockRows(A);
+  bs      = SUNBlockSparseMatrix_BlockSize(A);
+  SUNAssertNull(nblocks * bs == N_VGetLength(y), SUN_ERR_ARG_DIMSMISMATCH);
+
+  nbatches = (nblocks + LANES - 1) / LANES;
+
+  batchSelectKernels();
+
+  /* Create an empty linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+  S->ops->gettype    = SUNLinSolGetType_BatchedDense;
+  S->ops->getid      = SUNLinSolGetID_BatchedDense;
+  S->ops->initialize = SUNLinSolInitialize_BatchedDense;
+  S->ops->setup      = SUNLinSolSetup_BatchedDense;
+  S->ops->solve      = SUNLinSolSolve_BatchedDense;
+  S->ops->lastflag   = SUNLinSolLastFlag_BatchedDense;
+  S->ops->space      = SUNLinSolSpace_BatchedDense;
+  S->ops->free       = SUNLinSolFree_BatchedDense;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_BatchedDense)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content */
+  content->nblocks     = nblocks;
+  content->bs          = bs;
+  content->nbatches    = nbatches;
+  content->lu          = NULL;
+  content->work        = NULL;
+  content->pivots      = NULL;
+  content->last_flag   = 0;
+  content->num_threads = 1;
+
+  /* Allocate content */
+  content->lu =
+    (sunrealtype*)malloc(nbatches * bs * bs * LANES * sizeof(sunrealtype));
+  SUNAssertNull(content->lu, SUN_ERR_MALLOC_FAIL);
+
+  content->work = (sunrealtype*)malloc(nbatches * bs * LANES *
+                                       sizeof(sunrealtype));
+  SUNAssertNull(content->work, SUN_ERR_MALLOC_FAIL);
+
+  content->pivots = (sunindextype*)malloc(nbatches * bs * LANES *
+                                          sizeof(sunindextype));
+  SUNAssertNull(content->pivots, SUN_ERR_MALLOC_FAIL);
+
+  return (S);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used in setup and solve
+ */
+
+SUNErrCode SUNLinSol_BatchedDense_SetNumThreads(SUNLinearSolver S,
+                                                int num_threads)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_BATCHEDDENSE,
+            SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_threads >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  NUMTHREADS(S) = num_threads;
+
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_BatchedDense(
+  SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_DIRECT);
+}
+
+SUNLinearSolver_ID SUNLinSolGetID_BatchedDense(
+  SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_BATCHEDDENSE);
+}
+
+SUNErrCode SUNLinSolInitialize_BatchedDense(SUNLinearSolver S)
+{
+  /* all solver-specific memory has already been allocated */
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSetup_BatchedDense(SUNLinearSolver S, SUNMatrix A)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunindextype r, bs, nbatches, flag;
+  sunindextype *rowptrs, *colind;
+  SUNDIALS_MAYBE_UNUSED int nt;
+
+  SUNAssert(A, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(SUNBlockSparseMatrix_BlockRows(A) == NBLOCKS(S),
+            SUN_ERR_ARG_DIMSMISMATCH);
+  SUNAssert(SUNBlockSparseMatrix_BlockSize(A) == BLOCKSIZE(S),
+            SUN_ERR_ARG_DIMSMISMATCH);
+
+  bs       = BLOCKSIZE(S);
+  nbatches = NBATCHES(S);
+  nt       = NUMTHREADS(S);
+
+  /* the matrix must be block diagonal; a block row without its diagonal
+     block has a zero diagonal block and is reported as singular below */
+  rowptrs = SUNBlockSparseMatrix_RowPointers(A);
+  colind  = SUNBlockSparseMatrix_ColumnIndices(A);
+  for (r = 0; r < NBLOCKS(S); r++)
+  {
+    if (rowptrs[r + 1] - rowptrs[r] > 1 ||
+        (rowptrs[r + 1] > rowptrs[r] && colind[rowptrs[r]] != r))
+    {
+      LASTFLAG(S) = SUN_ERR_ARG_INCOMPATIBLE;
+      return SUN_ERR_ARG_INCOMPATIBLE;
+    }
+  }
+
+  /* load and factor the batches, keeping the first singular row */
+  flag = NBLOCKS(S) * bs + 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) schedule(static) \
+  reduction(min : flag) num_threads(nt) if (nt > 1)
+#endif
+  for (sunindextype g = 0; g < nbatches; g++)
+  {
+    sunrealtype* lu    = LU(S) + g * bs * bs * LANES;
+    sunindextype* piv  = PIVOTS(S) + g * bs * LANES;
+    sunindextype gflag = 0;
+
+    batchLoad(A, g, lu);
+    gflag = batchFactor(bs, lu, piv);
+    if (gflag > 0) { flag = SUNMIN(flag, g * LANES * bs + gflag); }
+  }
+
+  /* store error flag (if nonzero, this row encountered zero-valued pivot) */
+  if (flag <= NBLOCKS(S) * bs)
+  {
+    LASTFLAG(S) = flag;
+    return (SUNLS_LUFACT_FAIL);
+  }
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSolve_BatchedDense(SUNLinearSolver S,
+                                SUNDIALS_MAYBE_UNUSED SUNMatrix A, N_Vector x,
+                                N_Vector b, SUNDIALS_MAYBE_UNUSED sunrealtype tol)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunrealtype *xdata, *bdata;
+  sunindextype bs, nblocks, nbatches;
+  SUNDIALS_MAYBE_UNUSED int nt;
+
+  /* access data pointers */
+  xdata = N_VGetArrayPointer(x);
+  SUNCheckLastErr();
+  bdata = N_VGetArrayPointer(b);
+  SUNCheckLastErr();
+  SUNAssert(xdata, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(bdata, SUN_ERR_ARG_CORRUPT);
+
+  bs       = BLOCKSIZE(S);
+  nblocks  = NBLOCKS(S);
+  nbatches = NBATCHES(S);
+  nt       = NUMTHREADS(S);
+
+  /* gather b into the interleaved layout, solve, and scatter into x */
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) schedule(static) num_threads(nt) \
+  if (nt > 1)
+#endif
+  for (sunindextype g = 0; g < nbatches; g++)
+  {
+    sunrealtype* lu   = LU(S) + g * bs * bs * LANES;
+    sunindextype* piv = PIVOTS(S) + g * bs * LANES;
+    sunrealtype* w    = WORK(S) + g * bs * LANES;
+    sunindextype i, l, blk;
+
+    for (l = 0; l < LANES; l++)
+    {
+      blk = g * LANES + l;
+      for (i = 0; i < bs; i++)
+      {
+        w[i * LANES + l] = (blk < nblocks) ? bdata[blk * bs + i] : ZERO;
+      }
+    }
+
+    batchSolve(bs, lu, piv, w);
+
+    for (l = 0; l < LANES && g * LANES + l < nblocks; l++)
+    {
+      blk = g * LANES + l;
+      for (i = 0; i < bs; i++) { xdata[blk * bs + i] = w[i * LANES + l]; }
+    }
+  }
+
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+sunindextype SUNLinSolLastFlag_BatchedDense(SUNLinearSolver S)
+{
+  /* return the stored 'last_flag' value */
+  return (LASTFLAG(S));
+}
+
+SUNErrCode SUNLinSolSpace_BatchedDense(SUNLinearSolver S, long int* lenrwLS,
+                                       long int* leniwLS)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_BATCHEDDENSE,
+            SUN_ERR_ARG_WRONGTYPE);
+  *lenrwLS = (long int)(NBATCHES(S) * BLOCKSIZE(S) * (BLOCKSIZE(S) + 1) *
+                        LANES);
+  *leniwLS = 5 + (long int)(NBATCHES(S) * BLOCKSIZE(S) * LANES);
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolFree_BatchedDense(SUNLinearSolver S)
+{
+  /* return if S is already free */
+  if (S == NULL) { return SUN_SUCCESS; }
+
+  /* delete items from contents, then delete generic structure */
+  if (S->content)
+  {
+    if (LU(S))
+    {
+      free(LU(S));
+      LU(S) = NULL;
+    }
+    if (WORK(S))
+    {
+      free(WORK(S));
+      WORK(S) = NULL;
+    }
+    if (PIVOTS(S))
+    {
+      free(PIVOTS(S));
+      PIVOTS(S) = NULL;
+    }
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops)
+  {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S);
+  S = NULL;
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Copy the diagonal blocks of a batch into the interleaved layout. Lanes past
+ * the last block hold identity blocks, and missing diagonal blocks are zero.
+ */
+
+static void batchLoad(SUNMatrix A, sunindextype batch, sunrealtype* lu)
+{
+  sunindextype i, l, blk;
+  sunindextype bs       = SUNBlockSparseMatrix_BlockSize(A);
+  sunindextype nblocks  = SUNBlockSparseMatrix_BlockRows(A);
+  sunindextype* rowptrs = SUNBlockSparseMatrix_RowPointers(A);
+  sunrealtype* data     = SUNBlockSparseMatrix_Data(A);
+  sunrealtype* block[LANES];
+
+  /* lanes without a block are zeroed first */
+  for (l = 0; l < LANES; l++)
+  {
+    blk      = batch * LANES + l;
+    block[l] = NULL;
+    if (blk < nblocks && rowptrs[blk + 1] > rowptrs[blk])
+    {
+      block[l] = data + rowptrs[blk] * bs * bs;
+    }
+    else
+    {
+      for (i = 0; i < bs * bs; i++) { lu[i * LANES + l] = ZERO; }
+      if (blk >= nblocks)
+      {
+        for (i = 0; i < bs; i++) { lu[(i * bs + i) * LANES + l] = ONE; }
+      }
+    }
+  }
+
+  /* interleave the entries of the blocks */
+  for (i = 0; i < bs * bs; i++)
+  {
+    for (l = 0; l < LANES; l++)
+    {
+      if (block[l]) { lu[i * LANES + l] = block[l][i]; }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------------
+ * Select the widest kernels supported by the CPU. Concurrent first calls may
+ * race but store the same values.
+ */
+
+static void batchSelectKernels(void)
+{
+  if (batchFactor && batchSolve) { return; }
+
+#if defined(BATCHEDDENSE_SIMD_ENABLED)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+  {
+    batchSolve  = batchSIMDSolve_avx512;
+    batchFactor = batchSIMDFactor_avx512;
+  }
+  else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    batchSolve  = batchSIMDSolve_avx2;
+    batchFactor = batchSIMDFactor_avx2;
+  }
+  else if (__builtin_cpu_supports("sse2"))
+  {
+    batchSolve  = batchSIMDSolve_sse2;
+    batchFactor = batchSIMDFactor_sse2;
+  }
+  else
+  {
+    batchSolve  = batchSIMDSolve_;
+    batchFactor = batchSIMDFactor_;
+  }
+#else
+  batchSolve  = batchSIMDSolve_;
+  batchFactor = batchSIMDFactor_;
+#endif
+}
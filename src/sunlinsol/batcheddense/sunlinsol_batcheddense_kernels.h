@@ -0,0 +1,191 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Kernels of the batched dense linear solver. This file is included
+ * once for each instruction set by sunlinsol_batcheddense.c after
+ * defining the following macros:
+ *
+ *   SIMD_FN(name)              - name of the kernel for the set
+ *   SIMD_TARGET                - function attribute enabling the set
+ *   SIMD_T                     - vector register type
+ *   SIMD_W                     - number of sunrealtype values in SIMD_T,
+ *                                a divisor of LANES
+ *   SIMD_LOAD(p)               - unaligned load
+ *   SIMD_STORE(p, v)           - unaligned store
+ *   SIMD_SET1(s)               - broadcast
+ *   SIMD_MUL(a, b)             - a * b
+ *   SIMD_DIV(a, b)             - a / b
+ *   SIMD_FMA(a, b, c)          - a * b + c
+ *   SIMD_ABS(v)                - |v|
+ *   SIMD_GT_SELECT(a, b, x, y) - (a > b) ? x : y in each lane
+ *
+ * The generic kernels use SIMD_T = sunrealtype and SIMD_W = 1.
+ * -----------------------------------------------------------------*/
+
+/* -----------------------------------------------------------------
+ * LU factorization with partial pivoting of the blocks of a batch,
+ * with the same pivots as SUNDlsMat_denseGETRF. Returns 0, or the
+ * smallest one-based index into the batch (lane * bs + k + 1) of a
+ * zero pivot. The elimination continues past a zero pivot with zero
+ * multipliers so the other blocks are still factored. The pivot
+ * search, the scaling and the update are vectorized across blocks;
+ * the row swaps, which differ from block to block, are not.
+ * ----------------------------------------------------------------*/
+
+SIMD_TARGET static sunindextype SIMD_FN(Factor)(sunindextype bs,
+                                                sunrealtype* lu,
+                                                sunindextype* piv)
+{
+  sunindextype i, j, k, l, p, v, fail;
+  sunindextype zero[LANES];
+  sunrealtype amax[LANES], rowk[LANES], temp;
+  sunrealtype *col_k, *col_j;
+
+  for (l = 0; l < LANES; l++) { zero[l] = 0; }
+
+  for (k = 0; k < bs; k++)
+  {
+    col_k = lu + k * bs * LANES;
+
+    /* find the first entry of largest magnitude on or below the diagonal */
+    for (v = 0; v < LANES; v += SIMD_W)
+    {
+      SIMD_T m = SIMD_ABS(SIMD_LOAD(col_k + k * LANES + v));
+      SIMD_T r = SIMD_SET1((sunrealtype)k);
+      for (i = k + 1; i < bs; i++)
+      {
+        SIMD_T a = SIMD_ABS(SIMD_LOAD(col_k + i * LANES + v));
+        r        = SIMD_GT_SELECT(a, m, SIMD_SET1((sunrealtype)i), r);
+        m        = SIMD_GT_SELECT(a, m, a, m);
+      }
+      SIMD_STORE(amax + v, m);
+      SIMD_STORE(rowk + v, r);
+    }
+
+    /* record the pivots and swap rows k and p of each block */
+    for (l = 0; l < LANES; l++)
+    {
+      p                  = (sunindextype)rowk[l];
+      piv[k * LANES + l] = p;
+      if (amax[l] == ZERO && zero[l] == 0) { zero[l] = k + 1; }
+      if (p != k)
+      {
+        for (j = 0; j < bs; j++)
+        {
+          temp                         = lu[(j * bs + p) * LANES + l];
+          lu[(j * bs + p) * LANES + l] = lu[(j * bs + k) * LANES + l];
+          lu[(j * bs + k) * LANES + l] = temp;
+        }
+      }
+    }
+
+    /* scale the multipliers below the diagonal, by zero in a block with a
+       zero pivot */
+    for (v = 0; v < LANES; v += SIMD_W)
+    {
+      SIMD_T s = SIMD_GT_SELECT(SIMD_LOAD(amax + v), SIMD_SET1(ZERO),
+                                SIMD_DIV(SIMD_SET1(ONE),
+                                         SIMD_LOAD(col_k + k * LANES + v)),
+                                SIMD_SET1(ZERO));
+      for (i = k + 1; i < bs; i++)
+      {
+        SIMD_STORE(col_k + i * LANES + v,
+                   SIMD_MUL(SIMD_LOAD(col_k + i * LANES + v), s));
+      }
+    }
+
+    /* update the trailing columns */
+    for (j = k + 1; j < bs; j++)
+    {
+      col_j = lu + j * bs * LANES;
+      for (v = 0; v < LANES; v += SIMD_W)
+      {
+        SIMD_T u = SIMD_MUL(SIMD_SET1(-ONE), SIMD_LOAD(col_j + k * LANES + v));
+        for (i = k + 1; i < bs; i++)
+        {
+          SIMD_STORE(col_j + i * LANES + v,
+                     SIMD_FMA(u, SIMD_LOAD(col_k + i * LANES + v),
+                              SIMD_LOAD(col_j + i * LANES + v)));
+        }
+      }
+    }
+  }
+
+  fail = 0;
+  for (l = LANES - 1; l >= 0; l--)
+  {
+    if (zero[l] > 0) { fail = l * bs + zero[l]; }
+  }
+
+  return (fail);
+}
+
+/* -----------------------------------------------------------------
+ * Solve with the LU factors of a batch, in place in the interleaved
+ * right-hand sides w, in the same order as SUNDlsMat_denseGETRS
+ * ----------------------------------------------------------------*/
+
+SIMD_TARGET static void SIMD_FN(Solve)(sunindextype bs, sunrealtype* lu,
+                                       sunindextype* piv, sunrealtype* w)
+{
+  sunindextype i, k, l, p, v;
+  sunrealtype *col_k, temp;
+
+  /* permute the right-hand sides */
+  for (k = 0; k < bs; k++)
+  {
+    for (l = 0; l < LANES; l++)
+    {
+      p = piv[k * LANES + l];
+      if (p != k)
+      {
+        temp             = w[k * LANES + l];
+        w[k * LANES + l] = w[p * LANES + l];
+        w[p * LANES + l] = temp;
+      }
+    }
+  }
+
+  /* solve Ly = b */
+  for (k = 0; k < bs - 1; k++)
+  {
+    col_k = lu + k * bs * LANES;
+    for (v = 0; v < LANES; v += SIMD_W)
+    {
+      SIMD_T u = SIMD_MUL(SIMD_SET1(-ONE), SIMD_LOAD(w + k * LANES + v));
+      for (i = k + 1; i < bs; i++)
+      {
+        SIMD_STORE(w + i * LANES + v,
+                   SIMD_FMA(u, SIMD_LOAD(col_k + i * LANES + v),
+                            SIMD_LOAD(w + i * LANES + v)));
+      }
+    }
+  }
+
+  /* solve Ux = y */
+  for (k = bs - 1; k >= 0; k--)
+  {
+    col_k = lu + k * bs * LANES;
+    for (v = 0; v < LANES; v += SIMD_W)
+    {
+      SIMD_T u = SIMD_DIV(SIMD_LOAD(w + k * LANES + v),
+                          SIMD_LOAD(col_k + k * LANES + v));
+      SIMD_STORE(w + k * LANES + v, u);
+      u = SIMD_MUL(SIMD_SET1(-ONE), u);
+      for (i = 0; i < k; i++)
+      {
+        SIMD_STORE(w + i * LANES + v,
+                   SIMD_FMA(u, SIMD_LOAD(col_k + i * LANES + v),
+                            SIMD_LOAD(w + i * LANES + v)));
+      }
+    }
+  }
+}
@@ -0,0 +1,893 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the Chebyshev polynomial
+ * implementation of the SUNLINSOL package.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_iterative.h>
+#include <sundials/sundials_math.h>
+#include <sunlinsol/sunlinsol_chebyshev.h>
+
+#include "sundials_logger_impl.h"
+#include "sundials_macros.h"
+
+#define ZERO    SUN_RCONST(0.0)
+#define HALF    SUN_RCONST(0.5)
+#define ONE     SUN_RCONST(1.0)
+#define TWO     SUN_RCONST(2.0)
+#define HUNDRED SUN_RCONST(100.0)
+
+/* maximum number of sweeps of the Jacobi eigenvalue iteration */
+#define MAX_JACOBI_SWEEPS 50
+
+/*
+ * -----------------------------------------------------------------
+ * Chebyshev solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define CHEB_CONTENT(S) ((SUNLinearSolverContent_Chebyshev)(S->content))
+#define PRETYPE(S)      (CHEB_CONTENT(S)->pretype)
+#define LASTFLAG(S)     (CHEB_CONTENT(S)->last_flag)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static int chebOperator(SUNLinearSolver S, N_Vector v, N_Vector Mv,
+                        sunrealtype delta);
+static int chebEstimate(SUNLinearSolver S, N_Vector z, sunrealtype delta);
+static void chebSymEigBounds(int n, sunrealtype* A, sunrealtype* emin,
+                             sunrealtype* emax);
+static void chebFreeArnoldi(SUNLinearSolver S);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new Chebyshev linear solver
+ */
+
+SUNLinearSolver SUNLinSol_Chebyshev(N_Vector y, int pretype, int degree,
+                                    SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  SUNLinearSolver S;
+  SUNLinearSolverContent_Chebyshev content;
+
+  /* check for legal pretype and degree values; if illegal use defaults */
+  if ((pretype != SUN_PREC_NONE) && (pretype != SUN_PREC_LEFT) &&
+      (pretype != SUN_PREC_RIGHT) && (pretype != SUN_PREC_BOTH))
+  {
+    pretype = SUN_PREC_NONE;
+  }
+  if (degree <= 0) { degree = SUNCHEBYSHEV_DEGREE_DEFAULT; }
+
+  /* Create linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+  S->ops->gettype           = SUNLinSolGetType_Chebyshev;
+  S->ops->getid             = SUNLinSolGetID_Chebyshev;
+  S->ops->setatimes         = SUNLinSolSetATimes_Chebyshev;
+  S->ops->setpreconditioner = SUNLinSolSetPreconditioner_Chebyshev;
+  S->ops->setzeroguess      = SUNLinSolSetZeroGuess_Chebyshev;
+  S->ops->initialize        = SUNLinSolInitialize_Chebyshev;
+  S->ops->setup             = SUNLinSolSetup_Chebyshev;
+  S->ops->solve             = SUNLinSolSolve_Chebyshev;
+  S->ops->numiters          = SUNLinSolNumIters_Chebyshev;
+  S->ops->lastflag          = SUNLinSolLastFlag_Chebyshev;
+  S->ops->space             = SUNLinSolSpace_Chebyshev;
+  S->ops->free              = SUNLinSolFree_Chebyshev;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_Chebyshev)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content */
+  content->last_flag  = 0;
+  content->degree     = degree;
+  content->maxeig     = SUNCHEBYSHEV_MAXEIG_DEFAULT;
+  content->pretype    = pretype;
+  content->zeroguess  = SUNFALSE;
+  content->user_eigs  = SUNFALSE;
+  content->eig_needed = SUNTRUE;
+  content->lmin       = ZERO;
+  content->lmax       = ZERO;
+  content->numiters   = 0;
+  content->ATimes     = NULL;
+  content->ATData     = NULL;
+  content->Psetup     = NULL;
+  content->Psolve     = NULL;
+  content->PData      = NULL;
+  content->r          = NULL;
+  content->d          = NULL;
+  content->w          = NULL;
+  content->V          = NULL;
+  content->H          = NULL;
+  content->Hsym       = NULL;
+
+  /* Allocate content */
+  content->r = N_VClone(y);
+  SUNCheckLastErrNull();
+
+  content->d = N_VClone(y);
+  SUNCheckLastErrNull();
+
+  content->w = N_VClone(y);
+  SUNCheckLastErrNull();
+
+  return (S);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the type of preconditioning for Chebyshev to use
+ */
+
+SUNErrCode SUNLinSol_ChebyshevSetPrecType(SUNLinearSolver S, int pretype)
+{
+  SUNFunctionBegin(S->sunctx);
+  /* Check for legal pretype */
+  SUNAssert((pretype == SUN_PREC_NONE) || (pretype == SUN_PREC_LEFT) ||
+            (pretype == SUN_PREC_RIGHT) || (pretype == SUN_PREC_BOTH),
+            SUN_ERR_ARG_OUTOFRANGE);
+
+  /* Set pretype, the bounds of the new operator must be estimated */
+  if (PRETYPE(S) != pretype && !CHEB_CONTENT(S)->user_eigs)
+  {
+    CHEB_CONTENT(S)->eig_needed = SUNTRUE;
+  }
+  PRETYPE(S) = pretype;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of Chebyshev iterations in each solve
+ */
+
+SUNErrCode SUNLinSol_ChebyshevSetDegree(SUNLinearSolver S, int degree)
+{
+  /* Check for legal degree */
+  if (degree <= 0) { degree = SUNCHEBYSHEV_DEGREE_DEFAULT; }
+
+  /* Set degree */
+  CHEB_CONTENT(S)->degree = degree;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of Arnoldi iterations used to estimate the
+ * bounds of the spectrum
+ */
+
+SUNErrCode SUNLinSol_ChebyshevSetMaxEigIters(SUNLinearSolver S, int maxeig)
+{
+  /* Check for legal number of iterations */
+  if (maxeig <= 0) { maxeig = SUNCHEBYSHEV_MAXEIG_DEFAULT; }
+
+  /* The Arnoldi workspace is sized by maxeig, reallocate it when needed */
+  if (maxeig != CHEB_CONTENT(S)->maxeig) { chebFreeArnoldi(S); }
+
+  /* Set the number of iterations */
+  CHEB_CONTENT(S)->maxeig = maxeig;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to supply the bounds of the spectrum, or with lmin = lmax = 0,
+ * to return to estimating them after each setup
+ */
+
+SUNErrCode SUNLinSol_ChebyshevSetEigBounds(SUNLinearSolver S, sunrealtype lmin,
+                                           sunrealtype lmax)
+{
+  SUNFunctionBegin(S->sunctx);
+
+  if ((lmin == ZERO) && (lmax == ZERO))
+  {
+    CHEB_CONTENT(S)->user_eigs  = SUNFALSE;
+    CHEB_CONTENT(S)->eig_needed = SUNTRUE;
+    return SUN_SUCCESS;
+  }
+
+  /* Check for a legal interval */
+  SUNAssert((lmin > ZERO) && (lmin < lmax), SUN_ERR_ARG_OUTOFRANGE);
+
+  CHEB_CONTENT(S)->lmin       = lmin;
+  CHEB_CONTENT(S)->lmax       = lmax;
+  CHEB_CONTENT(S)->user_eigs  = SUNTRUE;
+  CHEB_CONTENT(S)->eig_needed = SUNFALSE;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to return the bounds of the spectrum used in the last solve
+ */
+
+SUNErrCode SUNLinSol_ChebyshevGetEigBounds(SUNLinearSolver S,
+                                           sunrealtype* lmin,
+                                           sunrealtype* lmax)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(lmin, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(lmax, SUN_ERR_ARG_CORRUPT);
+  *lmin = CHEB_CONTENT(S)->lmin;
+  *lmax = CHEB_CONTENT(S)->lmax;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Preconditioner setup and solve functions for passing the solver object to
+ * SUNLinSolSetPreconditioner of a Krylov solver (e.g., PCG, SPGMR, or
+ * SPFGMR) as the P_data input
+ */
+
+int SUNLinSol_ChebyshevPrecSetup(void* P_data)
+{
+  return (SUNLinSolSetup((SUNLinearSolver)P_data, NULL));
+}
+
+int SUNLinSol_ChebyshevPrecSolve(void* P_data, N_Vector r, N_Vector z,
+                                 sunrealtype tol, SUNDIALS_MAYBE_UNUSED int lr)
+{
+  SUNLinearSolver S = (SUNLinearSolver)P_data;
+
+  /* z = p(A) r is always applied from a zero initial guess */
+  CHEB_CONTENT(S)->zeroguess = SUNTRUE;
+  return (SUNLinSolSolve(S, NULL, z, r, tol));
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_Chebyshev(
+  SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_ITERATIVE);
+}
+
+SUNLinearSolver_ID SUNLinSolGetID_Chebyshev(
+  SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_CHEBYSHEV);
+}
+
+SUNErrCode SUNLinSolInitialize_Chebyshev(SUNLinearSolver S)
+{
+  SUNFunctionBegin(S->sunctx);
+  if (CHEB_CONTENT(S)->degree <= 0)
+  {
+    CHEB_CONTENT(S)->degree = SUNCHEBYSHEV_DEGREE_DEFAULT;
+  }
+  if (CHEB_CONTENT(S)->maxeig <= 0)
+  {
+    CHEB_CONTENT(S)->maxeig = SUNCHEBYSHEV_MAXEIG_DEFAULT;
+  }
+
+  SUNAssert(CHEB_CONTENT(S)->ATimes, SUN_ERR_ARG_CORRUPT);
+
+  if ((PRETYPE(S) != SUN_PREC_LEFT) && (PRETYPE(S) != SUN_PREC_RIGHT) &&
+      (PRETYPE(S) != SUN_PREC_BOTH))
+  {
+    PRETYPE(S) = SUN_PREC_NONE;
+  }
+
+  SUNAssert((CHEB_CONTENT(S)->pretype == SUN_PREC_NONE) ||
+            (CHEB_CONTENT(S)->Psolve != NULL),
+            SUN_ERR_ARG_CORRUPT);
+
+  /* estimate the bounds before the next solve */
+  if (!CHEB_CONTENT(S)->user_eigs) { CHEB_CONTENT(S)->eig_needed = SUNTRUE; }
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolSetATimes_Chebyshev(SUNLinearSolver S, void* ATData,
+                                        SUNATimesFn ATimes)
+{
+  /* set function pointers to integrator-supplied ATimes routine
+     and data, and return with success */
+  CHEB_CONTENT(S)->ATimes = ATimes;
+  CHEB_CONTENT(S)->ATData = ATData;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolSetPreconditioner_Chebyshev(SUNLinearSolver S, void* PData,
+                                                SUNPSetupFn Psetup,
+                                                SUNPSolveFn Psolve)
+{
+  /* set function pointers to integrator-supplied Psetup and PSolve
+     routines and data, and return with success */
+  CHEB_CONTENT(S)->Psetup = Psetup;
+  CHEB_CONTENT(S)->Psolve = Psolve;
+  CHEB_CONTENT(S)->PData  = PData;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolSetZeroGuess_Chebyshev(SUNLinearSolver S,
+                                           sunbooleantype onoff)
+{
+  /* set flag indicating a zero initial guess */
+  CHEB_CONTENT(S)->zeroguess = onoff;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSetup_Chebyshev(SUNLinearSolver S,
+                             SUNDIALS_MAYBE_UNUSED SUNMatrix nul)
+{
+  SUNFunctionBegin(S->sunctx);
+
+  int status;
+  SUNPSetupFn Psetup;
+  void* PData;
+
+  /* Set shortcuts to Chebyshev memory structures */
+  Psetup = CHEB_CONTENT(S)->Psetup;
+  PData  = CHEB_CONTENT(S)->PData;
+
+  /* if user-supplied Psetup routine exists, call that here */
+  if (Psetup != NULL)
+  {
+    status = Psetup(PData);
+    if (status != 0)
+    {
+      LASTFLAG(S) = (status < 0) ? SUNLS_PSET_FAIL_UNREC : SUNLS_PSET_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+  }
+
+  /* the operator may have changed, estimate the bounds of its spectrum
+     again in the next solve */
+  if (!CHEB_CONTENT(S)->user_eigs) { CHEB_CONTENT(S)->eig_needed = SUNTRUE; }
+
+  /* return with success */
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSolve_Chebyshev(SUNLinearSolver S,
+                             SUNDIALS_MAYBE_UNUSED SUNMatrix nul, N_Vector x,
+                             N_Vector b, sunrealtype delta)
+{
+  SUNFunctionBegin(S->sunctx);
+
+  /* local data and shortcut variables */
+  sunrealtype theta, halfwidth, sigma, rho, rho_new;
+  sunrealtype cv[3];
+  N_Vector Xv[3];
+  N_Vector r, d, w;
+  sunbooleantype UsePrec;
+  sunbooleantype* zeroguess;
+  int k, degree, pretype;
+  void *A_data, *P_data;
+  SUNATimesFn atimes;
+  SUNPSolveFn psolve;
+  int* nli;
+  int status;
+
+  /* Make local shorcuts to solver variables. */
+  degree    = CHEB_CONTENT(S)->degree;
+  r         = CHEB_CONTENT(S)->r;
+  d         = CHEB_CONTENT(S)->d;
+  w         = CHEB_CONTENT(S)->w;
+  A_data    = CHEB_CONTENT(S)->ATData;
+  P_data    = CHEB_CONTENT(S)->PData;
+  atimes    = CHEB_CONTENT(S)->ATimes;
+  psolve    = CHEB_CONTENT(S)->Psolve;
+  pretype   = CHEB_CONTENT(S)->pretype;
+  zeroguess = &(CHEB_CONTENT(S)->zeroguess);
+  nli       = &(CHEB_CONTENT(S)->numiters);
+
+  /* Initialize counters */
+  *nli = 0;
+
+  /* set sunbooleantype flags for internal solver options */
+  UsePrec = ((pretype == SUN_PREC_BOTH) || (pretype == SUN_PREC_LEFT) ||
+             (pretype == SUN_PREC_RIGHT));
+
+  /* Check if Atimes function has been set */
+  SUNAssert(atimes, SUN_ERR_ARG_CORRUPT);
+
+  /* If preconditioning, check if psolve has been set */
+  SUNAssert(!UsePrec || psolve, SUN_ERR_ARG_CORRUPT);
+
+  /* Set r to initial residual r_0 = b - A*x_0 */
+  if (*zeroguess)
+  {
+    N_VScale(ONE, b, r);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    status = atimes(A_data, x, r);
+    if (status != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = (status < 0) ? SUNLS_ATIMES_FAIL_UNREC
+                                 : SUNLS_ATIMES_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+    N_VLinearSum(ONE, b, -ONE, r, r);
+    SUNCheckLastErr();
+  }
+
+  /* Apply preconditioner to the residual, d = P^{-1} r_0 */
+  if (UsePrec)
+  {
+    status = psolve(P_data, r, d, delta, SUN_PREC_LEFT);
+    if (status != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = (status < 0) ? SUNLS_PSOLVE_FAIL_UNREC
+                                 : SUNLS_PSOLVE_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+  }
+  else
+  {
+    N_VScale(ONE, r, d);
+    SUNCheckLastErr();
+  }
+
+  /* Estimate the bounds of the spectrum of P^{-1} A from the Krylov space of
+     the initial residual. This is the only place with global reductions. */
+  if (CHEB_CONTENT(S)->eig_needed)
+  {
+    status = chebEstimate(S, d, delta);
+    if (status != SUN_SUCCESS)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = status;
+      return (LASTFLAG(S));
+    }
+
+    /* the initial residual is zero, x_0 is the solution */
+    if (CHEB_CONTENT(S)->eig_needed)
+    {
+      if (*zeroguess)
+      {
+        N_VConst(ZERO, x);
+        SUNCheckLastErr();
+      }
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = SUN_SUCCESS;
+      return (LASTFLAG(S));
+    }
+  }
+
+  /* Chebyshev iteration for the interval [lmin, lmax] (Saad, Iterative
+     Methods for Sparse Linear Systems, Algorithm 12.1) */
+  theta     = HALF * (CHEB_CONTENT(S)->lmax + CHEB_CONTENT(S)->lmin);
+  halfwidth = HALF * (CHEB_CONTENT(S)->lmax - CHEB_CONTENT(S)->lmin);
+  sigma     = theta / halfwidth;
+  rho       = ONE / sigma;
+
+  /* d_0 = P^{-1} r_0 / theta */
+  N_VScale(ONE / theta, d, d);
+  SUNCheckLastErr();
+
+  for (k = 0; k < degree; k++)
+  {
+    /* increment counter */
+    (*nli)++;
+
+    /* Update x = x + d */
+    if (k == 0 && *zeroguess)
+    {
+      N_VScale(ONE, d, x);
+      SUNCheckLastErr();
+    }
+    else
+    {
+      N_VLinearSum(ONE, x, ONE, d, x);
+      SUNCheckLastErr();
+    }
+
+    /* The residual and direction are not needed after the last update */
+    if (k == degree - 1) { break; }
+
+    /* Generate w = A*d */
+    status = atimes(A_data, d, w);
+    if (status != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = (status < 0) ? SUNLS_ATIMES_FAIL_UNREC
+                                 : SUNLS_ATIMES_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+
+    rho_new = ONE / (TWO * sigma - rho);
+    cv[0]   = rho_new * rho;
+    cv[1]   = TWO * rho_new / halfwidth;
+
+    if (UsePrec)
+    {
+      /* Update r = r - A*d */
+      N_VLinearSum(ONE, r, -ONE, w, r);
+      SUNCheckLastErr();
+
+      /* Apply preconditioner: w = P^{-1}*r */
+      status = psolve(P_data, r, w, delta, SUN_PREC_LEFT);
+      if (status != 0)
+      {
+        *zeroguess  = SUNFALSE;
+        LASTFLAG(S) = (status < 0) ? SUNLS_PSOLVE_FAIL_UNREC
+                                   : SUNLS_PSOLVE_FAIL_REC;
+        return (LASTFLAG(S));
+      }
+
+      /* Update d = c0*d + c1*P^{-1}*r */
+      N_VLinearSum(cv[0], d, cv[1], w, d);
+      SUNCheckLastErr();
+    }
+    else
+    {
+      /* Update d = c0*d + c1*(r - A*d) before r is overwritten */
+      cv[2] = -cv[1];
+      Xv[0] = d;
+      Xv[1] = r;
+      Xv[2] = w;
+      SUNCheckCall(N_VLinearCombination(3, cv, Xv, d));
+
+      /* Update r = r - A*d */
+      N_VLinearSum(ONE, r, -ONE, w, r);
+      SUNCheckLastErr();
+    }
+
+    rho = rho_new;
+  }
+
+  /* Main loop finished, the polynomial has a fixed degree so the solve does
+     not test for convergence */
+  *zeroguess  = SUNFALSE;
+  LASTFLAG(S) = SUN_SUCCESS;
+  return (LASTFLAG(S));
+}
+
+int SUNLinSolNumIters_Chebyshev(SUNLinearSolver S)
+{
+  /* return the stored 'numiters' value */
+  return (CHEB_CONTENT(S)->numiters);
+}
+
+sunindextype SUNLinSolLastFlag_Chebyshev(SUNLinearSolver S)
+{
+  /* return the stored 'last_flag' value */
+  return (LASTFLAG(S));
+}
+
+SUNErrCode SUNLinSolSpace_Chebyshev(SUNLinearSolver S, long int* lenrwLS,
+                                    long int* leniwLS)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunindextype liw1, lrw1;
+  long int nv, maxeig;
+  N_VSpace(CHEB_CONTENT(S)->r, &lrw1, &liw1);
+  SUNCheckLastErr();
+  maxeig   = CHEB_CONTENT(S)->maxeig;
+  nv       = (CHEB_CONTENT(S)->V) ? 3 + maxeig + 1 : 3;
+  *lenrwLS = 2 + lrw1 * nv;
+  *leniwLS = 5 + liw1 * nv;
+  if (CHEB_CONTENT(S)->H)
+  {
+    *lenrwLS += (maxeig + 1) * maxeig + maxeig * maxeig;
+  }
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolFree_Chebyshev(SUNLinearSolver S)
+{
+  if (S == NULL) { return SUN_SUCCESS; }
+
+  if (S->content)
+  {
+    /* delete items from within the content structure */
+    if (CHEB_CONTENT(S)->r)
+    {
+      N_VDestroy(CHEB_CONTENT(S)->r);
+      CHEB_CONTENT(S)->r = NULL;
+    }
+    if (CHEB_CONTENT(S)->d)
+    {
+      N_VDestroy(CHEB_CONTENT(S)->d);
+      CHEB_CONTENT(S)->d = NULL;
+    }
+    if (CHEB_CONTENT(S)->w)
+    {
+      N_VDestroy(CHEB_CONTENT(S)->w);
+      CHEB_CONTENT(S)->w = NULL;
+    }
+    chebFreeArnoldi(S);
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops)
+  {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S);
+  S = NULL;
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Apply the (preconditioned) operator, Mv = P^{-1} A v. Returns 0 or a
+ * SUNLS failure flag.
+ */
+
+static int chebOperator(SUNLinearSolver S, N_Vector v, N_Vector Mv,
+                        sunrealtype delta)
+{
+  int status;
+  int pretype = CHEB_CONTENT(S)->pretype;
+
+  if (pretype == SUN_PREC_NONE)
+  {
+    status = CHEB_CONTENT(S)->ATimes(CHEB_CONTENT(S)->ATData, v, Mv);
+    if (status != 0)
+    {
+      return ((status < 0) ? SUNLS_ATIMES_FAIL_UNREC : SUNLS_ATIMES_FAIL_REC);
+    }
+    return SUN_SUCCESS;
+  }
+
+  status = CHEB_CONTENT(S)->ATimes(CHEB_CONTENT(S)->ATData, v,
+                                   CHEB_CONTENT(S)->w);
+  if (status != 0)
+  {
+    return ((status < 0) ? SUNLS_ATIMES_FAIL_UNREC : SUNLS_ATIMES_FAIL_REC);
+  }
+
+  status = CHEB_CONTENT(S)->Psolve(CHEB_CONTENT(S)->PData, CHEB_CONTENT(S)->w,
+                                   Mv, delta, SUN_PREC_LEFT);
+  if (status != 0)
+  {
+    return ((status < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Estimate the bounds of the spectrum of M = P^{-1} A with at most maxeig
+ * Arnoldi iterations started from z. The real parts of the eigenvalues of the
+ * Hessenberg matrix H lie between the extreme eigenvalues of its symmetric
+ * part, (H + H^T)/2, and for symmetric M these are the Lanczos estimates. The
+ * upper bound is enlarged by a safety factor since the Ritz values
+ * underestimate it, and the lower bound is kept above a fraction of the upper
+ * one. If z is zero the bounds are left unchanged and eig_needed is not
+ * cleared.
+ */
+
+static int chebEstimate(SUNLinearSolver S, N_Vector z, sunrealtype delta)
+{
+  SUNFunctionBegin(S->sunctx);
+  int i, j, m, maxeig, status;
+  sunrealtype znorm, hmax, emin, emax;
+  N_Vector* V;
+  sunrealtype** H;
+  sunrealtype* Hs;
+
+  maxeig = CHEB_CONTENT(S)->maxeig;
+
+  /* Allocate the Arnoldi workspace on first use */
+  if (CHEB_CONTENT(S)->V == NULL)
+  {
+    CHEB_CONTENT(S)->V = N_VCloneVectorArray(maxeig + 1, CHEB_CONTENT(S)->r);
+    SUNCheckLastErr();
+  }
+  if (CHEB_CONTENT(S)->H == NULL)
+  {
+    CHEB_CONTENT(S)->H =
+      (sunrealtype**)calloc(maxeig + 1, sizeof(sunrealtype*));
+    SUNAssert(CHEB_CONTENT(S)->H, SUN_ERR_MALLOC_FAIL);
+    for (i = 0; i <= maxeig; i++)
+    {
+      CHEB_CONTENT(S)->H[i] =
+        (sunrealtype*)malloc(maxeig * sizeof(sunrealtype));
+      SUNAssert(CHEB_CONTENT(S)->H[i], SUN_ERR_MALLOC_FAIL);
+    }
+  }
+  if (CHEB_CONTENT(S)->Hsym == NULL)
+  {
+    CHEB_CONTENT(S)->Hsym =
+      (sunrealtype*)malloc(maxeig * maxeig * sizeof(sunrealtype));
+    SUNAssert(CHEB_CONTENT(S)->Hsym, SUN_ERR_MALLOC_FAIL);
+  }
+
+  V  = CHEB_CONTENT(S)->V;
+  H  = CHEB_CONTENT(S)->H;
+  Hs = CHEB_CONTENT(S)->Hsym;
+
+  /* V[0] = z / ||z||, nothing to estimate from a zero vector */
+  znorm = N_VDotProd(z, z);
+  SUNCheckLastErr();
+  znorm = SUNRsqrt(znorm);
+  if (znorm == ZERO) { return SUN_SUCCESS; }
+
+  N_VScale(ONE / znorm, z, V[0]);
+  SUNCheckLastErr();
+
+  for (i = 0; i <= maxeig; i++)
+  {
+    for (j = 0; j < maxeig; j++) { H[i][j] = ZERO; }
+  }
+
+  /* Arnoldi iteration, stop early on an invariant subspace */
+  m    = 0;
+  hmax = ZERO;
+  for (j = 0; j < maxeig; j++)
+  {
+    status = chebOperator(S, V[j], V[j + 1], delta);
+    if (status != SUN_SUCCESS) { return status; }
+
+    SUNCheckCall(SUNModifiedGS(V, H, j + 1, j + 1, &(H[j + 1][j])));
+    m = j + 1;
+
+    for (i = 0; i <= j; i++) { hmax = SUNMAX(hmax, SUNRabs(H[i][j])); }
+    if (H[j + 1][j] <= HUNDRED * SUN_UNIT_ROUNDOFF * hmax) { break; }
+
+    N_VScale(ONE / H[j + 1][j], V[j + 1], V[j + 1]);
+    SUNCheckLastErr();
+  }
+
+  /* Extreme eigenvalues of the symmetric part of the m x m Hessenberg
+     matrix (stored column-major in Hs) */
+  for (j = 0; j < m; j++)
+  {
+    for (i = 0; i < m; i++) { Hs[i + j * m] = HALF * (H[i][j] + H[j][i]); }
+  }
+  chebSymEigBounds(m, Hs, &emin, &emax);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+  SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
+                     "SUNLinSolSolve_Chebyshev", "eig-estimate",
+                     "iters = %i, emin = %.16g, emax = %.16g", m, emin, emax);
+#endif
+
+  /* The polynomial is built for a positive interval */
+  if (emax <= ZERO) { return SUNLS_CONV_FAIL; }
+
+  CHEB_CONTENT(S)->lmax = SUNCHEBYSHEV_EIG_SAFETY * emax;
+  CHEB_CONTENT(S)->lmin = SUNMAX(emin, SUNCHEBYSHEV_EIG_RATIO_FLOOR *
+                                 CHEB_CONTENT(S)->lmax);
+  CHEB_CONTENT(S)->eig_needed = SUNFALSE;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Extreme eigenvalues of the n x n symmetric matrix A (column-major) by the
+ * cyclic Jacobi method. A is overwritten.
+ */
+
+static void chebSymEigBounds(int n, sunrealtype* A, sunrealtype* emin,
+                             sunrealtype* emax)
+{
+  int i, p, q, sweep;
+  sunrealtype off, total, app, aqq, apq, tau, t, c, s, aip, aiq;
+
+  for (sweep = 0; sweep < MAX_JACOBI_SWEEPS; sweep++)
+  {
+    /* stop when the off-diagonal part is negligible */
+    off   = ZERO;
+    total = ZERO;
+    for (q = 0; q < n; q++)
+    {
+      for (p = 0; p < n; p++)
+      {
+        total += A[p + q * n] * A[p + q * n];
+        if (p != q) { off += A[p + q * n] * A[p + q * n]; }
+      }
+    }
+    if (off <= SUN_UNIT_ROUNDOFF * SUN_UNIT_ROUNDOFF * total) { break; }
+
+    for (p = 0; p < n - 1; p++)
+    {
+      for (q = p + 1; q < n; q++)
+      {
+        apq = A[p + q * n];
+        if (apq == ZERO) { continue; }
+        app = A[p + p * n];
+        aqq = A[q + q * n];
+
+        /* rotation that zeros the (p,q) entry */
+        tau = (aqq - app) / (TWO * apq);
+        t   = ONE / (SUNRabs(tau) + SUNRsqrt(ONE + tau * tau));
+        if (tau < ZERO) { t = -t; }
+        c = ONE / SUNRsqrt(ONE + t * t);
+        s = t * c;
+
+        /* A = A J */
+        for (i = 0; i < n; i++)
+        {
+          aip          = A[i + p * n];
+          aiq          = A[i + q * n];
+          A[i + p * n] = c * aip - s * aiq;
+          A[i + q * n] = s * aip + c * aiq;
+        }
+
+        /* A = J^T A */
+        for (i = 0; i < n; i++)
+        {
+          aip          = A[p + i * n];
+          aiq          = A[q + i * n];
+          A[p + i * n] = c * aip - s * aiq;
+          A[q + i * n] = s * aip + c * aiq;
+        }
+      }
+    }
+  }
+
+  *emin = A[0];
+  *emax = A[0];
+  for (i = 1; i < n; i++)
+  {
+    *emin = SUNMIN(*emin, A[i + i * n]);
+    *emax = SUNMAX(*emax, A[i + i * n]);
+  }
+}
+
+/* ----------------------------------------------------------------------------
+ * Free the Arnoldi workspace
+ */
+
+static void chebFreeArnoldi(SUNLinearSolver S)
+{
+  int i;
+
+  if (CHEB_CONTENT(S)->V)
+  {
+    N_VDestroyVectorArray(CHEB_CONTENT(S)->V, CHEB_CONTENT(S)->maxeig + 1);
+    CHEB_CONTENT(S)->V = NULL;
+  }
+  if (CHEB_CONTENT(S)->H)
+  {
+    for (i = 0; i <= CHEB_CONTENT(S)->maxeig; i++)
+    {
+      free(CHEB_CONTENT(S)->H[i]);
+      CHEB_CONTENT(S)->H[i] = NULL;
+    }
+    free(CHEB_CONTENT(S)->H);
+    CHEB_CONTENT(S)->H = NULL;
+  }
+  if (CHEB_CONTENT(S)->Hsym)
+  {
+    free(CHEB_CONTENT(S)->Hsym);
+    CHEB_CONTENT(S)->Hsym = NULL;
+  }
+}
@@ -26,7 +26,9 @@
 #include "sundials_logger_impl.h"
 #include "sundials_macros.h"
 
-#define ONE SUN_RCONST(1.0)
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
 
 /*
  * -----------------------------------------------------------------
@@ -37,6 +39,27 @@
 #define DENSE_CONTENT(S) ((SUNLinearSolverContent_Dense)(S->content))
 #define PIVOTS(S)        (DENSE_CONTENT(S)->pivots)
 #define LASTFLAG(S)      (DENSE_CONTENT(S)->last_flag)
+#define NUMTHREADS(S)    (DENSE_CONTENT(S)->num_threads)
+#define MIXED(S)         (DENSE_CONTENT(S)->mixed)
+#define MAXREFINE(S)     (DENSE_CONTENT(S)->max_refine)
+#define DFACTORED(S)     (DENSE_CONTENT(S)->dfactored)
+#define SDATA(S)         (DENSE_CONTENT(S)->sdata)
+#define SCOLS(S)         (DENSE_CONTENT(S)->scols)
+#define RES(S)           (DENSE_CONTENT(S)->res)
+#define RTOL(S)          (DENSE_CONTENT(S)->rtol)
+#define LASTREFINE(S)    (DENSE_CONTENT(S)->last_refine)
+#define NUMREFINE(S)     (DENSE_CONTENT(S)->num_refine)
+#define NUMFALLBACK(S)   (DENSE_CONTENT(S)->num_fallback)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static sunbooleantype denseRefine(SUNLinearSolver S, sunrealtype** A_cols,
+                                  sunindextype n, sunrealtype* x,
+                                  sunrealtype* b);
 
 /*
  * -----------------------------------------------------------------
@@ -75,6 +98,7 @@ SUNLinearSolver SUNLinSol_Dense(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   S->ops->initialize = SUNLinSolInitialize_Dense;
   S->ops->setup      = SUNLinSolSetup_Dense;
   S->ops->solve      = SUNLinSolSolve_Dense;
+  S->ops->numiters   = SUNLinSolNumIters_Dense;
   S->ops->lastflag   = SUNLinSolLastFlag_Dense;
   S->ops->space      = SUNLinSolSpace_Dense;
   S->ops->free       = SUNLinSolFree_Dense;
@@ -88,9 +112,20 @@ SUNLinearSolver SUNLinSol_Dense(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   S->content = content;
 
   /* Fill content */
-  content->N         = MatrixRows;
-  content->last_flag = 0;
-  content->pivots    = NULL;
+  content->N            = MatrixRows;
+  content->last_flag    = 0;
+  content->pivots       = NULL;
+  content->num_threads  = 1;
+  content->mixed        = SUNFALSE;
+  content->max_refine   = 0;
+  content->dfactored    = SUNTRUE;
+  content->sdata        = NULL;
+  content->scols        = NULL;
+  content->res          = NULL;
+  content->rtol         = ZERO;
+  content->last_refine  = 0;
+  content->num_refine   = 0;
+  content->num_fallback = 0;
 
   /* Allocate content */
   content->pivots = (sunindextype*)malloc(MatrixRows * sizeof(sunindextype));
@@ -99,6 +134,68 @@ SUNLinearSolver SUNLinSol_Dense(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   return (S);
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used in the LU factorization
+ */
+
+SUNErrCode SUNLinSol_Dense_SetNumThreads(SUNLinearSolver S, int num_threads)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_DENSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_threads >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  NUMTHREADS(S) = num_threads;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to factor the matrix in single precision and refine the solutions
+ */
+
+SUNErrCode SUNLinSol_Dense_SetMixedPrecision(SUNLinearSolver S,
+                                             sunbooleantype onoff,
+                                             int max_refine)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_DENSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(max_refine >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  MIXED(S)     = onoff;
+  MAXREFINE(S) = max_refine;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to get the total numbers of refinement iterations and of
+ * factorizations in sunrealtype after a failure in single precision
+ */
+
+SUNErrCode SUNLinSol_Dense_GetNumRefinements(SUNLinearSolver S,
+                                             long int* num_refine)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_DENSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_refine, SUN_ERR_ARG_CORRUPT);
+
+  *num_refine = NUMREFINE(S);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_Dense_GetNumFallbacks(SUNLinearSolver S,
+                                           long int* num_fallback)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_DENSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_fallback, SUN_ERR_ARG_CORRUPT);
+
+  *num_fallback = NUMFALLBACK(S);
+
+  return SUN_SUCCESS;
+}
+
 /*
  * -----------------------------------------------------------------
  * implementation of linear solver operations
@@ -125,8 +222,9 @@ SUNErrCode SUNLinSolInitialize_Dense(SUNLinearSolver S)
 int SUNLinSolSetup_Dense(SUNLinearSolver S, SUNMatrix A)
 {
   SUNFunctionBegin(S->sunctx);
-  sunrealtype** A_cols;
+  sunrealtype **A_cols, *col_j, anorm;
   sunindextype* pivots;
+  sunindextype i, j, n;
 
   SUNAssert(A, SUN_ERR_ARG_CORRUPT);
   SUNAssert(SUNMatGetID(A) == SUNMATRIX_DENSE, SUN_ERR_ARG_WRONGTYPE);
@@ -139,9 +237,52 @@ int SUNLinSolSetup_Dense(SUNLinearSolver S, SUNMatrix A)
   SUNAssert(pivots, SUN_ERR_ARG_CORRUPT);
   SUNAssert(A_cols, SUN_ERR_ARG_CORRUPT);
 
+  /* in mixed precision, factor a single precision copy of A and keep A for
+     the residuals of the refinement */
+  if (MIXED(S))
+  {
+    n = DENSE_CONTENT(S)->N;
+
+    if (SDATA(S) == NULL)
+    {
+      SDATA(S) = (float*)malloc(n * n * sizeof(float));
+      SCOLS(S) = (float**)malloc(n * sizeof(float*));
+      RES(S)   = (sunrealtype*)malloc(n * sizeof(sunrealtype));
+      SUNAssert(SDATA(S) && SCOLS(S) && RES(S), SUN_ERR_MALLOC_FAIL);
+      for (j = 0; j < n; j++) { SCOLS(S)[j] = SDATA(S) + j * n; }
+    }
+
+    /* copy A and compute its infinity norm from the row sums */
+    for (i = 0; i < n; i++) { RES(S)[i] = ZERO; }
+    for (j = 0; j < n; j++)
+    {
+      col_j = A_cols[j];
+      for (i = 0; i < n; i++)
+      {
+        SCOLS(S)[j][i] = (float)col_j[i];
+        RES(S)[i] += SUNRabs(col_j[i]);
+      }
+    }
+    anorm = ZERO;
+    for (i = 0; i < n; i++) { anorm = SUNMAX(anorm, RES(S)[i]); }
+    RTOL(S) = SUNRsqrt((sunrealtype)n) * SUN_UNIT_ROUNDOFF * anorm;
+
+    LASTFLAG(S) = SUNDlsMat_denseSGETRF(SCOLS(S), n, n, pivots, NUMTHREADS(S));
+    if (LASTFLAG(S) == 0)
+    {
+      DFACTORED(S) = SUNFALSE;
+      return SUN_SUCCESS;
+    }
+
+    /* the copy is singular in single precision, factor A instead */
+    NUMFALLBACK(S)++;
+  }
+  DFACTORED(S) = SUNTRUE;
+
   /* perform LU factorization of input matrix */
-  LASTFLAG(S) = SUNDlsMat_denseGETRF(A_cols, SUNDenseMatrix_Rows(A),
-                                     SUNDenseMatrix_Columns(A), pivots);
+  LASTFLAG(S) = SUNDlsMat_denseGETRFThreads(A_cols, SUNDenseMatrix_Rows(A),
+                                            SUNDenseMatrix_Columns(A), pivots,
+                                            NUMTHREADS(S));
 
   /* store error flag (if nonzero, this row encountered zero-valued pivod) */
   if (LASTFLAG(S) > 0) { return (SUNLS_LUFACT_FAIL); }
@@ -152,9 +293,11 @@ int SUNLinSolSolve_Dense(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
                          SUNDIALS_MAYBE_UNUSED sunrealtype tol)
 {
   SUNFunctionBegin(S->sunctx);
-  sunrealtype **A_cols, *xdata;
+  sunrealtype **A_cols, *xdata, *bdata;
   sunindextype* pivots;
 
+  LASTREFINE(S) = 0;
+
   /* copy b into x */
   N_VScale(ONE, b, x);
   SUNCheckLastErr();
@@ -173,12 +316,43 @@ int SUNLinSolSolve_Dense(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   SUNAssert(xdata, SUN_ERR_ARG_CORRUPT);
   SUNAssert(pivots, SUN_ERR_ARG_CORRUPT);
 
+  /* solve with the single precision factors and refine the solution */
+  if (!DFACTORED(S))
+  {
+    bdata = N_VGetArrayPointer(b);
+    SUNCheckLastErr();
+    SUNAssert(bdata, SUN_ERR_ARG_CORRUPT);
+
+    if (denseRefine(S, A_cols, SUNDenseMatrix_Rows(A), xdata, bdata))
+    {
+      LASTFLAG(S) = SUN_SUCCESS;
+      return SUN_SUCCESS;
+    }
+
+    /* the refinement did not converge, factor A in sunrealtype */
+    NUMFALLBACK(S)++;
+    DFACTORED(S) = SUNTRUE;
+    LASTFLAG(S)  = SUNDlsMat_denseGETRFThreads(A_cols, SUNDenseMatrix_Rows(A),
+                                               SUNDenseMatrix_Columns(A),
+                                               pivots, NUMTHREADS(S));
+    if (LASTFLAG(S) > 0) { return (SUNLS_LUFACT_FAIL); }
+
+    N_VScale(ONE, b, x);
+    SUNCheckLastErr();
+  }
+
   /* solve using LU factors */
   SUNDlsMat_denseGETRS(A_cols, SUNDenseMatrix_Rows(A), pivots, xdata);
   LASTFLAG(S) = SUN_SUCCESS;
   return SUN_SUCCESS;
 }
 
+int SUNLinSolNumIters_Dense(SUNLinearSolver S)
+{
+  /* return the number of refinement iterations in the last solve */
+  return (LASTREFINE(S));
+}
+
 sunindextype SUNLinSolLastFlag_Dense(SUNLinearSolver S)
 {
   /* return the stored 'last_flag' value */
@@ -192,6 +366,14 @@ SUNErrCode SUNLinSolSpace_Dense(SUNLinearSolver S, long int* lenrwLS,
   SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_DENSE, SUN_ERR_ARG_WRONGTYPE);
   *leniwLS = 2 + DENSE_CONTENT(S)->N;
   *lenrwLS = 0;
+  if (SDATA(S))
+  {
+    /* single precision factors and residual */
+    *lenrwLS = DENSE_CONTENT(S)->N +
+               (DENSE_CONTENT(S)->N * DENSE_CONTENT(S)->N * sizeof(float) +
+                sizeof(sunrealtype) - 1) /
+                 sizeof(sunrealtype);
+  }
   return SUN_SUCCESS;
 }
 
@@ -208,6 +390,9 @@ SUNErrCode SUNLinSolFree_Dense(SUNLinearSolver S)
       free(PIVOTS(S));
       PIVOTS(S) = NULL;
     }
+    free(SDATA(S));
+    free(SCOLS(S));
+    free(RES(S));
     free(S->content);
     S->content = NULL;
   }
@@ -220,3 +405,61 @@ SUNErrCode SUNLinSolFree_Dense(SUNLinearSolver S)
   S = NULL;
   return SUN_SUCCESS;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Solve with the single precision factors and refine the solution x, which
+ * holds b on input, with residuals computed in sunrealtype. Returns SUNFALSE
+ * if the residual does not meet the tolerance within max_refine iterations or
+ * is not at least halved by an iteration.
+ */
+
+static sunbooleantype denseRefine(SUNLinearSolver S, sunrealtype** A_cols,
+                                  sunindextype n, sunrealtype* x,
+                                  sunrealtype* b)
+{
+  sunindextype i;
+  sunrealtype *r, rnorm, rnorm_old, xnorm;
+  int iter;
+
+  r = RES(S);
+
+  SUNDlsMat_denseSGETRS(SCOLS(S), n, PIVOTS(S), x);
+
+  rnorm_old = SUN_BIG_REAL;
+  for (iter = 0;; iter++)
+  {
+    /* r = b - A x */
+    SUNDlsMat_denseMatvec(A_cols, x, r, n, n);
+    rnorm = ZERO;
+    xnorm = ZERO;
+    for (i = 0; i < n; i++)
+    {
+      r[i]  = b[i] - r[i];
+      rnorm = SUNMAX(rnorm, SUNRabs(r[i]));
+      xnorm = SUNMAX(xnorm, SUNRabs(x[i]));
+    }
+
+    if (rnorm <= RTOL(S) * xnorm) { break; }
+    if (iter == MAXREFINE(S) || rnorm > HALF * rnorm_old)
+    {
+      LASTREFINE(S) = iter;
+      NUMREFINE(S) += iter;
+      return SUNFALSE;
+    }
+    rnorm_old = rnorm;
+
+    /* x = x + (LU)^{-1} r */
+    SUNDlsMat_denseSGETRS(SCOLS(S), n, PIVOTS(S), r);
+    for (i = 0; i < n; i++) { x[i] += r[i]; }
+  }
+
+  LASTREFINE(S) = iter;
+  NUMREFINE(S) += iter;
+  return SUNTRUE;
+}
@@ -0,0 +1,1729 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the GCRO-DR implementation of
+ * the SUNLINSOL package.
+ *
+ * Each cycle of the method solves the least squares problem
+ *
+ *   min || r - A-tilde [U, V_m] y ||,
+ *
+ * where C = A-tilde U is an orthonormal basis of the image of the
+ * recycled subspace U and V_(m+1) is the Arnoldi basis of the Krylov
+ * subspace of (I - C C^T) A-tilde generated from the residual r,
+ * which is orthogonal to C. With the columns of U scaled to unit norm,
+ * A-tilde U = C D for a diagonal matrix D and the Arnoldi relation
+ *
+ *   A-tilde [U, V_m] = [C, V_(m+1)] G,  G = [ D  B ]
+ *                                          [ 0  H ],
+ *
+ * where B = C^T A-tilde V_m and H is the upper Hessenberg matrix,
+ * makes G upper Hessenberg, so the residual norm of the least squares
+ * problem is updated with Givens rotations as in GMRES. At the end of
+ * each cycle, U is replaced by the harmonic Ritz vectors of A-tilde
+ * with respect to the span of [U, V_m] of smallest harmonic Ritz
+ * values. At the start of each solve, C is recomputed from U, so the
+ * recycled subspace remains valid when A-tilde changes between
+ * solves, e.g. with the step size of an integrator.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_dense.h>
+#include <sundials/sundials_direct.h>
+#include <sundials/sundials_math.h>
+#include <sunlinsol/sunlinsol_gcrodr.h>
+
+#include "sundials_logger_impl.h"
+#include "sundials_macros.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+
+/* length of the workspace for the harmonic Ritz vectors */
+#define GCRODR_WORK_LEN(maxl, kdim)                            \
+  (3 * (maxl) * (maxl) + 6 * (maxl) + (2 * (maxl) + 1) * (kdim) + \
+   (kdim) * (kdim))
+
+/*
+ * -----------------------------------------------------------------
+ * GCRODR solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define GCRODR_CONTENT(S) ((SUNLinearSolverContent_GCRODR)(S->content))
+#define LASTFLAG(S)       (GCRODR_CONTENT(S)->last_flag)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static int gcrodrATilde(SUNLinearSolver S, N_Vector v, N_Vector w,
+                        sunrealtype delta);
+static int gcrodrRecomputeC(SUNLinearSolver S, sunrealtype delta);
+static SUNErrCode gcrodrOrthRecycle(SUNLinearSolver S, int kc);
+static int gcrodrUpdateRecycle(SUNLinearSolver S, int kc, int n);
+static int gcrodrCorrect(SUNLinearSolver S, N_Vector x, sunrealtype delta);
+static int gcrodrEigvec(int n, sunrealtype* T, sunrealtype** E,
+                        sunindextype* piv, sunrealtype wr, sunrealtype wi,
+                        sunrealtype tnorm, sunrealtype* z);
+static void gcrodrHessReduce(int n, sunrealtype* h, sunrealtype* v);
+static int gcrodrHessEig(int n, sunrealtype* h, sunrealtype* wr,
+                         sunrealtype* wi);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new GCRO-DR linear solver
+ */
+
+SUNLinearSolver SUNLinSol_GCRODR(N_Vector y, int pretype, int maxl, int kdim,
+                                 SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  SUNLinearSolver S;
+  SUNLinearSolverContent_GCRODR content;
+
+  /* check for legal pretype, maxl and kdim values; if illegal use defaults */
+  if ((pretype != SUN_PREC_NONE) && (pretype != SUN_PREC_LEFT) &&
+      (pretype != SUN_PREC_RIGHT) && (pretype != SUN_PREC_BOTH))
+  {
+    pretype = SUN_PREC_NONE;
+  }
+  if (maxl <= 0) { maxl = SUNGCRODR_MAXL_DEFAULT; }
+  if (kdim < 0) { kdim = SUNGCRODR_KDIM_DEFAULT; }
+
+  /* check that the supplied N_Vector supports all requisite operations */
+  SUNAssertNull((y->ops->nvclone) && (y->ops->nvdestroy) &&
+                  (y->ops->nvlinearsum) && (y->ops->nvconst) && (y->ops->nvprod) &&
+                  (y->ops->nvdiv) && (y->ops->nvscale) && (y->ops->nvdotprod),
+                SUN_ERR_ARG_OUTOFRANGE);
+
+  /* Create linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+  S->ops->gettype           = SUNLinSolGetType_GCRODR;
+  S->ops->getid             = SUNLinSolGetID_GCRODR;
+  S->ops->setatimes         = SUNLinSolSetATimes_GCRODR;
+  S->ops->setpreconditioner = SUNLinSolSetPreconditioner_GCRODR;
+  S->ops->setscalingvectors = SUNLinSolSetScalingVectors_GCRODR;
+  S->ops->setzeroguess      = SUNLinSolSetZeroGuess_GCRODR;
+  S->ops->initialize        = SUNLinSolInitialize_GCRODR;
+  S->ops->setup             = SUNLinSolSetup_GCRODR;
+  S->ops->solve             = SUNLinSolSolve_GCRODR;
+  S->ops->numiters          = SUNLinSolNumIters_GCRODR;
+  S->ops->resnorm           = SUNLinSolResNorm_GCRODR;
+  S->ops->resid             = SUNLinSolResid_GCRODR;
+  S->ops->lastflag          = SUNLinSolLastFlag_GCRODR;
+  S->ops->space             = SUNLinSolSpace_GCRODR;
+  S->ops->free              = SUNLinSolFree_GCRODR;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_GCRODR)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content */
+  content->last_flag    = 0;
+  content->maxl         = maxl;
+  content->kdim         = kdim;
+  content->pretype      = pretype;
+  content->gstype       = SUNGCRODR_GSTYPE_DEFAULT;
+  content->max_restarts = SUNGCRODR_MAXRS_DEFAULT;
+  content->zeroguess    = SUNFALSE;
+  content->numiters     = 0;
+  content->resnorm      = ZERO;
+  content->xcor         = NULL;
+  content->vtemp        = NULL;
+  content->s1           = NULL;
+  content->s2           = NULL;
+  content->ATimes       = NULL;
+  content->ATData       = NULL;
+  content->Psetup       = NULL;
+  content->Psolve       = NULL;
+  content->PData        = NULL;
+  content->V            = NULL;
+  content->U            = NULL;
+  content->Utmp         = NULL;
+  content->Ctmp         = NULL;
+  content->nrecycled    = 0;
+  content->dvals        = NULL;
+  content->Hes          = NULL;
+  content->Gcopy        = NULL;
+  content->givens       = NULL;
+  content->yg           = NULL;
+  content->cv           = NULL;
+  content->Xv           = NULL;
+  content->work         = NULL;
+  content->Eig          = NULL;
+  content->pivots       = NULL;
+
+  /* Allocate content */
+  content->xcor = N_VClone(y);
+  SUNCheckLastErrNull();
+  content->vtemp = N_VClone(y);
+  SUNCheckLastErrNull();
+
+  return (S);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the type of preconditioning for GCRO-DR to use
+ */
+
+SUNErrCode SUNLinSol_GCRODRSetPrecType(SUNLinearSolver S, int pretype)
+{
+  SUNFunctionBegin(S->sunctx);
+  /* Check for legal pretype */
+  SUNAssert((pretype == SUN_PREC_NONE) || (pretype == SUN_PREC_LEFT) ||
+              (pretype == SUN_PREC_RIGHT) || (pretype == SUN_PREC_BOTH),
+            SUN_ERR_ARG_OUTOFRANGE);
+
+  /* Set pretype */
+  GCRODR_CONTENT(S)->pretype = pretype;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the type of Gram-Schmidt orthogonalization for GCRO-DR to
+ * use
+ */
+
+SUNErrCode SUNLinSol_GCRODRSetGSType(SUNLinearSolver S, int gstype)
+{
+  SUNFunctionBegin(S->sunctx);
+  /* Check for legal gstype */
+  SUNAssert(gstype == SUN_MODIFIED_GS || gstype == SUN_CLASSICAL_GS,
+            SUN_ERR_ARG_OUTOFRANGE);
+
+  /* Set gstype */
+  GCRODR_CONTENT(S)->gstype = gstype;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the maximum number of GCRO-DR restarts to allow
+ */
+
+SUNErrCode SUNLinSol_GCRODRSetMaxRestarts(SUNLinearSolver S, int maxrs)
+{
+  /* Illegal maxrs implies use of default value */
+  if (maxrs < 0) { maxrs = SUNGCRODR_MAXRS_DEFAULT; }
+
+  /* Set max_restarts */
+  GCRODR_CONTENT(S)->max_restarts = maxrs;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to get the current dimension of the recycled subspace
+ */
+
+SUNErrCode SUNLinSol_GCRODRGetNumRecycled(SUNLinearSolver S, int* nrecycled)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(nrecycled, SUN_ERR_ARG_CORRUPT);
+  *nrecycled = GCRODR_CONTENT(S)->nrecycled;
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_GCRODR(SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_ITERATIVE);
+}
+
+SUNLinearSolver_ID SUNLinSolGetID_GCRODR(SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_GCRODR);
+}
+
+SUNErrCode SUNLinSolInitialize_GCRODR(SUNLinearSolver S)
+{
+  int k, mdim;
+  SUNLinearSolverContent_GCRODR content;
+  SUNFunctionBegin(S->sunctx);
+
+  /* set shortcut to GCRODR memory structure */
+  content = GCRODR_CONTENT(S);
+
+  /* ensure valid options */
+  if (content->max_restarts < 0)
+  {
+    content->max_restarts = SUNGCRODR_MAXRS_DEFAULT;
+  }
+
+  SUNAssert(content->ATimes, SUN_ERR_ARG_CORRUPT);
+
+  if ((content->pretype != SUN_PREC_LEFT) &&
+      (content->pretype != SUN_PREC_RIGHT) && (content->pretype != SUN_PREC_BOTH))
+  {
+    content->pretype = SUN_PREC_NONE;
+  }
+
+  SUNAssert((content->pretype == SUN_PREC_NONE) || (content->Psolve != NULL),
+            SUN_ERR_ARG_CORRUPT);
+
+  /* allocate solver-specific memory (where the size depends on the
+     choice of maxl and kdim) here */
+
+  /*   Recycled subspace and Krylov subspace vectors, each cycle holds up to
+       kdim recycled and maxl Arnoldi vectors */
+  mdim = content->maxl + content->kdim;
+  if (content->V == NULL)
+  {
+    content->V = N_VCloneVectorArray(mdim + 1, content->vtemp);
+    SUNCheckLastErr();
+  }
+
+  if (content->kdim > 0 && content->U == NULL)
+  {
+    content->U = N_VCloneVectorArray(content->kdim, content->vtemp);
+    SUNCheckLastErr();
+    content->Utmp = N_VCloneVectorArray(content->kdim, content->vtemp);
+    SUNCheckLastErr();
+    content->Ctmp = N_VCloneVectorArray(content->kdim, content->vtemp);
+    SUNCheckLastErr();
+    content->dvals = (sunrealtype*)malloc(content->kdim * sizeof(sunrealtype));
+    SUNAssert(content->dvals, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /*   Hessenberg matrix Hes and its copy */
+  if (content->Hes == NULL)
+  {
+    content->Hes = (sunrealtype**)malloc((mdim + 1) * sizeof(sunrealtype*));
+    SUNAssert(content->Hes, SUN_ERR_MALLOC_FAIL);
+
+    for (k = 0; k <= mdim; k++)
+    {
+      content->Hes[k] = NULL;
+      content->Hes[k] = (sunrealtype*)malloc(mdim * sizeof(sunrealtype));
+      SUNAssert(content->Hes[k], SUN_ERR_MALLOC_FAIL);
+    }
+  }
+
+  if (content->Gcopy == NULL)
+  {
+    content->Gcopy =
+      (sunrealtype*)malloc((mdim + 1) * mdim * sizeof(sunrealtype));
+    SUNAssert(content->Gcopy, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /*   Givens rotation components */
+  if (content->givens == NULL)
+  {
+    content->givens = (sunrealtype*)malloc(2 * mdim * sizeof(sunrealtype));
+    SUNAssert(content->givens, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /*    y and g vectors */
+  if (content->yg == NULL)
+  {
+    content->yg = (sunrealtype*)malloc((mdim + 1) * sizeof(sunrealtype));
+    SUNAssert(content->yg, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /*    cv vector for fused vector ops */
+  if (content->cv == NULL)
+  {
+    content->cv = (sunrealtype*)malloc((mdim + 1) * sizeof(sunrealtype));
+    SUNAssert(content->cv, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /*    Xv vector for fused vector ops */
+  if (content->Xv == NULL)
+  {
+    content->Xv = (N_Vector*)malloc((mdim + 1) * sizeof(N_Vector));
+    SUNAssert(content->Xv, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /*    workspace for the harmonic Ritz vectors */
+  if (content->kdim > 0 && content->work == NULL)
+  {
+    content->work = (sunrealtype*)malloc(GCRODR_WORK_LEN(mdim, content->kdim) *
+                                         sizeof(sunrealtype));
+    SUNAssert(content->work, SUN_ERR_MALLOC_FAIL);
+    content->Eig = SUNDlsMat_newDenseMat(2 * mdim, 2 * mdim);
+    SUNAssert(content->Eig, SUN_ERR_MALLOC_FAIL);
+    content->pivots = SUNDlsMat_newIndexArray(2 * mdim);
+    SUNAssert(content->pivots, SUN_ERR_MALLOC_FAIL);
+  }
+
+  /* discard the recycled subspace */
+  content->nrecycled = 0;
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolSetATimes_GCRODR(SUNLinearSolver S, void* ATData,
+                                     SUNATimesFn ATimes)
+{
+  /* set function pointers to integrator-supplied ATimes routine
+     and data, and return with success */
+  GCRODR_CONTENT(S)->ATimes = ATimes;
+  GCRODR_CONTENT(S)->ATData = ATData;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolSetPreconditioner_GCRODR(SUNLinearSolver S, void* PData,
+                                             SUNPSetupFn Psetup,
+                                             SUNPSolveFn Psolve)
+{
+  /* set function pointers to integrator-supplied Psetup and PSolve
+     routines and data, and return with success */
+  GCRODR_CONTENT(S)->Psetup = Psetup;
+  GCRODR_CONTENT(S)->Psolve = Psolve;
+  GCRODR_CONTENT(S)->PData  = PData;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolSetScalingVectors_GCRODR(SUNLinearSolver S, N_Vector s1,
+                                             N_Vector s2)
+{
+  /* set N_Vector pointers to integrator-supplied scaling vectors,
+     and return with success */
+  GCRODR_CONTENT(S)->s1 = s1;
+  GCRODR_CONTENT(S)->s2 = s2;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolSetZeroGuess_GCRODR(SUNLinearSolver S, sunbooleantype onff)
+{
+  /* set flag indicating a zero initial guess */
+  GCRODR_CONTENT(S)->zeroguess = onff;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSetup_GCRODR(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A)
+{
+  SUNFunctionBegin(S->sunctx);
+
+  int status = SUN_SUCCESS;
+
+  /* Set shortcuts to GCRODR memory structures */
+  SUNPSetupFn Psetup = GCRODR_CONTENT(S)->Psetup;
+  void* PData        = GCRODR_CONTENT(S)->PData;
+
+  /* no solver-specific setup is required, the image of the recycled
+     subspace is recomputed in each solve, but if user-supplied Psetup
+     routine exists, call that here */
+  if (Psetup != NULL)
+  {
+    status = Psetup(PData);
+    if (status != 0)
+    {
+      LASTFLAG(S) = (status < 0) ? SUNLS_PSET_FAIL_UNREC : SUNLS_PSET_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+  }
+
+  /* return with success */
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSolve_GCRODR(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A,
+                          N_Vector x, N_Vector b, sunrealtype delta)
+{
+  SUNFunctionBegin(S->sunctx);
+
+  /* local data and shortcut variables */
+  N_Vector *V, *U, xcor, vtemp, s1;
+  sunrealtype **Hes, *Gcopy, *givens, *yg, *dvals, *res_norm;
+  sunrealtype beta, rotation_product, r_norm, s_product, rho;
+  sunbooleantype preOnLeft, converged;
+  sunbooleantype* zeroguess;
+  int i, j, k, l, l_plus_1, l_max, mdim, kc, krydim, ntries, max_restarts;
+  int gstype;
+  int* nli;
+  void *A_data, *P_data;
+  SUNATimesFn atimes;
+  SUNPSolveFn psolve;
+  sunrealtype* cv;
+  N_Vector* Xv;
+  int status;
+
+  /* Initialize some variables */
+  l_plus_1 = 0;
+  krydim   = 0;
+
+  /* Make local shorcuts to solver variables. */
+  mdim         = GCRODR_CONTENT(S)->maxl + GCRODR_CONTENT(S)->kdim;
+  max_restarts = GCRODR_CONTENT(S)->max_restarts;
+  gstype       = GCRODR_CONTENT(S)->gstype;
+  V            = GCRODR_CONTENT(S)->V;
+  Hes          = GCRODR_CONTENT(S)->Hes;
+  Gcopy        = GCRODR_CONTENT(S)->Gcopy;
+  givens       = GCRODR_CONTENT(S)->givens;
+  dvals        = GCRODR_CONTENT(S)->dvals;
+  xcor         = GCRODR_CONTENT(S)->xcor;
+  yg           = GCRODR_CONTENT(S)->yg;
+  vtemp        = GCRODR_CONTENT(S)->vtemp;
+  s1           = GCRODR_CONTENT(S)->s1;
+  A_data       = GCRODR_CONTENT(S)->ATData;
+  P_data       = GCRODR_CONTENT(S)->PData;
+  atimes       = GCRODR_CONTENT(S)->ATimes;
+  psolve       = GCRODR_CONTENT(S)->Psolve;
+  zeroguess    = &(GCRODR_CONTENT(S)->zeroguess);
+  nli          = &(GCRODR_CONTENT(S)->numiters);
+  res_norm     = &(GCRODR_CONTENT(S)->resnorm);
+  cv           = GCRODR_CONTENT(S)->cv;
+  Xv           = GCRODR_CONTENT(S)->Xv;
+
+  /* Initialize counters and convergence flag */
+  *nli      = 0;
+  converged = SUNFALSE;
+
+  /* Set sunbooleantype flags for internal solver options */
+  preOnLeft = ((GCRODR_CONTENT(S)->pretype == SUN_PREC_LEFT) ||
+               (GCRODR_CONTENT(S)->pretype == SUN_PREC_BOTH));
+
+  /* Check if Atimes function has been set */
+  SUNAssert(atimes, SUN_ERR_ARG_CORRUPT);
+
+  /* If preconditioning, check if psolve has been set */
+  SUNAssert(GCRODR_CONTENT(S)->pretype == SUN_PREC_NONE || psolve,
+            SUN_ERR_ARG_CORRUPT);
+
+  /* Set vtemp and V[0] to initial (unscaled) residual r_0 = b - A*x_0 */
+  if (*zeroguess)
+  {
+    N_VScale(ONE, b, vtemp);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    status = atimes(A_data, x, vtemp);
+    if (status != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = (status < 0) ? SUNLS_ATIMES_FAIL_UNREC
+                                 : SUNLS_ATIMES_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+    N_VLinearSum(ONE, b, -ONE, vtemp, vtemp);
+    SUNCheckLastErr();
+  }
+  N_VScale(ONE, vtemp, V[0]);
+  SUNCheckLastErr();
+
+  /* Apply left preconditioner and left scaling to V[0] = r_0 */
+  if (preOnLeft)
+  {
+    status = psolve(P_data, V[0], vtemp, delta, SUN_PREC_LEFT);
+    if (status != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = (status < 0) ? SUNLS_PSOLVE_FAIL_UNREC
+                                 : SUNLS_PSOLVE_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+  }
+  else
+  {
+    N_VScale(ONE, V[0], vtemp);
+    SUNCheckLastErr();
+  }
+
+  if (s1 != NULL)
+  {
+    N_VProd(s1, vtemp, V[0]);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    N_VScale(ONE, vtemp, V[0]);
+    SUNCheckLastErr();
+  }
+
+  /* Set r_norm = beta to L2 norm of V[0] = s1 P1_inv r_0, and
+     return if small  */
+  r_norm = N_VDotProd(V[0], V[0]);
+  SUNCheckLastErr();
+  *res_norm = r_norm = beta = SUNRsqrt(r_norm);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+  SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
+                     "SUNLinSolSolve_GCRODR", "initial-residual",
+                     "nli = %li, resnorm = %.16g", (long int)0, *res_norm);
+#endif
+
+  if (r_norm <= delta)
+  {
+    *zeroguess  = SUNFALSE;
+    LASTFLAG(S) = SUN_SUCCESS;
+    return (LASTFLAG(S));
+  }
+
+  /* Set xcor = 0, or if a subspace is recycled, compute its image C for the
+     current system and set xcor = U C^T r_0 and r = (I - C C^T) r_0 in
+     V[kc], where kc is the dimension of the recycled subspace */
+  kc = GCRODR_CONTENT(S)->nrecycled;
+  if (kc > 0)
+  {
+    N_VScale(ONE, V[0], xcor);
+    SUNCheckLastErr();
+
+    status = gcrodrRecomputeC(S, delta);
+    if (status != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = status;
+      return (LASTFLAG(S));
+    }
+    kc = GCRODR_CONTENT(S)->nrecycled;
+    U  = GCRODR_CONTENT(S)->U;
+
+    if (kc > 0)
+    {
+      SUNCheckCall(N_VDotProdMulti(kc, xcor, V, cv + 1));
+      cv[0] = ONE;
+      Xv[0] = xcor;
+      for (i = 0; i < kc; i++)
+      {
+        yg[i]     = cv[i + 1] / dvals[i];
+        cv[i + 1] = -cv[i + 1];
+        Xv[i + 1] = V[i];
+      }
+      SUNCheckCall(N_VLinearCombination(kc + 1, cv, Xv, V[kc]));
+      SUNCheckCall(N_VLinearCombination(kc, yg, U, xcor));
+
+      r_norm = N_VDotProd(V[kc], V[kc]);
+      SUNCheckLastErr();
+      *res_norm = r_norm = SUNRsqrt(r_norm);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+      SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
+                         "SUNLinSolSolve_GCRODR", "recycled-residual",
+                         "nrecycled = %i, resnorm = %.16g", kc, *res_norm);
+#endif
+    }
+    else
+    {
+      N_VScale(ONE, xcor, V[0]);
+      SUNCheckLastErr();
+      N_VConst(ZERO, xcor);
+      SUNCheckLastErr();
+    }
+  }
+  else
+  {
+    N_VConst(ZERO, xcor);
+    SUNCheckLastErr();
+  }
+
+  /* Initialize rho to avoid compiler warning message */
+  rho       = r_norm;
+  converged = (r_norm <= delta);
+
+  /* Begin outer iterations: up to (max_restarts + 1) attempts */
+  for (ntries = 0; !converged && ntries <= max_restarts; ntries++)
+  {
+    /* Initialize the matrix G, with the scaling of the recycled vectors in
+       its first kc columns, its copy, and its QR factorization and the Givens
+       rotation product. Normalize the initial vector V[kc] */
+    kc    = GCRODR_CONTENT(S)->nrecycled;
+    U     = GCRODR_CONTENT(S)->U;
+    l_max = kc + GCRODR_CONTENT(S)->maxl;
+    for (i = 0; i <= l_max; i++)
+    {
+      for (j = 0; j < l_max; j++)
+      {
+        Hes[i][j]           = ZERO;
+        Gcopy[i * mdim + j] = ZERO;
+      }
+    }
+    for (i = 0; i < kc; i++)
+    {
+      Hes[i][i]           = dvals[i];
+      Gcopy[i * mdim + i] = dvals[i];
+    }
+    if (kc > 0 && SUNQRfact(kc, Hes, givens, 0) != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = SUNLS_QRFACT_FAIL;
+      return (LASTFLAG(S));
+    }
+
+    rotation_product = ONE;
+    N_VScale(ONE / r_norm, V[kc], V[kc]);
+    SUNCheckLastErr();
+
+    /* Inner loop: generate Krylov sequence and Arnoldi basis of
+       (I - C C^T) A-tilde */
+    for (l = kc; l < l_max; l++)
+    {
+      (*nli)++;
+      krydim = l_plus_1 = l + 1;
+
+      /* Generate A-tilde V[l], where A-tilde = s1 P1_inv A P2_inv s2_inv */
+      status = gcrodrATilde(S, V[l], V[l_plus_1], delta);
+      if (status != 0)
+      {
+        *zeroguess  = SUNFALSE;
+        LASTFLAG(S) = status;
+        return (LASTFLAG(S));
+      }
+
+      /*  Orthogonalize V[l+1] against C and previous V[i]: V[l+1] = w_tilde,
+          column l of G holds C^T A-tilde V[l] above the Hessenberg entries.
+          The solution is sensitive to a loss of orthogonality against C, so
+          classical Gram-Schmidt always makes a second pass */
+      if (gstype == SUN_CLASSICAL_GS)
+      {
+        SUNCheckCall(
+          SUNClassicalGS(V, Hes, l_plus_1, mdim, &(Hes[l_plus_1][l]), cv, Xv));
+
+        SUNCheckCall(N_VDotProdMulti(l_plus_1, V[l_plus_1], V, cv + 1));
+        cv[0] = ONE;
+        Xv[0] = V[l_plus_1];
+        for (i = 0; i <= l; i++)
+        {
+          Hes[i][l] += cv[i + 1];
+          cv[i + 1] = -cv[i + 1];
+          Xv[i + 1] = V[i];
+        }
+        SUNCheckCall(N_VLinearCombination(l_plus_1 + 1, cv, Xv, V[l_plus_1]));
+
+        Hes[l_plus_1][l] = N_VDotProd(V[l_plus_1], V[l_plus_1]);
+        SUNCheckLastErr();
+        Hes[l_plus_1][l] = SUNRsqrt(Hes[l_plus_1][l]);
+      }
+      else
+      {
+        SUNCheckCall(SUNModifiedGS(V, Hes, l_plus_1, mdim, &(Hes[l_plus_1][l])));
+      }
+      for (i = 0; i <= l_plus_1; i++) { Gcopy[i * mdim + l] = Hes[i][l]; }
+
+      /*  Update the QR factorization of G */
+      if (SUNQRfact(krydim, Hes, givens, l) != 0)
+      {
+        *zeroguess  = SUNFALSE;
+        LASTFLAG(S) = SUNLS_QRFACT_FAIL;
+        return (LASTFLAG(S));
+      }
+
+      /*  Update residual norm estimate */
+      rotation_product *= givens[2 * l + 1];
+      *res_norm = rho = SUNRabs(rotation_product * r_norm);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
+      SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
+                         "SUNLinSolSolve_GCRODR", "iterate-residual",
+                         "nli = %li, resnorm = %.16g", (long int)*nli, *res_norm);
+#endif
+
+      /* Normalize V[l+1] with norm value from the Gram-Schmidt routine, also
+         after convergence as the recycled subspace is built from it */
+      if (Gcopy[l_plus_1 * mdim + l] != ZERO)
+      {
+        N_VScale(ONE / Gcopy[l_plus_1 * mdim + l], V[l_plus_1], V[l_plus_1]);
+        SUNCheckLastErr();
+      }
+
+      /* Break if convergence test passes */
+      if (rho <= delta)
+      {
+        converged = SUNTRUE;
+        break;
+      }
+    }
+
+    /* Inner loop is done.  Compute the new correction vector xcor */
+
+    /*   Construct g, then solve for y */
+    for (i = 0; i <= krydim; i++) { yg[i] = ZERO; }
+    yg[kc] = r_norm;
+    if (SUNQRsol(krydim, Hes, givens, yg) != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = SUNLS_QRSOL_FAIL;
+      return (LASTFLAG(S));
+    }
+
+    /*   Add correction vector [U, V_l] y to xcor */
+    cv[0] = ONE;
+    Xv[0] = xcor;
+
+    for (k = 0; k < krydim; k++)
+    {
+      cv[k + 1] = yg[k];
+      Xv[k + 1] = (k < kc) ? U[k] : V[k];
+    }
+    SUNCheckCall(N_VLinearCombination(krydim + 1, cv, Xv, xcor));
+
+    /* If a restart follows, compute the residual vector in vtemp from the
+       last column of Q, it is orthogonal to the next recycled subspace */
+    if (!converged && ntries < max_restarts)
+    {
+      s_product = ONE;
+      for (i = krydim; i > kc; i--)
+      {
+        yg[i] = s_product * givens[2 * i - 2];
+        s_product *= givens[2 * i - 1];
+      }
+      yg[kc] = s_product;
+
+      /* Scale r_norm and yg */
+      r_norm *= s_product;
+      for (i = kc; i <= krydim; i++) { yg[i] *= r_norm; }
+      r_norm = SUNRabs(r_norm);
+
+      SUNCheckCall(
+        N_VLinearCombination(krydim + 1 - kc, yg + kc, V + kc, vtemp));
+    }
+
+    /* Update the recycled subspace from this cycle */
+    if (GCRODR_CONTENT(S)->kdim > 0)
+    {
+      status = gcrodrUpdateRecycle(S, kc, krydim);
+      if (status != 0)
+      {
+        *zeroguess  = SUNFALSE;
+        LASTFLAG(S) = status;
+        return (LASTFLAG(S));
+      }
+    }
+
+    /* Not yet converged; if allowed, restart from the residual vector */
+    if (converged || ntries == max_restarts) { break; }
+
+    N_VScale(ONE, vtemp, V[GCRODR_CONTENT(S)->nrecycled]);
+    SUNCheckLastErr();
+  }
+
+  /* If converged, or if the residual norm was reduced below its initial
+     value, construct the solution vector x and return. Otherwise return
+     failure flag. */
+  if (converged || rho < beta)
+  {
+    status = gcrodrCorrect(S, x, delta);
+    if (status != 0)
+    {
+      *zeroguess  = SUNFALSE;
+      LASTFLAG(S) = status;
+      return (LASTFLAG(S));
+    }
+
+    *zeroguess  = SUNFALSE;
+    LASTFLAG(S) = converged ? SUN_SUCCESS : SUNLS_RES_REDUCED;
+    return (LASTFLAG(S));
+  }
+
+  *zeroguess  = SUNFALSE;
+  LASTFLAG(S) = SUNLS_CONV_FAIL;
+  return (LASTFLAG(S));
+}
+
+int SUNLinSolNumIters_GCRODR(SUNLinearSolver S)
+{
+  return (GCRODR_CONTENT(S)->numiters);
+}
+
+sunrealtype SUNLinSolResNorm_GCRODR(SUNLinearSolver S)
+{
+  return (GCRODR_CONTENT(S)->resnorm);
+}
+
+N_Vector SUNLinSolResid_GCRODR(SUNLinearSolver S)
+{
+  return (GCRODR_CONTENT(S)->vtemp);
+}
+
+sunindextype SUNLinSolLastFlag_GCRODR(SUNLinearSolver S)
+{
+  return (LASTFLAG(S));
+}
+
+SUNErrCode SUNLinSolSpace_GCRODR(SUNLinearSolver S, long int* lenrwLS,
+                                 long int* leniwLS)
+{
+  SUNFunctionBegin(S->sunctx);
+  int mdim, kdim;
+  sunindextype liw1, lrw1;
+  kdim = GCRODR_CONTENT(S)->kdim;
+  mdim = GCRODR_CONTENT(S)->maxl + kdim;
+  if (GCRODR_CONTENT(S)->vtemp->ops->nvspace)
+  {
+    N_VSpace(GCRODR_CONTENT(S)->vtemp, &lrw1, &liw1);
+    SUNCheckLastErr();
+  }
+  else { lrw1 = liw1 = 0; }
+  *lenrwLS = lrw1 * (mdim + 3 + 3 * kdim) + 2 * mdim * (mdim + 1) +
+             4 * mdim + 2 + kdim;
+  *leniwLS = liw1 * (mdim + 3 + 3 * kdim);
+  if (kdim > 0)
+  {
+    *lenrwLS += GCRODR_WORK_LEN(mdim, kdim) + 4 * mdim * mdim;
+    *leniwLS += 2 * mdim;
+  }
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolFree_GCRODR(SUNLinearSolver S)
+{
+  int k;
+
+  if (S == NULL) { return SUN_SUCCESS; }
+
+  if (S->content)
+  {
+    /* delete items from within the content structure */
+    if (GCRODR_CONTENT(S)->xcor)
+    {
+      N_VDestroy(GCRODR_CONTENT(S)->xcor);
+      GCRODR_CONTENT(S)->xcor = NULL;
+    }
+    if (GCRODR_CONTENT(S)->vtemp)
+    {
+      N_VDestroy(GCRODR_CONTENT(S)->vtemp);
+      GCRODR_CONTENT(S)->vtemp = NULL;
+    }
+    if (GCRODR_CONTENT(S)->V)
+    {
+      N_VDestroyVectorArray(GCRODR_CONTENT(S)->V,
+                            GCRODR_CONTENT(S)->maxl + GCRODR_CONTENT(S)->kdim +
+                              1);
+      GCRODR_CONTENT(S)->V = NULL;
+    }
+    if (GCRODR_CONTENT(S)->U)
+    {
+      N_VDestroyVectorArray(GCRODR_CONTENT(S)->U, GCRODR_CONTENT(S)->kdim);
+      GCRODR_CONTENT(S)->U = NULL;
+    }
+    if (GCRODR_CONTENT(S)->Utmp)
+    {
+      N_VDestroyVectorArray(GCRODR_CONTENT(S)->Utmp, GCRODR_CONTENT(S)->kdim);
+      GCRODR_CONTENT(S)->Utmp = NULL;
+    }
+    if (GCRODR_CONTENT(S)->Ctmp)
+    {
+      N_VDestroyVectorArray(GCRODR_CONTENT(S)->Ctmp, GCRODR_CONTENT(S)->kdim);
+      GCRODR_CONTENT(S)->Ctmp = NULL;
+    }
+    if (GCRODR_CONTENT(S)->dvals)
+    {
+      free(GCRODR_CONTENT(S)->dvals);
+      GCRODR_CONTENT(S)->dvals = NULL;
+    }
+    if (GCRODR_CONTENT(S)->Hes)
+    {
+      for (k = 0; k <= GCRODR_CONTENT(S)->maxl + GCRODR_CONTENT(S)->kdim; k++)
+      {
+        if (GCRODR_CONTENT(S)->Hes[k])
+        {
+          free(GCRODR_CONTENT(S)->Hes[k]);
+          GCRODR_CONTENT(S)->Hes[k] = NULL;
+        }
+      }
+      free(GCRODR_CONTENT(S)->Hes);
+      GCRODR_CONTENT(S)->Hes = NULL;
+    }
+    if (GCRODR_CONTENT(S)->Gcopy)
+    {
+      free(GCRODR_CONTENT(S)->Gcopy);
+      GCRODR_CONTENT(S)->Gcopy = NULL;
+    }
+    if (GCRODR_CONTENT(S)->givens)
+    {
+      free(GCRODR_CONTENT(S)->givens);
+      GCRODR_CONTENT(S)->givens = NULL;
+    }
+    if (GCRODR_CONTENT(S)->yg)
+    {
+      free(GCRODR_CONTENT(S)->yg);
+      GCRODR_CONTENT(S)->yg = NULL;
+    }
+    if (GCRODR_CONTENT(S)->cv)
+    {
+      free(GCRODR_CONTENT(S)->cv);
+      GCRODR_CONTENT(S)->cv = NULL;
+    }
+    if (GCRODR_CONTENT(S)->Xv)
+    {
+      free(GCRODR_CONTENT(S)->Xv);
+      GCRODR_CONTENT(S)->Xv = NULL;
+    }
+    if (GCRODR_CONTENT(S)->work)
+    {
+      free(GCRODR_CONTENT(S)->work);
+      GCRODR_CONTENT(S)->work = NULL;
+    }
+    if (GCRODR_CONTENT(S)->Eig)
+    {
+      SUNDlsMat_destroyMat(GCRODR_CONTENT(S)->Eig);
+      GCRODR_CONTENT(S)->Eig = NULL;
+    }
+    if (GCRODR_CONTENT(S)->pivots)
+    {
+      SUNDlsMat_destroyArray(GCRODR_CONTENT(S)->pivots);
+      GCRODR_CONTENT(S)->pivots = NULL;
+    }
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops)
+  {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S);
+  S = NULL;
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Compute w = A-tilde v, where A-tilde = s1 P1_inv A P2_inv s2_inv, using
+ * vtemp as workspace. Returns 0 on success or a SUNLS_* failure flag.
+ */
+
+static int gcrodrATilde(SUNLinearSolver S, N_Vector v, N_Vector w,
+                        sunrealtype delta)
+{
+  SUNFunctionBegin(S->sunctx);
+  N_Vector vtemp, s1, s2;
+  sunbooleantype preOnLeft, preOnRight;
+  int status;
+
+  vtemp      = GCRODR_CONTENT(S)->vtemp;
+  s1         = GCRODR_CONTENT(S)->s1;
+  s2         = GCRODR_CONTENT(S)->s2;
+  preOnLeft  = ((GCRODR_CONTENT(S)->pretype == SUN_PREC_LEFT) ||
+                (GCRODR_CONTENT(S)->pretype == SUN_PREC_BOTH));
+  preOnRight = ((GCRODR_CONTENT(S)->pretype == SUN_PREC_RIGHT) ||
+                (GCRODR_CONTENT(S)->pretype == SUN_PREC_BOTH));
+
+  /* Apply right scaling: vtemp = s2_inv v */
+  if (s2 != NULL)
+  {
+    N_VDiv(v, s2, vtemp);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    N_VScale(ONE, v, vtemp);
+    SUNCheckLastErr();
+  }
+
+  /* Apply right preconditioner: vtemp = P2_inv s2_inv v */
+  if (preOnRight)
+  {
+    N_VScale(ONE, vtemp, w);
+    SUNCheckLastErr();
+    status = GCRODR_CONTENT(S)->Psolve(GCRODR_CONTENT(S)->PData, w, vtemp,
+                                       delta, SUN_PREC_RIGHT);
+    if (status != 0)
+    {
+      return ((status < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+    }
+  }
+
+  /* Apply A: w = A P2_inv s2_inv v */
+  status = GCRODR_CONTENT(S)->ATimes(GCRODR_CONTENT(S)->ATData, vtemp, w);
+  if (status != 0)
+  {
+    return ((status < 0) ? SUNLS_ATIMES_FAIL_UNREC : SUNLS_ATIMES_FAIL_REC);
+  }
+
+  /* Apply left preconditioning: vtemp = P1_inv A P2_inv s2_inv v */
+  if (preOnLeft)
+  {
+    status = GCRODR_CONTENT(S)->Psolve(GCRODR_CONTENT(S)->PData, w, vtemp,
+                                       delta, SUN_PREC_LEFT);
+    if (status != 0)
+    {
+      return ((status < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+    }
+  }
+  else
+  {
+    N_VScale(ONE, w, vtemp);
+    SUNCheckLastErr();
+  }
+
+  /* Apply left scaling: w = s1 P1_inv A P2_inv s2_inv v */
+  if (s1 != NULL)
+  {
+    N_VProd(s1, vtemp, w);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    N_VScale(ONE, vtemp, w);
+    SUNCheckLastErr();
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Recompute the image C = A-tilde U of the recycled subspace in V[0], ...,
+ * V[kc-1] for the current system and orthonormalize it. Returns 0 on success
+ * or a failure flag.
+ */
+
+static int gcrodrRecomputeC(SUNLinearSolver S, sunrealtype delta)
+{
+  SUNFunctionBegin(S->sunctx);
+  N_Vector *V, *U;
+  int i, kc, status;
+
+  V  = GCRODR_CONTENT(S)->V;
+  U  = GCRODR_CONTENT(S)->U;
+  kc = GCRODR_CONTENT(S)->nrecycled;
+
+  for (i = 0; i < kc; i++)
+  {
+    status = gcrodrATilde(S, U[i], V[i], delta);
+    if (status != 0) { return (status); }
+  }
+
+  SUNCheckCall(gcrodrOrthRecycle(S, kc));
+
+  return (0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Orthonormalize the kc vectors C in V[0], ..., V[kc-1] with classical
+ * Gram-Schmidt with reorthogonalization, applying the same transformations
+ * to U so that A-tilde U = C still holds. A vector of U whose image depends
+ * on the previous ones is dropped. The vectors of U are then scaled to unit
+ * norm, A-tilde U = C D with D = diag(dvals), and nrecycled is set to the
+ * number of vectors kept.
+ */
+
+static SUNErrCode gcrodrOrthRecycle(SUNLinearSolver S, int kc)
+{
+  SUNFunctionBegin(S->sunctx);
+  N_Vector *V, *U, *Xv, tmp;
+  sunrealtype *cv, *dvals, nrm0, nrm;
+  int i, q, pass;
+
+  V     = GCRODR_CONTENT(S)->V;
+  U     = GCRODR_CONTENT(S)->U;
+  Xv    = GCRODR_CONTENT(S)->Xv;
+  cv    = GCRODR_CONTENT(S)->cv;
+  dvals = GCRODR_CONTENT(S)->dvals;
+
+  i = 0;
+  while (i < kc)
+  {
+    nrm0 = N_VDotProd(V[i], V[i]);
+    SUNCheckLastErr();
+    nrm0 = SUNRsqrt(nrm0);
+
+    /* orthogonalize V[i] against V[0], ..., V[i-1] and update U[i], where
+       A-tilde U[q] = dvals[q] V[q] for q < i */
+    for (pass = 0; pass < 2 && i > 0; pass++)
+    {
+      SUNCheckCall(N_VDotProdMulti(i, V[i], V, cv + 1));
+      cv[0] = ONE;
+      Xv[0] = V[i];
+      for (q = 0; q < i; q++)
+      {
+        cv[q + 1] = -cv[q + 1];
+        Xv[q + 1] = V[q];
+      }
+      SUNCheckCall(N_VLinearCombination(i + 1, cv, Xv, V[i]));
+
+      Xv[0] = U[i];
+      for (q = 0; q < i; q++)
+      {
+        cv[q + 1] /= dvals[q];
+        Xv[q + 1] = U[q];
+      }
+      SUNCheckCall(N_VLinearCombination(i + 1, cv, Xv, U[i]));
+    }
+
+    nrm = N_VDotProd(V[i], V[i]);
+    SUNCheckLastErr();
+    nrm = SUNRsqrt(nrm);
+
+    /* drop U[i] by swapping it with the last recycled vector */
+    if (nrm == ZERO || nrm <= SUN_RCONST(1000.0) * SUN_UNIT_ROUNDOFF * nrm0)
+    {
+      kc--;
+      tmp   = U[i];
+      U[i]  = U[kc];
+      U[kc] = tmp;
+      tmp   = V[i];
+      V[i]  = V[kc];
+      V[kc] = tmp;
+      continue;
+    }
+
+    N_VScale(ONE / nrm, V[i], V[i]);
+    SUNCheckLastErr();
+    N_VScale(ONE / nrm, U[i], U[i]);
+    SUNCheckLastErr();
+
+    nrm = N_VDotProd(U[i], U[i]);
+    SUNCheckLastErr();
+    dvals[i] = ONE / SUNRsqrt(nrm);
+    N_VScale(dvals[i], U[i], U[i]);
+    SUNCheckLastErr();
+
+    i++;
+  }
+
+  GCRODR_CONTENT(S)->nrecycled = kc;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Replace the recycled subspace by the harmonic Ritz vectors of A-tilde with
+ * respect to the span of W = [U, V_(n-kc)] of largest 1/theta, where theta
+ * is a harmonic Ritz value, at the end of a cycle with kc recycled vectors
+ * and n columns in G. These solve
+ *
+ *   G^T G z = theta G^T V_hat^T W z,  V_hat = [C, V_(n-kc+1)],
+ *
+ * or, with the QR factorization G = Q R computed in the cycle,
+ * R^{-1} Q^T V_hat^T W z = (1/theta) z. Complex eigenvectors contribute
+ * their real and imaginary parts. With Y = W P, where P holds the
+ * eigenvectors, and the QR factorization G P = Q_k R_k, the new recycled
+ * subspace is U = Y R_k^{-1} with image C = V_hat Q_k. Returns 0 on success
+ * or a failure flag. The recycled subspace is unchanged if the eigenvalue
+ * iteration does not converge.
+ */
+
+static int gcrodrUpdateRecycle(SUNLinearSolver S, int kc, int n)
+{
+  SUNFunctionBegin(S->sunctx);
+  N_Vector *V, *U, *Utmp, *Ctmp, *Xv, tmp;
+  sunrealtype **Hes, *Gcopy, *givens, *cv;
+  sunrealtype *WtV, *T, *H, *wr, *wi, *mag, *P, *GP, *Rs, *z;
+  sunrealtype c, s, t1, t2, tnorm, best, nrm0, nrm;
+  int i, j, q, ib, ic, m, pass, kdim, mdim, ld;
+
+  kdim   = GCRODR_CONTENT(S)->kdim;
+  mdim   = GCRODR_CONTENT(S)->maxl + kdim;
+  V      = GCRODR_CONTENT(S)->V;
+  U      = GCRODR_CONTENT(S)->U;
+  Utmp   = GCRODR_CONTENT(S)->Utmp;
+  Ctmp   = GCRODR_CONTENT(S)->Ctmp;
+  Xv     = GCRODR_CONTENT(S)->Xv;
+  cv     = GCRODR_CONTENT(S)->cv;
+  Hes    = GCRODR_CONTENT(S)->Hes;
+  Gcopy  = GCRODR_CONTENT(S)->Gcopy;
+  givens = GCRODR_CONTENT(S)->givens;
+
+  /* Column-major workspace with leading dimension ld for the (n+1) by n
+     matrix V_hat^T W and the n+1 by kdim matrix G P, and n for the n by n
+     matrix T = R^{-1} Q^T V_hat^T W and the n by kdim matrix P */
+  ld  = n + 1;
+  WtV = GCRODR_CONTENT(S)->work;
+  T   = WtV + ld * n;
+  H   = T + n * n;
+  wr  = H + n * n;
+  wi  = wr + n;
+  mag = wi + n;
+  P   = mag + n;
+  GP  = P + n * kdim;
+  Rs  = GP + ld * kdim;
+  z   = Rs + kdim * kdim;
+
+  /* T = R^{-1} Q^T V_hat^T W, where V_hat^T W = [V_hat^T U, I; 0] */
+  tnorm = ZERO;
+  for (j = 0; j < n; j++)
+  {
+    if (j < kc) { SUNCheckCall(N_VDotProdMulti(n + 1, U[j], V, WtV + j * ld)); }
+    else
+    {
+      for (i = 0; i <= n; i++) { WtV[i + j * ld] = ZERO; }
+      WtV[j + j * ld] = ONE;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+      c                   = givens[2 * i];
+      s                   = givens[2 * i + 1];
+      t1                  = WtV[i + j * ld];
+      t2                  = WtV[i + 1 + j * ld];
+      WtV[i + j * ld]     = c * t1 - s * t2;
+      WtV[i + 1 + j * ld] = s * t1 + c * t2;
+    }
+
+    for (i = n - 1; i >= 0; i--)
+    {
+      t1 = WtV[i + j * ld];
+      for (q = i + 1; q < n; q++) { t1 -= Hes[i][q] * T[q + j * n]; }
+      T[i + j * n] = t1 / Hes[i][i];
+      tnorm += SUNRabs(T[i + j * n]);
+    }
+  }
+
+  /* Eigenvalues 1/theta of T */
+  for (i = 0; i < n; i++)
+  {
+    for (j = 0; j < n; j++) { H[i * n + j] = T[i + j * n]; }
+  }
+  gcrodrHessReduce(n, H, z);
+  if (gcrodrHessEig(n, H, wr, wi) != 0) { return (0); }
+
+  /* Eigenvectors of largest magnitude eigenvalues in P, the conjugate of a
+     complex eigenvector adds nothing to the span */
+  for (i = 0; i < n; i++) { mag[i] = SUNRsqrt(wr[i] * wr[i] + wi[i] * wi[i]); }
+  m = 0;
+  while (m < kdim)
+  {
+    ib   = -1;
+    best = -ONE;
+    for (i = 0; i < n; i++)
+    {
+      if (wi[i] >= ZERO && mag[i] > best)
+      {
+        best = mag[i];
+        ib   = i;
+      }
+    }
+    if (ib < 0) { break; }
+    mag[ib] = -ONE;
+
+    if (gcrodrEigvec(n, T, GCRODR_CONTENT(S)->Eig, GCRODR_CONTENT(S)->pivots,
+                     wr[ib], wi[ib], tnorm, z) != 0)
+    {
+      continue;
+    }
+
+    for (i = 0; i < n; i++) { P[i + m * n] = z[i]; }
+    m++;
+    if (wi[ib] > ZERO && m < kdim)
+    {
+      for (i = 0; i < n; i++) { P[i + m * n] = z[n + i]; }
+      m++;
+    }
+  }
+
+  /* G P = Q_k R_k by modified Gram-Schmidt with reorthogonalization, dropping
+     dependent columns */
+  for (j = 0; j < m; j++)
+  {
+    for (i = 0; i <= n; i++)
+    {
+      t1 = ZERO;
+      for (q = 0; q < n; q++) { t1 += Gcopy[i * mdim + q] * P[q + j * n]; }
+      GP[i + j * ld] = t1;
+    }
+  }
+
+  ic = 0;
+  for (j = 0; j < m; j++)
+  {
+    if (ic != j)
+    {
+      for (i = 0; i <= n; i++) { GP[i + ic * ld] = GP[i + j * ld]; }
+      for (i = 0; i < n; i++) { P[i + ic * n] = P[i + j * n]; }
+    }
+
+    nrm0 = ZERO;
+    for (i = 0; i <= n; i++) { nrm0 += GP[i + ic * ld] * GP[i + ic * ld]; }
+    nrm0 = SUNRsqrt(nrm0);
+
+    for (q = 0; q < ic; q++) { Rs[q + ic * kdim] = ZERO; }
+    for (pass = 0; pass < 2; pass++)
+    {
+      for (q = 0; q < ic; q++)
+      {
+        t1 = ZERO;
+        for (i = 0; i <= n; i++) { t1 += GP[i + q * ld] * GP[i + ic * ld]; }
+        Rs[q + ic * kdim] += t1;
+        for (i = 0; i <= n; i++) { GP[i + ic * ld] -= t1 * GP[i + q * ld]; }
+      }
+    }
+
+    nrm = ZERO;
+    for (i = 0; i <= n; i++) { nrm += GP[i + ic * ld] * GP[i + ic * ld]; }
+    nrm = SUNRsqrt(nrm);
+    if (nrm == ZERO || nrm <= SUN_RCONST(100.0) * SUN_UNIT_ROUNDOFF * nrm0)
+    {
+      continue;
+    }
+
+    Rs[ic + ic * kdim] = nrm;
+    for (i = 0; i <= n; i++) { GP[i + ic * ld] /= nrm; }
+    ic++;
+  }
+  m = ic;
+  if (m == 0) { return (0); }
+
+  /* Y = W P in Utmp and C = V_hat Q_k in Ctmp */
+  for (i = 0; i < n; i++) { Xv[i] = (i < kc) ? U[i] : V[i]; }
+  for (j = 0; j < m; j++)
+  {
+    SUNCheckCall(N_VLinearCombination(n, P + j * n, Xv, Utmp[j]));
+    SUNCheckCall(N_VLinearCombination(n + 1, GP + j * ld, V, Ctmp[j]));
+  }
+
+  /* U = Y R_k^{-1} */
+  for (j = 0; j < m; j++)
+  {
+    cv[0] = ONE / Rs[j + j * kdim];
+    Xv[0] = Utmp[j];
+    for (q = 0; q < j; q++)
+    {
+      cv[q + 1] = -Rs[q + j * kdim] * cv[0];
+      Xv[q + 1] = Utmp[q];
+    }
+    SUNCheckCall(N_VLinearCombination(j + 1, cv, Xv, Utmp[j]));
+  }
+
+  /* Swap the new recycled vectors and their images into U and V, then
+     restore the orthonormality of C lost to rounding in V_hat */
+  for (j = 0; j < m; j++)
+  {
+    tmp     = U[j];
+    U[j]    = Utmp[j];
+    Utmp[j] = tmp;
+    tmp     = V[j];
+    V[j]    = Ctmp[j];
+    Ctmp[j] = tmp;
+  }
+  SUNCheckCall(gcrodrOrthRecycle(S, m));
+
+  return (0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Construct the solution x = x_0 + P2_inv s2_inv xcor, using vtemp as
+ * workspace. Returns 0 on success or a SUNLS_* failure flag.
+ */
+
+static int gcrodrCorrect(SUNLinearSolver S, N_Vector x, sunrealtype delta)
+{
+  SUNFunctionBegin(S->sunctx);
+  N_Vector xcor, vtemp, s2;
+  sunbooleantype preOnRight;
+  int status;
+
+  xcor       = GCRODR_CONTENT(S)->xcor;
+  vtemp      = GCRODR_CONTENT(S)->vtemp;
+  s2         = GCRODR_CONTENT(S)->s2;
+  preOnRight = ((GCRODR_CONTENT(S)->pretype == SUN_PREC_RIGHT) ||
+                (GCRODR_CONTENT(S)->pretype == SUN_PREC_BOTH));
+
+  /* Apply right scaling and right precond.: vtemp = P2_inv s2_inv xcor */
+  if (s2 != NULL)
+  {
+    N_VDiv(xcor, s2, xcor);
+    SUNCheckLastErr();
+  }
+
+  if (preOnRight)
+  {
+    status = GCRODR_CONTENT(S)->Psolve(GCRODR_CONTENT(S)->PData, xcor, vtemp,
+                                       delta, SUN_PREC_RIGHT);
+    if (status != 0)
+    {
+      return ((status < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+    }
+  }
+  else
+  {
+    N_VScale(ONE, xcor, vtemp);
+    SUNCheckLastErr();
+  }
+
+  /* Add vtemp to initial x to get final solution x */
+  if (GCRODR_CONTENT(S)->zeroguess)
+  {
+    N_VScale(ONE, vtemp, x);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    N_VLinearSum(ONE, x, ONE, vtemp, x);
+    SUNCheckLastErr();
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute an eigenvector z of the n by n matrix T, stored by columns, for
+ * the eigenvalue wr + i wi by two steps of inverse iteration with a slightly
+ * perturbed shift, in real arithmetic with the 2n by 2n system
+ *
+ *   [ T - wr I     wi I   ] [ zr ]
+ *   [  -wi I     T - wr I ] [ zi ]
+ *
+ * for a complex eigenvalue, so that z = [zr; zi]. E and piv are workspace of
+ * size at least 2n. Returns 0 on success or 1 on failure.
+ */
+
+static int gcrodrEigvec(int n, sunrealtype* T, sunrealtype** E,
+                        sunindextype* piv, sunrealtype wr, sunrealtype wi,
+                        sunrealtype tnorm, sunrealtype* z)
+{
+  int i, j, m, it;
+  sunrealtype sigma, nrm;
+
+  if (tnorm == ZERO) { return (1); }
+
+  m     = (wi != ZERO) ? 2 * n : n;
+  sigma = wr + SUN_RCONST(100.0) * SUN_UNIT_ROUNDOFF * tnorm;
+
+  for (j = 0; j < m; j++)
+  {
+    for (i = 0; i < m; i++) { E[j][i] = ZERO; }
+  }
+  for (j = 0; j < n; j++)
+  {
+    for (i = 0; i < n; i++)
+    {
+      E[j][i] = T[i + j * n];
+      if (m > n) { E[j + n][i + n] = T[i + j * n]; }
+    }
+  }
+  for (i = 0; i < n; i++)
+  {
+    E[i][i] -= sigma;
+    if (m > n)
+    {
+      E[i + n][i + n] -= sigma;
+      E[i + n][i] = wi;
+      E[i][i + n] = -wi;
+    }
+  }
+
+  if (SUNDlsMat_denseGETRF(E, m, m, piv) != 0) { return (1); }
+
+  for (i = 0; i < m; i++) { z[i] = ONE; }
+  for (it = 0; it < 2; it++)
+  {
+    SUNDlsMat_denseGETRS(E, m, piv, z);
+    nrm = ZERO;
+    for (i = 0; i < m; i++) { nrm += z[i] * z[i]; }
+    nrm = SUNRsqrt(nrm);
+    if (nrm == ZERO) { return (1); }
+    for (i = 0; i < m; i++) { z[i] /= nrm; }
+  }
+
+  return (0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Reduce the n by n matrix h, stored by rows, to upper Hessenberg form with
+ * Householder reflections, using v as workspace of length n.
+ */
+
+static void gcrodrHessReduce(int n, sunrealtype* h, sunrealtype* v)
+{
+  int i, j, k, len;
+  sunrealtype alpha, beta, p;
+
+#define H(i, j) h[(i) * n + (j)]
+
+  for (k = 0; k < n - 2; k++)
+  {
+    len   = n - k - 1;
+    alpha = ZERO;
+    for (i = 0; i < len; i++)
+    {
+      v[i] = H(k + 1 + i, k);
+      alpha += v[i] * v[i];
+    }
+    alpha = SUNRsqrt(alpha);
+    if (alpha == ZERO) { continue; }
+    if (v[0] < ZERO) { alpha = -alpha; }
+    v[0] += alpha;
+    beta = ZERO;
+    for (i = 0; i < len; i++) { beta += v[i] * v[i]; }
+    beta = 2 / beta;
+
+    /* apply I - beta v v^T on the left and on the right */
+    for (j = k; j < n; j++)
+    {
+      p = ZERO;
+      for (i = 0; i < len; i++) { p += v[i] * H(k + 1 + i, j); }
+      p *= beta;
+      for (i = 0; i < len; i++) { H(k + 1 + i, j) -= p * v[i]; }
+    }
+    for (i = 0; i < n; i++)
+    {
+      p = ZERO;
+      for (j = 0; j < len; j++) { p += H(i, k + 1 + j) * v[j]; }
+      p *= beta;
+      for (j = 0; j < len; j++) { H(i, k + 1 + j) -= p * v[j]; }
+    }
+    for (i = 2; i < len + 1; i++) { H(k + i, k) = ZERO; }
+  }
+
+#undef H
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute the eigenvalues wr + i wi of the n by n upper Hessenberg matrix h,
+ * stored by rows and overwritten, with the Francis double shift QR iteration.
+ * Complex conjugate pairs are returned in consecutive entries. Returns 0 on
+ * success or 1 if the iteration does not converge.
+ */
+
+static int gcrodrHessEig(int n, sunrealtype* h, sunrealtype* wr,
+                         sunrealtype* wi)
+{
+  int i, j, k, l, hi, its, nv;
+  sunrealtype anorm, s, t, x, y, z, p, q, w, beta, v[3];
+
+#define H(i, j) h[(i) * n + (j)]
+
+  anorm = ZERO;
+  for (i = 0; i < n; i++)
+  {
+    for (j = SUNMAX(i - 1, 0); j < n; j++) { anorm += SUNRabs(H(i, j)); }
+  }
+
+  hi  = n - 1;
+  its = 0;
+  while (hi >= 0)
+  {
+    /* find the start l of the unreduced block ending at row hi */
+    for (l = hi; l > 0; l--)
+    {
+      s = SUNRabs(H(l - 1, l - 1)) + SUNRabs(H(l, l));
+      if (s == ZERO) { s = anorm; }
+      if (SUNRabs(H(l, l - 1)) <= SUN_UNIT_ROUNDOFF * s)
+      {
+        H(l, l - 1) = ZERO;
+        break;
+      }
+    }
+
+    if (l == hi)
+    {
+      /* one real eigenvalue */
+      wr[hi] = H(hi, hi);
+      wi[hi] = ZERO;
+      hi--;
+      its = 0;
+    }
+    else if (l == hi - 1)
+    {
+      /* two eigenvalues of the trailing 2 by 2 block */
+      x = H(hi, hi);
+      w = H(hi, hi - 1) * H(hi - 1, hi);
+      p = HALF * (H(hi - 1, hi - 1) - x);
+      q = p * p + w;
+      z = SUNRsqrt(SUNRabs(q));
+      if (q >= ZERO)
+      {
+        z          = (p >= ZERO) ? p + z : p - z;
+        wr[hi - 1] = x + z;
+        wr[hi]     = (z != ZERO) ? x - w / z : x + z;
+        wi[hi - 1] = wi[hi] = ZERO;
+      }
+      else
+      {
+        wr[hi - 1] = wr[hi] = x + p;
+        wi[hi - 1]          = z;
+        wi[hi]              = -z;
+      }
+      hi -= 2;
+      its = 0;
+    }
+    else
+    {
+      if (its == 30) { return (1); }
+      its++;
+
+      /* sum s and product t of the shifts, with exceptional shifts after
+         10 and 20 iterations without deflation */
+      if (its == 10 || its == 20)
+      {
+        x = SUNRabs(H(hi, hi - 1)) + SUNRabs(H(hi - 1, hi - 2));
+        y = SUN_RCONST(0.75) * x + H(hi, hi);
+        s = 2 * y;
+        t = y * y + SUN_RCONST(0.4375) * x * x;
+      }
+      else
+      {
+        s = H(hi - 1, hi - 1) + H(hi, hi);
+        t = H(hi - 1, hi - 1) * H(hi, hi) - H(hi - 1, hi) * H(hi, hi - 1);
+      }
+
+      /* first column of (H - shift_1 I)(H - shift_2 I) */
+      x = H(l, l) * H(l, l) + H(l, l + 1) * H(l + 1, l) - s * H(l, l) + t;
+      y = H(l + 1, l) * (H(l, l) + H(l + 1, l + 1) - s);
+      z = H(l + 1, l) * H(l + 2, l + 1);
+
+      /* chase the bulge with Householder reflections I - beta v v^T */
+      for (k = l; k <= hi - 1; k++)
+      {
+        nv   = (k < hi - 1) ? 3 : 2;
+        v[0] = x;
+        v[1] = y;
+        v[2] = (nv == 3) ? z : ZERO;
+        w    = SUNRsqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (w != ZERO)
+        {
+          v[0] += (v[0] >= ZERO) ? w : -w;
+          beta = 2 / (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+          for (j = SUNMAX(k - 1, l); j <= hi; j++)
+          {
+            p = H(k, j) * v[0] + H(k + 1, j) * v[1];
+            if (nv == 3) { p += H(k + 2, j) * v[2]; }
+            p *= beta;
+            H(k, j) -= p * v[0];
+            H(k + 1, j) -= p * v[1];
+            if (nv == 3) { H(k + 2, j) -= p * v[2]; }
+          }
+          for (i = l; i <= SUNMIN(k + 3, hi); i++)
+          {
+            p = H(i, k) * v[0] + H(i, k + 1) * v[1];
+            if (nv == 3) { p += H(i, k + 2) * v[2]; }
+            p *= beta;
+            H(i, k) -= p * v[0];
+            H(i, k + 1) -= p * v[1];
+            if (nv == 3) { H(i, k + 2) -= p * v[2]; }
+          }
+        }
+        if (k < hi - 1)
+        {
+          x = H(k + 1, k);
+          y = H(k + 2, k);
+          if (k < hi - 2) { z = H(k + 3, k); }
+        }
+      }
+    }
+  }
+
+#undef H
+
+  return (0);
+}
+
@@ -0,0 +1,1010 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the incomplete factorization
+ * implementation of the SUNLINSOL package.
+ *
+ * All factorization types share one code path. The analysis picks
+ * the pattern of the factors (the diagonal, the dense diagonal
+ * blocks, or the ILU(k) level of fill pattern of Y. Saad, Iterative
+ * Methods for Sparse Linear Systems, 2nd ed., SIAM, 2003, Sec. 10.3)
+ * stored by rows with sorted columns, maps the entries of A into it,
+ * and groups the rows into levels: a row of the L (U) solve depends
+ * only on rows of lower levels. The factorization, which has the
+ * dependencies of the L solve, and the two triangular solves then
+ * process the rows of a level in parallel. The analysis is redone
+ * only when the pattern of A changes.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_math.h>
+#include <sunlinsol/sunlinsol_ilu.h>
+
+#include "sundials_macros.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+
+/* smallest number of rows in a level for which the rows are processed in
+   parallel */
+#define ILU_PAR_MIN_ROWS 64
+
+/*
+ * -----------------------------------------------------------------
+ * ILU solver structure accessibility macros:
+ * -----------------------------------------------------------------
+ */
+
+#define ILU_CONTENT(S) ((SUNLinearSolverContent_ILU)(S->content))
+#define ILUTYPE(S)     (ILU_CONTENT(S)->ilutype)
+#define FILL(S)        (ILU_CONTENT(S)->fill)
+#define BLOCKSIZE(S)   (ILU_CONTENT(S)->bs)
+#define NUMTHREADS(S)  (ILU_CONTENT(S)->num_threads)
+#define CURRENT(S)     (ILU_CONTENT(S)->current)
+#define LASTFLAG(S)    (ILU_CONTENT(S)->last_flag)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static sunbooleantype iluSamePattern(SUNLinearSolver S, SUNMatrix A);
+static SUNErrCode iluAnalyze(SUNLinearSolver S, SUNMatrix A);
+static SUNErrCode iluRowPattern(SUNMatrix A, sunindextype** rp,
+                                sunindextype** rc);
+static SUNErrCode iluPatternILUK(SUNLinearSolver S, sunindextype* arp,
+                                 sunindextype* arc);
+static SUNErrCode iluPatternBlocks(SUNLinearSolver S, sunindextype bs);
+static SUNErrCode iluLevels(sunindextype N, sunindextype* rowptrs,
+                            sunindextype* colind, sunindextype* diag,
+                            sunbooleantype lower, sunindextype* nlev,
+                            sunindextype** levptr, sunindextype** levrows);
+static void iluFreeAnalysis(SUNLinearSolver S);
+static int iluCompareIndex(const void* a, const void* b);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new ILU linear solver
+ */
+
+SUNLinearSolver SUNLinSol_ILU(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
+                              int ilutype, SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  SUNLinearSolver S;
+  SUNLinearSolverContent_ILU content;
+
+  SUNAssertNull(SUNMatGetID(A) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssertNull(SUNSparseMatrix_Rows(A) == SUNSparseMatrix_Columns(A),
+                SUN_ERR_ARG_DIMSMISMATCH);
+  SUNAssertNull(y->ops->nvgetarraypointer, SUN_ERR_ARG_INCOMPATIBLE);
+  SUNAssertNull(SUNSparseMatrix_Rows(A) == N_VGetLength(y),
+                SUN_ERR_ARG_DIMSMISMATCH);
+  SUNAssertNull(ilutype == SUN_ILU_JACOBI || ilutype == SUN_ILU_BLOCK_JACOBI ||
+                  ilutype == SUN_ILU_ILUK,
+                SUN_ERR_ARG_OUTOFRANGE);
+
+  /* Create an empty linear solver */
+  S = NULL;
+  S = SUNLinSolNewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+  S->ops->gettype    = SUNLinSolGetType_ILU;
+  S->ops->getid      = SUNLinSolGetID_ILU;
+  S->ops->initialize = SUNLinSolInitialize_ILU;
+  S->ops->setup      = SUNLinSolSetup_ILU;
+  S->ops->solve      = SUNLinSolSolve_ILU;
+  S->ops->lastflag   = SUNLinSolLastFlag_ILU;
+  S->ops->space      = SUNLinSolSpace_ILU;
+  S->ops->free       = SUNLinSolFree_ILU;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNLinearSolverContent_ILU)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach content */
+  S->content = content;
+
+  /* Fill content */
+  content->ilutype     = ilutype;
+  content->fill        = SUNILU_FILL_DEFAULT;
+  content->bs          = SUNILU_BLOCKSIZE_DEFAULT;
+  content->num_threads = 1;
+  content->N           = SUNSparseMatrix_Rows(A);
+  content->current     = SUNFALSE;
+  content->a_type      = -1;
+  content->a_nnz       = 0;
+  content->a_ptrs      = NULL;
+  content->a_vals      = NULL;
+  content->amap        = NULL;
+  content->nnz         = 0;
+  content->rowptrs     = NULL;
+  content->colind      = NULL;
+  content->diag        = NULL;
+  content->lu          = NULL;
+  content->nlevL       = 0;
+  content->levptrL     = NULL;
+  content->levrowsL    = NULL;
+  content->nlevU       = 0;
+  content->levptrU     = NULL;
+  content->levrowsU    = NULL;
+  content->iwork       = NULL;
+  content->last_flag   = 0;
+
+  return (S);
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to set the factorization type and parameters, a change takes
+ * effect at the next setup
+ */
+
+SUNErrCode SUNLinSol_ILUSetType(SUNLinearSolver S, int ilutype)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_ILU, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(ilutype == SUN_ILU_JACOBI || ilutype == SUN_ILU_BLOCK_JACOBI ||
+              ilutype == SUN_ILU_ILUK,
+            SUN_ERR_ARG_OUTOFRANGE);
+
+  if (ilutype != ILUTYPE(S)) { CURRENT(S) = SUNFALSE; }
+  ILUTYPE(S) = ilutype;
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_ILUSetFillLevel(SUNLinearSolver S, int fill)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_ILU, SUN_ERR_ARG_WRONGTYPE);
+
+  /* Check for legal fill level; if illegal use default */
+  if (fill < 0) { fill = SUNILU_FILL_DEFAULT; }
+
+  if (fill != FILL(S)) { CURRENT(S) = SUNFALSE; }
+  FILL(S) = fill;
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_ILUSetBlockSize(SUNLinearSolver S, sunindextype bs)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_ILU, SUN_ERR_ARG_WRONGTYPE);
+
+  /* Check for legal block size; if illegal use default */
+  if (bs < 1) { bs = SUNILU_BLOCKSIZE_DEFAULT; }
+
+  if (bs != BLOCKSIZE(S)) { CURRENT(S) = SUNFALSE; }
+  BLOCKSIZE(S) = bs;
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_ILUSetNumThreads(SUNLinearSolver S, int num_threads)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_ILU, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_threads >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  /* the row scatter arrays are reallocated at the next setup */
+  if (num_threads != NUMTHREADS(S) && ILU_CONTENT(S)->iwork)
+  {
+    free(ILU_CONTENT(S)->iwork);
+    ILU_CONTENT(S)->iwork = NULL;
+  }
+  NUMTHREADS(S) = num_threads;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to get the number of nonzeros of the factors and the number of
+ * levels of the triangular solves from the last analysis
+ */
+
+SUNErrCode SUNLinSol_ILUGetNumNonzeros(SUNLinearSolver S, sunindextype* nnz)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_ILU, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(nnz, SUN_ERR_ARG_CORRUPT);
+  *nnz = ILU_CONTENT(S)->nnz;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_ILUGetNumLevels(SUNLinearSolver S, sunindextype* nlevL,
+                                     sunindextype* nlevU)
+{
+  SUNFunctionBegin(S->sunctx);
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_ILU, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(nlevL, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(nlevU, SUN_ERR_ARG_CORRUPT);
+  *nlevL = ILU_CONTENT(S)->nlevL;
+  *nlevU = ILU_CONTENT(S)->nlevU;
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of linear solver operations
+ * -----------------------------------------------------------------
+ */
+
+SUNLinearSolver_Type SUNLinSolGetType_ILU(SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_DIRECT);
+}
+
+SUNLinearSolver_ID SUNLinSolGetID_ILU(SUNDIALS_MAYBE_UNUSED SUNLinearSolver S)
+{
+  return (SUNLINEARSOLVER_ILU);
+}
+
+SUNErrCode SUNLinSolInitialize_ILU(SUNLinearSolver S)
+{
+  /* force a new analysis at the next setup */
+  CURRENT(S)  = SUNFALSE;
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSetup_ILU(SUNLinearSolver S, SUNMatrix A)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunindextype N, p, lev, flag;
+  sunindextype *amap, *rowptrs, *colind, *diag, *levptr, *levrows;
+  sunrealtype *lu, *adata;
+  SUNErrCode retval;
+  int nt;
+
+  SUNAssert(A, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(SUNSparseMatrix_Rows(A) == ILU_CONTENT(S)->N,
+            SUN_ERR_ARG_DIMSMISMATCH);
+  SUNAssert(SUNSparseMatrix_Columns(A) == ILU_CONTENT(S)->N,
+            SUN_ERR_ARG_DIMSMISMATCH);
+
+  N  = ILU_CONTENT(S)->N;
+  nt = NUMTHREADS(S);
+
+  /* redo the analysis if the pattern of A changed */
+  if (!CURRENT(S) || !iluSamePattern(S, A))
+  {
+    retval = iluAnalyze(S, A);
+    if (retval != SUN_SUCCESS)
+    {
+      LASTFLAG(S) = retval;
+      return retval;
+    }
+  }
+
+  /* allocate the row scatter arrays, one per thread, all entries are -1
+     between rows */
+  if (ILU_CONTENT(S)->iwork == NULL)
+  {
+    ILU_CONTENT(S)->iwork =
+      (sunindextype*)malloc((size_t)nt * N * sizeof(sunindextype));
+    if (ILU_CONTENT(S)->iwork == NULL)
+    {
+      LASTFLAG(S) = SUN_ERR_MALLOC_FAIL;
+      return SUN_ERR_MALLOC_FAIL;
+    }
+    for (p = 0; p < (sunindextype)nt * N; p++) { ILU_CONTENT(S)->iwork[p] = -1; }
+  }
+
+  amap    = ILU_CONTENT(S)->amap;
+  rowptrs = ILU_CONTENT(S)->rowptrs;
+  colind  = ILU_CONTENT(S)->colind;
+  diag    = ILU_CONTENT(S)->diag;
+  lu      = ILU_CONTENT(S)->lu;
+  levptr  = ILU_CONTENT(S)->levptrL;
+  levrows = ILU_CONTENT(S)->levrowsL;
+  adata   = SUNSparseMatrix_Data(A);
+
+  /* load the entries of A that lie in the pattern of the factors */
+  for (p = 0; p < ILU_CONTENT(S)->nnz; p++) { lu[p] = ZERO; }
+  for (p = 0; p < ILU_CONTENT(S)->a_nnz; p++)
+  {
+    if (amap[p] >= 0) { lu[amap[p]] += adata[p]; }
+  }
+
+  /* factor the rows of each level of the L solve, keeping the first row with
+     a zero pivot */
+  flag = N + 1;
+  for (lev = 0; lev < ILU_CONTENT(S)->nlevL; lev++)
+  {
+    SUNDIALS_MAYBE_UNUSED sunindextype nrows = levptr[lev + 1] - levptr[lev];
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) schedule(static) \
+  reduction(min : flag) num_threads(nt) if (nt > 1 && nrows >= ILU_PAR_MIN_ROWS)
+#endif
+    for (sunindextype r = levptr[lev]; r < levptr[lev + 1]; r++)
+    {
+      sunindextype i = levrows[r];
+      sunindextype k, j, q, p2;
+      sunindextype* pos = ILU_CONTENT(S)->iwork;
+      sunrealtype lik;
+
+#ifdef _OPENMP
+      pos += (sunindextype)omp_get_thread_num() * N;
+#endif
+
+      for (q = rowptrs[i]; q < rowptrs[i + 1]; q++) { pos[colind[q]] = q; }
+
+      /* eliminate the entries of row i left of the diagonal with the
+         already factored rows k */
+      for (p2 = rowptrs[i]; p2 < diag[i]; p2++)
+      {
+        k       = colind[p2];
+        lik     = lu[p2] / lu[diag[k]];
+        lu[p2]  = lik;
+        for (q = diag[k] + 1; q < rowptrs[k + 1]; q++)
+        {
+          j = pos[colind[q]];
+          if (j >= 0) { lu[j] -= lik * lu[q]; }
+        }
+      }
+
+      for (q = rowptrs[i]; q < rowptrs[i + 1]; q++) { pos[colind[q]] = -1; }
+
+      if (lu[diag[i]] == ZERO) { flag = SUNMIN(flag, i + 1); }
+    }
+  }
+
+  /* store error flag (if nonzero, this row encountered zero-valued pivot) */
+  if (flag <= N)
+  {
+    LASTFLAG(S) = flag;
+    return (SUNLS_LUFACT_FAIL);
+  }
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+int SUNLinSolSolve_ILU(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A,
+                       N_Vector x, N_Vector b,
+                       SUNDIALS_MAYBE_UNUSED sunrealtype tol)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunrealtype *xdata, *bdata, *lu;
+  sunindextype lev;
+  sunindextype *rowptrs, *colind, *diag, *levptr, *levrows;
+  SUNDIALS_MAYBE_UNUSED int nt;
+
+  /* access data pointers */
+  xdata = N_VGetArrayPointer(x);
+  SUNCheckLastErr();
+  bdata = N_VGetArrayPointer(b);
+  SUNCheckLastErr();
+  SUNAssert(xdata, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(bdata, SUN_ERR_ARG_CORRUPT);
+
+  rowptrs = ILU_CONTENT(S)->rowptrs;
+  colind  = ILU_CONTENT(S)->colind;
+  diag    = ILU_CONTENT(S)->diag;
+  lu      = ILU_CONTENT(S)->lu;
+  nt      = NUMTHREADS(S);
+
+  /* solve L y = b, L has a unit diagonal */
+  levptr  = ILU_CONTENT(S)->levptrL;
+  levrows = ILU_CONTENT(S)->levrowsL;
+  for (lev = 0; lev < ILU_CONTENT(S)->nlevL; lev++)
+  {
+    SUNDIALS_MAYBE_UNUSED sunindextype nrows = levptr[lev + 1] - levptr[lev];
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) schedule(static) num_threads(nt) \
+  if (nt > 1 && nrows >= ILU_PAR_MIN_ROWS)
+#endif
+    for (sunindextype r = levptr[lev]; r < levptr[lev + 1]; r++)
+    {
+      sunindextype i = levrows[r];
+      sunindextype p;
+      sunrealtype s = bdata[i];
+      for (p = rowptrs[i]; p < diag[i]; p++) { s -= lu[p] * xdata[colind[p]]; }
+      xdata[i] = s;
+    }
+  }
+
+  /* solve U x = y */
+  levptr  = ILU_CONTENT(S)->levptrU;
+  levrows = ILU_CONTENT(S)->levrowsU;
+  for (lev = 0; lev < ILU_CONTENT(S)->nlevU; lev++)
+  {
+    SUNDIALS_MAYBE_UNUSED sunindextype nrows = levptr[lev + 1] - levptr[lev];
+
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) schedule(static) num_threads(nt) \
+  if (nt > 1 && nrows >= ILU_PAR_MIN_ROWS)
+#endif
+    for (sunindextype r = levptr[lev]; r < levptr[lev + 1]; r++)
+    {
+      sunindextype i = levrows[r];
+      sunindextype p;
+      sunrealtype s = xdata[i];
+      for (p = diag[i] + 1; p < rowptrs[i + 1]; p++)
+      {
+        s -= lu[p] * xdata[colind[p]];
+      }
+      xdata[i] = s / lu[diag[i]];
+    }
+  }
+
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
+sunindextype SUNLinSolLastFlag_ILU(SUNLinearSolver S)
+{
+  /* return the stored 'last_flag' value */
+  return (LASTFLAG(S));
+}
+
+SUNErrCode SUNLinSolSpace_ILU(SUNLinearSolver S, long int* lenrwLS,
+                              long int* leniwLS)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunindextype N;
+  SUNAssert(SUNLinSolGetID(S) == SUNLINEARSOLVER_ILU, SUN_ERR_ARG_WRONGTYPE);
+  N        = ILU_CONTENT(S)->N;
+  *lenrwLS = (long int)ILU_CONTENT(S)->nnz;
+  *leniwLS = 12 + (long int)(ILU_CONTENT(S)->nnz + 2 * ILU_CONTENT(S)->a_nnz +
+                             6 * N + ILU_CONTENT(S)->nlevL +
+                             ILU_CONTENT(S)->nlevU);
+  if (ILU_CONTENT(S)->iwork) { *leniwLS += (long int)(NUMTHREADS(S) * N); }
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSolFree_ILU(SUNLinearSolver S)
+{
+  /* return if S is already free */
+  if (S == NULL) { return SUN_SUCCESS; }
+
+  /* delete items from contents, then delete generic structure */
+  if (S->content)
+  {
+    iluFreeAnalysis(S);
+    if (ILU_CONTENT(S)->iwork)
+    {
+      free(ILU_CONTENT(S)->iwork);
+      ILU_CONTENT(S)->iwork = NULL;
+    }
+    free(S->content);
+    S->content = NULL;
+  }
+  if (S->ops)
+  {
+    free(S->ops);
+    S->ops = NULL;
+  }
+  free(S);
+  S = NULL;
+  return SUN_SUCCESS;
+}
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Check if A has the storage format and pattern of the last analysis
+ */
+
+static sunbooleantype iluSamePattern(SUNLinearSolver S, SUNMatrix A)
+{
+  sunindextype N      = ILU_CONTENT(S)->N;
+  sunindextype* ptrs  = SUNSparseMatrix_IndexPointers(A);
+  sunindextype* vals  = SUNSparseMatrix_IndexValues(A);
+  sunindextype a_nnz  = ILU_CONTENT(S)->a_nnz;
+
+  if (SUNSparseMatrix_SparseType(A) != ILU_CONTENT(S)->a_type) { return SUNFALSE; }
+  if (ptrs[N] != a_nnz) { return SUNFALSE; }
+  if (memcmp(ptrs, ILU_CONTENT(S)->a_ptrs, (N + 1) * sizeof(sunindextype)))
+  {
+    return SUNFALSE;
+  }
+  if (a_nnz > 0 &&
+      memcmp(vals, ILU_CONTENT(S)->a_vals, a_nnz * sizeof(sunindextype)))
+  {
+    return SUNFALSE;
+  }
+  return SUNTRUE;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute the pattern of the factors, the map of the entries of A into the
+ * factors, and the level schedules, and save the pattern of A
+ */
+
+static SUNErrCode iluAnalyze(SUNLinearSolver S, SUNMatrix A)
+{
+  SUNErrCode retval;
+  sunindextype N, a_nnz, i, p, r, c, lo, hi, mid;
+  sunindextype *ptrs, *vals, *arp, *arc;
+  sunindextype *rowptrs, *colind;
+  sunbooleantype csr;
+
+  iluFreeAnalysis(S);
+
+  N     = ILU_CONTENT(S)->N;
+  ptrs  = SUNSparseMatrix_IndexPointers(A);
+  vals  = SUNSparseMatrix_IndexValues(A);
+  a_nnz = ptrs[N];
+  csr   = (SUNSparseMatrix_SparseType(A) == CSR_MAT);
+
+  /* save the pattern of A */
+  ILU_CONTENT(S)->a_type = SUNSparseMatrix_SparseType(A);
+  ILU_CONTENT(S)->a_nnz  = a_nnz;
+  ILU_CONTENT(S)->a_ptrs = (sunindextype*)malloc((N + 1) * sizeof(sunindextype));
+  ILU_CONTENT(S)->a_vals =
+    (sunindextype*)malloc(SUNMAX(a_nnz, 1) * sizeof(sunindextype));
+  ILU_CONTENT(S)->amap =
+    (sunindextype*)malloc(SUNMAX(a_nnz, 1) * sizeof(sunindextype));
+  ILU_CONTENT(S)->diag = (sunindextype*)malloc(N * sizeof(sunindextype));
+  if (!ILU_CONTENT(S)->a_ptrs || !ILU_CONTENT(S)->a_vals ||
+      !ILU_CONTENT(S)->amap || !ILU_CONTENT(S)->diag)
+  {
+    iluFreeAnalysis(S);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+  memcpy(ILU_CONTENT(S)->a_ptrs, ptrs, (N + 1) * sizeof(sunindextype));
+  if (a_nnz > 0)
+  {
+    memcpy(ILU_CONTENT(S)->a_vals, vals, a_nnz * sizeof(sunindextype));
+  }
+
+  /* pattern of the factors */
+  if (ILUTYPE(S) == SUN_ILU_ILUK)
+  {
+    arp    = NULL;
+    arc    = NULL;
+    retval = iluRowPattern(A, &arp, &arc);
+    if (retval == SUN_SUCCESS)
+    {
+      retval = iluPatternILUK(S, arp, arc);
+      free(arp);
+      free(arc);
+    }
+  }
+  else
+  {
+    retval = iluPatternBlocks(S, (ILUTYPE(S) == SUN_ILU_JACOBI) ? 1
+                                                                : BLOCKSIZE(S));
+  }
+  if (retval != SUN_SUCCESS)
+  {
+    iluFreeAnalysis(S);
+    return retval;
+  }
+
+  ILU_CONTENT(S)->lu =
+    (sunrealtype*)malloc(ILU_CONTENT(S)->nnz * sizeof(sunrealtype));
+  if (ILU_CONTENT(S)->lu == NULL)
+  {
+    iluFreeAnalysis(S);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  /* find each entry of A in its row of the factors, entries outside the
+     pattern are dropped */
+  rowptrs = ILU_CONTENT(S)->rowptrs;
+  colind  = ILU_CONTENT(S)->colind;
+  for (i = 0; i < N; i++)
+  {
+    for (p = ptrs[i]; p < ptrs[i + 1]; p++)
+    {
+      r  = csr ? i : vals[p];
+      c  = csr ? vals[p] : i;
+      lo = rowptrs[r];
+      hi = rowptrs[r + 1];
+      while (lo < hi)
+      {
+        mid = (lo + hi) / 2;
+        if (colind[mid] < c) { lo = mid + 1; }
+        else { hi = mid; }
+      }
+      ILU_CONTENT(S)->amap[p] = (lo < rowptrs[r + 1] && colind[lo] == c) ? lo
+                                                                         : -1;
+    }
+  }
+
+  /* level schedules of the L and U solves */
+  retval = iluLevels(N, rowptrs, colind, ILU_CONTENT(S)->diag, SUNTRUE,
+                     &ILU_CONTENT(S)->nlevL, &ILU_CONTENT(S)->levptrL,
+                     &ILU_CONTENT(S)->levrowsL);
+  if (retval == SUN_SUCCESS)
+  {
+    retval = iluLevels(N, rowptrs, colind, ILU_CONTENT(S)->diag, SUNFALSE,
+                       &ILU_CONTENT(S)->nlevU, &ILU_CONTENT(S)->levptrU,
+                       &ILU_CONTENT(S)->levrowsU);
+  }
+  if (retval != SUN_SUCCESS)
+  {
+    iluFreeAnalysis(S);
+    return retval;
+  }
+
+  CURRENT(S) = SUNTRUE;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Return the pattern of A by rows (rp, rc), the columns of a row are not
+ * sorted and may repeat
+ */
+
+static SUNErrCode iluRowPattern(SUNMatrix A, sunindextype** rp,
+                                sunindextype** rc)
+{
+  sunindextype N, nnz, i, p, r;
+  sunindextype *ptrs, *vals, *arp, *arc;
+
+  N    = SUNSparseMatrix_Rows(A);
+  ptrs = SUNSparseMatrix_IndexPointers(A);
+  vals = SUNSparseMatrix_IndexValues(A);
+  nnz  = ptrs[N];
+
+  arp = (sunindextype*)malloc((N + 1) * sizeof(sunindextype));
+  arc = (sunindextype*)malloc(SUNMAX(nnz, 1) * sizeof(sunindextype));
+  if (!arp || !arc)
+  {
+    free(arp);
+    free(arc);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  if (SUNSparseMatrix_SparseType(A) == CSR_MAT)
+  {
+    memcpy(arp, ptrs, (N + 1) * sizeof(sunindextype));
+    if (nnz > 0) { memcpy(arc, vals, nnz * sizeof(sunindextype)); }
+  }
+  else
+  {
+    /* count the entries of each row, then place the column indices */
+    for (i = 0; i <= N; i++) { arp[i] = 0; }
+    for (p = 0; p < nnz; p++) { arp[vals[p] + 1]++; }
+    for (i = 0; i < N; i++) { arp[i + 1] += arp[i]; }
+    for (i = 0; i < N; i++)
+    {
+      for (p = ptrs[i]; p < ptrs[i + 1]; p++)
+      {
+        r           = vals[p];
+        arc[arp[r]] = i;
+        arp[r]++;
+      }
+    }
+    for (i = N; i > 0; i--) { arp[i] = arp[i - 1]; }
+    arp[0] = 0;
+  }
+
+  *rp = arp;
+  *rc = arc;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Symbolic ILU(k). The columns of row i are kept in a sorted linked list
+ * (next, with head next[N] and terminator N) together with their levels.
+ * Eliminating with an earlier row k adds column j of the U part of row k at
+ * level lev(i,k) + lev(k,j) + 1 when that level does not exceed the fill
+ * level, or lowers the level of column j when it is already present. The
+ * diagonal is always included.
+ */
+
+static SUNErrCode iluPatternILUK(SUNLinearSolver S, sunindextype* arp,
+                                 sunindextype* arc)
+{
+  sunindextype N, i, j, k, p, q, prev, len, cap, nnz, nl;
+  sunindextype *next, *lvl, *mark, *cols, *rowptrs, *colind, *levs, *diag;
+  sunindextype *tmp, *tmp2;
+  int fill;
+
+  N    = ILU_CONTENT(S)->N;
+  fill = FILL(S);
+  diag = ILU_CONTENT(S)->diag;
+
+  next    = (sunindextype*)malloc((N + 1) * sizeof(sunindextype));
+  lvl     = (sunindextype*)malloc(N * sizeof(sunindextype));
+  mark    = (sunindextype*)malloc(N * sizeof(sunindextype));
+  cols    = (sunindextype*)malloc((N + 1) * sizeof(sunindextype));
+  rowptrs = (sunindextype*)malloc((N + 1) * sizeof(sunindextype));
+  cap     = arp[N] + N;
+  colind  = (sunindextype*)malloc(cap * sizeof(sunindextype));
+  levs    = (sunindextype*)malloc(cap * sizeof(sunindextype));
+  if (!next || !lvl || !mark || !cols || !rowptrs || !colind || !levs)
+  {
+    free(next);
+    free(lvl);
+    free(mark);
+    free(cols);
+    free(rowptrs);
+    free(colind);
+    free(levs);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+  for (j = 0; j < N; j++) { mark[j] = -1; }
+
+  nnz        = 0;
+  rowptrs[0] = 0;
+  for (i = 0; i < N; i++)
+  {
+    /* the distinct columns of row i of A and the diagonal, in order */
+    len       = 0;
+    mark[i]   = i;
+    cols[len] = i;
+    len++;
+    for (p = arp[i]; p < arp[i + 1]; p++)
+    {
+      j = arc[p];
+      if (mark[j] == i) { continue; }
+      mark[j]   = i;
+      cols[len] = j;
+      len++;
+    }
+    qsort(cols, len, sizeof(sunindextype), iluCompareIndex);
+
+    prev = N;
+    for (p = 0; p < len; p++)
+    {
+      next[prev]   = cols[p];
+      lvl[cols[p]] = 0;
+      prev         = cols[p];
+    }
+    next[prev] = N;
+
+    /* eliminate with the rows k < i in increasing order */
+    for (k = next[N]; k < i; k = next[k])
+    {
+      if (lvl[k] >= fill) { continue; }
+      prev = k;
+      for (q = diag[k] + 1; q < rowptrs[k + 1]; q++)
+      {
+        j  = colind[q];
+        nl = lvl[k] + levs[q] + 1;
+        if (nl > fill) { continue; }
+        while (next[prev] < j) { prev = next[prev]; }
+        if (mark[j] == i) { lvl[j] = SUNMIN(lvl[j], nl); }
+        else
+        {
+          next[j]    = next[prev];
+          next[prev] = j;
+          mark[j]    = i;
+          lvl[j]     = nl;
+        }
+        prev = j;
+      }
+    }
+
+    /* append row i, growing the storage of the factors when needed */
+    len = 0;
+    for (j = next[N]; j < N; j = next[j])
+    {
+      cols[len] = j;
+      len++;
+    }
+    if (nnz + len > cap)
+    {
+      cap = SUNMAX(2 * cap, nnz + len);
+      tmp = (sunindextype*)realloc(colind, cap * sizeof(sunindextype));
+      if (tmp) { colind = tmp; }
+      tmp2 = (sunindextype*)realloc(levs, cap * sizeof(sunindextype));
+      if (tmp2) { levs = tmp2; }
+      if (!tmp || !tmp2)
+      {
+        free(next);
+        free(lvl);
+        free(mark);
+        free(cols);
+        free(rowptrs);
+        free(colind);
+        free(levs);
+        return SUN_ERR_MALLOC_FAIL;
+      }
+    }
+    for (p = 0; p < len; p++)
+    {
+      j = cols[p];
+      if (j == i) { diag[i] = nnz; }
+      colind[nnz] = j;
+      levs[nnz]   = lvl[j];
+      nnz++;
+    }
+    rowptrs[i + 1] = nnz;
+  }
+
+  free(next);
+  free(lvl);
+  free(mark);
+  free(cols);
+  free(levs);
+
+  ILU_CONTENT(S)->nnz     = nnz;
+  ILU_CONTENT(S)->rowptrs = rowptrs;
+  ILU_CONTENT(S)->colind  = colind;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Pattern of the dense diagonal blocks of size bs (the last block may be
+ * smaller), bs = 1 gives the diagonal
+ */
+
+static SUNErrCode iluPatternBlocks(SUNLinearSolver S, sunindextype bs)
+{
+  sunindextype N, i, j, s, e, nnz;
+  sunindextype *rowptrs, *colind, *diag;
+
+  N    = ILU_CONTENT(S)->N;
+  diag = ILU_CONTENT(S)->diag;
+  bs   = SUNMIN(bs, SUNMAX(N, 1));
+
+  /* each row holds its block, only the last block can be smaller */
+  nnz = (N / bs) * bs * bs + (N % bs) * (N % bs);
+
+  rowptrs = (sunindextype*)malloc((N + 1) * sizeof(sunindextype));
+  colind  = (sunindextype*)malloc(SUNMAX(nnz, 1) * sizeof(sunindextype));
+  if (!rowptrs || !colind)
+  {
+    free(rowptrs);
+    free(colind);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  nnz        = 0;
+  rowptrs[0] = 0;
+  for (i = 0; i < N; i++)
+  {
+    s = (i / bs) * bs;
+    e = SUNMIN(s + bs, N);
+    for (j = s; j < e; j++)
+    {
+      if (j == i) { diag[i] = nnz; }
+      colind[nnz] = j;
+      nnz++;
+    }
+    rowptrs[i + 1] = nnz;
+  }
+
+  ILU_CONTENT(S)->nnz     = nnz;
+  ILU_CONTENT(S)->rowptrs = rowptrs;
+  ILU_CONTENT(S)->colind  = colind;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Level schedule of the L (lower = SUNTRUE) or U solve: the level of a row is
+ * one more than the highest level of the rows it depends on. The rows are
+ * returned grouped by level in levrows, level l is levrows[levptr[l]] to
+ * levrows[levptr[l+1]-1].
+ */
+
+static SUNErrCode iluLevels(sunindextype N, sunindextype* rowptrs,
+                            sunindextype* colind, sunindextype* diag,
+                            sunbooleantype lower, sunindextype* nlev,
+                            sunindextype** levptr, sunindextype** levrows)
+{
+  sunindextype i, ii, p, lev, maxlev, start, end;
+  sunindextype *level, *ptr, *rows;
+
+  level = (sunindextype*)malloc(SUNMAX(N, 1) * sizeof(sunindextype));
+  rows  = (sunindextype*)malloc(SUNMAX(N, 1) * sizeof(sunindextype));
+  if (!level || !rows)
+  {
+    free(level);
+    free(rows);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  maxlev = -1;
+  for (ii = 0; ii < N; ii++)
+  {
+    i     = lower ? ii : N - 1 - ii;
+    start = lower ? rowptrs[i] : diag[i] + 1;
+    end   = lower ? diag[i] : rowptrs[i + 1];
+    lev   = 0;
+    for (p = start; p < end; p++) { lev = SUNMAX(lev, level[colind[p]] + 1); }
+    level[i] = lev;
+    maxlev   = SUNMAX(maxlev, lev);
+  }
+
+  ptr = (sunindextype*)malloc((maxlev + 2) * sizeof(sunindextype));
+  if (!ptr)
+  {
+    free(level);
+    free(rows);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  /* counting sort of the rows by level, in the order of the solve */
+  for (lev = 0; lev <= maxlev + 1; lev++) { ptr[lev] = 0; }
+  for (i = 0; i < N; i++) { ptr[level[i] + 1]++; }
+  for (lev = 0; lev <= maxlev; lev++) { ptr[lev + 1] += ptr[lev]; }
+  for (ii = 0; ii < N; ii++)
+  {
+    i                    = lower ? ii : N - 1 - ii;
+    rows[ptr[level[i]]] = i;
+    ptr[level[i]]++;
+  }
+  for (lev = maxlev + 1; lev > 0; lev--) { ptr[lev] = ptr[lev - 1]; }
+  ptr[0] = 0;
+
+  free(level);
+
+  *nlev    = maxlev + 1;
+  *levptr  = ptr;
+  *levrows = rows;
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Free the data of the last analysis
+ */
+
+static void iluFreeAnalysis(SUNLinearSolver S)
+{
+  SUNLinearSolverContent_ILU content = ILU_CONTENT(S);
+
+  free(content->a_ptrs);
+  free(content->a_vals);
+  free(content->amap);
+  free(content->rowptrs);
+  free(content->colind);
+  free(content->diag);
+  free(content->lu);
+  free(content->levptrL);
+  free(content->levrowsL);
+  free(content->levptrU);
+  free(content->levrowsU);
+
+  content->a_type   = -1;
+  content->a_nnz    = 0;
+  content->a_ptrs   = NULL;
+  content->a_vals   = NULL;
+  content->amap     = NULL;
+  content->nnz      = 0;
+  content->rowptrs  = NULL;
+  content->colind   = NULL;
+  content->diag     = NULL;
+  content->lu       = NULL;
+  content->nlevL    = 0;
+  content->levptrL  = NULL;
+  content->levrowsL = NULL;
+  content->nlevU    = 0;
+  content->levptrU  = NULL;
+  content->levrowsU = NULL;
+  content->current  = SUNFALSE;
+}
+
+static int iluCompareIndex(const void* a, const void* b)
+{
+  sunindextype ia = *(const sunindextype*)a;
+  sunindextype ib = *(const sunindextype*)b;
+  return (ia > ib) - (ia < ib);
+}
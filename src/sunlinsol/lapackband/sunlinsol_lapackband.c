@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <sundials/sundials_band.h>
 #include <sundials/sundials_math.h>
 #include <sunlinsol/sunlinsol_lapackband.h>
 
@@ -37,6 +38,7 @@
 #endif
 
 #define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
 #define ONE  SUN_RCONST(1.0)
 
 /*
@@ -48,6 +50,26 @@
 #define LAPACKBAND_CONTENT(S) ((SUNLinearSolverContent_LapackBand)(S->content))
 #define PIVOTS(S)             (LAPACKBAND_CONTENT(S)->pivots)
 #define LASTFLAG(S)           (LAPACKBAND_CONTENT(S)->last_flag)
+#define MIXED(S)              (LAPACKBAND_CONTENT(S)->mixed)
+#define MAXREFINE(S)          (LAPACKBAND_CONTENT(S)->max_refine)
+#define DFACTORED(S)          (LAPACKBAND_CONTENT(S)->dfactored)
+#define SDATA(S)              (LAPACKBAND_CONTENT(S)->sdata)
+#define SWORK(S)              (LAPACKBAND_CONTENT(S)->swork)
+#define SLDIM(S)              (LAPACKBAND_CONTENT(S)->sldim)
+#define RES(S)                (LAPACKBAND_CONTENT(S)->res)
+#define RTOL(S)               (LAPACKBAND_CONTENT(S)->rtol)
+#define LASTREFINE(S)         (LAPACKBAND_CONTENT(S)->last_refine)
+#define NUMREFINE(S)          (LAPACKBAND_CONTENT(S)->num_refine)
+#define NUMFALLBACK(S)        (LAPACKBAND_CONTENT(S)->num_fallback)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static int lapackBandRefine(SUNLinearSolver S, SUNMatrix A, sunrealtype* x,
+                            sunrealtype* b);
 
 /*
  * -----------------------------------------------------------------
@@ -91,6 +113,7 @@ SUNLinearSolver SUNLinSol_LapackBand(N_Vector y, SUNMatrix A, SUNContext sunctx)
   S->ops->initialize = SUNLinSolInitialize_LapackBand;
   S->ops->setup      = SUNLinSolSetup_LapackBand;
   S->ops->solve      = SUNLinSolSolve_LapackBand;
+  S->ops->numiters   = SUNLinSolNumIters_LapackBand;
   S->ops->lastflag   = SUNLinSolLastFlag_LapackBand;
   S->ops->space      = SUNLinSolSpace_LapackBand;
   S->ops->free       = SUNLinSolFree_LapackBand;
@@ -108,9 +131,20 @@ SUNLinearSolver SUNLinSol_LapackBand(N_Vector y, SUNMatrix A, SUNContext sunctx)
   S->content = content;
 
   /* Fill content */
-  content->N         = MatrixRows;
-  content->last_flag = 0;
-  content->pivots    = NULL;
+  content->N            = MatrixRows;
+  content->last_flag    = 0;
+  content->pivots       = NULL;
+  content->mixed        = SUNFALSE;
+  content->max_refine   = 0;
+  content->dfactored    = SUNTRUE;
+  content->sdata        = NULL;
+  content->swork        = NULL;
+  content->sldim        = 0;
+  content->res          = NULL;
+  content->rtol         = ZERO;
+  content->last_refine  = 0;
+  content->num_refine   = 0;
+  content->num_fallback = 0;
 
   /* Allocate content */
   content->pivots = (sunindextype*)malloc(MatrixRows * sizeof(sunindextype));
@@ -123,6 +157,44 @@ SUNLinearSolver SUNLinSol_LapackBand(N_Vector y, SUNMatrix A, SUNContext sunctx)
   return (S);
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to factor the matrix in single precision and refine the solutions
+ */
+
+SUNErrCode SUNLinSol_LapackBand_SetMixedPrecision(SUNLinearSolver S,
+                                                  sunbooleantype onoff,
+                                                  int max_refine)
+{
+  if (S == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  if (max_refine < 0) { return SUN_ERR_ARG_OUTOFRANGE; }
+
+  MIXED(S)     = onoff;
+  MAXREFINE(S) = max_refine;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to get the total numbers of refinement iterations and of
+ * factorizations in sunrealtype after a failure in single precision
+ */
+
+SUNErrCode SUNLinSol_LapackBand_GetNumRefinements(SUNLinearSolver S,
+                                                  long int* num_refine)
+{
+  if ((S == NULL) || (num_refine == NULL)) { return SUN_ERR_ARG_CORRUPT; }
+  *num_refine = NUMREFINE(S);
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_LapackBand_GetNumFallbacks(SUNLinearSolver S,
+                                                long int* num_fallback)
+{
+  if ((S == NULL) || (num_fallback == NULL)) { return SUN_ERR_ARG_CORRUPT; }
+  *num_fallback = NUMFALLBACK(S);
+  return SUN_SUCCESS;
+}
+
 /*
  * -----------------------------------------------------------------
  * implementation of linear solver operations
@@ -149,7 +221,8 @@ SUNErrCode SUNLinSolInitialize_LapackBand(SUNLinearSolver S)
 
 int SUNLinSolSetup_LapackBand(SUNLinearSolver S, SUNMatrix A)
 {
-  sunindextype n, ml, mu, ldim, ier;
+  sunindextype i, j, n, ml, mu, ldim, ier;
+  sunrealtype *col_j, anorm;
 
   /* check for valid inputs */
   if ((A == NULL) || (S == NULL)) { return SUN_ERR_ARG_CORRUPT; }
@@ -161,12 +234,78 @@ int SUNLinSolSetup_LapackBand(SUNLinearSolver S, SUNMatrix A)
     return SUN_ERR_ARG_INCOMPATIBLE;
   }
 
-  /* Call LAPACK to do LU factorization of A */
-  ier  = 0;
   n    = SUNBandMatrix_Rows(A);
   ml   = SUNBandMatrix_LowerBandwidth(A);
   mu   = SUNBandMatrix_UpperBandwidth(A);
   ldim = SUNBandMatrix_LDim(A);
+
+  /* in mixed precision, factor a single precision copy of A and keep A for
+     the residuals of the refinement */
+  if (MIXED(S))
+  {
+    if (SDATA(S) != NULL && SLDIM(S) != ldim)
+    {
+      free(SDATA(S));
+      SDATA(S) = NULL;
+    }
+    if (SDATA(S) == NULL)
+    {
+      SDATA(S) = (float*)malloc(n * ldim * sizeof(float));
+      if (SWORK(S) == NULL) { SWORK(S) = (float*)malloc(n * sizeof(float)); }
+      if (RES(S) == NULL)
+      {
+        RES(S) = (sunrealtype*)malloc(n * sizeof(sunrealtype));
+      }
+      if (SDATA(S) == NULL || SWORK(S) == NULL || RES(S) == NULL)
+      {
+        free(SDATA(S));
+        free(SWORK(S));
+        free(RES(S));
+        SDATA(S)    = NULL;
+        SWORK(S)    = NULL;
+        RES(S)      = NULL;
+        LASTFLAG(S) = SUN_ERR_MALLOC_FAIL;
+        return SUN_ERR_MALLOC_FAIL;
+      }
+      SLDIM(S) = ldim;
+    }
+
+    /* copy A, including the fill-in rows, and compute its infinity norm from
+       the row sums */
+    for (j = 0; j < n * ldim; j++)
+    {
+      SDATA(S)[j] = (float)SUNBandMatrix_Data(A)[j];
+    }
+    for (i = 0; i < n; i++) { RES(S)[i] = ZERO; }
+    for (j = 0; j < n; j++)
+    {
+      col_j = SUNBandMatrix_Column(A, j);
+      for (i = SUNMAX(0, j - mu); i <= SUNMIN(n - 1, j + ml); i++)
+      {
+        RES(S)[i] += SUNRabs(col_j[i - j]);
+      }
+    }
+    anorm = ZERO;
+    for (i = 0; i < n; i++) { anorm = SUNMAX(anorm, RES(S)[i]); }
+    RTOL(S) = SUNRsqrt((sunrealtype)n) * SUN_UNIT_ROUNDOFF * anorm;
+
+    ier = 0;
+    sgbtrf_f77(&n, &n, &ml, &mu, SDATA(S), &ldim, PIVOTS(S), &ier);
+    LASTFLAG(S) = ier;
+    if (ier < 0) { return SUN_ERR_EXT_FAIL; }
+    if (ier == 0)
+    {
+      DFACTORED(S) = SUNFALSE;
+      return SUN_SUCCESS;
+    }
+
+    /* the copy is singular in single precision, factor A instead */
+    NUMFALLBACK(S)++;
+  }
+  DFACTORED(S) = SUNTRUE;
+
+  /* Call LAPACK to do LU factorization of A */
+  ier = 0;
   xgbtrf_f77(&n, &n, &ml, &mu, SUNBandMatrix_Data(A), &ldim, PIVOTS(S), &ier);
 
   LASTFLAG(S) = ier;
@@ -179,7 +318,7 @@ int SUNLinSolSolve_LapackBand(SUNLinearSolver S, SUNMatrix A, N_Vector x,
                               N_Vector b, SUNDIALS_MAYBE_UNUSED sunrealtype tol)
 {
   sunindextype n, ml, mu, ldim, one, ier;
-  sunrealtype* xdata;
+  sunrealtype *xdata, *bdata;
 
   /* check for valid inputs */
   if ((A == NULL) || (S == NULL) || (x == NULL) || (b == NULL))
@@ -187,6 +326,8 @@ int SUNLinSolSolve_LapackBand(SUNLinearSolver S, SUNMatrix A, N_Vector x,
     return SUN_ERR_ARG_CORRUPT;
   }
 
+  LASTREFINE(S) = 0;
+
   /* copy b into x */
   N_VScale(ONE, b, x);
 
@@ -198,13 +339,48 @@ int SUNLinSolSolve_LapackBand(SUNLinearSolver S, SUNMatrix A, N_Vector x,
     return SUN_ERR_MEM_FAIL;
   }
 
-  /* Call LAPACK to solve the linear system */
-  ier  = 0;
   n    = SUNBandMatrix_Rows(A);
   ml   = SUNBandMatrix_LowerBandwidth(A);
   mu   = SUNBandMatrix_UpperBandwidth(A);
   ldim = SUNBandMatrix_LDim(A);
-  one  = 1;
+
+  /* solve with the single precision factors and refine the solution */
+  if (!DFACTORED(S))
+  {
+    bdata = N_VGetArrayPointer(b);
+    if (bdata == NULL)
+    {
+      LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+      return SUN_ERR_MEM_FAIL;
+    }
+
+    ier = lapackBandRefine(S, A, xdata, bdata);
+    if (ier < 0)
+    {
+      LASTFLAG(S) = ier;
+      return SUN_ERR_EXT_FAIL;
+    }
+    if (ier == 0)
+    {
+      LASTFLAG(S) = SUN_SUCCESS;
+      return SUN_SUCCESS;
+    }
+
+    /* the refinement did not converge, factor A in sunrealtype */
+    NUMFALLBACK(S)++;
+    DFACTORED(S) = SUNTRUE;
+    ier          = 0;
+    xgbtrf_f77(&n, &n, &ml, &mu, SUNBandMatrix_Data(A), &ldim, PIVOTS(S), &ier);
+    LASTFLAG(S) = ier;
+    if (ier > 0) { return (SUNLS_LUFACT_FAIL); }
+    if (ier < 0) { return SUN_ERR_EXT_FAIL; }
+
+    N_VScale(ONE, b, x);
+  }
+
+  /* Call LAPACK to solve the linear system */
+  ier = 0;
+  one = 1;
   xgbtrs_f77("N", &n, &ml, &mu, &one, SUNBandMatrix_Data(A), &ldim, PIVOTS(S),
              xdata, &n, &ier);
   LASTFLAG(S) = ier;
@@ -214,6 +390,12 @@ int SUNLinSolSolve_LapackBand(SUNLinearSolver S, SUNMatrix A, N_Vector x,
   return SUN_SUCCESS;
 }
 
+int SUNLinSolNumIters_LapackBand(SUNLinearSolver S)
+{
+  /* return the number of refinement iterations in the last solve */
+  return (LASTREFINE(S));
+}
+
 sunindextype SUNLinSolLastFlag_LapackBand(SUNLinearSolver S)
 {
   return (LASTFLAG(S));
@@ -224,6 +406,14 @@ SUNErrCode SUNLinSolSpace_LapackBand(SUNLinearSolver S, long int* lenrwLS,
 {
   *lenrwLS = 0;
   *leniwLS = 2 + LAPACKBAND_CONTENT(S)->N;
+  if (SDATA(S))
+  {
+    /* single precision factors and work array, and residual */
+    *lenrwLS = LAPACKBAND_CONTENT(S)->N +
+               ((SLDIM(S) + 1) * LAPACKBAND_CONTENT(S)->N * sizeof(float) +
+                sizeof(sunrealtype) - 1) /
+                 sizeof(sunrealtype);
+  }
   return SUN_SUCCESS;
 }
 
@@ -240,6 +430,9 @@ SUNErrCode SUNLinSolFree_LapackBand(SUNLinearSolver S)
       free(PIVOTS(S));
       PIVOTS(S) = NULL;
     }
+    free(SDATA(S));
+    free(SWORK(S));
+    free(RES(S));
     free(S->content);
     S->content = NULL;
   }
@@ -252,3 +445,76 @@ SUNErrCode SUNLinSolFree_LapackBand(SUNLinearSolver S)
   S = NULL;
   return SUN_SUCCESS;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Solve with the single precision factors and refine the solution x, which
+ * holds b on input, with residuals computed in sunrealtype. Returns 0 on
+ * success, 1 if the residual does not meet the tolerance within max_refine
+ * iterations or is not at least halved by an iteration, or the negative
+ * value returned by LAPACK.
+ */
+
+static int lapackBandRefine(SUNLinearSolver S, SUNMatrix A, sunrealtype* x,
+                            sunrealtype* b)
+{
+  sunindextype i, n, ml, mu, ldim, one, ier;
+  sunrealtype *r, rnorm, rnorm_old, xnorm;
+  float* w;
+  int iter;
+
+  n    = SUNBandMatrix_Rows(A);
+  ml   = SUNBandMatrix_LowerBandwidth(A);
+  mu   = SUNBandMatrix_UpperBandwidth(A);
+  ldim = SUNBandMatrix_LDim(A);
+  one  = 1;
+  ier  = 0;
+  r    = RES(S);
+  w    = SWORK(S);
+
+  for (i = 0; i < n; i++) { w[i] = (float)x[i]; }
+  sgbtrs_f77("N", &n, &ml, &mu, &one, SDATA(S), &ldim, PIVOTS(S), w, &n, &ier);
+  if (ier < 0) { return ((int)ier); }
+  for (i = 0; i < n; i++) { x[i] = w[i]; }
+
+  rnorm_old = SUN_BIG_REAL;
+  for (iter = 0;; iter++)
+  {
+    /* r = b - A x */
+    SUNDlsMat_bandMatvec(SUNBandMatrix_Cols(A), x, r, n, mu, ml,
+                         SUNBandMatrix_StoredUpperBandwidth(A));
+    rnorm = ZERO;
+    xnorm = ZERO;
+    for (i = 0; i < n; i++)
+    {
+      r[i]  = b[i] - r[i];
+      rnorm = SUNMAX(rnorm, SUNRabs(r[i]));
+      xnorm = SUNMAX(xnorm, SUNRabs(x[i]));
+    }
+
+    if (rnorm <= RTOL(S) * xnorm) { break; }
+    if (iter == MAXREFINE(S) || rnorm > HALF * rnorm_old)
+    {
+      LASTREFINE(S) = iter;
+      NUMREFINE(S) += iter;
+      return (1);
+    }
+    rnorm_old = rnorm;
+
+    /* x = x + (LU)^{-1} r */
+    for (i = 0; i < n; i++) { w[i] = (float)r[i]; }
+    sgbtrs_f77("N", &n, &ml, &mu, &one, SDATA(S), &ldim, PIVOTS(S), w, &n,
+               &ier);
+    if (ier < 0) { return ((int)ier); }
+    for (i = 0; i < n; i++) { x[i] += w[i]; }
+  }
+
+  LASTREFINE(S) = iter;
+  NUMREFINE(S) += iter;
+  return (0);
+}
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <sundials/sundials_dense.h>
 #include <sundials/sundials_math.h>
 #include <sunlinsol/sunlinsol_lapackdense.h>
 
@@ -37,6 +38,7 @@
 #endif
 
 #define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
 #define ONE  SUN_RCONST(1.0)
 
 /*
@@ -47,8 +49,27 @@
 
 #define LAPACKDENSE_CONTENT(S) \
   ((SUNLinearSolverContent_LapackDense)(S->content))
-#define PIVOTS(S)   (LAPACKDENSE_CONTENT(S)->pivots)
-#define LASTFLAG(S) (LAPACKDENSE_CONTENT(S)->last_flag)
+#define PIVOTS(S)      (LAPACKDENSE_CONTENT(S)->pivots)
+#define LASTFLAG(S)    (LAPACKDENSE_CONTENT(S)->last_flag)
+#define MIXED(S)       (LAPACKDENSE_CONTENT(S)->mixed)
+#define MAXREFINE(S)   (LAPACKDENSE_CONTENT(S)->max_refine)
+#define DFACTORED(S)   (LAPACKDENSE_CONTENT(S)->dfactored)
+#define SDATA(S)       (LAPACKDENSE_CONTENT(S)->sdata)
+#define SWORK(S)       (LAPACKDENSE_CONTENT(S)->swork)
+#define RES(S)         (LAPACKDENSE_CONTENT(S)->res)
+#define RTOL(S)        (LAPACKDENSE_CONTENT(S)->rtol)
+#define LASTREFINE(S)  (LAPACKDENSE_CONTENT(S)->last_refine)
+#define NUMREFINE(S)   (LAPACKDENSE_CONTENT(S)->num_refine)
+#define NUMFALLBACK(S) (LAPACKDENSE_CONTENT(S)->num_fallback)
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static int lapackDenseRefine(SUNLinearSolver S, SUNMatrix A, sunrealtype* x,
+                             sunrealtype* b);
 
 /*
  * -----------------------------------------------------------------
@@ -92,6 +113,7 @@ SUNLinearSolver SUNLinSol_LapackDense(N_Vector y, SUNMatrix A, SUNContext sunctx
   S->ops->initialize = SUNLinSolInitialize_LapackDense;
   S->ops->setup      = SUNLinSolSetup_LapackDense;
   S->ops->solve      = SUNLinSolSolve_LapackDense;
+  S->ops->numiters   = SUNLinSolNumIters_LapackDense;
   S->ops->lastflag   = SUNLinSolLastFlag_LapackDense;
   S->ops->space      = SUNLinSolSpace_LapackDense;
   S->ops->free       = SUNLinSolFree_LapackDense;
@@ -109,9 +131,19 @@ SUNLinearSolver SUNLinSol_LapackDense(N_Vector y, SUNMatrix A, SUNContext sunctx
   S->content = content;
 
   /* Fill content */
-  content->N         = MatrixRows;
-  content->last_flag = 0;
-  content->pivots    = NULL;
+  content->N            = MatrixRows;
+  content->last_flag    = 0;
+  content->pivots       = NULL;
+  content->mixed        = SUNFALSE;
+  content->max_refine   = 0;
+  content->dfactored    = SUNTRUE;
+  content->sdata        = NULL;
+  content->swork        = NULL;
+  content->res          = NULL;
+  content->rtol         = ZERO;
+  content->last_refine  = 0;
+  content->num_refine   = 0;
+  content->num_fallback = 0;
 
   /* Allocate content */
   content->pivots = (sunindextype*)malloc(MatrixRows * sizeof(sunindextype));
@@ -124,6 +156,44 @@ SUNLinearSolver SUNLinSol_LapackDense(N_Vector y, SUNMatrix A, SUNContext sunctx
   return (S);
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to factor the matrix in single precision and refine the solutions
+ */
+
+SUNErrCode SUNLinSol_LapackDense_SetMixedPrecision(SUNLinearSolver S,
+                                                   sunbooleantype onoff,
+                                                   int max_refine)
+{
+  if (S == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  if (max_refine < 0) { return SUN_ERR_ARG_OUTOFRANGE; }
+
+  MIXED(S)     = onoff;
+  MAXREFINE(S) = max_refine;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to get the total numbers of refinement iterations and of
+ * factorizations in sunrealtype after a failure in single precision
+ */
+
+SUNErrCode SUNLinSol_LapackDense_GetNumRefinements(SUNLinearSolver S,
+                                                   long int* num_refine)
+{
+  if ((S == NULL) || (num_refine == NULL)) { return SUN_ERR_ARG_CORRUPT; }
+  *num_refine = NUMREFINE(S);
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNLinSol_LapackDense_GetNumFallbacks(SUNLinearSolver S,
+                                                 long int* num_fallback)
+{
+  if ((S == NULL) || (num_fallback == NULL)) { return SUN_ERR_ARG_CORRUPT; }
+  *num_fallback = NUMFALLBACK(S);
+  return SUN_SUCCESS;
+}
+
 /*
  * -----------------------------------------------------------------
  * implementation of linear solver operations
@@ -150,7 +220,8 @@ SUNErrCode SUNLinSolInitialize_LapackDense(SUNLinearSolver S)
 
 int SUNLinSolSetup_LapackDense(SUNLinearSolver S, SUNMatrix A)
 {
-  sunindextype n, ier;
+  sunindextype i, j, n, ier;
+  sunrealtype *data, anorm;
 
   /* check for valid inputs */
   if ((A == NULL) || (S == NULL)) { return SUN_ERR_ARG_CORRUPT; }
@@ -162,8 +233,60 @@ int SUNLinSolSetup_LapackDense(SUNLinearSolver S, SUNMatrix A)
     return SUN_ERR_ARG_INCOMPATIBLE;
   }
 
+  /* in mixed precision, factor a single precision copy of A and keep A for
+     the residuals of the refinement */
+  n = SUNDenseMatrix_Rows(A);
+  if (MIXED(S))
+  {
+    if (SDATA(S) == NULL)
+    {
+      SDATA(S) = (float*)malloc(n * n * sizeof(float));
+      SWORK(S) = (float*)malloc(n * sizeof(float));
+      RES(S)   = (sunrealtype*)malloc(n * sizeof(sunrealtype));
+      if (SDATA(S) == NULL || SWORK(S) == NULL || RES(S) == NULL)
+      {
+        free(SDATA(S));
+        free(SWORK(S));
+        free(RES(S));
+        SDATA(S)    = NULL;
+        SWORK(S)    = NULL;
+        RES(S)      = NULL;
+        LASTFLAG(S) = SUN_ERR_MALLOC_FAIL;
+        return SUN_ERR_MALLOC_FAIL;
+      }
+    }
+
+    /* copy A and compute its infinity norm from the row sums */
+    data = SUNDenseMatrix_Data(A);
+    for (i = 0; i < n; i++) { RES(S)[i] = ZERO; }
+    for (j = 0; j < n; j++)
+    {
+      for (i = 0; i < n; i++)
+      {
+        SDATA(S)[j * n + i] = (float)data[j * n + i];
+        RES(S)[i] += SUNRabs(data[j * n + i]);
+      }
+    }
+    anorm = ZERO;
+    for (i = 0; i < n; i++) { anorm = SUNMAX(anorm, RES(S)[i]); }
+    RTOL(S) = SUNRsqrt((sunrealtype)n) * SUN_UNIT_ROUNDOFF * anorm;
+
+    ier = 0;
+    sgetrf_f77(&n, &n, SDATA(S), &n, PIVOTS(S), &ier);
+    LASTFLAG(S) = ier;
+    if (ier < 0) { return SUN_ERR_EXT_FAIL; }
+    if (ier == 0)
+    {
+      DFACTORED(S) = SUNFALSE;
+      return SUN_SUCCESS;
+    }
+
+    /* the copy is singular in single precision, factor A instead */
+    NUMFALLBACK(S)++;
+  }
+  DFACTORED(S) = SUNTRUE;
+
   /* Call LAPACK to do LU factorization of A */
-  n   = SUNDenseMatrix_Rows(A);
   ier = 0;
   xgetrf_f77(&n, &n, SUNDenseMatrix_Data(A), &n, PIVOTS(S), &ier);
   LASTFLAG(S) = ier;
@@ -176,13 +299,15 @@ int SUNLinSolSolve_LapackDense(SUNLinearSolver S, SUNMatrix A, N_Vector x,
                                N_Vector b, SUNDIALS_MAYBE_UNUSED sunrealtype tol)
 {
   sunindextype n, one, ier;
-  sunrealtype* xdata;
+  sunrealtype *xdata, *bdata;
 
   if ((A == NULL) || (S == NULL) || (x == NULL) || (b == NULL))
   {
     return SUN_ERR_ARG_CORRUPT;
   }
 
+  LASTREFINE(S) = 0;
+
   /* copy b into x */
   N_VScale(ONE, b, x);
 
@@ -194,8 +319,42 @@ int SUNLinSolSolve_LapackDense(SUNLinearSolver S, SUNMatrix A, N_Vector x,
     return SUN_ERR_MEM_FAIL;
   }
 
+  /* solve with the single precision factors and refine the solution */
+  n = SUNDenseMatrix_Rows(A);
+  if (!DFACTORED(S))
+  {
+    bdata = N_VGetArrayPointer(b);
+    if (bdata == NULL)
+    {
+      LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+      return SUN_ERR_MEM_FAIL;
+    }
+
+    ier = lapackDenseRefine(S, A, xdata, bdata);
+    if (ier < 0)
+    {
+      LASTFLAG(S) = ier;
+      return SUN_ERR_EXT_FAIL;
+    }
+    if (ier == 0)
+    {
+      LASTFLAG(S) = SUN_SUCCESS;
+      return SUN_SUCCESS;
+    }
+
+    /* the refinement did not converge, factor A in sunrealtype */
+    NUMFALLBACK(S)++;
+    DFACTORED(S) = SUNTRUE;
+    ier          = 0;
+    xgetrf_f77(&n, &n, SUNDenseMatrix_Data(A), &n, PIVOTS(S), &ier);
+    LASTFLAG(S) = ier;
+    if (ier > 0) { return (SUNLS_LUFACT_FAIL); }
+    if (ier < 0) { return SUN_ERR_EXT_FAIL; }
+
+    N_VScale(ONE, b, x);
+  }
+
   /* Call LAPACK to solve the linear system */
-  n   = SUNDenseMatrix_Rows(A);
   one = 1;
   ier = 0;
   xgetrs_f77("N", &n, &one, SUNDenseMatrix_Data(A), &n, PIVOTS(S), xdata, &n,
@@ -207,6 +366,12 @@ int SUNLinSolSolve_LapackDense(SUNLinearSolver S, SUNMatrix A, N_Vector x,
   return SUN_SUCCESS;
 }
 
+int SUNLinSolNumIters_LapackDense(SUNLinearSolver S)
+{
+  /* return the number of refinement iterations in the last solve */
+  return (LASTREFINE(S));
+}
+
 sunindextype SUNLinSolLastFlag_LapackDense(SUNLinearSolver S)
 {
   return (LASTFLAG(S));
@@ -217,6 +382,15 @@ SUNErrCode SUNLinSolSpace_LapackDense(SUNLinearSolver S, long int* lenrwLS,
 {
   *lenrwLS = 0;
   *leniwLS = 2 + LAPACKDENSE_CONTENT(S)->N;
+  if (SDATA(S))
+  {
+    /* single precision factors and work array, and residual */
+    *lenrwLS = LAPACKDENSE_CONTENT(S)->N +
+               ((LAPACKDENSE_CONTENT(S)->N + 1) * LAPACKDENSE_CONTENT(S)->N *
+                  sizeof(float) +
+                sizeof(sunrealtype) - 1) /
+                 sizeof(sunrealtype);
+  }
   return SUN_SUCCESS;
 }
 
@@ -233,6 +407,9 @@ SUNErrCode SUNLinSolFree_LapackDense(SUNLinearSolver S)
       free(PIVOTS(S));
       PIVOTS(S) = NULL;
     }
+    free(SDATA(S));
+    free(SWORK(S));
+    free(RES(S));
     free(S->content);
     S->content = NULL;
   }
@@ -245,3 +422,71 @@ SUNErrCode SUNLinSolFree_LapackDense(SUNLinearSolver S)
   S = NULL;
   return SUN_SUCCESS;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Solve with the single precision factors and refine the solution x, which
+ * holds b on input, with residuals computed in sunrealtype. Returns 0 on
+ * success, 1 if the residual does not meet the tolerance within max_refine
+ * iterations or is not at least halved by an iteration, or the negative
+ * value returned by LAPACK.
+ */
+
+static int lapackDenseRefine(SUNLinearSolver S, SUNMatrix A, sunrealtype* x,
+                             sunrealtype* b)
+{
+  sunindextype i, n, one, ier;
+  sunrealtype *r, rnorm, rnorm_old, xnorm;
+  float* w;
+  int iter;
+
+  n   = SUNDenseMatrix_Rows(A);
+  one = 1;
+  ier = 0;
+  r   = RES(S);
+  w   = SWORK(S);
+
+  for (i = 0; i < n; i++) { w[i] = (float)x[i]; }
+  sgetrs_f77("N", &n, &one, SDATA(S), &n, PIVOTS(S), w, &n, &ier);
+  if (ier < 0) { return ((int)ier); }
+  for (i = 0; i < n; i++) { x[i] = w[i]; }
+
+  rnorm_old = SUN_BIG_REAL;
+  for (iter = 0;; iter++)
+  {
+    /* r = b - A x */
+    SUNDlsMat_denseMatvec(SUNDenseMatrix_Cols(A), x, r, n, n);
+    rnorm = ZERO;
+    xnorm = ZERO;
+    for (i = 0; i < n; i++)
+    {
+      r[i]  = b[i] - r[i];
+      rnorm = SUNMAX(rnorm, SUNRabs(r[i]));
+      xnorm = SUNMAX(xnorm, SUNRabs(x[i]));
+    }
+
+    if (rnorm <= RTOL(S) * xnorm) { break; }
+    if (iter == MAXREFINE(S) || rnorm > HALF * rnorm_old)
+    {
+      LASTREFINE(S) = iter;
+      NUMREFINE(S) += iter;
+      return (1);
+    }
+    rnorm_old = rnorm;
+
+    /* x = x + (LU)^{-1} r */
+    for (i = 0; i < n; i++) { w[i] = (float)r[i]; }
+    sgetrs_f77("N", &n, &one, SDATA(S), &n, PIVOTS(S), w, &n, &ier);
+    if (ier < 0) { return ((int)ier); }
+    for (i = 0; i < n; i++) { x[i] += w[i]; }
+  }
+
+  LASTREFINE(S) = iter;
+  NUMREFINE(S) += iter;
+  return (0);
+}
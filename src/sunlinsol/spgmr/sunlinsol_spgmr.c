@@ -28,6 +28,7 @@
 #include "sundials_macros.h"
 
 #define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
 #define ONE  SUN_RCONST(1.0)
 
 /*
@@ -39,6 +40,23 @@
 #define SPGMR_CONTENT(S) ((SUNLinearSolverContent_SPGMR)(S->content))
 #define LASTFLAG(S)      (SPGMR_CONTENT(S)->last_flag)
 
+/* length of the s-step workspace for a maximum Krylov dimension maxl */
+#define SSTEP_WORK_LEN(maxl) (((maxl) + 1) * (7 * (maxl) + 1))
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static int spgmrATilde(SUNLinearSolver S, N_Vector v, N_Vector w,
+                       sunrealtype delta);
+static int spgmrSStepBlock(SUNLinearSolver S, int j, int s, sunrealtype delta,
+                           int* nblock);
+static void spgmrSetShifts(SUNLinearSolver S, int s);
+static int spgmrHessEig(int n, sunrealtype* h, sunrealtype* wr,
+                        sunrealtype* wi);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -124,6 +142,11 @@ SUNLinearSolver SUNLinSol_SPGMR(N_Vector y, int pretype, int maxl,
   content->yg           = NULL;
   content->cv           = NULL;
   content->Xv           = NULL;
+  content->sstep        = SUNSPGMR_SSTEP_DEFAULT;
+  content->newshifts    = SUNTRUE;
+  content->shifts       = NULL;
+  content->Hcopy        = NULL;
+  content->swork        = NULL;
 
   /* Allocate content */
   content->xcor = N_VClone(y);
@@ -181,6 +204,22 @@ SUNErrCode SUNLinSol_SPGMRSetMaxRestarts(SUNLinearSolver S, int maxrs)
   return SUN_SUCCESS;
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to set the number of Krylov vectors to generate and orthogonalize
+ * together in each block of s-step GMRES
+ */
+
+SUNErrCode SUNLinSol_SPGMRSetSStep(SUNLinearSolver S, int sstep)
+{
+  /* Illegal sstep implies use of default value */
+  if (sstep < 1) { sstep = SUNSPGMR_SSTEP_DEFAULT; }
+
+  /* Set sstep, the shifts of the basis are computed in the next solve */
+  SPGMR_CONTENT(S)->sstep     = sstep;
+  SPGMR_CONTENT(S)->newshifts = SUNTRUE;
+  return SUN_SUCCESS;
+}
+
 /*
  * -----------------------------------------------------------------
  * implementation of linear solver operations
@@ -277,6 +316,24 @@ SUNErrCode SUNLinSolInitialize_SPGMR(SUNLinearSolver S)
     SUNAssert(content->Xv, SUN_ERR_MALLOC_FAIL);
   }
 
+  /*    shifts of the Newton basis, copy of the Hessenberg matrix, and
+        workspace for s-step GMRES */
+  if (content->sstep > 1 && content->swork == NULL)
+  {
+    content->shifts =
+      (sunrealtype*)malloc((2 * content->maxl + 1) * sizeof(sunrealtype));
+    SUNAssert(content->shifts, SUN_ERR_MALLOC_FAIL);
+
+    content->Hcopy = (sunrealtype*)malloc((content->maxl + 1) * content->maxl *
+                                          sizeof(sunrealtype));
+    SUNAssert(content->Hcopy, SUN_ERR_MALLOC_FAIL);
+
+    content->swork =
+      (sunrealtype*)malloc(SSTEP_WORK_LEN(content->maxl) * sizeof(sunrealtype));
+    SUNAssert(content->swork, SUN_ERR_MALLOC_FAIL);
+  }
+  content->newshifts = SUNTRUE;
+
   return SUN_SUCCESS;
 }
 
@@ -329,6 +386,9 @@ int SUNLinSolSetup_SPGMR(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A)
   SUNPSetupFn Psetup = SPGMR_CONTENT(S)->Psetup;
   void* PData        = SPGMR_CONTENT(S)->PData;
 
+  /* recompute the shifts of the s-step basis for the new system */
+  SPGMR_CONTENT(S)->newshifts = SUNTRUE;
+
   /* no solver-specific setup is required, but if user-supplied
      Psetup routine exists, call that here */
   if (Psetup != NULL)
@@ -358,6 +418,8 @@ int SUNLinSolSolve_SPGMR(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A,
   sunbooleantype preOnLeft, preOnRight, scale2, scale1, converged;
   sunbooleantype* zeroguess;
   int i, j, k, l, l_plus_1, l_max, krydim, ntries, max_restarts, gstype;
+  int sstep, nblock, ncols;
+  sunrealtype* Hcopy;
   int* nli;
   void *A_data, *P_data;
   SUNATimesFn atimes;
@@ -391,6 +453,8 @@ int SUNLinSolSolve_SPGMR(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A,
   res_norm     = &(SPGMR_CONTENT(S)->resnorm);
   cv           = SPGMR_CONTENT(S)->cv;
   Xv           = SPGMR_CONTENT(S)->Xv;
+  sstep        = SUNMIN(SPGMR_CONTENT(S)->sstep, l_max);
+  Hcopy        = SPGMR_CONTENT(S)->Hcopy;
 
   /* Initialize counters and convergence flag */
   *nli      = 0;
@@ -410,6 +474,9 @@ int SUNLinSolSolve_SPGMR(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A,
   /* If preconditioning, check if psolve has been set */
   SUNAssert(!(preOnLeft || preOnRight) || psolve, SUN_ERR_ARG_CORRUPT);
 
+  /* Use standard steps until the s-step workspace has been allocated */
+  if (Hcopy == NULL) { sstep = 1; }
+
   /* Set vtemp and V[0] to initial (unscaled) residual r_0 = b - A*x_0 */
   if (*zeroguess)
   {
@@ -502,118 +569,107 @@ int SUNLinSolSolve_SPGMR(SUNLinearSolver S, SUNDIALS_MAYBE_UNUSED SUNMatrix A,
     SUNCheckLastErr();
 
     /* Inner loop: generate Krylov sequence and Arnoldi basis */
-    for (l = 0; l < l_max; l++)
+    l = 0;
+    while (l < l_max)
     {
-      (*nli)++;
-      krydim = l_plus_1 = l + 1;
-
-      /* Generate A-tilde V[l], where A-tilde = s1 P1_inv A P2_inv s2_inv */
-
-      /*   Apply right scaling: vtemp = s2_inv V[l] */
-      if (scale2)
+      /* In s-step mode, once the shifts of the Newton basis are known,
+         generate and orthogonalize the next block of vectors together */
+      nblock = 0;
+      if (sstep > 1 && !SPGMR_CONTENT(S)->newshifts)
       {
-        N_VDiv(V[l], s2, vtemp);
-        SUNCheckLastErr();
-      }
-      else
-      {
-        N_VScale(ONE, V[l], vtemp);
-        SUNCheckLastErr();
-      }
-
-      /*   Apply right preconditioner: vtemp = P2_inv s2_inv V[l] */
-      if (preOnRight)
-      {
-        N_VScale(ONE, vtemp, V[l_plus_1]);
-        SUNCheckLastErr();
-        status = psolve(P_data, V[l_plus_1], vtemp, delta, SUN_PREC_RIGHT);
+        status = spgmrSStepBlock(S, l, SUNMIN(sstep, l_max - l), delta,
+                                 &nblock);
         if (status != 0)
         {
           *zeroguess  = SUNFALSE;
-          LASTFLAG(S) = (status < 0) ? SUNLS_PSOLVE_FAIL_UNREC
-                                     : SUNLS_PSOLVE_FAIL_REC;
+          LASTFLAG(S) = status;
           return (LASTFLAG(S));
         }
       }
 
-      /* Apply A: V[l+1] = A P2_inv s2_inv V[l] */
-      status = atimes(A_data, vtemp, V[l_plus_1]);
-      if (status != 0)
+      /* Otherwise, or if the block broke down, take one Arnoldi step */
+      if (nblock == 0)
       {
-        *zeroguess  = SUNFALSE;
-        LASTFLAG(S) = (status < 0) ? SUNLS_ATIMES_FAIL_UNREC
-                                   : SUNLS_ATIMES_FAIL_REC;
-        return (LASTFLAG(S));
-      }
+        l_plus_1 = l + 1;
 
-      /* Apply left preconditioning: vtemp = P1_inv A P2_inv s2_inv V[l] */
-      if (preOnLeft)
-      {
-        status = psolve(P_data, V[l_plus_1], vtemp, delta, SUN_PREC_LEFT);
+        /* Generate A-tilde V[l], where A-tilde = s1 P1_inv A P2_inv s2_inv */
+        status = spgmrATilde(S, V[l], V[l_plus_1], delta);
         if (status != 0)
         {
           *zeroguess  = SUNFALSE;
-          LASTFLAG(S) = (status < 0) ? SUNLS_PSOLVE_FAIL_UNREC
-                                     : SUNLS_PSOLVE_FAIL_REC;
+          LASTFLAG(S) = status;
           return (LASTFLAG(S));
         }
-      }
-      else
-      {
-        N_VScale(ONE, V[l_plus_1], vtemp);
-        SUNCheckLastErr();
-      }
 
-      /* Apply left scaling: V[l+1] = s1 P1_inv A P2_inv s2_inv V[l] */
-      if (scale1)
-      {
-        N_VProd(s1, vtemp, V[l_plus_1]);
-        SUNCheckLastErr();
-      }
-      else
-      {
-        N_VScale(ONE, vtemp, V[l_plus_1]);
-        SUNCheckLastErr();
-      }
+        /*  Orthogonalize V[l+1] against previous V[i]: V[l+1] = w_tilde */
+        if (gstype == SUN_CLASSICAL_GS)
+        {
+          SUNCheckCall(SUNClassicalGS(V, Hes, l_plus_1, l_max,
+                                      &(Hes[l_plus_1][l]), cv, Xv));
+        }
+        else
+        {
+          SUNCheckCall(
+            SUNModifiedGS(V, Hes, l_plus_1, l_max, &(Hes[l_plus_1][l])));
+        }
 
-      /*  Orthogonalize V[l+1] against previous V[i]: V[l+1] = w_tilde */
-      if (gstype == SUN_CLASSICAL_GS)
-      {
-        SUNCheckCall(
-          SUNClassicalGS(V, Hes, l_plus_1, l_max, &(Hes[l_plus_1][l]), cv, Xv));
-      }
-      else
-      {
-        SUNCheckCall(SUNModifiedGS(V, Hes, l_plus_1, l_max, &(Hes[l_plus_1][l])));
+        /* Keep the Hessenberg column for the s-step blocks */
+        if (sstep > 1)
+        {
+          for (i = 0; i <= l_plus_1; i++) { Hcopy[i * l_max + l] = Hes[i][l]; }
+        }
       }
 
-      /*  Update the QR factorization of Hes */
-      if (SUNQRfact(krydim, Hes, givens, l) != 0)
+      /* Update the QR factorization and the residual norm for each new
+         column of Hes */
+      ncols = SUNMAX(nblock, 1);
+      for (k = 0; k < ncols; k++)
       {
-        *zeroguess  = SUNFALSE;
-        LASTFLAG(S) = SUNLS_QRFACT_FAIL;
-        return (LASTFLAG(S));
-      }
+        (*nli)++;
+        krydim = l_plus_1 = l + 1;
 
-      /*  Update residual norm estimate; break if convergence test passes */
-      rotation_product *= givens[2 * l + 1];
-      *res_norm = rho = SUNRabs(rotation_product * r_norm);
+        /*  Update the QR factorization of Hes */
+        if (SUNQRfact(krydim, Hes, givens, l) != 0)
+        {
+          *zeroguess  = SUNFALSE;
+          LASTFLAG(S) = SUNLS_QRFACT_FAIL;
+          return (LASTFLAG(S));
+        }
+
+        /*  Update residual norm estimate; break if convergence test passes */
+        rotation_product *= givens[2 * l + 1];
+        *res_norm = rho = SUNRabs(rotation_product * r_norm);
 
 #if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_INFO
-      SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
-                         "SUNLinSolSolve_SPGMR", "iterate-residual",
-                         "nli = %li, resnorm = %.16g", (long int)*nli, *res_norm);
+        SUNLogger_QueueMsg(S->sunctx->logger, SUN_LOGLEVEL_INFO,
+                           "SUNLinSolSolve_SPGMR", "iterate-residual",
+                           "nli = %li, resnorm = %.16g", (long int)*nli,
+                           *res_norm);
 #endif
 
-      if (rho <= delta)
-      {
-        converged = SUNTRUE;
-        break;
+        if (rho <= delta)
+        {
+          converged = SUNTRUE;
+          break;
+        }
+
+        /* Normalize V[l+1] with norm value from the Gram-Schmidt routine,
+           the vectors of a block are already normalized */
+        if (nblock == 0)
+        {
+          N_VScale(ONE / Hes[l_plus_1][l], V[l_plus_1], V[l_plus_1]);
+          SUNCheckLastErr();
+        }
+        l++;
       }
+      if (converged) { break; }
 
-      /* Normalize V[l+1] with norm value from the Gram-Schmidt routine */
-      N_VScale(ONE / Hes[l_plus_1][l], V[l_plus_1], V[l_plus_1]);
-      SUNCheckLastErr();
+      /* In s-step mode, set the shifts from the Ritz values of the first
+         sstep Arnoldi steps */
+      if (sstep > 1 && SPGMR_CONTENT(S)->newshifts && l >= sstep)
+      {
+        spgmrSetShifts(S, sstep);
+      }
     }
 
     /* Inner loop is done.  Compute the new correction vector xcor */
@@ -795,6 +851,10 @@ SUNErrCode SUNLinSolSpace_SPGMR(SUNLinearSolver S, long int* lenrwLS,
   else { lrw1 = liw1 = 0; }
   *lenrwLS = lrw1 * (maxl + 5) + maxl * (maxl + 5) + 2;
   *leniwLS = liw1 * (maxl + 5);
+  if (SPGMR_CONTENT(S)->swork)
+  {
+    *lenrwLS += (maxl + 1) * maxl + SSTEP_WORK_LEN(maxl) + 2 * maxl + 1;
+  }
   return SUN_SUCCESS;
 }
 
@@ -853,6 +913,21 @@ SUNErrCode SUNLinSolFree_SPGMR(SUNLinearSolver S)
       free(SPGMR_CONTENT(S)->Xv);
       SPGMR_CONTENT(S)->Xv = NULL;
     }
+    if (SPGMR_CONTENT(S)->shifts)
+    {
+      free(SPGMR_CONTENT(S)->shifts);
+      SPGMR_CONTENT(S)->shifts = NULL;
+    }
+    if (SPGMR_CONTENT(S)->Hcopy)
+    {
+      free(SPGMR_CONTENT(S)->Hcopy);
+      SPGMR_CONTENT(S)->Hcopy = NULL;
+    }
+    if (SPGMR_CONTENT(S)->swork)
+    {
+      free(SPGMR_CONTENT(S)->swork);
+      SPGMR_CONTENT(S)->swork = NULL;
+    }
     free(S->content);
     S->content = NULL;
   }
@@ -865,3 +940,554 @@ SUNErrCode SUNLinSolFree_SPGMR(SUNLinearSolver S)
   S = NULL;
   return SUN_SUCCESS;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Compute w = A-tilde v, where A-tilde = s1 P1_inv A P2_inv s2_inv, using
+ * vtemp as workspace. Returns 0 on success or a SUNLS_* failure flag.
+ */
+
+static int spgmrATilde(SUNLinearSolver S, N_Vector v, N_Vector w,
+                       sunrealtype delta)
+{
+  SUNFunctionBegin(S->sunctx);
+  N_Vector vtemp, s1, s2;
+  sunbooleantype preOnLeft, preOnRight;
+  int status;
+
+  vtemp      = SPGMR_CONTENT(S)->vtemp;
+  s1         = SPGMR_CONTENT(S)->s1;
+  s2         = SPGMR_CONTENT(S)->s2;
+  preOnLeft  = ((SPGMR_CONTENT(S)->pretype == SUN_PREC_LEFT) ||
+               (SPGMR_CONTENT(S)->pretype == SUN_PREC_BOTH));
+  preOnRight = ((SPGMR_CONTENT(S)->pretype == SUN_PREC_RIGHT) ||
+                (SPGMR_CONTENT(S)->pretype == SUN_PREC_BOTH));
+
+  /* Apply right scaling: vtemp = s2_inv v */
+  if (s2 != NULL)
+  {
+    N_VDiv(v, s2, vtemp);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    N_VScale(ONE, v, vtemp);
+    SUNCheckLastErr();
+  }
+
+  /* Apply right preconditioner: vtemp = P2_inv s2_inv v */
+  if (preOnRight)
+  {
+    N_VScale(ONE, vtemp, w);
+    SUNCheckLastErr();
+    status = SPGMR_CONTENT(S)->Psolve(SPGMR_CONTENT(S)->PData, w, vtemp, delta,
+                                      SUN_PREC_RIGHT);
+    if (status != 0)
+    {
+      return ((status < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+    }
+  }
+
+  /* Apply A: w = A P2_inv s2_inv v */
+  status = SPGMR_CONTENT(S)->ATimes(SPGMR_CONTENT(S)->ATData, vtemp, w);
+  if (status != 0)
+  {
+    return ((status < 0) ? SUNLS_ATIMES_FAIL_UNREC : SUNLS_ATIMES_FAIL_REC);
+  }
+
+  /* Apply left preconditioning: vtemp = P1_inv A P2_inv s2_inv v */
+  if (preOnLeft)
+  {
+    status = SPGMR_CONTENT(S)->Psolve(SPGMR_CONTENT(S)->PData, w, vtemp, delta,
+                                      SUN_PREC_LEFT);
+    if (status != 0)
+    {
+      return ((status < 0) ? SUNLS_PSOLVE_FAIL_UNREC : SUNLS_PSOLVE_FAIL_REC);
+    }
+  }
+  else
+  {
+    N_VScale(ONE, w, vtemp);
+    SUNCheckLastErr();
+  }
+
+  /* Apply left scaling: w = s1 P1_inv A P2_inv s2_inv v */
+  if (s1 != NULL)
+  {
+    N_VProd(s1, vtemp, w);
+    SUNCheckLastErr();
+  }
+  else
+  {
+    N_VScale(ONE, vtemp, w);
+    SUNCheckLastErr();
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Generate a block of s Krylov vectors V[j+1], ..., V[j+s] from V[j] in the
+ * Newton basis
+ *
+ *   Z_0 = V[j],  Z_{c+1} = (A-tilde Z_c - a_c Z_c + e_c Z_{c-1}) / rho,
+ *
+ * where a complex conjugate pair of shifts a +/- i b takes two steps with
+ * real arithmetic (e_c = b^2 / rho in the second step, 0 otherwise), without
+ * any reduction. The block is then orthonormalized against V[0], ..., V[j]
+ * and within itself by two passes of block classical Gram-Schmidt with a
+ * Cholesky QR of the projected block, each pass with a single reduction when
+ * the vectors provide the local dot product and all-reduce operations. Last,
+ * columns j to j+s-1 of the Hessenberg matrix are recovered from the change
+ * of basis and the orthogonalization coefficients. On return, nblock is the
+ * number of orthonormal vectors added, less than s if the basis lost rank,
+ * or 0 if its first vector did. Returns 0 on success or a failure flag.
+ */
+
+static int spgmrSStepBlock(SUNLinearSolver S, int j, int s, sunrealtype delta,
+                           int* nblock)
+{
+  SUNFunctionBegin(S->sunctx);
+  N_Vector *V, *Xv;
+  sunrealtype **Hes, *Hcopy, *cv, *a, *e, rho, d;
+  sunrealtype *G, *C1, *C2, *R1, *R2, *Rc, *X, *C, *R;
+  sunbooleantype single_buffer;
+  int c, i, k, q, r, m, pass, ld, L, l_max, status;
+
+  *nblock = 0;
+
+  l_max = SPGMR_CONTENT(S)->maxl;
+  V     = SPGMR_CONTENT(S)->V;
+  Hes   = SPGMR_CONTENT(S)->Hes;
+  Hcopy = SPGMR_CONTENT(S)->Hcopy;
+  cv    = SPGMR_CONTENT(S)->cv;
+  Xv    = SPGMR_CONTENT(S)->Xv;
+  a     = SPGMR_CONTENT(S)->shifts;
+  e     = a + l_max;
+  rho   = a[2 * l_max];
+
+  /* Column-major workspace with leading dimension ld: the dot products G,
+     the projections C1 and C2 on V[0], ..., V[j], the triangular factors R1
+     and R2, the change of basis Rc and the new Hessenberg columns X */
+  ld = l_max + 1;
+  G  = SPGMR_CONTENT(S)->swork;
+  C1 = G + ld * s;
+  C2 = C1 + ld * s;
+  R1 = C2 + ld * s;
+  R2 = R1 + ld * s;
+  Rc = R2 + ld * s;
+  X  = Rc + ld * (s + 1);
+
+  single_buffer = (V[0]->ops->nvdotprodlocal ||
+                   V[0]->ops->nvdotprodmultilocal) &&
+                  V[0]->ops->nvdotprodmultiallreduce;
+
+  /* Generate the Newton basis of the block */
+  for (c = 0; c < s; c++)
+  {
+    status = spgmrATilde(S, V[j + c], V[j + c + 1], delta);
+    if (status != 0) { return (status); }
+
+    cv[0] = ONE / rho;
+    Xv[0] = V[j + c + 1];
+    cv[1] = -a[c] / rho;
+    Xv[1] = V[j + c];
+    k     = 2;
+    if (e[c] != ZERO)
+    {
+      cv[2] = e[c] / rho;
+      Xv[2] = V[j + c - 1];
+      k     = 3;
+    }
+    SUNCheckCall(N_VLinearCombination(k, cv, Xv, V[j + c + 1]));
+  }
+
+  /* Orthonormalize the block in two passes */
+  m = s;
+  for (pass = 0; pass < 2; pass++)
+  {
+    C = (pass == 0) ? C1 : C2;
+    R = (pass == 0) ? R1 : R2;
+
+    /* Row i of G holds the products of V[j+1+i] with V[0], ..., V[j+1+i] */
+    L = j + 1 + m;
+    for (i = 0; i < m; i++)
+    {
+      if (single_buffer)
+      {
+        SUNCheckCall(
+          N_VDotProdMultiLocal(j + 2 + i, V[j + 1 + i], V, G + i * L));
+        for (k = j + 2 + i; k < L; k++) { G[i * L + k] = ZERO; }
+      }
+      else
+      {
+        SUNCheckCall(N_VDotProdMulti(j + 2 + i, V[j + 1 + i], V, G + i * L));
+      }
+    }
+    if (single_buffer)
+    {
+      SUNCheckCall(N_VDotProdMultiAllReduce(m * L, V[0], G));
+    }
+
+    /* C = Q^T W and the Cholesky factor R of W^T W - C^T C, where Q holds
+       V[0], ..., V[j] and W the block, truncated at a loss of rank */
+    for (i = 0; i < m; i++)
+    {
+      for (q = 0; q <= j; q++) { C[q + i * ld] = G[i * L + q]; }
+    }
+    for (i = 0; i < m; i++)
+    {
+      for (k = 0; k <= i; k++)
+      {
+        d = G[i * L + j + 1 + k];
+        for (q = 0; q <= j; q++) { d -= C[q + k * ld] * C[q + i * ld]; }
+        for (q = 0; q < k; q++) { d -= R[q + k * ld] * R[q + i * ld]; }
+        if (k < i) { R[k + i * ld] = d / R[k + k * ld]; }
+        else if (d > SUN_RCONST(100.0) * SUN_UNIT_ROUNDOFF *
+                       G[i * L + j + 1 + i])
+        {
+          R[i + i * ld] = SUNRsqrt(d);
+        }
+        else { m = i; }
+      }
+    }
+    if (m == 0) { return (0); }
+
+    /* W = (W - Q C) R^{-1}, column by column in place */
+    for (i = 0; i < m; i++)
+    {
+      d     = ONE / R[i + i * ld];
+      cv[0] = d;
+      Xv[0] = V[j + 1 + i];
+      for (q = 0; q <= j; q++)
+      {
+        cv[1 + q] = -C[q + i * ld] * d;
+        Xv[1 + q] = V[q];
+      }
+      for (k = 0; k < i; k++)
+      {
+        cv[j + 2 + k] = -R[k + i * ld] * d;
+        Xv[j + 2 + k] = V[j + 1 + k];
+      }
+      SUNCheckCall(N_VLinearCombination(j + 2 + i, cv, Xv, V[j + 1 + i]));
+    }
+  }
+
+  /* Combine the passes: C1 = C1 + C2 R1 and R2 = R2 R1 */
+  for (i = m - 1; i >= 0; i--)
+  {
+    for (q = 0; q <= j; q++)
+    {
+      for (k = 0; k <= i; k++)
+      {
+        C1[q + i * ld] += C2[q + k * ld] * R1[k + i * ld];
+      }
+    }
+    for (k = 0; k <= i; k++)
+    {
+      d = ZERO;
+      for (r = k; r <= i; r++) { d += R2[k + r * ld] * R1[r + i * ld]; }
+      R2[k + i * ld] = d;
+    }
+  }
+
+  /* Z_0, ..., Z_m = V[0], ..., V[j+m] Rc */
+  for (c = 0; c <= m; c++)
+  {
+    for (r = 0; r <= j + m; r++) { Rc[r + c * ld] = ZERO; }
+  }
+  Rc[j] = ONE;
+  for (c = 1; c <= m; c++)
+  {
+    for (r = 0; r <= j; r++) { Rc[r + c * ld] = C1[r + (c - 1) * ld]; }
+    for (r = 0; r < c; r++)
+    {
+      Rc[j + 1 + r + c * ld] = R2[r + (c - 1) * ld];
+    }
+  }
+
+  /* A-tilde Z_c = rho Z_{c+1} + a_c Z_c - e_c Z_{c-1} gives the Hessenberg
+     columns X from X Rs = Rc B - H Rc_top, where Rs holds rows j to j+m-1 of
+     Rc, Rc_top rows 0 to j-1 and H the previous Hessenberg columns */
+  for (c = 0; c < m; c++)
+  {
+    for (r = 0; r <= j + m; r++)
+    {
+      d = a[c] * Rc[r + c * ld] + rho * Rc[r + (c + 1) * ld];
+      if (e[c] != ZERO) { d -= e[c] * Rc[r + (c - 1) * ld]; }
+      if (r <= j)
+      {
+        for (q = SUNMAX(r - 1, 0); q < j; q++)
+        {
+          d -= Hcopy[r * l_max + q] * Rc[q + c * ld];
+        }
+      }
+      for (k = 0; k < c; k++) { d -= X[r + k * ld] * Rc[j + k + c * ld]; }
+      X[r + c * ld] = d / Rc[j + c + c * ld];
+    }
+  }
+
+  for (c = 0; c < m; c++)
+  {
+    for (r = 0; r <= j + c + 1; r++)
+    {
+      Hes[r][j + c]            = X[r + c * ld];
+      Hcopy[r * l_max + j + c] = X[r + c * ld];
+    }
+  }
+
+  *nblock = m;
+  return (0);
+}
+
+/* ----------------------------------------------------------------------------
+ * Set the shifts of the s-step Newton basis to the Ritz values of the first
+ * s Arnoldi steps, in Leja order with complex conjugate pairs adjacent, and
+ * the scaling of the basis to their largest magnitude. If the Ritz values
+ * cannot be computed, the basis is a scaled monomial basis.
+ */
+
+static void spgmrSetShifts(SUNLinearSolver S, int s)
+{
+  sunrealtype *h, *wr, *wi, *used, *ai, *a, *e, *Hcopy, rho, val, best, t;
+  int c, i, k, ib, l_max;
+
+  l_max = SPGMR_CONTENT(S)->maxl;
+  Hcopy = SPGMR_CONTENT(S)->Hcopy;
+  a     = SPGMR_CONTENT(S)->shifts;
+  e     = a + l_max;
+  h     = SPGMR_CONTENT(S)->swork;
+  wr    = h + s * s;
+  wi    = wr + s;
+  used  = wi + s;
+  ai    = used + s;
+
+  for (i = 0; i < s; i++)
+  {
+    for (k = 0; k < s; k++)
+    {
+      h[i * s + k] = (k >= i - 1) ? Hcopy[i * l_max + k] : ZERO;
+    }
+  }
+  for (c = 0; c < s; c++) { a[c] = e[c] = ZERO; }
+  rho = ZERO;
+
+  if (spgmrHessEig(s, h, wr, wi) == 0)
+  {
+    for (i = 0; i < s; i++)
+    {
+      rho     = SUNMAX(rho, SUNRsqrt(wr[i] * wr[i] + wi[i] * wi[i]));
+      used[i] = ZERO;
+    }
+    if (rho == ZERO) { rho = ONE; }
+
+    /* Leja order: each shift maximizes the product of its distances to the
+       previous ones, the first one has the largest magnitude */
+    c = 0;
+    while (c < s)
+    {
+      ib   = -1;
+      best = -ONE;
+      for (i = 0; i < s; i++)
+      {
+        if (used[i] != ZERO || wi[i] < ZERO) { continue; }
+        val = (c == 0) ? SUNRsqrt(wr[i] * wr[i] + wi[i] * wi[i]) : ONE;
+        for (k = 0; k < c; k++)
+        {
+          t = SUNRsqrt(SUNSQR(wr[i] - a[k]) + SUNSQR(wi[i] - ai[k]));
+          val *= t / rho;
+        }
+        if (val > best)
+        {
+          best = val;
+          ib   = i;
+        }
+      }
+      if (ib < 0) { break; }
+
+      used[ib] = ONE;
+      a[c]     = wr[ib];
+      ai[c]    = wi[ib];
+      c++;
+
+      /* the conjugate of a complex shift follows it */
+      if (wi[ib] > ZERO && c < s)
+      {
+        for (i = 0; i < s; i++)
+        {
+          if (used[i] == ZERO && wi[i] == -wi[ib] && wr[i] == wr[ib])
+          {
+            used[i] = ONE;
+            break;
+          }
+        }
+        a[c]  = wr[ib];
+        ai[c] = -wi[ib];
+        e[c]  = wi[ib] * wi[ib] / rho;
+        c++;
+      }
+    }
+  }
+  else
+  {
+    /* scale the monomial basis by the infinity norm of the Hessenberg block */
+    for (i = 0; i < s; i++)
+    {
+      val = ZERO;
+      for (k = SUNMAX(i - 1, 0); k < s; k++)
+      {
+        val += SUNRabs(Hcopy[i * l_max + k]);
+      }
+      rho = SUNMAX(rho, val);
+    }
+    if (rho == ZERO) { rho = ONE; }
+  }
+
+  a[2 * l_max]                = rho;
+  SPGMR_CONTENT(S)->newshifts = SUNFALSE;
+}
+
+/* ----------------------------------------------------------------------------
+ * Compute the eigenvalues wr + i wi of the n by n upper Hessenberg matrix h,
+ * stored by rows and overwritten, with the Francis double shift QR iteration.
+ * Complex conjugate pairs are returned in consecutive entries. Returns 0 on
+ * success or 1 if the iteration does not converge.
+ */
+
+static int spgmrHessEig(int n, sunrealtype* h, sunrealtype* wr, sunrealtype* wi)
+{
+  int i, j, k, l, hi, its, nv;
+  sunrealtype anorm, s, t, x, y, z, p, q, w, beta, v[3];
+
+#define H(i, j) h[(i) * n + (j)]
+
+  anorm = ZERO;
+  for (i = 0; i < n; i++)
+  {
+    for (j = SUNMAX(i - 1, 0); j < n; j++) { anorm += SUNRabs(H(i, j)); }
+  }
+
+  hi  = n - 1;
+  its = 0;
+  while (hi >= 0)
+  {
+    /* find the start l of the unreduced block ending at row hi */
+    for (l = hi; l > 0; l--)
+    {
+      s = SUNRabs(H(l - 1, l - 1)) + SUNRabs(H(l, l));
+      if (s == ZERO) { s = anorm; }
+      if (SUNRabs(H(l, l - 1)) <= SUN_UNIT_ROUNDOFF * s)
+      {
+        H(l, l - 1) = ZERO;
+        break;
+      }
+    }
+
+    if (l == hi)
+    {
+      /* one real eigenvalue */
+      wr[hi] = H(hi, hi);
+      wi[hi] = ZERO;
+      hi--;
+      its = 0;
+    }
+    else if (l == hi - 1)
+    {
+      /* two eigenvalues of the trailing 2 by 2 block */
+      x = H(hi, hi);
+      w = H(hi, hi - 1) * H(hi - 1, hi);
+      p = HALF * (H(hi - 1, hi - 1) - x);
+      q = p * p + w;
+      z = SUNRsqrt(SUNRabs(q));
+      if (q >= ZERO)
+      {
+        z          = (p >= ZERO) ? p + z : p - z;
+        wr[hi - 1] = x + z;
+        wr[hi]     = (z != ZERO) ? x - w / z : x + z;
+        wi[hi - 1] = wi[hi] = ZERO;
+      }
+      else
+      {
+        wr[hi - 1] = wr[hi] = x + p;
+        wi[hi - 1]          = z;
+        wi[hi]              = -z;
+      }
+      hi -= 2;
+      its = 0;
+    }
+    else
+    {
+      if (its == 30) { return (1); }
+      its++;
+
+      /* sum s and product t of the shifts, with exceptional shifts after
+         10 and 20 iterations without deflation */
+      if (its == 10 || its == 20)
+      {
+        x = SUNRabs(H(hi, hi - 1)) + SUNRabs(H(hi - 1, hi - 2));
+        y = SUN_RCONST(0.75) * x + H(hi, hi);
+        s = 2 * y;
+        t = y * y + SUN_RCONST(0.4375) * x * x;
+      }
+      else
+      {
+        s = H(hi - 1, hi - 1) + H(hi, hi);
+        t = H(hi - 1, hi - 1) * H(hi, hi) - H(hi - 1, hi) * H(hi, hi - 1);
+      }
+
+      /* first column of (H - shift_1 I)(H - shift_2 I) */
+      x = H(l, l) * H(l, l) + H(l, l + 1) * H(l + 1, l) - s * H(l, l) + t;
+      y = H(l + 1, l) * (H(l, l) + H(l + 1, l + 1) - s);
+      z = H(l + 1, l) * H(l + 2, l + 1);
+
+      /* chase the bulge with Householder reflections I - beta v v^T */
+      for (k = l; k <= hi - 1; k++)
+      {
+        nv   = (k < hi - 1) ? 3 : 2;
+        v[0] = x;
+        v[1] = y;
+        v[2] = (nv == 3) ? z : ZERO;
+        w    = SUNRsqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (w != ZERO)
+        {
+          v[0] += (v[0] >= ZERO) ? w : -w;
+          beta = 2 / (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+          for (j = SUNMAX(k - 1, l); j <= hi; j++)
+          {
+            p = H(k, j) * v[0] + H(k + 1, j) * v[1];
+            if (nv == 3) { p += H(k + 2, j) * v[2]; }
+            p *= beta;
+            H(k, j) -= p * v[0];
+            H(k + 1, j) -= p * v[1];
+            if (nv == 3) { H(k + 2, j) -= p * v[2]; }
+          }
+          for (i = l; i <= SUNMIN(k + 3, hi); i++)
+          {
+            p = H(i, k) * v[0] + H(i, k + 1) * v[1];
+            if (nv == 3) { p += H(i, k + 2) * v[2]; }
+            p *= beta;
+            H(i, k) -= p * v[0];
+            H(i, k + 1) -= p * v[1];
+            if (nv == 3) { H(i, k + 2) -= p * v[2]; }
+          }
+        }
+        if (k < hi - 1)
+        {
+          x = H(k + 1, k);
+          y = H(k + 2, k);
+          if (k < hi - 2) { z = H(k + 3, k); }
+        }
+      }
+    }
+  }
+
+#undef H
+
+  return (0);
+}
@@ -0,0 +1,1373 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the block sparse
+ * implementation of the SUNMATRIX package.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_dense.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_math.h>
+#include <sunmatrix/sunmatrix_blocksparse.h>
+#include <sunmatrix/sunmatrix_dense.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+
+#include "sundials_macros.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Kernels for the specialized block sizes, e.g. Matvec_3 for 3x3 blocks */
+#define BSR_PASTE_(name, bs) name##_##bs
+#define BSR_PASTE(name, bs)  BSR_PASTE_(name, bs)
+#define BSR_FN(name)         BSR_PASTE(name, BSR_BS)
+
+#define BSR_BS 2
+#include "sunmatrix_blocksparse_kernels.h"
+#undef BSR_BS
+
+#define BSR_BS 3
+#include "sunmatrix_blocksparse_kernels.h"
+#undef BSR_BS
+
+#define BSR_BS 4
+#include "sunmatrix_blocksparse_kernels.h"
+#undef BSR_BS
+
+#define BSR_BS 5
+#include "sunmatrix_blocksparse_kernels.h"
+#undef BSR_BS
+
+#define BSR_BS 6
+#include "sunmatrix_blocksparse_kernels.h"
+#undef BSR_BS
+
+#define BSR_BS 7
+#include "sunmatrix_blocksparse_kernels.h"
+#undef BSR_BS
+
+#define BSR_BS 8
+#include "sunmatrix_blocksparse_kernels.h"
+#undef BSR_BS
+
+/* Private function prototypes */
+static sunbooleantype compatibleMatrices(SUNMatrix A, SUNMatrix B);
+static sunbooleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x,
+                                                 N_Vector y);
+static sunbooleantype samePattern(SUNMatrix A, SUNMatrix B);
+static void Matvec_Generic(sunindextype M, sunindextype bs,
+                           const sunindextype* rowptrs,
+                           const sunindextype* colind, const sunrealtype* data,
+                           const sunrealtype* x, sunrealtype* y);
+static SUNErrCode transpose_pattern(SUNMatrix A, sunindextype** tptrs,
+                                    sunindextype** trows, sunindextype** tpos);
+static SUNErrCode find_diagonal(SUNMatrix A, sunindextype* nmissing);
+static SUNErrCode insert_diagonal(SUNMatrix A, sunindextype nmissing);
+
+/*
+ * -----------------------------------------------------------------
+ * exported functions
+ * -----------------------------------------------------------------
+ */
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new block sparse matrix with M block rows, N block
+ * columns, block size bs, and storage for NNZB blocks
+ */
+
+SUNMatrix SUNBlockSparseMatrix(sunindextype M, sunindextype N,
+                               sunindextype bs, sunindextype NNZB,
+                               SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+  SUNMatrix A;
+  SUNMatrixContent_BlockSparse content;
+
+  /* return with NULL matrix on illegal input */
+  SUNAssertNull(M > 0 && N > 0 && bs > 0, SUN_ERR_ARG_OUTOFRANGE);
+  SUNAssertNull(NNZB >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  /* Create an empty matrix object */
+  A = NULL;
+  A = SUNMatNewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+  A->ops->getid     = SUNMatGetID_BlockSparse;
+  A->ops->clone     = SUNMatClone_BlockSparse;
+  A->ops->destroy   = SUNMatDestroy_BlockSparse;
+  A->ops->zero      = SUNMatZero_BlockSparse;
+  A->ops->copy      = SUNMatCopy_BlockSparse;
+  A->ops->scaleadd  = SUNMatScaleAdd_BlockSparse;
+  A->ops->scaleaddi = SUNMatScaleAddI_BlockSparse;
+  A->ops->matvec    = SUNMatMatvec_BlockSparse;
+  A->ops->space     = SUNMatSpace_BlockSparse;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNMatrixContent_BlockSparse)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach content */
+  A->content = content;
+
+  /* Fill content */
+  content->M       = M;
+  content->N       = N;
+  content->bs      = bs;
+  content->NNZB    = NNZB;
+  content->data    = NULL;
+  content->colind  = NULL;
+  content->rowptrs = NULL;
+  content->diag    = NULL;
+  content->bdiag   = NULL;
+  content->bcols   = NULL;
+  content->bpivots = NULL;
+
+  /* Allocate content */
+  content->data = (sunrealtype*)calloc(NNZB * bs * bs, sizeof(sunrealtype));
+  SUNAssertNull(content->data, SUN_ERR_MALLOC_FAIL);
+
+  content->colind = (sunindextype*)calloc(NNZB, sizeof(sunindextype));
+  SUNAssertNull(content->colind, SUN_ERR_MALLOC_FAIL);
+
+  content->rowptrs = (sunindextype*)calloc(M + 1, sizeof(sunindextype));
+  SUNAssertNull(content->rowptrs, SUN_ERR_MALLOC_FAIL);
+
+  return (A);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new block sparse matrix from an existing dense matrix.
+ * The dimensions of the dense matrix must be multiples of bs, and every block
+ * with an entry of magnitude larger than droptol is stored.
+ */
+
+SUNMatrix SUNBlockSparseFromDenseMatrix(SUNMatrix Ad, sunindextype bs,
+                                        sunrealtype droptol)
+{
+  sunindextype i, j, r, c, M, N, nnzb, nz;
+  sunbooleantype keep;
+  SUNMatrix As;
+  SUNFunctionBegin(Ad->sunctx);
+
+  SUNAssertNull(SUNMatGetID(Ad) == SUNMATRIX_DENSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssertNull(bs > 0, SUN_ERR_ARG_OUTOFRANGE);
+  SUNAssertNull(droptol >= ZERO, SUN_ERR_ARG_OUTOFRANGE);
+  SUNAssertNull(SM_ROWS_D(Ad) % bs == 0 && SM_COLUMNS_D(Ad) % bs == 0,
+                SUN_ERR_ARG_DIMSMISMATCH);
+
+  M = SM_ROWS_D(Ad) / bs;
+  N = SM_COLUMNS_D(Ad) / bs;
+
+  /* count the blocks to keep */
+  nnzb = 0;
+  for (i = 0; i < M; i++)
+  {
+    for (j = 0; j < N; j++)
+    {
+      keep = SUNFALSE;
+      for (c = 0; c < bs && !keep; c++)
+      {
+        for (r = 0; r < bs && !keep; r++)
+        {
+          keep = SUNRabs(SM_ELEMENT_D(Ad, i * bs + r, j * bs + c)) > droptol;
+        }
+      }
+      if (keep) { nnzb++; }
+    }
+  }
+
+  /* allocate the block sparse matrix */
+  As = SUNBlockSparseMatrix(M, N, bs, nnzb, Ad->sunctx);
+  SUNCheckLastErrNull();
+
+  /* copy the blocks */
+  nz = 0;
+  for (i = 0; i < M; i++)
+  {
+    SM_ROWPTRS_BS(As)[i] = nz;
+    for (j = 0; j < N; j++)
+    {
+      keep = SUNFALSE;
+      for (c = 0; c < bs && !keep; c++)
+      {
+        for (r = 0; r < bs && !keep; r++)
+        {
+          keep = SUNRabs(SM_ELEMENT_D(Ad, i * bs + r, j * bs + c)) > droptol;
+        }
+      }
+      if (!keep) { continue; }
+
+      SM_COLIND_BS(As)[nz] = j;
+      for (c = 0; c < bs; c++)
+      {
+        for (r = 0; r < bs; r++)
+        {
+          SM_BLOCK_ELEMENT_BS(As, nz, r, c) = SM_ELEMENT_D(Ad, i * bs + r,
+                                                           j * bs + c);
+        }
+      }
+      nz++;
+    }
+  }
+  SM_ROWPTRS_BS(As)[M] = nz;
+
+  return (As);
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to reallocate the block storage so that the matrix has storage for
+ * a specified number of blocks
+ */
+
+SUNErrCode SUNBlockSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZB)
+{
+  sunindextype bs;
+  SUNFunctionBegin(A->sunctx);
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(NNZB >= 0, SUN_ERR_ARG_OUTOFRANGE);
+
+  bs = SM_BLOCKSIZE_BS(A);
+
+  /* perform reallocation */
+  SM_COLIND_BS(A) = (sunindextype*)realloc(SM_COLIND_BS(A),
+                                           NNZB * sizeof(sunindextype));
+  SUNAssert(SM_COLIND_BS(A), SUN_ERR_MALLOC_FAIL);
+
+  SM_DATA_BS(A) = (sunrealtype*)realloc(SM_DATA_BS(A),
+                                        NNZB * bs * bs * sizeof(sunrealtype));
+  SUNAssert(SM_DATA_BS(A), SUN_ERR_MALLOC_FAIL);
+
+  SM_NNZB_BS(A) = NNZB;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to create a new sparse matrix (CSC or CSR) with the entries of a
+ * block sparse matrix, e.g. for use with the KLU or SuperLU_MT solvers
+ */
+
+SUNErrCode SUNBlockSparseMatrix_ToSparse(SUNMatrix A, int sparsetype,
+                                         SUNMatrix* Bout)
+{
+  sunindextype bs;
+  SUNFunctionBegin(A->sunctx);
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(sparsetype == CSC_MAT || sparsetype == CSR_MAT,
+            SUN_ERR_ARG_OUTOFRANGE);
+  SUNAssert(Bout, SUN_ERR_ARG_CORRUPT);
+
+  bs    = SM_BLOCKSIZE_BS(A);
+  *Bout = SUNSparseMatrix(SM_BLOCKROWS_BS(A) * bs, SM_BLOCKCOLS_BS(A) * bs,
+                          SM_ROWPTRS_BS(A)[SM_BLOCKROWS_BS(A)] * bs * bs,
+                          sparsetype, A->sunctx);
+  SUNCheckLastErr();
+
+  SUNCheckCall(SUNBlockSparseMatrix_CopyToSparse(A, *Bout));
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to copy the entries of a block sparse matrix into an existing sparse
+ * matrix with the same dimensions, reallocating the sparse storage if needed.
+ * Every entry of a stored block is copied, including zeros, so the pattern of
+ * the sparse matrix only changes when the block pattern changes. The indices in
+ * each row (column) are sorted when the block column indices in each block row
+ * are sorted.
+ */
+
+SUNErrCode SUNBlockSparseMatrix_CopyToSparse(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, j, k, l, r, c, bs, M, N, nnz, nz;
+  sunindextype *rowptrs, *colind, *tptrs, *trows, *tpos, *Bptrs, *Bvals;
+  sunrealtype *Adata, *Bdata;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(SUNMatGetID(B) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
+
+  M  = SM_BLOCKROWS_BS(A);
+  N  = SM_BLOCKCOLS_BS(A);
+  bs = SM_BLOCKSIZE_BS(A);
+  SUNCheck(SM_ROWS_S(B) == M * bs && SM_COLUMNS_S(B) == N * bs,
+           SUN_ERR_ARG_DIMSMISMATCH);
+
+  rowptrs = SM_ROWPTRS_BS(A);
+  colind  = SM_COLIND_BS(A);
+  Adata   = SM_DATA_BS(A);
+
+  /* ensure B has enough storage, then clear its pattern */
+  nnz = rowptrs[M] * bs * bs;
+  if (SM_NNZ_S(B) < nnz)
+  {
+    SUNCheckCall(SUNSparseMatrix_Reallocate(B, nnz));
+  }
+  SUNCheckCall(SUNMatZero_Sparse(B));
+
+  Bptrs = SM_INDEXPTRS_S(B);
+  Bvals = SM_INDEXVALS_S(B);
+  Bdata = SM_DATA_S(B);
+
+  nz = 0;
+  if (SM_SPARSETYPE_S(B) == CSR_MAT)
+  {
+    /* each block row gives bs rows of B */
+    for (i = 0; i < M; i++)
+    {
+      for (r = 0; r < bs; r++)
+      {
+        Bptrs[i * bs + r] = nz;
+        for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+        {
+          for (c = 0; c < bs; c++)
+          {
+            Bvals[nz] = colind[k] * bs + c;
+            Bdata[nz] = Adata[(k * bs + c) * bs + r];
+            nz++;
+          }
+        }
+      }
+    }
+    Bptrs[M * bs] = nz;
+  }
+  else
+  {
+    /* each block column gives bs columns of B */
+    SUNCheckCall(transpose_pattern(A, &tptrs, &trows, &tpos));
+    for (j = 0; j < N; j++)
+    {
+      for (c = 0; c < bs; c++)
+      {
+        Bptrs[j * bs + c] = nz;
+        for (l = tptrs[j]; l < tptrs[j + 1]; l++)
+        {
+          k = tpos[l];
+          for (r = 0; r < bs; r++)
+          {
+            Bvals[nz] = trows[l] * bs + r;
+            Bdata[nz] = Adata[(k * bs + c) * bs + r];
+            nz++;
+          }
+        }
+      }
+    }
+    Bptrs[N * bs] = nz;
+    free(tptrs);
+    free(trows);
+    free(tpos);
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to partition the block columns of a block sparse matrix into
+ * structurally orthogonal groups i.e., no two block columns in the same group
+ * have a block in the same block row. On return colors[j] is the group of block
+ * column j and ncolors is the number of groups. The groups are assigned
+ * greedily in column order.
+ */
+
+SUNErrCode SUNBlockSparseMatrix_ColorBlockColumns(SUNMatrix A,
+                                                  sunindextype* colors,
+                                                  sunindextype* ncolors)
+{
+  sunindextype i, j, k, l, c, N;
+  sunindextype *rowptrs, *colind, *tptrs, *trows, *mark;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(colors, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(ncolors, SUN_ERR_ARG_CORRUPT);
+
+  N       = SM_BLOCKCOLS_BS(A);
+  rowptrs = SM_ROWPTRS_BS(A);
+  colind  = SM_COLIND_BS(A);
+
+  /* the block rows of each block column */
+  SUNCheckCall(transpose_pattern(A, &tptrs, &trows, NULL));
+
+  /* mark[c] == j if color c is used by a neighbor of block column j */
+  mark = (sunindextype*)malloc(N * sizeof(sunindextype));
+  SUNAssert(mark, SUN_ERR_MALLOC_FAIL);
+
+  for (j = 0; j < N; j++)
+  {
+    colors[j] = -1;
+    mark[j]   = -1;
+  }
+
+  *ncolors = 0;
+  for (j = 0; j < N; j++)
+  {
+    /* mark the colors of block columns sharing a block row with j */
+    for (k = tptrs[j]; k < tptrs[j + 1]; k++)
+    {
+      i = trows[k];
+      for (l = rowptrs[i]; l < rowptrs[i + 1]; l++)
+      {
+        c = colors[colind[l]];
+        if (c >= 0) { mark[c] = j; }
+      }
+    }
+
+    /* assign the smallest unmarked color */
+    c = 0;
+    while (mark[c] == j) { c++; }
+    colors[j] = c;
+    if (c + 1 > *ncolors) { *ncolors = c + 1; }
+  }
+
+  free(mark);
+  free(tptrs);
+  free(trows);
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to compute a difference quotient approximation of the Jacobian of
+ * f(y) in the block pattern of J. The block columns are grouped with
+ * SUNBlockSparseMatrix_ColorBlockColumns, and column q of every block in a
+ * group is computed from one evaluation of f, so the Jacobian costs bs times
+ * the number of groups evaluations. The increment for component j is
+ * sqrt(uround) * max(|y_j|, 1/w_j), with w_j = 1 when w is NULL. The work
+ * vectors tmp1 and tmp2 must have the lengths of y and fy, respectively.
+ *
+ * Returns 0 on success, the nonzero value returned by f if an evaluation fails,
+ * or a SUNErrCode.
+ */
+
+int SUNBlockSparseMatrix_DQJacobian(SUNMatrix J, SUNBlockSparseFn f,
+                                    void* user_data, N_Vector y, N_Vector fy,
+                                    N_Vector w, N_Vector tmp1, N_Vector tmp2)
+{
+  sunindextype i, j, k, l, q, r, bs, M, N, ncolors;
+  sunindextype *rowptrs, *colind, *colors;
+  sunrealtype *y_data, *fy_data, *w_data, *ytemp_data, *ftemp_data;
+  sunrealtype *inc, *b, srur, scale, inc_inv;
+  SUNErrCode err;
+  int retval = 0;
+  SUNFunctionBegin(J->sunctx);
+
+  SUNAssert(SUNMatGetID(J) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(f, SUN_ERR_ARG_CORRUPT);
+
+  M  = SM_BLOCKROWS_BS(J);
+  N  = SM_BLOCKCOLS_BS(J);
+  bs = SM_BLOCKSIZE_BS(J);
+  SUNCheck(N_VGetLength(y) == N * bs && N_VGetLength(tmp1) == N * bs,
+           SUN_ERR_ARG_DIMSMISMATCH);
+  SUNCheck(N_VGetLength(fy) == M * bs && N_VGetLength(tmp2) == M * bs,
+           SUN_ERR_ARG_DIMSMISMATCH);
+
+  rowptrs = SM_ROWPTRS_BS(J);
+  colind  = SM_COLIND_BS(J);
+
+  y_data     = N_VGetArrayPointer(y);
+  fy_data    = N_VGetArrayPointer(fy);
+  w_data     = (w == NULL) ? NULL : N_VGetArrayPointer(w);
+  ytemp_data = N_VGetArrayPointer(tmp1);
+  ftemp_data = N_VGetArrayPointer(tmp2);
+
+  colors = (sunindextype*)malloc(N * sizeof(sunindextype));
+  SUNAssert(colors, SUN_ERR_MALLOC_FAIL);
+
+  inc = (sunrealtype*)malloc(N * bs * sizeof(sunrealtype));
+  SUNAssert(inc, SUN_ERR_MALLOC_FAIL);
+
+  /* group the block columns */
+  err = SUNBlockSparseMatrix_ColorBlockColumns(J, colors, &ncolors);
+  if (err)
+  {
+    free(colors);
+    free(inc);
+    return err;
+  }
+
+  /* compute the increment for each component of y */
+  srur = SUNRsqrt(SUN_UNIT_ROUNDOFF);
+  for (l = 0; l < N * bs; l++)
+  {
+    scale  = (w_data == NULL) ? ONE : ONE / w_data[l];
+    inc[l] = srur * SUNMAX(SUNRabs(y_data[l]), scale);
+  }
+
+  N_VScale(ONE, y, tmp1);
+
+  /* loop over the groups and the columns within the blocks */
+  for (l = 0; l < ncolors * bs && retval == 0; l++)
+  {
+    k = l / bs; /* group */
+    q = l % bs; /* column of the blocks */
+
+    /* increment component q of every block column in the group */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] == k) { ytemp_data[j * bs + q] += inc[j * bs + q]; }
+    }
+
+    retval = f(tmp1, tmp2, user_data);
+
+    /* restore ytemp */
+    for (j = 0; j < N; j++)
+    {
+      if (colors[j] == k) { ytemp_data[j * bs + q] = y_data[j * bs + q]; }
+    }
+    if (retval != 0) { break; }
+
+    /* fill column q of the blocks in the group */
+    for (i = 0; i < M; i++)
+    {
+      for (j = rowptrs[i]; j < rowptrs[i + 1]; j++)
+      {
+        if (colors[colind[j]] != k) { continue; }
+        inc_inv = ONE / inc[colind[j] * bs + q];
+        b       = SM_BLOCK_BS(J, j) + q * bs;
+        for (r = 0; r < bs; r++)
+        {
+          b[r] = inc_inv * (ftemp_data[i * bs + r] - fy_data[i * bs + r]);
+        }
+      }
+    }
+  }
+
+  free(colors);
+  free(inc);
+
+  return retval;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to compute the LU factorization of each diagonal block of a square
+ * block sparse matrix for a block-Jacobi preconditioner. The factors are stored
+ * in the matrix, separate from the blocks, and are used by
+ * SUNBlockSparseMatrix_SolveBlockDiagonal until the next call. Returns
+ * SUN_ERR_OP_FAIL if a diagonal block is missing or singular.
+ */
+
+SUNErrCode SUNBlockSparseMatrix_FactorBlockDiagonal(SUNMatrix A)
+{
+  sunindextype i, l, bs, bs2, M, nmissing;
+  sunrealtype *src, *dst;
+  SUNMatrixContent_BlockSparse content;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(SM_BLOCKROWS_BS(A) == SM_BLOCKCOLS_BS(A), SUN_ERR_ARG_INCOMPATIBLE);
+
+  content = SM_CONTENT_BS(A);
+  M       = content->M;
+  bs      = content->bs;
+  bs2     = bs * bs;
+
+  /* allocate the factors on first use */
+  if (content->bdiag == NULL)
+  {
+    content->bdiag = (sunrealtype*)malloc(M * bs2 * sizeof(sunrealtype));
+    SUNAssert(content->bdiag, SUN_ERR_MALLOC_FAIL);
+
+    content->bcols = (sunrealtype**)malloc(M * bs * sizeof(sunrealtype*));
+    SUNAssert(content->bcols, SUN_ERR_MALLOC_FAIL);
+
+    content->bpivots = (sunindextype*)malloc(M * bs * sizeof(sunindextype));
+    SUNAssert(content->bpivots, SUN_ERR_MALLOC_FAIL);
+
+    for (l = 0; l < M * bs; l++) { content->bcols[l] = content->bdiag + l * bs; }
+  }
+
+  SUNCheckCall(find_diagonal(A, &nmissing));
+  if (nmissing > 0) { return SUN_ERR_OP_FAIL; }
+
+  for (i = 0; i < M; i++)
+  {
+    src = SM_BLOCK_BS(A, content->diag[i]);
+    dst = content->bdiag + i * bs2;
+    for (l = 0; l < bs2; l++) { dst[l] = src[l]; }
+
+    if (SUNDlsMat_denseGETRF(content->bcols + i * bs, bs, bs,
+                             content->bpivots + i * bs))
+    {
+      return SUN_ERR_OP_FAIL;
+    }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to solve D x = b, where D is the block diagonal part of A factored
+ * by SUNBlockSparseMatrix_FactorBlockDiagonal. x and b may be the same vector.
+ */
+
+SUNErrCode SUNBlockSparseMatrix_SolveBlockDiagonal(SUNMatrix A, N_Vector x,
+                                                   N_Vector b)
+{
+  sunindextype i, bs, M;
+  sunrealtype* xd;
+  SUNMatrixContent_BlockSparse content;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+
+  content = SM_CONTENT_BS(A);
+  M       = content->M;
+  bs      = content->bs;
+  SUNAssert(content->bdiag, SUN_ERR_ARG_CORRUPT);
+  SUNCheck(N_VGetLength(x) == M * bs && N_VGetLength(b) == M * bs,
+           SUN_ERR_ARG_DIMSMISMATCH);
+
+  if (x != b) { N_VScale(ONE, b, x); }
+  xd = N_VGetArrayPointer(x);
+  SUNCheckLastErr();
+
+  for (i = 0; i < M; i++)
+  {
+    SUNDlsMat_denseGETRS(content->bcols + i * bs, bs, content->bpivots + i * bs,
+                         xd + i * bs);
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to print the block sparse matrix
+ */
+
+void SUNBlockSparseMatrix_Print(SUNMatrix A, FILE* outfile)
+{
+  SUNFunctionBegin(A->sunctx);
+  sunindextype i, k, r, c, bs;
+
+  SUNAssertVoid(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+
+  bs = SM_BLOCKSIZE_BS(A);
+
+  /* perform operation */
+  fprintf(outfile, "\n");
+  fprintf(outfile, "%ld by %ld block matrix, block size %ld, NNZB: %ld \n",
+          (long int)SM_BLOCKROWS_BS(A), (long int)SM_BLOCKCOLS_BS(A),
+          (long int)bs, (long int)SM_NNZB_BS(A));
+  for (i = 0; i < SM_BLOCKROWS_BS(A); i++)
+  {
+    fprintf(outfile, "block row %ld : locations %ld to %ld\n", (long int)i,
+            (long int)(SM_ROWPTRS_BS(A))[i],
+            (long int)(SM_ROWPTRS_BS(A))[i + 1] - 1);
+    for (k = (SM_ROWPTRS_BS(A))[i]; k < (SM_ROWPTRS_BS(A))[i + 1]; k++)
+    {
+      fprintf(outfile, "  block column %ld:\n", (long int)(SM_COLIND_BS(A))[k]);
+      for (r = 0; r < bs; r++)
+      {
+        fprintf(outfile, "   ");
+        for (c = 0; c < bs; c++)
+        {
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+          fprintf(outfile, " %.32Lg", SM_BLOCK_ELEMENT_BS(A, k, r, c));
+#elif defined(SUNDIALS_DOUBLE_PRECISION)
+          fprintf(outfile, " %.16g", SM_BLOCK_ELEMENT_BS(A, k, r, c));
+#else
+          fprintf(outfile, " %.8g", SM_BLOCK_ELEMENT_BS(A, k, r, c));
+#endif
+        }
+        fprintf(outfile, "\n");
+      }
+    }
+  }
+  fprintf(outfile, "\n");
+  return;
+}
+
+/* ----------------------------------------------------------------------------
+ * Functions to access the contents of the block sparse matrix structure
+ */
+
+sunindextype SUNBlockSparseMatrix_Rows(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNoRet(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_BLOCKROWS_BS(A) * SM_BLOCKSIZE_BS(A);
+}
+
+sunindextype SUNBlockSparseMatrix_Columns(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNoRet(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_BLOCKCOLS_BS(A) * SM_BLOCKSIZE_BS(A);
+}
+
+sunindextype SUNBlockSparseMatrix_BlockRows(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNoRet(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_BLOCKROWS_BS(A);
+}
+
+sunindextype SUNBlockSparseMatrix_BlockColumns(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNoRet(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_BLOCKCOLS_BS(A);
+}
+
+sunindextype SUNBlockSparseMatrix_BlockSize(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNoRet(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_BLOCKSIZE_BS(A);
+}
+
+sunindextype SUNBlockSparseMatrix_NNZB(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNoRet(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_NNZB_BS(A);
+}
+
+sunrealtype* SUNBlockSparseMatrix_Data(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNull(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_DATA_BS(A);
+}
+
+sunindextype* SUNBlockSparseMatrix_ColumnIndices(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNull(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_COLIND_BS(A);
+}
+
+sunindextype* SUNBlockSparseMatrix_RowPointers(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssertNull(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  return SM_ROWPTRS_BS(A);
+}
+
+/*
+ * -----------------------------------------------------------------
+ * implementation of matrix operations
+ * -----------------------------------------------------------------
+ */
+
+SUNMatrix_ID SUNMatGetID_BlockSparse(SUNDIALS_MAYBE_UNUSED SUNMatrix A)
+{
+  return SUNMATRIX_BLOCKSPARSE;
+}
+
+SUNMatrix SUNMatClone_BlockSparse(SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNMatrix B = SUNBlockSparseMatrix(SM_BLOCKROWS_BS(A), SM_BLOCKCOLS_BS(A),
+                                     SM_BLOCKSIZE_BS(A), SM_NNZB_BS(A),
+                                     A->sunctx);
+  SUNCheckLastErrNull();
+  return (B);
+}
+
+void SUNMatDestroy_BlockSparse(SUNMatrix A)
+{
+  if (A == NULL) { return; }
+
+  /* free content */
+  if (A->content != NULL)
+  {
+    free(SM_DATA_BS(A));
+    free(SM_COLIND_BS(A));
+    free(SM_ROWPTRS_BS(A));
+    free(SM_CONTENT_BS(A)->diag);
+    free(SM_CONTENT_BS(A)->bdiag);
+    free(SM_CONTENT_BS(A)->bcols);
+    free(SM_CONTENT_BS(A)->bpivots);
+    free(A->content);
+    A->content = NULL;
+  }
+
+  /* free ops and matrix */
+  if (A->ops)
+  {
+    free(A->ops);
+    A->ops = NULL;
+  }
+  free(A);
+  A = NULL;
+
+  return;
+}
+
+/* The block pattern is kept, only the values of the stored blocks are zeroed */
+SUNErrCode SUNMatZero_BlockSparse(SUNMatrix A)
+{
+  sunindextype l, n;
+
+  n = SM_ROWPTRS_BS(A)[SM_BLOCKROWS_BS(A)] * SM_BLOCKSIZE_BS(A) *
+      SM_BLOCKSIZE_BS(A);
+  for (l = 0; l < n; l++) { SM_DATA_BS(A)[l] = ZERO; }
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMatCopy_BlockSparse(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype l, M, nnzb, bs;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(SUNMatGetID(B) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNCheck(compatibleMatrices(A, B), SUN_ERR_ARG_DIMSMISMATCH);
+
+  M    = SM_BLOCKROWS_BS(A);
+  bs   = SM_BLOCKSIZE_BS(A);
+  nnzb = SM_ROWPTRS_BS(A)[M];
+
+  /* ensure that B has storage for the blocks of A */
+  if (SM_NNZB_BS(B) < nnzb)
+  {
+    SUNCheckCall(SUNBlockSparseMatrix_Reallocate(B, nnzb));
+  }
+
+  /* copy the pattern and the blocks */
+  for (l = 0; l <= M; l++) { SM_ROWPTRS_BS(B)[l] = SM_ROWPTRS_BS(A)[l]; }
+  for (l = 0; l < nnzb; l++) { SM_COLIND_BS(B)[l] = SM_COLIND_BS(A)[l]; }
+  for (l = 0; l < nnzb * bs * bs; l++) { SM_DATA_BS(B)[l] = SM_DATA_BS(A)[l]; }
+
+  /* B has the pattern of A, so the diagonal positions of A apply to B */
+  if (SM_CONTENT_BS(A)->diag && SM_CONTENT_BS(A) != SM_CONTENT_BS(B))
+  {
+    if (SM_CONTENT_BS(B)->diag == NULL)
+    {
+      SM_CONTENT_BS(B)->diag = (sunindextype*)malloc(M * sizeof(sunindextype));
+      SUNAssert(SM_CONTENT_BS(B)->diag, SUN_ERR_MALLOC_FAIL);
+    }
+    for (l = 0; l < M; l++)
+    {
+      SM_CONTENT_BS(B)->diag[l] = SM_CONTENT_BS(A)->diag[l];
+    }
+  }
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMatScaleAddI_BlockSparse(sunrealtype c, SUNMatrix A)
+{
+  sunindextype i, l, r, n, bs, M, nmissing;
+  sunrealtype* b;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(SM_BLOCKROWS_BS(A) == SM_BLOCKCOLS_BS(A), SUN_ERR_ARG_INCOMPATIBLE);
+
+  M  = SM_BLOCKROWS_BS(A);
+  bs = SM_BLOCKSIZE_BS(A);
+
+  /* insert the missing diagonal blocks as zero blocks */
+  SUNCheckCall(find_diagonal(A, &nmissing));
+  if (nmissing > 0) { SUNCheckCall(insert_diagonal(A, nmissing)); }
+
+  /* scale the stored blocks, then add the identity to the diagonal blocks */
+  n = SM_ROWPTRS_BS(A)[M] * bs * bs;
+  for (l = 0; l < n; l++) { SM_DATA_BS(A)[l] *= c; }
+
+  for (i = 0; i < M; i++)
+  {
+    b = SM_BLOCK_BS(A, SM_CONTENT_BS(A)->diag[i]);
+    for (r = 0; r < bs; r++) { b[r * (bs + 1)] += ONE; }
+  }
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMatScaleAdd_BlockSparse(sunrealtype c, SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, j, k, l, p, q, M, N, bs, bs2, nnzb, nz, start;
+  sunindextype *Arowptrs, *Acolind, *Browptrs, *Bcolind;
+  sunindextype *rowptrs, *colind, *mark, *pos;
+  sunrealtype *Adata, *Bdata, *data, *dst, *src;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(SUNMatGetID(B) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNCheck(compatibleMatrices(A, B), SUN_ERR_ARG_DIMSMISMATCH);
+
+  M   = SM_BLOCKROWS_BS(A);
+  N   = SM_BLOCKCOLS_BS(A);
+  bs  = SM_BLOCKSIZE_BS(A);
+  bs2 = bs * bs;
+
+  Arowptrs = SM_ROWPTRS_BS(A);
+  Acolind  = SM_COLIND_BS(A);
+  Adata    = SM_DATA_BS(A);
+  Browptrs = SM_ROWPTRS_BS(B);
+  Bcolind  = SM_COLIND_BS(B);
+  Bdata    = SM_DATA_BS(B);
+
+  /* with the same pattern the sum is a single pass over the values */
+  if (samePattern(A, B))
+  {
+    nz = Arowptrs[M] * bs2;
+    for (l = 0; l < nz; l++) { Adata[l] = c * Adata[l] + Bdata[l]; }
+    return SUN_SUCCESS;
+  }
+
+  /* mark[j] == i if block column j is in block row i of the sum, and pos[j] is
+     then its position */
+  mark = (sunindextype*)malloc(N * sizeof(sunindextype));
+  SUNAssert(mark, SUN_ERR_MALLOC_FAIL);
+
+  pos = (sunindextype*)malloc(N * sizeof(sunindextype));
+  SUNAssert(pos, SUN_ERR_MALLOC_FAIL);
+
+  /* count the blocks of the sum */
+  for (j = 0; j < N; j++) { mark[j] = -1; }
+  nnzb = 0;
+  for (i = 0; i < M; i++)
+  {
+    for (k = Arowptrs[i]; k < Arowptrs[i + 1]; k++)
+    {
+      if (mark[Acolind[k]] != i)
+      {
+        mark[Acolind[k]] = i;
+        nnzb++;
+      }
+    }
+    for (k = Browptrs[i]; k < Browptrs[i + 1]; k++)
+    {
+      if (mark[Bcolind[k]] != i)
+      {
+        mark[Bcolind[k]] = i;
+        nnzb++;
+      }
+    }
+  }
+
+  /* allocate the new storage */
+  rowptrs = (sunindextype*)malloc((M + 1) * sizeof(sunindextype));
+  SUNAssert(rowptrs, SUN_ERR_MALLOC_FAIL);
+
+  colind = (sunindextype*)malloc(SUNMAX(nnzb, 1) * sizeof(sunindextype));
+  SUNAssert(colind, SUN_ERR_MALLOC_FAIL);
+
+  data = (sunrealtype*)malloc(SUNMAX(nnzb * bs2, 1) * sizeof(sunrealtype));
+  SUNAssert(data, SUN_ERR_MALLOC_FAIL);
+
+  /* form each block row of the sum with sorted block columns */
+  for (j = 0; j < N; j++) { mark[j] = -1; }
+  nz = 0;
+  for (i = 0; i < M; i++)
+  {
+    rowptrs[i] = nz;
+    start      = nz;
+    for (k = Arowptrs[i]; k < Arowptrs[i + 1]; k++)
+    {
+      if (mark[Acolind[k]] != i)
+      {
+        mark[Acolind[k]] = i;
+        colind[nz++]     = Acolind[k];
+      }
+    }
+    for (k = Browptrs[i]; k < Browptrs[i + 1]; k++)
+    {
+      if (mark[Bcolind[k]] != i)
+      {
+        mark[Bcolind[k]] = i;
+        colind[nz++]     = Bcolind[k];
+      }
+    }
+
+    /* insertion sort, block rows are short */
+    for (p = start + 1; p < nz; p++)
+    {
+      j = colind[p];
+      for (q = p; q > start && colind[q - 1] > j; q--)
+      {
+        colind[q] = colind[q - 1];
+      }
+      colind[q] = j;
+    }
+
+    for (p = start; p < nz; p++)
+    {
+      pos[colind[p]] = p;
+      for (l = 0; l < bs2; l++) { data[p * bs2 + l] = ZERO; }
+    }
+
+    for (k = Arowptrs[i]; k < Arowptrs[i + 1]; k++)
+    {
+      dst = data + pos[Acolind[k]] * bs2;
+      src = Adata + k * bs2;
+      for (l = 0; l < bs2; l++) { dst[l] += c * src[l]; }
+    }
+    for (k = Browptrs[i]; k < Browptrs[i + 1]; k++)
+    {
+      dst = data + pos[Bcolind[k]] * bs2;
+      src = Bdata + k * bs2;
+      for (l = 0; l < bs2; l++) { dst[l] += src[l]; }
+    }
+  }
+  rowptrs[M] = nz;
+
+  /* replace the storage of A */
+  free(SM_ROWPTRS_BS(A));
+  free(SM_COLIND_BS(A));
+  free(SM_DATA_BS(A));
+  SM_ROWPTRS_BS(A) = rowptrs;
+  SM_COLIND_BS(A)  = colind;
+  SM_DATA_BS(A)    = data;
+  SM_NNZB_BS(A)    = nnzb;
+
+  free(mark);
+  free(pos);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMatMatvec_BlockSparse(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  sunindextype M, *rowptrs, *colind;
+  sunrealtype *data, *xd, *yd;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNCheck(compatibleMatrixAndVectors(A, x, y), SUN_ERR_ARG_DIMSMISMATCH);
+
+  M       = SM_BLOCKROWS_BS(A);
+  rowptrs = SM_ROWPTRS_BS(A);
+  colind  = SM_COLIND_BS(A);
+  data    = SM_DATA_BS(A);
+
+  /* access vector data (return if failure) */
+  xd = N_VGetArrayPointer(x);
+  SUNCheckLastErr();
+  yd = N_VGetArrayPointer(y);
+  SUNCheckLastErr();
+  SUNAssert(xd != yd, SUN_ERR_ARG_INCOMPATIBLE);
+
+  /* Perform operation with the kernel for the block size */
+  switch (SM_BLOCKSIZE_BS(A))
+  {
+  case 2: Matvec_2(M, rowptrs, colind, data, xd, yd); break;
+  case 3: Matvec_3(M, rowptrs, colind, data, xd, yd); break;
+  case 4: Matvec_4(M, rowptrs, colind, data, xd, yd); break;
+  case 5: Matvec_5(M, rowptrs, colind, data, xd, yd); break;
+  case 6: Matvec_6(M, rowptrs, colind, data, xd, yd); break;
+  case 7: Matvec_7(M, rowptrs, colind, data, xd, yd); break;
+  case 8: Matvec_8(M, rowptrs, colind, data, xd, yd); break;
+  default:
+    Matvec_Generic(M, SM_BLOCKSIZE_BS(A), rowptrs, colind, data, xd, yd);
+  }
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMatSpace_BlockSparse(SUNMatrix A, long int* lenrw,
+                                   long int* leniw)
+{
+  sunindextype M, bs;
+  SUNFunctionBegin(A->sunctx);
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_BLOCKSPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(lenrw, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(leniw, SUN_ERR_ARG_CORRUPT);
+
+  M  = SM_BLOCKROWS_BS(A);
+  bs = SM_BLOCKSIZE_BS(A);
+
+  *lenrw = SM_NNZB_BS(A) * bs * bs;
+  *leniw = 10 + M + 1 + SM_NNZB_BS(A);
+  if (SM_CONTENT_BS(A)->diag) { *leniw += M; }
+  if (SM_CONTENT_BS(A)->bdiag)
+  {
+    *lenrw += M * bs * bs;
+    *leniw += M * bs;
+  }
+  return SUN_SUCCESS;
+}
+
+/*
+ * =================================================================
+ * private functions
+ * =================================================================
+ */
+
+/* -----------------------------------------------------------------
+ * Function to check compatibility of two block sparse SUNMatrix objects
+ */
+
+SUNDIALS_MAYBE_UNUSED
+static sunbooleantype compatibleMatrices(SUNMatrix A, SUNMatrix B)
+{
+  /* both matrices must have the same block shape and block size */
+  if (SM_BLOCKROWS_BS(A) != SM_BLOCKROWS_BS(B)) { return SUNFALSE; }
+  if (SM_BLOCKCOLS_BS(A) != SM_BLOCKCOLS_BS(B)) { return SUNFALSE; }
+  if (SM_BLOCKSIZE_BS(A) != SM_BLOCKSIZE_BS(B)) { return SUNFALSE; }
+
+  return SUNTRUE;
+}
+
+/* -----------------------------------------------------------------
+ * Function to check compatibility of a SUNMatrix object with two
+ * N_Vectors (A*x = b)
+ */
+
+SUNDIALS_MAYBE_UNUSED
+static sunbooleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x,
+                                                 N_Vector y)
+{
+  /* vectors must implement N_VGetArrayPointer */
+  if ((x->ops->nvgetarraypointer == NULL) || (y->ops->nvgetarraypointer == NULL))
+  {
+    return SUNFALSE;
+  }
+
+  /* Verify that the dimensions of A, x, and y agree */
+  if ((SUNBlockSparseMatrix_Columns(A) != N_VGetLength(x)) ||
+      (SUNBlockSparseMatrix_Rows(A) != N_VGetLength(y)))
+  {
+    return SUNFALSE;
+  }
+
+  return SUNTRUE;
+}
+
+/* -----------------------------------------------------------------
+ * Function to check if two block sparse matrices have the same block
+ * pattern (the same block columns in the same order in each row)
+ */
+
+static sunbooleantype samePattern(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, M;
+
+  if (A == B) { return SUNTRUE; }
+
+  M = SM_BLOCKROWS_BS(A);
+  for (i = 0; i <= M; i++)
+  {
+    if (SM_ROWPTRS_BS(A)[i] != SM_ROWPTRS_BS(B)[i]) { return SUNFALSE; }
+  }
+  for (i = 0; i < SM_ROWPTRS_BS(A)[M]; i++)
+  {
+    if (SM_COLIND_BS(A)[i] != SM_COLIND_BS(B)[i]) { return SUNFALSE; }
+  }
+
+  return SUNTRUE;
+}
+
+/* -----------------------------------------------------------------
+ * Computes y = A x for any block size. The specialized kernels in
+ * sunmatrix_blocksparse_kernels.h are used for block sizes 2 to 8.
+ */
+
+static void Matvec_Generic(sunindextype M, sunindextype bs,
+                           const sunindextype* rowptrs,
+                           const sunindextype* colind, const sunrealtype* data,
+                           const sunrealtype* x, sunrealtype* y)
+{
+  sunindextype i, k, r, c;
+  sunrealtype* yi;
+  const sunrealtype *b, *xj;
+
+  for (i = 0; i < M; i++)
+  {
+    yi = y + i * bs;
+    for (r = 0; r < bs; r++) { yi[r] = ZERO; }
+
+    for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+    {
+      b  = data + k * bs * bs;
+      xj = x + colind[k] * bs;
+      for (c = 0; c < bs; c++)
+      {
+        for (r = 0; r < bs; r++) { yi[r] += b[c * bs + r] * xj[c]; }
+      }
+    }
+  }
+}
+
+/* -----------------------------------------------------------------
+ * Creates the block pattern by columns: tptrs[j] is the first entry
+ * of block column j in trows (block rows, sorted) and tpos (the
+ * positions of the blocks in A). tpos may be NULL if not needed.
+ * The caller is responsible for freeing the arrays.
+ */
+
+static SUNErrCode transpose_pattern(SUNMatrix A, sunindextype** tptrs,
+                             sunindextype** trows, sunindextype** tpos)
+{
+  sunindextype i, j, k, l, M, N, nnzb;
+  sunindextype *rowptrs, *colind, *next;
+  SUNFunctionBegin(A->sunctx);
+
+  M       = SM_BLOCKROWS_BS(A);
+  N       = SM_BLOCKCOLS_BS(A);
+  rowptrs = SM_ROWPTRS_BS(A);
+  colind  = SM_COLIND_BS(A);
+  nnzb    = rowptrs[M];
+
+  *tptrs = (sunindextype*)calloc(N + 1, sizeof(sunindextype));
+  SUNAssert(*tptrs, SUN_ERR_MALLOC_FAIL);
+
+  *trows = (sunindextype*)malloc(SUNMAX(nnzb, 1) * sizeof(sunindextype));
+  SUNAssert(*trows, SUN_ERR_MALLOC_FAIL);
+
+  if (tpos)
+  {
+    *tpos = (sunindextype*)malloc(SUNMAX(nnzb, 1) * sizeof(sunindextype));
+    SUNAssert(*tpos, SUN_ERR_MALLOC_FAIL);
+  }
+
+  next = (sunindextype*)malloc(N * sizeof(sunindextype));
+  SUNAssert(next, SUN_ERR_MALLOC_FAIL);
+
+  /* count the blocks in each block column */
+  for (k = 0; k < nnzb; k++) { (*tptrs)[colind[k] + 1]++; }
+  for (j = 0; j < N; j++)
+  {
+    (*tptrs)[j + 1] += (*tptrs)[j];
+    next[j] = (*tptrs)[j];
+  }
+
+  /* scan the block rows in order */
+  for (i = 0; i < M; i++)
+  {
+    for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+    {
+      l           = next[colind[k]]++;
+      (*trows)[l] = i;
+      if (tpos) { (*tpos)[l] = k; }
+    }
+  }
+
+  free(next);
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Updates the cached positions of the diagonal blocks of a square
+ * block sparse matrix. A cached position is only kept if it still
+ * holds the diagonal block of its row, otherwise the row is searched.
+ * On return diag[i] is -1 for the nmissing rows without a diagonal
+ * block.
+ */
+
+static SUNErrCode find_diagonal(SUNMatrix A, sunindextype* nmissing)
+{
+  sunindextype i, k, d, M;
+  sunindextype *rowptrs, *colind, *diag;
+  SUNFunctionBegin(A->sunctx);
+
+  M       = SM_BLOCKROWS_BS(A);
+  rowptrs = SM_ROWPTRS_BS(A);
+  colind  = SM_COLIND_BS(A);
+
+  if (SM_CONTENT_BS(A)->diag == NULL)
+  {
+    SM_CONTENT_BS(A)->diag = (sunindextype*)malloc(M * sizeof(sunindextype));
+    SUNAssert(SM_CONTENT_BS(A)->diag, SUN_ERR_MALLOC_FAIL);
+    for (i = 0; i < M; i++) { SM_CONTENT_BS(A)->diag[i] = -1; }
+  }
+  diag = SM_CONTENT_BS(A)->diag;
+
+  *nmissing = 0;
+  for (i = 0; i < M; i++)
+  {
+    d = diag[i];
+    if (d >= rowptrs[i] && d < rowptrs[i + 1] && colind[d] == i) { continue; }
+
+    diag[i] = -1;
+    for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+    {
+      if (colind[k] == i)
+      {
+        diag[i] = k;
+        break;
+      }
+    }
+    if (diag[i] < 0) { (*nmissing)++; }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Inserts zero blocks for the nmissing diagonal blocks found by
+ * find_diagonal, before the first block with a larger block column
+ * so that sorted rows stay sorted, and updates the diagonal positions.
+ */
+
+static SUNErrCode insert_diagonal(SUNMatrix A, sunindextype nmissing)
+{
+  sunindextype i, k, l, M, bs2, nnzb, nz, kstart, kend;
+  sunindextype *rowptrs, *colind, *diag, *newcolind;
+  sunrealtype *data, *newdata;
+  sunbooleantype missing;
+  SUNFunctionBegin(A->sunctx);
+
+  M       = SM_BLOCKROWS_BS(A);
+  bs2     = SM_BLOCKSIZE_BS(A) * SM_BLOCKSIZE_BS(A);
+  rowptrs = SM_ROWPTRS_BS(A);
+  colind  = SM_COLIND_BS(A);
+  data    = SM_DATA_BS(A);
+  diag    = SM_CONTENT_BS(A)->diag;
+  nnzb    = rowptrs[M] + nmissing;
+
+  newcolind = (sunindextype*)malloc(nnzb * sizeof(sunindextype));
+  SUNAssert(newcolind, SUN_ERR_MALLOC_FAIL);
+
+  newdata = (sunrealtype*)malloc(nnzb * bs2 * sizeof(sunrealtype));
+  SUNAssert(newdata, SUN_ERR_MALLOC_FAIL);
+
+  nz     = 0;
+  kstart = rowptrs[0];
+  for (i = 0; i < M; i++)
+  {
+    kend       = rowptrs[i + 1];
+    rowptrs[i] = nz;
+    missing    = (diag[i] < 0);
+
+    for (k = kstart; k <= kend; k++)
+    {
+      /* insert the zero diagonal block before a larger block column */
+      if (missing && (k == kend || colind[k] > i))
+      {
+        newcolind[nz] = i;
+        for (l = 0; l < bs2; l++) { newdata[nz * bs2 + l] = ZERO; }
+        diag[i] = nz++;
+        missing = SUNFALSE;
+      }
+      if (k == kend) { break; }
+
+      newcolind[nz] = colind[k];
+      for (l = 0; l < bs2; l++) { newdata[nz * bs2 + l] = data[k * bs2 + l]; }
+      if (colind[k] == i && diag[i] == k) { diag[i] = nz; }
+      nz++;
+    }
+    kstart = kend;
+  }
+  rowptrs[M] = nz;
+
+  free(SM_COLIND_BS(A));
+  free(SM_DATA_BS(A));
+  SM_COLIND_BS(A) = newcolind;
+  SM_DATA_BS(A)   = newdata;
+  SM_NNZB_BS(A)   = nnzb;
+
+  return SUN_SUCCESS;
+}
@@ -0,0 +1,49 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Block size specific kernels for the block sparse SUNMATRIX. This
+ * file is included once for each specialized block size by
+ * sunmatrix_blocksparse.c after defining the following macros:
+ *
+ *   BSR_FN(name) - name of the kernel for the block size
+ *   BSR_BS       - the block size, a compile-time constant
+ *
+ * With a constant block size the loops over a block are fully
+ * unrolled and the products of a block row are accumulated in
+ * registers.
+ * -----------------------------------------------------------------*/
+
+/* y = A x for the M block rows of A */
+static void BSR_FN(Matvec)(sunindextype M, const sunindextype* rowptrs,
+                           const sunindextype* colind, const sunrealtype* data,
+                           const sunrealtype* x, sunrealtype* y)
+{
+  sunindextype i, k;
+  int r, c;
+
+  for (i = 0; i < M; i++)
+  {
+    sunrealtype sum[BSR_BS];
+    for (r = 0; r < BSR_BS; r++) { sum[r] = ZERO; }
+
+    for (k = rowptrs[i]; k < rowptrs[i + 1]; k++)
+    {
+      const sunrealtype* b  = data + k * BSR_BS * BSR_BS;
+      const sunrealtype* xj = x + colind[k] * BSR_BS;
+      for (c = 0; c < BSR_BS; c++)
+      {
+        for (r = 0; r < BSR_BS; r++) { sum[r] += b[c * BSR_BS + r] * xj[c]; }
+      }
+    }
+
+    for (r = 0; r < BSR_BS; r++) { y[i * BSR_BS + r] = sum[r]; }
+  }
+}
@@ -41,7 +41,17 @@ static sunbooleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x,
                                                  N_Vector y);
 static SUNErrCode Matvec_SparseCSC(SUNMatrix A, N_Vector x, N_Vector y);
 static SUNErrCode Matvec_SparseCSR(SUNMatrix A, N_Vector x, N_Vector y);
+static SUNErrCode Matvec_SparseThreaded(SUNMatrix A, N_Vector x, N_Vector y);
+static SUNErrCode update_csr_view(SUNMatrix A);
 static SUNErrCode format_convert(const SUNMatrix A, SUNMatrix B);
+static SUNErrCode transpose_pattern(sunindextype np, sunindextype nt,
+                                    const sunindextype* ptrs,
+                                    const sunindextype* vals,
+                                    sunindextype** tptrs, sunindextype** tvals,
+                                    sunindextype** tperm);
+static SUNErrCode find_diagonal(SUNMatrix A, sunindextype* nmissing);
+static SUNErrCode scale_add_diagonal(sunrealtype c, sunrealtype d, SUNMatrix A);
+static sunbooleantype samePattern(SUNMatrix A, SUNMatrix B);
 
 /*
  * -----------------------------------------------------------------
@@ -121,7 +131,14 @@ SUNMatrix SUNSparseMatrix(sunindextype M, sunindextype N, sunindextype NNZ,
   }
   content->data      = NULL;
   content->indexvals = NULL;
-  content->indexptrs = NULL;
+  content->indexptrs   = NULL;
+  content->diag        = NULL;
+  content->num_threads = 1;
+  content->csrptrs     = NULL;
+  content->csrvals     = NULL;
+  content->csrperm     = NULL;
+  content->rowpart     = NULL;
+  content->csrvalid    = SUNFALSE;
 
   /* Allocate content */
   content->data = (sunrealtype*)calloc(NNZ, sizeof(sunrealtype));
@@ -342,6 +359,8 @@ SUNErrCode SUNSparseMatrix_Realloc(SUNMatrix A)
   nzmax = (SM_INDEXPTRS_S(A))[SM_NP_S(A)];
   SUNAssert(nzmax >= 0, SUN_ERR_ARG_CORRUPT);
 
+  SM_CONTENT_S(A)->csrvalid = SUNFALSE;
+
   /* perform reallocation */
   SM_INDEXVALS_S(A) = (sunindextype*)realloc(SM_INDEXVALS_S(A),
                                              nzmax * sizeof(sunindextype));
@@ -368,6 +387,8 @@ SUNErrCode SUNSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZ)
   SUNAssert(SUNMatGetID(A) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
   SUNAssert(NNZ >= 0, SUN_ERR_ARG_OUTOFRANGE);
 
+  SM_CONTENT_S(A)->csrvalid = SUNFALSE;
+
   /* perform reallocation */
   SM_INDEXVALS_S(A) = (sunindextype*)realloc(SM_INDEXVALS_S(A),
                                              NNZ * sizeof(sunindextype));
@@ -381,6 +402,134 @@ SUNErrCode SUNSparseMatrix_Reallocate(SUNMatrix A, sunindextype NNZ)
   return SUN_SUCCESS;
 }
 
+/* ----------------------------------------------------------------------------
+ * Function to insert explicit zeros into the sparsity pattern for the diagonal
+ * entries that are not already stored, reallocating the storage if needed. The
+ * positions of the diagonal entries are cached in the matrix, so while the
+ * pattern is unchanged SUNMatScaleAddI only scales the values and updates the
+ * diagonal in place.
+ */
+
+SUNErrCode SUNSparseMatrix_InsertDiagonal(SUNMatrix A)
+{
+  sunindextype nmissing;
+  SUNFunctionBegin(A->sunctx);
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
+
+  SUNCheckCall(find_diagonal(A, &nmissing));
+  if (nmissing > 0) { SUNCheckCall(scale_add_diagonal(ONE, ZERO, A)); }
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to set the number of OpenMP threads used by the matrix-vector
+ * product. With more than one thread the rows of the product are divided among
+ * the threads so that each thread works on about the same number of nonzeros.
+ * CSC matrices use a cached CSR view of their pattern for the product.
+ */
+
+SUNErrCode SUNSparseMatrix_SetNumThreads(SUNMatrix A, int num_threads)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(num_threads >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  SM_CONTENT_S(A)->num_threads = num_threads;
+  SM_CONTENT_S(A)->csrvalid    = SUNFALSE;
+
+  return SUN_SUCCESS;
+}
+
+/* ----------------------------------------------------------------------------
+ * Function to partition the columns of a sparse matrix into structurally
+ * orthogonal groups i.e., no two columns in the same group have a nonzero in
+ * the same row. On return colors[j] is the group of column j and ncolors is the
+ * number of groups. The groups are assigned greedily in column order so that
+ * the columns of a difference quotient Jacobian with this pattern can be
+ * computed with one function evaluation per group (Curtis, Powell, and Reid).
+ */
+
+SUNErrCode SUNSparseMatrix_ColorColumns(SUNMatrix A, sunindextype* colors,
+                                        sunindextype* ncolors)
+{
+  sunindextype i, j, k, l, c, M, N;
+  sunindextype *colptrs, *rowvals, *rowptrs, *colvals, *tptrs, *tvals, *mark;
+  SUNFunctionBegin(A->sunctx);
+
+  SUNAssert(SUNMatGetID(A) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
+  SUNAssert(colors, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(ncolors, SUN_ERR_ARG_CORRUPT);
+
+  M = SM_ROWS_S(A);
+  N = SM_COLUMNS_S(A);
+
+  /* both the rows in each column and the columns in each row are needed,
+     create the index arrays for the format A is not stored in */
+  tptrs = NULL;
+  tvals = NULL;
+  if (SM_SPARSETYPE_S(A) == CSC_MAT)
+  {
+    SUNCheckCall(transpose_pattern(N, M, SM_INDEXPTRS_S(A), SM_INDEXVALS_S(A),
+                                   &tptrs, &tvals, NULL));
+    colptrs = SM_INDEXPTRS_S(A);
+    rowvals = SM_INDEXVALS_S(A);
+    rowptrs = tptrs;
+    colvals = tvals;
+  }
+  else
+  {
+    SUNCheckCall(transpose_pattern(M, N, SM_INDEXPTRS_S(A), SM_INDEXVALS_S(A),
+                                   &tptrs, &tvals, NULL));
+    colptrs = tptrs;
+    rowvals = tvals;
+    rowptrs = SM_INDEXPTRS_S(A);
+    colvals = SM_INDEXVALS_S(A);
+  }
+
+  /* mark[c] == j if color c is used by a neighbor of column j */
+  mark = (sunindextype*)malloc(SUNMAX(N, 1) * sizeof(sunindextype));
+  if (mark == NULL)
+  {
+    free(tptrs);
+    free(tvals);
+  }
+  SUNAssert(mark, SUN_ERR_MALLOC_FAIL);
+
+  for (j = 0; j < N; j++)
+  {
+    colors[j] = -1;
+    mark[j]   = -1;
+  }
+
+  *ncolors = 0;
+  for (j = 0; j < N; j++)
+  {
+    /* mark the colors of columns sharing a row with column j */
+    for (k = colptrs[j]; k < colptrs[j + 1]; k++)
+    {
+      i = rowvals[k];
+      for (l = rowptrs[i]; l < rowptrs[i + 1]; l++)
+      {
+        c = colors[colvals[l]];
+        if (c >= 0) { mark[c] = j; }
+      }
+    }
+
+    /* assign the smallest unmarked color */
+    c = 0;
+    while (mark[c] == j) { c++; }
+    colors[j] = c;
+    if (c + 1 > *ncolors) { *ncolors = c + 1; }
+  }
+
+  free(mark);
+  free(tptrs);
+  free(tvals);
+
+  return SUN_SUCCESS;
+}
+
 /* ----------------------------------------------------------------------------
  * Function to print the sparse matrix
  */
@@ -510,6 +659,7 @@ SUNMatrix SUNMatClone_Sparse(SUNMatrix A)
   SUNMatrix B = SUNSparseMatrix(SM_ROWS_S(A), SM_COLUMNS_S(A), SM_NNZ_S(A),
                                 SM_SPARSETYPE_S(A), A->sunctx);
   SUNCheckLastErrNull();
+  SM_CONTENT_S(B)->num_threads = SM_CONTENT_S(A)->num_threads;
   return (B);
 }
 
@@ -542,6 +692,21 @@ void SUNMatDestroy_Sparse(SUNMatrix A)
       SM_CONTENT_S(A)->colptrs = NULL;
       SM_CONTENT_S(A)->rowptrs = NULL;
     }
+    /* free diagonal positions array */
+    if (SM_CONTENT_S(A)->diag)
+    {
+      free(SM_CONTENT_S(A)->diag);
+      SM_CONTENT_S(A)->diag = NULL;
+    }
+    /* free the CSR view and row partition */
+    free(SM_CONTENT_S(A)->csrptrs);
+    free(SM_CONTENT_S(A)->csrvals);
+    free(SM_CONTENT_S(A)->csrperm);
+    free(SM_CONTENT_S(A)->rowpart);
+    SM_CONTENT_S(A)->csrptrs = NULL;
+    SM_CONTENT_S(A)->csrvals = NULL;
+    SM_CONTENT_S(A)->csrperm = NULL;
+    SM_CONTENT_S(A)->rowpart = NULL;
     /* free content struct */
     free(A->content);
     A->content = NULL;
@@ -571,12 +736,13 @@ SUNErrCode SUNMatZero_Sparse(SUNMatrix A)
   }
   for (i = 0; i < SM_NP_S(A); i++) { (SM_INDEXPTRS_S(A))[i] = 0; }
   (SM_INDEXPTRS_S(A))[SM_NP_S(A)] = 0;
+  SM_CONTENT_S(A)->csrvalid       = SUNFALSE;
   return SUN_SUCCESS;
 }
 
 SUNErrCode SUNMatCopy_Sparse(SUNMatrix A, SUNMatrix B)
 {
-  sunindextype i, A_nz;
+  sunindextype i, A_nz, nd;
   SUNFunctionBegin(A->sunctx);
 
   SUNAssert(SUNMatGetID(A) == SUNMATRIX_SPARSE, SUN_ERR_ARG_WRONGTYPE);
@@ -601,7 +767,8 @@ SUNErrCode SUNMatCopy_Sparse(SUNMatrix A, SUNMatrix B)
     SM_NNZ_S(B) = A_nz;
   }
 
-  /* zero out B so that copy works correctly */
+  /* zero out B so that copy works correctly (this also invalidates the CSR
+     view of B) */
   SUNCheckCall(SUNMatZero_Sparse(B));
 
   /* copy the data and row indices over */
@@ -618,239 +785,28 @@ SUNErrCode SUNMatCopy_Sparse(SUNMatrix A, SUNMatrix B)
   }
   (SM_INDEXPTRS_S(B))[SM_NP_S(A)] = A_nz;
 
-  return SUN_SUCCESS;
-}
-
-SUNErrCode SUNMatScaleAddI_Sparse(sunrealtype c, SUNMatrix A)
-{
-  sunindextype j, i, p, nz, newvals, M, N, cend, nw;
-  sunbooleantype newmat, found;
-  sunindextype *w, *Ap, *Ai, *Cp, *Ci;
-  sunrealtype *x, *Ax, *Cx;
-  SUNMatrix C;
-  SUNFunctionBegin(A->sunctx);
-
-  /* store shortcuts to matrix dimensions (M is inner dimension, N is outer) */
-  if (SM_SPARSETYPE_S(A) == CSC_MAT)
-  {
-    M = SM_ROWS_S(A);
-    N = SM_COLUMNS_S(A);
-  }
-  else
-  {
-    M = SM_COLUMNS_S(A);
-    N = SM_ROWS_S(A);
-  }
-
-  /* access data arrays from A */
-  Ap = NULL;
-  Ai = NULL;
-  Ax = NULL;
-  Ap = SM_INDEXPTRS_S(A);
-  SUNAssert(Ap, SUN_ERR_ARG_CORRUPT);
-  Ai = SM_INDEXVALS_S(A);
-  SUNAssert(Ai, SUN_ERR_ARG_CORRUPT);
-  Ax = SM_DATA_S(A);
-  SUNAssert(Ax, SUN_ERR_ARG_CORRUPT);
-
-  /* determine if A: contains values on the diagonal (so I can just be added
-     in); if not, then increment counter for extra storage that should be
-     required. */
-  newvals = 0;
-  for (j = 0; j < SUNMIN(M, N); j++)
-  {
-    /* scan column (row if CSR) of A, searching for diagonal value */
-    found = SUNFALSE;
-    for (i = Ap[j]; i < Ap[j + 1]; i++)
-    {
-      if (Ai[i] == j)
-      {
-        found = SUNTRUE;
-        break;
-      }
-    }
-    /* if no diagonal found, increment necessary storage counter */
-    if (!found) { newvals += 1; }
-  }
-
-  /* If extra nonzeros required, check whether matrix has sufficient storage
-     space for new nonzero entries  (so I can be inserted into existing storage)
-   */
-  newmat = SUNFALSE; /* no reallocation needed */
-  if (newvals > (SM_NNZ_S(A) - Ap[N])) { newmat = SUNTRUE; }
-
-  /* perform operation based on existing/necessary structure */
-
-  /*   case 1: A already contains a diagonal */
-  if (newvals == 0)
+  /* B has the pattern of A, so the diagonal positions of A apply to B */
+  if (SM_CONTENT_S(A)->diag)
   {
-    /* iterate through columns, adding 1.0 to diagonal */
-    for (j = 0; j < SUNMIN(M, N); j++)
+    nd = SUNMIN(SM_ROWS_S(A), SM_COLUMNS_S(A));
+    if (SM_CONTENT_S(B)->diag == NULL)
     {
-      for (i = Ap[j]; i < Ap[j + 1]; i++)
-      {
-        if (Ai[i] == j) { Ax[i] = ONE + c * Ax[i]; }
-        else { Ax[i] = c * Ax[i]; }
-      }
+      SM_CONTENT_S(B)->diag = (sunindextype*)malloc(nd * sizeof(sunindextype));
+      SUNAssert(SM_CONTENT_S(B)->diag, SUN_ERR_MALLOC_FAIL);
     }
-
-    /*   case 2: A has sufficient storage, but does not already contain a
-     * diagonal */
-  }
-  else if (!newmat)
-  {
-    /* create work arrays for nonzero row (column) indices and values in a
-     * single column (row) */
-    w = (sunindextype*)malloc(M * sizeof(sunindextype));
-    SUNAssert(w, SUN_ERR_MALLOC_FAIL);
-    x = (sunrealtype*)malloc(M * sizeof(sunrealtype));
-    SUNAssert(x, SUN_ERR_MALLOC_FAIL);
-
-    /* determine storage location where last column (row) should end */
-    nz = Ap[N] + newvals;
-
-    /* store pointer past last column (row) from original A,
-       and store updated value in revised A */
-    cend  = Ap[N];
-    Ap[N] = nz;
-
-    /* iterate through columns (rows) backwards */
-    for (j = N - 1; j >= 0; j--)
+    for (i = 0; i < nd; i++)
     {
-      /* reset diagonal entry, in case it's not in A */
-      x[j] = ZERO;
-
-      /* iterate down column (row) of A, collecting nonzeros */
-      for (p = Ap[j], i = 0; p < cend; p++, i++)
-      {
-        w[i]     = Ai[p];     /* collect row (column) index */
-        x[Ai[p]] = c * Ax[p]; /* collect/scale value */
-      }
-
-      /* NNZ in this column (row) */
-      nw = cend - Ap[j];
-
-      /* add identity to this column (row) */
-      if (j < M) { x[j] += ONE; /* update value */ }
-
-      /* fill entries of A with this column's (row's) data */
-      /* fill entries past diagonal */
-      for (i = nw - 1; i >= 0 && w[i] > j; i--)
-      {
-        Ai[--nz] = w[i];
-        Ax[nz]   = x[w[i]];
-      }
-      /* fill diagonal if applicable */
-      if (i < 0 /* empty or insert at front */ ||
-          w[i] != j /* insert behind front */)
-      {
-        Ai[--nz] = j;
-        Ax[nz]   = x[j];
-      }
-      /* fill entries before diagonal */
-      for (; i >= 0; i--)
-      {
-        Ai[--nz] = w[i];
-        Ax[nz]   = x[w[i]];
-      }
-
-      /* store ptr past this col (row) from orig A, update value for new A */
-      cend  = Ap[j];
-      Ap[j] = nz;
+      SM_CONTENT_S(B)->diag[i] = SM_CONTENT_S(A)->diag[i];
     }
-
-    /* clean up */
-    free(w);
-    free(x);
-
-    /*   case 3: A must be reallocated with sufficient storage */
   }
-  else
-  {
-    /* create work array for nonzero values in a single column (row) */
-    x = (sunrealtype*)malloc(M * sizeof(sunrealtype));
-
-    /* create new matrix for sum */
-    C = SUNSparseMatrix(SM_ROWS_S(A), SM_COLUMNS_S(A), Ap[N] + newvals,
-                        SM_SPARSETYPE_S(A), A->sunctx);
-    SUNCheckLastErr();
-
-    /* access data from CSR structures (return if failure) */
-    Cp = NULL;
-    Ci = NULL;
-    Cx = NULL;
-    Cp = SM_INDEXPTRS_S(C);
-    SUNAssert(Cp, SUN_ERR_ARG_CORRUPT);
-    Ci = SM_INDEXVALS_S(C);
-    SUNAssert(Ci, SUN_ERR_ARG_CORRUPT);
-    Cx = SM_DATA_S(C);
-    SUNAssert(Cx, SUN_ERR_ARG_CORRUPT);
-
-    /* initialize total nonzero count */
-    nz = 0;
-
-    /* iterate through columns (rows for CSR) */
-    for (j = 0; j < N; j++)
-    {
-      /* set current column (row) pointer to current # nonzeros */
-      Cp[j] = nz;
 
-      /* reset diagonal entry, in case it's not in A */
-      x[j] = ZERO;
-
-      /* iterate down column (along row) of A, collecting nonzeros */
-      for (p = Ap[j]; p < Ap[j + 1]; p++)
-      {
-        x[Ai[p]] = c * Ax[p]; /* collect/scale value */
-      }
-
-      /* add identity to this column (row) */
-      if (j < M) { x[j] += ONE; /* update value */ }
-
-      /* fill entries of C with this column's (row's) data */
-      /* fill entries before diagonal */
-      for (p = Ap[j]; p < Ap[j + 1] && Ai[p] < j; p++)
-      {
-        Ci[nz]   = Ai[p];
-        Cx[nz++] = x[Ai[p]];
-      }
-      /* fill diagonal if applicable */
-      if (p >= Ap[j + 1] /* empty or insert at end */ ||
-          Ai[p] != j /* insert before end */)
-      {
-        Ci[nz]   = j;
-        Cx[nz++] = x[j];
-      }
-      /* fill entries past diagonal */
-      for (; p < Ap[j + 1]; p++)
-      {
-        Ci[nz]   = Ai[p];
-        Cx[nz++] = x[Ai[p]];
-      }
-    }
-
-    /* indicate end of data */
-    Cp[N] = nz;
-
-    /* update A's structure with C's values; nullify C's pointers */
-    SM_NNZ_S(A) = SM_NNZ_S(C);
-
-    if (SM_DATA_S(A)) { free(SM_DATA_S(A)); }
-    SM_DATA_S(A) = SM_DATA_S(C);
-    SM_DATA_S(C) = NULL;
-
-    if (SM_INDEXVALS_S(A)) { free(SM_INDEXVALS_S(A)); }
-    SM_INDEXVALS_S(A) = SM_INDEXVALS_S(C);
-    SM_INDEXVALS_S(C) = NULL;
-
-    if (SM_INDEXPTRS_S(A)) { free(SM_INDEXPTRS_S(A)); }
-    SM_INDEXPTRS_S(A) = SM_INDEXPTRS_S(C);
-    SM_INDEXPTRS_S(C) = NULL;
+  return SUN_SUCCESS;
+}
 
-    /* clean up */
-    SUNMatDestroy_Sparse(C);
-    free(x);
-  }
+SUNErrCode SUNMatScaleAddI_Sparse(sunrealtype c, SUNMatrix A)
+{
+  SUNFunctionBegin(A->sunctx);
+  SUNCheckCall(scale_add_diagonal(c, ONE, A));
   return SUN_SUCCESS;
 }
 
@@ -895,6 +851,16 @@ SUNErrCode SUNMatScaleAdd_Sparse(sunrealtype c, SUNMatrix A, SUNMatrix B)
   Bx = SM_DATA_S(B);
   SUNAssert(Bx, SUN_ERR_ARG_CORRUPT);
 
+  /* if A and B have the same pattern, add the values in a single pass */
+  if (samePattern(A, B))
+  {
+    for (p = Ap[0]; p < Ap[N]; p++) { Ax[p] = c * Ax[p] + Bx[p]; }
+    return SUN_SUCCESS;
+  }
+
+  /* the pattern of A may change */
+  SM_CONTENT_S(A)->csrvalid = SUNFALSE;
+
   /* create work arrays for row indices and nonzero column values */
   w = (sunindextype*)malloc(M * sizeof(sunindextype));
   SUNAssert(w, SUN_ERR_MALLOC_FAIL);
@@ -1095,7 +1061,11 @@ SUNErrCode SUNMatMatvec_Sparse(SUNMatrix A, N_Vector x, N_Vector y)
   SUNCheck(compatibleMatrixAndVectors(A, x, y), SUN_ERR_ARG_DIMSMISMATCH);
 
   /* Perform operation */
-  if (SM_SPARSETYPE_S(A) == CSC_MAT)
+  if (SM_CONTENT_S(A)->num_threads > 1)
+  {
+    SUNCheckCall(Matvec_SparseThreaded(A, x, y));
+  }
+  else if (SM_SPARSETYPE_S(A) == CSC_MAT)
   {
     SUNCheckCall(Matvec_SparseCSC(A, x, y));
   }
@@ -1164,6 +1134,353 @@ static sunbooleantype compatibleMatrixAndVectors(SUNMatrix A, N_Vector x,
   return SUNTRUE;
 }
 
+/* -----------------------------------------------------------------
+ * Creates the index arrays for the transpose of a sparse pattern with np
+ * compressed dimensions and nt indexed dimensions (i.e., converts the CSC
+ * column pointers and row indices to CSR row pointers and column indices or
+ * vice versa). If tperm is not NULL, it is set to the positions of the
+ * transposed entries in the original arrays. The caller is responsible for
+ * freeing tptrs, tvals, and tperm.
+ */
+
+SUNErrCode transpose_pattern(sunindextype np, sunindextype nt,
+                             const sunindextype* ptrs, const sunindextype* vals,
+                             sunindextype** tptrs, sunindextype** tvals,
+                             sunindextype** tperm)
+{
+  sunindextype i, j, k, nnz;
+  sunindextype* next;
+
+  nnz = ptrs[np];
+
+  *tptrs = (sunindextype*)calloc(nt + 1, sizeof(sunindextype));
+  *tvals = (sunindextype*)malloc(SUNMAX(nnz, 1) * sizeof(sunindextype));
+  next   = (sunindextype*)malloc((nt + 1) * sizeof(sunindextype));
+  if (tperm)
+  {
+    *tperm = (sunindextype*)malloc(SUNMAX(nnz, 1) * sizeof(sunindextype));
+  }
+  if (*tptrs == NULL || *tvals == NULL || next == NULL ||
+      (tperm && *tperm == NULL))
+  {
+    free(*tptrs);
+    free(*tvals);
+    free(next);
+    *tptrs = NULL;
+    *tvals = NULL;
+    if (tperm)
+    {
+      free(*tperm);
+      *tperm = NULL;
+    }
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  /* count the entries in each transposed slice */
+  for (k = 0; k < nnz; k++) { (*tptrs)[vals[k] + 1]++; }
+  for (i = 0; i < nt; i++) { (*tptrs)[i + 1] += (*tptrs)[i]; }
+
+  /* scatter the indices */
+  for (i = 0; i <= nt; i++) { next[i] = (*tptrs)[i]; }
+  for (j = 0; j < np; j++)
+  {
+    for (k = ptrs[j]; k < ptrs[j + 1]; k++)
+    {
+      if (tperm) { (*tperm)[next[vals[k]]] = k; }
+      (*tvals)[next[vals[k]]++] = j;
+    }
+  }
+
+  free(next);
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Function to locate the diagonal entries of a sparse matrix. The
+ * positions are cached in the matrix content and a cached position is
+ * reused while it still holds the diagonal entry of its column (row),
+ * so only the columns (rows) whose pattern changed are searched. On
+ * return nmissing is the number of diagonal entries that are not in
+ * the pattern, and their positions are set to -1.
+ */
+
+SUNErrCode find_diagonal(SUNMatrix A, sunindextype* nmissing)
+{
+  sunindextype j, p, nd, *Ap, *Ai, *diag;
+  SUNFunctionBegin(A->sunctx);
+
+  nd = SUNMIN(SM_ROWS_S(A), SM_COLUMNS_S(A));
+
+  /* allocate the cache on first use */
+  if (SM_CONTENT_S(A)->diag == NULL)
+  {
+    SM_CONTENT_S(A)->diag = (sunindextype*)malloc(nd * sizeof(sunindextype));
+    SUNAssert(SM_CONTENT_S(A)->diag, SUN_ERR_MALLOC_FAIL);
+    for (j = 0; j < nd; j++) { SM_CONTENT_S(A)->diag[j] = -1; }
+  }
+
+  diag = SM_CONTENT_S(A)->diag;
+  Ap   = SM_INDEXPTRS_S(A);
+  Ai   = SM_INDEXVALS_S(A);
+
+  *nmissing = 0;
+  for (j = 0; j < nd; j++)
+  {
+    /* keep the cached position if it still holds the diagonal entry */
+    p = diag[j];
+    if (p >= Ap[j] && p < Ap[j + 1] && Ai[p] == j) { continue; }
+
+    /* otherwise scan the column (row) of A */
+    diag[j] = -1;
+    for (p = Ap[j]; p < Ap[j + 1]; p++)
+    {
+      if (Ai[p] == j)
+      {
+        diag[j] = p;
+        break;
+      }
+    }
+    if (diag[j] < 0) { *nmissing += 1; }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Function to compute A = c*A + d*I, inserting the diagonal entries
+ * that are missing from the sparsity pattern of A
+ */
+
+SUNErrCode scale_add_diagonal(sunrealtype c, sunrealtype d, SUNMatrix A)
+{
+  sunindextype j, p, nz, newvals, M, N, nd, cend, start;
+  sunbooleantype newmat, insert;
+  sunindextype *Ap, *Ai, *Cp, *Ci, *diag;
+  sunrealtype *x, *Ax, *Cx;
+  SUNMatrix C;
+  SUNFunctionBegin(A->sunctx);
+
+  /* store shortcuts to matrix dimensions (M is inner dimension, N is outer) */
+  if (SM_SPARSETYPE_S(A) == CSC_MAT)
+  {
+    M = SM_ROWS_S(A);
+    N = SM_COLUMNS_S(A);
+  }
+  else
+  {
+    M = SM_COLUMNS_S(A);
+    N = SM_ROWS_S(A);
+  }
+
+  /* access data arrays from A */
+  Ap = NULL;
+  Ai = NULL;
+  Ax = NULL;
+  Ap = SM_INDEXPTRS_S(A);
+  SUNAssert(Ap, SUN_ERR_ARG_CORRUPT);
+  Ai = SM_INDEXVALS_S(A);
+  SUNAssert(Ai, SUN_ERR_ARG_CORRUPT);
+  Ax = SM_DATA_S(A);
+  SUNAssert(Ax, SUN_ERR_ARG_CORRUPT);
+
+  /* locate the diagonal entries of A and count those that are missing from
+     its pattern (and so require extra storage) */
+  SUNCheckCall(find_diagonal(A, &newvals));
+  diag = SM_CONTENT_S(A)->diag;
+  nd   = SUNMIN(M, N);
+
+  /* the pattern of A changes if entries are inserted */
+  if (newvals > 0) { SM_CONTENT_S(A)->csrvalid = SUNFALSE; }
+
+  /* If extra nonzeros required, check whether matrix has sufficient storage
+     space for new nonzero entries  (so I can be inserted into existing storage)
+   */
+  newmat = SUNFALSE; /* no reallocation needed */
+  if (newvals > (SM_NNZ_S(A) - Ap[N])) { newmat = SUNTRUE; }
+
+  /* perform operation based on existing/necessary structure */
+
+  /*   case 1: A already contains a diagonal */
+  if (newvals == 0)
+  {
+    /* scale all entries, then update the diagonal at its cached positions */
+    for (p = Ap[0]; p < Ap[N]; p++) { Ax[p] = c * Ax[p]; }
+    for (j = 0; j < nd; j++) { Ax[diag[j]] += d; }
+
+    /*   case 2: A has sufficient storage, but does not already contain a
+     * diagonal */
+  }
+  else if (!newmat)
+  {
+    /* determine storage location where last column (row) should end */
+    nz = Ap[N] + newvals;
+
+    /* store pointer past last column (row) from original A,
+       and store updated value in revised A */
+    cend  = Ap[N];
+    Ap[N] = nz;
+
+    /* iterate through columns (rows) backwards, shifting the entries to
+       their new positions; as the entries only move toward the end of the
+       arrays, no work arrays are needed */
+    for (j = N - 1; j >= 0; j--)
+    {
+      start  = Ap[j];
+      insert = (j < nd) && (diag[j] < 0);
+
+      for (p = cend - 1; p >= start; p--)
+      {
+        /* insert a missing diagonal entry in front of the later entries */
+        if (insert && Ai[p] < j)
+        {
+          Ai[--nz] = j;
+          Ax[nz]   = d;
+          diag[j]  = nz;
+          insert   = SUNFALSE;
+        }
+        Ai[--nz] = Ai[p];
+        Ax[nz]   = c * Ax[p];
+        if (Ai[p] == j && j < nd)
+        {
+          Ax[nz] += d;
+          diag[j] = nz;
+        }
+      }
+      /* insert a missing diagonal entry at the front */
+      if (insert)
+      {
+        Ai[--nz] = j;
+        Ax[nz]   = d;
+        diag[j]  = nz;
+      }
+
+      /* store ptr past this col (row) from orig A, update value for new A */
+      cend  = Ap[j];
+      Ap[j] = nz;
+    }
+
+    /*   case 3: A must be reallocated with sufficient storage */
+  }
+  else
+  {
+    /* create work array for nonzero values in a single column (row) */
+    x = (sunrealtype*)malloc(M * sizeof(sunrealtype));
+
+    /* create new matrix for sum */
+    C = SUNSparseMatrix(SM_ROWS_S(A), SM_COLUMNS_S(A), Ap[N] + newvals,
+                        SM_SPARSETYPE_S(A), A->sunctx);
+    SUNCheckLastErr();
+
+    /* access data from CSR structures (return if failure) */
+    Cp = NULL;
+    Ci = NULL;
+    Cx = NULL;
+    Cp = SM_INDEXPTRS_S(C);
+    SUNAssert(Cp, SUN_ERR_ARG_CORRUPT);
+    Ci = SM_INDEXVALS_S(C);
+    SUNAssert(Ci, SUN_ERR_ARG_CORRUPT);
+    Cx = SM_DATA_S(C);
+    SUNAssert(Cx, SUN_ERR_ARG_CORRUPT);
+
+    /* initialize total nonzero count */
+    nz = 0;
+
+    /* iterate through columns (rows for CSR) */
+    for (j = 0; j < N; j++)
+    {
+      /* set current column (row) pointer to current # nonzeros */
+      Cp[j] = nz;
+
+      /* reset diagonal entry, in case it's not in A */
+      x[j] = ZERO;
+
+      /* iterate down column (along row) of A, collecting nonzeros */
+      for (p = Ap[j]; p < Ap[j + 1]; p++)
+      {
+        x[Ai[p]] = c * Ax[p]; /* collect/scale value */
+      }
+
+      /* add the diagonal to this column (row) */
+      if (j < M) { x[j] += d; /* update value */ }
+
+      /* fill entries of C with this column's (row's) data */
+      /* fill entries before diagonal */
+      for (p = Ap[j]; p < Ap[j + 1] && Ai[p] < j; p++)
+      {
+        Ci[nz]   = Ai[p];
+        Cx[nz++] = x[Ai[p]];
+      }
+      /* fill diagonal if applicable */
+      if (p >= Ap[j + 1] /* empty or insert at end */ ||
+          Ai[p] != j /* insert before end */)
+      {
+        Ci[nz]   = j;
+        Cx[nz++] = x[j];
+      }
+      /* fill entries past diagonal */
+      for (; p < Ap[j + 1]; p++)
+      {
+        Ci[nz]   = Ai[p];
+        Cx[nz++] = x[Ai[p]];
+      }
+    }
+
+    /* indicate end of data */
+    Cp[N] = nz;
+
+    /* update A's structure with C's values; nullify C's pointers */
+    SM_NNZ_S(A) = SM_NNZ_S(C);
+
+    if (SM_DATA_S(A)) { free(SM_DATA_S(A)); }
+    SM_DATA_S(A) = SM_DATA_S(C);
+    SM_DATA_S(C) = NULL;
+
+    if (SM_INDEXVALS_S(A)) { free(SM_INDEXVALS_S(A)); }
+    SM_INDEXVALS_S(A) = SM_INDEXVALS_S(C);
+    SM_INDEXVALS_S(C) = NULL;
+
+    if (SM_INDEXPTRS_S(A)) { free(SM_INDEXPTRS_S(A)); }
+    SM_INDEXPTRS_S(A) = SM_INDEXPTRS_S(C);
+    SM_INDEXPTRS_S(C) = NULL;
+
+    /* clean up */
+    SUNMatDestroy_Sparse(C);
+    free(x);
+
+    /* update the diagonal positions for the new pattern */
+    SUNCheckCall(find_diagonal(A, &newvals));
+  }
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Function to check if two sparse matrices have the same sparsity
+ * pattern
+ */
+
+sunbooleantype samePattern(SUNMatrix A, SUNMatrix B)
+{
+  sunindextype i, np, *Ap, *Ai, *Bp, *Bi;
+
+  np = SM_NP_S(A);
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  Bp = SM_INDEXPTRS_S(B);
+  Bi = SM_INDEXVALS_S(B);
+
+  for (i = 0; i <= np; i++)
+  {
+    if (Ap[i] != Bp[i]) { return SUNFALSE; }
+  }
+  for (i = Ap[0]; i < Ap[np]; i++)
+  {
+    if (Ai[i] != Bi[i]) { return SUNFALSE; }
+  }
+
+  return SUNTRUE;
+}
+
 /* -----------------------------------------------------------------
  * Computes y=A*x, where A is a CSC SUNMatrix_Sparse of dimension MxN, x is a
  * compatible N_Vector object of length N, and y is a compatible
@@ -1249,6 +1566,146 @@ SUNErrCode Matvec_SparseCSR(SUNMatrix A, N_Vector x, N_Vector y)
   return SUN_SUCCESS;
 }
 
+/* -----------------------------------------------------------------
+ * Computes y=A*x with the rows of y divided among the threads. CSR
+ * matrices are used directly while CSC matrices use the CSR view of
+ * their pattern, reading the values through the positions of the
+ * entries in the data array. The columns in each row are in increasing
+ * order, so the result is identical to that of the serial product.
+ */
+SUNErrCode Matvec_SparseThreaded(SUNMatrix A, N_Vector x, N_Vector y)
+{
+  int t, nt;
+  sunindextype *Ap, *Aj, *perm, *part;
+  sunrealtype *Ax, *xd, *yd;
+  SUNFunctionBegin(A->sunctx);
+
+  /* rebuild the CSR view and partition after a change in the pattern */
+  if (!SM_CONTENT_S(A)->csrvalid ||
+      (SM_SPARSETYPE_S(A) == CSC_MAT &&
+       SM_CONTENT_S(A)->csrptrs[SM_ROWS_S(A)] !=
+         SM_INDEXPTRS_S(A)[SM_NP_S(A)]))
+  {
+    SUNCheckCall(update_csr_view(A));
+  }
+
+  if (SM_SPARSETYPE_S(A) == CSC_MAT)
+  {
+    Ap   = SM_CONTENT_S(A)->csrptrs;
+    Aj   = SM_CONTENT_S(A)->csrvals;
+    perm = SM_CONTENT_S(A)->csrperm;
+  }
+  else
+  {
+    Ap   = SM_INDEXPTRS_S(A);
+    Aj   = SM_INDEXVALS_S(A);
+    perm = NULL;
+  }
+  Ax   = SM_DATA_S(A);
+  part = SM_CONTENT_S(A)->rowpart;
+  nt   = SM_CONTENT_S(A)->num_threads;
+  SUNAssert(Ap && Aj && Ax, SUN_ERR_ARG_CORRUPT);
+
+  /* access vector data (return if failure) */
+  xd = N_VGetArrayPointer(x);
+  SUNCheckLastErr();
+  yd = N_VGetArrayPointer(y);
+  SUNCheckLastErr();
+  SUNAssert(xd, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(yd, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(xd != yd, SUN_ERR_ARG_CORRUPT);
+
+  /* each thread computes the rows in one or more parts of the partition */
+#ifdef _OPENMP
+#pragma omp parallel for default(shared) private(t) schedule(static, 1) \
+  num_threads(nt)
+#endif
+  for (t = 0; t < nt; t++)
+  {
+    sunindextype i, k;
+    sunrealtype sum;
+
+    if (perm)
+    {
+      for (i = part[t]; i < part[t + 1]; i++)
+      {
+        sum = ZERO;
+        for (k = Ap[i]; k < Ap[i + 1]; k++) { sum += Ax[perm[k]] * xd[Aj[k]]; }
+        yd[i] = sum;
+      }
+    }
+    else
+    {
+      for (i = part[t]; i < part[t + 1]; i++)
+      {
+        sum = ZERO;
+        for (k = Ap[i]; k < Ap[i + 1]; k++) { sum += Ax[k] * xd[Aj[k]]; }
+        yd[i] = sum;
+      }
+    }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Builds the CSR view of the pattern of a CSC matrix and divides the
+ * rows into num_threads parts with about the same number of nonzeros.
+ */
+SUNErrCode update_csr_view(SUNMatrix A)
+{
+  int t, nt;
+  sunindextype M, lo, hi, mid, nnz, target, *ptrs, *part;
+  SUNMatrixContent_Sparse content;
+  SUNFunctionBegin(A->sunctx);
+
+  content = SM_CONTENT_S(A);
+  M       = SM_ROWS_S(A);
+  nt      = content->num_threads;
+
+  if (SM_SPARSETYPE_S(A) == CSC_MAT)
+  {
+    free(content->csrptrs);
+    free(content->csrvals);
+    free(content->csrperm);
+    content->csrptrs = NULL;
+    content->csrvals = NULL;
+    content->csrperm = NULL;
+    SUNCheckCall(transpose_pattern(SM_COLUMNS_S(A), M, SM_INDEXPTRS_S(A),
+                                   SM_INDEXVALS_S(A), &content->csrptrs,
+                                   &content->csrvals, &content->csrperm));
+    ptrs = content->csrptrs;
+  }
+  else { ptrs = SM_INDEXPTRS_S(A); }
+
+  part = (sunindextype*)realloc(content->rowpart,
+                                (nt + 1) * sizeof(sunindextype));
+  SUNAssert(part, SUN_ERR_MALLOC_FAIL);
+  content->rowpart = part;
+
+  /* part t starts at the first row with at least t*nnz/nt nonzeros before it */
+  nnz     = ptrs[M];
+  part[0] = 0;
+  for (t = 1; t < nt; t++)
+  {
+    target = (sunindextype)(((double)nnz * t) / nt);
+    lo     = part[t - 1];
+    hi     = M;
+    while (lo < hi)
+    {
+      mid = lo + (hi - lo) / 2;
+      if (ptrs[mid] < target) { lo = mid + 1; }
+      else { hi = mid; }
+    }
+    part[t] = lo;
+  }
+  part[nt] = M;
+
+  content->csrvalid = SUNTRUE;
+
+  return SUN_SUCCESS;
+}
+
 /* -----------------------------------------------------------------
  * Copies A into a matrix B in the opposite format of A.
  * Returns 0 if successful, nonzero if unsuccessful.
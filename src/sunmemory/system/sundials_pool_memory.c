@@ -0,0 +1,452 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * SUNDIALS memory helper implementation that keeps deallocated
+ * host memory in size class free lists for reuse.
+ * ----------------------------------------------------------------*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_memory.h>
+#include <sunmemory/sunmemory_pool.h>
+
+#include "sundials_debug.h"
+#include "sundials_macros.h"
+
+/* Size classes: the smallest class holds POOL_MIN_BYTES, above that every
+   power of two is split in POOL_CLASS_STEPS classes, so a block is at most
+   1/POOL_CLASS_STEPS larger than requested. */
+#define POOL_MIN_SHIFT   6
+#define POOL_MIN_BYTES   ((size_t)1 << POOL_MIN_SHIFT)
+#define POOL_CLASS_STEPS 4
+#define POOL_NUM_CLASSES \
+  (1 + POOL_CLASS_STEPS * (8 * (int)sizeof(size_t) - POOL_MIN_SHIFT))
+
+/* Blocks are at least aligned for the pointer stored in front of them */
+#define POOL_MIN_ALIGNMENT (2 * sizeof(void*))
+
+/* The content is shared by a helper and its clones */
+struct SUNMemoryHelper_Content_Pool_
+{
+  int refcount;                /* number of helpers sharing the pool */
+  SUNMemoryHelper upstream;    /* helper for other memory types      */
+  size_t alignment;            /* alignment of the host blocks       */
+  size_t max_cached;           /* largest number of idle bytes kept  */
+  size_t bytes_cached;         /* idle bytes in the free lists       */
+  void* free_blocks[POOL_NUM_CLASSES]; /* idle blocks of each class  */
+  SUNMemory free_mems;         /* idle SUNMemory descriptors         */
+  unsigned long num_allocations;
+  unsigned long num_deallocations;
+  unsigned long num_hits;
+  unsigned long num_misses;
+  size_t bytes_allocated;
+  size_t bytes_high_watermark;
+};
+
+typedef struct SUNMemoryHelper_Content_Pool_ SUNMemoryHelper_Content_Pool;
+
+#define SUNHELPER_CONTENT(h) ((SUNMemoryHelper_Content_Pool*)h->content)
+
+/* Idle blocks and descriptors are linked through their first pointer */
+#define POOL_NEXT(block) (*((void**)(block)))
+
+/* -----------------------------------------------------------------
+ * Private functions
+ * ----------------------------------------------------------------*/
+
+/* Returns the size class of a request and the size of its blocks */
+static int poolSizeClass(size_t bytes, size_t* class_bytes)
+{
+  int shift;
+  size_t base, step, n;
+
+  if (bytes <= POOL_MIN_BYTES)
+  {
+    *class_bytes = POOL_MIN_BYTES;
+    return 0;
+  }
+
+  /* base is the largest power of two below bytes */
+  shift = POOL_MIN_SHIFT;
+  while ((bytes - 1) >> (shift + 1)) { shift++; }
+  base = (size_t)1 << shift;
+  step = base / POOL_CLASS_STEPS;
+  n    = (bytes - base + step - 1) / step;
+
+  *class_bytes = base + n * step;
+  return 1 + POOL_CLASS_STEPS * (shift - POOL_MIN_SHIFT) + (int)n - 1;
+}
+
+/* Allocates a block with the raw allocation stored in front of it, the
+   alignment is a power of two of at least POOL_MIN_ALIGNMENT */
+static void* poolNewBlock(size_t class_bytes, size_t alignment)
+{
+  char* raw;
+  uintptr_t ptr;
+
+  raw = (char*)malloc(class_bytes + sizeof(void*) + alignment - 1);
+  if (raw == NULL) { return NULL; }
+
+  ptr = ((uintptr_t)(raw + sizeof(void*)) + alignment - 1) &
+        ~((uintptr_t)alignment - 1);
+  ((void**)ptr)[-1] = (void*)raw;
+
+  return (void*)ptr;
+}
+
+static void poolFreeBlock(void* block) { free(((void**)block)[-1]); }
+
+/* Frees the idle blocks */
+static void poolReleaseBlocks(SUNMemoryHelper_Content_Pool* content)
+{
+  int i;
+
+  for (i = 0; i < POOL_NUM_CLASSES; i++)
+  {
+    while (content->free_blocks[i])
+    {
+      void* block              = content->free_blocks[i];
+      content->free_blocks[i] = POOL_NEXT(block);
+      poolFreeBlock(block);
+    }
+  }
+  content->bytes_cached = 0;
+}
+
+/* Frees the idle descriptors */
+static void poolReleaseMems(SUNMemoryHelper_Content_Pool* content)
+{
+  while (content->free_mems)
+  {
+    SUNMemory mem      = content->free_mems;
+    content->free_mems = (SUNMemory)POOL_NEXT(mem);
+    free(mem);
+  }
+}
+
+static sunbooleantype poolIsPool(SUNMemoryHelper helper)
+{
+  return (helper->ops->alloc == SUNMemoryHelper_Alloc_Pool) ? SUNTRUE
+                                                             : SUNFALSE;
+}
+
+/* -----------------------------------------------------------------
+ * Implementation specific functions
+ * ----------------------------------------------------------------*/
+
+SUNMemoryHelper SUNMemoryHelper_Pool(SUNMemoryHelper upstream,
+                                     SUNContext sunctx)
+{
+  SUNFunctionBegin(sunctx);
+
+  SUNMemoryHelper helper;
+  SUNMemoryHelper_Content_Pool* content;
+  int i;
+
+  /* Allocate the helper */
+  helper = SUNMemoryHelper_NewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Set the ops */
+  helper->ops->alloc         = SUNMemoryHelper_Alloc_Pool;
+  helper->ops->dealloc       = SUNMemoryHelper_Dealloc_Pool;
+  helper->ops->copy          = SUNMemoryHelper_Copy_Pool;
+  helper->ops->copyasync     = SUNMemoryHelper_CopyAsync_Pool;
+  helper->ops->getallocstats = SUNMemoryHelper_GetAllocStats_Pool;
+  helper->ops->clone         = SUNMemoryHelper_Clone_Pool;
+  helper->ops->destroy       = SUNMemoryHelper_Destroy_Pool;
+
+  /* Attach content */
+  content = (SUNMemoryHelper_Content_Pool*)malloc(
+    sizeof(SUNMemoryHelper_Content_Pool));
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+  helper->content = content;
+
+  content->refcount     = 1;
+  content->upstream     = upstream;
+  content->alignment    = SUNMEMORY_POOL_DEFAULT_ALIGNMENT;
+  content->max_cached   = (size_t)-1;
+  content->bytes_cached = 0;
+  for (i = 0; i < POOL_NUM_CLASSES; i++) { content->free_blocks[i] = NULL; }
+  content->free_mems            = NULL;
+  content->num_allocations      = 0;
+  content->num_deallocations    = 0;
+  content->num_hits             = 0;
+  content->num_misses           = 0;
+  content->bytes_allocated      = 0;
+  content->bytes_high_watermark = 0;
+
+  return helper;
+}
+
+SUNErrCode SUNMemoryHelper_SetAlignment_Pool(SUNMemoryHelper helper,
+                                             size_t alignment)
+{
+  if (!poolIsPool(helper)) { return SUN_ERR_ARG_WRONGTYPE; }
+  if (alignment & (alignment - 1)) { return SUN_ERR_ARG_OUTOFRANGE; }
+  alignment = SUNMAX(alignment, POOL_MIN_ALIGNMENT);
+
+  /* Idle blocks may not have the new alignment */
+  if (alignment != SUNHELPER_CONTENT(helper)->alignment)
+  {
+    poolReleaseBlocks(SUNHELPER_CONTENT(helper));
+  }
+  SUNHELPER_CONTENT(helper)->alignment = alignment;
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMemoryHelper_SetMaxCachedBytes_Pool(SUNMemoryHelper helper,
+                                                  size_t max_cached)
+{
+  if (!poolIsPool(helper)) { return SUN_ERR_ARG_WRONGTYPE; }
+
+  SUNHELPER_CONTENT(helper)->max_cached = max_cached;
+  if (SUNHELPER_CONTENT(helper)->bytes_cached > max_cached)
+  {
+    poolReleaseBlocks(SUNHELPER_CONTENT(helper));
+  }
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMemoryHelper_Release_Pool(SUNMemoryHelper helper)
+{
+  if (!poolIsPool(helper)) { return SUN_ERR_ARG_WRONGTYPE; }
+
+  poolReleaseBlocks(SUNHELPER_CONTENT(helper));
+  poolReleaseMems(SUNHELPER_CONTENT(helper));
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMemoryHelper_GetPoolStats_Pool(SUNMemoryHelper helper,
+                                             unsigned long* num_hits,
+                                             unsigned long* num_misses,
+                                             size_t* bytes_cached)
+{
+  if (!poolIsPool(helper)) { return SUN_ERR_ARG_WRONGTYPE; }
+
+  *num_hits     = SUNHELPER_CONTENT(helper)->num_hits;
+  *num_misses   = SUNHELPER_CONTENT(helper)->num_misses;
+  *bytes_cached = SUNHELPER_CONTENT(helper)->bytes_cached;
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * SUNMemoryHelper functions
+ * ----------------------------------------------------------------*/
+
+SUNErrCode SUNMemoryHelper_Alloc_Pool(SUNMemoryHelper helper, SUNMemory* memptr,
+                                      size_t mem_size, SUNMemoryType mem_type,
+                                      void* queue)
+{
+  SUNFunctionBegin(helper->sunctx);
+
+  SUNMemoryHelper_Content_Pool* content = SUNHELPER_CONTENT(helper);
+  SUNMemory mem;
+  size_t class_bytes;
+  int size_class;
+
+  if (mem_type != SUNMEMTYPE_HOST)
+  {
+    if (!content->upstream) { return SUN_ERR_ARG_INCOMPATIBLE; }
+    return SUNMemoryHelper_Alloc(content->upstream, memptr, mem_size, mem_type,
+                                 queue);
+  }
+
+  /* Reuse a descriptor if possible */
+  if (content->free_mems)
+  {
+    mem                = content->free_mems;
+    content->free_mems = (SUNMemory)POOL_NEXT(mem);
+  }
+  else
+  {
+    mem = SUNMemoryNewEmpty(helper->sunctx);
+    SUNCheckLastErr();
+  }
+
+  mem->own   = SUNTRUE;
+  mem->type  = mem_type;
+  mem->bytes = mem_size;
+
+  /* Reuse a block of the same class if possible */
+  size_class = poolSizeClass(mem_size, &class_bytes);
+  if (content->free_blocks[size_class])
+  {
+    mem->ptr                         = content->free_blocks[size_class];
+    content->free_blocks[size_class] = POOL_NEXT(mem->ptr);
+    content->bytes_cached -= class_bytes;
+    content->num_hits++;
+  }
+  else
+  {
+    mem->ptr = poolNewBlock(class_bytes, content->alignment);
+    if (mem->ptr == NULL && content->bytes_cached > 0)
+    {
+      /* Return the idle blocks to the system and try again */
+      poolReleaseBlocks(content);
+      mem->ptr = poolNewBlock(class_bytes, content->alignment);
+    }
+    if (mem->ptr == NULL)
+    {
+      free(mem);
+      *memptr = NULL;
+      return SUN_ERR_MALLOC_FAIL;
+    }
+    content->num_misses++;
+  }
+
+  content->bytes_allocated += mem_size;
+  content->num_allocations++;
+  content->bytes_high_watermark = SUNMAX(content->bytes_allocated,
+                                         content->bytes_high_watermark);
+
+  *memptr = mem;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMemoryHelper_Dealloc_Pool(SUNMemoryHelper helper, SUNMemory mem,
+                                        void* queue)
+{
+  SUNMemoryHelper_Content_Pool* content = SUNHELPER_CONTENT(helper);
+  size_t class_bytes;
+  int size_class;
+
+  if (mem == NULL) { return SUN_SUCCESS; }
+
+  if (mem->type != SUNMEMTYPE_HOST)
+  {
+    if (!content->upstream) { return SUN_ERR_ARG_INCOMPATIBLE; }
+    return SUNMemoryHelper_Dealloc(content->upstream, mem, queue);
+  }
+
+  if (mem->ptr != NULL && mem->own)
+  {
+    content->num_deallocations++;
+    content->bytes_allocated -= mem->bytes;
+
+    size_class = poolSizeClass(mem->bytes, &class_bytes);
+    /* Blocks allocated before an alignment change are not kept */
+    if (content->bytes_cached + class_bytes <= content->max_cached &&
+        ((uintptr_t)mem->ptr & (content->alignment - 1)) == 0)
+    {
+      POOL_NEXT(mem->ptr)              = content->free_blocks[size_class];
+      content->free_blocks[size_class] = mem->ptr;
+      content->bytes_cached += class_bytes;
+    }
+    else { poolFreeBlock(mem->ptr); }
+    mem->ptr = NULL;
+  }
+
+  /* Keep the descriptor for the next allocation */
+  POOL_NEXT(mem)     = (void*)content->free_mems;
+  content->free_mems = mem;
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNMemoryHelper_Copy_Pool(SUNMemoryHelper helper, SUNMemory dst,
+                                     SUNMemory src, size_t memory_size,
+                                     void* queue)
+{
+  if (src->type == SUNMEMTYPE_HOST && dst->type == SUNMEMTYPE_HOST)
+  {
+    memcpy(dst->ptr, src->ptr, memory_size);
+    return SUN_SUCCESS;
+  }
+
+  if (!SUNHELPER_CONTENT(helper)->upstream) { return SUN_ERR_ARG_INCOMPATIBLE; }
+  return SUNMemoryHelper_Copy(SUNHELPER_CONTENT(helper)->upstream, dst, src,
+                              memory_size, queue);
+}
+
+SUNErrCode SUNMemoryHelper_CopyAsync_Pool(SUNMemoryHelper helper, SUNMemory dst,
+                                          SUNMemory src, size_t memory_size,
+                                          void* queue)
+{
+  if (src->type == SUNMEMTYPE_HOST && dst->type == SUNMEMTYPE_HOST)
+  {
+    memcpy(dst->ptr, src->ptr, memory_size);
+    return SUN_SUCCESS;
+  }
+
+  if (!SUNHELPER_CONTENT(helper)->upstream) { return SUN_ERR_ARG_INCOMPATIBLE; }
+  return SUNMemoryHelper_CopyAsync(SUNHELPER_CONTENT(helper)->upstream, dst,
+                                   src, memory_size, queue);
+}
+
+SUNErrCode SUNMemoryHelper_GetAllocStats_Pool(SUNMemoryHelper helper,
+                                              SUNMemoryType mem_type,
+                                              unsigned long* num_allocations,
+                                              unsigned long* num_deallocations,
+                                              size_t* bytes_allocated,
+                                              size_t* bytes_high_watermark)
+{
+  SUNMemoryHelper_Content_Pool* content = SUNHELPER_CONTENT(helper);
+
+  if (mem_type != SUNMEMTYPE_HOST)
+  {
+    if (!content->upstream) { return SUN_ERR_ARG_INCOMPATIBLE; }
+    return SUNMemoryHelper_GetAllocStats(content->upstream, mem_type,
+                                         num_allocations, num_deallocations,
+                                         bytes_allocated, bytes_high_watermark);
+  }
+
+  *num_allocations      = content->num_allocations;
+  *num_deallocations    = content->num_deallocations;
+  *bytes_allocated      = content->bytes_allocated;
+  *bytes_high_watermark = content->bytes_high_watermark;
+  return SUN_SUCCESS;
+}
+
+/* A clone shares the pool, so memory allocated through one helper may be
+   deallocated through the other and recycled by both. */
+SUNMemoryHelper SUNMemoryHelper_Clone_Pool(SUNMemoryHelper helper)
+{
+  SUNFunctionBegin(helper->sunctx);
+
+  SUNMemoryHelper hclone = SUNMemoryHelper_NewEmpty(helper->sunctx);
+  SUNCheckLastErrNull();
+
+  SUNMemoryHelper_CopyOps(helper, hclone);
+  hclone->content = helper->content;
+  SUNHELPER_CONTENT(helper)->refcount++;
+
+  return hclone;
+}
+
+SUNErrCode SUNMemoryHelper_Destroy_Pool(SUNMemoryHelper helper)
+{
+  SUNMemoryHelper_Content_Pool* content;
+
+  if (helper == NULL) { return SUN_SUCCESS; }
+
+  content = SUNHELPER_CONTENT(helper);
+  if (content && --content->refcount == 0)
+  {
+    poolReleaseBlocks(content);
+    poolReleaseMems(content);
+    free(content);
+  }
+
+  if (helper->ops) { free(helper->ops); }
+  free(helper);
+
+  return SUN_SUCCESS;
+}
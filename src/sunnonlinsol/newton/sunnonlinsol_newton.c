@@ -33,6 +33,12 @@
 /* Constant macros */
 #define ZERO SUN_RCONST(0.0) /* real 0.0 */
 #define ONE  SUN_RCONST(1.0) /* real 1.0 */
+#define TWO  SUN_RCONST(2.0) /* real 2.0 */
+#define PT1  SUN_RCONST(0.1) /* real 0.1 */
+
+/* Private function prototypes */
+static SUNErrCode newton_ForcingTerm(SUNNonlinearSolver NLS, N_Vector F,
+                                     N_Vector w);
 
 /*==============================================================================
   Constructor to create a new Newton solver
@@ -66,6 +72,7 @@ SUNNonlinearSolver SUNNonlinSol_Newton(N_Vector y, SUNContext sunctx)
   NLS->ops->getnumiters     = SUNNonlinSolGetNumIters_Newton;
   NLS->ops->getcuriter      = SUNNonlinSolGetCurIter_Newton;
   NLS->ops->getnumconvfails = SUNNonlinSolGetNumConvFails_Newton;
+  NLS->ops->getforcingterm  = SUNNonlinSolGetForcingTerm_Newton;
 
   /* Create content */
   content = NULL;
@@ -89,6 +96,12 @@ SUNNonlinearSolver SUNNonlinSol_Newton(N_Vector y, SUNContext sunctx)
   content->niters     = 0;
   content->nconvfails = 0;
   content->ctest_data = NULL;
+  content->forcing    = SUNFALSE;
+  content->eta        = ZERO;
+  content->eta_init   = ZERO;
+  content->eta_gamma  = SUNNEWTON_ETA_GAMMA;
+  content->eta_alpha  = SUNNEWTON_ETA_ALPHA;
+  content->fnorm      = ZERO;
 
   /* Fill allocatable content */
   content->delta = N_VClone(y);
@@ -188,6 +201,7 @@ int SUNNonlinSolSolve_Newton(SUNNonlinearSolver NLS,
   SUNAssert(NEWTON_CONTENT(NLS)->Sys && NEWTON_CONTENT(NLS)->CTest &&
               NEWTON_CONTENT(NLS)->LSolve,
             SUN_ERR_ARG_CORRUPT);
+  SUNAssert(!NEWTON_CONTENT(NLS)->forcing || w, SUN_ERR_ARG_CORRUPT);
   SUNAssert(!callLSetup || (callLSetup && NEWTON_CONTENT(NLS)->LSetup),
             SUN_ERR_ARG_CORRUPT);
 
@@ -239,6 +253,12 @@ int SUNNonlinSolSolve_Newton(SUNNonlinearSolver NLS,
       /* increment nonlinear solver iteration counter */
       NEWTON_CONTENT(NLS)->niters++;
 
+      /* if enabled, update the forcing term for the linear solve */
+      if (NEWTON_CONTENT(NLS)->forcing)
+      {
+        SUNCheckCall(newton_ForcingTerm(NLS, delta, w));
+      }
+
       /* compute the negative of the residual for the linear system rhs */
       N_VScale(-ONE, delta, delta);
       SUNCheckLastErr();
@@ -275,6 +295,7 @@ int SUNNonlinSolSolve_Newton(SUNNonlinearSolver NLS,
                            NEWTON_CONTENT(NLS)->niters);
 #endif
         NEWTON_CONTENT(NLS)->jcur = SUNFALSE;
+        NEWTON_CONTENT(NLS)->eta  = ZERO;
         return SUN_SUCCESS;
       }
 
@@ -331,10 +352,58 @@ int SUNNonlinSolSolve_Newton(SUNNonlinearSolver NLS,
   /* increment number of convergence failures */
   NEWTON_CONTENT(NLS)->nconvfails++;
 
+  /* the forcing term only applies within a solve */
+  NEWTON_CONTENT(NLS)->eta = ZERO;
+
   /* all error returns exit here */
   return (retval);
 }
 
+/*------------------------------------------------------------------------------
+  newton_ForcingTerm: Computes the Eisenstat-Walker forcing term for the linear
+  solve in the current iteration from the nonlinear residual F. The first
+  iteration of a solve attempt uses eta_init, which is zero by default so that
+  the client's own linear solver tolerance applies while no convergence rate
+  is available. Subsequent iterations use choice 2 of Eisenstat and Walker,
+
+    eta_k = gamma (||F_k|| / ||F_{k-1}||)^alpha,
+
+  safeguarded against decreasing too quickly and limited to
+  [SUNNEWTON_ETA_MIN, SUNNEWTON_ETA_MAX] as in KINSOL.
+  ----------------------------------------------------------------------------*/
+static SUNErrCode newton_ForcingTerm(SUNNonlinearSolver NLS, N_Vector F,
+                                     N_Vector w)
+{
+  SUNFunctionBegin(NLS->sunctx);
+  sunrealtype fnormp, eta_safe;
+  SUNNonlinearSolverContent_Newton content = NEWTON_CONTENT(NLS);
+
+  fnormp = N_VWrmsNorm(F, w);
+  SUNCheckLastErr();
+
+  if (content->curiter == 0 || content->fnorm <= ZERO)
+  {
+    content->eta = content->eta_init;
+  }
+  else
+  {
+    eta_safe = content->eta_gamma *
+               SUNRpowerR(content->eta, content->eta_alpha);
+    content->eta = content->eta_gamma *
+                   SUNRpowerR(fnormp / content->fnorm, content->eta_alpha);
+
+    /* apply safeguards */
+    if (eta_safe < PT1) { eta_safe = ZERO; }
+    content->eta = SUNMAX(content->eta, eta_safe);
+    content->eta = SUNMAX(content->eta, SUNNEWTON_ETA_MIN);
+    content->eta = SUNMIN(content->eta, SUNNEWTON_ETA_MAX);
+  }
+
+  content->fnorm = fnormp;
+
+  return SUN_SUCCESS;
+}
+
 SUNErrCode SUNNonlinSolFree_Newton(SUNNonlinearSolver NLS)
 {
   /* return if NLS is already free */
@@ -420,6 +489,37 @@ SUNErrCode SUNNonlinSolSetMaxIters_Newton(SUNNonlinearSolver NLS, int maxiters)
   return SUN_SUCCESS;
 }
 
+SUNErrCode SUNNonlinSolSetForcingTerm_Newton(SUNNonlinearSolver NLS,
+                                             sunbooleantype onoff)
+{
+  NEWTON_CONTENT(NLS)->forcing = onoff;
+  NEWTON_CONTENT(NLS)->eta     = ZERO;
+  NEWTON_CONTENT(NLS)->fnorm   = ZERO;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNNonlinSolSetForcingParams_Newton(SUNNonlinearSolver NLS,
+                                               sunrealtype eta_init,
+                                               sunrealtype gamma,
+                                               sunrealtype alpha)
+{
+  SUNFunctionBegin(NLS->sunctx);
+  SUNAssert(eta_init >= ZERO && eta_init <= SUNNEWTON_ETA_MAX,
+            SUN_ERR_ARG_OUTOFRANGE);
+  SUNAssert(gamma >= ZERO && gamma <= ONE, SUN_ERR_ARG_OUTOFRANGE);
+  SUNAssert(alpha == ZERO || (alpha > ONE && alpha <= TWO),
+            SUN_ERR_ARG_OUTOFRANGE);
+
+  /* a value of zero restores the default */
+  if (gamma == ZERO) { gamma = SUNNEWTON_ETA_GAMMA; }
+  if (alpha == ZERO) { alpha = SUNNEWTON_ETA_ALPHA; }
+
+  NEWTON_CONTENT(NLS)->eta_init  = eta_init;
+  NEWTON_CONTENT(NLS)->eta_gamma = gamma;
+  NEWTON_CONTENT(NLS)->eta_alpha = alpha;
+  return SUN_SUCCESS;
+}
+
 /*==============================================================================
   Get functions
   ============================================================================*/
@@ -446,6 +546,14 @@ SUNErrCode SUNNonlinSolGetNumConvFails_Newton(SUNNonlinearSolver NLS,
   return SUN_SUCCESS;
 }
 
+SUNErrCode SUNNonlinSolGetForcingTerm_Newton(SUNNonlinearSolver NLS,
+                                             sunrealtype* eta)
+{
+  /* return the forcing term for the current linear solve (zero if disabled) */
+  *eta = NEWTON_CONTENT(NLS)->forcing ? NEWTON_CONTENT(NLS)->eta : ZERO;
+  return SUN_SUCCESS;
+}
+
 SUNErrCode SUNNonlinSolGetSysFn_Newton(SUNNonlinearSolver NLS,
                                        SUNNonlinSolSysFn* SysFn)
 {
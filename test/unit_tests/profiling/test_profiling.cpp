@@ -12,6 +12,7 @@
  * SUNDIALS Copyright End
  * ---------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <iostream>
@@ -19,6 +20,7 @@
 #include <string>
 #include <thread>
 
+#include "sundials/sundials_errors.h"
 #include "sundials/sundials_math.h"
 #include "sundials/sundials_profiler.h"
 #include "sundials/sundials_types.h"
@@ -43,6 +45,28 @@ static int sleep(SUNProfiler prof, int sec, double* chrono)
   return 0;
 }
 
+static int nested(SUNProfiler prof, int outer, int inner, double* chrono)
+{
+  auto begin = std::chrono::steady_clock::now();
+
+  int flag = SUNProfiler_BeginTimer(prof, outer);
+  for (int i = 0; i < 2; i++)
+  {
+    flag += SUNProfiler_BeginTimer(prof, inner);
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    flag += SUNProfiler_EndTimer(prof, inner);
+  }
+  flag += SUNProfiler_EndTimer(prof, outer);
+
+  auto end = std::chrono::steady_clock::now();
+
+  auto elapsed =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+  *chrono = std::chrono::duration<double>(elapsed).count() * 1e-9;
+
+  return flag;
+}
+
 static int print_timings(SUNProfiler prof)
 {
   // Output timing in default (table) format
@@ -223,6 +247,135 @@ int main()
 
   std::fclose(fout);
 
+  // ------
+  // Test 4
+  // ------
+
+  std::cout << "\nTest 4: nested timers with handles, print timings\n";
+
+  flag = SUNProfiler_Reset(prof);
+  if (flag)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "SUNProfiler_Reset returned " << flag << "\n";
+    return 1;
+  }
+
+  int outer = -1;
+  int inner = -1;
+  flag      = SUNProfiler_RegisterTimer(prof, "outer", &outer);
+  flag += SUNProfiler_RegisterTimer(prof, "inner", &inner);
+  if (flag || outer < 0 || inner < 0 || outer == inner)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "SUNProfiler_RegisterTimer returned " << flag << "\n";
+    return 1;
+  }
+
+  // Registering a name again must return the same handle
+  int again = -1;
+  flag      = SUNProfiler_RegisterTimer(prof, "outer", &again);
+  if (flag || again != outer)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "SUNProfiler_RegisterTimer returned a new handle\n";
+    return 1;
+  }
+
+  flag = nested(prof, outer, inner, &chrono);
+  if (flag)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "nested returned " << flag << "\n";
+    return 1;
+  }
+
+  flag = print_timings(prof);
+  if (flag)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "print_timings returned " << flag << "\n";
+    return 1;
+  }
+
+  flag = SUNProfiler_GetElapsedTime(prof, "outer", &time);
+  if (flag)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "SUNProfiler_GetElapsedTime returned " << flag << "\n";
+    return 1;
+  }
+
+  if (SUNRCompareTol(time, chrono, 1e-2))
+  {
+    std::cerr << ">>> FAILURE: "
+              << "time recorded was " << time << "s, but expected " << chrono
+              << "s +/- " << 1e-2 << "\n";
+    return 1;
+  }
+
+  // Ending a timer that is not running must fail
+  flag = SUNProfiler_EndTimer(prof, inner);
+  if (flag == SUN_SUCCESS)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "SUNProfiler_EndTimer succeeded on a stopped timer\n";
+    return 1;
+  }
+
+  // ------
+  // Test 5
+  // ------
+
+  std::cout << "\nTest 5: nested timers on two threads, print timings\n";
+
+  flag = SUNProfiler_Reset(prof);
+  if (flag)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "SUNProfiler_Reset returned " << flag << "\n";
+    return 1;
+  }
+
+  // Each thread keeps its own stack, so the regions may overlap in time
+  double chrono_thread = 0;
+  int flag_thread      = 0;
+  std::thread worker(
+    [&]() { flag_thread = nested(prof, outer, inner, &chrono_thread); });
+  flag = nested(prof, outer, inner, &chrono);
+  worker.join();
+  if (flag || flag_thread)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "nested returned " << flag << " and " << flag_thread << "\n";
+    return 1;
+  }
+
+  flag = print_timings(prof);
+  if (flag)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "print_timings returned " << flag << "\n";
+    return 1;
+  }
+
+  flag = SUNProfiler_GetElapsedTime(prof, "outer", &time);
+  if (flag)
+  {
+    std::cerr << ">>> FAILURE: "
+              << "SUNProfiler_GetElapsedTime returned " << flag << "\n";
+    return 1;
+  }
+
+  // The time of a timer used on several threads is the largest one
+  if (SUNRCompareTol(time, std::max(chrono, chrono_thread), 1e-2))
+  {
+    std::cerr << ">>> FAILURE: "
+              << "time recorded was " << time << "s, but expected "
+              << std::max(chrono, chrono_thread) << "s +/- " << 1e-2 << "\n";
+    return 1;
+  }
+
   // --------
   // Clean up
   // --------
@@ -0,0 +1,203 @@
+/*------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *-----------------------------------------------------------------*/
+
+#include <cstdint>
+#include <iostream>
+#include <sundials/sundials_core.hpp>
+#include <sunmemory/sunmemory_pool.h>
+#include <sunmemory/sunmemory_system.h>
+
+static int check(bool passed, const char* msg)
+{
+  if (!passed) { std::cout << "    " << msg << "\n"; }
+  return passed ? 0 : 1;
+}
+
+// Allocates, copies, and deallocates two buffers and checks the alloc stats
+static int test_instance(SUNMemoryHelper helper)
+{
+  int N                 = 8;
+  size_t bytes_to_alloc = N * sizeof(sunrealtype);
+  SUNMemory some_memory = nullptr, other_memory = nullptr;
+  int fails             = 0;
+
+  unsigned long num_allocations0, num_deallocations0;
+  size_t bytes_allocated0, bytes_high_watermark0;
+  SUNMemoryHelper_GetAllocStats(helper, SUNMEMTYPE_HOST, &num_allocations0,
+                                &num_deallocations0, &bytes_allocated0,
+                                &bytes_high_watermark0);
+
+  if (SUNMemoryHelper_Alloc(helper, &some_memory, bytes_to_alloc,
+                            SUNMEMTYPE_HOST, nullptr) ||
+      SUNMemoryHelper_Alloc(helper, &other_memory, bytes_to_alloc,
+                            SUNMEMTYPE_HOST, nullptr))
+  {
+    std::cout << "    SUNMemoryHelper_Alloc failed\n";
+    return 1;
+  }
+
+  sunrealtype* some_arr = static_cast<sunrealtype*>(some_memory->ptr);
+  for (int i = 0; i < N; i++) { some_arr[i] = i * sunrealtype{1.0}; }
+
+  fails += check(!SUNMemoryHelper_Copy(helper, other_memory, some_memory,
+                                       bytes_to_alloc, nullptr),
+                 "SUNMemoryHelper_Copy failed");
+  sunrealtype* other_arr = static_cast<sunrealtype*>(other_memory->ptr);
+  for (int i = 0; i < N; i++)
+  {
+    if (other_arr[i] != some_arr[i])
+    {
+      fails += check(false, "copied values differ");
+      break;
+    }
+  }
+
+  fails += check(!SUNMemoryHelper_Dealloc(helper, some_memory, nullptr) &&
+                   !SUNMemoryHelper_Dealloc(helper, other_memory, nullptr),
+                 "SUNMemoryHelper_Dealloc failed");
+
+  unsigned long num_allocations, num_deallocations;
+  size_t bytes_allocated, bytes_high_watermark;
+  SUNMemoryHelper_GetAllocStats(helper, SUNMEMTYPE_HOST, &num_allocations,
+                                &num_deallocations, &bytes_allocated,
+                                &bytes_high_watermark);
+  fails += check(num_allocations - num_allocations0 == 2,
+                 "num_allocations did not increase by 2");
+  fails += check(num_deallocations - num_deallocations0 == 2,
+                 "num_deallocations did not increase by 2");
+  fails += check(bytes_allocated == bytes_allocated0,
+                 "bytes_allocated changed");
+  fails += check(bytes_high_watermark >= bytes_to_alloc * 2,
+                 "bytes_high_watermark too small");
+
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  sundials::Context sunctx;
+  int fails = 0;
+
+  std::cout << "Testing the SUNMemoryHelper_Pool module... \n";
+
+  SUNMemoryHelper upstream = SUNMemoryHelper_Sys(sunctx);
+  SUNMemoryHelper helper   = SUNMemoryHelper_Pool(upstream, sunctx);
+  if (!helper)
+  {
+    std::cout << "  SUNMemoryHelper_Pool... FAILED\n";
+    return -1;
+  }
+  std::cout << "  SUNMemoryHelper_Pool... PASSED\n";
+
+  // Basic operations
+  fails += test_instance(helper);
+  std::cout << "  SUNMemoryHelper operations... "
+            << (fails ? "FAILED" : "PASSED") << "\n";
+
+  // The first pass misses and the buffers are recycled by the second
+  unsigned long hits, misses;
+  size_t cached;
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &hits, &misses, &cached);
+  int pool_fails = check(hits == 0 && misses == 2, "expected 0 hits 2 misses");
+  pool_fails += check(cached > 0, "no bytes cached after dealloc");
+
+  pool_fails += test_instance(helper);
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &hits, &misses, &cached);
+  pool_fails += check(hits == 2 && misses == 2, "expected 2 hits 2 misses");
+
+  // Sizes in the same class share blocks, others do not
+  SUNMemory a = nullptr, b = nullptr;
+  SUNMemoryHelper_Alloc(helper, &a, 1000, SUNMEMTYPE_HOST, nullptr);
+  void* a_ptr = a->ptr;
+  SUNMemoryHelper_Dealloc(helper, a, nullptr);
+  SUNMemoryHelper_Alloc(helper, &b, 1020, SUNMEMTYPE_HOST, nullptr);
+  pool_fails += check(b->ptr == a_ptr, "block not reused within its class");
+  SUNMemoryHelper_Dealloc(helper, b, nullptr);
+  SUNMemoryHelper_Alloc(helper, &b, 2000, SUNMEMTYPE_HOST, nullptr);
+  pool_fails += check(b->ptr != a_ptr, "block reused for a larger class");
+  SUNMemoryHelper_Dealloc(helper, b, nullptr);
+
+  std::cout << "  SUNMemoryHelper_GetPoolStats_Pool... "
+            << (pool_fails ? "FAILED" : "PASSED") << "\n";
+  fails += pool_fails;
+
+  // Alignment
+  int align_fails = 0;
+  for (size_t alignment : {size_t{64}, size_t{256}, size_t{4096}})
+  {
+    align_fails += check(!SUNMemoryHelper_SetAlignment_Pool(helper, alignment),
+                         "SUNMemoryHelper_SetAlignment_Pool failed");
+    for (size_t bytes : {size_t{1}, size_t{100}, size_t{5000}})
+    {
+      SUNMemoryHelper_Alloc(helper, &a, bytes, SUNMEMTYPE_HOST, nullptr);
+      align_fails += check(reinterpret_cast<std::uintptr_t>(a->ptr) %
+                               alignment ==
+                             0,
+                           "misaligned block");
+      SUNMemoryHelper_Dealloc(helper, a, nullptr);
+    }
+  }
+  align_fails += check(SUNMemoryHelper_SetAlignment_Pool(helper, 48) != 0,
+                       "accepted an alignment that is not a power of two");
+  std::cout << "  SUNMemoryHelper_SetAlignment_Pool... "
+            << (align_fails ? "FAILED" : "PASSED") << "\n";
+  fails += align_fails;
+
+  // Cache limit
+  int limit_fails = check(!SUNMemoryHelper_SetMaxCachedBytes_Pool(helper, 0),
+                          "SUNMemoryHelper_SetMaxCachedBytes_Pool failed");
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &hits, &misses, &cached);
+  limit_fails += check(cached == 0, "cache not trimmed");
+  SUNMemoryHelper_Alloc(helper, &a, 100, SUNMEMTYPE_HOST, nullptr);
+  SUNMemoryHelper_Dealloc(helper, a, nullptr);
+  SUNMemoryHelper_GetPoolStats_Pool(helper, &hits, &misses, &cached);
+  limit_fails += check(cached == 0, "block cached beyond the limit");
+  SUNMemoryHelper_SetMaxCachedBytes_Pool(helper, SIZE_MAX);
+  std::cout << "  SUNMemoryHelper_SetMaxCachedBytes_Pool... "
+            << (limit_fails ? "FAILED" : "PASSED") << "\n";
+  fails += limit_fails;
+
+  // Clones share the pool
+  SUNMemoryHelper helper2 = SUNMemoryHelper_Clone(helper);
+  int clone_fails         = test_instance(helper2);
+  SUNMemoryHelper_Alloc(helper2, &a, 100, SUNMEMTYPE_HOST, nullptr);
+  a_ptr = a->ptr;
+  SUNMemoryHelper_Dealloc(helper2, a, nullptr);
+  SUNMemoryHelper_Alloc(helper, &b, 100, SUNMEMTYPE_HOST, nullptr);
+  clone_fails += check(b->ptr == a_ptr, "clone does not share the pool");
+  SUNMemoryHelper_Dealloc(helper, b, nullptr);
+  std::cout << "  SUNMemoryHelper_Clone... "
+            << (clone_fails ? "FAILED" : "PASSED") << "\n";
+  fails += clone_fails;
+
+  // Other helpers are rejected by the pool functions
+  fails += check(SUNMemoryHelper_Release_Pool(upstream) != 0,
+                 "accepted a helper that is not a pool");
+  fails += check(!SUNMemoryHelper_Release_Pool(helper),
+                 "SUNMemoryHelper_Release_Pool failed");
+
+  if (SUNMemoryHelper_Destroy(helper) || SUNMemoryHelper_Destroy(helper2) ||
+      SUNMemoryHelper_Destroy(upstream))
+  {
+    std::cout << "  SUNMemoryHelper_Destroy... FAILED\n";
+    return -1;
+  }
+  std::cout << "  SUNMemoryHelper_Destroy... PASSED\n";
+
+  if (fails)
+  {
+    std::cout << "FAILED " << fails << " checks\n";
+    return -1;
+  }
+  std::cout << "All Tests PASSED\n";
+  return 0;
+}